@@ -18,6 +18,8 @@
 #define TINK_AEAD_H_
 
 #include "absl/strings/string_view.h"
+#include "tink/output_buffer.h"
+#include "tink/util/status.h"
 #include "tink/util/statusor.h"
 
 namespace crypto {
@@ -48,6 +50,23 @@ class Aead {
       absl::string_view ciphertext,
       absl::string_view associated_data) const = 0;
 
+  // Like Encrypt(), but writes the ciphertext to 'ciphertext' instead of
+  // returning it, so that the caller decides where it is stored.
+  // The default implementation copies the result of Encrypt().
+  virtual crypto::tink::util::Status EncryptInto(
+      absl::string_view plaintext,
+      absl::string_view associated_data,
+      OutputBuffer* ciphertext) const;
+
+  // Like Decrypt(), but writes the plaintext to 'plaintext' instead of
+  // returning it. If decryption fails, no unverified plaintext is left in
+  // 'plaintext'.
+  // The default implementation copies the result of Decrypt().
+  virtual crypto::tink::util::Status DecryptInto(
+      absl::string_view ciphertext,
+      absl::string_view associated_data,
+      OutputBuffer* plaintext) const;
+
   virtual ~Aead() {}
 };
 
@@ -20,6 +20,8 @@
 #include "tink/aead/aes_ctr_hmac_aead_key_manager.h"
 #include "tink/aead/aes_eax_key_manager.h"
 #include "tink/aead/aes_gcm_key_manager.h"
+#include "tink/aead/aes_gcm_siv_key_manager.h"
+#include "tink/aead/chacha20_poly1305_key_manager.h"
 #include "tink/aead/xchacha20_poly1305_key_manager.h"
 #include "tink/catalogue.h"
 #include "tink/key_manager.h"
@@ -36,12 +38,19 @@ CreateKeyManager(const std::string& type_url) {
   if (type_url == AesGcmKeyManager::kKeyType) {
     std::unique_ptr<KeyManager<Aead>> manager(new AesGcmKeyManager());
     return std::move(manager);
+  } else if (type_url == AesGcmSivKeyManager::kKeyType) {
+    std::unique_ptr<KeyManager<Aead>> manager(new AesGcmSivKeyManager());
+    return std::move(manager);
   } else if (type_url == AesEaxKeyManager::kKeyType) {
     std::unique_ptr<KeyManager<Aead>> manager(new AesEaxKeyManager());
     return std::move(manager);
   } else if (type_url == AesCtrHmacAeadKeyManager::kKeyType) {
     std::unique_ptr<KeyManager<Aead>> manager(new AesCtrHmacAeadKeyManager());
     return std::move(manager);
+  } else if (type_url == ChaCha20Poly1305KeyManager::kKeyType) {
+    std::unique_ptr<KeyManager<Aead>> manager(
+        new ChaCha20Poly1305KeyManager());
+    return std::move(manager);
   } else if (type_url == XChacha20Poly1305KeyManager::kKeyType) {
     std::unique_ptr<KeyManager<Aead>> manager(
         new XChacha20Poly1305KeyManager());
@@ -33,7 +33,9 @@ TEST_F(AeadCatalogueTest, testBasic) {
   std::string key_types[] = {
       "type.googleapis.com/google.crypto.tink.AesEaxKey",
       "type.googleapis.com/google.crypto.tink.AesGcmKey",
+      "type.googleapis.com/google.crypto.tink.AesGcmSivKey",
       "type.googleapis.com/google.crypto.tink.AesCtrHmacAeadKey",
+      "type.googleapis.com/google.crypto.tink.ChaCha20Poly1305Key",
       "type.googleapis.com/google.crypto.tink.XChacha20Poly1305Key"};
 
   AeadCatalogue catalogue;
@@ -52,10 +52,20 @@ TEST_F(AeadConfigTest, testBasic) {
       "type.googleapis.com/google.crypto.tink.AesEaxKey";
   std::string aes_gcm_key_type =
       "type.googleapis.com/google.crypto.tink.AesGcmKey";
+  std::string aes_gcm_siv_key_type =
+      "type.googleapis.com/google.crypto.tink.AesGcmSivKey";
+  std::string chacha20_poly1305_key_type =
+      "type.googleapis.com/google.crypto.tink.ChaCha20Poly1305Key";
   std::string hmac_key_type = "type.googleapis.com/google.crypto.tink.HmacKey";
+  std::string aes_cmac_key_type =
+      "type.googleapis.com/google.crypto.tink.AesCmacKey";
+  std::string poly1305_mac_key_type =
+      "type.googleapis.com/google.crypto.tink.Poly1305MacKey";
+  std::string tree_hmac_key_type =
+      "type.googleapis.com/google.crypto.tink.TreeHmacKey";
   auto& config = AeadConfig::Latest();
 
-  EXPECT_EQ(4, AeadConfig::Latest().entry_size());
+  EXPECT_EQ(9, AeadConfig::Latest().entry_size());
 
   EXPECT_EQ("TinkMac", config.entry(0).catalogue_name());
   EXPECT_EQ("Mac", config.entry(0).primitive_name());
@@ -63,24 +73,54 @@ TEST_F(AeadConfigTest, testBasic) {
   EXPECT_EQ(true, config.entry(0).new_key_allowed());
   EXPECT_EQ(0, config.entry(0).key_manager_version());
 
-  EXPECT_EQ("TinkAead", config.entry(1).catalogue_name());
-  EXPECT_EQ("Aead", config.entry(1).primitive_name());
-  EXPECT_EQ(aes_ctr_hmac_aead_key_type, config.entry(1).type_url());
+  EXPECT_EQ("TinkMac", config.entry(1).catalogue_name());
+  EXPECT_EQ("Mac", config.entry(1).primitive_name());
+  EXPECT_EQ(aes_cmac_key_type, config.entry(1).type_url());
   EXPECT_EQ(true, config.entry(1).new_key_allowed());
   EXPECT_EQ(0, config.entry(1).key_manager_version());
 
-  EXPECT_EQ("TinkAead", config.entry(2).catalogue_name());
-  EXPECT_EQ("Aead", config.entry(2).primitive_name());
-  EXPECT_EQ(aes_gcm_key_type, config.entry(2).type_url());
+  EXPECT_EQ("TinkMac", config.entry(2).catalogue_name());
+  EXPECT_EQ("Mac", config.entry(2).primitive_name());
+  EXPECT_EQ(poly1305_mac_key_type, config.entry(2).type_url());
   EXPECT_EQ(true, config.entry(2).new_key_allowed());
   EXPECT_EQ(0, config.entry(2).key_manager_version());
 
-  EXPECT_EQ("TinkAead", config.entry(3).catalogue_name());
-  EXPECT_EQ("Aead", config.entry(3).primitive_name());
-  EXPECT_EQ(aes_eax_key_type, config.entry(3).type_url());
+  EXPECT_EQ("TinkMac", config.entry(3).catalogue_name());
+  EXPECT_EQ("Mac", config.entry(3).primitive_name());
+  EXPECT_EQ(tree_hmac_key_type, config.entry(3).type_url());
   EXPECT_EQ(true, config.entry(3).new_key_allowed());
   EXPECT_EQ(0, config.entry(3).key_manager_version());
 
+  EXPECT_EQ("TinkAead", config.entry(4).catalogue_name());
+  EXPECT_EQ("Aead", config.entry(4).primitive_name());
+  EXPECT_EQ(aes_ctr_hmac_aead_key_type, config.entry(4).type_url());
+  EXPECT_EQ(true, config.entry(4).new_key_allowed());
+  EXPECT_EQ(0, config.entry(4).key_manager_version());
+
+  EXPECT_EQ("TinkAead", config.entry(5).catalogue_name());
+  EXPECT_EQ("Aead", config.entry(5).primitive_name());
+  EXPECT_EQ(aes_gcm_key_type, config.entry(5).type_url());
+  EXPECT_EQ(true, config.entry(5).new_key_allowed());
+  EXPECT_EQ(0, config.entry(5).key_manager_version());
+
+  EXPECT_EQ("TinkAead", config.entry(6).catalogue_name());
+  EXPECT_EQ("Aead", config.entry(6).primitive_name());
+  EXPECT_EQ(aes_eax_key_type, config.entry(6).type_url());
+  EXPECT_EQ(true, config.entry(6).new_key_allowed());
+  EXPECT_EQ(0, config.entry(6).key_manager_version());
+
+  EXPECT_EQ("TinkAead", config.entry(7).catalogue_name());
+  EXPECT_EQ("Aead", config.entry(7).primitive_name());
+  EXPECT_EQ(aes_gcm_siv_key_type, config.entry(7).type_url());
+  EXPECT_EQ(true, config.entry(7).new_key_allowed());
+  EXPECT_EQ(0, config.entry(7).key_manager_version());
+
+  EXPECT_EQ("TinkAead", config.entry(8).catalogue_name());
+  EXPECT_EQ("Aead", config.entry(8).primitive_name());
+  EXPECT_EQ(chacha20_poly1305_key_type, config.entry(8).type_url());
+  EXPECT_EQ(true, config.entry(8).new_key_allowed());
+  EXPECT_EQ(0, config.entry(8).key_manager_version());
+
   // No key manager before registration.
   auto manager_result = Registry::get_key_manager<Aead>(aes_gcm_key_type);
   EXPECT_FALSE(manager_result.ok());
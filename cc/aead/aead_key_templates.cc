@@ -16,9 +16,12 @@
 
 #include "tink/aead/aead_key_templates.h"
 
+#include "openssl/aead.h"
 #include "proto/aes_ctr_hmac_aead.pb.h"
 #include "proto/aes_eax.pb.h"
 #include "proto/aes_gcm.pb.h"
+#include "proto/aes_gcm_siv.pb.h"
+#include "proto/chacha20_poly1305.pb.h"
 #include "proto/common.pb.h"
 #include "proto/tink.pb.h"
 #include "proto/xchacha20_poly1305.pb.h"
@@ -26,6 +29,8 @@
 using google::crypto::tink::AesCtrHmacAeadKeyFormat;
 using google::crypto::tink::AesEaxKeyFormat;
 using google::crypto::tink::AesGcmKeyFormat;
+using google::crypto::tink::AesGcmSivKeyFormat;
+using google::crypto::tink::ChaCha20Poly1305KeyFormat;
 using google::crypto::tink::HashType;
 using google::crypto::tink::KeyTemplate;
 using google::crypto::tink::OutputPrefixType;
@@ -59,6 +64,17 @@ KeyTemplate* NewAesGcmKeyTemplate(int key_size_in_bytes) {
   return key_template;
 }
 
+KeyTemplate* NewAesGcmSivKeyTemplate(int key_size_in_bytes) {
+  KeyTemplate* key_template = new KeyTemplate;
+  key_template->set_type_url(
+      "type.googleapis.com/google.crypto.tink.AesGcmSivKey");
+  key_template->set_output_prefix_type(OutputPrefixType::TINK);
+  AesGcmSivKeyFormat key_format;
+  key_format.set_key_size(key_size_in_bytes);
+  key_format.SerializeToString(key_template->mutable_value());
+  return key_template;
+}
+
 KeyTemplate* NewAesCtrHmacAeadKeyTemplate(
     int aes_key_size_in_bytes, int iv_size_in_bytes,
     int hmac_key_size_in_bytes, int tag_size_in_bytes,
@@ -79,6 +95,16 @@ KeyTemplate* NewAesCtrHmacAeadKeyTemplate(
   return key_template;
 }
 
+KeyTemplate* NewChaCha20Poly1305KeyTemplate() {
+  KeyTemplate* key_template = new KeyTemplate;
+  key_template->set_type_url(
+      "type.googleapis.com/google.crypto.tink.ChaCha20Poly1305Key");
+  key_template->set_output_prefix_type(OutputPrefixType::TINK);
+  ChaCha20Poly1305KeyFormat key_format;
+  key_format.SerializeToString(key_template->mutable_value());
+  return key_template;
+}
+
 KeyTemplate* NewXChacha20Poly1305KeyTemplate() {
   KeyTemplate* key_template = new KeyTemplate;
   key_template->set_type_url(
@@ -122,6 +148,20 @@ const KeyTemplate& AeadKeyTemplates::Aes256Gcm() {
   return *key_template;
 }
 
+// static
+const KeyTemplate& AeadKeyTemplates::Aes128GcmSiv() {
+  static const KeyTemplate* key_template =
+      NewAesGcmSivKeyTemplate(/* key_size_in_bytes= */ 16);
+  return *key_template;
+}
+
+// static
+const KeyTemplate& AeadKeyTemplates::Aes256GcmSiv() {
+  static const KeyTemplate* key_template =
+      NewAesGcmSivKeyTemplate(/* key_size_in_bytes= */ 32);
+  return *key_template;
+}
+
 // static
 const KeyTemplate& AeadKeyTemplates::Aes128CtrHmacSha256() {
   static const KeyTemplate* key_template = NewAesCtrHmacAeadKeyTemplate(
@@ -144,6 +184,18 @@ const KeyTemplate& AeadKeyTemplates::Aes256CtrHmacSha256() {
   return *key_template;
 }
 
+// static
+const KeyTemplate& AeadKeyTemplates::ChaCha20Poly1305() {
+  static const KeyTemplate* key_template = NewChaCha20Poly1305KeyTemplate();
+  return *key_template;
+}
+
+// static
+const KeyTemplate& AeadKeyTemplates::Aes128GcmOrChaCha20Poly1305() {
+  if (EVP_has_aes_hardware()) return Aes128Gcm();
+  return ChaCha20Poly1305();
+}
+
 // static
 const KeyTemplate& AeadKeyTemplates::XChacha20Poly1305() {
   static const KeyTemplate* key_template = NewXChacha20Poly1305KeyTemplate();
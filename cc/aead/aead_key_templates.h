@@ -67,6 +67,22 @@ class AeadKeyTemplates {
   //   - OutputPrefixType: TINK
   static const google::crypto::tink::KeyTemplate& Aes256Gcm();
 
+  // Returns a KeyTemplate that generates new instances of AesGcmSivKey
+  // with the following parameters:
+  //   - key size: 16 bytes
+  //   - IV size: 12 bytes
+  //   - tag size: 16 bytes
+  //   - OutputPrefixType: TINK
+  static const google::crypto::tink::KeyTemplate& Aes128GcmSiv();
+
+  // Returns a KeyTemplate that generates new instances of AesGcmSivKey
+  // with the following parameters:
+  //   - key size: 32 bytes
+  //   - IV size: 12 bytes
+  //   - tag size: 16 bytes
+  //   - OutputPrefixType: TINK
+  static const google::crypto::tink::KeyTemplate& Aes256GcmSiv();
+
   // Returns a KeyTemplate that generates new instances of AesCtrHmacAeadKey
   // with the following parameters:
   //   - AES key size: 16 bytes
@@ -87,6 +103,22 @@ class AeadKeyTemplates {
   //   - OutputPrefixType: TINK
   static const google::crypto::tink::KeyTemplate& Aes256CtrHmacSha256();
 
+  // Returns a KeyTemplate that generates new instances of ChaCha20Poly1305Key
+  // with the following parameters:
+  //   - ChaCha20 key size: 32 bytes
+  //   - IV size: 12 bytes
+  //   - OutputPrefixType: TINK
+  static const google::crypto::tink::KeyTemplate& ChaCha20Poly1305();
+
+  // Returns Aes128Gcm() if the CPU running this code has hardware support
+  // for AES (AES-NI on x86, the Cryptography Extensions on ARMv8), and
+  // ChaCha20Poly1305() otherwise. Without that support ChaCha20-Poly1305
+  // is several times faster than AES-GCM. Every host can decrypt keysets
+  // generated with either template, so this only sets the default for new
+  // keys.
+  static const google::crypto::tink::KeyTemplate&
+  Aes128GcmOrChaCha20Poly1305();
+
   // Returns a KeyTemplate that generates new instances of XChacha20Poly1305Key
   // with the following parameters:
   //   - XChacha20 key size: 32 bytes
@@ -18,6 +18,7 @@
 
 #include "tink/aead.h"
 #include "tink/crypto_format.h"
+#include "tink/output_buffer.h"
 #include "tink/primitive_set.h"
 #include "tink/subtle/subtle_util_boringssl.h"
 #include "tink/util/status.h"
@@ -105,5 +106,59 @@ util::StatusOr<std::string> AeadSetWrapper::Decrypt(
   return util::Status(util::error::INVALID_ARGUMENT, "decryption failed");
 }
 
+util::Status AeadSetWrapper::EncryptInto(
+    absl::string_view plaintext,
+    absl::string_view associated_data,
+    OutputBuffer* ciphertext) const {
+  plaintext = subtle::SubtleUtilBoringSSL::EnsureNonNull(plaintext);
+  associated_data = subtle::SubtleUtilBoringSSL::EnsureNonNull(associated_data);
+
+  auto primary = aead_set_->get_primary();
+  // The primitive writes its ciphertext right after the key prefix.
+  PrefixedOutputBuffer output(primary->get_identifier(), ciphertext);
+  return primary->get_primitive().EncryptInto(
+      plaintext, associated_data, &output);
+}
+
+util::Status AeadSetWrapper::DecryptInto(
+    absl::string_view ciphertext,
+    absl::string_view associated_data,
+    OutputBuffer* plaintext) const {
+  associated_data = subtle::SubtleUtilBoringSSL::EnsureNonNull(associated_data);
+
+  if (ciphertext.length() > CryptoFormat::kNonRawPrefixSize) {
+    auto primitives_result = aead_set_->get_primitives(std::string(
+        ciphertext.substr(0, CryptoFormat::kNonRawPrefixSize)));
+    if (primitives_result.ok()) {
+      absl::string_view raw_ciphertext =
+          ciphertext.substr(CryptoFormat::kNonRawPrefixSize);
+      for (auto& aead_entry : *(primitives_result.ValueOrDie())) {
+        Aead& aead = aead_entry->get_primitive();
+        util::Status status =
+            aead.DecryptInto(raw_ciphertext, associated_data, plaintext);
+        if (status.ok() ||
+            status.error_code() == util::error::RESOURCE_EXHAUSTED) {
+          return status;
+        }
+      }
+    }
+  }
+
+  // No matching key succeeded with decryption, try all RAW keys.
+  auto raw_primitives_result = aead_set_->get_raw_primitives();
+  if (raw_primitives_result.ok()) {
+    for (auto& aead_entry : *(raw_primitives_result.ValueOrDie())) {
+      Aead& aead = aead_entry->get_primitive();
+      util::Status status =
+          aead.DecryptInto(ciphertext, associated_data, plaintext);
+      if (status.ok() ||
+          status.error_code() == util::error::RESOURCE_EXHAUSTED) {
+        return status;
+      }
+    }
+  }
+  return util::Status(util::error::INVALID_ARGUMENT, "decryption failed");
+}
+
 }  // namespace tink
 }  // namespace crypto
@@ -19,7 +19,9 @@
 
 #include "absl/strings/string_view.h"
 #include "tink/aead.h"
+#include "tink/output_buffer.h"
 #include "tink/primitive_set.h"
+#include "tink/util/status.h"
 #include "tink/util/statusor.h"
 #include "proto/tink.pb.h"
 
@@ -31,6 +33,8 @@ namespace tink {
 // instances, depending on the context:
 //   * Aead::Encrypt(...) uses the primary instance from the set
 //   * Aead::Decrypt(...) uses the instance that matches the ciphertext prefix.
+// DecryptInto(...) fails with RESOURCE_EXHAUSTED as soon as an instance
+// finds the output buffer too small, without trying the remaining instances.
 class AeadSetWrapper : public Aead {
  public:
   // Returns an Aead-primitive that uses Aead-instances provided in 'aead_set',
@@ -46,6 +50,16 @@ class AeadSetWrapper : public Aead {
       absl::string_view ciphertext,
       absl::string_view associated_data) const override;
 
+  crypto::tink::util::Status EncryptInto(
+      absl::string_view plaintext,
+      absl::string_view associated_data,
+      OutputBuffer* ciphertext) const override;
+
+  crypto::tink::util::Status DecryptInto(
+      absl::string_view ciphertext,
+      absl::string_view associated_data,
+      OutputBuffer* plaintext) const override;
+
   virtual ~AeadSetWrapper() {}
 
  private:
@@ -16,6 +16,7 @@
 
 #include "tink/aead/aead_set_wrapper.h"
 #include "tink/aead.h"
+#include "tink/output_buffer.h"
 #include "tink/primitive_set.h"
 #include "tink/util/status.h"
 #include "tink/util/test_util.h"
@@ -116,6 +117,46 @@ TEST_F(AeadSetWrapperTest, testBasic) {
   }
 }
 
+TEST_F(AeadSetWrapperTest, testDecryptIntoBufferTooSmall) {
+  Keyset keyset;
+  Keyset::Key* key = keyset.add_key();
+  key->set_output_prefix_type(OutputPrefixType::RAW);
+  key->set_key_id(1234543);
+  key = keyset.add_key();
+  key->set_output_prefix_type(OutputPrefixType::TINK);
+  key->set_key_id(726329);
+
+  std::unique_ptr<PrimitiveSet<Aead>> aead_set(new PrimitiveSet<Aead>());
+  std::unique_ptr<Aead> aead(new DummyAead("aead0"));
+  auto entry_result = aead_set->AddPrimitive(std::move(aead), keyset.key(0));
+  ASSERT_TRUE(entry_result.ok());
+  aead.reset(new DummyAead("aead1"));
+  entry_result = aead_set->AddPrimitive(std::move(aead), keyset.key(1));
+  ASSERT_TRUE(entry_result.ok());
+  aead_set->set_primary(entry_result.ValueOrDie());
+  auto aead_result = AeadSetWrapper::NewAead(std::move(aead_set));
+  ASSERT_TRUE(aead_result.ok()) << aead_result.status();
+  aead = std::move(aead_result.ValueOrDie());
+
+  std::string plaintext = "some_plaintext";
+  std::string aad = "some_aad";
+  auto encrypt_result = aead->Encrypt(plaintext, aad);
+  ASSERT_TRUE(encrypt_result.ok()) << encrypt_result.status();
+  std::string ciphertext = encrypt_result.ValueOrDie();
+  char data[64];
+
+  // The matching key finds the buffer too small; the wrapper must report
+  // that rather than fall back to the RAW key.
+  FixedOutputBuffer small_output(data, plaintext.size() - 1);
+  auto status = aead->DecryptInto(ciphertext, aad, &small_output);
+  EXPECT_EQ(util::error::RESOURCE_EXHAUSTED, status.error_code()) << status;
+
+  FixedOutputBuffer output(data, plaintext.size());
+  status = aead->DecryptInto(ciphertext, aad, &output);
+  EXPECT_TRUE(status.ok()) << status;
+  EXPECT_EQ(plaintext, output.output());
+}
+
 }  // namespace
 }  // namespace tink
 }  // namespace crypto
@@ -18,11 +18,13 @@
 
 #include <map>
 
+#include "openssl/aead.h"
 #include "tink/aead.h"
 #include "tink/key_manager.h"
 #include "tink/mac.h"
 #include "tink/registry.h"
 #include "tink/subtle/aes_ctr_boringssl.h"
+#include "tink/subtle/aes_ctr_hmac_aead_boringssl.h"
 #include "tink/subtle/encrypt_then_authenticate.h"
 #include "tink/subtle/hmac_boringssl.h"
 #include "tink/subtle/random.h"
@@ -199,6 +201,18 @@ StatusOr<std::unique_ptr<Aead>> AesCtrHmacAeadKeyManager::GetPrimitiveImpl(
       kHmacKeyType, aes_ctr_hmac_aead_key.hmac_key());
   if (!hmac_result.ok()) return hmac_result.status();
 
+  if (EVP_has_aes_hardware()) {
+    // With AES-NI, AES-CTR is fast enough for the two passes of
+    // EncryptThenAuthenticate to be memory bound on large messages, so use
+    // the single-pass implementation. Both produce the same ciphertexts.
+    const auto& hmac_key = aes_ctr_hmac_aead_key.hmac_key();
+    return subtle::AesCtrHmacAeadBoringSsl::New(
+        aes_ctr_hmac_aead_key.aes_ctr_key().key_value(),
+        aes_ctr_hmac_aead_key.aes_ctr_key().params().iv_size(),
+        Enums::ProtoToSubtle(hmac_key.params().hash()), hmac_key.key_value(),
+        hmac_key.params().tag_size());
+  }
+
   auto cipher_res = subtle::EncryptThenAuthenticate::New(
       std::move(aes_ctr_result.ValueOrDie()),
       std::move(hmac_result.ValueOrDie()),
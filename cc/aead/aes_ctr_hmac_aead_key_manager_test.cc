@@ -18,6 +18,10 @@
 
 #include "tink/config.h"
 #include "tink/mac/mac_config.h"
+#include "tink/subtle/aes_ctr_boringssl.h"
+#include "tink/subtle/common_enums.h"
+#include "tink/subtle/encrypt_then_authenticate.h"
+#include "tink/subtle/hmac_boringssl.h"
 #include "tink/util/status.h"
 #include "tink/util/statusor.h"
 #include "gtest/gtest.h"
@@ -235,6 +239,50 @@ TEST_F(AesCtrHmacAeadKeyManagerTest, testPrimitives) {
   }
 }
 
+TEST_F(AesCtrHmacAeadKeyManagerTest, testTwoPassCompatibility) {
+  // The manager may pick a single-pass implementation at runtime; its
+  // ciphertexts must be interchangeable with EncryptThenAuthenticate's.
+  std::string plaintext(10000, 'p');
+  std::string aad = "some aad";
+  AesCtrHmacAeadKeyManager key_manager;
+  AesCtrHmacAeadKey key;
+
+  key.set_version(0);
+  auto aes_ctr_key = key.mutable_aes_ctr_key();
+  aes_ctr_key->set_key_value(std::string(32, 'a'));
+  aes_ctr_key->mutable_params()->set_iv_size(16);
+  auto hmac_key = key.mutable_hmac_key();
+  hmac_key->set_key_value(std::string(32, 'b'));
+  hmac_key->mutable_params()->set_hash(HashType::SHA256);
+  hmac_key->mutable_params()->set_tag_size(32);
+
+  auto result = key_manager.GetPrimitive(key);
+  EXPECT_TRUE(result.ok()) << result.status();
+  auto cipher = std::move(result.ValueOrDie());
+  auto ind_cpa_cipher = subtle::AesCtrBoringSsl::New(std::string(32, 'a'), 16);
+  EXPECT_TRUE(ind_cpa_cipher.ok()) << ind_cpa_cipher.status();
+  auto mac = subtle::HmacBoringSsl::New(subtle::HashType::SHA256, 32,
+                                        std::string(32, 'b'));
+  EXPECT_TRUE(mac.ok()) << mac.status();
+  auto two_pass_result = subtle::EncryptThenAuthenticate::New(
+      std::move(ind_cpa_cipher.ValueOrDie()), std::move(mac.ValueOrDie()), 32);
+  EXPECT_TRUE(two_pass_result.ok()) << two_pass_result.status();
+  auto two_pass_cipher = std::move(two_pass_result.ValueOrDie());
+
+  auto encrypt_result = cipher->Encrypt(plaintext, aad);
+  EXPECT_TRUE(encrypt_result.ok()) << encrypt_result.status();
+  auto decrypt_result =
+      two_pass_cipher->Decrypt(encrypt_result.ValueOrDie(), aad);
+  EXPECT_TRUE(decrypt_result.ok()) << decrypt_result.status();
+  EXPECT_EQ(plaintext, decrypt_result.ValueOrDie());
+
+  encrypt_result = two_pass_cipher->Encrypt(plaintext, aad);
+  EXPECT_TRUE(encrypt_result.ok()) << encrypt_result.status();
+  decrypt_result = cipher->Decrypt(encrypt_result.ValueOrDie(), aad);
+  EXPECT_TRUE(decrypt_result.ok()) << decrypt_result.status();
+  EXPECT_EQ(plaintext, decrypt_result.ValueOrDie());
+}
+
 TEST_F(AesCtrHmacAeadKeyManagerTest, testNewKeyErrors) {
   AesCtrHmacAeadKeyManager key_manager;
   const KeyFactory& key_factory = key_manager.get_key_factory();
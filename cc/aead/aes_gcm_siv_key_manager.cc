@@ -0,0 +1,208 @@
+// Copyright 2018 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/aead/aes_gcm_siv_key_manager.h"
+
+#include "absl/strings/string_view.h"
+#include "tink/aead.h"
+#include "tink/key_manager.h"
+#include "tink/subtle/aes_gcm_siv_boringssl.h"
+#include "tink/subtle/random.h"
+#include "tink/util/errors.h"
+#include "tink/util/protobuf_helper.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "tink/util/validation.h"
+#include "proto/aes_gcm_siv.pb.h"
+#include "proto/tink.pb.h"
+
+namespace crypto {
+namespace tink {
+
+using google::crypto::tink::AesGcmSivKey;
+using google::crypto::tink::AesGcmSivKeyFormat;
+using google::crypto::tink::KeyData;
+using google::crypto::tink::KeyTemplate;
+using portable_proto::MessageLite;
+using crypto::tink::util::Status;
+using crypto::tink::util::StatusOr;
+
+class AesGcmSivKeyFactory : public KeyFactory {
+ public:
+  AesGcmSivKeyFactory() {}
+
+  // Generates a new random AesGcmSivKey, based on the specified 'key_format',
+  // which must contain AesGcmSivKeyFormat-proto.
+  crypto::tink::util::StatusOr<std::unique_ptr<portable_proto::MessageLite>>
+  NewKey(const portable_proto::MessageLite& key_format) const override;
+
+  // Generates a new random AesGcmSivKey, based on the specified
+  // 'serialized_key_format', which must contain AesGcmSivKeyFormat-proto.
+  crypto::tink::util::StatusOr<std::unique_ptr<portable_proto::MessageLite>>
+  NewKey(absl::string_view serialized_key_format) const override;
+
+  // Generates a new random AesGcmSivKey, based on the specified
+  // 'serialized_key_format' (which must contain AesGcmSivKeyFormat-proto),
+  // and wraps it in a KeyData-proto.
+  crypto::tink::util::StatusOr<std::unique_ptr<google::crypto::tink::KeyData>>
+  NewKeyData(absl::string_view serialized_key_format) const override;
+};
+
+StatusOr<std::unique_ptr<MessageLite>> AesGcmSivKeyFactory::NewKey(
+    const portable_proto::MessageLite& key_format) const {
+  std::string key_format_url = std::string(
+      AesGcmSivKeyManager::kKeyTypePrefix) + key_format.GetTypeName();
+  if (key_format_url != AesGcmSivKeyManager::kKeyFormatUrl) {
+    return ToStatusF(util::error::INVALID_ARGUMENT,
+                     "Key format proto '%s' is not supported by this manager.",
+                     key_format_url.c_str());
+  }
+  const AesGcmSivKeyFormat& aes_gcm_siv_key_format =
+        reinterpret_cast<const AesGcmSivKeyFormat&>(key_format);
+  Status status = AesGcmSivKeyManager::Validate(aes_gcm_siv_key_format);
+  if (!status.ok()) return status;
+
+  // Generate AesGcmSivKey.
+  std::unique_ptr<AesGcmSivKey> aes_gcm_siv_key(new AesGcmSivKey());
+  aes_gcm_siv_key->set_version(AesGcmSivKeyManager::kVersion);
+  aes_gcm_siv_key->set_key_value(
+      subtle::Random::GetRandomBytes(aes_gcm_siv_key_format.key_size()));
+  std::unique_ptr<MessageLite> key = std::move(aes_gcm_siv_key);
+  return std::move(key);
+}
+
+StatusOr<std::unique_ptr<MessageLite>> AesGcmSivKeyFactory::NewKey(
+    absl::string_view serialized_key_format) const {
+  AesGcmSivKeyFormat key_format;
+  if (!key_format.ParseFromString(std::string(serialized_key_format))) {
+    return ToStatusF(util::error::INVALID_ARGUMENT,
+                     "Could not parse the passed string as proto '%s'.",
+                     AesGcmSivKeyManager::kKeyFormatUrl);
+  }
+  return NewKey(key_format);
+}
+
+StatusOr<std::unique_ptr<KeyData>> AesGcmSivKeyFactory::NewKeyData(
+    absl::string_view serialized_key_format) const {
+  auto new_key_result = NewKey(serialized_key_format);
+  if (!new_key_result.ok()) return new_key_result.status();
+  auto new_key = reinterpret_cast<const AesGcmSivKey&>(
+      *(new_key_result.ValueOrDie()));
+  std::unique_ptr<KeyData> key_data(new KeyData());
+  key_data->set_type_url(AesGcmSivKeyManager::kKeyType);
+  key_data->set_value(new_key.SerializeAsString());
+  key_data->set_key_material_type(KeyData::SYMMETRIC);
+  return std::move(key_data);
+}
+
+constexpr char AesGcmSivKeyManager::kKeyFormatUrl[];
+constexpr char AesGcmSivKeyManager::kKeyTypePrefix[];
+constexpr char AesGcmSivKeyManager::kKeyType[];
+constexpr uint32_t AesGcmSivKeyManager::kVersion;
+
+const int kMinKeySizeInBytes = 16;
+
+AesGcmSivKeyManager::AesGcmSivKeyManager()
+    : key_type_(kKeyType), key_factory_(new AesGcmSivKeyFactory()) {}
+
+const std::string& AesGcmSivKeyManager::get_key_type() const {
+  return key_type_;
+}
+
+uint32_t AesGcmSivKeyManager::get_version() const {
+  return kVersion;
+}
+
+const KeyFactory& AesGcmSivKeyManager::get_key_factory() const {
+  return *key_factory_;
+}
+
+StatusOr<std::unique_ptr<Aead>>
+AesGcmSivKeyManager::GetPrimitive(const KeyData& key_data) const {
+  if (DoesSupport(key_data.type_url())) {
+    AesGcmSivKey aes_gcm_siv_key;
+    if (!aes_gcm_siv_key.ParseFromString(key_data.value())) {
+      return ToStatusF(util::error::INVALID_ARGUMENT,
+                       "Could not parse key_data.value as key type '%s'.",
+                       key_data.type_url().c_str());
+    }
+    return GetPrimitiveImpl(aes_gcm_siv_key);
+  } else {
+    return ToStatusF(util::error::INVALID_ARGUMENT,
+                     "Key type '%s' is not supported by this manager.",
+                     key_data.type_url().c_str());
+  }
+}
+
+StatusOr<std::unique_ptr<Aead>>
+AesGcmSivKeyManager::GetPrimitive(const MessageLite& key) const {
+  std::string key_type = std::string(kKeyTypePrefix) + key.GetTypeName();
+  if (DoesSupport(key_type)) {
+    const AesGcmSivKey& aes_gcm_siv_key =
+        reinterpret_cast<const AesGcmSivKey&>(key);
+    return GetPrimitiveImpl(aes_gcm_siv_key);
+  } else {
+    return ToStatusF(util::error::INVALID_ARGUMENT,
+                     "Key type '%s' is not supported by this manager.",
+                     key_type.c_str());
+  }
+}
+
+StatusOr<std::unique_ptr<Aead>>
+AesGcmSivKeyManager::GetPrimitiveImpl(
+    const AesGcmSivKey& aes_gcm_siv_key) const {
+  Status status = Validate(aes_gcm_siv_key);
+  if (!status.ok()) return status;
+  auto aes_gcm_siv_result =
+      subtle::AesGcmSivBoringSsl::New(aes_gcm_siv_key.key_value());
+  if (!aes_gcm_siv_result.ok()) return aes_gcm_siv_result.status();
+  return std::move(aes_gcm_siv_result.ValueOrDie());
+}
+
+// static
+Status AesGcmSivKeyManager::Validate(const AesGcmSivKey& key) {
+  Status status = ValidateVersion(key.version(), kVersion);
+  if (!status.ok()) return status;
+  uint32_t key_size = key.key_value().size();
+  if (key_size < kMinKeySizeInBytes) {
+      return ToStatusF(util::error::INVALID_ARGUMENT,
+                       "Invalid AesGcmSivKey: key_value is too short.");
+  }
+  if (key_size != 16 && key_size != 32) {
+      return ToStatusF(util::error::INVALID_ARGUMENT,
+                       "Invalid AesGcmSivKey: key_value has %d bytes; "
+                       "supported sizes: 16 or 32 bytes.", key_size);
+  }
+  return Status::OK;
+}
+
+// static
+Status AesGcmSivKeyManager::Validate(const AesGcmSivKeyFormat& key_format) {
+  if (key_format.key_size() < kMinKeySizeInBytes) {
+      return ToStatusF(util::error::INVALID_ARGUMENT,
+                       "Invalid AesGcmSivKeyFormat: key_size is too small.");
+  }
+  if (key_format.key_size() != 16 && key_format.key_size() != 32) {
+      return ToStatusF(util::error::INVALID_ARGUMENT,
+                       "Invalid AesGcmSivKeyFormat: key_size is %d bytes; "
+                       "supported sizes: 16 or 32 bytes.",
+                       key_format.key_size());
+  }
+  return Status::OK;
+}
+
+}  // namespace tink
+}  // namespace crypto
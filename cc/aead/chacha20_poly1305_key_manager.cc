@@ -0,0 +1,202 @@
+// Copyright 2018 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/aead/chacha20_poly1305_key_manager.h"
+
+#include "absl/strings/string_view.h"
+#include "tink/aead.h"
+#include "tink/key_manager.h"
+#include "tink/subtle/random.h"
+#include "tink/subtle/chacha20_poly1305_boringssl.h"
+#include "tink/util/errors.h"
+#include "tink/util/protobuf_helper.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "tink/util/validation.h"
+#include "proto/tink.pb.h"
+#include "proto/chacha20_poly1305.pb.h"
+
+namespace crypto {
+namespace tink {
+
+using crypto::tink::util::Status;
+using crypto::tink::util::StatusOr;
+using google::crypto::tink::KeyData;
+using google::crypto::tink::ChaCha20Poly1305Key;
+using google::crypto::tink::ChaCha20Poly1305KeyFormat;
+using portable_proto::MessageLite;
+
+namespace {
+
+const int kKeySizeInBytes = 32;
+
+}  // namespace
+
+class ChaCha20Poly1305KeyFactory : public KeyFactory {
+ public:
+  ChaCha20Poly1305KeyFactory() {}
+
+  // Generates a new random ChaCha20Poly1305Key, based on the specified
+  // 'key_format', which must contain ChaCha20Poly1305KeyFormat-proto.
+  crypto::tink::util::StatusOr<std::unique_ptr<portable_proto::MessageLite>>
+  NewKey(const portable_proto::MessageLite& key_format) const override;
+
+  // Generates a new random ChaCha20Poly1305Key, based on the specified
+  // 'serialized_key_format', which must contain
+  // ChaCha20Poly1305KeyFormat-proto.
+  crypto::tink::util::StatusOr<std::unique_ptr<portable_proto::MessageLite>>
+  NewKey(absl::string_view serialized_key_format) const override;
+
+  // Generates a new random ChaCha20Poly1305Key, based on the specified
+  // 'serialized_key_format' (which must contain
+  // ChaCha20Poly1305KeyFormat-proto), and wraps it in a KeyData-proto.
+  crypto::tink::util::StatusOr<std::unique_ptr<google::crypto::tink::KeyData>>
+  NewKeyData(absl::string_view serialized_key_format) const override;
+};
+
+StatusOr<std::unique_ptr<MessageLite>> ChaCha20Poly1305KeyFactory::NewKey(
+    const portable_proto::MessageLite& key_format) const {
+  std::string key_format_url =
+      std::string(ChaCha20Poly1305KeyManager::kKeyTypePrefix) +
+      key_format.GetTypeName();
+  if (key_format_url != ChaCha20Poly1305KeyManager::kKeyFormatUrl) {
+    return ToStatusF(util::error::INVALID_ARGUMENT,
+                     "Key format proto '%s' is not supported by this manager.",
+                     key_format_url.c_str());
+  }
+  const ChaCha20Poly1305KeyFormat& chacha20_poly1305_key_format =
+      reinterpret_cast<const ChaCha20Poly1305KeyFormat&>(key_format);
+  Status status =
+      ChaCha20Poly1305KeyManager::Validate(chacha20_poly1305_key_format);
+  if (!status.ok()) return status;
+
+  // Generate ChaCha20Poly1305Key.
+  std::unique_ptr<ChaCha20Poly1305Key> chacha20_poly1305_key(
+      new ChaCha20Poly1305Key());
+  chacha20_poly1305_key->set_version(ChaCha20Poly1305KeyManager::kVersion);
+  chacha20_poly1305_key->set_key_value(
+      subtle::Random::GetRandomBytes(kKeySizeInBytes));
+  std::unique_ptr<MessageLite> key = std::move(chacha20_poly1305_key);
+  return std::move(key);
+}
+
+StatusOr<std::unique_ptr<MessageLite>> ChaCha20Poly1305KeyFactory::NewKey(
+    absl::string_view serialized_key_format) const {
+  ChaCha20Poly1305KeyFormat key_format;
+  if (!key_format.ParseFromString(std::string(serialized_key_format))) {
+    return ToStatusF(util::error::INVALID_ARGUMENT,
+                     "Could not parse the passed string as proto '%s'.",
+                     ChaCha20Poly1305KeyManager::kKeyFormatUrl);
+  }
+  return NewKey(key_format);
+}
+
+StatusOr<std::unique_ptr<KeyData>> ChaCha20Poly1305KeyFactory::NewKeyData(
+    absl::string_view serialized_key_format) const {
+  auto new_key_result = NewKey(serialized_key_format);
+  if (!new_key_result.ok()) return new_key_result.status();
+  auto new_key = reinterpret_cast<const ChaCha20Poly1305Key&>(
+      *(new_key_result.ValueOrDie()));
+  std::unique_ptr<KeyData> key_data(new KeyData());
+  key_data->set_type_url(ChaCha20Poly1305KeyManager::kKeyType);
+  key_data->set_value(new_key.SerializeAsString());
+  key_data->set_key_material_type(KeyData::SYMMETRIC);
+  return std::move(key_data);
+}
+
+constexpr char ChaCha20Poly1305KeyManager::kKeyFormatUrl[];
+constexpr char ChaCha20Poly1305KeyManager::kKeyTypePrefix[];
+constexpr char ChaCha20Poly1305KeyManager::kKeyType[];
+constexpr uint32_t ChaCha20Poly1305KeyManager::kVersion;
+
+ChaCha20Poly1305KeyManager::ChaCha20Poly1305KeyManager()
+    : key_type_(kKeyType), key_factory_(new ChaCha20Poly1305KeyFactory()) {}
+
+const std::string& ChaCha20Poly1305KeyManager::get_key_type() const {
+  return key_type_;
+}
+
+uint32_t ChaCha20Poly1305KeyManager::get_version() const { return kVersion; }
+
+const KeyFactory& ChaCha20Poly1305KeyManager::get_key_factory() const {
+  return *key_factory_;
+}
+
+StatusOr<std::unique_ptr<Aead>> ChaCha20Poly1305KeyManager::GetPrimitive(
+    const KeyData& key_data) const {
+  if (DoesSupport(key_data.type_url())) {
+    ChaCha20Poly1305Key chacha20_poly1305_key;
+    if (!chacha20_poly1305_key.ParseFromString(key_data.value())) {
+      return ToStatusF(util::error::INVALID_ARGUMENT,
+                       "Could not parse key_data.value as key type '%s'.",
+                       key_data.type_url().c_str());
+    }
+    return GetPrimitiveImpl(chacha20_poly1305_key);
+  } else {
+    return ToStatusF(util::error::INVALID_ARGUMENT,
+                     "Key type '%s' is not supported by this manager.",
+                     key_data.type_url().c_str());
+  }
+}
+
+StatusOr<std::unique_ptr<Aead>> ChaCha20Poly1305KeyManager::GetPrimitive(
+    const MessageLite& key) const {
+  std::string key_type = std::string(kKeyTypePrefix) + key.GetTypeName();
+  if (DoesSupport(key_type)) {
+    const ChaCha20Poly1305Key& chacha20_poly1305_key =
+        reinterpret_cast<const ChaCha20Poly1305Key&>(key);
+    return GetPrimitiveImpl(chacha20_poly1305_key);
+  } else {
+    return ToStatusF(util::error::INVALID_ARGUMENT,
+                     "Key type '%s' is not supported by this manager.",
+                     key_type.c_str());
+  }
+}
+
+StatusOr<std::unique_ptr<Aead>> ChaCha20Poly1305KeyManager::GetPrimitiveImpl(
+    const ChaCha20Poly1305Key& chacha20_poly1305_key) const {
+  Status status = Validate(chacha20_poly1305_key);
+  if (!status.ok()) return status;
+  auto chacha20_poly1305_result = subtle::ChaCha20Poly1305BoringSsl::New(
+      chacha20_poly1305_key.key_value());
+  if (!chacha20_poly1305_result.ok())
+    return chacha20_poly1305_result.status();
+  return std::move(chacha20_poly1305_result.ValueOrDie());
+}
+
+// static
+Status ChaCha20Poly1305KeyManager::Validate(const ChaCha20Poly1305Key& key) {
+  Status status = ValidateVersion(key.version(), kVersion);
+  if (!status.ok()) return status;
+  uint32_t key_size = key.key_value().size();
+  if (key_size != kKeySizeInBytes) {
+    return ToStatusF(util::error::INVALID_ARGUMENT,
+                     "Invalid ChaCha20Poly1305Key: key_value has %d bytes; "
+                     "supported size: %d bytes.",
+                     key_size, kKeySizeInBytes);
+  }
+  return Status::OK;
+}
+
+// static
+Status ChaCha20Poly1305KeyManager::Validate(
+    const ChaCha20Poly1305KeyFormat& key_format) {
+  // ChaCha20Poly1305KeyFormat has no parameters.
+  return Status::OK;
+}
+
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,156 @@
+// Copyright 2018 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/aead/encrypted_journal_reader.h"
+
+#include "absl/strings/string_view.h"
+#include "tink/aead.h"
+#include "tink/aead/aead_factory.h"
+#include "tink/aead/encrypted_journal_writer.h"
+#include "tink/keyset_handle.h"
+#include "tink/random_access_stream.h"
+#include "tink/util/errors.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+
+namespace {
+
+typedef EncryptedJournalWriter Format;
+
+uint64_t LoadBigEndian(const char* p, int size) {
+  uint64_t value = 0;
+  for (int i = 0; i < size; i++) {
+    value = (value << 8) | static_cast<uint8_t>(p[i]);
+  }
+  return value;
+}
+
+util::Status InvalidJournal(const char* reason) {
+  return ToStatusF(util::error::INVALID_ARGUMENT,
+                   "Invalid journal: %s.", reason);
+}
+
+util::Status TruncatedJournal() {
+  return util::Status(util::error::DATA_LOSS,
+                      "Journal ends before its final group.");
+}
+
+}  // anonymous namespace
+
+// static
+util::StatusOr<std::unique_ptr<EncryptedJournalReader>>
+EncryptedJournalReader::New(const KeysetHandle& keyset_handle,
+                            absl::string_view associated_data,
+                            RandomAccessStream* journal) {
+  if (journal == nullptr) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "journal must be non-null");
+  }
+  auto aead_result = AeadFactory::GetPrimitive(keyset_handle);
+  if (!aead_result.ok()) return aead_result.status();
+  std::unique_ptr<EncryptedJournalReader> reader(new EncryptedJournalReader(
+      std::move(aead_result.ValueOrDie()), associated_data, journal));
+  util::Status status = reader->Init();
+  if (!status.ok()) return status;
+  return std::move(reader);
+}
+
+util::Status EncryptedJournalReader::Init() {
+  auto size_result = journal_->size();
+  if (!size_result.ok()) return size_result.status();
+  if (size_result.ValueOrDie() < Format::kHeaderSize) {
+    return TruncatedJournal();
+  }
+  header_.resize(Format::kHeaderSize);
+  util::Status status = journal_->PRead(0, header_.size(), &header_[0]);
+  if (!status.ok()) return status;
+  if (absl::string_view(header_).substr(0, Format::kMagicSize) !=
+      Format::kMagic) {
+    return InvalidJournal("wrong magic");
+  }
+  if (static_cast<uint8_t>(header_[Format::kMagicSize]) != Format::kVersion) {
+    return InvalidJournal("unsupported version");
+  }
+  position_ = header_.size();
+  return util::Status::OK;
+}
+
+util::Status EncryptedJournalReader::ReadGroup() {
+  auto size_result = journal_->size();
+  if (!size_result.ok()) return size_result.status();
+  uint64_t size = size_result.ValueOrDie();
+  if (size - position_ < Format::kGroupHeaderSize) return TruncatedJournal();
+  char group_header[Format::kGroupHeaderSize];
+  util::Status status =
+      journal_->PRead(position_, sizeof(group_header), group_header);
+  if (!status.ok()) return status;
+  uint8_t last = static_cast<uint8_t>(group_header[0]);
+  uint64_t ciphertext_size = LoadBigEndian(group_header + 1, 4);
+  if (last > 1 || ciphertext_size > Format::kMaxGroupCiphertextSize) {
+    return InvalidJournal("malformed group header");
+  }
+  if (size - position_ - Format::kGroupHeaderSize < ciphertext_size) {
+    return TruncatedJournal();
+  }
+  ciphertext_.resize(ciphertext_size);
+  status = journal_->PRead(position_ + Format::kGroupHeaderSize,
+                           ciphertext_size, &ciphertext_[0]);
+  if (!status.ok()) return status;
+  auto decrypt_result = aead_->Decrypt(
+      ciphertext_, Format::GroupAssociatedData(header_, group_index_,
+                                               last == 1, associated_data_));
+  if (!decrypt_result.ok()) return InvalidJournal("decryption failed");
+  uint64_t group_end = position_ + Format::kGroupHeaderSize + ciphertext_size;
+  if (last == 1) {
+    if (!decrypt_result.ValueOrDie().empty()) {
+      return InvalidJournal("non-empty final group");
+    }
+    if (group_end != size) return InvalidJournal("data after final group");
+    finished_ = true;
+  }
+  position_ = group_end;
+  group_index_++;
+  events_ = std::move(decrypt_result.ValueOrDie());
+  events_position_ = 0;
+  return util::Status::OK;
+}
+
+util::StatusOr<std::string> EncryptedJournalReader::Next() {
+  while (events_position_ == events_.size()) {
+    if (finished_) {
+      return util::Status(util::error::OUT_OF_RANGE, "End of journal.");
+    }
+    util::Status status = ReadGroup();
+    if (!status.ok()) return status;
+  }
+  if (events_.size() - events_position_ < 4) {
+    return InvalidJournal("malformed group");
+  }
+  uint64_t event_size = LoadBigEndian(&events_[events_position_], 4);
+  events_position_ += 4;
+  if (events_.size() - events_position_ < event_size) {
+    return InvalidJournal("malformed group");
+  }
+  std::string event = events_.substr(events_position_, event_size);
+  events_position_ += event_size;
+  return std::move(event);
+}
+
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,86 @@
+// Copyright 2018 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_AEAD_ENCRYPTED_JOURNAL_READER_H_
+#define TINK_AEAD_ENCRYPTED_JOURNAL_READER_H_
+
+#include <memory>
+#include <string>
+
+#include "absl/strings/string_view.h"
+#include "tink/aead.h"
+#include "tink/keyset_handle.h"
+#include "tink/random_access_stream.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+
+///////////////////////////////////////////////////////////////////////////////
+// Reads the events of a journal written by EncryptedJournalWriter (see
+// there for the format) in the order in which they were appended. Each
+// group is decrypted and verified before any of its events is returned.
+//
+// A reader is not thread-safe.
+class EncryptedJournalReader {
+ public:
+  // Returns a reader for the journal in 'journal', which must start at
+  // position 0 and outlive the reader.
+  static crypto::tink::util::StatusOr<std::unique_ptr<EncryptedJournalReader>>
+  New(const KeysetHandle& keyset_handle, absl::string_view associated_data,
+      RandomAccessStream* journal);
+
+  // Returns the next event. After the last event, returns OUT_OF_RANGE if
+  // the journal was closed by its writer, and DATA_LOSS if it ends before
+  // its final group, e.g. because the writer crashed; the events of all
+  // complete groups are returned before either status.
+  crypto::tink::util::StatusOr<std::string> Next();
+
+ private:
+  EncryptedJournalReader(std::unique_ptr<Aead> aead,
+                         absl::string_view associated_data,
+                         RandomAccessStream* journal)
+      : aead_(std::move(aead)),
+        associated_data_(associated_data),
+        journal_(journal),
+        position_(0),
+        group_index_(0),
+        events_position_(0),
+        finished_(false) {}
+
+  // Reads and verifies the header.
+  crypto::tink::util::Status Init();
+
+  // Reads, verifies and decrypts the next group into events_.
+  crypto::tink::util::Status ReadGroup();
+
+  const std::unique_ptr<Aead> aead_;
+  const std::string associated_data_;
+  RandomAccessStream* const journal_;
+  std::string header_;
+  uint64_t position_;  // of the next group in the journal
+  uint64_t group_index_;
+  std::string ciphertext_;
+  std::string events_;  // of the current group
+  size_t events_position_;
+  bool finished_;  // whether the final group has been read
+};
+
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_AEAD_ENCRYPTED_JOURNAL_READER_H_
@@ -0,0 +1,183 @@
+// Copyright 2018 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/aead/encrypted_journal_reader.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "tink/aead/aead_config.h"
+#include "tink/aead/aead_key_templates.h"
+#include "tink/aead/encrypted_journal_writer.h"
+#include "tink/keyset_handle.h"
+#include "tink/util/buffer_random_access_stream.h"
+#include "tink/util/file_random_access_stream.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace {
+
+class EncryptedJournalReaderTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    ASSERT_TRUE(AeadConfig::Register().ok());
+    auto handle_result =
+        KeysetHandle::GenerateNew(AeadKeyTemplates::Aes128Gcm());
+    ASSERT_TRUE(handle_result.ok()) << handle_result.status();
+    keyset_handle_ = std::move(handle_result.ValueOrDie());
+  }
+
+  // Writes 'events' to a journal, with a sync after each of the events
+  // listed in 'group_ends', and returns the journal.
+  std::string WriteJournal(const std::vector<std::string>& events,
+                           const std::vector<int>& group_ends) {
+    std::string filename = std::string(getenv("TEST_TMPDIR")) +
+                           "/encrypted_journal_reader_test.journal";
+    int fd = open(filename.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0600);
+    EXPECT_LE(0, fd);
+    auto writer = std::move(
+        EncryptedJournalWriter::New(*keyset_handle_, "ad", fd, 64)
+            .ValueOrDie());
+    for (int i = 0; i < events.size(); i++) {
+      auto sequence_result = writer->Append(events[i]);
+      EXPECT_TRUE(sequence_result.ok());
+      for (int end : group_ends) {
+        if (end == i) {
+          EXPECT_TRUE(writer->WaitDurable(sequence_result.ValueOrDie()).ok());
+        }
+      }
+    }
+    EXPECT_TRUE(writer->Close().ok());
+    util::FileRandomAccessStream stream(fd);
+    uint64_t size = stream.size().ValueOrDie();
+    std::string journal(size, '\0');
+    EXPECT_TRUE(stream.PRead(0, size, &journal[0]).ok());
+    close(fd);
+    return journal;
+  }
+
+  // Reads the events of 'journal' into 'events', and returns the status
+  // that ended the reading.
+  util::Status ReadJournal(const std::string& journal,
+                           absl::string_view associated_data,
+                           std::vector<std::string>* events) {
+    util::BufferRandomAccessStream stream(journal);
+    auto reader_result =
+        EncryptedJournalReader::New(*keyset_handle_, associated_data, &stream);
+    if (!reader_result.ok()) return reader_result.status();
+    auto reader = std::move(reader_result.ValueOrDie());
+    while (true) {
+      auto event_result = reader->Next();
+      if (!event_result.ok()) return event_result.status();
+      events->push_back(event_result.ValueOrDie());
+    }
+  }
+
+  std::unique_ptr<KeysetHandle> keyset_handle_;
+};
+
+TEST_F(EncryptedJournalReaderTest, testRead) {
+  std::vector<std::string> events = {"first", "", "third",
+                                     std::string(100000, 'e'), "last"};
+  std::string journal = WriteJournal(events, {0, 2});
+  std::vector<std::string> read_events;
+  util::Status status = ReadJournal(journal, "ad", &read_events);
+  EXPECT_EQ(util::error::OUT_OF_RANGE, status.error_code()) << status;
+  EXPECT_EQ(events, read_events);
+}
+
+TEST_F(EncryptedJournalReaderTest, testWrongAssociatedData) {
+  std::string journal = WriteJournal({"event"}, {});
+  std::vector<std::string> read_events;
+  util::Status status = ReadJournal(journal, "other", &read_events);
+  EXPECT_EQ(util::error::INVALID_ARGUMENT, status.error_code()) << status;
+  EXPECT_TRUE(read_events.empty());
+}
+
+TEST_F(EncryptedJournalReaderTest, testTruncatedJournal) {
+  std::vector<std::string> events = {"0", "1", "2", "3"};
+  std::string journal = WriteJournal(events, {0, 1, 2});
+  for (size_t size = 0; size < journal.size(); size++) {
+    std::vector<std::string> read_events;
+    util::Status status =
+        ReadJournal(journal.substr(0, size), "ad", &read_events);
+    EXPECT_EQ(util::error::DATA_LOSS, status.error_code())
+        << size << ": " << status;
+    // The events of the complete groups are still returned.
+    ASSERT_LE(read_events.size(), events.size());
+    for (int i = 0; i < read_events.size(); i++) {
+      EXPECT_EQ(events[i], read_events[i]);
+    }
+  }
+}
+
+TEST_F(EncryptedJournalReaderTest, testModifiedJournal) {
+  std::vector<std::string> events = {"0", "1", "2", "3"};
+  std::string journal = WriteJournal(events, {0, 1, 2});
+  for (size_t position = 0; position < journal.size(); position++) {
+    std::string modified = journal;
+    modified[position] ^= 0x01;
+    std::vector<std::string> read_events;
+    util::Status status = ReadJournal(modified, "ad", &read_events);
+    EXPECT_NE(util::error::OUT_OF_RANGE, status.error_code()) << position;
+  }
+  std::vector<std::string> read_events;
+  EXPECT_FALSE(ReadJournal(journal + "x", "ad", &read_events).ok());
+}
+
+TEST_F(EncryptedJournalReaderTest, testReorderedGroups) {
+  std::string journal = WriteJournal({"0", "1"}, {0});
+  // Both groups have the same size, so they can be swapped.
+  size_t group_size = (journal.size() - EncryptedJournalWriter::kHeaderSize -
+                       EncryptedJournalWriter::kGroupHeaderSize - 5 - 28) / 2;
+  std::string reordered =
+      journal.substr(0, EncryptedJournalWriter::kHeaderSize) +
+      journal.substr(EncryptedJournalWriter::kHeaderSize + group_size,
+                     group_size) +
+      journal.substr(EncryptedJournalWriter::kHeaderSize, group_size) +
+      journal.substr(EncryptedJournalWriter::kHeaderSize + 2 * group_size);
+  std::vector<std::string> read_events;
+  util::Status status = ReadJournal(reordered, "ad", &read_events);
+  EXPECT_EQ(util::error::INVALID_ARGUMENT, status.error_code()) << status;
+  EXPECT_TRUE(read_events.empty());
+}
+
+TEST_F(EncryptedJournalReaderTest, testInvalidArguments) {
+  EXPECT_FALSE(EncryptedJournalReader::New(*keyset_handle_, "ad", nullptr)
+                   .ok());
+  std::string journal = WriteJournal({}, {});
+  journal[0] = 'X';
+  util::BufferRandomAccessStream stream(journal);
+  auto reader_result =
+      EncryptedJournalReader::New(*keyset_handle_, "ad", &stream);
+  EXPECT_EQ(util::error::INVALID_ARGUMENT,
+            reader_result.status().error_code());
+}
+
+}  // namespace
+}  // namespace tink
+}  // namespace crypto
+
+int main(int ac, char* av[]) {
+  testing::InitGoogleTest(&ac, av);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,333 @@
+// Copyright 2018 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/aead/encrypted_journal_writer.h"
+
+#include <errno.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include "absl/strings/string_view.h"
+#include "tink/aead.h"
+#include "tink/aead/aead_factory.h"
+#include "tink/keyset_handle.h"
+#include "tink/subtle/random.h"
+#include "tink/util/errors.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+
+namespace {
+
+// The writer thread stops adding events to a group once the group holds
+// this many bytes.
+const size_t kGroupSize = 1 << 22;
+
+void AppendBigEndian(uint64_t value, int size, std::string* out) {
+  for (int shift = 8 * (size - 1); shift >= 0; shift -= 8) {
+    out->push_back(static_cast<char>(value >> shift));
+  }
+}
+
+// Writes all 'count' buffers of 'iov' to 'fd', retrying partial writes.
+// Modifies 'iov'.
+util::Status WriteAll(int fd, struct iovec* iov, int count) {
+  while (count > 0) {
+    ssize_t written = writev(fd, iov, count);
+    if (written < 0) {
+      if (errno == EINTR) continue;
+      return ToStatusF(util::error::INTERNAL,
+                       "writev failed with errno %d.", errno);
+    }
+    while (count > 0 && static_cast<size_t>(written) >= iov->iov_len) {
+      written -= iov->iov_len;
+      iov++;
+      count--;
+    }
+    if (count > 0) {
+      iov->iov_base = static_cast<char*>(iov->iov_base) + written;
+      iov->iov_len -= written;
+    }
+  }
+  return util::Status::OK;
+}
+
+}  // anonymous namespace
+
+constexpr char EncryptedJournalWriter::kMagic[];
+constexpr int EncryptedJournalWriter::kMagicSize;
+constexpr uint8_t EncryptedJournalWriter::kVersion;
+constexpr int EncryptedJournalWriter::kJournalIdSize;
+constexpr int EncryptedJournalWriter::kHeaderSize;
+constexpr int EncryptedJournalWriter::kGroupHeaderSize;
+constexpr uint32_t EncryptedJournalWriter::kMaxEventSize;
+constexpr uint32_t EncryptedJournalWriter::kMaxGroupCiphertextSize;
+
+// static
+util::StatusOr<std::unique_ptr<EncryptedJournalWriter>>
+EncryptedJournalWriter::New(const KeysetHandle& keyset_handle,
+                            absl::string_view associated_data, int fd,
+                            uint32_t queue_capacity) {
+  if (fd < 0) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "fd must be a valid file descriptor");
+  }
+  // EncryptedJournalReader expects the header at offset 0, so a regular
+  // file must be empty, and writes must start at its beginning.
+  struct stat fd_stat;
+  if (fstat(fd, &fd_stat) != 0) {
+    return ToStatusF(util::error::INVALID_ARGUMENT,
+                     "fstat failed with errno %d.", errno);
+  }
+  if (S_ISREG(fd_stat.st_mode) &&
+      (fd_stat.st_size != 0 || lseek(fd, 0, SEEK_CUR) != 0)) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "fd must refer to an empty file at offset 0");
+  }
+  if (queue_capacity == 0 || (queue_capacity & (queue_capacity - 1)) != 0) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "queue_capacity must be a power of two");
+  }
+  auto aead_result = AeadFactory::GetPrimitive(keyset_handle);
+  if (!aead_result.ok()) return aead_result.status();
+  std::unique_ptr<EncryptedJournalWriter> writer(new EncryptedJournalWriter(
+      std::move(aead_result.ValueOrDie()), associated_data, fd,
+      queue_capacity));
+  writer->thread_ = std::thread(&EncryptedJournalWriter::Run, writer.get());
+  return std::move(writer);
+}
+
+EncryptedJournalWriter::EncryptedJournalWriter(
+    std::unique_ptr<Aead> aead, absl::string_view associated_data, int fd,
+    uint32_t queue_capacity)
+    : aead_(std::move(aead)),
+      associated_data_(associated_data),
+      fd_(fd),
+      header_written_(false),
+      slots_(new Slot[queue_capacity]),
+      mask_(queue_capacity - 1),
+      tail_(0),
+      head_(0),
+      closing_(false),
+      failed_(false),
+      writer_waiting_(false),
+      producers_waiting_(0),
+      durable_count_(0),
+      closed_(false) {
+  for (uint32_t i = 0; i < queue_capacity; i++) {
+    slots_[i].sequence.store(i, std::memory_order_relaxed);
+  }
+  header_.append(kMagic, kMagicSize);
+  header_.push_back(static_cast<char>(kVersion));
+  header_.append(subtle::Random::GetRandomBytes(kJournalIdSize));
+}
+
+EncryptedJournalWriter::~EncryptedJournalWriter() {
+  if (!closed_) Close();
+}
+
+// static
+std::string EncryptedJournalWriter::GroupAssociatedData(
+    absl::string_view header, uint64_t group_index, bool last,
+    absl::string_view associated_data) {
+  std::string data;
+  data.reserve(header.size() + 9 + associated_data.size());
+  data.append(header.data(), header.size());
+  data.push_back(last ? 0x01 : 0x00);
+  AppendBigEndian(group_index, 8, &data);
+  data.append(associated_data.data(), associated_data.size());
+  return data;
+}
+
+util::StatusOr<uint64_t> EncryptedJournalWriter::Append(std::string event) {
+  if (event.size() > kMaxEventSize) {
+    return util::Status(util::error::INVALID_ARGUMENT, "event too large");
+  }
+  if (closing_.load()) {
+    return util::Status(util::error::FAILED_PRECONDITION,
+                        "journal already closed");
+  }
+  // Claim the slot of the next sequence number. A slot whose sequence is
+  // behind still holds an event of the previous round of the ring.
+  uint64_t sequence = tail_.load(std::memory_order_relaxed);
+  Slot* slot;
+  while (true) {
+    if (failed_.load()) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      return status_;
+    }
+    slot = &slots_[sequence & mask_];
+    uint64_t slot_sequence = slot->sequence.load(std::memory_order_acquire);
+    if (slot_sequence == sequence) {
+      if (tail_.compare_exchange_weak(sequence, sequence + 1,
+                                      std::memory_order_relaxed)) {
+        break;
+      }
+    } else if (slot_sequence < sequence) {
+      // The ring is full.
+      producers_waiting_.fetch_add(1);
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        space_cv_.wait(lock, [slot, slot_sequence, this]() {
+          return slot->sequence.load() != slot_sequence || failed_.load();
+        });
+      }
+      producers_waiting_.fetch_sub(1);
+      sequence = tail_.load(std::memory_order_relaxed);
+    } else {
+      sequence = tail_.load(std::memory_order_relaxed);
+    }
+  }
+  slot->event = std::move(event);
+  slot->sequence.store(sequence + 1);
+  if (writer_waiting_.load()) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    writer_cv_.notify_one();
+  }
+  return sequence;
+}
+
+util::Status EncryptedJournalWriter::WaitDurable(uint64_t sequence) {
+  if (sequence >= tail_.load()) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "no event with this sequence number");
+  }
+  std::unique_lock<std::mutex> lock(mutex_);
+  durable_cv_.wait(lock, [sequence, this]() {
+    return durable_count_ > sequence || !status_.ok();
+  });
+  if (durable_count_ > sequence) return util::Status::OK;
+  return status_;
+}
+
+util::Status EncryptedJournalWriter::Close() {
+  if (closed_) {
+    return util::Status(util::error::FAILED_PRECONDITION,
+                        "journal already closed");
+  }
+  closed_ = true;
+  closing_.store(true);
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    writer_cv_.notify_one();
+  }
+  thread_.join();
+  std::lock_guard<std::mutex> lock(mutex_);
+  return status_;
+}
+
+bool EncryptedJournalWriter::EventReady() const {
+  return slots_[head_ & mask_].sequence.load() == head_ + 1;
+}
+
+bool EncryptedJournalWriter::WaitForEvent() {
+  if (EventReady()) return true;
+  // Producers only take the mutex to wake the writer thread while it
+  // waits, so that the common path of Append() stays lock-free.
+  writer_waiting_.store(true);
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    writer_cv_.wait(lock,
+                    [this]() { return EventReady() || closing_.load(); });
+  }
+  writer_waiting_.store(false);
+  return EventReady();
+}
+
+void EncryptedJournalWriter::Run() {
+  const uint64_t capacity = mask_ + 1;
+  uint64_t group_index = 0;
+  std::string events;
+  while (WaitForEvent()) {
+    events.clear();
+    // Take every event that is ready, up to the group size.
+    while (events.size() < kGroupSize && EventReady()) {
+      Slot& slot = slots_[head_ & mask_];
+      AppendBigEndian(slot.event.size(), 4, &events);
+      events.append(slot.event);
+      slot.event.clear();
+      slot.sequence.store(head_ + capacity);
+      head_++;
+    }
+    if (producers_waiting_.load() > 0) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      space_cv_.notify_all();
+    }
+    util::Status status = WriteGroup(group_index++, false, events);
+    if (!status.ok()) {
+      Fail(status);
+      return;
+    }
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      durable_count_ = head_;
+    }
+    durable_cv_.notify_all();
+  }
+  util::Status status = WriteGroup(group_index, true, "");
+  if (!status.ok()) Fail(status);
+}
+
+util::Status EncryptedJournalWriter::WriteGroup(uint64_t group_index,
+                                                bool last,
+                                                absl::string_view events) {
+  auto encrypt_result = aead_->Encrypt(
+      events,
+      GroupAssociatedData(header_, group_index, last, associated_data_));
+  if (!encrypt_result.ok()) return encrypt_result.status();
+  std::string& ciphertext = encrypt_result.ValueOrDie();
+  if (ciphertext.size() > kMaxGroupCiphertextSize) {
+    return util::Status(util::error::INTERNAL, "group too large");
+  }
+  std::string group_header;
+  group_header.push_back(last ? 0x01 : 0x00);
+  AppendBigEndian(ciphertext.size(), 4, &group_header);
+
+  struct iovec iov[3];
+  int count = 0;
+  if (!header_written_) {
+    iov[count].iov_base = &header_[0];
+    iov[count++].iov_len = header_.size();
+  }
+  iov[count].iov_base = &group_header[0];
+  iov[count++].iov_len = group_header.size();
+  iov[count].iov_base = &ciphertext[0];
+  iov[count++].iov_len = ciphertext.size();
+  util::Status status = WriteAll(fd_, iov, count);
+  if (!status.ok()) return status;
+  header_written_ = true;
+  if (fdatasync(fd_) != 0) {
+    return ToStatusF(util::error::INTERNAL,
+                     "fdatasync failed with errno %d.", errno);
+  }
+  return util::Status::OK;
+}
+
+void EncryptedJournalWriter::Fail(const util::Status& status) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    status_ = status;
+    failed_.store(true);
+  }
+  space_cv_.notify_all();
+  durable_cv_.notify_all();
+}
+
+}  // namespace tink
+}  // namespace crypto
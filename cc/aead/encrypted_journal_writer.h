@@ -0,0 +1,175 @@
+// Copyright 2018 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_AEAD_ENCRYPTED_JOURNAL_WRITER_H_
+#define TINK_AEAD_ENCRYPTED_JOURNAL_WRITER_H_
+
+#include <atomic>
+#include <condition_variable>  // NOLINT(build/c++11)
+#include <memory>
+#include <mutex>  // NOLINT(build/c++11)
+#include <string>
+#include <thread>  // NOLINT(build/c++11)
+
+#include "absl/strings/string_view.h"
+#include "tink/aead.h"
+#include "tink/keyset_handle.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+
+///////////////////////////////////////////////////////////////////////////////
+// An append-only journal of encrypted events with group commit: many
+// threads append events concurrently, and a single writer thread encrypts
+// all events that are pending at a time as one group, writes the group
+// with one writev(2) and makes it durable with one fdatasync(2). The cost
+// of encryption setup and of the sync is thus shared by all events of a
+// group, and throughput grows with the number of concurrent producers
+// instead of being bounded by the sync latency.
+//
+//   auto writer_result = EncryptedJournalWriter::New(
+//       keyset_handle, "associated data", fd, 4096);
+//   auto& writer = writer_result.ValueOrDie();
+//   // In any number of threads:
+//   auto sequence_result = writer->Append(event);
+//   auto status = writer->WaitDurable(sequence_result.ValueOrDie());
+//   // Once all producers are done:
+//   status = writer->Close();
+//
+// Producers hand events to the writer thread through a bounded lock-free
+// ring; Append() only blocks when the ring is full.
+//
+// Each group is encrypted with the primary Aead of the keyset, with its
+// position in the journal as part of the associated data, so groups cannot
+// be reordered, dropped or moved to another journal without detection.
+// Close() appends an empty final group, which lets EncryptedJournalReader
+// tell a complete journal from a truncated one. The journal layout is
+// (integers are big endian):
+//
+//   header: "TKJL" || version (1 byte) || journal_id (16 random bytes)
+//   group:  last (1 byte, 0x01 for the final group, else 0x00) ||
+//           ciphertext_size (4 bytes) ||
+//           Encrypt(events, header || last || group_index (8 bytes) ||
+//                           associated_data)
+//   events: the concatenation of event_size (4 bytes) || event for each
+//           event of the group.
+class EncryptedJournalWriter {
+ public:
+  // Returns a writer that writes the journal to the file descriptor 'fd'.
+  // If 'fd' refers to a regular file, the file must be empty and 'fd' must
+  // be at offset 0, since the journal header is read from offset 0.
+  // The descriptor is not owned; the caller must keep it open until
+  // Close() returns. 'queue_capacity' is
+  // the number of events that may be pending at a time, and must be a
+  // power of two.
+  static crypto::tink::util::StatusOr<std::unique_ptr<EncryptedJournalWriter>>
+  New(const KeysetHandle& keyset_handle, absl::string_view associated_data,
+      int fd, uint32_t queue_capacity);
+
+  // Queues 'event' for the next group and returns its sequence number,
+  // i.e. the number of events appended before it. Thread-safe.
+  crypto::tink::util::StatusOr<uint64_t> Append(std::string event);
+
+  // Blocks until the event with the given sequence number has been synced
+  // to the file. Thread-safe.
+  crypto::tink::util::Status WaitDurable(uint64_t sequence);
+
+  // Writes all pending events and the final group, and stops the writer
+  // thread. Must not be called concurrently with Append(). The writer
+  // cannot be used afterwards.
+  crypto::tink::util::Status Close();
+
+  // Calls Close() if it has not been called yet.
+  ~EncryptedJournalWriter();
+
+  // Format constants shared with EncryptedJournalReader.
+  static constexpr char kMagic[] = "TKJL";
+  static constexpr int kMagicSize = 4;
+  static constexpr uint8_t kVersion = 1;
+  static constexpr int kJournalIdSize = 16;
+  static constexpr int kHeaderSize = kMagicSize + 1 + kJournalIdSize;
+  static constexpr int kGroupHeaderSize = 1 + 4;
+  static constexpr uint32_t kMaxEventSize = 1 << 24;
+  static constexpr uint32_t kMaxGroupCiphertextSize = 1 << 26;
+
+  // Returns the associated data of group 'group_index' of the journal with
+  // the given 'header'.
+  static std::string GroupAssociatedData(absl::string_view header,
+                                         uint64_t group_index, bool last,
+                                         absl::string_view associated_data);
+
+ private:
+  // An entry of the ring. 'sequence' is the sequence number of the event
+  // the slot may next be claimed for, plus one once the event is stored.
+  struct Slot {
+    std::atomic<uint64_t> sequence;
+    std::string event;
+  };
+
+  EncryptedJournalWriter(std::unique_ptr<Aead> aead,
+                         absl::string_view associated_data, int fd,
+                         uint32_t queue_capacity);
+
+  // The loop of the writer thread.
+  void Run();
+
+  // Returns true if the event at head_ has been stored.
+  bool EventReady() const;
+
+  // Waits until the event at head_ has been stored or the journal is being
+  // closed, and returns EventReady().
+  bool WaitForEvent();
+
+  // Encrypts 'events' as group 'group_index', writes it and syncs the file.
+  crypto::tink::util::Status WriteGroup(uint64_t group_index, bool last,
+                                        absl::string_view events);
+
+  // Records the failure of the writer thread and wakes up all waiters.
+  void Fail(const crypto::tink::util::Status& status);
+
+  const std::unique_ptr<Aead> aead_;
+  const std::string associated_data_;
+  const int fd_;
+  std::string header_;
+  bool header_written_;  // accessed by the writer thread only
+
+  const std::unique_ptr<Slot[]> slots_;
+  const uint64_t mask_;
+  std::atomic<uint64_t> tail_;  // the next sequence number to claim
+  uint64_t head_;  // the next event to write; writer thread only
+
+  std::atomic<bool> closing_;
+  std::atomic<bool> failed_;
+  std::atomic<bool> writer_waiting_;
+  std::atomic<int> producers_waiting_;
+
+  std::mutex mutex_;
+  std::condition_variable writer_cv_;
+  std::condition_variable space_cv_;
+  std::condition_variable durable_cv_;
+  uint64_t durable_count_;                 // guarded by mutex_
+  crypto::tink::util::Status status_;      // guarded by mutex_
+
+  std::thread thread_;
+  bool closed_;
+};
+
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_AEAD_ENCRYPTED_JOURNAL_WRITER_H_
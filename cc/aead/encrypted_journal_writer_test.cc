@@ -0,0 +1,258 @@
+// Copyright 2018 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/aead/encrypted_journal_writer.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>  // NOLINT(build/c++11)
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "tink/aead/aead_config.h"
+#include "tink/aead/aead_key_templates.h"
+#include "tink/aead/encrypted_journal_reader.h"
+#include "tink/keyset_handle.h"
+#include "tink/util/buffer_random_access_stream.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace {
+
+std::string Event(int producer, int i) {
+  return std::to_string(producer) + ":" + std::to_string(i);
+}
+
+class EncryptedJournalWriterTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    ASSERT_TRUE(AeadConfig::Register().ok());
+    auto handle_result =
+        KeysetHandle::GenerateNew(AeadKeyTemplates::Aes128Gcm());
+    ASSERT_TRUE(handle_result.ok()) << handle_result.status();
+    keyset_handle_ = std::move(handle_result.ValueOrDie());
+    const char* test_name =
+        ::testing::UnitTest::GetInstance()->current_test_info()->name();
+    filename_ = std::string(getenv("TEST_TMPDIR")) + "/" + test_name +
+                ".journal";
+    fd_ = open(filename_.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0600);
+    ASSERT_LE(0, fd_);
+  }
+
+  void TearDown() override { close(fd_); }
+
+  std::string ReadFile() {
+    std::ifstream input(filename_, std::ios::binary);
+    std::stringstream contents;
+    contents << input.rdbuf();
+    return contents.str();
+  }
+
+  // Returns all events of 'journal', and expects it to be complete.
+  std::vector<std::string> ReadEvents(const std::string& journal) {
+    std::vector<std::string> events;
+    util::BufferRandomAccessStream stream(journal);
+    auto reader_result =
+        EncryptedJournalReader::New(*keyset_handle_, "ad", &stream);
+    EXPECT_TRUE(reader_result.ok()) << reader_result.status();
+    if (!reader_result.ok()) return events;
+    auto reader = std::move(reader_result.ValueOrDie());
+    while (true) {
+      auto event_result = reader->Next();
+      if (!event_result.ok()) {
+        EXPECT_EQ(util::error::OUT_OF_RANGE,
+                  event_result.status().error_code())
+            << event_result.status();
+        return events;
+      }
+      events.push_back(event_result.ValueOrDie());
+    }
+  }
+
+  // Returns the number of groups in 'journal'.
+  int CountGroups(const std::string& journal) {
+    int groups = 0;
+    size_t position = EncryptedJournalWriter::kHeaderSize;
+    while (position + EncryptedJournalWriter::kGroupHeaderSize <=
+           journal.size()) {
+      size_t size = 0;
+      for (int i = 1; i < EncryptedJournalWriter::kGroupHeaderSize; i++) {
+        size = (size << 8) | static_cast<uint8_t>(journal[position + i]);
+      }
+      position += EncryptedJournalWriter::kGroupHeaderSize + size;
+      groups++;
+    }
+    return groups;
+  }
+
+  std::unique_ptr<KeysetHandle> keyset_handle_;
+  std::string filename_;
+  int fd_;
+};
+
+TEST_F(EncryptedJournalWriterTest, testConcurrentProducers) {
+  const int kProducers = 8;
+  const int kEvents = 200;
+  auto writer = std::move(
+      EncryptedJournalWriter::New(*keyset_handle_, "ad", fd_, 64)
+          .ValueOrDie());
+  std::vector<std::thread> threads;
+  std::vector<int> failures(kProducers, 0);
+  for (int p = 0; p < kProducers; p++) {
+    threads.emplace_back([&, p]() {
+      for (int i = 0; i < kEvents; i++) {
+        auto sequence_result = writer->Append(Event(p, i));
+        if (!sequence_result.ok() ||
+            !writer->WaitDurable(sequence_result.ValueOrDie()).ok()) {
+          failures[p]++;
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) thread.join();
+  for (int p = 0; p < kProducers; p++) EXPECT_EQ(0, failures[p]);
+  ASSERT_TRUE(writer->Close().ok());
+
+  std::string journal = ReadFile();
+  std::vector<std::string> events = ReadEvents(journal);
+  ASSERT_EQ(kProducers * kEvents, events.size());
+  // The events of each producer are in the order in which it appended them.
+  std::vector<int> next(kProducers, 0);
+  for (const std::string& event : events) {
+    int p = std::stoi(event.substr(0, event.find(':')));
+    ASSERT_EQ(Event(p, next[p]), event);
+    next[p]++;
+  }
+  // Producers waiting for the same sync share a group.
+  EXPECT_LT(CountGroups(journal), kProducers * kEvents);
+}
+
+TEST_F(EncryptedJournalWriterTest, testFullQueue) {
+  const int kEvents = 1000;
+  auto writer = std::move(
+      EncryptedJournalWriter::New(*keyset_handle_, "ad", fd_, 2)
+          .ValueOrDie());
+  uint64_t last_sequence = 0;
+  for (int i = 0; i < kEvents; i++) {
+    auto sequence_result = writer->Append(Event(0, i));
+    ASSERT_TRUE(sequence_result.ok()) << sequence_result.status();
+    EXPECT_EQ(i, sequence_result.ValueOrDie());
+    last_sequence = sequence_result.ValueOrDie();
+  }
+  EXPECT_TRUE(writer->WaitDurable(last_sequence).ok());
+  ASSERT_TRUE(writer->Close().ok());
+
+  std::vector<std::string> events = ReadEvents(ReadFile());
+  ASSERT_EQ(kEvents, events.size());
+  for (int i = 0; i < kEvents; i++) EXPECT_EQ(Event(0, i), events[i]);
+}
+
+TEST_F(EncryptedJournalWriterTest, testEmptyJournal) {
+  auto writer = std::move(
+      EncryptedJournalWriter::New(*keyset_handle_, "ad", fd_, 16)
+          .ValueOrDie());
+  ASSERT_TRUE(writer->Close().ok());
+  std::string journal = ReadFile();
+  EXPECT_EQ(1, CountGroups(journal));
+  EXPECT_TRUE(ReadEvents(journal).empty());
+}
+
+TEST_F(EncryptedJournalWriterTest, testCloseInDestructor) {
+  {
+    auto writer = std::move(
+        EncryptedJournalWriter::New(*keyset_handle_, "ad", fd_, 16)
+            .ValueOrDie());
+    ASSERT_TRUE(writer->Append("event").ok());
+  }
+  std::vector<std::string> events = ReadEvents(ReadFile());
+  ASSERT_EQ(1, events.size());
+  EXPECT_EQ("event", events[0]);
+}
+
+TEST_F(EncryptedJournalWriterTest, testErrors) {
+  EXPECT_FALSE(
+      EncryptedJournalWriter::New(*keyset_handle_, "ad", -1, 16).ok());
+  EXPECT_FALSE(
+      EncryptedJournalWriter::New(*keyset_handle_, "ad", fd_, 0).ok());
+  EXPECT_FALSE(
+      EncryptedJournalWriter::New(*keyset_handle_, "ad", fd_, 12).ok());
+
+  auto writer = std::move(
+      EncryptedJournalWriter::New(*keyset_handle_, "ad", fd_, 16)
+          .ValueOrDie());
+  EXPECT_FALSE(writer->WaitDurable(0).ok());
+  EXPECT_FALSE(
+      writer->Append(std::string(EncryptedJournalWriter::kMaxEventSize + 1,
+                                 'e')).ok());
+  ASSERT_TRUE(writer->Close().ok());
+  auto append_result = writer->Append("event");
+  EXPECT_FALSE(append_result.ok());
+  EXPECT_EQ(util::error::FAILED_PRECONDITION,
+            append_result.status().error_code());
+  EXPECT_FALSE(writer->Close().ok());
+}
+
+TEST_F(EncryptedJournalWriterTest, testFileNotAtStart) {
+  // The reader expects the header at offset 0.
+  ASSERT_EQ(3, lseek(fd_, 3, SEEK_SET));
+  auto writer_result =
+      EncryptedJournalWriter::New(*keyset_handle_, "ad", fd_, 16);
+  EXPECT_EQ(util::error::INVALID_ARGUMENT,
+            writer_result.status().error_code());
+
+  // Nor can a journal be appended to existing data, e.g. with O_APPEND.
+  ASSERT_EQ(0, lseek(fd_, 0, SEEK_SET));
+  ASSERT_EQ(4, write(fd_, "data", 4));
+  int append_fd = open(filename_.c_str(), O_WRONLY | O_APPEND);
+  ASSERT_LE(0, append_fd);
+  auto append_result =
+      EncryptedJournalWriter::New(*keyset_handle_, "ad", append_fd, 16);
+  EXPECT_EQ(util::error::INVALID_ARGUMENT,
+            append_result.status().error_code());
+  close(append_fd);
+}
+
+TEST_F(EncryptedJournalWriterTest, testWriteFailure) {
+  int read_only_fd = open(filename_.c_str(), O_RDONLY);
+  ASSERT_LE(0, read_only_fd);
+  auto writer = std::move(
+      EncryptedJournalWriter::New(*keyset_handle_, "ad", read_only_fd, 4)
+          .ValueOrDie());
+  auto sequence_result = writer->Append("event");
+  ASSERT_TRUE(sequence_result.ok());
+  EXPECT_FALSE(writer->WaitDurable(sequence_result.ValueOrDie()).ok());
+  // Further events are rejected.
+  for (int i = 0; i < 8; i++) {
+    EXPECT_FALSE(writer->Append("event").ok());
+  }
+  EXPECT_FALSE(writer->Close().ok());
+  close(read_only_fd);
+}
+
+}  // namespace
+}  // namespace tink
+}  // namespace crypto
+
+int main(int ac, char* av[]) {
+  testing::InitGoogleTest(&ac, av);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,253 @@
+// Copyright 2018 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/aead/record_container_reader.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "absl/strings/string_view.h"
+#include "tink/aead.h"
+#include "tink/aead/record_container_writer.h"
+#include "tink/keyset_handle.h"
+#include "tink/primitive_set.h"
+#include "tink/registry.h"
+#include "tink/util/errors.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+
+namespace {
+
+typedef RecordContainerWriter Format;
+
+uint64_t LoadBigEndian(const char* p, int size) {
+  uint64_t value = 0;
+  for (int i = 0; i < size; i++) {
+    value = (value << 8) | static_cast<uint8_t>(p[i]);
+  }
+  return value;
+}
+
+util::Status InvalidContainer(const char* reason) {
+  return ToStatusF(util::error::INVALID_ARGUMENT,
+                   "Invalid record container: %s.", reason);
+}
+
+// Returns the entries of 'aead_set' for the key prefix 'prefix', or null.
+const PrimitiveSet<Aead>::Primitives* FindAeads(PrimitiveSet<Aead>* aead_set,
+                                                absl::string_view prefix) {
+  auto primitives_result = aead_set->get_primitives(std::string(prefix));
+  if (!primitives_result.ok()) return nullptr;
+  return primitives_result.ValueOrDie();
+}
+
+// Splits 'data' = prefix_size (1 byte) || prefix || rest.
+bool SplitPrefix(absl::string_view data, absl::string_view* prefix,
+                 absl::string_view* rest) {
+  if (data.empty()) return false;
+  size_t prefix_size = static_cast<uint8_t>(data[0]);
+  if (data.size() < 1 + prefix_size) return false;
+  *prefix = data.substr(1, prefix_size);
+  *rest = data.substr(1 + prefix_size);
+  return true;
+}
+
+}  // anonymous namespace
+
+// static
+util::StatusOr<std::unique_ptr<RecordContainerReader>>
+RecordContainerReader::New(const KeysetHandle& keyset_handle,
+                           absl::string_view associated_data,
+                           absl::string_view container) {
+  auto primitives_result =
+      Registry::GetPrimitives<Aead>(keyset_handle, nullptr);
+  if (!primitives_result.ok()) return primitives_result.status();
+  std::unique_ptr<RecordContainerReader> reader(new RecordContainerReader(
+      std::move(primitives_result.ValueOrDie()), associated_data, container,
+      nullptr));
+  util::Status status = reader->Init();
+  if (!status.ok()) return status;
+  return std::move(reader);
+}
+
+// static
+util::StatusOr<std::unique_ptr<RecordContainerReader>>
+RecordContainerReader::NewFromFile(const KeysetHandle& keyset_handle,
+                                   absl::string_view associated_data,
+                                   const std::string& filename) {
+  auto primitives_result =
+      Registry::GetPrimitives<Aead>(keyset_handle, nullptr);
+  if (!primitives_result.ok()) return primitives_result.status();
+  int fd = open(filename.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return ToStatusF(util::error::INVALID_ARGUMENT,
+                     "Could not open the container file '%s'.",
+                     filename.c_str());
+  }
+  struct stat file_stat;
+  if (fstat(fd, &file_stat) != 0) {
+    close(fd);
+    return ToStatusF(util::error::INVALID_ARGUMENT,
+                     "Could not stat the container file '%s'.",
+                     filename.c_str());
+  }
+  size_t file_size = file_stat.st_size;
+  if (file_size == 0) {
+    close(fd);
+    return InvalidContainer("empty file");
+  }
+  void* mapped_data = mmap(nullptr, file_size, PROT_READ, MAP_SHARED, fd, 0);
+  // The mapping stays valid after the descriptor is closed.
+  close(fd);
+  if (mapped_data == MAP_FAILED) {
+    return ToStatusF(util::error::INVALID_ARGUMENT,
+                     "Could not map the container file '%s'.",
+                     filename.c_str());
+  }
+  std::unique_ptr<RecordContainerReader> reader(new RecordContainerReader(
+      std::move(primitives_result.ValueOrDie()), associated_data,
+      absl::string_view(static_cast<const char*>(mapped_data), file_size),
+      mapped_data));
+  util::Status status = reader->Init();
+  if (!status.ok()) return status;
+  return std::move(reader);
+}
+
+RecordContainerReader::~RecordContainerReader() {
+  if (mapped_data_ != nullptr) {
+    munmap(mapped_data_, container_.size());
+  }
+}
+
+util::Status RecordContainerReader::Init() {
+  const uint64_t size = container_.size();
+  if (size < Format::kHeaderSize + Format::kTrailerSize) {
+    return InvalidContainer("too short");
+  }
+  absl::string_view header = container_.substr(0, Format::kHeaderSize);
+  absl::string_view trailer =
+      container_.substr(size - Format::kTrailerSize);
+  if (header.substr(0, Format::kMagicSize) != Format::kMagic ||
+      trailer.substr(16) != Format::kMagic) {
+    return InvalidContainer("wrong magic");
+  }
+  if (static_cast<uint8_t>(header[Format::kMagicSize]) != Format::kVersion) {
+    return InvalidContainer("unsupported version");
+  }
+  records_per_block_ = LoadBigEndian(header.data() + Format::kMagicSize + 1, 4);
+  if (records_per_block_ == 0) {
+    return InvalidContainer("zero records per block");
+  }
+
+  uint64_t index_offset = LoadBigEndian(trailer.data(), 8);
+  record_count_ = LoadBigEndian(trailer.data() + 8, 8);
+  uint64_t index_end = size - Format::kTrailerSize;
+  if (index_offset < Format::kHeaderSize || index_offset > index_end ||
+      record_count_ > (index_end - index_offset) / Format::kIndexEntrySize) {
+    return InvalidContainer("index out of bounds");
+  }
+  uint64_t block_count =
+      (record_count_ + records_per_block_ - 1) / records_per_block_;
+  uint64_t index_size = record_count_ * Format::kIndexEntrySize +
+                        block_count * Format::kBlockEntrySize;
+  if (index_size > index_end - index_offset) {
+    return InvalidContainer("index out of bounds");
+  }
+  index_ = container_.substr(index_offset, index_size);
+
+  // Verify the index before trusting any offset in it.
+  absl::string_view prefix;
+  absl::string_view authenticator;
+  if (!SplitPrefix(container_.substr(index_offset + index_size,
+                                     index_end - index_offset - index_size),
+                   &prefix, &authenticator)) {
+    return InvalidContainer("missing index authenticator");
+  }
+  const PrimitiveSet<Aead>::Primitives* aeads =
+      FindAeads(aead_set_.get(), prefix);
+  if (aeads == nullptr) {
+    return util::Status(util::error::NOT_FOUND,
+                        "No key found for the container index.");
+  }
+  std::string index_associated_data = Format::IndexAssociatedData(
+      header, record_count_, index_, associated_data_);
+  bool verified = false;
+  for (const auto& entry : *aeads) {
+    auto result =
+        entry->get_primitive().Decrypt(authenticator, index_associated_data);
+    if (result.ok() && result.ValueOrDie().empty()) {
+      verified = true;
+      break;
+    }
+  }
+  if (!verified) return InvalidContainer("index authentication failed");
+
+  // Look up the key of each block once, so that Read() needs no lookup.
+  block_aeads_.reserve(block_count);
+  const char* block_entries =
+      index_.data() + record_count_ * Format::kIndexEntrySize;
+  for (uint64_t block = 0; block < block_count; block++) {
+    uint64_t block_offset = LoadBigEndian(
+        block_entries + block * Format::kBlockEntrySize, 8);
+    absl::string_view rest;
+    if (block_offset < Format::kHeaderSize || block_offset >= index_offset ||
+        !SplitPrefix(container_.substr(block_offset,
+                                       index_offset - block_offset),
+                     &prefix, &rest)) {
+      return InvalidContainer("block out of bounds");
+    }
+    block_aeads_.push_back(FindAeads(aead_set_.get(), prefix));
+  }
+  return util::Status::OK;
+}
+
+util::StatusOr<std::string> RecordContainerReader::Read(uint64_t index) const {
+  if (index >= record_count_) {
+    return ToStatusF(util::error::OUT_OF_RANGE,
+                     "Record %llu does not exist.",
+                     static_cast<unsigned long long>(index));  // NOLINT
+  }
+  const char* entry = index_.data() + index * Format::kIndexEntrySize;
+  uint64_t offset = LoadBigEndian(entry, 8);
+  uint64_t size = LoadBigEndian(entry + 8, 4);
+  uint64_t index_offset = index_.data() - container_.data();
+  if (offset < Format::kHeaderSize || offset > index_offset ||
+      size > index_offset - offset) {
+    return InvalidContainer("record out of bounds");
+  }
+  const PrimitiveSet<Aead>::Primitives* aeads =
+      block_aeads_[index / records_per_block_];
+  if (aeads == nullptr) {
+    return util::Status(util::error::NOT_FOUND,
+                        "No key found for the record.");
+  }
+  absl::string_view ciphertext = container_.substr(offset, size);
+  std::string associated_data = Format::RecordAssociatedData(
+      container_.substr(0, Format::kHeaderSize), index, associated_data_);
+  for (const auto& entry : *aeads) {
+    auto result = entry->get_primitive().Decrypt(ciphertext, associated_data);
+    if (result.ok()) return std::move(result.ValueOrDie());
+  }
+  return util::Status(util::error::INVALID_ARGUMENT, "decryption failed");
+}
+
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,94 @@
+// Copyright 2018 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_AEAD_RECORD_CONTAINER_READER_H_
+#define TINK_AEAD_RECORD_CONTAINER_READER_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/strings/string_view.h"
+#include "tink/aead.h"
+#include "tink/keyset_handle.h"
+#include "tink/primitive_set.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+
+///////////////////////////////////////////////////////////////////////////////
+// Reads containers written by RecordContainerWriter (see there for the
+// format). Opening a container checks the authenticator of its index and
+// looks up the key of each block in the keyset; afterwards Read() locates a
+// record through the index and decrypts only that record.
+//
+// Read() may be called concurrently from several threads.
+class RecordContainerReader {
+ public:
+  // Returns a reader for the container stored in the file 'filename'.
+  // The file is memory-mapped read-only rather than copied into memory,
+  // so only the index and the records that are read are touched.
+  static crypto::tink::util::StatusOr<std::unique_ptr<RecordContainerReader>>
+  NewFromFile(const KeysetHandle& keyset_handle,
+              absl::string_view associated_data, const std::string& filename);
+
+  // Returns a reader for the container in 'container', which must outlive
+  // the reader.
+  static crypto::tink::util::StatusOr<std::unique_ptr<RecordContainerReader>>
+  New(const KeysetHandle& keyset_handle, absl::string_view associated_data,
+      absl::string_view container);
+
+  // Returns the number of records in the container.
+  uint64_t record_count() const { return record_count_; }
+
+  // Decrypts and returns the record with the given 'index'.
+  crypto::tink::util::StatusOr<std::string> Read(uint64_t index) const;
+
+  ~RecordContainerReader();
+
+ private:
+  RecordContainerReader(std::unique_ptr<PrimitiveSet<Aead>> aead_set,
+                        absl::string_view associated_data,
+                        absl::string_view container, void* mapped_data)
+      : aead_set_(std::move(aead_set)),
+        associated_data_(associated_data),
+        container_(container),
+        mapped_data_(mapped_data),
+        records_per_block_(0),
+        record_count_(0) {}
+
+  // Parses the header and the trailer, verifies the index and looks up the
+  // key of each block.
+  crypto::tink::util::Status Init();
+
+  const std::unique_ptr<PrimitiveSet<Aead>> aead_set_;
+  const std::string associated_data_;
+  const absl::string_view container_;
+  void* const mapped_data_;  // if not null, the mapping of container_
+  uint32_t records_per_block_;
+  uint64_t record_count_;
+  absl::string_view index_;
+  // The candidate Aeads of each block, or null if the block's key is not
+  // in the keyset.
+  std::vector<const PrimitiveSet<Aead>::Primitives*> block_aeads_;
+};
+
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_AEAD_RECORD_CONTAINER_READER_H_
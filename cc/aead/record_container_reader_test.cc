@@ -0,0 +1,220 @@
+// Copyright 2018 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/aead/record_container_reader.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <string>
+#include <thread>  // NOLINT(build/c++11)
+#include <vector>
+
+#include "absl/strings/string_view.h"
+#include "gtest/gtest.h"
+#include "tink/aead/aead_config.h"
+#include "tink/aead/aead_key_templates.h"
+#include "tink/aead/record_container_writer.h"
+#include "tink/keyset_handle.h"
+#include "tink/keyset_manager.h"
+#include "tink/random_access_stream.h"
+#include "tink/util/file_random_access_stream.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace {
+
+// A RandomAccessSink that grows a string as needed.
+class StringSink : public RandomAccessSink {
+ public:
+  util::Status PWrite(uint64_t position, absl::string_view data) override {
+    if (data_.size() < position + data.size()) {
+      data_.resize(position + data.size());
+    }
+    data_.replace(position, data.size(), data.data(), data.size());
+    return util::Status::OK;
+  }
+
+  std::string data_;
+};
+
+std::string Record(int i) { return "record " + std::to_string(i); }
+
+class RecordContainerReaderTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    ASSERT_TRUE(AeadConfig::Register().ok());
+    auto manager_result = KeysetManager::New(AeadKeyTemplates::Aes128Gcm());
+    ASSERT_TRUE(manager_result.ok()) << manager_result.status();
+    keyset_manager_ = std::move(manager_result.ValueOrDie());
+  }
+
+  std::unique_ptr<KeysetHandle> Handle() {
+    return keyset_manager_->GetKeysetHandle();
+  }
+
+  std::string WriteContainer(int records, absl::string_view associated_data,
+                             uint32_t records_per_block) {
+    StringSink sink;
+    auto writer_result = RecordContainerWriter::New(
+        *Handle(), associated_data, &sink, records_per_block);
+    EXPECT_TRUE(writer_result.ok()) << writer_result.status();
+    auto writer = std::move(writer_result.ValueOrDie());
+    for (int i = 0; i < records; i++) {
+      EXPECT_TRUE(writer->Append(Record(i)).ok());
+    }
+    EXPECT_TRUE(writer->Close().ok());
+    return sink.data_;
+  }
+
+  std::unique_ptr<KeysetManager> keyset_manager_;
+};
+
+TEST_F(RecordContainerReaderTest, testReadAnyRecord) {
+  for (int records : {0, 1, 7, 8, 9, 100}) {
+    SCOPED_TRACE(records);
+    std::string container = WriteContainer(records, "ad", 8);
+    auto reader_result =
+        RecordContainerReader::New(*Handle(), "ad", container);
+    ASSERT_TRUE(reader_result.ok()) << reader_result.status();
+    auto reader = std::move(reader_result.ValueOrDie());
+    EXPECT_EQ(records, reader->record_count());
+    for (int i = records - 1; i >= 0; i--) {
+      auto result = reader->Read(i);
+      ASSERT_TRUE(result.ok()) << result.status();
+      EXPECT_EQ(Record(i), result.ValueOrDie());
+    }
+    auto result = reader->Read(records);
+    EXPECT_FALSE(result.ok());
+    EXPECT_EQ(util::error::OUT_OF_RANGE, result.status().error_code());
+  }
+}
+
+TEST_F(RecordContainerReaderTest, testReadFromFile) {
+  std::string filename =
+      std::string(getenv("TEST_TMPDIR")) + "/record_container_test.bin";
+  int fd = open(filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0600);
+  ASSERT_LE(0, fd);
+  {
+    util::FileRandomAccessSink sink(fd);
+    auto writer = std::move(
+        RecordContainerWriter::New(*Handle(), "ad", &sink, 64).ValueOrDie());
+    for (int i = 0; i < 1000; i++) {
+      ASSERT_TRUE(writer->Append(Record(i)).ok());
+    }
+    ASSERT_TRUE(writer->Close().ok());
+  }
+  close(fd);
+
+  auto reader_result =
+      RecordContainerReader::NewFromFile(*Handle(), "ad", filename);
+  ASSERT_TRUE(reader_result.ok()) << reader_result.status();
+  auto reader = std::move(reader_result.ValueOrDie());
+  EXPECT_EQ(1000, reader->record_count());
+  EXPECT_EQ(Record(517), reader->Read(517).ValueOrDie());
+
+  // Concurrent reads.
+  const int kThreads = 4;
+  std::vector<std::thread> threads;
+  std::vector<int> failures(kThreads, 0);
+  for (int t = 0; t < kThreads; t++) {
+    threads.emplace_back([&, t]() {
+      for (int i = t; i < 1000; i += kThreads) {
+        auto result = reader->Read(i);
+        if (!result.ok() || result.ValueOrDie() != Record(i)) failures[t]++;
+      }
+    });
+  }
+  for (auto& thread : threads) thread.join();
+  for (int t = 0; t < kThreads; t++) EXPECT_EQ(0, failures[t]);
+
+  EXPECT_FALSE(RecordContainerReader::NewFromFile(
+      *Handle(), "ad", filename + ".does_not_exist").ok());
+}
+
+TEST_F(RecordContainerReaderTest, testKeyRotation) {
+  std::string old_container = WriteContainer(10, "", 4);
+  auto old_handle = Handle();
+  ASSERT_TRUE(keyset_manager_->Rotate(AeadKeyTemplates::Aes256Gcm()).ok());
+  std::string new_container = WriteContainer(10, "", 4);
+
+  // The rotated keyset reads containers of both keys.
+  for (const std::string& container : {old_container, new_container}) {
+    auto reader = std::move(
+        RecordContainerReader::New(*Handle(), "", container).ValueOrDie());
+    EXPECT_EQ(Record(9), reader->Read(9).ValueOrDie());
+  }
+  // A keyset without the new key cannot open the new container.
+  auto result = RecordContainerReader::New(*old_handle, "", new_container);
+  EXPECT_FALSE(result.ok());
+  EXPECT_EQ(util::error::NOT_FOUND, result.status().error_code());
+}
+
+TEST_F(RecordContainerReaderTest, testModifiedContainer) {
+  std::string container = WriteContainer(10, "ad", 4);
+  EXPECT_FALSE(RecordContainerReader::New(*Handle(), "other", container).ok());
+  for (size_t size = 0; size < container.size(); size++) {
+    EXPECT_FALSE(RecordContainerReader::New(
+        *Handle(), "ad", container.substr(0, size)).ok()) << size;
+  }
+
+  // Modifying any byte either fails to open or fails to read some record.
+  for (size_t position = 0; position < container.size(); position++) {
+    std::string modified = container;
+    modified[position] ^= 0x01;
+    auto reader_result = RecordContainerReader::New(*Handle(), "ad", modified);
+    if (!reader_result.ok()) continue;
+    auto reader = std::move(reader_result.ValueOrDie());
+    bool all_ok = true;
+    for (int i = 0; i < 10; i++) {
+      auto result = reader->Read(i);
+      all_ok = all_ok && result.ok() && result.ValueOrDie() == Record(i);
+    }
+    EXPECT_FALSE(all_ok) << position;
+  }
+}
+
+TEST_F(RecordContainerReaderTest, testRecordsAreBoundToContainer) {
+  std::string container1 = WriteContainer(2, "", 4);
+  std::string container2 = WriteContainer(2, "", 4);
+  ASSERT_EQ(container1.size(), container2.size());
+  // Copy the records of container 2 into container 1, keeping its index.
+  size_t records_begin = RecordContainerWriter::kHeaderSize;
+  size_t index_offset = 0;
+  for (int i = 0; i < 8; i++) {
+    index_offset = (index_offset << 8) |
+                   static_cast<uint8_t>(container1[container1.size() - 20 + i]);
+  }
+  std::string spliced =
+      container1.substr(0, records_begin) +
+      container2.substr(records_begin, index_offset - records_begin) +
+      container1.substr(index_offset);
+  auto reader = std::move(
+      RecordContainerReader::New(*Handle(), "", spliced).ValueOrDie());
+  EXPECT_FALSE(reader->Read(0).ok());
+  EXPECT_FALSE(reader->Read(1).ok());
+}
+
+}  // namespace
+}  // namespace tink
+}  // namespace crypto
+
+int main(int ac, char* av[]) {
+  testing::InitGoogleTest(&ac, av);
+  return RUN_ALL_TESTS();
+}
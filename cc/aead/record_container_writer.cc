@@ -0,0 +1,200 @@
+// Copyright 2018 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/aead/record_container_writer.h"
+
+#include <limits>
+
+#include "absl/strings/string_view.h"
+#include "tink/aead.h"
+#include "tink/keyset_handle.h"
+#include "tink/primitive_set.h"
+#include "tink/random_access_stream.h"
+#include "tink/registry.h"
+#include "tink/subtle/random.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+
+namespace {
+
+// Records are written to the sink in pieces of about this many bytes.
+const size_t kFlushSize = 1 << 16;
+
+const uint8_t kRecordTag = 0x00;
+const uint8_t kIndexTag = 0x01;
+
+void AppendBigEndian(uint64_t value, int size, std::string* out) {
+  for (int shift = 8 * (size - 1); shift >= 0; shift -= 8) {
+    out->push_back(static_cast<char>(value >> shift));
+  }
+}
+
+}  // anonymous namespace
+
+constexpr char RecordContainerWriter::kMagic[];
+constexpr int RecordContainerWriter::kMagicSize;
+constexpr uint8_t RecordContainerWriter::kVersion;
+constexpr int RecordContainerWriter::kContainerIdSize;
+constexpr int RecordContainerWriter::kHeaderSize;
+constexpr int RecordContainerWriter::kIndexEntrySize;
+constexpr int RecordContainerWriter::kBlockEntrySize;
+constexpr int RecordContainerWriter::kTrailerSize;
+
+// static
+util::StatusOr<std::unique_ptr<RecordContainerWriter>>
+RecordContainerWriter::New(const KeysetHandle& keyset_handle,
+                           absl::string_view associated_data,
+                           RandomAccessSink* sink,
+                           uint32_t records_per_block) {
+  if (sink == nullptr) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "sink must be non-null");
+  }
+  if (records_per_block == 0) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "records_per_block must be positive");
+  }
+  auto primitives_result =
+      Registry::GetPrimitives<Aead>(keyset_handle, nullptr);
+  if (!primitives_result.ok()) return primitives_result.status();
+  if (primitives_result.ValueOrDie()->get_primary() == nullptr) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "keyset has no primary");
+  }
+  return std::unique_ptr<RecordContainerWriter>(new RecordContainerWriter(
+      std::move(primitives_result.ValueOrDie()), associated_data, sink,
+      records_per_block));
+}
+
+RecordContainerWriter::RecordContainerWriter(
+    std::unique_ptr<PrimitiveSet<Aead>> aead_set,
+    absl::string_view associated_data, RandomAccessSink* sink,
+    uint32_t records_per_block)
+    : aead_set_(std::move(aead_set)),
+      associated_data_(associated_data),
+      sink_(sink),
+      records_per_block_(records_per_block),
+      position_(0),
+      record_count_(0),
+      closed_(false) {
+  header_.append(kMagic, kMagicSize);
+  header_.push_back(static_cast<char>(kVersion));
+  AppendBigEndian(records_per_block, 4, &header_);
+  header_.append(subtle::Random::GetRandomBytes(kContainerIdSize));
+  buffer_ = header_;
+  position_ = header_.size();
+}
+
+// static
+std::string RecordContainerWriter::RecordAssociatedData(
+    absl::string_view header, uint64_t index,
+    absl::string_view associated_data) {
+  std::string data;
+  data.reserve(header.size() + 9 + associated_data.size());
+  data.append(header.data(), header.size());
+  data.push_back(static_cast<char>(kRecordTag));
+  AppendBigEndian(index, 8, &data);
+  data.append(associated_data.data(), associated_data.size());
+  return data;
+}
+
+// static
+std::string RecordContainerWriter::IndexAssociatedData(
+    absl::string_view header, uint64_t record_count, absl::string_view index,
+    absl::string_view associated_data) {
+  std::string data;
+  data.reserve(header.size() + 9 + index.size() + associated_data.size());
+  data.append(header.data(), header.size());
+  data.push_back(static_cast<char>(kIndexTag));
+  AppendBigEndian(record_count, 8, &data);
+  data.append(index.data(), index.size());
+  data.append(associated_data.data(), associated_data.size());
+  return data;
+}
+
+util::Status RecordContainerWriter::Flush() {
+  if (buffer_.empty()) return util::Status::OK;
+  util::Status status = sink_->PWrite(position_ - buffer_.size(), buffer_);
+  buffer_.clear();
+  // The container cannot be completed after a failed write.
+  if (!status.ok()) closed_ = true;
+  return status;
+}
+
+util::StatusOr<uint64_t> RecordContainerWriter::Append(
+    absl::string_view record) {
+  if (closed_) {
+    return util::Status(util::error::FAILED_PRECONDITION,
+                        "container already closed");
+  }
+  const auto* primary = aead_set_->get_primary();
+  auto encrypt_result = primary->get_primitive().Encrypt(
+      record, RecordAssociatedData(header_, record_count_, associated_data_));
+  if (!encrypt_result.ok()) return encrypt_result.status();
+  const std::string& ciphertext = encrypt_result.ValueOrDie();
+  if (ciphertext.size() > std::numeric_limits<uint32_t>::max()) {
+    return util::Status(util::error::INVALID_ARGUMENT, "record too large");
+  }
+  if (record_count_ % records_per_block_ == 0) {
+    const std::string& prefix = primary->get_identifier();
+    AppendBigEndian(position_, 8, &block_index_);
+    buffer_.push_back(static_cast<char>(prefix.size()));
+    buffer_.append(prefix);
+    position_ += 1 + prefix.size();
+  }
+  AppendBigEndian(position_, 8, &index_);
+  AppendBigEndian(ciphertext.size(), 4, &index_);
+  buffer_.append(ciphertext);
+  position_ += ciphertext.size();
+  if (buffer_.size() >= kFlushSize) {
+    util::Status status = Flush();
+    if (!status.ok()) return status;
+  }
+  return record_count_++;
+}
+
+util::StatusOr<uint64_t> RecordContainerWriter::Close() {
+  if (closed_) {
+    return util::Status(util::error::FAILED_PRECONDITION,
+                        "container already closed");
+  }
+  closed_ = true;
+  const auto* primary = aead_set_->get_primary();
+  uint64_t index_offset = position_;
+  index_.append(block_index_);
+  auto authenticator_result = primary->get_primitive().Encrypt(
+      "", IndexAssociatedData(header_, record_count_, index_,
+                              associated_data_));
+  if (!authenticator_result.ok()) return authenticator_result.status();
+  size_t buffered = buffer_.size();
+  buffer_.append(index_);
+  buffer_.push_back(static_cast<char>(primary->get_identifier().size()));
+  buffer_.append(primary->get_identifier());
+  buffer_.append(authenticator_result.ValueOrDie());
+  AppendBigEndian(index_offset, 8, &buffer_);
+  AppendBigEndian(record_count_, 8, &buffer_);
+  buffer_.append(kMagic, kMagicSize);
+  position_ += buffer_.size() - buffered;
+  util::Status status = Flush();
+  if (!status.ok()) return status;
+  return position_;
+}
+
+}  // namespace tink
+}  // namespace crypto
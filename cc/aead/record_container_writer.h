@@ -0,0 +1,130 @@
+// Copyright 2018 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_AEAD_RECORD_CONTAINER_WRITER_H_
+#define TINK_AEAD_RECORD_CONTAINER_WRITER_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/strings/string_view.h"
+#include "tink/aead.h"
+#include "tink/keyset_handle.h"
+#include "tink/primitive_set.h"
+#include "tink/random_access_stream.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+
+///////////////////////////////////////////////////////////////////////////////
+// Writes many small records, each encrypted with the primary Aead of a
+// keyset, into a container that RecordContainerReader can read one record
+// at a time without scanning:
+//
+//   auto writer_result = RecordContainerWriter::New(
+//       keyset_handle, "associated data", &sink, 1024);
+//   auto& writer = writer_result.ValueOrDie();
+//   for (...) writer->Append(record);
+//   auto status = writer->Close();
+//
+// Records are grouped into blocks of records_per_block records. The key
+// prefix (see CryptoFormat) is stored once per block, followed by the raw
+// ciphertexts of the block's records. After the last block, Close() writes
+// an index of the offset and size of each record and the offset of each
+// block, authenticated with the primary Aead. The container layout is
+// (integers are big endian):
+//
+//   header:  "TKRC" || version (1 byte) || records_per_block (4 bytes) ||
+//            container_id (16 random bytes)
+//   block:   prefix_size (1 byte) || prefix || record ciphertexts
+//   index:   record_count * (offset (8 bytes) || size (4 bytes)) ||
+//            block_count * offset (8 bytes)
+//   index authenticator: prefix_size (1 byte) || prefix ||
+//            Encrypt("", header || 0x01 || record_count (8 bytes) ||
+//                        index || associated_data)
+//   trailer: index_offset (8 bytes) || record_count (8 bytes) || "TKRC"
+//
+// Record i is encrypted with the associated data
+//   header || 0x00 || i (8 bytes) || associated_data,
+// which binds it to its position in this container.
+//
+// A writer is not thread-safe. The container is incomplete until Close()
+// returns OK.
+class RecordContainerWriter {
+ public:
+  // Returns a writer that writes the container to 'sink', starting at
+  // position 0. The sink must outlive the writer.
+  static crypto::tink::util::StatusOr<std::unique_ptr<RecordContainerWriter>>
+  New(const KeysetHandle& keyset_handle, absl::string_view associated_data,
+      RandomAccessSink* sink, uint32_t records_per_block);
+
+  // Encrypts and appends 'record', and returns its index in the container.
+  crypto::tink::util::StatusOr<uint64_t> Append(absl::string_view record);
+
+  // Writes the index and the trailer, and returns the size of the container.
+  // The writer cannot be used afterwards.
+  crypto::tink::util::StatusOr<uint64_t> Close();
+
+  // Format constants shared with RecordContainerReader.
+  static constexpr char kMagic[] = "TKRC";
+  static constexpr int kMagicSize = 4;
+  static constexpr uint8_t kVersion = 1;
+  static constexpr int kContainerIdSize = 16;
+  static constexpr int kHeaderSize = kMagicSize + 1 + 4 + kContainerIdSize;
+  static constexpr int kIndexEntrySize = 12;
+  static constexpr int kBlockEntrySize = 8;
+  static constexpr int kTrailerSize = 8 + 8 + kMagicSize;
+
+  // Returns the associated data for record 'index' of the container with
+  // the given 'header'.
+  static std::string RecordAssociatedData(absl::string_view header,
+                                          uint64_t index,
+                                          absl::string_view associated_data);
+
+  // Returns the associated data of the index authenticator.
+  static std::string IndexAssociatedData(absl::string_view header,
+                                         uint64_t record_count,
+                                         absl::string_view index,
+                                         absl::string_view associated_data);
+
+ private:
+  RecordContainerWriter(std::unique_ptr<PrimitiveSet<Aead>> aead_set,
+                        absl::string_view associated_data,
+                        RandomAccessSink* sink, uint32_t records_per_block);
+
+  // Writes the buffered bytes to the sink.
+  crypto::tink::util::Status Flush();
+
+  const std::unique_ptr<PrimitiveSet<Aead>> aead_set_;
+  const std::string associated_data_;
+  RandomAccessSink* const sink_;
+  const uint32_t records_per_block_;
+  std::string header_;
+  std::string buffer_;
+  uint64_t position_;  // of the end of buffer_ in the container
+  std::string index_;
+  std::string block_index_;
+  uint64_t record_count_;
+  bool closed_;
+};
+
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_AEAD_RECORD_CONTAINER_WRITER_H_
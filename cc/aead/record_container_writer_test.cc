@@ -0,0 +1,149 @@
+// Copyright 2018 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/aead/record_container_writer.h"
+
+#include <string>
+
+#include "absl/strings/string_view.h"
+#include "gtest/gtest.h"
+#include "tink/aead/aead_config.h"
+#include "tink/aead/aead_key_templates.h"
+#include "tink/keyset_handle.h"
+#include "tink/random_access_stream.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace {
+
+// A RandomAccessSink that grows a string as needed.
+class StringSink : public RandomAccessSink {
+ public:
+  util::Status PWrite(uint64_t position, absl::string_view data) override {
+    if (data_.size() < position + data.size()) {
+      data_.resize(position + data.size());
+    }
+    data_.replace(position, data.size(), data.data(), data.size());
+    writes_++;
+    return util::Status::OK;
+  }
+
+  std::string data_;
+  int writes_ = 0;
+};
+
+class RecordContainerWriterTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    ASSERT_TRUE(AeadConfig::Register().ok());
+    auto handle_result =
+        KeysetHandle::GenerateNew(AeadKeyTemplates::Aes128Gcm());
+    ASSERT_TRUE(handle_result.ok()) << handle_result.status();
+    keyset_handle_ = std::move(handle_result.ValueOrDie());
+  }
+
+  std::unique_ptr<KeysetHandle> keyset_handle_;
+};
+
+TEST_F(RecordContainerWriterTest, testLayout) {
+  const int kRecords = 10;
+  const int kRecordsPerBlock = 4;
+  // AES-GCM adds a 12-byte IV and a 16-byte tag to each record.
+  const int kCiphertextOverhead = 28;
+  const int kPrefixSize = 5;
+  StringSink sink;
+  auto writer = std::move(RecordContainerWriter::New(
+      *keyset_handle_, "ad", &sink, kRecordsPerBlock).ValueOrDie());
+  for (int i = 0; i < kRecords; i++) {
+    auto result = writer->Append(std::string(i, 'r'));
+    ASSERT_TRUE(result.ok()) << result.status();
+    EXPECT_EQ(i, result.ValueOrDie());
+  }
+  // Small records are buffered until Close().
+  EXPECT_EQ(0, sink.writes_);
+  auto close_result = writer->Close();
+  ASSERT_TRUE(close_result.ok()) << close_result.status();
+  EXPECT_EQ(sink.data_.size(), close_result.ValueOrDie());
+
+  // The key prefix is stored once per block, not once per record.
+  const int kBlocks = 3;
+  size_t records_size = kRecords * (kRecords - 1) / 2 +
+                        kRecords * kCiphertextOverhead;
+  size_t expected_size =
+      RecordContainerWriter::kHeaderSize + kBlocks * (1 + kPrefixSize) +
+      records_size +
+      kRecords * RecordContainerWriter::kIndexEntrySize +
+      kBlocks * RecordContainerWriter::kBlockEntrySize +
+      (1 + kPrefixSize + kCiphertextOverhead) +
+      RecordContainerWriter::kTrailerSize;
+  EXPECT_EQ(expected_size, sink.data_.size());
+  EXPECT_EQ("TKRC", sink.data_.substr(0, 4));
+  EXPECT_EQ("TKRC", sink.data_.substr(sink.data_.size() - 4));
+  // The first block starts right after the header, with the TINK prefix.
+  EXPECT_EQ(kPrefixSize, sink.data_[RecordContainerWriter::kHeaderSize]);
+  EXPECT_EQ(1, sink.data_[RecordContainerWriter::kHeaderSize + 1]);
+}
+
+TEST_F(RecordContainerWriterTest, testLargeRecordsAreFlushed) {
+  StringSink sink;
+  auto writer = std::move(RecordContainerWriter::New(
+      *keyset_handle_, "", &sink, 1024).ValueOrDie());
+  for (int i = 0; i < 4; i++) {
+    ASSERT_TRUE(writer->Append(std::string(1 << 16, 'r')).ok());
+  }
+  EXPECT_EQ(4, sink.writes_);
+  ASSERT_TRUE(writer->Close().ok());
+  EXPECT_EQ(5, sink.writes_);
+}
+
+TEST_F(RecordContainerWriterTest, testEmptyContainer) {
+  StringSink sink;
+  auto writer = std::move(RecordContainerWriter::New(
+      *keyset_handle_, "", &sink, 16).ValueOrDie());
+  auto close_result = writer->Close();
+  ASSERT_TRUE(close_result.ok()) << close_result.status();
+  EXPECT_EQ(RecordContainerWriter::kHeaderSize + 1 + 5 + 28 +
+                RecordContainerWriter::kTrailerSize,
+            close_result.ValueOrDie());
+}
+
+TEST_F(RecordContainerWriterTest, testErrors) {
+  StringSink sink;
+  EXPECT_FALSE(
+      RecordContainerWriter::New(*keyset_handle_, "", nullptr, 16).ok());
+  EXPECT_FALSE(RecordContainerWriter::New(*keyset_handle_, "", &sink, 0).ok());
+
+  auto writer = std::move(RecordContainerWriter::New(
+      *keyset_handle_, "", &sink, 16).ValueOrDie());
+  ASSERT_TRUE(writer->Append("record").ok());
+  ASSERT_TRUE(writer->Close().ok());
+  auto append_result = writer->Append("record");
+  EXPECT_FALSE(append_result.ok());
+  EXPECT_EQ(util::error::FAILED_PRECONDITION,
+            append_result.status().error_code());
+  EXPECT_FALSE(writer->Close().ok());
+}
+
+}  // namespace
+}  // namespace tink
+}  // namespace crypto
+
+int main(int ac, char* av[]) {
+  testing::InitGoogleTest(&ac, av);
+  return RUN_ALL_TESTS();
+}
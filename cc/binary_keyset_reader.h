@@ -18,6 +18,7 @@
 #define TINK_BINARY_KEYSET_READER_H_
 
 #include <istream>
+#include <string>
 
 #include "absl/strings/string_view.h"
 #include "tink/keyset_reader.h"
@@ -37,6 +38,14 @@ class BinaryKeysetReader : public KeysetReader {
   static crypto::tink::util::StatusOr<std::unique_ptr<KeysetReader>> New(
       absl::string_view serialized_keyset);
 
+  // Returns a reader for the keyset stored in the file |filename|.
+  // The file is memory-mapped read-only and private rather than copied
+  // into memory, so processes reading the same keyset file share the page
+  // cache, and only the parts of the file that are actually parsed are
+  // touched. The file must not be modified while the reader is in use.
+  static crypto::tink::util::StatusOr<std::unique_ptr<BinaryKeysetReader>>
+  NewFromFile(const std::string& filename);
+
   crypto::tink::util::StatusOr<std::unique_ptr<google::crypto::tink::Keyset>>
   Read() override;
 
@@ -44,11 +53,34 @@ class BinaryKeysetReader : public KeysetReader {
     std::unique_ptr<google::crypto::tink::EncryptedKeyset>>
   ReadEncrypted() override;
 
+  crypto::tink::util::StatusOr<google::crypto::tink::Keyset*>
+  ReadOnArena(google::protobuf::Arena* arena) override;
+
+  // Reads only the metadata of the keys (id, status, output prefix type
+  // and type URL) of a cleartext keyset, without copying any key material.
+  crypto::tink::util::StatusOr<
+    std::unique_ptr<google::crypto::tink::KeysetInfo>>
+  ReadKeysetInfo();
+
+  ~BinaryKeysetReader() override;
+
+  // The reader owns its mapping, which the destructor unmaps.
+  BinaryKeysetReader(const BinaryKeysetReader&) = delete;
+  BinaryKeysetReader& operator=(const BinaryKeysetReader&) = delete;
+
  private:
   BinaryKeysetReader(absl::string_view serialized_keyset)
-      : serialized_keyset_(serialized_keyset) {}
+      : serialized_keyset_(serialized_keyset), mapped_data_(nullptr),
+        mapped_size_(0) {}
+  BinaryKeysetReader(void* mapped_data, size_t mapped_size)
+      : mapped_data_(mapped_data), mapped_size_(mapped_size) {}
+
+  // Returns the serialized keyset, either owned or memory-mapped.
+  absl::string_view serialized_keyset() const;
 
   std::string serialized_keyset_;
+  void* mapped_data_;  // if not null, a read-only mapping of a keyset file
+  size_t mapped_size_;
 };
 
 }  // namespace tink
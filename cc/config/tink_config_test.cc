@@ -19,6 +19,7 @@
 #include "tink/aead.h"
 #include "tink/catalogue.h"
 #include "tink/config.h"
+#include "tink/deterministic_aead.h"
 #include "tink/hybrid_decrypt.h"
 #include "tink/hybrid_encrypt.h"
 #include "tink/mac.h"
@@ -67,11 +68,31 @@ TEST_F(TinkConfigTest, testBasic) {
       "type.googleapis.com/google.crypto.tink.AesEaxKey";
   std::string aes_gcm_key_type =
       "type.googleapis.com/google.crypto.tink.AesGcmKey";
+  std::string aes_gcm_siv_key_type =
+      "type.googleapis.com/google.crypto.tink.AesGcmSivKey";
+  std::string chacha20_poly1305_key_type =
+      "type.googleapis.com/google.crypto.tink.ChaCha20Poly1305Key";
   std::string hmac_key_type =
       "type.googleapis.com/google.crypto.tink.HmacKey";
+  std::string ed25519_sign_key_type =
+      "type.googleapis.com/google.crypto.tink.Ed25519PrivateKey";
+  std::string ed25519_verify_key_type =
+      "type.googleapis.com/google.crypto.tink.Ed25519PublicKey";
+  std::string hpke_decrypt_key_type =
+      "type.googleapis.com/google.crypto.tink.HpkePrivateKey";
+  std::string hpke_encrypt_key_type =
+      "type.googleapis.com/google.crypto.tink.HpkePublicKey";
+  std::string aes_siv_key_type =
+      "type.googleapis.com/google.crypto.tink.AesSivKey";
+  std::string aes_cmac_key_type =
+      "type.googleapis.com/google.crypto.tink.AesCmacKey";
+  std::string poly1305_mac_key_type =
+      "type.googleapis.com/google.crypto.tink.Poly1305MacKey";
+  std::string tree_hmac_key_type =
+      "type.googleapis.com/google.crypto.tink.TreeHmacKey";
   auto& config = TinkConfig::Latest();
 
-  EXPECT_EQ(8, TinkConfig::Latest().entry_size());
+  EXPECT_EQ(18, TinkConfig::Latest().entry_size());
 
   EXPECT_EQ("TinkMac", config.entry(0).catalogue_name());
   EXPECT_EQ("Mac", config.entry(0).primitive_name());
@@ -79,48 +100,108 @@ TEST_F(TinkConfigTest, testBasic) {
   EXPECT_EQ(true, config.entry(0).new_key_allowed());
   EXPECT_EQ(0, config.entry(0).key_manager_version());
 
-  EXPECT_EQ("TinkAead", config.entry(1).catalogue_name());
-  EXPECT_EQ("Aead", config.entry(1).primitive_name());
-  EXPECT_EQ(aes_ctr_hmac_aead_key_type, config.entry(1).type_url());
+  EXPECT_EQ("TinkMac", config.entry(1).catalogue_name());
+  EXPECT_EQ("Mac", config.entry(1).primitive_name());
+  EXPECT_EQ(aes_cmac_key_type, config.entry(1).type_url());
   EXPECT_EQ(true, config.entry(1).new_key_allowed());
   EXPECT_EQ(0, config.entry(1).key_manager_version());
 
-  EXPECT_EQ("TinkAead", config.entry(2).catalogue_name());
-  EXPECT_EQ("Aead", config.entry(2).primitive_name());
-  EXPECT_EQ(aes_gcm_key_type, config.entry(2).type_url());
+  EXPECT_EQ("TinkMac", config.entry(2).catalogue_name());
+  EXPECT_EQ("Mac", config.entry(2).primitive_name());
+  EXPECT_EQ(poly1305_mac_key_type, config.entry(2).type_url());
   EXPECT_EQ(true, config.entry(2).new_key_allowed());
   EXPECT_EQ(0, config.entry(2).key_manager_version());
 
-  EXPECT_EQ("TinkAead", config.entry(3).catalogue_name());
-  EXPECT_EQ("Aead", config.entry(3).primitive_name());
-  EXPECT_EQ(aes_eax_key_type, config.entry(3).type_url());
+  EXPECT_EQ("TinkMac", config.entry(3).catalogue_name());
+  EXPECT_EQ("Mac", config.entry(3).primitive_name());
+  EXPECT_EQ(tree_hmac_key_type, config.entry(3).type_url());
   EXPECT_EQ(true, config.entry(3).new_key_allowed());
   EXPECT_EQ(0, config.entry(3).key_manager_version());
 
-  EXPECT_EQ("TinkHybridDecrypt", config.entry(4).catalogue_name());
-  EXPECT_EQ("HybridDecrypt", config.entry(4).primitive_name());
-  EXPECT_EQ(hybrid_decrypt_key_type, config.entry(4).type_url());
+  EXPECT_EQ("TinkAead", config.entry(4).catalogue_name());
+  EXPECT_EQ("Aead", config.entry(4).primitive_name());
+  EXPECT_EQ(aes_ctr_hmac_aead_key_type, config.entry(4).type_url());
   EXPECT_EQ(true, config.entry(4).new_key_allowed());
-  EXPECT_EQ(0, config.entry(3).key_manager_version());
+  EXPECT_EQ(0, config.entry(4).key_manager_version());
 
-  EXPECT_EQ("TinkHybridEncrypt", config.entry(5).catalogue_name());
-  EXPECT_EQ("HybridEncrypt", config.entry(5).primitive_name());
-  EXPECT_EQ(hybrid_encrypt_key_type, config.entry(5).type_url());
+  EXPECT_EQ("TinkAead", config.entry(5).catalogue_name());
+  EXPECT_EQ("Aead", config.entry(5).primitive_name());
+  EXPECT_EQ(aes_gcm_key_type, config.entry(5).type_url());
   EXPECT_EQ(true, config.entry(5).new_key_allowed());
   EXPECT_EQ(0, config.entry(5).key_manager_version());
 
-  EXPECT_EQ("TinkPublicKeySign", config.entry(6).catalogue_name());
-  EXPECT_EQ("PublicKeySign", config.entry(6).primitive_name());
-  EXPECT_EQ(public_key_sign_key_type, config.entry(6).type_url());
+  EXPECT_EQ("TinkAead", config.entry(6).catalogue_name());
+  EXPECT_EQ("Aead", config.entry(6).primitive_name());
+  EXPECT_EQ(aes_eax_key_type, config.entry(6).type_url());
   EXPECT_EQ(true, config.entry(6).new_key_allowed());
   EXPECT_EQ(0, config.entry(6).key_manager_version());
 
-  EXPECT_EQ("TinkPublicKeyVerify", config.entry(7).catalogue_name());
-  EXPECT_EQ("PublicKeyVerify", config.entry(7).primitive_name());
-  EXPECT_EQ(public_key_verify_key_type, config.entry(7).type_url());
+  EXPECT_EQ("TinkAead", config.entry(7).catalogue_name());
+  EXPECT_EQ("Aead", config.entry(7).primitive_name());
+  EXPECT_EQ(aes_gcm_siv_key_type, config.entry(7).type_url());
   EXPECT_EQ(true, config.entry(7).new_key_allowed());
   EXPECT_EQ(0, config.entry(7).key_manager_version());
 
+  EXPECT_EQ("TinkAead", config.entry(8).catalogue_name());
+  EXPECT_EQ("Aead", config.entry(8).primitive_name());
+  EXPECT_EQ(chacha20_poly1305_key_type, config.entry(8).type_url());
+  EXPECT_EQ(true, config.entry(8).new_key_allowed());
+  EXPECT_EQ(0, config.entry(8).key_manager_version());
+
+  EXPECT_EQ("TinkHybridDecrypt", config.entry(9).catalogue_name());
+  EXPECT_EQ("HybridDecrypt", config.entry(9).primitive_name());
+  EXPECT_EQ(hybrid_decrypt_key_type, config.entry(9).type_url());
+  EXPECT_EQ(true, config.entry(9).new_key_allowed());
+  EXPECT_EQ(0, config.entry(9).key_manager_version());
+
+  EXPECT_EQ("TinkHybridEncrypt", config.entry(10).catalogue_name());
+  EXPECT_EQ("HybridEncrypt", config.entry(10).primitive_name());
+  EXPECT_EQ(hybrid_encrypt_key_type, config.entry(10).type_url());
+  EXPECT_EQ(true, config.entry(10).new_key_allowed());
+  EXPECT_EQ(0, config.entry(10).key_manager_version());
+
+  EXPECT_EQ("TinkHybridDecrypt", config.entry(11).catalogue_name());
+  EXPECT_EQ("HybridDecrypt", config.entry(11).primitive_name());
+  EXPECT_EQ(hpke_decrypt_key_type, config.entry(11).type_url());
+  EXPECT_EQ(true, config.entry(11).new_key_allowed());
+  EXPECT_EQ(0, config.entry(11).key_manager_version());
+
+  EXPECT_EQ("TinkHybridEncrypt", config.entry(12).catalogue_name());
+  EXPECT_EQ("HybridEncrypt", config.entry(12).primitive_name());
+  EXPECT_EQ(hpke_encrypt_key_type, config.entry(12).type_url());
+  EXPECT_EQ(true, config.entry(12).new_key_allowed());
+  EXPECT_EQ(0, config.entry(12).key_manager_version());
+
+  EXPECT_EQ("TinkPublicKeySign", config.entry(13).catalogue_name());
+  EXPECT_EQ("PublicKeySign", config.entry(13).primitive_name());
+  EXPECT_EQ(public_key_sign_key_type, config.entry(13).type_url());
+  EXPECT_EQ(true, config.entry(13).new_key_allowed());
+  EXPECT_EQ(0, config.entry(13).key_manager_version());
+
+  EXPECT_EQ("TinkPublicKeyVerify", config.entry(14).catalogue_name());
+  EXPECT_EQ("PublicKeyVerify", config.entry(14).primitive_name());
+  EXPECT_EQ(public_key_verify_key_type, config.entry(14).type_url());
+  EXPECT_EQ(true, config.entry(14).new_key_allowed());
+  EXPECT_EQ(0, config.entry(14).key_manager_version());
+
+  EXPECT_EQ("TinkPublicKeySign", config.entry(15).catalogue_name());
+  EXPECT_EQ("PublicKeySign", config.entry(15).primitive_name());
+  EXPECT_EQ(ed25519_sign_key_type, config.entry(15).type_url());
+  EXPECT_EQ(true, config.entry(15).new_key_allowed());
+  EXPECT_EQ(0, config.entry(15).key_manager_version());
+
+  EXPECT_EQ("TinkPublicKeyVerify", config.entry(16).catalogue_name());
+  EXPECT_EQ("PublicKeyVerify", config.entry(16).primitive_name());
+  EXPECT_EQ(ed25519_verify_key_type, config.entry(16).type_url());
+  EXPECT_EQ(true, config.entry(16).new_key_allowed());
+  EXPECT_EQ(0, config.entry(16).key_manager_version());
+
+  EXPECT_EQ("TinkDeterministicAead", config.entry(17).catalogue_name());
+  EXPECT_EQ("DeterministicAead", config.entry(17).primitive_name());
+  EXPECT_EQ(aes_siv_key_type, config.entry(17).type_url());
+  EXPECT_EQ(true, config.entry(17).new_key_allowed());
+  EXPECT_EQ(0, config.entry(17).key_manager_version());
+
   // No key manager before registration.
   {
     auto manager_result = Registry::get_key_manager<Aead>(aes_gcm_key_type);
@@ -156,6 +237,12 @@ TEST_F(TinkConfigTest, testBasic) {
     EXPECT_FALSE(manager_result.ok());
     EXPECT_EQ(util::error::NOT_FOUND, manager_result.status().error_code());
   }
+  {
+    auto manager_result =
+        Registry::get_key_manager<DeterministicAead>(aes_siv_key_type);
+    EXPECT_FALSE(manager_result.ok());
+    EXPECT_EQ(util::error::NOT_FOUND, manager_result.status().error_code());
+  }
 
   // Registration of standard key types works.
   auto status = TinkConfig::Register();
@@ -198,6 +285,12 @@ TEST_F(TinkConfigTest, testBasic) {
     EXPECT_TRUE(manager_result.ValueOrDie()->DoesSupport(
         public_key_verify_key_type));
   }
+  {
+    auto manager_result =
+        Registry::get_key_manager<DeterministicAead>(aes_siv_key_type);
+    EXPECT_TRUE(manager_result.ok()) << manager_result.status();
+    EXPECT_TRUE(manager_result.ValueOrDie()->DoesSupport(aes_siv_key_type));
+  }
 }
 
 TEST_F(TinkConfigTest, testRegister) {
@@ -0,0 +1,43 @@
+// Copyright 2018 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/aead.h"
+
+#include "absl/strings/string_view.h"
+#include "tink/output_buffer.h"
+#include "tink/util/status.h"
+
+namespace crypto {
+namespace tink {
+
+util::Status Aead::EncryptInto(absl::string_view plaintext,
+                               absl::string_view associated_data,
+                               OutputBuffer* ciphertext) const {
+  auto encrypt_result = Encrypt(plaintext, associated_data);
+  if (!encrypt_result.ok()) return encrypt_result.status();
+  return WriteToOutputBuffer(encrypt_result.ValueOrDie(), ciphertext);
+}
+
+util::Status Aead::DecryptInto(absl::string_view ciphertext,
+                               absl::string_view associated_data,
+                               OutputBuffer* plaintext) const {
+  auto decrypt_result = Decrypt(ciphertext, associated_data);
+  if (!decrypt_result.ok()) return decrypt_result.status();
+  return WriteToOutputBuffer(decrypt_result.ValueOrDie(), plaintext);
+}
+
+}  // namespace tink
+}  // namespace crypto
@@ -16,11 +16,19 @@
 
 #include "tink/binary_keyset_reader.h"
 
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
 #include <iostream>
 #include <istream>
 #include <sstream>
 
 #include "absl/memory/memory.h"
+#include "google/protobuf/arena.h"
+#include "google/protobuf/io/coded_stream.h"
+#include "google/protobuf/wire_format_lite.h"
 #include "tink/util/errors.h"
 #include "tink/util/status.h"
 #include "tink/util/statusor.h"
@@ -30,7 +38,88 @@ namespace crypto {
 namespace tink {
 
 using google::crypto::tink::EncryptedKeyset;
+using google::crypto::tink::KeyStatusType;
 using google::crypto::tink::Keyset;
+using google::crypto::tink::KeysetInfo;
+using google::crypto::tink::OutputPrefixType;
+using google::protobuf::internal::WireFormatLite;
+using google::protobuf::io::CodedInputStream;
+
+namespace {
+
+// Field numbers of Keyset, Keyset.Key and KeyData, cf. proto/tink.proto.
+const int kKeysetPrimaryKeyIdField = 1;
+const int kKeysetKeyField = 2;
+const int kKeyKeyDataField = 1;
+const int kKeyStatusField = 2;
+const int kKeyKeyIdField = 3;
+const int kKeyOutputPrefixTypeField = 4;
+const int kKeyDataTypeUrlField = 1;
+
+bool IsField(uint32_t tag, int field_number,
+             WireFormatLite::WireType wire_type) {
+  return WireFormatLite::GetTagFieldNumber(tag) == field_number &&
+         WireFormatLite::GetTagWireType(tag) == wire_type;
+}
+
+// Calls 'parse_field' for each field of the length-delimited message
+// at the current position of 'input'.
+template <typename FieldParser>
+bool ParseEmbeddedMessage(CodedInputStream* input,
+                          const FieldParser& parse_field) {
+  int length;
+  if (!input->ReadVarintSizeAsInt(&length)) return false;
+  // PushLimit() would clamp the length of a truncated message to the end
+  // of the input, and the message would parse as a shorter one.
+  if (length > input->BytesUntilLimit()) return false;
+  auto limit = input->PushLimit(length);
+  uint32_t tag;
+  while ((tag = input->ReadTag()) != 0) {
+    if (!parse_field(tag)) return false;
+  }
+  if (!input->ConsumedEntireMessage()) return false;
+  input->PopLimit(limit);
+  return true;
+}
+
+// Parses KeyData at the current position of 'input', keeping only the
+// type URL; the key material is skipped without being copied.
+bool ParseKeyDataTypeUrl(CodedInputStream* input, KeysetInfo::KeyInfo* info) {
+  return ParseEmbeddedMessage(input, [input, info](uint32_t tag) {
+    if (IsField(tag, kKeyDataTypeUrlField,
+                WireFormatLite::WIRETYPE_LENGTH_DELIMITED)) {
+      return WireFormatLite::ReadString(input, info->mutable_type_url());
+    }
+    return WireFormatLite::SkipField(input, tag);
+  });
+}
+
+// Parses Keyset.Key at the current position of 'input' into 'info'.
+bool ParseKeyInfo(CodedInputStream* input, KeysetInfo::KeyInfo* info) {
+  return ParseEmbeddedMessage(input, [input, info](uint32_t tag) {
+    uint32_t value;
+    if (IsField(tag, kKeyKeyDataField,
+                WireFormatLite::WIRETYPE_LENGTH_DELIMITED)) {
+      return ParseKeyDataTypeUrl(input, info);
+    } else if (IsField(tag, kKeyStatusField, WireFormatLite::WIRETYPE_VARINT)) {
+      if (!input->ReadVarint32(&value)) return false;
+      info->set_status(static_cast<KeyStatusType>(value));
+      return true;
+    } else if (IsField(tag, kKeyKeyIdField, WireFormatLite::WIRETYPE_VARINT)) {
+      if (!input->ReadVarint32(&value)) return false;
+      info->set_key_id(value);
+      return true;
+    } else if (IsField(tag, kKeyOutputPrefixTypeField,
+                       WireFormatLite::WIRETYPE_VARINT)) {
+      if (!input->ReadVarint32(&value)) return false;
+      info->set_output_prefix_type(static_cast<OutputPrefixType>(value));
+      return true;
+    }
+    return WireFormatLite::SkipField(input, tag);
+  });
+}
+
+}  // anonymous namespace
 
 //  static
 util::StatusOr<std::unique_ptr<KeysetReader>> BinaryKeysetReader::New(
@@ -52,24 +141,114 @@ util::StatusOr<std::unique_ptr<KeysetReader>> BinaryKeysetReader::New(
   return std::move(reader);
 }
 
+//  static
+util::StatusOr<std::unique_ptr<BinaryKeysetReader>>
+BinaryKeysetReader::NewFromFile(const std::string& filename) {
+  int fd = open(filename.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return ToStatusF(util::error::INVALID_ARGUMENT,
+                     "Could not open the keyset file '%s'.", filename.c_str());
+  }
+  struct stat file_stat;
+  if (fstat(fd, &file_stat) != 0) {
+    close(fd);
+    return ToStatusF(util::error::INVALID_ARGUMENT,
+                     "Could not stat the keyset file '%s'.", filename.c_str());
+  }
+  size_t file_size = file_stat.st_size;
+  if (file_size == 0) {
+    // An empty mapping is not allowed, and there is nothing to share anyway.
+    close(fd);
+    std::unique_ptr<BinaryKeysetReader> reader(new BinaryKeysetReader(""));
+    return std::move(reader);
+  }
+  void* mapped_data = mmap(nullptr, file_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  // The mapping stays valid after the descriptor is closed.
+  close(fd);
+  if (mapped_data == MAP_FAILED) {
+    return ToStatusF(util::error::INVALID_ARGUMENT,
+                     "Could not map the keyset file '%s'.", filename.c_str());
+  }
+  std::unique_ptr<BinaryKeysetReader> reader(
+      new BinaryKeysetReader(mapped_data, file_size));
+  return std::move(reader);
+}
+
+BinaryKeysetReader::~BinaryKeysetReader() {
+  if (mapped_data_ != nullptr) munmap(mapped_data_, mapped_size_);
+}
+
+absl::string_view BinaryKeysetReader::serialized_keyset() const {
+  if (mapped_data_ != nullptr) {
+    return absl::string_view(static_cast<const char*>(mapped_data_),
+                             mapped_size_);
+  }
+  return serialized_keyset_;
+}
+
 util::StatusOr<std::unique_ptr<Keyset>> BinaryKeysetReader::Read() {
   auto keyset = absl::make_unique<Keyset>();
-  if (!keyset->ParseFromString(serialized_keyset_)) {
+  absl::string_view serialized = serialized_keyset();
+  if (!keyset->ParseFromArray(serialized.data(), serialized.size())) {
     return util::Status(util::error::INVALID_ARGUMENT,
                         "Could not parse the input stream as a Keyset-proto.");
   }
   return std::move(keyset);
 }
 
+util::StatusOr<Keyset*> BinaryKeysetReader::ReadOnArena(
+    google::protobuf::Arena* arena) {
+  auto keyset = google::protobuf::Arena::CreateMessage<Keyset>(arena);
+  absl::string_view serialized = serialized_keyset();
+  if (!keyset->ParseFromArray(serialized.data(), serialized.size())) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "Could not parse the input stream as a Keyset-proto.");
+  }
+  return keyset;
+}
+
 util::StatusOr<std::unique_ptr<EncryptedKeyset>>
 BinaryKeysetReader::ReadEncrypted() {
   auto enc_keyset = absl::make_unique<EncryptedKeyset>();
-  if (!enc_keyset->ParseFromString(serialized_keyset_)) {
+  absl::string_view serialized = serialized_keyset();
+  if (!enc_keyset->ParseFromArray(serialized.data(), serialized.size())) {
     return util::Status(util::error::INVALID_ARGUMENT,
         "Could not parse the input stream as an EncryptedKeyset-proto.");
   }
   return std::move(enc_keyset);
 }
 
+util::StatusOr<std::unique_ptr<KeysetInfo>>
+BinaryKeysetReader::ReadKeysetInfo() {
+  absl::string_view serialized = serialized_keyset();
+  CodedInputStream input(reinterpret_cast<const uint8_t*>(serialized.data()),
+                         serialized.size());
+  auto keyset_info = absl::make_unique<KeysetInfo>();
+  uint32_t tag;
+  while ((tag = input.ReadTag()) != 0) {
+    bool parsed;
+    if (IsField(tag, kKeysetPrimaryKeyIdField,
+                WireFormatLite::WIRETYPE_VARINT)) {
+      uint32_t primary_key_id;
+      parsed = input.ReadVarint32(&primary_key_id);
+      keyset_info->set_primary_key_id(primary_key_id);
+    } else if (IsField(tag, kKeysetKeyField,
+                       WireFormatLite::WIRETYPE_LENGTH_DELIMITED)) {
+      parsed = ParseKeyInfo(&input, keyset_info->add_key_info());
+    } else {
+      parsed = WireFormatLite::SkipField(&input, tag);
+    }
+    if (!parsed) {
+      return util::Status(util::error::INVALID_ARGUMENT,
+                          "Could not parse the input as a Keyset-proto.");
+    }
+  }
+  if (!input.ConsumedEntireMessage()) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "Could not parse the input as a Keyset-proto.");
+  }
+  return std::move(keyset_info);
+}
+
 }  // namespace tink
 }  // namespace crypto
@@ -16,10 +16,14 @@
 
 #include "tink/binary_keyset_reader.h"
 
+#include <stdlib.h>
+
+#include <fstream>
 #include <iostream>
 #include <istream>
 #include <sstream>
 
+#include "google/protobuf/arena.h"
 #include "tink/util/test_util.h"
 #include "gtest/gtest.h"
 #include "proto/tink.pb.h"
@@ -30,6 +34,7 @@ using crypto::tink::test::AddTinkKey;
 using google::crypto::tink::EncryptedKeyset;
 using google::crypto::tink::KeyData;
 using google::crypto::tink::Keyset;
+using google::crypto::tink::KeysetInfo;
 using google::crypto::tink::KeyStatusType;
 
 namespace crypto {
@@ -151,6 +156,130 @@ TEST_F(BinaryKeysetReaderTest, testReadFromStream) {
   }
 }
 
+TEST_F(BinaryKeysetReaderTest, testReadOnArena) {
+  {  // Good std::string.
+    auto reader_result = BinaryKeysetReader::New(good_serialized_keyset_);
+    EXPECT_TRUE(reader_result.ok()) << reader_result.status();
+    auto reader = std::move(reader_result.ValueOrDie());
+    google::protobuf::Arena arena;
+    auto read_result = reader->ReadOnArena(&arena);
+    EXPECT_TRUE(read_result.ok()) << read_result.status();
+    Keyset* keyset = read_result.ValueOrDie();
+    EXPECT_EQ(&arena, keyset->GetArena());
+    EXPECT_EQ(good_serialized_keyset_, keyset->SerializeAsString());
+  }
+
+  {  // Bad std::string.
+    auto reader_result = BinaryKeysetReader::New(bad_serialized_keyset_);
+    EXPECT_TRUE(reader_result.ok()) << reader_result.status();
+    auto reader = std::move(reader_result.ValueOrDie());
+    google::protobuf::Arena arena;
+    auto read_result = reader->ReadOnArena(&arena);
+    EXPECT_FALSE(read_result.ok());
+    EXPECT_EQ(util::error::INVALID_ARGUMENT,
+              read_result.status().error_code());
+  }
+}
+
+TEST_F(BinaryKeysetReaderTest, testReadFromFile) {
+  std::string filename =
+      std::string(getenv("TEST_TMPDIR")) + "/binary_keyset_reader_test.bin";
+  {
+    std::ofstream file(filename, std::ios_base::binary);
+    file << good_serialized_keyset_;
+  }
+
+  {  // Good file.
+    auto reader_result = BinaryKeysetReader::NewFromFile(filename);
+    EXPECT_TRUE(reader_result.ok()) << reader_result.status();
+    auto reader = std::move(reader_result.ValueOrDie());
+    auto read_result = reader->Read();
+    EXPECT_TRUE(read_result.ok()) << read_result.status();
+    auto keyset = std::move(read_result.ValueOrDie());
+    EXPECT_EQ(good_serialized_keyset_, keyset->SerializeAsString());
+  }
+
+  {  // Missing file.
+    auto reader_result =
+        BinaryKeysetReader::NewFromFile(filename + ".does_not_exist");
+    EXPECT_FALSE(reader_result.ok());
+    EXPECT_EQ(util::error::INVALID_ARGUMENT,
+              reader_result.status().error_code());
+  }
+}
+
+TEST_F(BinaryKeysetReaderTest, testReadKeysetInfo) {
+  {  // Empty file.
+    auto reader = std::move(
+        BinaryKeysetReader::NewFromFile("/dev/null").ValueOrDie());
+    auto read_result = reader->ReadKeysetInfo();
+    EXPECT_TRUE(read_result.ok()) << read_result.status();
+    EXPECT_EQ(0, read_result.ValueOrDie()->key_info_size());
+  }
+
+  {  // Keyset with keys.
+    std::string filename =
+        std::string(getenv("TEST_TMPDIR")) + "/keyset_info_test.bin";
+    {
+      std::ofstream file(filename, std::ios_base::binary);
+      file << good_serialized_keyset_;
+    }
+    auto reader =
+        std::move(BinaryKeysetReader::NewFromFile(filename).ValueOrDie());
+    auto read_result = reader->ReadKeysetInfo();
+    EXPECT_TRUE(read_result.ok()) << read_result.status();
+    auto keyset_info = std::move(read_result.ValueOrDie());
+    EXPECT_EQ(keyset_.primary_key_id(), keyset_info->primary_key_id());
+    EXPECT_EQ(keyset_.key_size(), keyset_info->key_info_size());
+    for (int i = 0; i < keyset_.key_size(); i++) {
+      const Keyset::Key& key = keyset_.key(i);
+      const KeysetInfo::KeyInfo& key_info = keyset_info->key_info(i);
+      EXPECT_EQ(key.key_data().type_url(), key_info.type_url());
+      EXPECT_EQ(key.status(), key_info.status());
+      EXPECT_EQ(key.key_id(), key_info.key_id());
+      EXPECT_EQ(key.output_prefix_type(), key_info.output_prefix_type());
+    }
+  }
+}
+
+TEST_F(BinaryKeysetReaderTest, testReadKeysetInfoMalformed) {
+  std::string filename =
+      std::string(getenv("TEST_TMPDIR")) + "/keyset_info_malformed_test.bin";
+  std::string truncated_keyset =
+      good_serialized_keyset_.substr(0, good_serialized_keyset_.size() - 1);
+  for (const std::string& serialized_keyset :
+       {bad_serialized_keyset_, truncated_keyset}) {
+    {
+      std::ofstream file(filename, std::ios_base::binary);
+      file << serialized_keyset;
+    }
+    auto reader =
+        std::move(BinaryKeysetReader::NewFromFile(filename).ValueOrDie());
+    auto read_result = reader->ReadKeysetInfo();
+    EXPECT_FALSE(read_result.ok());
+    EXPECT_EQ(util::error::INVALID_ARGUMENT,
+              read_result.status().error_code());
+  }
+
+  // Every prefix of a keyset is accepted exactly when the full proto parser
+  // accepts it, i.e. when it ends between two fields.
+  for (size_t size = 0; size < good_serialized_keyset_.size(); size++) {
+    std::string prefix = good_serialized_keyset_.substr(0, size);
+    {
+      std::ofstream file(filename, std::ios_base::binary);
+      file << prefix;
+    }
+    auto reader =
+        std::move(BinaryKeysetReader::NewFromFile(filename).ValueOrDie());
+    auto read_result = reader->ReadKeysetInfo();
+    Keyset keyset;
+    ASSERT_EQ(keyset.ParseFromString(prefix), read_result.ok()) << size;
+    if (read_result.ok()) {
+      EXPECT_EQ(keyset.key_size(), read_result.ValueOrDie()->key_info_size());
+    }
+  }
+}
+
 TEST_F(BinaryKeysetReaderTest, testReadEncryptedFromString) {
   {  // Good std::string.
     auto reader_result =
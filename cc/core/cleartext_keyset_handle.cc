@@ -18,6 +18,8 @@
 
 #include <istream>
 
+#include "absl/memory/memory.h"
+#include "google/protobuf/arena.h"
 #include "tink/keyset_handle.h"
 #include "tink/keyset_reader.h"
 #include "tink/util/errors.h"
@@ -34,14 +36,15 @@ namespace tink {
 // static
 util::StatusOr<std::unique_ptr<KeysetHandle>> CleartextKeysetHandle::Read(
     std::unique_ptr<KeysetReader> reader) {
-  auto keyset_result = reader->Read();
+  auto arena = absl::make_unique<google::protobuf::Arena>();
+  auto keyset_result = reader->ReadOnArena(arena.get());
   if (!keyset_result.ok()) {
     return ToStatusF(util::error::INVALID_ARGUMENT,
                      "Error reading keyset data: %s",
                      keyset_result.status().error_message().c_str());
   }
   std::unique_ptr<KeysetHandle> handle(
-      new KeysetHandle(std::move(keyset_result.ValueOrDie())));
+      new KeysetHandle(std::move(arena), keyset_result.ValueOrDie()));
   return std::move(handle);
 }
 
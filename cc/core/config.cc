@@ -18,10 +18,12 @@
 
 #include "tink/mac.h"
 #include "tink/aead.h"
+#include "tink/deterministic_aead.h"
 #include "tink/hybrid_decrypt.h"
 #include "tink/hybrid_encrypt.h"
 #include "tink/public_key_sign.h"
 #include "tink/public_key_verify.h"
+#include "tink/streaming_aead.h"
 #include "absl/strings/ascii.h"
 #include "tink/util/errors.h"
 #include "tink/util/status.h"
@@ -78,6 +80,8 @@ util::Status Config::Register(
       status = Register<Mac>(entry);
     } else if (primitive_name == "aead") {
       status = Register<Aead>(entry);
+    } else if (primitive_name == "deterministicaead") {
+      status = Register<DeterministicAead>(entry);
     } else if (primitive_name == "hybriddecrypt") {
       status = Register<HybridDecrypt>(entry);
     } else if (primitive_name == "hybridencrypt") {
@@ -86,6 +90,8 @@ util::Status Config::Register(
       status = Register<PublicKeySign>(entry);
     } else if (primitive_name == "publickeyverify") {
       status = Register<PublicKeyVerify>(entry);
+    } else if (primitive_name == "streamingaead") {
+      status = Register<StreamingAead>(entry);
     } else {
       status = ToStatusF(crypto::tink::util::error::INVALID_ARGUMENT,
                          "A non-standard primitive '%s' '%s', "
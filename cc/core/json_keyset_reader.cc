@@ -22,6 +22,7 @@
 
 #include "absl/memory/memory.h"
 #include "absl/strings/escaping.h"
+#include "google/protobuf/arena.h"
 #include "include/rapidjson/document.h"
 #include "include/rapidjson/error/en.h"
 #include "tink/util/enums.h"
@@ -177,51 +178,49 @@ tinkutil::Status ValidateKeyData(const rapidjson::Value& json_value) {
   return tinkutil::Status::OK;
 }
 
-tinkutil::StatusOr<std::unique_ptr<KeyData>>
-KeyDataFromJson(const rapidjson::Value& json_value) {
+// The helpers below fill in messages provided by the caller, so that
+// the whole keyset is allocated wherever the top-level Keyset lives
+// (e.g. on an arena), without temporary copies of the key material.
+tinkutil::Status KeyDataFromJson(const rapidjson::Value& json_value,
+                                 KeyData* key_data) {
   auto status = ValidateKeyData(json_value);
   if (!status.ok()) return status;
-  std::string value_field;
-  if (!absl::Base64Unescape(json_value["value"].GetString(), &value_field)) {
+  if (!absl::Base64Unescape(json_value["value"].GetString(),
+                            key_data->mutable_value())) {
     return tinkutil::Status(tinkutil::error::INVALID_ARGUMENT,
                             "Invalid JSON KeyData");
   }
-  auto key_data = absl::make_unique<KeyData>();
   key_data->set_type_url(json_value["typeUrl"].GetString());
-  key_data->set_value(value_field);
   key_data->set_key_material_type(
       Enums::KeyMaterial(json_value["keyMaterialType"].GetString()));
-  return std::move(key_data);
+  return tinkutil::Status::OK;
 }
 
-tinkutil::StatusOr<std::unique_ptr<Keyset::Key>>
-KeyFromJson(const rapidjson::Value& json_value) {
+tinkutil::Status KeyFromJson(const rapidjson::Value& json_value,
+                             Keyset::Key* key) {
   auto status = ValidateKey(json_value);
   if (!status.ok()) return status;
-  auto key_data_result = KeyDataFromJson(json_value["keyData"]);
-  if (!key_data_result.ok()) return key_data_result.status();
-
-  auto key = absl::make_unique<Keyset::Key>();
+  status = KeyDataFromJson(json_value["keyData"], key->mutable_key_data());
+  if (!status.ok()) return status;
   key->set_key_id(json_value["keyId"].GetUint());
   key->set_status(Enums::KeyStatus(json_value["status"].GetString()));
   key->set_output_prefix_type(
       Enums::OutputPrefix(json_value["outputPrefixType"].GetString()));
-  *(key->mutable_key_data()) = *(key_data_result.ValueOrDie());
-  return std::move(key);
+  return tinkutil::Status::OK;
 }
 
-tinkutil::StatusOr<std::unique_ptr<Keyset>>
-KeysetFromJson(const rapidjson::Document& json_doc) {
+tinkutil::Status KeysetFromJson(const rapidjson::Document& json_doc,
+                                Keyset* keyset) {
   auto status = ValidateKeyset(json_doc);
   if (!status.ok()) return status;
-  auto keyset = absl::make_unique<Keyset>();
   keyset->set_primary_key_id(json_doc["primaryKeyId"].GetUint());
-  for (const auto& json_key : json_doc["key"].GetArray()) {
-    auto key_result = KeyFromJson(json_key);
-    if (!key_result.ok()) return key_result.status();
-    *(keyset->add_key()) = *(key_result.ValueOrDie());
+  const auto& json_keys = json_doc["key"].GetArray();
+  keyset->mutable_key()->Reserve(json_keys.Size());
+  for (const auto& json_key : json_keys) {
+    status = KeyFromJson(json_key, keyset->add_key());
+    if (!status.ok()) return status;
   }
-  return std::move(keyset);
+  return tinkutil::Status::OK;
 }
 
 }  // namespace
@@ -246,7 +245,7 @@ tinkutil::StatusOr<std::unique_ptr<KeysetReader>> JsonKeysetReader::New(
   return std::move(reader);
 }
 
-tinkutil::StatusOr<std::unique_ptr<Keyset>> JsonKeysetReader::Read() {
+tinkutil::Status JsonKeysetReader::ReadKeyset(Keyset* keyset) {
   std::string serialized_keyset_from_stream;
   std::string* serialized_keyset;
   if (keyset_stream_ == nullptr) {
@@ -263,7 +262,22 @@ tinkutil::StatusOr<std::unique_ptr<Keyset>> JsonKeysetReader::Read() {
         (unsigned)json_doc.GetErrorOffset(),
         rapidjson::GetParseError_En(json_doc.GetParseError()));
   }
-  return KeysetFromJson(json_doc);
+  return KeysetFromJson(json_doc, keyset);
+}
+
+tinkutil::StatusOr<std::unique_ptr<Keyset>> JsonKeysetReader::Read() {
+  auto keyset = absl::make_unique<Keyset>();
+  auto status = ReadKeyset(keyset.get());
+  if (!status.ok()) return status;
+  return std::move(keyset);
+}
+
+tinkutil::StatusOr<Keyset*> JsonKeysetReader::ReadOnArena(
+    google::protobuf::Arena* arena) {
+  auto keyset = google::protobuf::Arena::CreateMessage<Keyset>(arena);
+  auto status = ReadKeyset(keyset);
+  if (!status.ok()) return status;
+  return keyset;
 }
 
 tinkutil::StatusOr<std::unique_ptr<EncryptedKeyset>>
@@ -21,6 +21,7 @@
 #include <sstream>
 
 #include "absl/strings/escaping.h"
+#include "google/protobuf/arena.h"
 #include "tink/util/protobuf_helper.h"
 #include "tink/util/test_util.h"
 #include "gtest/gtest.h"
@@ -220,6 +221,31 @@ TEST_F(JsonKeysetReaderTest, testReadFromStream) {
   }
 }
 
+TEST_F(JsonKeysetReaderTest, testReadOnArena) {
+  {  // Good std::string.
+    auto reader_result = JsonKeysetReader::New(good_json_keyset);
+    EXPECT_TRUE(reader_result.ok()) << reader_result.status();
+    auto reader = std::move(reader_result.ValueOrDie());
+    google::protobuf::Arena arena;
+    auto read_result = reader->ReadOnArena(&arena);
+    EXPECT_TRUE(read_result.ok()) << read_result.status();
+    Keyset* keyset = read_result.ValueOrDie();
+    EXPECT_EQ(&arena, keyset->GetArena());
+    EXPECT_EQ(keyset_.SerializeAsString(), keyset->SerializeAsString());
+  }
+
+  {  // Bad std::string.
+    auto reader_result = JsonKeysetReader::New(bad_json_keyset);
+    EXPECT_TRUE(reader_result.ok()) << reader_result.status();
+    auto reader = std::move(reader_result.ValueOrDie());
+    google::protobuf::Arena arena;
+    auto read_result = reader->ReadOnArena(&arena);
+    EXPECT_FALSE(read_result.ok());
+    EXPECT_EQ(util::error::INVALID_ARGUMENT,
+              read_result.status().error_code());
+  }
+}
+
 TEST_F(JsonKeysetReaderTest, testReadEncryptedFromString) {
   {  // Good std::string.
     auto reader_result =
@@ -15,6 +15,8 @@
 ///////////////////////////////////////////////////////////////////////////////
 
 #include "absl/memory/memory.h"
+#include "google/protobuf/arena.h"
+#include "openssl/mem.h"
 #include "tink/aead.h"
 #include "tink/keyset_handle.h"
 #include "tink/keyset_manager.h"
@@ -45,17 +47,30 @@ Encrypt(const Keyset& keyset, const Aead& master_key_aead) {
   return std::move(enc_keyset);
 }
 
-util::StatusOr<std::unique_ptr<Keyset>>
-Decrypt(const EncryptedKeyset& enc_keyset, const Aead& master_key_aead) {
+// Decrypts 'enc_keyset' into a Keyset allocated on 'arena'.
+util::StatusOr<Keyset*> Decrypt(const EncryptedKeyset& enc_keyset,
+                                const Aead& master_key_aead,
+                                google::protobuf::Arena* arena) {
   auto decrypt_result = master_key_aead.Decrypt(
           enc_keyset.encrypted_keyset(), /* associated_data= */ "");
   if (!decrypt_result.ok()) return decrypt_result.status();
-  auto keyset = absl::make_unique<Keyset>();
-  if (!keyset->ParseFromString(decrypt_result.ValueOrDie())) {
+  std::string& serialized_keyset = decrypt_result.ValueOrDie();
+  auto keyset = google::protobuf::Arena::CreateMessage<Keyset>(arena);
+  bool parsed = keyset->ParseFromString(serialized_keyset);
+  OPENSSL_cleanse(&serialized_keyset[0], serialized_keyset.size());
+  if (!parsed) {
     return util::Status(util::error::INVALID_ARGUMENT,
         "Could not parse the decrypted data as a Keyset-proto.");
   }
-  return std::move(keyset);
+  return keyset;
+}
+
+// Overwrites the key material held by 'keyset' with zeros.
+void WipeKeyMaterial(Keyset* keyset) {
+  for (Keyset::Key& key : *keyset->mutable_key()) {
+    std::string* value = key.mutable_key_data()->mutable_value();
+    OPENSSL_cleanse(&(*value)[0], value->size());
+  }
 }
 
 }  // anonymous namespace
@@ -70,8 +85,9 @@ util::StatusOr<std::unique_ptr<KeysetHandle>> KeysetHandle::Read(
                      enc_keyset_result.status().error_message().c_str());
   }
 
+  auto arena = absl::make_unique<google::protobuf::Arena>();
   auto keyset_result =
-      Decrypt(*enc_keyset_result.ValueOrDie(), master_key_aead);
+      Decrypt(*enc_keyset_result.ValueOrDie(), master_key_aead, arena.get());
   if (!keyset_result.ok()) {
     return ToStatusF(util::error::INVALID_ARGUMENT,
                      "Error decrypting encrypted keyset: %s",
@@ -79,7 +95,7 @@ util::StatusOr<std::unique_ptr<KeysetHandle>> KeysetHandle::Read(
   }
 
   std::unique_ptr<KeysetHandle> handle(
-      new KeysetHandle(std::move(keyset_result.ValueOrDie())));
+      new KeysetHandle(std::move(arena), keyset_result.ValueOrDie()));
   return std::move(handle);
 }
 
@@ -138,10 +154,19 @@ KeysetHandle::GetPublicKeysetHandle() {
 }
 
 KeysetHandle::KeysetHandle(std::unique_ptr<Keyset> keyset)
-    : keyset_(std::move(keyset)) {}
+    : arena_(nullptr), keyset_(keyset.release()) {}
+
+KeysetHandle::KeysetHandle(std::unique_ptr<google::protobuf::Arena> arena,
+                           Keyset* keyset)
+    : arena_(std::move(arena)), keyset_(keyset) {}
+
+KeysetHandle::~KeysetHandle() {
+  WipeKeyMaterial(keyset_);
+  if (arena_ == nullptr) delete keyset_;
+}
 
 const Keyset& KeysetHandle::get_keyset() const {
-  return *(keyset_.get());
+  return *keyset_;
 }
 
 }  // namespace tink
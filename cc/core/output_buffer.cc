@@ -0,0 +1,57 @@
+// Copyright 2018 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/output_buffer.h"
+
+#include <string.h>
+
+#include <limits>
+
+#include "absl/strings/string_view.h"
+#include "tink/util/status.h"
+
+namespace crypto {
+namespace tink {
+
+char* FixedOutputBuffer::Resize(size_t size) {
+  if (size > capacity_) return nullptr;
+  size_ = size;
+  return data_;
+}
+
+char* PrefixedOutputBuffer::Resize(size_t size) {
+  if (size > std::numeric_limits<size_t>::max() - prefix_.size()) {
+    return nullptr;
+  }
+  char* data = buffer_->Resize(prefix_.size() + size);
+  if (data == nullptr) return nullptr;
+  if (!prefix_.empty()) memcpy(data, prefix_.data(), prefix_.size());
+  return data + prefix_.size();
+}
+
+util::Status WriteToOutputBuffer(absl::string_view data,
+                                 OutputBuffer* buffer) {
+  char* output = buffer->Resize(data.size());
+  if (output == nullptr) {
+    return util::Status(util::error::RESOURCE_EXHAUSTED,
+                        "output buffer too small");
+  }
+  if (!data.empty()) memcpy(output, data.data(), data.size());
+  return util::Status::OK;
+}
+
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,263 @@
+// Copyright 2018 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/output_buffer.h"
+
+#include <stdlib.h>
+
+#include <atomic>
+#include <new>
+#include <string>
+
+#include "gtest/gtest.h"
+#include "tink/aead.h"
+#include "tink/aead/aead_config.h"
+#include "tink/aead/aead_factory.h"
+#include "tink/aead/aead_key_templates.h"
+#include "tink/keyset_handle.h"
+#include "tink/mac.h"
+#include "tink/mac/mac_config.h"
+#include "tink/mac/mac_factory.h"
+#include "tink/mac/mac_key_templates.h"
+#include "tink/public_key_sign.h"
+#include "tink/signature/public_key_sign_factory.h"
+#include "tink/signature/signature_config.h"
+#include "tink/signature/signature_key_templates.h"
+#include "tink/util/status.h"
+#include "tink/util/test_util.h"
+
+// Counts memory allocations, so that the tests can verify that the *Into()
+// methods do not allocate memory in steady state. new_count counts the calls
+// of the global operator new. With glibc, malloc_count counts all calls of
+// malloc, including those made by BoringSSL; elsewhere it stays 0.
+std::atomic<int> new_count(0);
+std::atomic<int> malloc_count(0);
+
+void* operator new(size_t size) {
+  new_count++;
+  void* p = malloc(size == 0 ? 1 : size);
+  if (p == nullptr) throw std::bad_alloc();
+  return p;
+}
+
+void operator delete(void* p) noexcept { free(p); }
+
+#if defined(__GLIBC__)
+
+extern "C" {
+
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t count, size_t size);
+void* __libc_realloc(void* p, size_t size);
+
+void* malloc(size_t size) {
+  malloc_count++;
+  return __libc_malloc(size);
+}
+
+void* calloc(size_t count, size_t size) {
+  malloc_count++;
+  return __libc_calloc(count, size);
+}
+
+void* realloc(void* p, size_t size) {
+  malloc_count++;
+  return __libc_realloc(p, size);
+}
+
+}  // extern "C"
+
+#endif  // defined(__GLIBC__)
+
+namespace crypto {
+namespace tink {
+namespace {
+
+using crypto::tink::test::DummyAead;
+using crypto::tink::test::DummyMac;
+using crypto::tink::test::DummyPublicKeySign;
+
+const int kIterations = 100;
+
+TEST(OutputBufferTest, testFixedOutputBuffer) {
+  char data[8];
+  FixedOutputBuffer buffer(data, sizeof(data));
+  EXPECT_EQ("", buffer.output());
+  char* output = buffer.Resize(3);
+  ASSERT_EQ(data, output);
+  memcpy(output, "abc", 3);
+  EXPECT_EQ("abc", buffer.output());
+  EXPECT_EQ(data, buffer.Resize(8));
+  EXPECT_EQ(nullptr, buffer.Resize(9));
+  EXPECT_EQ(8, buffer.output().size());
+  EXPECT_EQ(data, buffer.Resize(2));
+  EXPECT_EQ("ab", buffer.output());
+}
+
+TEST(OutputBufferTest, testStringOutputBuffer) {
+  std::string output = "previous";
+  StringOutputBuffer buffer(&output);
+  memcpy(buffer.Resize(3), "abc", 3);
+  EXPECT_EQ("abc", output);
+  buffer.Resize(4)[3] = 'd';
+  EXPECT_EQ("abcd", output);
+}
+
+TEST(OutputBufferTest, testPrefixedOutputBuffer) {
+  std::string output;
+  StringOutputBuffer string_buffer(&output);
+  PrefixedOutputBuffer buffer("prefix:", &string_buffer);
+  memcpy(buffer.Resize(3), "abc", 3);
+  EXPECT_EQ("prefix:abc", output);
+  buffer.Resize(0);
+  EXPECT_EQ("prefix:", output);
+
+  char data[8];
+  FixedOutputBuffer fixed_buffer(data, sizeof(data));
+  PrefixedOutputBuffer small_buffer("prefix:", &fixed_buffer);
+  EXPECT_NE(nullptr, small_buffer.Resize(1));
+  EXPECT_EQ(nullptr, small_buffer.Resize(2));
+  EXPECT_EQ(nullptr, small_buffer.Resize(static_cast<size_t>(-1)));
+}
+
+TEST(OutputBufferTest, testWriteToOutputBuffer) {
+  char data[4];
+  FixedOutputBuffer buffer(data, sizeof(data));
+  EXPECT_TRUE(WriteToOutputBuffer("abcd", &buffer).ok());
+  EXPECT_EQ("abcd", buffer.output());
+  EXPECT_TRUE(WriteToOutputBuffer("", &buffer).ok());
+  EXPECT_EQ("", buffer.output());
+  util::Status status = WriteToOutputBuffer("abcde", &buffer);
+  EXPECT_EQ(util::error::RESOURCE_EXHAUSTED, status.error_code()) << status;
+}
+
+TEST(OutputBufferTest, testDefaultImplementations) {
+  std::string output;
+  StringOutputBuffer buffer(&output);
+
+  DummyAead aead("aead");
+  EXPECT_TRUE(aead.EncryptInto("plaintext", "ad", &buffer).ok());
+  EXPECT_EQ(aead.Encrypt("plaintext", "ad").ValueOrDie(), output);
+  std::string ciphertext = output;
+  EXPECT_TRUE(aead.DecryptInto(ciphertext, "ad", &buffer).ok());
+  EXPECT_EQ("plaintext", output);
+  EXPECT_FALSE(aead.DecryptInto("wrong", "ad", &buffer).ok());
+
+  DummyMac mac("mac");
+  EXPECT_TRUE(mac.ComputeMacInto("data", &buffer).ok());
+  EXPECT_EQ(mac.ComputeMac("data").ValueOrDie(), output);
+
+  DummyPublicKeySign sign("sign");
+  EXPECT_TRUE(sign.SignInto("data", &buffer).ok());
+  EXPECT_EQ(sign.Sign("data").ValueOrDie(), output);
+
+  char data[4];
+  FixedOutputBuffer small_buffer(data, sizeof(data));
+  EXPECT_EQ(util::error::RESOURCE_EXHAUSTED,
+            aead.EncryptInto("plaintext", "ad", &small_buffer).error_code());
+}
+
+class OutputBufferAllocationTest : public ::testing::Test {
+ protected:
+  static void SetUpTestCase() {
+    ASSERT_TRUE(AeadConfig::Register().ok());
+    ASSERT_TRUE(MacConfig::Register().ok());
+    ASSERT_TRUE(SignatureConfig::Register().ok());
+  }
+
+  template <typename Primitive, typename Factory>
+  std::unique_ptr<Primitive> NewPrimitive(
+      const google::crypto::tink::KeyTemplate& key_template) {
+    auto handle_result = KeysetHandle::GenerateNew(key_template);
+    EXPECT_TRUE(handle_result.ok()) << handle_result.status();
+    auto primitive_result =
+        Factory::GetPrimitive(*handle_result.ValueOrDie());
+    EXPECT_TRUE(primitive_result.ok()) << primitive_result.status();
+    return std::move(primitive_result.ValueOrDie());
+  }
+
+  char ciphertext_[256];
+  char plaintext_[256];
+};
+
+TEST_F(OutputBufferAllocationTest, testAesGcm) {
+  auto aead = NewPrimitive<Aead, AeadFactory>(AeadKeyTemplates::Aes128Gcm());
+  std::string plaintext(100, 'p');
+  FixedOutputBuffer ciphertext_buffer(ciphertext_, sizeof(ciphertext_));
+  FixedOutputBuffer plaintext_buffer(plaintext_, sizeof(plaintext_));
+  // Warms up the per-thread state of BoringSSL's random number generator.
+  ASSERT_TRUE(aead->EncryptInto(plaintext, "ad", &ciphertext_buffer).ok());
+  int news = new_count;
+  int mallocs = malloc_count;
+  for (int i = 0; i < kIterations; i++) {
+    ASSERT_TRUE(aead->EncryptInto(plaintext, "ad", &ciphertext_buffer).ok());
+    ASSERT_TRUE(aead->DecryptInto(ciphertext_buffer.output(), "ad",
+                                  &plaintext_buffer).ok());
+  }
+  EXPECT_EQ(news, new_count);
+  EXPECT_EQ(mallocs, malloc_count);
+  EXPECT_EQ(plaintext, plaintext_buffer.output());
+  EXPECT_EQ(plaintext,
+            aead->Decrypt(ciphertext_buffer.output(), "ad").ValueOrDie());
+  // The string-returning methods do allocate.
+  EXPECT_LT(news, new_count);
+
+  // A failed decryption leaves no unverified plaintext in the buffer.
+  ciphertext_[ciphertext_buffer.output().size() - 1] ^= 0x01;
+  EXPECT_FALSE(aead->DecryptInto(ciphertext_buffer.output(), "ad",
+                                 &plaintext_buffer).ok());
+  EXPECT_EQ("", plaintext_buffer.output());
+
+  FixedOutputBuffer small_buffer(ciphertext_, plaintext.size());
+  EXPECT_EQ(util::error::RESOURCE_EXHAUSTED,
+            aead->EncryptInto(plaintext, "ad", &small_buffer).error_code());
+}
+
+TEST_F(OutputBufferAllocationTest, testHmac) {
+  auto mac = NewPrimitive<Mac, MacFactory>(MacKeyTemplates::HmacSha256());
+  FixedOutputBuffer mac_buffer(ciphertext_, sizeof(ciphertext_));
+  int news = new_count;
+  for (int i = 0; i < kIterations; i++) {
+    ASSERT_TRUE(mac->ComputeMacInto("data", &mac_buffer).ok());
+  }
+  // BoringSSL's HMAC() allocates its digest contexts with malloc, so only
+  // the allocations of Tink itself are checked.
+  EXPECT_EQ(news, new_count);
+  EXPECT_TRUE(mac->VerifyMac(mac_buffer.output(), "data").ok());
+}
+
+TEST_F(OutputBufferAllocationTest, testEd25519) {
+  auto signer = NewPrimitive<PublicKeySign, PublicKeySignFactory>(
+      SignatureKeyTemplates::Ed25519());
+  FixedOutputBuffer signature_buffer(ciphertext_, sizeof(ciphertext_));
+  int news = new_count;
+  int mallocs = malloc_count;
+  for (int i = 0; i < kIterations; i++) {
+    ASSERT_TRUE(signer->SignInto("data", &signature_buffer).ok());
+  }
+  EXPECT_EQ(news, new_count);
+  EXPECT_EQ(mallocs, malloc_count);
+  EXPECT_EQ(signer->Sign("data").ValueOrDie(), signature_buffer.output());
+}
+
+}  // namespace
+}  // namespace tink
+}  // namespace crypto
+
+int main(int ac, char* av[]) {
+  testing::InitGoogleTest(&ac, av);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,77 @@
+// Copyright 2018 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/public_key_sign.h"
+
+#include <string>
+
+#include "absl/strings/string_view.h"
+#include "tink/output_buffer.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+
+namespace {
+
+// Collects all chunks and signs them at once with PublicKeySign::Sign().
+class BufferingPublicKeySigner : public PublicKeySigner {
+ public:
+  explicit BufferingPublicKeySigner(const PublicKeySign* public_key_sign)
+      : public_key_sign_(public_key_sign), finalized_(false) {}
+
+  util::Status Update(absl::string_view data) override {
+    if (finalized_) {
+      return util::Status(util::error::FAILED_PRECONDITION,
+                          "Signer already finalized.");
+    }
+    data_.append(data.data(), data.size());
+    return util::Status::OK;
+  }
+
+  util::StatusOr<std::string> Finalize() override {
+    if (finalized_) {
+      return util::Status(util::error::FAILED_PRECONDITION,
+                          "Signer already finalized.");
+    }
+    finalized_ = true;
+    return public_key_sign_->Sign(data_);
+  }
+
+ private:
+  const PublicKeySign* public_key_sign_;
+  std::string data_;
+  bool finalized_;
+};
+
+}  // namespace
+
+util::Status PublicKeySign::SignInto(absl::string_view data,
+                                     OutputBuffer* signature) const {
+  auto sign_result = Sign(data);
+  if (!sign_result.ok()) return sign_result.status();
+  return WriteToOutputBuffer(sign_result.ValueOrDie(), signature);
+}
+
+util::StatusOr<std::unique_ptr<PublicKeySigner>> PublicKeySign::NewSigner()
+    const {
+  std::unique_ptr<PublicKeySigner> signer(new BufferingPublicKeySigner(this));
+  return std::move(signer);
+}
+
+}  // namespace tink
+}  // namespace crypto
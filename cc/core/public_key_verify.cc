@@ -0,0 +1,75 @@
+// Copyright 2018 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/public_key_verify.h"
+
+#include <string>
+
+#include "absl/strings/string_view.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+
+namespace {
+
+// Collects all chunks and verifies them at once with
+// PublicKeyVerify::Verify().
+class BufferingPublicKeyVerifier : public PublicKeyVerifier {
+ public:
+  BufferingPublicKeyVerifier(const PublicKeyVerify* public_key_verify,
+                             absl::string_view signature)
+      : public_key_verify_(public_key_verify),
+        signature_(signature),
+        finalized_(false) {}
+
+  util::Status Update(absl::string_view data) override {
+    if (finalized_) {
+      return util::Status(util::error::FAILED_PRECONDITION,
+                          "Verifier already finalized.");
+    }
+    data_.append(data.data(), data.size());
+    return util::Status::OK;
+  }
+
+  util::Status Finalize() override {
+    if (finalized_) {
+      return util::Status(util::error::FAILED_PRECONDITION,
+                          "Verifier already finalized.");
+    }
+    finalized_ = true;
+    return public_key_verify_->Verify(signature_, data_);
+  }
+
+ private:
+  const PublicKeyVerify* public_key_verify_;
+  const std::string signature_;
+  std::string data_;
+  bool finalized_;
+};
+
+}  // namespace
+
+util::StatusOr<std::unique_ptr<PublicKeyVerifier>>
+PublicKeyVerify::NewVerifier(absl::string_view signature) const {
+  std::unique_ptr<PublicKeyVerifier> verifier(
+      new BufferingPublicKeyVerifier(this, signature));
+  return std::move(verifier);
+}
+
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,198 @@
+// Copyright 2018 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/daead/aes_siv_key_manager.h"
+
+#include "absl/strings/string_view.h"
+#include "tink/deterministic_aead.h"
+#include "tink/key_manager.h"
+#include "tink/subtle/aes_siv_boringssl.h"
+#include "tink/subtle/random.h"
+#include "tink/util/errors.h"
+#include "tink/util/protobuf_helper.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "tink/util/validation.h"
+#include "proto/aes_siv.pb.h"
+#include "proto/tink.pb.h"
+
+namespace crypto {
+namespace tink {
+
+using google::crypto::tink::AesSivKey;
+using google::crypto::tink::AesSivKeyFormat;
+using google::crypto::tink::KeyData;
+using google::crypto::tink::KeyTemplate;
+using portable_proto::MessageLite;
+using crypto::tink::util::Status;
+using crypto::tink::util::StatusOr;
+
+class AesSivKeyFactory : public KeyFactory {
+ public:
+  AesSivKeyFactory() {}
+
+  // Generates a new random AesSivKey, based on the specified 'key_format',
+  // which must contain AesSivKeyFormat-proto.
+  crypto::tink::util::StatusOr<std::unique_ptr<portable_proto::MessageLite>>
+  NewKey(const portable_proto::MessageLite& key_format) const override;
+
+  // Generates a new random AesSivKey, based on the specified
+  // 'serialized_key_format', which must contain AesSivKeyFormat-proto.
+  crypto::tink::util::StatusOr<std::unique_ptr<portable_proto::MessageLite>>
+  NewKey(absl::string_view serialized_key_format) const override;
+
+  // Generates a new random AesSivKey, based on the specified
+  // 'serialized_key_format' (which must contain AesSivKeyFormat-proto),
+  // and wraps it in a KeyData-proto.
+  crypto::tink::util::StatusOr<std::unique_ptr<google::crypto::tink::KeyData>>
+  NewKeyData(absl::string_view serialized_key_format) const override;
+};
+
+StatusOr<std::unique_ptr<MessageLite>> AesSivKeyFactory::NewKey(
+    const portable_proto::MessageLite& key_format) const {
+  std::string key_format_url =
+      std::string(AesSivKeyManager::kKeyTypePrefix) + key_format.GetTypeName();
+  if (key_format_url != AesSivKeyManager::kKeyFormatUrl) {
+    return ToStatusF(util::error::INVALID_ARGUMENT,
+                     "Key format proto '%s' is not supported by this manager.",
+                     key_format_url.c_str());
+  }
+  const AesSivKeyFormat& aes_siv_key_format =
+        reinterpret_cast<const AesSivKeyFormat&>(key_format);
+  Status status = AesSivKeyManager::Validate(aes_siv_key_format);
+  if (!status.ok()) return status;
+
+  // Generate AesSivKey.
+  std::unique_ptr<AesSivKey> aes_siv_key(new AesSivKey());
+  aes_siv_key->set_version(AesSivKeyManager::kVersion);
+  aes_siv_key->set_key_value(
+      subtle::Random::GetRandomBytes(aes_siv_key_format.key_size()));
+  std::unique_ptr<MessageLite> key = std::move(aes_siv_key);
+  return std::move(key);
+}
+
+StatusOr<std::unique_ptr<MessageLite>> AesSivKeyFactory::NewKey(
+    absl::string_view serialized_key_format) const {
+  AesSivKeyFormat key_format;
+  if (!key_format.ParseFromString(std::string(serialized_key_format))) {
+    return ToStatusF(util::error::INVALID_ARGUMENT,
+                     "Could not parse the passed string as proto '%s'.",
+                     AesSivKeyManager::kKeyFormatUrl);
+  }
+  return NewKey(key_format);
+}
+
+StatusOr<std::unique_ptr<KeyData>> AesSivKeyFactory::NewKeyData(
+    absl::string_view serialized_key_format) const {
+  auto new_key_result = NewKey(serialized_key_format);
+  if (!new_key_result.ok()) return new_key_result.status();
+  auto new_key = reinterpret_cast<const AesSivKey&>(
+      *(new_key_result.ValueOrDie()));
+  std::unique_ptr<KeyData> key_data(new KeyData());
+  key_data->set_type_url(AesSivKeyManager::kKeyType);
+  key_data->set_value(new_key.SerializeAsString());
+  key_data->set_key_material_type(KeyData::SYMMETRIC);
+  return std::move(key_data);
+}
+
+constexpr char AesSivKeyManager::kKeyFormatUrl[];
+constexpr char AesSivKeyManager::kKeyTypePrefix[];
+constexpr char AesSivKeyManager::kKeyType[];
+constexpr uint32_t AesSivKeyManager::kVersion;
+
+// RFC 5297 also allows 256 and 384 bit keys, but Tink only uses AES-256-SIV.
+const int kKeySizeInBytes = 64;
+
+AesSivKeyManager::AesSivKeyManager()
+    : key_type_(kKeyType), key_factory_(new AesSivKeyFactory()) {}
+
+const std::string& AesSivKeyManager::get_key_type() const {
+  return key_type_;
+}
+
+uint32_t AesSivKeyManager::get_version() const {
+  return kVersion;
+}
+
+const KeyFactory& AesSivKeyManager::get_key_factory() const {
+  return *key_factory_;
+}
+
+StatusOr<std::unique_ptr<DeterministicAead>>
+AesSivKeyManager::GetPrimitive(const KeyData& key_data) const {
+  if (DoesSupport(key_data.type_url())) {
+    AesSivKey aes_siv_key;
+    if (!aes_siv_key.ParseFromString(key_data.value())) {
+      return ToStatusF(util::error::INVALID_ARGUMENT,
+                       "Could not parse key_data.value as key type '%s'.",
+                       key_data.type_url().c_str());
+    }
+    return GetPrimitiveImpl(aes_siv_key);
+  } else {
+    return ToStatusF(util::error::INVALID_ARGUMENT,
+                     "Key type '%s' is not supported by this manager.",
+                     key_data.type_url().c_str());
+  }
+}
+
+StatusOr<std::unique_ptr<DeterministicAead>>
+AesSivKeyManager::GetPrimitive(const MessageLite& key) const {
+  std::string key_type = std::string(kKeyTypePrefix) + key.GetTypeName();
+  if (DoesSupport(key_type)) {
+    const AesSivKey& aes_siv_key = reinterpret_cast<const AesSivKey&>(key);
+    return GetPrimitiveImpl(aes_siv_key);
+  } else {
+    return ToStatusF(util::error::INVALID_ARGUMENT,
+                     "Key type '%s' is not supported by this manager.",
+                     key_type.c_str());
+  }
+}
+
+StatusOr<std::unique_ptr<DeterministicAead>>
+AesSivKeyManager::GetPrimitiveImpl(const AesSivKey& aes_siv_key) const {
+  Status status = Validate(aes_siv_key);
+  if (!status.ok()) return status;
+  auto aes_siv_result = subtle::AesSivBoringSsl::New(aes_siv_key.key_value());
+  if (!aes_siv_result.ok()) return aes_siv_result.status();
+  return std::move(aes_siv_result.ValueOrDie());
+}
+
+// static
+Status AesSivKeyManager::Validate(const AesSivKey& key) {
+  Status status = ValidateVersion(key.version(), kVersion);
+  if (!status.ok()) return status;
+  uint32_t key_size = key.key_value().size();
+  if (key_size != kKeySizeInBytes) {
+      return ToStatusF(util::error::INVALID_ARGUMENT,
+                       "Invalid AesSivKey: key_value has %d bytes; "
+                       "supported size: %d bytes.", key_size, kKeySizeInBytes);
+  }
+  return Status::OK;
+}
+
+// static
+Status AesSivKeyManager::Validate(const AesSivKeyFormat& key_format) {
+  if (key_format.key_size() != kKeySizeInBytes) {
+      return ToStatusF(util::error::INVALID_ARGUMENT,
+                       "Invalid AesSivKeyFormat: key_size is %d; "
+                       "supported size: %d bytes.",
+                       key_format.key_size(), kKeySizeInBytes);
+  }
+  return Status::OK;
+}
+
+}  // namespace tink
+}  // namespace crypto
@@ -17,6 +17,7 @@
 #include "tink/hybrid/ecies_aead_hkdf_hybrid_decrypt.h"
 
 #include "tink/hybrid_decrypt.h"
+#include "tink/output_buffer.h"
 #include "tink/hybrid/ecies_aead_hkdf_dem_helper.h"
 #include "tink/subtle/ec_util.h"
 #include "tink/subtle/ecies_hkdf_recipient_kem_boringssl.h"
@@ -56,6 +57,17 @@ EciesAeadHkdfHybridDecrypt::New(const EciesAeadHkdfPrivateKey& recipient_key) {
 util::StatusOr<std::string> EciesAeadHkdfHybridDecrypt::Decrypt(
     absl::string_view ciphertext,
     absl::string_view context_info) const {
+  std::string plaintext;
+  StringOutputBuffer output(&plaintext);
+  util::Status status = DecryptInto(ciphertext, context_info, &output);
+  if (!status.ok()) return status;
+  return std::move(plaintext);
+}
+
+util::Status EciesAeadHkdfHybridDecrypt::DecryptInto(
+    absl::string_view ciphertext,
+    absl::string_view context_info,
+    OutputBuffer* plaintext) const {
   // Extract KEM-bytes from the ciphertext.
   auto header_size_result = subtle::EcUtil::EncodingSizeInBytes(
       util::Enums::ProtoToSubtle(
@@ -89,11 +101,8 @@ util::StatusOr<std::string> EciesAeadHkdfHybridDecrypt::Decrypt(
   auto aead = std::move(aead_result.ValueOrDie());
 
   // Do the actual decryption using the AEAD-primitive.
-  auto decrypt_result =
-      aead->Decrypt(ciphertext.substr(header_size), "");  // empty aad
-  if (!decrypt_result.ok()) return decrypt_result.status();
-
-  return decrypt_result.ValueOrDie();
+  return aead->DecryptInto(ciphertext.substr(header_size), "",  // empty aad
+                           plaintext);
 }
 
 // static
@@ -19,6 +19,7 @@
 
 #include "absl/strings/string_view.h"
 #include "tink/hybrid_decrypt.h"
+#include "tink/output_buffer.h"
 #include "tink/hybrid/ecies_aead_hkdf_dem_helper.h"
 #include "tink/subtle/ecies_hkdf_recipient_kem_boringssl.h"
 #include "tink/util/statusor.h"
@@ -41,6 +42,12 @@ class EciesAeadHkdfHybridDecrypt : public HybridDecrypt {
       absl::string_view ciphertext,
       absl::string_view context_info) const override;
 
+  // Writes the plaintext directly into 'plaintext'.
+  crypto::tink::util::Status DecryptInto(
+      absl::string_view ciphertext,
+      absl::string_view context_info,
+      OutputBuffer* plaintext) const override;
+
   virtual ~EciesAeadHkdfHybridDecrypt() {}
 
  private:
@@ -19,8 +19,10 @@
 #include "tink/aead.h"
 #include "tink/hybrid_encrypt.h"
 #include "tink/key_manager.h"
+#include "tink/output_buffer.h"
 #include "tink/registry.h"
 #include "tink/hybrid/ecies_aead_hkdf_dem_helper.h"
+#include "tink/subtle/ec_ephemeral_key_pool.h"
 #include "tink/subtle/ecies_hkdf_sender_kem_boringssl.h"
 #include "tink/util/enums.h"
 #include "tink/util/statusor.h"
@@ -39,13 +41,21 @@ namespace tink {
 // static
 StatusOr<std::unique_ptr<HybridEncrypt>>
 EciesAeadHkdfHybridEncrypt::New(const EciesAeadHkdfPublicKey& recipient_key) {
+  return New(recipient_key, nullptr);
+}
+
+// static
+StatusOr<std::unique_ptr<HybridEncrypt>>
+EciesAeadHkdfHybridEncrypt::New(
+    const EciesAeadHkdfPublicKey& recipient_key,
+    std::shared_ptr<subtle::EcEphemeralKeyPool> ephemeral_key_pool) {
   Status status = Validate(recipient_key);
   if (!status.ok()) return status;
 
   auto kem_result = subtle::EciesHkdfSenderKemBoringSsl::New(
       util::Enums::ProtoToSubtle(
           recipient_key.params().kem_params().curve_type()),
-      recipient_key.x(), recipient_key.y());
+      recipient_key.x(), recipient_key.y(), std::move(ephemeral_key_pool));
   if (!kem_result.ok()) return kem_result.status();
 
   auto dem_result = EciesAeadHkdfDemHelper::New(
@@ -61,6 +71,17 @@ EciesAeadHkdfHybridEncrypt::New(const EciesAeadHkdfPublicKey& recipient_key) {
 StatusOr<std::string> EciesAeadHkdfHybridEncrypt::Encrypt(
     absl::string_view plaintext,
     absl::string_view context_info) const {
+  std::string ciphertext;
+  StringOutputBuffer output(&ciphertext);
+  Status status = EncryptInto(plaintext, context_info, &output);
+  if (!status.ok()) return status;
+  return std::move(ciphertext);
+}
+
+Status EciesAeadHkdfHybridEncrypt::EncryptInto(
+    absl::string_view plaintext,
+    absl::string_view context_info,
+    OutputBuffer* ciphertext) const {
   // Use KEM to get a symmetric key.
   auto kem_key_result = sender_kem_->GenerateKey(
       util::Enums::ProtoToSubtle(
@@ -78,14 +99,12 @@ StatusOr<std::string> EciesAeadHkdfHybridEncrypt::Encrypt(
   if (!aead_result.ok()) return aead_result.status();
   auto aead = std::move(aead_result.ValueOrDie());
 
-  // Do the actual encryption using the AEAD-primitive.
-  auto encrypt_result = aead->Encrypt(plaintext, "");  // empty aad
-  if (!encrypt_result.ok()) return encrypt_result.status();
-
-  // Prepend AEAD-ciphertext with a KEM component.
-  std::string ciphertext = kem_key->get_kem_bytes();
-  ciphertext.append(encrypt_result.ValueOrDie());
-  return ciphertext;
+  // Do the actual encryption using the AEAD-primitive, writing the
+  // AEAD-ciphertext right after the KEM component. get_kem_bytes() returns
+  // a copy, which must outlive 'output'.
+  std::string kem_bytes = kem_key->get_kem_bytes();
+  PrefixedOutputBuffer output(kem_bytes, ciphertext);
+  return aead->EncryptInto(plaintext, "", &output);  // empty aad
 }
 
 // static
@@ -17,11 +17,15 @@
 #ifndef TINK_HYBRID_ECIES_AEAD_HKDF_HYBRID_ENCRYPT_H_
 #define TINK_HYBRID_ECIES_AEAD_HKDF_HYBRID_ENCRYPT_H_
 
+#include <memory>
+
 #include "absl/strings/string_view.h"
 #include "tink/aead.h"
 #include "tink/hybrid_encrypt.h"
 #include "tink/key_manager.h"
+#include "tink/output_buffer.h"
 #include "tink/hybrid/ecies_aead_hkdf_dem_helper.h"
+#include "tink/subtle/ec_ephemeral_key_pool.h"
 #include "tink/subtle/ecies_hkdf_sender_kem_boringssl.h"
 #include "tink/util/statusor.h"
 #include "proto/ecies_aead_hkdf.pb.h"
@@ -39,10 +43,23 @@ class EciesAeadHkdfHybridEncrypt : public HybridEncrypt {
   static crypto::tink::util::StatusOr<std::unique_ptr<HybridEncrypt>> New(
       const google::crypto::tink::EciesAeadHkdfPublicKey& recipient_key);
 
+  // Like New(), but Encrypt() takes the ephemeral key pair of the KEM from
+  // 'ephemeral_key_pool' when the pool has one, and generates it inline
+  // otherwise. The pool must be for the curve of 'recipient_key'.
+  static crypto::tink::util::StatusOr<std::unique_ptr<HybridEncrypt>> New(
+      const google::crypto::tink::EciesAeadHkdfPublicKey& recipient_key,
+      std::shared_ptr<subtle::EcEphemeralKeyPool> ephemeral_key_pool);
+
   crypto::tink::util::StatusOr<std::string> Encrypt(
       absl::string_view plaintext,
       absl::string_view context_info) const override;
 
+  // Writes the KEM bytes and the DEM ciphertext directly into 'ciphertext'.
+  crypto::tink::util::Status EncryptInto(
+      absl::string_view plaintext,
+      absl::string_view context_info,
+      OutputBuffer* ciphertext) const override;
+
   virtual ~EciesAeadHkdfHybridEncrypt() {}
 
  private:
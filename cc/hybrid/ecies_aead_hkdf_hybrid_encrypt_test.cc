@@ -20,6 +20,8 @@
 #include "tink/hybrid_encrypt.h"
 #include "tink/registry.h"
 #include "tink/aead/aes_gcm_key_manager.h"
+#include "tink/hybrid/ecies_aead_hkdf_hybrid_decrypt.h"
+#include "tink/subtle/ec_ephemeral_key_pool.h"
 #include "tink/subtle/subtle_util_boringssl.h"
 #include "tink/util/enums.h"
 #include "tink/util/statusor.h"
@@ -149,6 +151,47 @@ TEST_F(EciesAeadHkdfHybridEncryptTest, testBasic) {
   }
 }
 
+TEST_F(EciesAeadHkdfHybridEncryptTest, testEphemeralKeyPool) {
+  ASSERT_TRUE(Registry::RegisterKeyManager(new AesGcmKeyManager()).ok());
+  auto ecies_key = test::GetEciesAesGcmHkdfTestKey(
+      EllipticCurveType::NIST_P256, EcPointFormat::UNCOMPRESSED,
+      HashType::SHA256, 16);
+  std::shared_ptr<subtle::EcEphemeralKeyPool> pool(std::move(
+      subtle::EcEphemeralKeyPool::NewWithoutRefill(
+          subtle::EllipticCurveType::NIST_P256, 2).ValueOrDie()));
+  ASSERT_TRUE(pool->Fill().ok());
+  auto result = EciesAeadHkdfHybridEncrypt::New(ecies_key.public_key(), pool);
+  ASSERT_TRUE(result.ok()) << result.status();
+  auto hybrid_encrypt = std::move(result.ValueOrDie());
+  auto hybrid_decrypt = std::move(
+      EciesAeadHkdfHybridDecrypt::New(ecies_key).ValueOrDie());
+
+  std::string plaintext = "some plaintext";
+  std::string context_info = "some context info";
+  // The first two ciphertexts use key pairs from the pool, the last one
+  // finds the pool empty and generates its key pair inline.
+  for (int i = 0; i < 3; i++) {
+    auto encrypt_result = hybrid_encrypt->Encrypt(plaintext, context_info);
+    ASSERT_TRUE(encrypt_result.ok()) << encrypt_result.status();
+    EXPECT_EQ(i < 2 ? 1u - i : 0u, pool->size());
+    EXPECT_EQ(i < 2 ? 0u : 1u, pool->misses());
+    auto decrypt_result =
+        hybrid_decrypt->Decrypt(encrypt_result.ValueOrDie(), context_info);
+    ASSERT_TRUE(decrypt_result.ok()) << decrypt_result.status();
+    EXPECT_EQ(plaintext, decrypt_result.ValueOrDie());
+  }
+
+  // A pool for another curve is rejected.
+  std::shared_ptr<subtle::EcEphemeralKeyPool> other_pool(std::move(
+      subtle::EcEphemeralKeyPool::NewWithoutRefill(
+          subtle::EllipticCurveType::NIST_P384, 1).ValueOrDie()));
+  auto other_result =
+      EciesAeadHkdfHybridEncrypt::New(ecies_key.public_key(), other_pool);
+  EXPECT_FALSE(other_result.ok());
+  EXPECT_EQ(util::error::INVALID_ARGUMENT,
+            other_result.status().error_code());
+}
+
 }  // namespace
 }  // namespace tink
 }  // namespace crypto
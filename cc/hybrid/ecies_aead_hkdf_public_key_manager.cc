@@ -20,6 +20,8 @@
 #include "tink/hybrid_encrypt.h"
 #include "tink/key_manager.h"
 #include "tink/hybrid/ecies_aead_hkdf_hybrid_encrypt.h"
+#include "tink/subtle/ec_ephemeral_key_pool.h"
+#include "tink/util/enums.h"
 #include "tink/util/errors.h"
 #include "tink/util/protobuf_helper.h"
 #include "tink/util/status.h"
@@ -87,7 +89,12 @@ constexpr char EciesAeadHkdfPublicKeyManager::kKeyType[];
 constexpr uint32_t EciesAeadHkdfPublicKeyManager::kVersion;
 
 EciesAeadHkdfPublicKeyManager::EciesAeadHkdfPublicKeyManager()
-    : key_type_(kKeyType), key_factory_(new EciesAeadHkdfPublicKeyFactory()) {
+    : EciesAeadHkdfPublicKeyManager(nullptr) {}
+
+EciesAeadHkdfPublicKeyManager::EciesAeadHkdfPublicKeyManager(
+    std::shared_ptr<subtle::EcEphemeralKeyPool> ephemeral_key_pool)
+    : key_type_(kKeyType), key_factory_(new EciesAeadHkdfPublicKeyFactory()),
+      ephemeral_key_pool_(std::move(ephemeral_key_pool)) {
 }
 
 const KeyFactory& EciesAeadHkdfPublicKeyManager::get_key_factory() const {
@@ -138,7 +145,14 @@ EciesAeadHkdfPublicKeyManager::GetPrimitiveImpl(
     const EciesAeadHkdfPublicKey& recipient_key) const {
   Status status = Validate(recipient_key);
   if (!status.ok()) return status;
-  auto ecies_result = EciesAeadHkdfHybridEncrypt::New(recipient_key);
+  std::shared_ptr<subtle::EcEphemeralKeyPool> ephemeral_key_pool;
+  if (ephemeral_key_pool_ != nullptr &&
+      ephemeral_key_pool_->curve() == util::Enums::ProtoToSubtle(
+          recipient_key.params().kem_params().curve_type())) {
+    ephemeral_key_pool = ephemeral_key_pool_;
+  }
+  auto ecies_result =
+      EciesAeadHkdfHybridEncrypt::New(recipient_key, ephemeral_key_pool);
   if (!ecies_result.ok()) return ecies_result.status();
   return std::move(ecies_result.ValueOrDie());
 }
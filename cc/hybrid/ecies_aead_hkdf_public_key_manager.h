@@ -15,6 +15,7 @@
 ///////////////////////////////////////////////////////////////////////////////
 
 #include <algorithm>
+#include <memory>
 #include <vector>
 
 #ifndef TINK_HYBRID_ECIES_AEAD_HKDF_PUBLIC_KEY_MANAGER_H_
@@ -23,6 +24,7 @@
 #include "absl/strings/string_view.h"
 #include "tink/hybrid_encrypt.h"
 #include "tink/key_manager.h"
+#include "tink/subtle/ec_ephemeral_key_pool.h"
 #include "tink/util/errors.h"
 #include "tink/util/protobuf_helper.h"
 #include "tink/util/status.h"
@@ -41,6 +43,14 @@ class EciesAeadHkdfPublicKeyManager : public KeyManager<HybridEncrypt> {
 
   EciesAeadHkdfPublicKeyManager();
 
+  // Constructs a manager whose primitives take the ephemeral key pairs of
+  // the KEM from 'ephemeral_key_pool' for keys on the curve of the pool.
+  // Primitives for keys on other curves generate them inline.
+  // The manager can be used via
+  //   HybridEncryptFactory::GetPrimitive(keyset_handle, &key_manager);
+  explicit EciesAeadHkdfPublicKeyManager(
+      std::shared_ptr<subtle::EcEphemeralKeyPool> ephemeral_key_pool);
+
   // Constructs an instance of ECIES-AEAD-HKDF HybridEncrypt
   // for the given 'key_data', which must contain EciesAeadHkdfPublicKey-proto.
   crypto::tink::util::StatusOr<std::unique_ptr<HybridEncrypt>> GetPrimitive(
@@ -72,6 +82,7 @@ class EciesAeadHkdfPublicKeyManager : public KeyManager<HybridEncrypt> {
 
   std::string key_type_;
   std::unique_ptr<KeyFactory> key_factory_;
+  std::shared_ptr<subtle::EcEphemeralKeyPool> ephemeral_key_pool_;
 
   // Constructs an instance of HybridEncrypt for the given 'key'.
   crypto::tink::util::StatusOr<std::unique_ptr<HybridEncrypt>> GetPrimitiveImpl(
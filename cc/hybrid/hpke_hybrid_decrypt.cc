@@ -0,0 +1,65 @@
+// Copyright 2018 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/hybrid/hpke_hybrid_decrypt.h"
+
+#include "tink/hybrid_decrypt.h"
+#include "tink/subtle/hpke_context_boringssl.h"
+#include "tink/util/enums.h"
+#include "tink/util/statusor.h"
+#include "proto/hpke.pb.h"
+
+using google::crypto::tink::HpkePrivateKey;
+using crypto::tink::util::Status;
+using crypto::tink::util::StatusOr;
+
+namespace crypto {
+namespace tink {
+
+// static
+StatusOr<std::unique_ptr<HybridDecrypt>> HpkeHybridDecrypt::New(
+    const HpkePrivateKey& recipient_key) {
+  if (recipient_key.private_key().size() !=
+          subtle::HpkeContextBoringSsl::kX25519KeySize ||
+      !recipient_key.has_public_key() ||
+      !recipient_key.public_key().has_params()) {
+    return Status(util::error::INVALID_ARGUMENT,
+                  "Invalid HpkePrivateKey: missing required fields.");
+  }
+  std::unique_ptr<HybridDecrypt> hybrid_decrypt(
+      new HpkeHybridDecrypt(recipient_key));
+  return std::move(hybrid_decrypt);
+}
+
+StatusOr<std::string> HpkeHybridDecrypt::Decrypt(
+    absl::string_view ciphertext, absl::string_view context_info) const {
+  // Extract the encapsulated key from the ciphertext.
+  const size_t header_size = subtle::HpkeContextBoringSsl::kX25519KeySize;
+  if (ciphertext.size() < header_size) {
+    return Status(util::error::INVALID_ARGUMENT, "ciphertext too short");
+  }
+  auto context_result = subtle::HpkeContextBoringSsl::SetupRecipient(
+      util::Enums::ProtoToSubtle(recipient_key_.public_key().params().aead()),
+      recipient_key_.private_key(), ciphertext.substr(0, header_size),
+      context_info);
+  if (!context_result.ok()) return context_result.status();
+
+  return context_result.ValueOrDie()->Open(ciphertext.substr(header_size),
+                                           "");  // empty aad
+}
+
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,54 @@
+// Copyright 2018 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_HYBRID_HPKE_HYBRID_DECRYPT_H_
+#define TINK_HYBRID_HPKE_HYBRID_DECRYPT_H_
+
+#include "absl/strings/string_view.h"
+#include "tink/hybrid_decrypt.h"
+#include "tink/util/statusor.h"
+#include "proto/hpke.pb.h"
+
+namespace crypto {
+namespace tink {
+
+// HPKE decryption in base mode (https://tools.ietf.org/html/rfc9180) with
+// DHKEM(X25519, HKDF-SHA256) and HKDF-SHA256, matching HpkeHybridEncrypt.
+class HpkeHybridDecrypt : public HybridDecrypt {
+ public:
+  // Returns an HybridDecrypt-primitive that uses the key material
+  // given in 'recipient_key'.
+  static crypto::tink::util::StatusOr<std::unique_ptr<HybridDecrypt>> New(
+      const google::crypto::tink::HpkePrivateKey& recipient_key);
+
+  crypto::tink::util::StatusOr<std::string> Decrypt(
+      absl::string_view ciphertext,
+      absl::string_view context_info) const override;
+
+  virtual ~HpkeHybridDecrypt() {}
+
+ private:
+  explicit HpkeHybridDecrypt(
+      const google::crypto::tink::HpkePrivateKey& recipient_key)
+      : recipient_key_(recipient_key) {}
+
+  google::crypto::tink::HpkePrivateKey recipient_key_;
+};
+
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_HYBRID_HPKE_HYBRID_DECRYPT_H_
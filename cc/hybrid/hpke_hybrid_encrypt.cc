@@ -0,0 +1,64 @@
+// Copyright 2018 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/hybrid/hpke_hybrid_encrypt.h"
+
+#include "absl/strings/str_cat.h"
+#include "tink/hybrid_encrypt.h"
+#include "tink/subtle/hpke_context_boringssl.h"
+#include "tink/util/enums.h"
+#include "tink/util/statusor.h"
+#include "proto/hpke.pb.h"
+
+using google::crypto::tink::HpkePublicKey;
+using crypto::tink::util::Status;
+using crypto::tink::util::StatusOr;
+
+namespace crypto {
+namespace tink {
+
+// static
+StatusOr<std::unique_ptr<HybridEncrypt>> HpkeHybridEncrypt::New(
+    const HpkePublicKey& recipient_key) {
+  if (recipient_key.public_key().size() !=
+          subtle::HpkeContextBoringSsl::kX25519KeySize ||
+      !recipient_key.has_params()) {
+    return Status(util::error::INVALID_ARGUMENT,
+                  "Invalid HpkePublicKey: missing required fields.");
+  }
+  std::unique_ptr<HybridEncrypt> hybrid_encrypt(
+      new HpkeHybridEncrypt(recipient_key));
+  return std::move(hybrid_encrypt);
+}
+
+StatusOr<std::string> HpkeHybridEncrypt::Encrypt(
+    absl::string_view plaintext, absl::string_view context_info) const {
+  std::string encapsulated_key;
+  auto context_result = subtle::HpkeContextBoringSsl::SetupSender(
+      util::Enums::ProtoToSubtle(recipient_key_.params().aead()),
+      recipient_key_.public_key(), context_info, &encapsulated_key);
+  if (!context_result.ok()) return context_result.status();
+
+  auto seal_result =
+      context_result.ValueOrDie()->Seal(plaintext, "");  // empty aad
+  if (!seal_result.ok()) return seal_result.status();
+
+  // Prepend the AEAD ciphertext with the encapsulated key.
+  return absl::StrCat(encapsulated_key, seal_result.ValueOrDie());
+}
+
+}  // namespace tink
+}  // namespace crypto
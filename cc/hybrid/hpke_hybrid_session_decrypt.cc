@@ -0,0 +1,206 @@
+// Copyright 2018 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/hybrid/hpke_hybrid_session_decrypt.h"
+
+#include "tink/hybrid/hpke_hybrid_session_encrypt.h"
+#include "tink/subtle/hpke_context_boringssl.h"
+#include "tink/util/enums.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "proto/hpke.pb.h"
+
+using google::crypto::tink::HpkePrivateKey;
+using crypto::tink::util::Status;
+using crypto::tink::util::StatusOr;
+
+namespace crypto {
+namespace tink {
+
+namespace {
+
+const uint8_t kFirstMessage = HpkeHybridSessionEncrypt::kFirstMessage;
+const uint8_t kNextMessage = HpkeHybridSessionEncrypt::kNextMessage;
+const size_t kSessionIdSize = HpkeHybridSessionEncrypt::kSessionIdSize;
+const size_t kEncapsulatedKeySize =
+    subtle::HpkeContextBoringSsl::kX25519KeySize;
+const size_t kSequenceNumberSize = 8;
+
+}  // anonymous namespace
+
+constexpr uint64_t HpkeHybridSessionDecrypt::kReplayWindowSize;
+
+// static
+StatusOr<std::unique_ptr<HpkeHybridSessionDecrypt>>
+HpkeHybridSessionDecrypt::New(const HpkePrivateKey& recipient_key,
+                              absl::string_view context_info,
+                              int max_sessions) {
+  if (recipient_key.private_key().size() != kEncapsulatedKeySize ||
+      !recipient_key.has_public_key() ||
+      !recipient_key.public_key().has_params()) {
+    return Status(util::error::INVALID_ARGUMENT,
+                  "Invalid HpkePrivateKey: missing required fields.");
+  }
+  if (max_sessions <= 0) {
+    return Status(util::error::INVALID_ARGUMENT,
+                  "max_sessions must be positive");
+  }
+  return std::unique_ptr<HpkeHybridSessionDecrypt>(
+      new HpkeHybridSessionDecrypt(recipient_key, context_info,
+                                   max_sessions));
+}
+
+StatusOr<std::string> HpkeHybridSessionDecrypt::Decrypt(
+    absl::string_view message, absl::string_view associated_data) {
+  if (message.empty()) {
+    return Status(util::error::INVALID_ARGUMENT, "message too short");
+  }
+  uint8_t type = static_cast<uint8_t>(message[0]);
+  if (type == kFirstMessage) {
+    if (message.size() < 1 + kEncapsulatedKeySize) {
+      return Status(util::error::INVALID_ARGUMENT, "message too short");
+    }
+    absl::string_view encapsulated_key =
+        message.substr(1, kEncapsulatedKeySize);
+    absl::string_view ciphertext = message.substr(1 + kEncapsulatedKeySize);
+    std::string session_id(encapsulated_key.substr(0, kSessionIdSize));
+    // A first message of a cached session can only be a replay, unless it
+    // is forged.
+    auto context = Lookup(session_id, encapsulated_key);
+    if (context != nullptr) {
+      return Open(session_id, std::move(context), 0, ciphertext,
+                  associated_data);
+    }
+    auto context_result = subtle::HpkeContextBoringSsl::SetupRecipient(
+        util::Enums::ProtoToSubtle(
+            recipient_key_.public_key().params().aead()),
+        recipient_key_.private_key(), encapsulated_key, context_info_);
+    if (!context_result.ok()) return context_result.status();
+    context = std::move(context_result.ValueOrDie());
+    auto open_result =
+        context->OpenWithSequenceNumber(0, ciphertext, associated_data);
+    // Only sessions whose first message is authentic enter the cache.
+    if (open_result.ok()) {
+      Insert(session_id, {std::string(encapsulated_key), std::move(context),
+                          /* highest_sequence_number= */ 0,
+                          /* decrypted= */ 1});
+    }
+    return open_result;
+  }
+
+  if (type != kNextMessage ||
+      message.size() < 1 + kSessionIdSize + kSequenceNumberSize) {
+    return Status(util::error::INVALID_ARGUMENT, "invalid message header");
+  }
+  std::string session_id(message.substr(1, kSessionIdSize));
+  uint64_t sequence_number = 0;
+  for (size_t i = 0; i < kSequenceNumberSize; i++) {
+    sequence_number = (sequence_number << 8) |
+                      static_cast<uint8_t>(message[1 + kSessionIdSize + i]);
+  }
+  if (sequence_number == 0) {
+    return Status(util::error::INVALID_ARGUMENT, "invalid message header");
+  }
+  auto context = Lookup(session_id);
+  if (context == nullptr) {
+    return Status(util::error::NOT_FOUND,
+                  "unknown session; its first message must be decrypted "
+                  "first");
+  }
+  return Open(session_id, std::move(context), sequence_number,
+              message.substr(1 + kSessionIdSize + kSequenceNumberSize),
+              associated_data);
+}
+
+StatusOr<std::string> HpkeHybridSessionDecrypt::Open(
+    const std::string& session_id,
+    std::shared_ptr<const subtle::HpkeContextBoringSsl> context,
+    uint64_t sequence_number, absl::string_view ciphertext,
+    absl::string_view associated_data) {
+  auto open_result = context->OpenWithSequenceNumber(
+      sequence_number, ciphertext, associated_data);
+  if (!open_result.ok()) return open_result;
+  if (!MarkDecrypted(session_id, context.get(), sequence_number)) {
+    return Status(util::error::INVALID_ARGUMENT,
+                  "replayed or too old message");
+  }
+  return open_result;
+}
+
+int HpkeHybridSessionDecrypt::session_count() {
+  std::lock_guard<std::mutex> lock(sessions_mutex_);
+  return sessions_.size();
+}
+
+std::shared_ptr<const subtle::HpkeContextBoringSsl>
+HpkeHybridSessionDecrypt::Lookup(const std::string& session_id,
+                                 absl::string_view encapsulated_key) {
+  std::lock_guard<std::mutex> lock(sessions_mutex_);
+  auto found = sessions_.find(session_id);
+  if (found == sessions_.end()) return nullptr;
+  const Session& session = found->second.first;
+  if (!encapsulated_key.empty() &&
+      session.encapsulated_key != encapsulated_key) {
+    return nullptr;
+  }
+  lru_.splice(lru_.begin(), lru_, found->second.second);
+  return session.context;
+}
+
+bool HpkeHybridSessionDecrypt::MarkDecrypted(
+    const std::string& session_id,
+    const subtle::HpkeContextBoringSsl* context, uint64_t sequence_number) {
+  std::lock_guard<std::mutex> lock(sessions_mutex_);
+  auto found = sessions_.find(session_id);
+  if (found == sessions_.end()) return false;
+  Session& session = found->second.first;
+  if (session.context.get() != context) return false;
+  if (sequence_number > session.highest_sequence_number) {
+    uint64_t shift = sequence_number - session.highest_sequence_number;
+    session.decrypted =
+        shift >= kReplayWindowSize ? 0 : session.decrypted << shift;
+    session.decrypted |= 1;
+    session.highest_sequence_number = sequence_number;
+    return true;
+  }
+  uint64_t offset = session.highest_sequence_number - sequence_number;
+  if (offset >= kReplayWindowSize) return false;
+  uint64_t bit = uint64_t{1} << offset;
+  if ((session.decrypted & bit) != 0) return false;
+  session.decrypted |= bit;
+  return true;
+}
+
+void HpkeHybridSessionDecrypt::Insert(const std::string& session_id,
+                                      Session session) {
+  std::lock_guard<std::mutex> lock(sessions_mutex_);
+  auto found = sessions_.find(session_id);
+  if (found != sessions_.end()) {
+    found->second.first = std::move(session);
+    lru_.splice(lru_.begin(), lru_, found->second.second);
+    return;
+  }
+  if (sessions_.size() >= static_cast<size_t>(max_sessions_)) {
+    sessions_.erase(lru_.back());
+    lru_.pop_back();
+  }
+  lru_.push_front(session_id);
+  sessions_.emplace(session_id, std::make_pair(std::move(session),
+                                               lru_.begin()));
+}
+
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,131 @@
+// Copyright 2018 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_HYBRID_HPKE_HYBRID_SESSION_DECRYPT_H_
+#define TINK_HYBRID_HPKE_HYBRID_SESSION_DECRYPT_H_
+
+#include <stdint.h>
+
+#include <list>
+#include <memory>
+#include <mutex>  // NOLINT(build/c++11)
+#include <string>
+#include <unordered_map>
+
+#include "absl/strings/string_view.h"
+#include "tink/subtle/hpke_context_boringssl.h"
+#include "tink/util/statusor.h"
+#include "proto/hpke.pb.h"
+
+namespace crypto {
+namespace tink {
+
+// The receiving end of HpkeHybridSessionEncrypt sessions to one recipient
+// key (see there for the message format). The HPKE context of a session is
+// set up when its first message is decrypted, and kept in a cache keyed by
+// the session id, so that later messages of the session skip the X25519 key
+// agreement and the key schedule. The cache holds at most 'max_sessions'
+// sessions and evicts the least recently used one; later messages of an
+// evicted session fail to decrypt until its first message is decrypted
+// again.
+//
+// Each session keeps a replay window of the last kReplayWindowSize sequence
+// numbers, as in IPsec (RFC 4303, section 3.4.3): a message whose sequence
+// number was already decrypted, or is kReplayWindowSize or more below the
+// highest one decrypted, is rejected. Only authentic messages update the
+// window. The window lives in the cache, so it is lost when the session is
+// evicted; after that, replaying the first message sets the session up
+// again with an empty window.
+//
+// Decrypt() is thread-safe.
+class HpkeHybridSessionDecrypt {
+ public:
+  // Returns a decrypter for sessions to 'recipient_key' that were set up
+  // with 'context_info' as the HPKE info.
+  static crypto::tink::util::StatusOr<std::unique_ptr<HpkeHybridSessionDecrypt>>
+  New(const google::crypto::tink::HpkePrivateKey& recipient_key,
+      absl::string_view context_info, int max_sessions);
+
+  // Decrypts 'message', which must have been encrypted with
+  // 'associated_data'.
+  crypto::tink::util::StatusOr<std::string> Decrypt(
+      absl::string_view message, absl::string_view associated_data);
+
+  // Returns the number of sessions in the cache.
+  int session_count();
+
+  static constexpr uint64_t kReplayWindowSize = 64;
+
+ private:
+  struct Session {
+    std::string encapsulated_key;
+    std::shared_ptr<const subtle::HpkeContextBoringSsl> context;
+    // The highest sequence number decrypted so far, and a bitmap of the
+    // decrypted sequence numbers below it: bit i stands for
+    // highest_sequence_number - i.
+    uint64_t highest_sequence_number;
+    uint64_t decrypted;
+  };
+  typedef std::list<std::string> SessionIdList;
+
+  HpkeHybridSessionDecrypt(
+      const google::crypto::tink::HpkePrivateKey& recipient_key,
+      absl::string_view context_info, int max_sessions)
+      : recipient_key_(recipient_key),
+        context_info_(context_info),
+        max_sessions_(max_sessions) {}
+
+  // Returns the cached context of the session with 'session_id', or nullptr,
+  // and marks the session as most recently used.
+  std::shared_ptr<const subtle::HpkeContextBoringSsl> Lookup(
+      const std::string& session_id,
+      absl::string_view encapsulated_key = absl::string_view());
+
+  // Opens 'ciphertext' with 'context', the context of the session with
+  // 'session_id', and rejects the message if it is a replay.
+  crypto::tink::util::StatusOr<std::string> Open(
+      const std::string& session_id,
+      std::shared_ptr<const subtle::HpkeContextBoringSsl> context,
+      uint64_t sequence_number, absl::string_view ciphertext,
+      absl::string_view associated_data);
+
+  // Adds the session to the cache, replacing one with the same id.
+  void Insert(const std::string& session_id, Session session);
+
+  // Records that the message with 'sequence_number' of the session with
+  // 'session_id' and 'context' was decrypted. Returns false if the message
+  // is a replay, is too old for the replay window, or the session is no
+  // longer cached.
+  bool MarkDecrypted(const std::string& session_id,
+                     const subtle::HpkeContextBoringSsl* context,
+                     uint64_t sequence_number);
+
+  const google::crypto::tink::HpkePrivateKey recipient_key_;
+  const std::string context_info_;
+  const int max_sessions_;
+
+  std::mutex sessions_mutex_;
+  // Session ids, most recently used first; guarded by sessions_mutex_.
+  SessionIdList lru_;
+  // Guarded by sessions_mutex_.
+  std::unordered_map<std::string,
+                     std::pair<Session, SessionIdList::iterator>> sessions_;
+};
+
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_HYBRID_HPKE_HYBRID_SESSION_DECRYPT_H_
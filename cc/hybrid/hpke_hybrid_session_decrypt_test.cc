@@ -0,0 +1,274 @@
+// Copyright 2018 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/hybrid/hpke_hybrid_session_decrypt.h"
+
+#include <string>
+#include <thread>  // NOLINT(build/c++11)
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "tink/hybrid/hpke_hybrid_decrypt.h"
+#include "tink/hybrid/hpke_hybrid_session_encrypt.h"
+#include "tink/hybrid/hpke_private_key_manager.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "proto/hpke.pb.h"
+
+using google::crypto::tink::HpkeAead;
+using google::crypto::tink::HpkeKeyFormat;
+using google::crypto::tink::HpkePrivateKey;
+
+namespace crypto {
+namespace tink {
+namespace {
+
+class HpkeHybridSessionDecryptTest : public ::testing::Test {
+ protected:
+  HpkePrivateKey NewPrivateKey(HpkeAead aead) {
+    HpkeKeyFormat key_format;
+    key_format.mutable_params()->set_kem(
+        google::crypto::tink::DHKEM_X25519_HKDF_SHA256);
+    key_format.mutable_params()->set_kdf(google::crypto::tink::HKDF_SHA256);
+    key_format.mutable_params()->set_aead(aead);
+    auto result = HpkePrivateKeyManager().get_key_factory().NewKey(key_format);
+    EXPECT_TRUE(result.ok()) << result.status();
+    return reinterpret_cast<const HpkePrivateKey&>(*result.ValueOrDie());
+  }
+
+  std::unique_ptr<HpkeHybridSessionEncrypt> NewSession(
+      const HpkePrivateKey& key) {
+    auto result = HpkeHybridSessionEncrypt::New(key.public_key(), "info");
+    EXPECT_TRUE(result.ok()) << result.status();
+    return std::move(result.ValueOrDie());
+  }
+
+  std::unique_ptr<HpkeHybridSessionDecrypt> NewDecrypt(
+      const HpkePrivateKey& key, int max_sessions) {
+    auto result = HpkeHybridSessionDecrypt::New(key, "info", max_sessions);
+    EXPECT_TRUE(result.ok()) << result.status();
+    return std::move(result.ValueOrDie());
+  }
+};
+
+TEST_F(HpkeHybridSessionDecryptTest, testEncryptDecrypt) {
+  for (HpkeAead aead : {HpkeAead::AES_128_GCM, HpkeAead::AES_256_GCM,
+                        HpkeAead::CHACHA20_POLY1305}) {
+    SCOPED_TRACE(static_cast<int>(aead));
+    HpkePrivateKey key = NewPrivateKey(aead);
+    auto session = NewSession(key);
+    std::vector<std::string> messages;
+    for (uint64_t i = 0; i < HpkeHybridSessionDecrypt::kReplayWindowSize;
+         i++) {
+      auto result = session->Encrypt("message " + std::to_string(i), "aad");
+      ASSERT_TRUE(result.ok()) << result.status();
+      messages.push_back(result.ValueOrDie());
+    }
+    // The first message carries the 32-byte encapsulated key, later ones an
+    // 8-byte session id and an 8-byte sequence number.
+    EXPECT_EQ(1 + 32 + 9 + 16, messages[0].size());
+    EXPECT_EQ(1 + 8 + 8 + 9 + 16, messages[1].size());
+
+    auto decrypt = NewDecrypt(key, 10);
+    // Later messages need the first one.
+    auto result = decrypt->Decrypt(messages[1], "aad");
+    EXPECT_FALSE(result.ok());
+    EXPECT_EQ(util::error::NOT_FOUND, result.status().error_code());
+
+    EXPECT_FALSE(decrypt->Decrypt(messages[0], "wrong aad").ok());
+    EXPECT_EQ(0, decrypt->session_count());
+    ASSERT_EQ("message 0", decrypt->Decrypt(messages[0], "aad").ValueOrDie());
+    EXPECT_EQ(1, decrypt->session_count());
+    // Later messages may arrive in any order within the replay window.
+    for (int i = messages.size() - 1; i >= 1; i--) {
+      EXPECT_FALSE(decrypt->Decrypt(messages[i], "wrong aad").ok());
+      auto result = decrypt->Decrypt(messages[i], "aad");
+      ASSERT_TRUE(result.ok()) << result.status();
+      EXPECT_EQ("message " + std::to_string(i), result.ValueOrDie());
+    }
+    EXPECT_EQ(1, decrypt->session_count());
+  }
+}
+
+TEST_F(HpkeHybridSessionDecryptTest, testFirstMessageIsHpkeCiphertext) {
+  HpkePrivateKey key = NewPrivateKey(HpkeAead::AES_128_GCM);
+  auto session = NewSession(key);
+  std::string message = session->Encrypt("plaintext", "").ValueOrDie();
+  auto hpke_decrypt = std::move(HpkeHybridDecrypt::New(key).ValueOrDie());
+  auto result = hpke_decrypt->Decrypt(message.substr(1), "info");
+  ASSERT_TRUE(result.ok()) << result.status();
+  EXPECT_EQ("plaintext", result.ValueOrDie());
+}
+
+TEST_F(HpkeHybridSessionDecryptTest, testModifiedMessages) {
+  HpkePrivateKey key = NewPrivateKey(HpkeAead::AES_128_GCM);
+  auto session = NewSession(key);
+  std::string first = session->Encrypt("first", "").ValueOrDie();
+  std::string next = session->Encrypt("next", "").ValueOrDie();
+  auto decrypt = NewDecrypt(key, 10);
+  for (size_t position = 0; position < first.size(); position++) {
+    std::string modified = first;
+    modified[position] ^= 0x01;
+    EXPECT_FALSE(decrypt->Decrypt(modified, "").ok()) << position;
+  }
+  EXPECT_EQ(0, decrypt->session_count());
+  ASSERT_TRUE(decrypt->Decrypt(first, "").ok());
+  for (size_t position = 0; position < next.size(); position++) {
+    std::string modified = next;
+    modified[position] ^= 0x01;
+    EXPECT_FALSE(decrypt->Decrypt(modified, "").ok()) << position;
+  }
+  for (size_t size = 0; size < next.size(); size++) {
+    EXPECT_FALSE(decrypt->Decrypt(next.substr(0, size), "").ok());
+  }
+  EXPECT_EQ("next", decrypt->Decrypt(next, "").ValueOrDie());
+
+  // A decrypter with another info cannot decrypt, and caches nothing.
+  auto other_decrypt = std::move(
+      HpkeHybridSessionDecrypt::New(key, "other info", 10).ValueOrDie());
+  EXPECT_FALSE(other_decrypt->Decrypt(first, "").ok());
+  EXPECT_EQ(0, other_decrypt->session_count());
+}
+
+TEST_F(HpkeHybridSessionDecryptTest, testEviction) {
+  HpkePrivateKey key = NewPrivateKey(HpkeAead::AES_128_GCM);
+  auto decrypt = NewDecrypt(key, 2);
+  std::vector<std::string> firsts;
+  std::vector<std::string> nexts;
+  for (int i = 0; i < 3; i++) {
+    auto session = NewSession(key);
+    firsts.push_back(session->Encrypt("first", "").ValueOrDie());
+    nexts.push_back(session->Encrypt("next", "").ValueOrDie());
+  }
+  ASSERT_TRUE(decrypt->Decrypt(firsts[0], "").ok());
+  ASSERT_TRUE(decrypt->Decrypt(firsts[1], "").ok());
+  // Session 0 becomes the most recently used.
+  ASSERT_TRUE(decrypt->Decrypt(nexts[0], "").ok());
+  ASSERT_TRUE(decrypt->Decrypt(firsts[2], "").ok());
+  EXPECT_EQ(2, decrypt->session_count());
+
+  // Session 1 was evicted until its first message is decrypted again.
+  EXPECT_TRUE(decrypt->Decrypt(nexts[2], "").ok());
+  auto result = decrypt->Decrypt(nexts[1], "");
+  EXPECT_EQ(util::error::NOT_FOUND, result.status().error_code());
+  ASSERT_TRUE(decrypt->Decrypt(firsts[1], "").ok());
+  EXPECT_TRUE(decrypt->Decrypt(nexts[1], "").ok());
+  // Eviction dropped the replay window of session 1, so its first message
+  // was accepted again; now that it is cached, replays are rejected.
+  EXPECT_FALSE(decrypt->Decrypt(firsts[1], "").ok());
+  EXPECT_FALSE(decrypt->Decrypt(nexts[1], "").ok());
+}
+
+TEST_F(HpkeHybridSessionDecryptTest, testReplay) {
+  HpkePrivateKey key = NewPrivateKey(HpkeAead::AES_128_GCM);
+  auto session = NewSession(key);
+  std::vector<std::string> messages;
+  for (uint64_t i = 0; i < 2 * HpkeHybridSessionDecrypt::kReplayWindowSize;
+       i++) {
+    messages.push_back(session->Encrypt(std::to_string(i), "").ValueOrDie());
+  }
+  auto decrypt = NewDecrypt(key, 10);
+  ASSERT_TRUE(decrypt->Decrypt(messages[0], "").ok());
+  auto result = decrypt->Decrypt(messages[0], "");
+  EXPECT_EQ(util::error::INVALID_ARGUMENT, result.status().error_code());
+
+  ASSERT_TRUE(decrypt->Decrypt(messages[2], "").ok());
+  result = decrypt->Decrypt(messages[2], "");
+  EXPECT_EQ(util::error::INVALID_ARGUMENT, result.status().error_code());
+  // Gaps below the highest sequence number can still be filled, once.
+  ASSERT_TRUE(decrypt->Decrypt(messages[1], "").ok());
+  EXPECT_FALSE(decrypt->Decrypt(messages[1], "").ok());
+
+  // A forged message does not move the window.
+  const int last = messages.size() - 1;
+  std::string forged = messages[last];
+  forged.back() ^= 0x01;
+  EXPECT_FALSE(decrypt->Decrypt(forged, "").ok());
+  ASSERT_TRUE(decrypt->Decrypt(messages[3], "").ok());
+
+  // Messages that fall out of the window are rejected even if never seen.
+  ASSERT_TRUE(decrypt->Decrypt(messages[last], "").ok());
+  const int oldest = last - HpkeHybridSessionDecrypt::kReplayWindowSize + 1;
+  EXPECT_FALSE(decrypt->Decrypt(messages[oldest - 1], "").ok());
+  EXPECT_TRUE(decrypt->Decrypt(messages[oldest], "").ok());
+  EXPECT_FALSE(decrypt->Decrypt(messages[last], "").ok());
+}
+
+TEST_F(HpkeHybridSessionDecryptTest, testConcurrentEncryptDecrypt) {
+  HpkePrivateKey key = NewPrivateKey(HpkeAead::AES_128_GCM);
+  auto session = NewSession(key);
+  auto decrypt = NewDecrypt(key, 10);
+  ASSERT_TRUE(
+      decrypt->Decrypt(session->Encrypt("first", "").ValueOrDie(), "").ok());
+
+  // The messages are encrypted concurrently, and then all threads try to
+  // decrypt all of them; each message is accepted exactly once.
+  const int kThreads = 4;
+  const int kMessages = HpkeHybridSessionDecrypt::kReplayWindowSize - 1;
+  std::vector<std::string> messages(kMessages);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreads; t++) {
+    threads.emplace_back([&, t]() {
+      for (int i = t; i < kMessages; i += kThreads) {
+        messages[i] = session->Encrypt("message", "").ValueOrDie();
+      }
+    });
+  }
+  for (auto& thread : threads) thread.join();
+  threads.clear();
+  std::vector<std::vector<int>> accepted(kThreads,
+                                         std::vector<int>(kMessages, 0));
+  for (int t = 0; t < kThreads; t++) {
+    threads.emplace_back([&, t]() {
+      for (int i = 0; i < kMessages; i++) {
+        auto result = decrypt->Decrypt(messages[(i + t) % kMessages], "");
+        if (result.ok() && result.ValueOrDie() == "message") {
+          accepted[t][(i + t) % kMessages]++;
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) thread.join();
+  for (int i = 0; i < kMessages; i++) {
+    int count = 0;
+    for (int t = 0; t < kThreads; t++) count += accepted[t][i];
+    EXPECT_EQ(1, count) << i;
+  }
+}
+
+TEST_F(HpkeHybridSessionDecryptTest, testInvalidParameters) {
+  HpkePrivateKey key = NewPrivateKey(HpkeAead::AES_128_GCM);
+  EXPECT_FALSE(HpkeHybridSessionDecrypt::New(key, "info", 0).ok());
+  HpkePrivateKey bad_key = key;
+  bad_key.set_private_key("too short");
+  EXPECT_FALSE(HpkeHybridSessionDecrypt::New(bad_key, "info", 1).ok());
+  google::crypto::tink::HpkePublicKey bad_public_key = key.public_key();
+  bad_public_key.set_public_key("too short");
+  EXPECT_FALSE(HpkeHybridSessionEncrypt::New(bad_public_key, "info").ok());
+
+  auto decrypt = NewDecrypt(key, 1);
+  EXPECT_FALSE(decrypt->Decrypt("", "").ok());
+  EXPECT_FALSE(decrypt->Decrypt(std::string(100, '\x02'), "").ok());
+}
+
+}  // namespace
+}  // namespace tink
+}  // namespace crypto
+
+int main(int ac, char* av[]) {
+  testing::InitGoogleTest(&ac, av);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,82 @@
+// Copyright 2018 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/hybrid/hpke_hybrid_session_encrypt.h"
+
+#include "tink/subtle/hpke_context_boringssl.h"
+#include "tink/util/enums.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "proto/hpke.pb.h"
+
+using google::crypto::tink::HpkePublicKey;
+using crypto::tink::util::Status;
+using crypto::tink::util::StatusOr;
+
+namespace crypto {
+namespace tink {
+
+constexpr uint8_t HpkeHybridSessionEncrypt::kFirstMessage;
+constexpr uint8_t HpkeHybridSessionEncrypt::kNextMessage;
+constexpr int HpkeHybridSessionEncrypt::kSessionIdSize;
+
+// static
+StatusOr<std::unique_ptr<HpkeHybridSessionEncrypt>>
+HpkeHybridSessionEncrypt::New(const HpkePublicKey& recipient_key,
+                              absl::string_view context_info) {
+  if (recipient_key.public_key().size() !=
+          subtle::HpkeContextBoringSsl::kX25519KeySize ||
+      !recipient_key.has_params()) {
+    return Status(util::error::INVALID_ARGUMENT,
+                  "Invalid HpkePublicKey: missing required fields.");
+  }
+  std::string encapsulated_key;
+  auto context_result = subtle::HpkeContextBoringSsl::SetupSender(
+      util::Enums::ProtoToSubtle(recipient_key.params().aead()),
+      recipient_key.public_key(), context_info, &encapsulated_key);
+  if (!context_result.ok()) return context_result.status();
+  return std::unique_ptr<HpkeHybridSessionEncrypt>(
+      new HpkeHybridSessionEncrypt(std::move(context_result.ValueOrDie()),
+                                   std::move(encapsulated_key)));
+}
+
+StatusOr<std::string> HpkeHybridSessionEncrypt::Encrypt(
+    absl::string_view plaintext, absl::string_view associated_data) {
+  uint64_t sequence_number = next_sequence_number_.fetch_add(1);
+  auto seal_result = context_->SealWithSequenceNumber(
+      sequence_number, plaintext, associated_data);
+  if (!seal_result.ok()) return seal_result.status();
+
+  std::string message;
+  if (sequence_number == 0) {
+    message.reserve(1 + encapsulated_key_.size() +
+                    seal_result.ValueOrDie().size());
+    message.push_back(static_cast<char>(kFirstMessage));
+    message.append(encapsulated_key_);
+  } else {
+    message.reserve(1 + kSessionIdSize + 8 + seal_result.ValueOrDie().size());
+    message.push_back(static_cast<char>(kNextMessage));
+    message.append(encapsulated_key_, 0, kSessionIdSize);
+    for (int shift = 56; shift >= 0; shift -= 8) {
+      message.push_back(static_cast<char>(sequence_number >> shift));
+    }
+  }
+  message.append(seal_result.ValueOrDie());
+  return message;
+}
+
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,83 @@
+// Copyright 2018 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_HYBRID_HPKE_HYBRID_SESSION_ENCRYPT_H_
+#define TINK_HYBRID_HPKE_HYBRID_SESSION_ENCRYPT_H_
+
+#include <atomic>
+#include <memory>
+#include <string>
+
+#include "absl/strings/string_view.h"
+#include "tink/subtle/hpke_context_boringssl.h"
+#include "tink/util/statusor.h"
+#include "proto/hpke.pb.h"
+
+namespace crypto {
+namespace tink {
+
+// The sending end of an HPKE session: a stream of messages to one recipient
+// key that share a single key encapsulation. The X25519 key agreement and
+// the HPKE key schedule run once, in New(); every message is then encrypted
+// with the AEAD of the resulting HPKE context, under the nonce for the
+// message's sequence number, at about the cost of plain AEAD.
+//
+// The first message (sequence number 0) carries the encapsulated key,
+//   0x00 || encapsulated_key (32 bytes) || ciphertext,
+// and later messages only refer to it:
+//   0x01 || session_id (8 bytes) || sequence_number (8 bytes, big endian) ||
+//   ciphertext,
+// where session_id is the first 8 bytes of the encapsulated key, and
+// ciphertext is the HPKE ciphertext of the message with the caller's
+// associated data. Messages are decrypted with HpkeHybridSessionDecrypt;
+// a later message can only be decrypted after the first one, but later
+// messages may arrive in any order, within the replay window of
+// HpkeHybridSessionDecrypt.
+//
+// Encrypt() is thread-safe.
+class HpkeHybridSessionEncrypt {
+ public:
+  // Encapsulates a fresh shared secret to 'recipient_key', with
+  // 'context_info' as the HPKE info, and returns the session.
+  static crypto::tink::util::StatusOr<std::unique_ptr<HpkeHybridSessionEncrypt>>
+  New(const google::crypto::tink::HpkePublicKey& recipient_key,
+      absl::string_view context_info);
+
+  // Encrypts 'plaintext' as the next message of the session.
+  crypto::tink::util::StatusOr<std::string> Encrypt(
+      absl::string_view plaintext, absl::string_view associated_data);
+
+  static constexpr uint8_t kFirstMessage = 0;
+  static constexpr uint8_t kNextMessage = 1;
+  static constexpr int kSessionIdSize = 8;
+
+ private:
+  HpkeHybridSessionEncrypt(
+      std::unique_ptr<subtle::HpkeContextBoringSsl> context,
+      std::string encapsulated_key)
+      : context_(std::move(context)),
+        encapsulated_key_(std::move(encapsulated_key)),
+        next_sequence_number_(0) {}
+
+  const std::unique_ptr<subtle::HpkeContextBoringSsl> context_;
+  const std::string encapsulated_key_;
+  std::atomic<uint64_t> next_sequence_number_;
+};
+
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_HYBRID_HPKE_HYBRID_SESSION_ENCRYPT_H_
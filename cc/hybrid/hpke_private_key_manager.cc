@@ -0,0 +1,227 @@
+// Copyright 2018 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/hybrid/hpke_private_key_manager.h"
+
+#include "absl/strings/string_view.h"
+#include "absl/memory/memory.h"
+#include "openssl/curve25519.h"
+#include "openssl/mem.h"
+#include "tink/hybrid_decrypt.h"
+#include "tink/key_manager.h"
+#include "tink/hybrid/hpke_hybrid_decrypt.h"
+#include "tink/hybrid/hpke_public_key_manager.h"
+#include "tink/util/errors.h"
+#include "tink/util/protobuf_helper.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "tink/util/validation.h"
+#include "proto/hpke.pb.h"
+#include "proto/tink.pb.h"
+
+namespace crypto {
+namespace tink {
+
+using google::crypto::tink::HpkePrivateKey;
+using google::crypto::tink::HpkeKeyFormat;
+using google::crypto::tink::KeyData;
+using google::crypto::tink::KeyTemplate;
+using portable_proto::MessageLite;
+using crypto::tink::util::Status;
+using crypto::tink::util::StatusOr;
+
+class HpkePrivateKeyFactory : public PrivateKeyFactory {
+ public:
+  HpkePrivateKeyFactory() {}
+
+  // Generates a new random HpkePrivateKey, based on
+  // the given 'key_format', which must contain HpkeKeyFormat-proto.
+  crypto::tink::util::StatusOr<std::unique_ptr<portable_proto::MessageLite>>
+  NewKey(const portable_proto::MessageLite& key_format) const override;
+
+  // Generates a new random HpkePrivateKey, based on
+  // the given 'serialized_key_format', which must contain
+  // HpkeKeyFormat-proto.
+  crypto::tink::util::StatusOr<std::unique_ptr<portable_proto::MessageLite>>
+  NewKey(absl::string_view serialized_key_format) const override;
+
+  // Generates a new random HpkePrivateKey based on
+  // the given 'serialized_key_format' (which must contain
+  // HpkeKeyFormat-proto), and wraps it in a KeyData-proto.
+  crypto::tink::util::StatusOr<std::unique_ptr<google::crypto::tink::KeyData>>
+  NewKeyData(absl::string_view serialized_key_format) const override;
+
+  // Returns KeyData proto that contains HpkePublicKey
+  // extracted from the given serialized_private_key, which must contain
+  // HpkePrivateKey-proto.
+  crypto::tink::util::StatusOr<std::unique_ptr<google::crypto::tink::KeyData>>
+  GetPublicKeyData(absl::string_view serialized_private_key) const override;
+};
+
+StatusOr<std::unique_ptr<MessageLite>> HpkePrivateKeyFactory::NewKey(
+    const portable_proto::MessageLite& key_format) const {
+  std::string key_format_url =
+      std::string(HpkePrivateKeyManager::kKeyTypePrefix) +
+      key_format.GetTypeName();
+  if (key_format_url != HpkePrivateKeyManager::kKeyFormatUrl) {
+    return ToStatusF(util::error::INVALID_ARGUMENT,
+                     "Key format proto '%s' is not supported by this manager.",
+                     key_format_url.c_str());
+  }
+  const HpkeKeyFormat& hpke_key_format =
+        reinterpret_cast<const HpkeKeyFormat&>(key_format);
+  Status status = HpkePublicKeyManager::Validate(hpke_key_format);
+  if (!status.ok()) return status;
+
+  // Generate new X25519 key.
+  uint8_t public_key[X25519_PUBLIC_VALUE_LEN];
+  uint8_t private_key[X25519_PRIVATE_KEY_LEN];
+  X25519_keypair(public_key, private_key);
+
+  // Build HpkePrivateKey.
+  std::unique_ptr<HpkePrivateKey> hpke_private_key(new HpkePrivateKey());
+  hpke_private_key->set_version(HpkePrivateKeyManager::kVersion);
+  hpke_private_key->set_private_key(private_key, sizeof(private_key));
+  OPENSSL_cleanse(private_key, sizeof(private_key));
+  auto hpke_public_key = hpke_private_key->mutable_public_key();
+  hpke_public_key->set_version(HpkePrivateKeyManager::kVersion);
+  hpke_public_key->set_public_key(public_key, sizeof(public_key));
+  *(hpke_public_key->mutable_params()) = hpke_key_format.params();
+
+  std::unique_ptr<MessageLite> key = std::move(hpke_private_key);
+  return std::move(key);
+}
+
+StatusOr<std::unique_ptr<MessageLite>> HpkePrivateKeyFactory::NewKey(
+    absl::string_view serialized_key_format) const {
+  HpkeKeyFormat key_format;
+  if (!key_format.ParseFromString(std::string(serialized_key_format))) {
+    return ToStatusF(util::error::INVALID_ARGUMENT,
+                     "Could not parse the passed string as proto '%s'.",
+                     HpkePrivateKeyManager::kKeyFormatUrl);
+  }
+  return NewKey(key_format);
+}
+
+StatusOr<std::unique_ptr<KeyData>> HpkePrivateKeyFactory::NewKeyData(
+    absl::string_view serialized_key_format) const {
+  auto new_key_result = NewKey(serialized_key_format);
+  if (!new_key_result.ok()) return new_key_result.status();
+  auto new_key = reinterpret_cast<const HpkePrivateKey&>(
+      *(new_key_result.ValueOrDie()));
+  std::unique_ptr<KeyData> key_data(new KeyData());
+  key_data->set_type_url(HpkePrivateKeyManager::kKeyType);
+  key_data->set_value(new_key.SerializeAsString());
+  key_data->set_key_material_type(KeyData::ASYMMETRIC_PRIVATE);
+  return std::move(key_data);
+}
+
+StatusOr<std::unique_ptr<KeyData>>
+HpkePrivateKeyFactory::GetPublicKeyData(
+    absl::string_view serialized_private_key) const {
+  HpkePrivateKey private_key;
+  if (!private_key.ParseFromString(std::string(serialized_private_key))) {
+    return ToStatusF(util::error::INVALID_ARGUMENT,
+                     "Could not parse the passed string as proto '%s'.",
+                     HpkePrivateKeyManager::kKeyType);
+  }
+  auto status = HpkePrivateKeyManager::Validate(private_key);
+  if (!status.ok()) return status;
+  auto key_data = absl::make_unique<KeyData>();
+  key_data->set_type_url(HpkePublicKeyManager::kKeyType);
+  key_data->set_value(private_key.public_key().SerializeAsString());
+  key_data->set_key_material_type(KeyData::ASYMMETRIC_PUBLIC);
+  return std::move(key_data);
+}
+
+constexpr char HpkePrivateKeyManager::kKeyFormatUrl[];
+constexpr char HpkePrivateKeyManager::kKeyTypePrefix[];
+constexpr char HpkePrivateKeyManager::kKeyType[];
+constexpr uint32_t HpkePrivateKeyManager::kVersion;
+
+HpkePrivateKeyManager::HpkePrivateKeyManager()
+    : key_type_(kKeyType), key_factory_(new HpkePrivateKeyFactory()) {
+}
+
+const std::string& HpkePrivateKeyManager::get_key_type() const {
+  return key_type_;
+}
+
+const KeyFactory& HpkePrivateKeyManager::get_key_factory() const {
+  return *key_factory_;
+}
+
+uint32_t HpkePrivateKeyManager::get_version() const {
+  return kVersion;
+}
+
+StatusOr<std::unique_ptr<HybridDecrypt>>
+HpkePrivateKeyManager::GetPrimitive(const KeyData& key_data) const {
+  if (DoesSupport(key_data.type_url())) {
+    HpkePrivateKey hpke_private_key;
+    if (!hpke_private_key.ParseFromString(key_data.value())) {
+      return ToStatusF(util::error::INVALID_ARGUMENT,
+                       "Could not parse key_data.value as key type '%s'.",
+                       key_data.type_url().c_str());
+    }
+    return GetPrimitiveImpl(hpke_private_key);
+  } else {
+    return ToStatusF(util::error::INVALID_ARGUMENT,
+                     "Key type '%s' is not supported by this manager.",
+                     key_data.type_url().c_str());
+  }
+}
+
+StatusOr<std::unique_ptr<HybridDecrypt>>
+HpkePrivateKeyManager::GetPrimitive(const MessageLite& key) const {
+  std::string key_type = std::string(kKeyTypePrefix) + key.GetTypeName();
+  if (DoesSupport(key_type)) {
+    const HpkePrivateKey& hpke_private_key =
+        reinterpret_cast<const HpkePrivateKey&>(key);
+    return GetPrimitiveImpl(hpke_private_key);
+  } else {
+    return ToStatusF(util::error::INVALID_ARGUMENT,
+                     "Key type '%s' is not supported by this manager.",
+                     key_type.c_str());
+  }
+}
+
+StatusOr<std::unique_ptr<HybridDecrypt>>
+HpkePrivateKeyManager::GetPrimitiveImpl(
+    const HpkePrivateKey& hpke_private_key) const {
+  Status status = Validate(hpke_private_key);
+  if (!status.ok()) return status;
+  auto hpke_result = HpkeHybridDecrypt::New(hpke_private_key);
+  if (!hpke_result.ok()) return hpke_result.status();
+  return std::move(hpke_result.ValueOrDie());
+}
+
+// static
+Status HpkePrivateKeyManager::Validate(
+    const HpkePrivateKey& key) {
+  Status status = ValidateVersion(key.version(), kVersion);
+  if (!status.ok()) return status;
+  if (!key.has_public_key()) {
+    return Status(util::error::INVALID_ARGUMENT, "Missing public_key.");
+  }
+  if (key.private_key().size() != X25519_PRIVATE_KEY_LEN) {
+    return Status(util::error::INVALID_ARGUMENT, "Invalid private_key size.");
+  }
+  return HpkePublicKeyManager::Validate(key.public_key());
+}
+
+}  // namespace tink
+}  // namespace crypto
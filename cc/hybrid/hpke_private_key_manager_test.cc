@@ -0,0 +1,189 @@
+// Copyright 2018 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include "tink/hybrid/hpke_private_key_manager.h"
+
+#include "tink/hybrid_decrypt.h"
+#include "tink/hybrid_encrypt.h"
+#include "tink/hybrid/hpke_public_key_manager.h"
+#include "tink/hybrid/hybrid_key_templates.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "gtest/gtest.h"
+#include "proto/hpke.pb.h"
+#include "proto/tink.pb.h"
+
+namespace crypto {
+namespace tink {
+
+using google::crypto::tink::HpkeAead;
+using google::crypto::tink::HpkeKeyFormat;
+using google::crypto::tink::HpkePrivateKey;
+using google::crypto::tink::HpkePublicKey;
+using google::crypto::tink::KeyData;
+
+namespace {
+
+class HpkePrivateKeyManagerTest : public ::testing::Test {
+ protected:
+  HpkePrivateKey NewPrivateKey(HpkeAead aead) {
+    HpkeKeyFormat key_format;
+    key_format.mutable_params()->set_kem(
+        google::crypto::tink::DHKEM_X25519_HKDF_SHA256);
+    key_format.mutable_params()->set_kdf(google::crypto::tink::HKDF_SHA256);
+    key_format.mutable_params()->set_aead(aead);
+    auto result = private_key_manager_.get_key_factory().NewKey(key_format);
+    EXPECT_TRUE(result.ok()) << result.status();
+    return reinterpret_cast<const HpkePrivateKey&>(*result.ValueOrDie());
+  }
+
+  HpkePrivateKeyManager private_key_manager_;
+  HpkePublicKeyManager public_key_manager_;
+};
+
+TEST_F(HpkePrivateKeyManagerTest, testBasic) {
+  EXPECT_EQ(0, private_key_manager_.get_version());
+  EXPECT_EQ("type.googleapis.com/google.crypto.tink.HpkePrivateKey",
+            private_key_manager_.get_key_type());
+  EXPECT_TRUE(private_key_manager_.DoesSupport(
+      "type.googleapis.com/google.crypto.tink.HpkePrivateKey"));
+}
+
+TEST_F(HpkePrivateKeyManagerTest, testEncryptDecrypt) {
+  for (HpkeAead aead : {HpkeAead::AES_128_GCM, HpkeAead::AES_256_GCM,
+                        HpkeAead::CHACHA20_POLY1305}) {
+    SCOPED_TRACE(static_cast<int>(aead));
+    HpkePrivateKey private_key = NewPrivateKey(aead);
+    EXPECT_EQ(0, private_key.version());
+    EXPECT_EQ(32, private_key.private_key().size());
+    EXPECT_EQ(32, private_key.public_key().public_key().size());
+    EXPECT_EQ(aead, private_key.public_key().params().aead());
+
+    auto decrypt_result = private_key_manager_.GetPrimitive(private_key);
+    ASSERT_TRUE(decrypt_result.ok()) << decrypt_result.status();
+    auto encrypt_result =
+        public_key_manager_.GetPrimitive(private_key.public_key());
+    ASSERT_TRUE(encrypt_result.ok()) << encrypt_result.status();
+
+    std::string plaintext = "some plaintext";
+    std::string context_info = "some context info";
+    auto ciphertext_result =
+        encrypt_result.ValueOrDie()->Encrypt(plaintext, context_info);
+    ASSERT_TRUE(ciphertext_result.ok()) << ciphertext_result.status();
+    std::string ciphertext = ciphertext_result.ValueOrDie();
+    auto plaintext_result =
+        decrypt_result.ValueOrDie()->Decrypt(ciphertext, context_info);
+    ASSERT_TRUE(plaintext_result.ok()) << plaintext_result.status();
+    EXPECT_EQ(plaintext, plaintext_result.ValueOrDie());
+
+    EXPECT_FALSE(
+        decrypt_result.ValueOrDie()->Decrypt(ciphertext, "other info").ok());
+    EXPECT_FALSE(decrypt_result.ValueOrDie()
+                     ->Decrypt(ciphertext.substr(0, 31), context_info)
+                     .ok());
+  }
+}
+
+TEST_F(HpkePrivateKeyManagerTest, testKeyDataErrors) {
+  {  // Bad key type.
+    KeyData key_data;
+    key_data.set_type_url(
+        "type.googleapis.com/google.crypto.tink.SomeOtherKey");
+    auto result = private_key_manager_.GetPrimitive(key_data);
+    EXPECT_FALSE(result.ok());
+    EXPECT_EQ(util::error::INVALID_ARGUMENT, result.status().error_code());
+  }
+
+  {  // Bad key value.
+    KeyData key_data;
+    key_data.set_type_url(private_key_manager_.get_key_type());
+    key_data.set_value("some bad serialized proto");
+    auto result = private_key_manager_.GetPrimitive(key_data);
+    EXPECT_FALSE(result.ok());
+    EXPECT_EQ(util::error::INVALID_ARGUMENT, result.status().error_code());
+  }
+
+  {  // Bad version.
+    HpkePrivateKey key = NewPrivateKey(HpkeAead::AES_128_GCM);
+    key.set_version(1);
+    EXPECT_FALSE(private_key_manager_.GetPrimitive(key).ok());
+  }
+
+  {  // Bad private key size.
+    HpkePrivateKey key = NewPrivateKey(HpkeAead::AES_128_GCM);
+    key.set_private_key("too short");
+    EXPECT_FALSE(private_key_manager_.GetPrimitive(key).ok());
+  }
+
+  {  // Unknown AEAD.
+    HpkePrivateKey key = NewPrivateKey(HpkeAead::AES_128_GCM);
+    key.mutable_public_key()->mutable_params()->set_aead(
+        HpkeAead::AEAD_UNKNOWN);
+    EXPECT_FALSE(private_key_manager_.GetPrimitive(key).ok());
+  }
+}
+
+TEST_F(HpkePrivateKeyManagerTest, testNewKeyErrors) {
+  const KeyFactory& key_factory = private_key_manager_.get_key_factory();
+
+  {  // Bad key format.
+    HpkePublicKey key;
+    auto result = key_factory.NewKey(key);
+    EXPECT_FALSE(result.ok());
+    EXPECT_EQ(util::error::INVALID_ARGUMENT, result.status().error_code());
+  }
+
+  {  // Missing params.
+    HpkeKeyFormat key_format;
+    EXPECT_FALSE(key_factory.NewKey(key_format).ok());
+  }
+
+  {  // Bad serialized key format.
+    auto result = key_factory.NewKey("some bad serialized proto");
+    EXPECT_FALSE(result.ok());
+    EXPECT_EQ(util::error::INVALID_ARGUMENT, result.status().error_code());
+  }
+}
+
+TEST_F(HpkePrivateKeyManagerTest, testNewKeyDataAndPublicKeyData) {
+  const auto& key_template = HybridKeyTemplates::HpkeX25519HkdfSha256Aes128Gcm();
+  auto key_data_result =
+      private_key_manager_.get_key_factory().NewKeyData(key_template.value());
+  ASSERT_TRUE(key_data_result.ok()) << key_data_result.status();
+  auto& key_data = *key_data_result.ValueOrDie();
+  EXPECT_EQ(private_key_manager_.get_key_type(), key_data.type_url());
+  EXPECT_EQ(KeyData::ASYMMETRIC_PRIVATE, key_data.key_material_type());
+
+  auto private_key_factory = dynamic_cast<const PrivateKeyFactory*>(
+      &private_key_manager_.get_key_factory());
+  ASSERT_NE(nullptr, private_key_factory);
+  auto public_key_data_result =
+      private_key_factory->GetPublicKeyData(key_data.value());
+  ASSERT_TRUE(public_key_data_result.ok()) << public_key_data_result.status();
+  auto& public_key_data = *public_key_data_result.ValueOrDie();
+  EXPECT_EQ(public_key_manager_.get_key_type(), public_key_data.type_url());
+  EXPECT_EQ(KeyData::ASYMMETRIC_PUBLIC, public_key_data.key_material_type());
+  EXPECT_TRUE(public_key_manager_.GetPrimitive(public_key_data).ok());
+}
+
+}  // namespace
+}  // namespace tink
+}  // namespace crypto
+
+int main(int ac, char* av[]) {
+  testing::InitGoogleTest(&ac, av);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,185 @@
+// Copyright 2018 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/hybrid/hpke_public_key_manager.h"
+
+#include "absl/strings/string_view.h"
+#include "openssl/curve25519.h"
+#include "tink/hybrid_encrypt.h"
+#include "tink/key_manager.h"
+#include "tink/hybrid/hpke_hybrid_encrypt.h"
+#include "tink/util/errors.h"
+#include "tink/util/protobuf_helper.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "tink/util/validation.h"
+#include "proto/hpke.pb.h"
+#include "proto/tink.pb.h"
+
+namespace crypto {
+namespace tink {
+
+using google::crypto::tink::HpkeAead;
+using google::crypto::tink::HpkeKdf;
+using google::crypto::tink::HpkeKem;
+using google::crypto::tink::HpkeKeyFormat;
+using google::crypto::tink::HpkeParams;
+using google::crypto::tink::HpkePublicKey;
+using google::crypto::tink::KeyData;
+using google::crypto::tink::KeyTemplate;
+using portable_proto::MessageLite;
+using crypto::tink::util::Status;
+using crypto::tink::util::StatusOr;
+
+class HpkePublicKeyFactory : public KeyFactory {
+ public:
+  HpkePublicKeyFactory() {}
+
+  // Not implemented for public keys.
+  crypto::tink::util::StatusOr<std::unique_ptr<portable_proto::MessageLite>>
+  NewKey(const portable_proto::MessageLite& key_format) const override;
+
+  // Not implemented for public keys.
+  crypto::tink::util::StatusOr<std::unique_ptr<portable_proto::MessageLite>>
+  NewKey(absl::string_view serialized_key_format) const override;
+
+  // Not implemented for public keys.
+  crypto::tink::util::StatusOr<std::unique_ptr<google::crypto::tink::KeyData>>
+  NewKeyData(absl::string_view serialized_key_format) const override;
+};
+
+StatusOr<std::unique_ptr<MessageLite>> HpkePublicKeyFactory::NewKey(
+    const portable_proto::MessageLite& key_format) const {
+  return util::Status(util::error::UNIMPLEMENTED,
+                      "Operation not supported for public keys, "
+                      "please use HpkePrivateKeyManager.");
+}
+
+StatusOr<std::unique_ptr<MessageLite>> HpkePublicKeyFactory::NewKey(
+    absl::string_view serialized_key_format) const {
+  return util::Status(util::error::UNIMPLEMENTED,
+                      "Operation not supported for public keys, "
+                      "please use HpkePrivateKeyManager.");
+}
+
+StatusOr<std::unique_ptr<KeyData>> HpkePublicKeyFactory::NewKeyData(
+    absl::string_view serialized_key_format) const {
+  return util::Status(util::error::UNIMPLEMENTED,
+                      "Operation not supported for public keys, "
+                      "please use HpkePrivateKeyManager.");
+}
+
+constexpr char HpkePublicKeyManager::kKeyTypePrefix[];
+constexpr char HpkePublicKeyManager::kKeyType[];
+constexpr uint32_t HpkePublicKeyManager::kVersion;
+
+HpkePublicKeyManager::HpkePublicKeyManager()
+    : key_type_(kKeyType), key_factory_(new HpkePublicKeyFactory()) {
+}
+
+const KeyFactory& HpkePublicKeyManager::get_key_factory() const {
+  return *key_factory_;
+}
+
+const std::string& HpkePublicKeyManager::get_key_type() const {
+  return key_type_;
+}
+
+uint32_t HpkePublicKeyManager::get_version() const {
+  return kVersion;
+}
+
+StatusOr<std::unique_ptr<HybridEncrypt>>
+HpkePublicKeyManager::GetPrimitive(const KeyData& key_data) const {
+  if (DoesSupport(key_data.type_url())) {
+    HpkePublicKey hpke_public_key;
+    if (!hpke_public_key.ParseFromString(key_data.value())) {
+      return ToStatusF(util::error::INVALID_ARGUMENT,
+                       "Could not parse key_data.value as key type '%s'.",
+                       key_data.type_url().c_str());
+    }
+    return GetPrimitiveImpl(hpke_public_key);
+  } else {
+    return ToStatusF(util::error::INVALID_ARGUMENT,
+                     "Key type '%s' is not supported by this manager.",
+                     key_data.type_url().c_str());
+  }
+}
+
+StatusOr<std::unique_ptr<HybridEncrypt>>
+HpkePublicKeyManager::GetPrimitive(const MessageLite& key) const {
+  std::string key_type = std::string(kKeyTypePrefix) + key.GetTypeName();
+  if (DoesSupport(key_type)) {
+    const HpkePublicKey& hpke_public_key =
+        reinterpret_cast<const HpkePublicKey&>(key);
+    return GetPrimitiveImpl(hpke_public_key);
+  } else {
+    return ToStatusF(util::error::INVALID_ARGUMENT,
+                     "Key type '%s' is not supported by this manager.",
+                     key_type.c_str());
+  }
+}
+
+StatusOr<std::unique_ptr<HybridEncrypt>>
+HpkePublicKeyManager::GetPrimitiveImpl(
+    const HpkePublicKey& recipient_key) const {
+  Status status = Validate(recipient_key);
+  if (!status.ok()) return status;
+  auto hpke_result = HpkeHybridEncrypt::New(recipient_key);
+  if (!hpke_result.ok()) return hpke_result.status();
+  return std::move(hpke_result.ValueOrDie());
+}
+
+// static
+Status HpkePublicKeyManager::Validate(
+    const HpkeParams& params) {
+  if (params.kem() != HpkeKem::DHKEM_X25519_HKDF_SHA256) {
+    return Status(util::error::INVALID_ARGUMENT, "Unsupported HPKE KEM.");
+  }
+  if (params.kdf() != HpkeKdf::HKDF_SHA256) {
+    return Status(util::error::INVALID_ARGUMENT, "Unsupported HPKE KDF.");
+  }
+  if (params.aead() == HpkeAead::AEAD_UNKNOWN) {
+    return Status(util::error::INVALID_ARGUMENT, "Unsupported HPKE AEAD.");
+  }
+  return Status::OK;
+}
+
+// static
+Status HpkePublicKeyManager::Validate(
+    const HpkePublicKey& key) {
+  Status status = ValidateVersion(key.version(), kVersion);
+  if (!status.ok()) return status;
+  if (!key.has_params()) {
+    return Status(util::error::INVALID_ARGUMENT, "Missing params.");
+  }
+  if (key.public_key().size() != X25519_PUBLIC_VALUE_LEN) {
+    return Status(util::error::INVALID_ARGUMENT, "Invalid public_key size.");
+  }
+  return Validate(key.params());
+}
+
+// static
+Status HpkePublicKeyManager::Validate(
+    const HpkeKeyFormat& key_format) {
+  if (!key_format.has_params()) {
+    return Status(util::error::INVALID_ARGUMENT, "Missing params.");
+  }
+  return Validate(key_format.params());
+}
+
+}  // namespace tink
+}  // namespace crypto
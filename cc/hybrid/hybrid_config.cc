@@ -41,6 +41,14 @@ google::crypto::tink::RegistryConfig* GenerateRegistryConfig() {
       HybridConfig::kHybridEncryptCatalogueName,
       HybridConfig::kHybridEncryptPrimitiveName,
       "EciesAeadHkdfPublicKey", 0, true));
+  config->add_entry()->MergeFrom(*Config::GetTinkKeyTypeEntry(
+      HybridConfig::kHybridDecryptCatalogueName,
+      HybridConfig::kHybridDecryptPrimitiveName,
+      "HpkePrivateKey", 0, true));
+  config->add_entry()->MergeFrom(*Config::GetTinkKeyTypeEntry(
+      HybridConfig::kHybridEncryptCatalogueName,
+      HybridConfig::kHybridEncryptPrimitiveName,
+      "HpkePublicKey", 0, true));
   config->set_config_name("TINK_HYBRID");
   return config;
 }
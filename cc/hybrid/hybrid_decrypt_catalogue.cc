@@ -19,6 +19,7 @@
 #include "absl/strings/ascii.h"
 #include "tink/catalogue.h"
 #include "tink/hybrid/ecies_aead_hkdf_private_key_manager.h"
+#include "tink/hybrid/hpke_private_key_manager.h"
 #include "tink/key_manager.h"
 #include "tink/util/status.h"
 #include "tink/util/statusor.h"
@@ -35,6 +36,11 @@ CreateKeyManager(const std::string& type_url) {
         new EciesAeadHkdfPrivateKeyManager());
     return std::move(manager);
   }
+  if (type_url == HpkePrivateKeyManager::kKeyType) {
+    std::unique_ptr<KeyManager<HybridDecrypt>> manager(
+        new HpkePrivateKeyManager());
+    return std::move(manager);
+  }
   return ToStatusF(crypto::tink::util::error::NOT_FOUND,
                    "No key manager for type_url '%s'.", type_url.c_str());
 }
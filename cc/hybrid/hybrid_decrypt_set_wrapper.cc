@@ -18,6 +18,7 @@
 
 #include "tink/crypto_format.h"
 #include "tink/hybrid_decrypt.h"
+#include "tink/output_buffer.h"
 #include "tink/primitive_set.h"
 #include "tink/subtle/subtle_util_boringssl.h"
 #include "tink/util/status.h"
@@ -94,5 +95,45 @@ util::StatusOr<std::string> HybridDecryptSetWrapper::Decrypt(
   return util::Status(util::error::INVALID_ARGUMENT, "decryption failed");
 }
 
+util::Status HybridDecryptSetWrapper::DecryptInto(
+    absl::string_view ciphertext,
+    absl::string_view context_info,
+    OutputBuffer* plaintext) const {
+  context_info = subtle::SubtleUtilBoringSSL::EnsureNonNull(context_info);
+
+  if (ciphertext.length() > CryptoFormat::kNonRawPrefixSize) {
+    auto primitives_result = hybrid_decrypt_set_->get_primitives(std::string(
+        ciphertext.substr(0, CryptoFormat::kNonRawPrefixSize)));
+    if (primitives_result.ok()) {
+      absl::string_view raw_ciphertext =
+          ciphertext.substr(CryptoFormat::kNonRawPrefixSize);
+      for (auto& hybrid_decrypt_entry : *(primitives_result.ValueOrDie())) {
+        HybridDecrypt& hybrid_decrypt = hybrid_decrypt_entry->get_primitive();
+        util::Status status =
+            hybrid_decrypt.DecryptInto(raw_ciphertext, context_info, plaintext);
+        if (status.ok() ||
+            status.error_code() == util::error::RESOURCE_EXHAUSTED) {
+          return status;
+        }
+      }
+    }
+  }
+
+  // No matching key succeeded with decryption, try all RAW keys.
+  auto raw_primitives_result = hybrid_decrypt_set_->get_raw_primitives();
+  if (raw_primitives_result.ok()) {
+    for (auto& hybrid_decrypt_entry : *(raw_primitives_result.ValueOrDie())) {
+      HybridDecrypt& hybrid_decrypt = hybrid_decrypt_entry->get_primitive();
+      util::Status status =
+          hybrid_decrypt.DecryptInto(ciphertext, context_info, plaintext);
+      if (status.ok() ||
+          status.error_code() == util::error::RESOURCE_EXHAUSTED) {
+        return status;
+      }
+    }
+  }
+  return util::Status(util::error::INVALID_ARGUMENT, "decryption failed");
+}
+
 }  // namespace tink
 }  // namespace crypto
@@ -19,7 +19,9 @@
 
 #include "absl/strings/string_view.h"
 #include "tink/hybrid_decrypt.h"
+#include "tink/output_buffer.h"
 #include "tink/primitive_set.h"
+#include "tink/util/status.h"
 #include "tink/util/statusor.h"
 #include "proto/tink.pb.h"
 
@@ -29,6 +31,8 @@ namespace tink {
 // Wraps a set of HybridDecrypt-instances that correspond to a keyset,
 // and combines them into a single HybridDecrypt-primitive, that for
 // actual decryption uses the instance that matches the ciphertext prefix.
+// DecryptInto(...) fails with RESOURCE_EXHAUSTED as soon as an instance
+// finds the output buffer too small, without trying the remaining instances.
 class HybridDecryptSetWrapper : public HybridDecrypt {
  public:
   // Returns an HybridDecrypt-primitive that uses HybridDecrypt-instances
@@ -41,6 +45,11 @@ class HybridDecryptSetWrapper : public HybridDecrypt {
       absl::string_view ciphertext,
       absl::string_view context_info) const override;
 
+  crypto::tink::util::Status DecryptInto(
+      absl::string_view ciphertext,
+      absl::string_view context_info,
+      OutputBuffer* plaintext) const override;
+
   virtual ~HybridDecryptSetWrapper() {}
 
  private:
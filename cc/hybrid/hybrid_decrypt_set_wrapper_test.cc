@@ -16,6 +16,7 @@
 
 #include "tink/hybrid/hybrid_decrypt_set_wrapper.h"
 #include "tink/hybrid_decrypt.h"
+#include "tink/output_buffer.h"
 #include "tink/primitive_set.h"
 #include "tink/util/status.h"
 #include "tink/util/test_util.h"
@@ -146,6 +147,59 @@ TEST_F(HybridDecryptSetWrapperTest, testBasic) {
   }
 }
 
+TEST_F(HybridDecryptSetWrapperTest, testDecryptIntoBufferTooSmall) {
+  Keyset keyset;
+  Keyset::Key* key = keyset.add_key();
+  key->set_output_prefix_type(OutputPrefixType::TINK);
+  key->set_key_id(726329);
+  key = keyset.add_key();
+  key->set_output_prefix_type(OutputPrefixType::RAW);
+  key->set_key_id(1234543);
+
+  std::unique_ptr<PrimitiveSet<HybridDecrypt>> hybrid_decrypt_set(
+      new PrimitiveSet<HybridDecrypt>());
+  std::unique_ptr<HybridDecrypt> hybrid_decrypt(
+      new DummyHybridDecrypt("hybrid_0"));
+  auto entry_result = hybrid_decrypt_set->AddPrimitive(
+      std::move(hybrid_decrypt), keyset.key(0));
+  ASSERT_TRUE(entry_result.ok());
+  std::string prefix_id_0 = entry_result.ValueOrDie()->get_identifier();
+  hybrid_decrypt_set->set_primary(entry_result.ValueOrDie());
+  hybrid_decrypt.reset(new DummyHybridDecrypt("hybrid_1"));
+  entry_result = hybrid_decrypt_set->AddPrimitive(
+      std::move(hybrid_decrypt), keyset.key(1));
+  ASSERT_TRUE(entry_result.ok());
+  auto hybrid_decrypt_result = HybridDecryptSetWrapper::NewHybridDecrypt(
+      std::move(hybrid_decrypt_set));
+  ASSERT_TRUE(hybrid_decrypt_result.ok()) << hybrid_decrypt_result.status();
+  hybrid_decrypt = std::move(hybrid_decrypt_result.ValueOrDie());
+
+  std::string plaintext = "some_plaintext";
+  std::string context_info = "some_context";
+  char data[64];
+
+  {  // Prefixed key.
+    std::string ciphertext = prefix_id_0 + plaintext + "hybrid_0";
+    FixedOutputBuffer small_output(data, plaintext.size() - 1);
+    auto status =
+        hybrid_decrypt->DecryptInto(ciphertext, context_info, &small_output);
+    EXPECT_EQ(util::error::RESOURCE_EXHAUSTED, status.error_code()) << status;
+
+    FixedOutputBuffer output(data, plaintext.size());
+    status = hybrid_decrypt->DecryptInto(ciphertext, context_info, &output);
+    EXPECT_TRUE(status.ok()) << status;
+    EXPECT_EQ(plaintext, output.output());
+  }
+
+  {  // RAW key.
+    std::string ciphertext = plaintext + "hybrid_1";
+    FixedOutputBuffer small_output(data, plaintext.size() - 1);
+    auto status =
+        hybrid_decrypt->DecryptInto(ciphertext, context_info, &small_output);
+    EXPECT_EQ(util::error::RESOURCE_EXHAUSTED, status.error_code()) << status;
+  }
+}
+
 }  // namespace
 }  // namespace tink
 }  // namespace crypto
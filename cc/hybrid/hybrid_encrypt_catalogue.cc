@@ -19,6 +19,7 @@
 #include "absl/strings/ascii.h"
 #include "tink/catalogue.h"
 #include "tink/hybrid/ecies_aead_hkdf_public_key_manager.h"
+#include "tink/hybrid/hpke_public_key_manager.h"
 #include "tink/key_manager.h"
 #include "tink/util/status.h"
 #include "tink/util/statusor.h"
@@ -35,6 +36,11 @@ CreateKeyManager(const std::string& type_url) {
         new EciesAeadHkdfPublicKeyManager());
     return std::move(manager);
   }
+  if (type_url == HpkePublicKeyManager::kKeyType) {
+    std::unique_ptr<KeyManager<HybridEncrypt>> manager(
+        new HpkePublicKeyManager());
+    return std::move(manager);
+  }
   return ToStatusF(crypto::tink::util::error::NOT_FOUND,
                    "No key manager for type_url '%s'.", type_url.c_str());
 }
@@ -19,9 +19,11 @@
 #include "gtest/gtest.h"
 #include "tink/config.h"
 #include "tink/crypto_format.h"
+#include "tink/hybrid/ecies_aead_hkdf_public_key_manager.h"
 #include "tink/hybrid/hybrid_config.h"
 #include "tink/hybrid_encrypt.h"
 #include "tink/keyset_handle.h"
+#include "tink/subtle/ec_ephemeral_key_pool.h"
 #include "tink/util/keyset_util.h"
 #include "tink/util/status.h"
 #include "tink/util/test_util.h"
@@ -49,10 +51,10 @@ namespace {
 class HybridEncryptFactoryTest : public ::testing::Test {
 };
 
-EciesAeadHkdfPublicKey GetNewEciesPublicKey() {
+EciesAeadHkdfPublicKey GetNewEciesPublicKey(
+    EllipticCurveType curve = EllipticCurveType::NIST_P256) {
   auto ecies_key = test::GetEciesAesGcmHkdfTestKey(
-      EllipticCurveType::NIST_P256, EcPointFormat::UNCOMPRESSED,
-      HashType::SHA256, 32);
+      curve, EcPointFormat::UNCOMPRESSED, HashType::SHA256, 32);
   return ecies_key.public_key();
 }
 
@@ -105,6 +107,53 @@ TEST_F(HybridEncryptFactoryTest, testPrimitive) {
   EXPECT_TRUE(encrypt_result.ok()) << encrypt_result.status();
 }
 
+TEST_F(HybridEncryptFactoryTest, testPrimitiveWithEphemeralKeyPool) {
+  ASSERT_TRUE(HybridConfig::Register().ok());
+  std::string key_type =
+      "type.googleapis.com/google.crypto.tink.EciesAeadHkdfPublicKey";
+  std::shared_ptr<subtle::EcEphemeralKeyPool> pool(std::move(
+      subtle::EcEphemeralKeyPool::NewWithoutRefill(
+          subtle::EllipticCurveType::NIST_P256, 2).ValueOrDie()));
+  ASSERT_TRUE(pool->Fill().ok());
+  EciesAeadHkdfPublicKeyManager key_manager(pool);
+  std::string plaintext = "some plaintext";
+  std::string context_info = "some context info";
+
+  {  // A key on the curve of the pool takes its key pairs from the pool.
+    Keyset keyset;
+    AddTinkKey(key_type, 1234543, GetNewEciesPublicKey(),
+               KeyStatusType::ENABLED, KeyData::ASYMMETRIC_PUBLIC, &keyset);
+    keyset.set_primary_key_id(1234543);
+    auto hybrid_encrypt_result = HybridEncryptFactory::GetPrimitive(
+        *KeysetUtil::GetKeysetHandle(keyset), &key_manager);
+    ASSERT_TRUE(hybrid_encrypt_result.ok()) << hybrid_encrypt_result.status();
+    auto hybrid_encrypt = std::move(hybrid_encrypt_result.ValueOrDie());
+    for (int i = 0; i < 3; i++) {
+      auto encrypt_result = hybrid_encrypt->Encrypt(plaintext, context_info);
+      EXPECT_TRUE(encrypt_result.ok()) << encrypt_result.status();
+    }
+    EXPECT_EQ(0u, pool->size());
+    EXPECT_EQ(1u, pool->misses());
+  }
+
+  {  // A key on another curve does not use the pool.
+    ASSERT_TRUE(pool->Fill().ok());
+    Keyset keyset;
+    AddTinkKey(key_type, 726329,
+               GetNewEciesPublicKey(EllipticCurveType::NIST_P384),
+               KeyStatusType::ENABLED, KeyData::ASYMMETRIC_PUBLIC, &keyset);
+    keyset.set_primary_key_id(726329);
+    auto hybrid_encrypt_result = HybridEncryptFactory::GetPrimitive(
+        *KeysetUtil::GetKeysetHandle(keyset), &key_manager);
+    ASSERT_TRUE(hybrid_encrypt_result.ok()) << hybrid_encrypt_result.status();
+    auto encrypt_result =
+        hybrid_encrypt_result.ValueOrDie()->Encrypt(plaintext, context_info);
+    EXPECT_TRUE(encrypt_result.ok()) << encrypt_result.status();
+    EXPECT_EQ(2u, pool->size());
+    EXPECT_EQ(1u, pool->misses());
+  }
+}
+
 }  // namespace
 }  // namespace tink
 }  // namespace crypto
@@ -18,6 +18,7 @@
 
 #include "tink/crypto_format.h"
 #include "tink/hybrid_encrypt.h"
+#include "tink/output_buffer.h"
 #include "tink/primitive_set.h"
 #include "tink/subtle/subtle_util_boringssl.h"
 #include "tink/util/status.h"
@@ -69,5 +70,19 @@ util::StatusOr<std::string> HybridEncryptSetWrapper::Encrypt(
   return key_id + encrypt_result.ValueOrDie();
 }
 
+util::Status HybridEncryptSetWrapper::EncryptInto(
+    absl::string_view plaintext,
+    absl::string_view context_info,
+    OutputBuffer* ciphertext) const {
+  plaintext = subtle::SubtleUtilBoringSSL::EnsureNonNull(plaintext);
+  context_info = subtle::SubtleUtilBoringSSL::EnsureNonNull(context_info);
+
+  auto primary = hybrid_encrypt_set_->get_primary();
+  // The primitive writes its ciphertext right after the key prefix.
+  PrefixedOutputBuffer output(primary->get_identifier(), ciphertext);
+  return primary->get_primitive().EncryptInto(plaintext, context_info,
+                                              &output);
+}
+
 }  // namespace tink
 }  // namespace crypto
@@ -19,7 +19,9 @@
 
 #include "absl/strings/string_view.h"
 #include "tink/hybrid_encrypt.h"
+#include "tink/output_buffer.h"
 #include "tink/primitive_set.h"
+#include "tink/util/status.h"
 #include "tink/util/statusor.h"
 #include "proto/tink.pb.h"
 
@@ -42,6 +44,11 @@ class HybridEncryptSetWrapper : public HybridEncrypt {
       absl::string_view plaintext,
       absl::string_view context_info) const override;
 
+  crypto::tink::util::Status EncryptInto(
+      absl::string_view plaintext,
+      absl::string_view context_info,
+      OutputBuffer* ciphertext) const override;
+
   virtual ~HybridEncryptSetWrapper() {}
 
  private:
@@ -20,6 +20,7 @@
 #include "tink/aead/aead_key_templates.h"
 #include "proto/ecies_aead_hkdf.pb.h"
 #include "proto/common.pb.h"
+#include "proto/hpke.pb.h"
 #include "proto/tink.pb.h"
 
 namespace crypto {
@@ -30,6 +31,10 @@ using google::crypto::tink::EciesAeadHkdfKeyFormat;
 using google::crypto::tink::EcPointFormat;
 using google::crypto::tink::EllipticCurveType;
 using google::crypto::tink::HashType;
+using google::crypto::tink::HpkeAead;
+using google::crypto::tink::HpkeKdf;
+using google::crypto::tink::HpkeKem;
+using google::crypto::tink::HpkeKeyFormat;
 using google::crypto::tink::KeyTemplate;
 using google::crypto::tink::OutputPrefixType;
 
@@ -55,6 +60,19 @@ KeyTemplate* NewEciesAeadHkdfKeyTemplate(
   return key_template;
 }
 
+KeyTemplate* NewHpkeKeyTemplate(HpkeAead aead) {
+  KeyTemplate* key_template = new KeyTemplate;
+  key_template->set_type_url(
+      "type.googleapis.com/google.crypto.tink.HpkePrivateKey");
+  key_template->set_output_prefix_type(OutputPrefixType::TINK);
+  HpkeKeyFormat key_format;
+  key_format.mutable_params()->set_kem(HpkeKem::DHKEM_X25519_HKDF_SHA256);
+  key_format.mutable_params()->set_kdf(HpkeKdf::HKDF_SHA256);
+  key_format.mutable_params()->set_aead(aead);
+  key_format.SerializeToString(key_template->mutable_value());
+  return key_template;
+}
+
 }  // anonymous namespace
 
 // static
@@ -80,6 +98,27 @@ HybridKeyTemplates::EciesP256HkdfHmacSha256Aes128CtrHmacSha256() {
   return *key_template;
 }
 
+// static
+const KeyTemplate& HybridKeyTemplates::HpkeX25519HkdfSha256Aes128Gcm() {
+  static const KeyTemplate* key_template =
+      NewHpkeKeyTemplate(HpkeAead::AES_128_GCM);
+  return *key_template;
+}
+
+// static
+const KeyTemplate& HybridKeyTemplates::HpkeX25519HkdfSha256Aes256Gcm() {
+  static const KeyTemplate* key_template =
+      NewHpkeKeyTemplate(HpkeAead::AES_256_GCM);
+  return *key_template;
+}
+
+// static
+const KeyTemplate&
+HybridKeyTemplates::HpkeX25519HkdfSha256ChaCha20Poly1305() {
+  static const KeyTemplate* key_template =
+      NewHpkeKeyTemplate(HpkeAead::CHACHA20_POLY1305);
+  return *key_template;
+}
 
 }  // namespace tink
 }  // namespace crypto
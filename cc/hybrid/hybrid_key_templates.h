@@ -57,6 +57,33 @@ class HybridKeyTemplates {
   //   - OutputPrefixType: TINK
   static const google::crypto::tink::KeyTemplate&
   EciesP256HkdfHmacSha256Aes128CtrHmacSha256();
+
+  // Returns a KeyTemplate that generates new instances of HpkePrivateKey
+  // with the following parameters:
+  //   - KEM: DHKEM(X25519, HKDF-SHA256)
+  //   - KDF: HKDF-SHA256
+  //   - AEAD: AES128-GCM
+  //   - OutputPrefixType: TINK
+  static const google::crypto::tink::KeyTemplate&
+  HpkeX25519HkdfSha256Aes128Gcm();
+
+  // Returns a KeyTemplate that generates new instances of HpkePrivateKey
+  // with the following parameters:
+  //   - KEM: DHKEM(X25519, HKDF-SHA256)
+  //   - KDF: HKDF-SHA256
+  //   - AEAD: AES256-GCM
+  //   - OutputPrefixType: TINK
+  static const google::crypto::tink::KeyTemplate&
+  HpkeX25519HkdfSha256Aes256Gcm();
+
+  // Returns a KeyTemplate that generates new instances of HpkePrivateKey
+  // with the following parameters:
+  //   - KEM: DHKEM(X25519, HKDF-SHA256)
+  //   - KDF: HKDF-SHA256
+  //   - AEAD: ChaCha20-Poly1305
+  //   - OutputPrefixType: TINK
+  static const google::crypto::tink::KeyTemplate&
+  HpkeX25519HkdfSha256ChaCha20Poly1305();
 };
 
 }  // namespace tink
@@ -16,11 +16,16 @@
 
 #include "tink/hybrid/hybrid_key_templates.h"
 
+#include <utility>
+#include <vector>
+
 #include "tink/aead/aead_key_templates.h"
 #include "tink/hybrid/ecies_aead_hkdf_private_key_manager.h"
+#include "tink/hybrid/hpke_private_key_manager.h"
 #include "tink/hybrid/hybrid_config.h"
 #include "proto/common.pb.h"
 #include "proto/ecies_aead_hkdf.pb.h"
+#include "proto/hpke.pb.h"
 #include "proto/tink.pb.h"
 #include "gtest/gtest.h"
 
@@ -32,6 +37,10 @@ using google::crypto::tink::EciesAeadHkdfKeyFormat;
 using google::crypto::tink::EcPointFormat;
 using google::crypto::tink::EllipticCurveType;
 using google::crypto::tink::HashType;
+using google::crypto::tink::HpkeAead;
+using google::crypto::tink::HpkeKdf;
+using google::crypto::tink::HpkeKem;
+using google::crypto::tink::HpkeKeyFormat;
 using google::crypto::tink::KeyTemplate;
 using google::crypto::tink::OutputPrefixType;
 
@@ -118,6 +127,40 @@ TEST_F(HybridKeyTemplatesTest, testEciesAeadHkdf) {
   }
 }
 
+TEST_F(HybridKeyTemplatesTest, testHpke) {
+  std::string type_url =
+      "type.googleapis.com/google.crypto.tink.HpkePrivateKey";
+  std::vector<std::pair<const KeyTemplate*, HpkeAead>> templates = {
+      {&HybridKeyTemplates::HpkeX25519HkdfSha256Aes128Gcm(),
+       HpkeAead::AES_128_GCM},
+      {&HybridKeyTemplates::HpkeX25519HkdfSha256Aes256Gcm(),
+       HpkeAead::AES_256_GCM},
+      {&HybridKeyTemplates::HpkeX25519HkdfSha256ChaCha20Poly1305(),
+       HpkeAead::CHACHA20_POLY1305}};
+
+  for (const auto& entry : templates) {
+    // Check that returned template is correct.
+    const KeyTemplate& key_template = *entry.first;
+    EXPECT_EQ(type_url, key_template.type_url());
+    EXPECT_EQ(OutputPrefixType::TINK, key_template.output_prefix_type());
+    HpkeKeyFormat key_format;
+    EXPECT_TRUE(key_format.ParseFromString(key_template.value()));
+    EXPECT_EQ(HpkeKem::DHKEM_X25519_HKDF_SHA256, key_format.params().kem());
+    EXPECT_EQ(HpkeKdf::HKDF_SHA256, key_format.params().kdf());
+    EXPECT_EQ(entry.second, key_format.params().aead());
+
+    // Check that the template works with the key manager.
+    HpkePrivateKeyManager key_manager;
+    EXPECT_EQ(key_manager.get_key_type(), key_template.type_url());
+    auto new_key_result = key_manager.get_key_factory().NewKey(key_format);
+    EXPECT_TRUE(new_key_result.ok()) << new_key_result.status();
+  }
+
+  // Check that reference to the same object is returned.
+  EXPECT_EQ(&HybridKeyTemplates::HpkeX25519HkdfSha256Aes128Gcm(),
+            &HybridKeyTemplates::HpkeX25519HkdfSha256Aes128Gcm());
+}
+
 }  // namespace
 }  // namespace tink
 }  // namespace crypto
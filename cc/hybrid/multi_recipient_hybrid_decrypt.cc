@@ -0,0 +1,168 @@
+// Copyright 2018 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/hybrid/multi_recipient_hybrid_decrypt.h"
+
+#include <string.h>
+
+#include <algorithm>
+
+#include "tink/aead.h"
+#include "tink/crypto_format.h"
+#include "tink/hybrid_decrypt.h"
+#include "tink/registry.h"
+#include "tink/hybrid/multi_recipient_hybrid_encrypt.h"
+#include "tink/subtle/aes_gcm_boringssl.h"
+#include "tink/subtle/subtle_util_boringssl.h"
+#include "tink/util/keyset_util.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "proto/tink.pb.h"
+
+using google::crypto::tink::Keyset;
+using google::crypto::tink::KeyStatusType;
+using google::crypto::tink::OutputPrefixType;
+using crypto::tink::util::Status;
+using crypto::tink::util::StatusOr;
+
+namespace crypto {
+namespace tink {
+
+namespace {
+
+const uint8_t kVersion = MultiRecipientHybridEncrypt::kVersion;
+const size_t kDemKeySizeInBytes =
+    MultiRecipientHybridEncrypt::kDemKeySizeInBytes;
+const size_t kSlotSizeInBytes = MultiRecipientHybridEncrypt::kSlotSizeInBytes;
+const size_t kHeaderSizeInBytes =
+    MultiRecipientHybridEncrypt::kHeaderSizeInBytes;
+const size_t kPrefixSize = CryptoFormat::kNonRawPrefixSize;
+
+uint32_t LoadBigEndian32(const char* p) {
+  const uint8_t* b = reinterpret_cast<const uint8_t*>(p);
+  return (static_cast<uint32_t>(b[0]) << 24) |
+         (static_cast<uint32_t>(b[1]) << 16) |
+         (static_cast<uint32_t>(b[2]) << 8) | static_cast<uint32_t>(b[3]);
+}
+
+}  // anonymous namespace
+
+// static
+StatusOr<std::unique_ptr<HybridDecrypt>> MultiRecipientHybridDecrypt::New(
+    const KeysetHandle& keyset_handle) {
+  auto primitives_result =
+      Registry::GetPrimitives<HybridDecrypt>(keyset_handle, nullptr);
+  if (!primitives_result.ok()) return primitives_result.status();
+  std::vector<std::string> key_prefixes;
+  const Keyset& keyset = KeysetUtil::GetKeyset(keyset_handle);
+  for (const Keyset::Key& key : keyset.key()) {
+    if (key.status() != KeyStatusType::ENABLED ||
+        key.output_prefix_type() == OutputPrefixType::RAW) {
+      continue;
+    }
+    auto prefix_result = CryptoFormat::get_output_prefix(key);
+    if (!prefix_result.ok()) return prefix_result.status();
+    key_prefixes.push_back(prefix_result.ValueOrDie());
+  }
+  if (key_prefixes.empty()) {
+    return Status(util::error::INVALID_ARGUMENT,
+                  "keyset has no enabled key with a non-RAW output prefix");
+  }
+  std::sort(key_prefixes.begin(), key_prefixes.end());
+  key_prefixes.erase(std::unique(key_prefixes.begin(), key_prefixes.end()),
+                     key_prefixes.end());
+  std::unique_ptr<HybridDecrypt> hybrid_decrypt(new MultiRecipientHybridDecrypt(
+      std::move(primitives_result.ValueOrDie()), std::move(key_prefixes)));
+  return std::move(hybrid_decrypt);
+}
+
+StatusOr<std::string> MultiRecipientHybridDecrypt::Decrypt(
+    absl::string_view ciphertext,
+    absl::string_view context_info) const {
+  // BoringSSL expects a non-null pointer for context_info,
+  // regardless of whether the size is 0.
+  context_info = subtle::SubtleUtilBoringSSL::EnsureNonNull(context_info);
+
+  if (ciphertext.size() < kHeaderSizeInBytes ||
+      static_cast<uint8_t>(ciphertext[0]) != kVersion) {
+    return Status(util::error::INVALID_ARGUMENT, "invalid ciphertext header");
+  }
+  size_t recipient_count = (static_cast<uint8_t>(ciphertext[1]) << 8) |
+                           static_cast<uint8_t>(ciphertext[2]);
+  size_t table_end = kHeaderSizeInBytes + kSlotSizeInBytes * recipient_count;
+  if (recipient_count == 0 || ciphertext.size() < table_end) {
+    return Status(util::error::INVALID_ARGUMENT, "invalid slot table");
+  }
+  const char* table = ciphertext.data() + kHeaderSizeInBytes;
+  auto wrapped_key_end = [table](size_t slot) -> size_t {
+    return LoadBigEndian32(table + slot * kSlotSizeInBytes + kPrefixSize);
+  };
+  size_t dem_start = table_end + wrapped_key_end(recipient_count - 1);
+  if (dem_start > ciphertext.size()) {
+    return Status(util::error::INVALID_ARGUMENT, "invalid slot table");
+  }
+  absl::string_view header = ciphertext.substr(0, dem_start);
+  absl::string_view dem_ciphertext = ciphertext.substr(dem_start);
+
+  for (const std::string& key_prefix : key_prefixes_) {
+    // Binary search for the slot of 'key_prefix'.
+    size_t lo = 0;
+    size_t hi = recipient_count;
+    while (lo < hi) {
+      size_t mid = lo + (hi - lo) / 2;
+      if (memcmp(table + mid * kSlotSizeInBytes, key_prefix.data(),
+                 kPrefixSize) < 0) {
+        lo = mid + 1;
+      } else {
+        hi = mid;
+      }
+    }
+    if (lo == recipient_count ||
+        memcmp(table + lo * kSlotSizeInBytes, key_prefix.data(),
+               kPrefixSize) != 0) {
+      continue;
+    }
+    size_t begin = lo == 0 ? 0 : wrapped_key_end(lo - 1);
+    size_t end = wrapped_key_end(lo);
+    if (begin > end || table_end + end > dem_start) {
+      return Status(util::error::INVALID_ARGUMENT, "invalid slot table");
+    }
+    absl::string_view wrapped_key =
+        ciphertext.substr(table_end + begin, end - begin);
+
+    auto primitives_result = hybrid_decrypt_set_->get_primitives(key_prefix);
+    if (!primitives_result.ok()) continue;
+    for (auto& hybrid_decrypt_entry : *(primitives_result.ValueOrDie())) {
+      auto unwrap_result = hybrid_decrypt_entry->get_primitive().Decrypt(
+          wrapped_key, context_info);
+      if (!unwrap_result.ok()) {
+        // LOG that a matching key didn't decrypt the slot.
+        continue;
+      }
+      const std::string& dem_key = unwrap_result.ValueOrDie();
+      if (dem_key.size() != kDemKeySizeInBytes) {
+        return Status(util::error::INVALID_ARGUMENT, "invalid DEM key size");
+      }
+      auto dem_result = subtle::AesGcmBoringSsl::New(dem_key);
+      if (!dem_result.ok()) return dem_result.status();
+      return dem_result.ValueOrDie()->Decrypt(dem_ciphertext, header);
+    }
+  }
+  return Status(util::error::INVALID_ARGUMENT, "decryption failed");
+}
+
+}  // namespace tink
+}  // namespace crypto
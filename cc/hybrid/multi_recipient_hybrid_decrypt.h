@@ -0,0 +1,66 @@
+// Copyright 2018 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_HYBRID_MULTI_RECIPIENT_HYBRID_DECRYPT_H_
+#define TINK_HYBRID_MULTI_RECIPIENT_HYBRID_DECRYPT_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/strings/string_view.h"
+#include "tink/hybrid_decrypt.h"
+#include "tink/keyset_handle.h"
+#include "tink/primitive_set.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+
+// Decrypts ciphertexts produced by MultiRecipientHybridEncrypt (see there
+// for the format). For each enabled non-RAW key of the private keyset, the
+// recipient slot is located with a binary search over the slot table, so
+// the cost of decryption does not grow with the number of recipients
+// beyond reading the ciphertext.
+class MultiRecipientHybridDecrypt : public HybridDecrypt {
+ public:
+  // Returns an HybridDecrypt-primitive that uses the keys of the private
+  // keyset in 'keyset_handle'.
+  static crypto::tink::util::StatusOr<std::unique_ptr<HybridDecrypt>> New(
+      const KeysetHandle& keyset_handle);
+
+  crypto::tink::util::StatusOr<std::string> Decrypt(
+      absl::string_view ciphertext,
+      absl::string_view context_info) const override;
+
+  virtual ~MultiRecipientHybridDecrypt() {}
+
+ private:
+  MultiRecipientHybridDecrypt(
+      std::unique_ptr<PrimitiveSet<HybridDecrypt>> hybrid_decrypt_set,
+      std::vector<std::string> key_prefixes)
+      : hybrid_decrypt_set_(std::move(hybrid_decrypt_set)),
+        key_prefixes_(std::move(key_prefixes)) {}
+
+  std::unique_ptr<PrimitiveSet<HybridDecrypt>> hybrid_decrypt_set_;
+  // Distinct prefixes of the enabled non-RAW keys in hybrid_decrypt_set_.
+  const std::vector<std::string> key_prefixes_;
+};
+
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_HYBRID_MULTI_RECIPIENT_HYBRID_DECRYPT_H_
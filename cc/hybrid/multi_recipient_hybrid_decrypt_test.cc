@@ -0,0 +1,218 @@
+// Copyright 2018 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/hybrid/multi_recipient_hybrid_decrypt.h"
+
+#include "gtest/gtest.h"
+#include "tink/hybrid_decrypt.h"
+#include "tink/hybrid_encrypt.h"
+#include "tink/keyset_handle.h"
+#include "tink/registry.h"
+#include "tink/hybrid/hpke_private_key_manager.h"
+#include "tink/hybrid/hpke_public_key_manager.h"
+#include "tink/hybrid/multi_recipient_hybrid_encrypt.h"
+#include "tink/subtle/random.h"
+#include "tink/util/keyset_util.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "tink/util/test_util.h"
+#include "proto/hpke.pb.h"
+#include "proto/tink.pb.h"
+
+using crypto::tink::test::AddRawKey;
+using crypto::tink::test::AddTinkKey;
+using google::crypto::tink::HpkeKeyFormat;
+using google::crypto::tink::KeyData;
+using google::crypto::tink::Keyset;
+using google::crypto::tink::KeyStatusType;
+
+namespace crypto {
+namespace tink {
+namespace {
+
+class MultiRecipientHybridDecryptTest : public ::testing::Test {
+ protected:
+  static void SetUpTestCase() {
+    ASSERT_TRUE(
+        Registry::RegisterKeyManager(new HpkePrivateKeyManager()).ok());
+    ASSERT_TRUE(Registry::RegisterKeyManager(new HpkePublicKeyManager()).ok());
+  }
+
+  // Adds a fresh HPKE private key with the given id to 'keyset'.
+  static void AddHpkeKey(uint32_t key_id, Keyset* keyset) {
+    HpkeKeyFormat key_format;
+    key_format.mutable_params()->set_kem(
+        google::crypto::tink::DHKEM_X25519_HKDF_SHA256);
+    key_format.mutable_params()->set_kdf(google::crypto::tink::HKDF_SHA256);
+    key_format.mutable_params()->set_aead(google::crypto::tink::AES_128_GCM);
+    auto key_result =
+        HpkePrivateKeyManager().get_key_factory().NewKey(key_format);
+    EXPECT_TRUE(key_result.ok()) << key_result.status();
+    AddTinkKey("type.googleapis.com/google.crypto.tink.HpkePrivateKey", key_id,
+               *key_result.ValueOrDie(), KeyStatusType::ENABLED,
+               KeyData::ASYMMETRIC_PRIVATE, keyset);
+    keyset->set_primary_key_id(key_id);
+  }
+
+  static std::unique_ptr<KeysetHandle> NewPrivateKeysetHandle(
+      uint32_t key_id) {
+    Keyset keyset;
+    AddHpkeKey(key_id, &keyset);
+    return KeysetUtil::GetKeysetHandle(keyset);
+  }
+
+  static std::unique_ptr<KeysetHandle> PublicKeysetHandle(
+      KeysetHandle* private_handle) {
+    auto result = private_handle->GetPublicKeysetHandle();
+    EXPECT_TRUE(result.ok()) << result.status();
+    return std::move(result.ValueOrDie());
+  }
+};
+
+TEST_F(MultiRecipientHybridDecryptTest, testEncryptDecrypt) {
+  const int kRecipients = 50;
+  std::vector<std::unique_ptr<KeysetHandle>> private_handles;
+  std::vector<std::unique_ptr<KeysetHandle>> public_handles;
+  std::vector<const KeysetHandle*> recipients;
+  for (int i = 0; i < kRecipients; i++) {
+    private_handles.push_back(NewPrivateKeysetHandle(1000003 * (i + 1)));
+    public_handles.push_back(PublicKeysetHandle(private_handles.back().get()));
+    recipients.push_back(public_handles.back().get());
+  }
+  auto encrypt_result = MultiRecipientHybridEncrypt::New(recipients);
+  ASSERT_TRUE(encrypt_result.ok()) << encrypt_result.status();
+
+  std::string context_info = "some context info";
+  for (int plaintext_size : {0, 1, 1000, 1 << 20}) {
+    SCOPED_TRACE(plaintext_size);
+    std::string plaintext = subtle::Random::GetRandomBytes(plaintext_size);
+    auto ciphertext_result =
+        encrypt_result.ValueOrDie()->Encrypt(plaintext, context_info);
+    ASSERT_TRUE(ciphertext_result.ok()) << ciphertext_result.status();
+    std::string ciphertext = ciphertext_result.ValueOrDie();
+
+    for (const auto& private_handle : private_handles) {
+      auto decrypt_result = MultiRecipientHybridDecrypt::New(*private_handle);
+      ASSERT_TRUE(decrypt_result.ok()) << decrypt_result.status();
+      auto plaintext_result =
+          decrypt_result.ValueOrDie()->Decrypt(ciphertext, context_info);
+      ASSERT_TRUE(plaintext_result.ok()) << plaintext_result.status();
+      EXPECT_TRUE(plaintext == plaintext_result.ValueOrDie());
+      EXPECT_FALSE(
+          decrypt_result.ValueOrDie()->Decrypt(ciphertext, "other info").ok());
+    }
+
+    // A keyset that is not among the recipients cannot decrypt, even with
+    // the key id of a recipient.
+    for (uint32_t key_id : {42, 1000003}) {
+      auto other_handle = NewPrivateKeysetHandle(key_id);
+      auto decrypt_result = MultiRecipientHybridDecrypt::New(*other_handle);
+      ASSERT_TRUE(decrypt_result.ok()) << decrypt_result.status();
+      EXPECT_FALSE(
+          decrypt_result.ValueOrDie()->Decrypt(ciphertext, context_info).ok());
+    }
+  }
+}
+
+TEST_F(MultiRecipientHybridDecryptTest, testKeyRotation) {
+  Keyset keyset;
+  AddHpkeKey(1, &keyset);
+  auto old_private_handle = KeysetUtil::GetKeysetHandle(keyset);
+  auto other_private_handle = NewPrivateKeysetHandle(2);
+  auto old_public_handle = PublicKeysetHandle(old_private_handle.get());
+  auto other_public_handle = PublicKeysetHandle(other_private_handle.get());
+  auto encrypt_result = MultiRecipientHybridEncrypt::New(
+      {old_public_handle.get(), other_public_handle.get()});
+  ASSERT_TRUE(encrypt_result.ok()) << encrypt_result.status();
+  std::string ciphertext =
+      encrypt_result.ValueOrDie()->Encrypt("plaintext", "").ValueOrDie();
+
+  // After rotation to a new primary key, the old key still decrypts.
+  AddHpkeKey(3, &keyset);
+  auto new_private_handle = KeysetUtil::GetKeysetHandle(keyset);
+  auto decrypt_result = MultiRecipientHybridDecrypt::New(*new_private_handle);
+  ASSERT_TRUE(decrypt_result.ok()) << decrypt_result.status();
+  auto plaintext_result =
+      decrypt_result.ValueOrDie()->Decrypt(ciphertext, "");
+  ASSERT_TRUE(plaintext_result.ok()) << plaintext_result.status();
+  EXPECT_EQ("plaintext", plaintext_result.ValueOrDie());
+
+  // Once the old key is disabled, decryption fails.
+  keyset.mutable_key(0)->set_status(KeyStatusType::DISABLED);
+  auto disabled_handle = KeysetUtil::GetKeysetHandle(keyset);
+  auto disabled_result = MultiRecipientHybridDecrypt::New(*disabled_handle);
+  ASSERT_TRUE(disabled_result.ok()) << disabled_result.status();
+  EXPECT_FALSE(disabled_result.ValueOrDie()->Decrypt(ciphertext, "").ok());
+}
+
+TEST_F(MultiRecipientHybridDecryptTest, testModifiedCiphertext) {
+  std::vector<std::unique_ptr<KeysetHandle>> private_handles;
+  std::vector<std::unique_ptr<KeysetHandle>> public_handles;
+  std::vector<const KeysetHandle*> recipients;
+  for (uint32_t key_id : {10, 20, 30}) {
+    private_handles.push_back(NewPrivateKeysetHandle(key_id));
+    public_handles.push_back(PublicKeysetHandle(private_handles.back().get()));
+    recipients.push_back(public_handles.back().get());
+  }
+  auto encrypt_result = MultiRecipientHybridEncrypt::New(recipients);
+  ASSERT_TRUE(encrypt_result.ok()) << encrypt_result.status();
+  std::string ciphertext =
+      encrypt_result.ValueOrDie()->Encrypt("some plaintext", "info")
+          .ValueOrDie();
+  auto decrypt = std::move(
+      MultiRecipientHybridDecrypt::New(*private_handles[1]).ValueOrDie());
+  ASSERT_TRUE(decrypt->Decrypt(ciphertext, "info").ok());
+
+  // Every modified byte is detected, whether it is in the header, in
+  // another recipient's slot, or in the DEM ciphertext.
+  for (size_t position = 0; position < ciphertext.size(); position++) {
+    std::string modified = ciphertext;
+    modified[position] ^= 0x01;
+    EXPECT_FALSE(decrypt->Decrypt(modified, "info").ok()) << position;
+  }
+  for (size_t size = 0; size < ciphertext.size(); size += 7) {
+    EXPECT_FALSE(decrypt->Decrypt(ciphertext.substr(0, size), "info").ok());
+  }
+}
+
+TEST_F(MultiRecipientHybridDecryptTest, testRawKeysetIsRejected) {
+  HpkeKeyFormat key_format;
+  key_format.mutable_params()->set_kem(
+      google::crypto::tink::DHKEM_X25519_HKDF_SHA256);
+  key_format.mutable_params()->set_kdf(google::crypto::tink::HKDF_SHA256);
+  key_format.mutable_params()->set_aead(google::crypto::tink::AES_128_GCM);
+  auto key_result =
+      HpkePrivateKeyManager().get_key_factory().NewKey(key_format);
+  ASSERT_TRUE(key_result.ok()) << key_result.status();
+  Keyset keyset;
+  AddRawKey("type.googleapis.com/google.crypto.tink.HpkePrivateKey", 1,
+            *key_result.ValueOrDie(), KeyStatusType::ENABLED,
+            KeyData::ASYMMETRIC_PRIVATE, &keyset);
+  keyset.set_primary_key_id(1);
+  auto result =
+      MultiRecipientHybridDecrypt::New(*KeysetUtil::GetKeysetHandle(keyset));
+  EXPECT_FALSE(result.ok());
+  EXPECT_EQ(util::error::INVALID_ARGUMENT, result.status().error_code());
+}
+
+}  // namespace
+}  // namespace tink
+}  // namespace crypto
+
+int main(int ac, char* av[]) {
+  testing::InitGoogleTest(&ac, av);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,143 @@
+// Copyright 2018 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/hybrid/multi_recipient_hybrid_encrypt.h"
+
+#include <algorithm>
+
+#include "tink/aead.h"
+#include "tink/crypto_format.h"
+#include "tink/hybrid_encrypt.h"
+#include "tink/registry.h"
+#include "tink/subtle/aes_gcm_boringssl.h"
+#include "tink/subtle/random.h"
+#include "tink/subtle/subtle_util_boringssl.h"
+#include "tink/util/errors.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+using crypto::tink::util::Status;
+using crypto::tink::util::StatusOr;
+
+namespace crypto {
+namespace tink {
+
+namespace {
+
+void AppendBigEndian32(uint32_t value, std::string* out) {
+  out->push_back(static_cast<char>(value >> 24));
+  out->push_back(static_cast<char>(value >> 16));
+  out->push_back(static_cast<char>(value >> 8));
+  out->push_back(static_cast<char>(value));
+}
+
+}  // anonymous namespace
+
+constexpr uint8_t MultiRecipientHybridEncrypt::kVersion;
+constexpr int MultiRecipientHybridEncrypt::kDemKeySizeInBytes;
+constexpr int MultiRecipientHybridEncrypt::kMaxRecipients;
+constexpr int MultiRecipientHybridEncrypt::kSlotSizeInBytes;
+constexpr int MultiRecipientHybridEncrypt::kHeaderSizeInBytes;
+
+// static
+StatusOr<std::unique_ptr<HybridEncrypt>> MultiRecipientHybridEncrypt::New(
+    const std::vector<const KeysetHandle*>& recipient_keyset_handles) {
+  if (recipient_keyset_handles.empty()) {
+    return Status(util::error::INVALID_ARGUMENT, "no recipients given");
+  }
+  if (recipient_keyset_handles.size() > kMaxRecipients) {
+    return ToStatusF(util::error::INVALID_ARGUMENT,
+                     "too many recipients: %d, at most %d are supported",
+                     static_cast<int>(recipient_keyset_handles.size()),
+                     kMaxRecipients);
+  }
+  std::vector<Recipient> recipients;
+  recipients.reserve(recipient_keyset_handles.size());
+  for (const KeysetHandle* keyset_handle : recipient_keyset_handles) {
+    if (keyset_handle == nullptr) {
+      return Status(util::error::INVALID_ARGUMENT,
+                    "recipient keyset handles must be non-NULL");
+    }
+    auto primitives_result =
+        Registry::GetPrimitives<HybridEncrypt>(*keyset_handle, nullptr);
+    if (!primitives_result.ok()) return primitives_result.status();
+    auto recipient_set = std::move(primitives_result.ValueOrDie());
+    if (recipient_set->get_primary() == nullptr) {
+      return Status(util::error::INVALID_ARGUMENT,
+                    "recipient keyset has no primary");
+    }
+    const std::string& key_prefix =
+        recipient_set->get_primary()->get_identifier();
+    if (key_prefix.size() != CryptoFormat::kNonRawPrefixSize) {
+      return Status(util::error::INVALID_ARGUMENT,
+                    "recipient primary keys must not use RAW output prefix");
+    }
+    recipients.emplace_back(key_prefix, std::move(recipient_set));
+  }
+  std::sort(recipients.begin(), recipients.end(),
+            [](const Recipient& a, const Recipient& b) {
+              return a.first < b.first;
+            });
+  for (size_t i = 1; i < recipients.size(); i++) {
+    if (recipients[i - 1].first == recipients[i].first) {
+      return Status(util::error::INVALID_ARGUMENT,
+                    "recipient primary keys must have distinct key ids");
+    }
+  }
+  std::unique_ptr<HybridEncrypt> hybrid_encrypt(
+      new MultiRecipientHybridEncrypt(std::move(recipients)));
+  return std::move(hybrid_encrypt);
+}
+
+StatusOr<std::string> MultiRecipientHybridEncrypt::Encrypt(
+    absl::string_view plaintext,
+    absl::string_view context_info) const {
+  // BoringSSL expects a non-null pointer for plaintext and context_info,
+  // regardless of whether the size is 0.
+  plaintext = subtle::SubtleUtilBoringSSL::EnsureNonNull(plaintext);
+  context_info = subtle::SubtleUtilBoringSSL::EnsureNonNull(context_info);
+
+  std::string dem_key = subtle::Random::GetRandomBytes(kDemKeySizeInBytes);
+  auto dem_result = subtle::AesGcmBoringSsl::New(dem_key);
+  if (!dem_result.ok()) return dem_result.status();
+
+  // Wrap the DEM key for every recipient.
+  std::string header;
+  header.reserve(kHeaderSizeInBytes + kSlotSizeInBytes * recipients_.size());
+  header.push_back(static_cast<char>(kVersion));
+  header.push_back(static_cast<char>(recipients_.size() >> 8));
+  header.push_back(static_cast<char>(recipients_.size()));
+  std::string wrapped_keys;
+  for (const Recipient& recipient : recipients_) {
+    auto wrap_result =
+        recipient.second->get_primary()->get_primitive().Encrypt(
+            dem_key, context_info);
+    if (!wrap_result.ok()) return wrap_result.status();
+    wrapped_keys.append(wrap_result.ValueOrDie());
+    header.append(recipient.first);
+    AppendBigEndian32(wrapped_keys.size(), &header);
+  }
+  header.append(wrapped_keys);
+
+  // Encrypt the payload once, binding it to the slot table and wrapped keys.
+  auto encrypt_result = dem_result.ValueOrDie()->Encrypt(plaintext, header);
+  if (!encrypt_result.ok()) return encrypt_result.status();
+  header.append(encrypt_result.ValueOrDie());
+  return header;
+}
+
+}  // namespace tink
+}  // namespace crypto
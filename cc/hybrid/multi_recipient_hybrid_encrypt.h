@@ -0,0 +1,89 @@
+// Copyright 2018 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_HYBRID_MULTI_RECIPIENT_HYBRID_ENCRYPT_H_
+#define TINK_HYBRID_MULTI_RECIPIENT_HYBRID_ENCRYPT_H_
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/strings/string_view.h"
+#include "tink/hybrid_encrypt.h"
+#include "tink/keyset_handle.h"
+#include "tink/primitive_set.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+
+// Encrypts a message for several recipients at once. The plaintext is
+// encrypted only once, with AES-256-GCM under a fresh random key (the DEM
+// key), and only the 32-byte DEM key is encrypted for each recipient, with
+// the primary HybridEncrypt-instance of the recipient's public keyset
+// (ECIES-AEAD-HKDF, HPKE, ...). Encrypting 1 MB for 50 recipients thus
+// costs 1 MB of AES plus 50 key encapsulations, rather than 50 MB of AES.
+//
+// Recipients are identified by the output prefix of their primary key, so
+// each primary key must use a non-RAW OutputPrefixType (e.g. TINK), and no
+// two recipients may share a primary key prefix. The ciphertext format is
+//   version (1 byte) || recipient_count (2 bytes, big endian) ||
+//   slot_table || wrapped_keys || dem_ciphertext,
+// where slot_table holds one 9-byte entry per recipient,
+//   key_prefix (5 bytes) || wrapped_key_end (4 bytes, big endian),
+// sorted by key_prefix, so that MultiRecipientHybridDecrypt can locate its
+// slot with a binary search. The wrapped key of slot i occupies
+// [wrapped_key_end of slot i-1, wrapped_key_end of slot i) of wrapped_keys,
+// and is the output of the recipient's HybridEncrypt for the DEM key and
+// 'context_info', without the key prefix. dem_ciphertext is
+// iv || ciphertext || tag, and is computed with all preceding bytes of the
+// ciphertext as associated data.
+class MultiRecipientHybridEncrypt : public HybridEncrypt {
+ public:
+  // Returns an HybridEncrypt-primitive that encrypts for the recipients
+  // whose public keysets are given in 'recipient_keyset_handles'.
+  static crypto::tink::util::StatusOr<std::unique_ptr<HybridEncrypt>> New(
+      const std::vector<const KeysetHandle*>& recipient_keyset_handles);
+
+  crypto::tink::util::StatusOr<std::string> Encrypt(
+      absl::string_view plaintext,
+      absl::string_view context_info) const override;
+
+  virtual ~MultiRecipientHybridEncrypt() {}
+
+  static constexpr uint8_t kVersion = 1;
+  static constexpr int kDemKeySizeInBytes = 32;
+  static constexpr int kMaxRecipients = 0xffff;
+  static constexpr int kSlotSizeInBytes = 9;
+  static constexpr int kHeaderSizeInBytes = 3;
+
+ private:
+  // The primary key prefix of a recipient, and its HybridEncrypt-set.
+  typedef std::pair<std::string, std::unique_ptr<PrimitiveSet<HybridEncrypt>>>
+      Recipient;
+
+  explicit MultiRecipientHybridEncrypt(std::vector<Recipient> recipients)
+      : recipients_(std::move(recipients)) {}
+
+  // Sorted by key prefix.
+  const std::vector<Recipient> recipients_;
+};
+
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_HYBRID_MULTI_RECIPIENT_HYBRID_ENCRYPT_H_
@@ -0,0 +1,169 @@
+// Copyright 2018 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/hybrid/multi_recipient_hybrid_encrypt.h"
+
+#include <algorithm>
+
+#include "gtest/gtest.h"
+#include "tink/hybrid_encrypt.h"
+#include "tink/keyset_handle.h"
+#include "tink/registry.h"
+#include "tink/hybrid/hpke_private_key_manager.h"
+#include "tink/hybrid/hpke_public_key_manager.h"
+#include "tink/util/keyset_util.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "tink/util/test_util.h"
+#include "proto/hpke.pb.h"
+#include "proto/tink.pb.h"
+
+using crypto::tink::test::AddRawKey;
+using crypto::tink::test::AddTinkKey;
+using google::crypto::tink::HpkeKeyFormat;
+using google::crypto::tink::HpkePrivateKey;
+using google::crypto::tink::KeyData;
+using google::crypto::tink::Keyset;
+using google::crypto::tink::KeyStatusType;
+
+namespace crypto {
+namespace tink {
+namespace {
+
+class MultiRecipientHybridEncryptTest : public ::testing::Test {
+ protected:
+  static void SetUpTestCase() {
+    ASSERT_TRUE(
+        Registry::RegisterKeyManager(new HpkePrivateKeyManager()).ok());
+    ASSERT_TRUE(Registry::RegisterKeyManager(new HpkePublicKeyManager()).ok());
+  }
+
+  // Returns a handle for a public keyset with a single HPKE key.
+  std::unique_ptr<KeysetHandle> NewPublicKeysetHandle(uint32_t key_id,
+                                                      bool raw = false) {
+    HpkeKeyFormat key_format;
+    key_format.mutable_params()->set_kem(
+        google::crypto::tink::DHKEM_X25519_HKDF_SHA256);
+    key_format.mutable_params()->set_kdf(google::crypto::tink::HKDF_SHA256);
+    key_format.mutable_params()->set_aead(google::crypto::tink::AES_128_GCM);
+    auto key_result =
+        HpkePrivateKeyManager().get_key_factory().NewKey(key_format);
+    EXPECT_TRUE(key_result.ok()) << key_result.status();
+    const HpkePrivateKey& key =
+        reinterpret_cast<const HpkePrivateKey&>(*key_result.ValueOrDie());
+    Keyset keyset;
+    std::string key_type =
+        "type.googleapis.com/google.crypto.tink.HpkePublicKey";
+    if (raw) {
+      AddRawKey(key_type, key_id, key.public_key(), KeyStatusType::ENABLED,
+                KeyData::ASYMMETRIC_PUBLIC, &keyset);
+    } else {
+      AddTinkKey(key_type, key_id, key.public_key(), KeyStatusType::ENABLED,
+                 KeyData::ASYMMETRIC_PUBLIC, &keyset);
+    }
+    keyset.set_primary_key_id(key_id);
+    return KeysetUtil::GetKeysetHandle(keyset);
+  }
+};
+
+TEST_F(MultiRecipientHybridEncryptTest, testCiphertextFormat) {
+  // Key ids in non-sorted order.
+  std::vector<uint32_t> key_ids = {0x30000000, 7, 0x01020304, 0xffffffff, 42};
+  std::vector<std::unique_ptr<KeysetHandle>> handles;
+  std::vector<const KeysetHandle*> recipients;
+  for (uint32_t key_id : key_ids) {
+    handles.push_back(NewPublicKeysetHandle(key_id));
+    recipients.push_back(handles.back().get());
+  }
+  auto encrypt_result = MultiRecipientHybridEncrypt::New(recipients);
+  ASSERT_TRUE(encrypt_result.ok()) << encrypt_result.status();
+
+  std::string plaintext(1000, 'p');
+  auto ciphertext_result =
+      encrypt_result.ValueOrDie()->Encrypt(plaintext, "context");
+  ASSERT_TRUE(ciphertext_result.ok()) << ciphertext_result.status();
+  const std::string& ciphertext = ciphertext_result.ValueOrDie();
+
+  // Each HPKE-wrapped DEM key is enc (32 bytes) || DEM key (32 bytes) ||
+  // tag (16 bytes); the DEM ciphertext is iv (12) || ciphertext || tag (16).
+  size_t wrapped_key_size = 32 + 32 + 16;
+  size_t n = key_ids.size();
+  EXPECT_EQ(3 + n * (9 + wrapped_key_size) + 12 + plaintext.size() + 16,
+            ciphertext.size());
+  EXPECT_EQ(MultiRecipientHybridEncrypt::kVersion, ciphertext[0]);
+  EXPECT_EQ(0, ciphertext[1]);
+  EXPECT_EQ(n, static_cast<size_t>(ciphertext[2]));
+
+  // Slots are sorted by key prefix: TINK prefix byte, then the key id.
+  std::sort(key_ids.begin(), key_ids.end());
+  for (size_t i = 0; i < n; i++) {
+    std::string slot = ciphertext.substr(3 + 9 * i, 9);
+    EXPECT_EQ(1, slot[0]);
+    uint32_t key_id = (static_cast<uint8_t>(slot[1]) << 24) |
+                      (static_cast<uint8_t>(slot[2]) << 16) |
+                      (static_cast<uint8_t>(slot[3]) << 8) |
+                      static_cast<uint8_t>(slot[4]);
+    EXPECT_EQ(key_ids[i], key_id);
+    uint32_t wrapped_key_end = (static_cast<uint8_t>(slot[7]) << 8) |
+                               static_cast<uint8_t>(slot[8]);
+    EXPECT_EQ((i + 1) * wrapped_key_size, wrapped_key_end);
+  }
+}
+
+TEST_F(MultiRecipientHybridEncryptTest, testInvalidRecipients) {
+  {  // No recipients.
+    auto result =
+        MultiRecipientHybridEncrypt::New(std::vector<const KeysetHandle*>());
+    EXPECT_FALSE(result.ok());
+    EXPECT_EQ(util::error::INVALID_ARGUMENT, result.status().error_code());
+  }
+
+  {  // Null handle.
+    auto result = MultiRecipientHybridEncrypt::New(
+        std::vector<const KeysetHandle*>({nullptr}));
+    EXPECT_FALSE(result.ok());
+    EXPECT_EQ(util::error::INVALID_ARGUMENT, result.status().error_code());
+  }
+
+  {  // RAW primary key.
+    auto handle = NewPublicKeysetHandle(1, /* raw= */ true);
+    auto result = MultiRecipientHybridEncrypt::New({handle.get()});
+    EXPECT_FALSE(result.ok());
+    EXPECT_EQ(util::error::INVALID_ARGUMENT, result.status().error_code());
+    EXPECT_PRED_FORMAT2(testing::IsSubstring, "RAW",
+                        result.status().error_message());
+  }
+
+  {  // Two recipients with the same key id.
+    auto handle_1 = NewPublicKeysetHandle(1234);
+    auto handle_2 = NewPublicKeysetHandle(1234);
+    auto result =
+        MultiRecipientHybridEncrypt::New({handle_1.get(), handle_2.get()});
+    EXPECT_FALSE(result.ok());
+    EXPECT_EQ(util::error::INVALID_ARGUMENT, result.status().error_code());
+    EXPECT_PRED_FORMAT2(testing::IsSubstring, "distinct",
+                        result.status().error_message());
+  }
+}
+
+}  // namespace
+}  // namespace tink
+}  // namespace crypto
+
+int main(int ac, char* av[]) {
+  testing::InitGoogleTest(&ac, av);
+  return RUN_ALL_TESTS();
+}
@@ -18,6 +18,8 @@
 #define TINK_HYBRID_DECRYPT_H_
 
 #include "absl/strings/string_view.h"
+#include "tink/output_buffer.h"
+#include "tink/util/status.h"
 #include "tink/util/statusor.h"
 
 namespace crypto {
@@ -60,6 +62,15 @@ class HybridDecrypt {
       absl::string_view ciphertext,
       absl::string_view context_info) const = 0;
 
+  // Like Decrypt(), but writes the plaintext to 'plaintext' instead of
+  // returning it. If decryption fails, no unverified plaintext is left in
+  // 'plaintext'.
+  // The default implementation copies the result of Decrypt().
+  virtual crypto::tink::util::Status DecryptInto(
+      absl::string_view ciphertext,
+      absl::string_view context_info,
+      OutputBuffer* plaintext) const;
+
   virtual ~HybridDecrypt() {}
 };
 
@@ -18,6 +18,8 @@
 #define TINK_HYBRID_ENCRYPT_H_
 
 #include "absl/strings/string_view.h"
+#include "tink/output_buffer.h"
+#include "tink/util/status.h"
 #include "tink/util/statusor.h"
 
 namespace crypto {
@@ -60,6 +62,14 @@ class HybridEncrypt {
       absl::string_view plaintext,
       absl::string_view context_info) const = 0;
 
+  // Like Encrypt(), but writes the ciphertext to 'ciphertext' instead of
+  // returning it, so that the caller decides where it is stored.
+  // The default implementation copies the result of Encrypt().
+  virtual crypto::tink::util::Status EncryptInto(
+      absl::string_view plaintext,
+      absl::string_view context_info,
+      OutputBuffer* ciphertext) const;
+
   virtual ~HybridEncrypt() {}
 };
 
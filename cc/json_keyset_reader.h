@@ -21,6 +21,7 @@
 
 #include "absl/strings/string_view.h"
 #include "tink/keyset_reader.h"
+#include "tink/util/status.h"
 #include "tink/util/statusor.h"
 #include "proto/tink.pb.h"
 
@@ -44,12 +45,18 @@ class JsonKeysetReader : public KeysetReader {
     std::unique_ptr<google::crypto::tink::EncryptedKeyset>>
   ReadEncrypted() override;
 
+  crypto::tink::util::StatusOr<google::crypto::tink::Keyset*>
+  ReadOnArena(google::protobuf::Arena* arena) override;
+
  private:
   JsonKeysetReader(std::unique_ptr<std::istream> keyset_stream)
       : serialized_keyset_(""), keyset_stream_(std::move(keyset_stream)) {}
   JsonKeysetReader(absl::string_view serialized_keyset)
       : serialized_keyset_(serialized_keyset), keyset_stream_(nullptr) {}
 
+  // Parses the underlying JSON source into the given |keyset|.
+  crypto::tink::util::Status ReadKeyset(google::crypto::tink::Keyset* keyset);
+
   std::string serialized_keyset_;
   std::unique_ptr<std::istream> keyset_stream_;
 };
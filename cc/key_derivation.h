@@ -0,0 +1,50 @@
+// Copyright 2018 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_KEY_DERIVATION_H_
+#define TINK_KEY_DERIVATION_H_
+
+#include <memory>
+
+#include "absl/strings/string_view.h"
+#include "tink/aead.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+
+///////////////////////////////////////////////////////////////////////////////
+// The interface for deriving primitives from a single root key.
+// The derivation is deterministic: the same root key and the same context
+// always yield the same derived key. Hence a derived primitive, e.g. per
+// tenant or per file, never has to be stored and can be re-created from
+// its context at any time.
+//
+// Derived primitives are shared: implementations may return the same
+// instance for repeated calls with the same context.
+class KeyDerivation {
+ public:
+  // Returns an Aead whose key is derived from the root key and 'context'.
+  virtual crypto::tink::util::StatusOr<std::shared_ptr<Aead>> DeriveAead(
+      absl::string_view context) const = 0;
+
+  virtual ~KeyDerivation() {}
+};
+
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_KEY_DERIVATION_H_
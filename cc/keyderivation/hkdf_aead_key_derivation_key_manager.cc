@@ -0,0 +1,249 @@
+// Copyright 2018 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/keyderivation/hkdf_aead_key_derivation_key_manager.h"
+
+#include <algorithm>
+
+#include "absl/strings/string_view.h"
+#include "tink/key_derivation.h"
+#include "tink/key_manager.h"
+#include "tink/subtle/hkdf_aead_key_derivation.h"
+#include "tink/subtle/random.h"
+#include "tink/util/enums.h"
+#include "tink/util/errors.h"
+#include "tink/util/protobuf_helper.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "tink/util/validation.h"
+#include "proto/common.pb.h"
+#include "proto/hkdf_aead_key_derivation.pb.h"
+#include "proto/tink.pb.h"
+
+namespace crypto {
+namespace tink {
+
+using google::crypto::tink::HashType;
+using google::crypto::tink::HkdfAeadKeyDerivationKey;
+using google::crypto::tink::HkdfAeadKeyDerivationKeyFormat;
+using google::crypto::tink::HkdfAeadKeyDerivationParams;
+using google::crypto::tink::KeyData;
+using google::crypto::tink::KeyTemplate;
+using portable_proto::MessageLite;
+using crypto::tink::util::Status;
+using crypto::tink::util::StatusOr;
+
+class HkdfAeadKeyDerivationKeyFactory : public KeyFactory {
+ public:
+  HkdfAeadKeyDerivationKeyFactory() {}
+
+  // Generates a new random HkdfAeadKeyDerivationKey, based on the specified
+  // 'key_format', which must contain HkdfAeadKeyDerivationKeyFormat-proto.
+  crypto::tink::util::StatusOr<std::unique_ptr<portable_proto::MessageLite>>
+  NewKey(const portable_proto::MessageLite& key_format) const override;
+
+  // Generates a new random HkdfAeadKeyDerivationKey, based on the specified
+  // 'serialized_key_format', which must contain
+  // HkdfAeadKeyDerivationKeyFormat-proto.
+  crypto::tink::util::StatusOr<std::unique_ptr<portable_proto::MessageLite>>
+  NewKey(absl::string_view serialized_key_format) const override;
+
+  // Generates a new random HkdfAeadKeyDerivationKey, based on the specified
+  // 'serialized_key_format' (which must contain
+  // HkdfAeadKeyDerivationKeyFormat-proto), and wraps it in a KeyData-proto.
+  crypto::tink::util::StatusOr<std::unique_ptr<google::crypto::tink::KeyData>>
+  NewKeyData(absl::string_view serialized_key_format) const override;
+};
+
+StatusOr<std::unique_ptr<MessageLite>> HkdfAeadKeyDerivationKeyFactory::NewKey(
+    const portable_proto::MessageLite& key_format) const {
+  std::string key_format_url =
+      std::string(HkdfAeadKeyDerivationKeyManager::kKeyTypePrefix) +
+      key_format.GetTypeName();
+  if (key_format_url != HkdfAeadKeyDerivationKeyManager::kKeyFormatUrl) {
+    return ToStatusF(util::error::INVALID_ARGUMENT,
+                     "Key format proto '%s' is not supported by this manager.",
+                     key_format_url.c_str());
+  }
+  const HkdfAeadKeyDerivationKeyFormat& key_derivation_key_format =
+        reinterpret_cast<const HkdfAeadKeyDerivationKeyFormat&>(key_format);
+  Status status =
+      HkdfAeadKeyDerivationKeyManager::Validate(key_derivation_key_format);
+  if (!status.ok()) return status;
+
+  // Generate HkdfAeadKeyDerivationKey.
+  std::unique_ptr<HkdfAeadKeyDerivationKey> key_derivation_key(
+      new HkdfAeadKeyDerivationKey());
+  key_derivation_key->set_version(HkdfAeadKeyDerivationKeyManager::kVersion);
+  key_derivation_key->set_key_value(
+      subtle::Random::GetRandomBytes(key_derivation_key_format.key_size()));
+  *(key_derivation_key->mutable_params()) = key_derivation_key_format.params();
+  std::unique_ptr<MessageLite> key = std::move(key_derivation_key);
+  return std::move(key);
+}
+
+StatusOr<std::unique_ptr<MessageLite>> HkdfAeadKeyDerivationKeyFactory::NewKey(
+    absl::string_view serialized_key_format) const {
+  HkdfAeadKeyDerivationKeyFormat key_format;
+  if (!key_format.ParseFromString(std::string(serialized_key_format))) {
+    return ToStatusF(util::error::INVALID_ARGUMENT,
+                     "Could not parse the passed string as proto '%s'.",
+                     HkdfAeadKeyDerivationKeyManager::kKeyFormatUrl);
+  }
+  return NewKey(key_format);
+}
+
+StatusOr<std::unique_ptr<KeyData>> HkdfAeadKeyDerivationKeyFactory::NewKeyData(
+    absl::string_view serialized_key_format) const {
+  auto new_key_result = NewKey(serialized_key_format);
+  if (!new_key_result.ok()) return new_key_result.status();
+  auto new_key = reinterpret_cast<const HkdfAeadKeyDerivationKey&>(
+      *(new_key_result.ValueOrDie()));
+  std::unique_ptr<KeyData> key_data(new KeyData());
+  key_data->set_type_url(HkdfAeadKeyDerivationKeyManager::kKeyType);
+  key_data->set_value(new_key.SerializeAsString());
+  key_data->set_key_material_type(KeyData::SYMMETRIC);
+  return std::move(key_data);
+}
+
+constexpr char HkdfAeadKeyDerivationKeyManager::kKeyFormatUrl[];
+constexpr char HkdfAeadKeyDerivationKeyManager::kKeyTypePrefix[];
+constexpr char HkdfAeadKeyDerivationKeyManager::kKeyType[];
+constexpr uint32_t HkdfAeadKeyDerivationKeyManager::kVersion;
+
+// The root key must be at least 16 bytes, and at least as long as the
+// derived keys.
+const uint32_t kMinRootKeySizeInBytes = 16;
+// HKDF extracts at most 64 bytes (SHA-512) from the root key, so longer
+// root keys add no strength.
+const uint32_t kMaxRootKeySizeInBytes = 64;
+
+static uint32_t MinRootKeySize(const HkdfAeadKeyDerivationParams& params) {
+  return std::max(kMinRootKeySizeInBytes, params.derived_key_size());
+}
+
+HkdfAeadKeyDerivationKeyManager::HkdfAeadKeyDerivationKeyManager()
+    : key_type_(kKeyType),
+      key_factory_(new HkdfAeadKeyDerivationKeyFactory()) {}
+
+const std::string& HkdfAeadKeyDerivationKeyManager::get_key_type() const {
+  return key_type_;
+}
+
+uint32_t HkdfAeadKeyDerivationKeyManager::get_version() const {
+  return kVersion;
+}
+
+const KeyFactory& HkdfAeadKeyDerivationKeyManager::get_key_factory() const {
+  return *key_factory_;
+}
+
+StatusOr<std::unique_ptr<KeyDerivation>>
+HkdfAeadKeyDerivationKeyManager::GetPrimitive(const KeyData& key_data) const {
+  if (DoesSupport(key_data.type_url())) {
+    HkdfAeadKeyDerivationKey key_derivation_key;
+    if (!key_derivation_key.ParseFromString(key_data.value())) {
+      return ToStatusF(util::error::INVALID_ARGUMENT,
+                       "Could not parse key_data.value as key type '%s'.",
+                       key_data.type_url().c_str());
+    }
+    return GetPrimitiveImpl(key_derivation_key);
+  } else {
+    return ToStatusF(util::error::INVALID_ARGUMENT,
+                     "Key type '%s' is not supported by this manager.",
+                     key_data.type_url().c_str());
+  }
+}
+
+StatusOr<std::unique_ptr<KeyDerivation>>
+HkdfAeadKeyDerivationKeyManager::GetPrimitive(const MessageLite& key) const {
+  std::string key_type = std::string(kKeyTypePrefix) + key.GetTypeName();
+  if (DoesSupport(key_type)) {
+    const HkdfAeadKeyDerivationKey& key_derivation_key =
+        reinterpret_cast<const HkdfAeadKeyDerivationKey&>(key);
+    return GetPrimitiveImpl(key_derivation_key);
+  } else {
+    return ToStatusF(util::error::INVALID_ARGUMENT,
+                     "Key type '%s' is not supported by this manager.",
+                     key_type.c_str());
+  }
+}
+
+StatusOr<std::unique_ptr<KeyDerivation>>
+HkdfAeadKeyDerivationKeyManager::GetPrimitiveImpl(
+    const HkdfAeadKeyDerivationKey& key_derivation_key) const {
+  Status status = Validate(key_derivation_key);
+  if (!status.ok()) return status;
+  const HkdfAeadKeyDerivationParams& params = key_derivation_key.params();
+  return subtle::HkdfAeadKeyDerivation::New(
+      util::Enums::ProtoToSubtle(params.hash()),
+      key_derivation_key.key_value(), params.salt(),
+      params.derived_key_size(), params.cache_size());
+}
+
+// static
+Status HkdfAeadKeyDerivationKeyManager::Validate(
+    const HkdfAeadKeyDerivationParams& params) {
+  if (params.hash() != HashType::SHA256 && params.hash() != HashType::SHA512) {
+    return ToStatusF(util::error::INVALID_ARGUMENT,
+                     "Invalid HkdfAeadKeyDerivationParams: "
+                     "unsupported hash type %d.", params.hash());
+  }
+  uint32_t derived_key_size = params.derived_key_size();
+  if (derived_key_size != 16 && derived_key_size != 32) {
+    return ToStatusF(util::error::INVALID_ARGUMENT,
+                     "Invalid HkdfAeadKeyDerivationParams: derived_key_size "
+                     "is %d; supported sizes: 16 or 32 bytes.",
+                     derived_key_size);
+  }
+  return Status::OK;
+}
+
+// static
+Status HkdfAeadKeyDerivationKeyManager::Validate(
+    const HkdfAeadKeyDerivationKey& key) {
+  Status status = ValidateVersion(key.version(), kVersion);
+  if (!status.ok()) return status;
+  status = Validate(key.params());
+  if (!status.ok()) return status;
+  uint32_t key_size = key.key_value().size();
+  if (key_size < MinRootKeySize(key.params())) {
+    return ToStatusF(util::error::INVALID_ARGUMENT,
+                     "Invalid HkdfAeadKeyDerivationKey: key_value has %d "
+                     "bytes; the minimum is %d bytes.",
+                     key_size, MinRootKeySize(key.params()));
+  }
+  return Status::OK;
+}
+
+// static
+Status HkdfAeadKeyDerivationKeyManager::Validate(
+    const HkdfAeadKeyDerivationKeyFormat& key_format) {
+  Status status = Validate(key_format.params());
+  if (!status.ok()) return status;
+  if (key_format.key_size() < MinRootKeySize(key_format.params()) ||
+      key_format.key_size() > kMaxRootKeySizeInBytes) {
+    return ToStatusF(util::error::INVALID_ARGUMENT,
+                     "Invalid HkdfAeadKeyDerivationKeyFormat: key_size is %d; "
+                     "supported sizes: %d to %d bytes.",
+                     key_format.key_size(), MinRootKeySize(key_format.params()),
+                     kMaxRootKeySizeInBytes);
+  }
+  return Status::OK;
+}
+
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,343 @@
+// Copyright 2018 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include "tink/keyderivation/hkdf_aead_key_derivation_key_manager.h"
+
+#include "tink/aead.h"
+#include "tink/key_derivation.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "gtest/gtest.h"
+#include "proto/aes_eax.pb.h"
+#include "proto/common.pb.h"
+#include "proto/hkdf_aead_key_derivation.pb.h"
+#include "proto/tink.pb.h"
+
+namespace crypto {
+namespace tink {
+
+using google::crypto::tink::AesEaxKey;
+using google::crypto::tink::AesEaxKeyFormat;
+using google::crypto::tink::HashType;
+using google::crypto::tink::HkdfAeadKeyDerivationKey;
+using google::crypto::tink::HkdfAeadKeyDerivationKeyFormat;
+using google::crypto::tink::KeyData;
+
+namespace {
+
+class HkdfAeadKeyDerivationKeyManagerTest : public ::testing::Test {
+ protected:
+  std::string key_type_prefix = "type.googleapis.com/";
+  std::string key_derivation_key_type =
+      "type.googleapis.com/google.crypto.tink.HkdfAeadKeyDerivationKey";
+
+  HkdfAeadKeyDerivationKey ValidKey() {
+    HkdfAeadKeyDerivationKey key;
+    key.set_version(0);
+    key.set_key_value(std::string(32, 'k'));
+    key.mutable_params()->set_hash(HashType::SHA256);
+    key.mutable_params()->set_salt("some salt");
+    key.mutable_params()->set_derived_key_size(16);
+    key.mutable_params()->set_cache_size(8);
+    return key;
+  }
+};
+
+TEST_F(HkdfAeadKeyDerivationKeyManagerTest, testBasic) {
+  HkdfAeadKeyDerivationKeyManager key_manager;
+
+  EXPECT_EQ(0, key_manager.get_version());
+  EXPECT_EQ("type.googleapis.com/google.crypto.tink.HkdfAeadKeyDerivationKey",
+            key_manager.get_key_type());
+  EXPECT_TRUE(key_manager.DoesSupport(key_manager.get_key_type()));
+}
+
+TEST_F(HkdfAeadKeyDerivationKeyManagerTest, testKeyDataErrors) {
+  HkdfAeadKeyDerivationKeyManager key_manager;
+
+  {  // Bad key type.
+    KeyData key_data;
+    std::string bad_key_type =
+        "type.googleapis.com/google.crypto.tink.SomeOtherKey";
+    key_data.set_type_url(bad_key_type);
+    auto result = key_manager.GetPrimitive(key_data);
+    EXPECT_FALSE(result.ok());
+    EXPECT_EQ(util::error::INVALID_ARGUMENT, result.status().error_code());
+    EXPECT_PRED_FORMAT2(testing::IsSubstring, "not supported",
+                        result.status().error_message());
+    EXPECT_PRED_FORMAT2(testing::IsSubstring, bad_key_type,
+                        result.status().error_message());
+  }
+
+  {  // Bad key value.
+    KeyData key_data;
+    key_data.set_type_url(key_derivation_key_type);
+    key_data.set_value("some bad serialized proto");
+    auto result = key_manager.GetPrimitive(key_data);
+    EXPECT_FALSE(result.ok());
+    EXPECT_EQ(util::error::INVALID_ARGUMENT, result.status().error_code());
+    EXPECT_PRED_FORMAT2(testing::IsSubstring, "not parse",
+                        result.status().error_message());
+  }
+
+  {  // Bad version.
+    KeyData key_data;
+    HkdfAeadKeyDerivationKey key = ValidKey();
+    key.set_version(1);
+    key_data.set_type_url(key_derivation_key_type);
+    key_data.set_value(key.SerializeAsString());
+    auto result = key_manager.GetPrimitive(key_data);
+    EXPECT_FALSE(result.ok());
+    EXPECT_EQ(util::error::INVALID_ARGUMENT, result.status().error_code());
+    EXPECT_PRED_FORMAT2(testing::IsSubstring, "version",
+                        result.status().error_message());
+  }
+
+  {  // Bad key_value size (minimum: 16).
+    for (int len = 0; len < 40; len++) {
+      HkdfAeadKeyDerivationKey key = ValidKey();
+      key.set_key_value(std::string(len, 'a'));
+      KeyData key_data;
+      key_data.set_type_url(key_derivation_key_type);
+      key_data.set_value(key.SerializeAsString());
+      auto result = key_manager.GetPrimitive(key_data);
+      if (len >= 16) {
+        EXPECT_TRUE(result.ok()) << result.status();
+      } else {
+        EXPECT_FALSE(result.ok());
+        EXPECT_EQ(util::error::INVALID_ARGUMENT,
+                  result.status().error_code());
+        EXPECT_PRED_FORMAT2(testing::IsSubstring,
+                            std::to_string(len) + " bytes",
+                            result.status().error_message());
+      }
+    }
+  }
+
+  {  // Bad key_value size (shorter than the derived keys).
+    for (int len = 16; len < 40; len++) {
+      HkdfAeadKeyDerivationKey key = ValidKey();
+      key.mutable_params()->set_derived_key_size(32);
+      key.set_key_value(std::string(len, 'a'));
+      KeyData key_data;
+      key_data.set_type_url(key_derivation_key_type);
+      key_data.set_value(key.SerializeAsString());
+      auto result = key_manager.GetPrimitive(key_data);
+      if (len >= 32) {
+        EXPECT_TRUE(result.ok()) << result.status();
+      } else {
+        EXPECT_FALSE(result.ok());
+        EXPECT_EQ(util::error::INVALID_ARGUMENT,
+                  result.status().error_code());
+        EXPECT_PRED_FORMAT2(testing::IsSubstring, "the minimum is 32 bytes",
+                            result.status().error_message());
+      }
+    }
+  }
+}
+
+TEST_F(HkdfAeadKeyDerivationKeyManagerTest, testKeyMessageErrors) {
+  HkdfAeadKeyDerivationKeyManager key_manager;
+
+  {  // Bad protobuffer.
+    AesEaxKey key;
+    auto result = key_manager.GetPrimitive(key);
+    EXPECT_FALSE(result.ok());
+    EXPECT_EQ(util::error::INVALID_ARGUMENT, result.status().error_code());
+    EXPECT_PRED_FORMAT2(testing::IsSubstring, "AesEaxKey",
+                        result.status().error_message());
+    EXPECT_PRED_FORMAT2(testing::IsSubstring, "not supported",
+                        result.status().error_message());
+  }
+
+  {  // Bad hash type.
+    HkdfAeadKeyDerivationKey key = ValidKey();
+    key.mutable_params()->set_hash(HashType::SHA1);
+    auto result = key_manager.GetPrimitive(key);
+    EXPECT_FALSE(result.ok());
+    EXPECT_EQ(util::error::INVALID_ARGUMENT, result.status().error_code());
+    EXPECT_PRED_FORMAT2(testing::IsSubstring, "hash type",
+                        result.status().error_message());
+  }
+
+  {  // Bad derived_key_size (supported sizes: 16, 32).
+    for (int len = 0; len < 40; len++) {
+      HkdfAeadKeyDerivationKey key = ValidKey();
+      key.mutable_params()->set_derived_key_size(len);
+      auto result = key_manager.GetPrimitive(key);
+      if (len == 16 || len == 32) {
+        EXPECT_TRUE(result.ok()) << result.status();
+      } else {
+        EXPECT_FALSE(result.ok());
+        EXPECT_EQ(util::error::INVALID_ARGUMENT,
+                  result.status().error_code());
+        EXPECT_PRED_FORMAT2(testing::IsSubstring, "derived_key_size",
+                            result.status().error_message());
+      }
+    }
+  }
+}
+
+TEST_F(HkdfAeadKeyDerivationKeyManagerTest, testPrimitives) {
+  std::string plaintext = "some plaintext";
+  std::string aad = "some aad";
+  HkdfAeadKeyDerivationKeyManager key_manager;
+  HkdfAeadKeyDerivationKey key = ValidKey();
+
+  // Primitives created from the same key derive the same Aeads.
+  auto result = key_manager.GetPrimitive(key);
+  EXPECT_TRUE(result.ok()) << result.status();
+  auto key_derivation = std::move(result.ValueOrDie());
+
+  KeyData key_data;
+  key_data.set_type_url(key_derivation_key_type);
+  key_data.set_value(key.SerializeAsString());
+  auto other_result = key_manager.GetPrimitive(key_data);
+  EXPECT_TRUE(other_result.ok()) << other_result.status();
+  auto other_key_derivation = std::move(other_result.ValueOrDie());
+
+  auto aead_result = key_derivation->DeriveAead("tenant 1");
+  EXPECT_TRUE(aead_result.ok()) << aead_result.status();
+  auto encrypt_result =
+      aead_result.ValueOrDie()->Encrypt(plaintext, aad);
+  EXPECT_TRUE(encrypt_result.ok()) << encrypt_result.status();
+
+  auto other_aead_result = other_key_derivation->DeriveAead("tenant 1");
+  EXPECT_TRUE(other_aead_result.ok()) << other_aead_result.status();
+  auto decrypt_result = other_aead_result.ValueOrDie()->Decrypt(
+      encrypt_result.ValueOrDie(), aad);
+  EXPECT_TRUE(decrypt_result.ok()) << decrypt_result.status();
+  EXPECT_EQ(plaintext, decrypt_result.ValueOrDie());
+
+  // Another context derives another key.
+  auto wrong_aead_result = other_key_derivation->DeriveAead("tenant 2");
+  EXPECT_TRUE(wrong_aead_result.ok()) << wrong_aead_result.status();
+  decrypt_result = wrong_aead_result.ValueOrDie()->Decrypt(
+      encrypt_result.ValueOrDie(), aad);
+  EXPECT_FALSE(decrypt_result.ok());
+}
+
+TEST_F(HkdfAeadKeyDerivationKeyManagerTest, testNewKeyErrors) {
+  HkdfAeadKeyDerivationKeyManager key_manager;
+  const KeyFactory& key_factory = key_manager.get_key_factory();
+
+  {  // Bad key format.
+    AesEaxKeyFormat key_format;
+    auto result = key_factory.NewKey(key_format);
+    EXPECT_FALSE(result.ok());
+    EXPECT_EQ(util::error::INVALID_ARGUMENT, result.status().error_code());
+    EXPECT_PRED_FORMAT2(testing::IsSubstring, "not supported",
+                        result.status().error_message());
+    EXPECT_PRED_FORMAT2(testing::IsSubstring, "AesEaxKeyFormat",
+                        result.status().error_message());
+  }
+
+  {  // Bad serialized key format.
+    auto result = key_factory.NewKey("some bad serialized proto");
+    EXPECT_FALSE(result.ok());
+    EXPECT_EQ(util::error::INVALID_ARGUMENT, result.status().error_code());
+    EXPECT_PRED_FORMAT2(testing::IsSubstring, "not parse",
+                        result.status().error_message());
+  }
+
+  {  // Bad HkdfAeadKeyDerivationKeyFormat: key_size too small.
+    HkdfAeadKeyDerivationKeyFormat key_format;
+    *(key_format.mutable_params()) = ValidKey().params();
+    key_format.set_key_size(8);
+    auto result = key_factory.NewKey(key_format);
+    EXPECT_FALSE(result.ok());
+    EXPECT_EQ(util::error::INVALID_ARGUMENT, result.status().error_code());
+    EXPECT_PRED_FORMAT2(testing::IsSubstring, "key_size",
+                        result.status().error_message());
+  }
+
+  {  // Bad HkdfAeadKeyDerivationKeyFormat: key_size shorter than the
+     // derived keys.
+    HkdfAeadKeyDerivationKeyFormat key_format;
+    *(key_format.mutable_params()) = ValidKey().params();
+    key_format.mutable_params()->set_derived_key_size(32);
+    key_format.set_key_size(16);
+    auto result = key_factory.NewKey(key_format);
+    EXPECT_FALSE(result.ok());
+    EXPECT_EQ(util::error::INVALID_ARGUMENT, result.status().error_code());
+    EXPECT_PRED_FORMAT2(testing::IsSubstring, "32 to 64 bytes",
+                        result.status().error_message());
+  }
+
+  {  // Bad HkdfAeadKeyDerivationKeyFormat: key_size too large.
+    HkdfAeadKeyDerivationKeyFormat key_format;
+    *(key_format.mutable_params()) = ValidKey().params();
+    key_format.set_key_size(65);
+    auto result = key_factory.NewKey(key_format);
+    EXPECT_FALSE(result.ok());
+    EXPECT_EQ(util::error::INVALID_ARGUMENT, result.status().error_code());
+    EXPECT_PRED_FORMAT2(testing::IsSubstring, "16 to 64 bytes",
+                        result.status().error_message());
+  }
+
+  {  // Bad HkdfAeadKeyDerivationKeyFormat: missing params.
+    HkdfAeadKeyDerivationKeyFormat key_format;
+    key_format.set_key_size(32);
+    auto result = key_factory.NewKey(key_format);
+    EXPECT_FALSE(result.ok());
+    EXPECT_EQ(util::error::INVALID_ARGUMENT, result.status().error_code());
+  }
+}
+
+TEST_F(HkdfAeadKeyDerivationKeyManagerTest, testNewKeyBasic) {
+  HkdfAeadKeyDerivationKeyManager key_manager;
+  const KeyFactory& key_factory = key_manager.get_key_factory();
+  HkdfAeadKeyDerivationKeyFormat key_format;
+  *(key_format.mutable_params()) = ValidKey().params();
+  key_format.set_key_size(32);
+
+  { // Via NewKey(format_proto).
+    auto result = key_factory.NewKey(key_format);
+    EXPECT_TRUE(result.ok()) << result.status();
+    auto key = std::move(result.ValueOrDie());
+    EXPECT_EQ(key_type_prefix + key->GetTypeName(), key_derivation_key_type);
+    std::unique_ptr<HkdfAeadKeyDerivationKey> key_derivation_key(
+        reinterpret_cast<HkdfAeadKeyDerivationKey*>(key.release()));
+    EXPECT_EQ(0, key_derivation_key->version());
+    EXPECT_EQ(key_format.key_size(), key_derivation_key->key_value().size());
+    EXPECT_EQ(key_format.params().SerializeAsString(),
+              key_derivation_key->params().SerializeAsString());
+  }
+
+  { // Via NewKeyData(serialized_format_proto).
+    auto result = key_factory.NewKeyData(key_format.SerializeAsString());
+    EXPECT_TRUE(result.ok()) << result.status();
+    auto key_data = std::move(result.ValueOrDie());
+    EXPECT_EQ(key_derivation_key_type, key_data->type_url());
+    EXPECT_EQ(KeyData::SYMMETRIC, key_data->key_material_type());
+    HkdfAeadKeyDerivationKey key_derivation_key;
+    EXPECT_TRUE(key_derivation_key.ParseFromString(key_data->value()));
+    EXPECT_EQ(0, key_derivation_key.version());
+    EXPECT_EQ(key_format.key_size(), key_derivation_key.key_value().size());
+    auto primitive_result = key_manager.GetPrimitive(*key_data);
+    EXPECT_TRUE(primitive_result.ok()) << primitive_result.status();
+  }
+}
+
+}  // namespace
+}  // namespace tink
+}  // namespace crypto
+
+
+int main(int ac, char* av[]) {
+  testing::InitGoogleTest(&ac, av);
+  return RUN_ALL_TESTS();
+}
@@ -17,6 +17,7 @@
 #ifndef TINK_KEYSET_HANDLE_H_
 #define TINK_KEYSET_HANDLE_H_
 
+#include "google/protobuf/arena.h"
 #include "tink/aead.h"
 #include "tink/keyset_reader.h"
 #include "tink/keyset_writer.h"
@@ -52,6 +53,8 @@ class KeysetHandle {
   crypto::tink::util::StatusOr<std::unique_ptr<KeysetHandle>>
   GetPublicKeysetHandle();
 
+  // Wipes the key material held by this handle.
+  ~KeysetHandle();
 
  private:
   // The classes below need access to get_keyset();
@@ -67,7 +70,15 @@ class KeysetHandle {
 
   // Creates a handle that contains and owns the given keyset.
   KeysetHandle(std::unique_ptr<google::crypto::tink::Keyset> keyset);
-  std::unique_ptr<google::crypto::tink::Keyset> keyset_;
+
+  // Creates a handle that owns |arena| and contains the given keyset,
+  // which must be allocated on |arena|.
+  KeysetHandle(std::unique_ptr<google::protobuf::Arena> arena,
+               google::crypto::tink::Keyset* keyset);
+
+  // Owns keyset_ if not null, otherwise keyset_ is owned by this handle.
+  std::unique_ptr<google::protobuf::Arena> arena_;
+  google::crypto::tink::Keyset* keyset_;
 };
 
 }  // namespace tink
@@ -17,6 +17,7 @@
 #ifndef TINK_KEYSET_READER_H_
 #define TINK_KEYSET_READER_H_
 
+#include "google/protobuf/arena.h"
 #include "tink/util/statusor.h"
 #include "proto/tink.pb.h"
 
@@ -37,6 +38,21 @@ class KeysetReader {
     std::unique_ptr<google::crypto::tink::EncryptedKeyset>>
   ReadEncrypted() = 0;
 
+  // Reads a (cleartext) Keyset object from the underlying source into
+  // a message allocated on |arena|, which owns the returned Keyset.
+  // The default implementation copies the result of Read() onto |arena|;
+  // readers should override it to parse directly into the arena.
+  virtual crypto::tink::util::StatusOr<google::crypto::tink::Keyset*>
+  ReadOnArena(google::protobuf::Arena* arena) {
+    auto keyset_result = Read();
+    if (!keyset_result.ok()) return keyset_result.status();
+    auto keyset =
+        google::protobuf::Arena::CreateMessage<google::crypto::tink::Keyset>(
+            arena);
+    keyset->Swap(keyset_result.ValueOrDie().get());
+    return keyset;
+  }
+
   virtual ~KeysetReader() {}
 };
 
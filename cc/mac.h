@@ -18,6 +18,7 @@
 #define TINK_MAC_H_
 
 #include "absl/strings/string_view.h"
+#include "tink/output_buffer.h"
 #include "tink/util/status.h"
 #include "tink/util/statusor.h"
 
@@ -34,6 +35,12 @@ class Mac {
   virtual crypto::tink::util::StatusOr<std::string> ComputeMac(
       absl::string_view data) const = 0;
 
+  // Like ComputeMac(), but writes the MAC to 'mac_value' instead of
+  // returning it, so that the caller decides where it is stored.
+  // The default implementation copies the result of ComputeMac().
+  virtual crypto::tink::util::Status ComputeMacInto(
+      absl::string_view data, OutputBuffer* mac_value) const;
+
   // Verifies if 'mac' is a correct authentication code (MAC) for 'data'.
   // Returns Status::OK if 'mac' is correct, and a non-OK-Status otherwise.
   virtual crypto::tink::util::Status VerifyMac(
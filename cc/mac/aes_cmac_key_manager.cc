@@ -0,0 +1,219 @@
+// Copyright 2018 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/mac/aes_cmac_key_manager.h"
+
+#include "absl/strings/string_view.h"
+#include "tink/mac.h"
+#include "tink/key_manager.h"
+#include "tink/subtle/aes_cmac_boringssl.h"
+#include "tink/subtle/random.h"
+#include "tink/util/errors.h"
+#include "tink/util/protobuf_helper.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "tink/util/validation.h"
+#include "proto/aes_cmac.pb.h"
+#include "proto/tink.pb.h"
+
+namespace crypto {
+namespace tink {
+
+using google::crypto::tink::AesCmacKey;
+using google::crypto::tink::AesCmacKeyFormat;
+using google::crypto::tink::AesCmacParams;
+using google::crypto::tink::KeyData;
+using google::crypto::tink::KeyTemplate;
+using portable_proto::MessageLite;
+using crypto::tink::util::Status;
+using crypto::tink::util::StatusOr;
+
+class AesCmacKeyFactory : public KeyFactory {
+ public:
+  AesCmacKeyFactory() {}
+
+  // Generates a new random AesCmacKey, based on the specified 'key_format',
+  // which must contain AesCmacKeyFormat-proto.
+  crypto::tink::util::StatusOr<std::unique_ptr<portable_proto::MessageLite>>
+  NewKey(const portable_proto::MessageLite& key_format) const override;
+
+
+  // Generates a new random AesCmacKey, based on the specified
+  // 'serialized_key_format', which must contain AesCmacKeyFormat-proto.
+  crypto::tink::util::StatusOr<std::unique_ptr<portable_proto::MessageLite>>
+  NewKey(absl::string_view serialized_key_format) const override;
+
+  // Generates a new random AesCmacKey, based on the specified
+  // 'serialized_key_format' (which must contain AesCmacKeyFormat-proto),
+  // and wraps it in a KeyData-proto.
+  crypto::tink::util::StatusOr<std::unique_ptr<google::crypto::tink::KeyData>>
+  NewKeyData(absl::string_view serialized_key_format) const override;
+};
+
+StatusOr<std::unique_ptr<MessageLite>> AesCmacKeyFactory::NewKey(
+    const portable_proto::MessageLite& key_format) const {
+  std::string key_format_url =
+      std::string(AesCmacKeyManager::kKeyTypePrefix) +
+      key_format.GetTypeName();
+  if (key_format_url != AesCmacKeyManager::kKeyFormatUrl) {
+    return ToStatusF(util::error::INVALID_ARGUMENT,
+                     "Key format proto '%s' is not supported by this manager.",
+                     key_format_url.c_str());
+  }
+  const AesCmacKeyFormat& aes_cmac_key_format =
+      reinterpret_cast<const AesCmacKeyFormat&>(key_format);
+  Status status = AesCmacKeyManager::Validate(aes_cmac_key_format);
+  if (!status.ok()) return status;
+
+  // Generate AesCmacKey.
+  std::unique_ptr<AesCmacKey> aes_cmac_key(new AesCmacKey());
+  aes_cmac_key->set_version(AesCmacKeyManager::kVersion);
+  *(aes_cmac_key->mutable_params()) = aes_cmac_key_format.params();
+  aes_cmac_key->set_key_value(
+      subtle::Random::GetRandomBytes(aes_cmac_key_format.key_size()));
+  std::unique_ptr<MessageLite> key = std::move(aes_cmac_key);
+  return std::move(key);
+}
+
+StatusOr<std::unique_ptr<MessageLite>> AesCmacKeyFactory::NewKey(
+    absl::string_view serialized_key_format) const {
+  AesCmacKeyFormat key_format;
+  if (!key_format.ParseFromString(std::string(serialized_key_format))) {
+    return ToStatusF(util::error::INVALID_ARGUMENT,
+                     "Could not parse the passed string as proto '%s'.",
+                     AesCmacKeyManager::kKeyFormatUrl);
+  }
+  return NewKey(key_format);
+}
+
+StatusOr<std::unique_ptr<KeyData>> AesCmacKeyFactory::NewKeyData(
+    absl::string_view serialized_key_format) const {
+  auto new_key_result = NewKey(serialized_key_format);
+  if (!new_key_result.ok()) return new_key_result.status();
+  auto new_key = reinterpret_cast<const AesCmacKey&>(
+      *(new_key_result.ValueOrDie()));
+  std::unique_ptr<KeyData> key_data(new KeyData());
+  key_data->set_type_url(AesCmacKeyManager::kKeyType);
+  key_data->set_value(new_key.SerializeAsString());
+  key_data->set_key_material_type(KeyData::SYMMETRIC);
+  return std::move(key_data);
+}
+
+constexpr char AesCmacKeyManager::kKeyFormatUrl[];
+constexpr char AesCmacKeyManager::kKeyTypePrefix[];
+constexpr char AesCmacKeyManager::kKeyType[];
+constexpr uint32_t AesCmacKeyManager::kVersion;
+
+const int kMinTagSizeInBytes = 10;
+const int kMaxTagSizeInBytes = 16;
+
+AesCmacKeyManager::AesCmacKeyManager()
+    : key_type_(kKeyType), key_factory_(new AesCmacKeyFactory()) {}
+
+const std::string& AesCmacKeyManager::get_key_type() const {
+  return key_type_;
+}
+
+uint32_t AesCmacKeyManager::get_version() const {
+  return kVersion;
+}
+
+const KeyFactory& AesCmacKeyManager::get_key_factory() const {
+  return *key_factory_;
+}
+
+StatusOr<std::unique_ptr<Mac>>
+AesCmacKeyManager::GetPrimitive(const KeyData& key_data) const {
+  if (DoesSupport(key_data.type_url())) {
+    AesCmacKey aes_cmac_key;
+    if (!aes_cmac_key.ParseFromString(key_data.value())) {
+      return ToStatusF(util::error::INVALID_ARGUMENT,
+                       "Could not parse key_data.value as key type '%s'.",
+                       key_data.type_url().c_str());
+    }
+    return GetPrimitiveImpl(aes_cmac_key);
+  } else {
+    return ToStatusF(util::error::INVALID_ARGUMENT,
+                     "Key type '%s' is not supported by this manager.",
+                     key_data.type_url().c_str());
+  }
+}
+
+StatusOr<std::unique_ptr<Mac>>
+AesCmacKeyManager::GetPrimitive(const MessageLite& key) const {
+  std::string key_type = std::string(kKeyTypePrefix) + key.GetTypeName();
+  if (DoesSupport(key_type)) {
+    const AesCmacKey& aes_cmac_key = reinterpret_cast<const AesCmacKey&>(key);
+    return GetPrimitiveImpl(aes_cmac_key);
+  } else {
+    return ToStatusF(util::error::INVALID_ARGUMENT,
+                     "Key type '%s' is not supported by this manager.",
+                     key_type.c_str());
+  }
+}
+
+StatusOr<std::unique_ptr<Mac>>
+AesCmacKeyManager::GetPrimitiveImpl(const AesCmacKey& aes_cmac_key) const {
+  Status status = Validate(aes_cmac_key);
+  if (!status.ok()) return status;
+  auto aes_cmac_result = subtle::AesCmacBoringSsl::New(
+      aes_cmac_key.key_value(), aes_cmac_key.params().tag_size());
+  if (!aes_cmac_result.ok()) return aes_cmac_result.status();
+  return std::move(aes_cmac_result.ValueOrDie());
+}
+
+// static
+Status AesCmacKeyManager::Validate(const AesCmacParams& params) {
+  if (params.tag_size() < kMinTagSizeInBytes ||
+      params.tag_size() > kMaxTagSizeInBytes) {
+    return ToStatusF(util::error::INVALID_ARGUMENT,
+                     "Invalid AesCmacParams: tag_size %d is not between "
+                     "%d and %d.",
+                     params.tag_size(), kMinTagSizeInBytes,
+                     kMaxTagSizeInBytes);
+  }
+  return Status::OK;
+}
+
+// static
+Status AesCmacKeyManager::ValidateKeySize(uint32_t key_size) {
+  if (key_size != 16 && key_size != 32) {
+    return ToStatusF(util::error::INVALID_ARGUMENT,
+                     "Invalid key size: %d bytes; supported sizes: "
+                     "16 or 32 bytes.",
+                     key_size);
+  }
+  return Status::OK;
+}
+
+// static
+Status AesCmacKeyManager::Validate(const AesCmacKey& key) {
+  Status status = ValidateVersion(key.version(), kVersion);
+  if (!status.ok()) return status;
+  status = ValidateKeySize(key.key_value().size());
+  if (!status.ok()) return status;
+  return Validate(key.params());
+}
+
+// static
+Status AesCmacKeyManager::Validate(const AesCmacKeyFormat& key_format) {
+  Status status = ValidateKeySize(key_format.key_size());
+  if (!status.ok()) return status;
+  return Validate(key_format.params());
+}
+
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,274 @@
+// Copyright 2017 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/mac/aes_cmac_key_manager.h"
+
+#include "tink/mac.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "tink/util/test_util.h"
+#include "gtest/gtest.h"
+#include "proto/aes_cmac.pb.h"
+#include "proto/aes_ctr.pb.h"
+#include "proto/tink.pb.h"
+
+namespace crypto {
+namespace tink {
+
+using google::crypto::tink::AesCmacKey;
+using google::crypto::tink::AesCmacKeyFormat;
+using google::crypto::tink::AesCtrKey;
+using google::crypto::tink::AesCtrKeyFormat;
+using google::crypto::tink::KeyData;
+
+namespace {
+
+class AesCmacKeyManagerTest : public ::testing::Test {
+ protected:
+  std::string key_type_prefix = "type.googleapis.com/";
+  std::string aes_cmac_key_type =
+      "type.googleapis.com/google.crypto.tink.AesCmacKey";
+};
+
+TEST_F(AesCmacKeyManagerTest, testBasic) {
+  AesCmacKeyManager key_manager;
+
+  EXPECT_EQ(0, key_manager.get_version());
+  EXPECT_EQ("type.googleapis.com/google.crypto.tink.AesCmacKey",
+            key_manager.get_key_type());
+  EXPECT_TRUE(key_manager.DoesSupport(key_manager.get_key_type()));
+}
+
+TEST_F(AesCmacKeyManagerTest, testKeyDataErrors) {
+  AesCmacKeyManager key_manager;
+
+  {  // Bad key type.
+    KeyData key_data;
+    std::string bad_key_type =
+        "type.googleapis.com/google.crypto.tink.SomeOtherKey";
+    key_data.set_type_url(bad_key_type);
+    auto result = key_manager.GetPrimitive(key_data);
+    EXPECT_FALSE(result.ok());
+    EXPECT_EQ(util::error::INVALID_ARGUMENT, result.status().error_code());
+    EXPECT_PRED_FORMAT2(testing::IsSubstring, "not supported",
+                        result.status().error_message());
+    EXPECT_PRED_FORMAT2(testing::IsSubstring, bad_key_type,
+                        result.status().error_message());
+  }
+
+  {  // Bad key value.
+    KeyData key_data;
+    key_data.set_type_url(aes_cmac_key_type);
+    key_data.set_value("some bad serialized proto");
+    auto result = key_manager.GetPrimitive(key_data);
+    EXPECT_FALSE(result.ok());
+    EXPECT_EQ(util::error::INVALID_ARGUMENT, result.status().error_code());
+    EXPECT_PRED_FORMAT2(testing::IsSubstring, "not parse",
+                        result.status().error_message());
+  }
+
+  {  // Bad version.
+    KeyData key_data;
+    AesCmacKey key;
+    key.set_version(1);
+    key_data.set_type_url(aes_cmac_key_type);
+    key_data.set_value(key.SerializeAsString());
+    auto result = key_manager.GetPrimitive(key_data);
+    EXPECT_FALSE(result.ok());
+    EXPECT_EQ(util::error::INVALID_ARGUMENT, result.status().error_code());
+    EXPECT_PRED_FORMAT2(testing::IsSubstring, "version",
+                        result.status().error_message());
+  }
+
+  {  // Bad key_value size (supported sizes: 16, 32).
+    for (int len = 0; len < 42; len++) {
+      AesCmacKey key;
+      key.set_version(0);
+      key.set_key_value(std::string(len, 'a'));
+      key.mutable_params()->set_tag_size(16);
+      KeyData key_data;
+      key_data.set_type_url(aes_cmac_key_type);
+      key_data.set_value(key.SerializeAsString());
+      auto result = key_manager.GetPrimitive(key_data);
+      if (len == 16 || len == 32) {
+        EXPECT_TRUE(result.ok()) << result.status();
+      } else {
+        EXPECT_FALSE(result.ok());
+        EXPECT_EQ(util::error::INVALID_ARGUMENT,
+                  result.status().error_code());
+        EXPECT_PRED_FORMAT2(testing::IsSubstring,
+                            std::to_string(len) + " bytes",
+                            result.status().error_message());
+      }
+    }
+  }
+}
+
+TEST_F(AesCmacKeyManagerTest, testKeyMessageErrors) {
+  AesCmacKeyManager key_manager;
+
+  {  // Bad protobuffer.
+    AesCtrKey key_message;
+    auto result = key_manager.GetPrimitive(key_message);
+    EXPECT_FALSE(result.ok());
+    EXPECT_EQ(util::error::INVALID_ARGUMENT, result.status().error_code());
+    EXPECT_PRED_FORMAT2(testing::IsSubstring, "AesCtrKey",
+                        result.status().error_message());
+    EXPECT_PRED_FORMAT2(testing::IsSubstring, "not supported",
+                        result.status().error_message());
+  }
+
+  {  // Bad tag_size (supported sizes: 10 to 16).
+    for (int tag_size = 0; tag_size < 33; tag_size++) {
+      AesCmacKey key;
+      key.set_version(0);
+      key.set_key_value(std::string(32, 'a'));
+      key.mutable_params()->set_tag_size(tag_size);
+      auto result = key_manager.GetPrimitive(key);
+      if (tag_size >= 10 && tag_size <= 16) {
+        EXPECT_TRUE(result.ok()) << result.status();
+      } else {
+        EXPECT_FALSE(result.ok());
+        EXPECT_EQ(util::error::INVALID_ARGUMENT,
+                  result.status().error_code());
+        EXPECT_PRED_FORMAT2(testing::IsSubstring, "tag_size",
+                            result.status().error_message());
+      }
+    }
+  }
+}
+
+TEST_F(AesCmacKeyManagerTest, testPrimitives) {
+  AesCmacKeyManager key_manager;
+  AesCmacKey key;
+
+  // Test vector from https://tools.ietf.org/html/rfc4493#section-4.
+  key.set_version(0);
+  key.set_key_value(test::HexDecodeOrDie("2b7e151628aed2a6abf7158809cf4f3c"));
+  key.mutable_params()->set_tag_size(16);
+  std::string data = test::HexDecodeOrDie("6bc1bee22e409f96e93d7e117393172a");
+  std::string tag = test::HexDecodeOrDie("070a16b46b4d4144f79bdd9dd04a287c");
+
+  {  // Using key message only.
+    auto result = key_manager.GetPrimitive(key);
+    EXPECT_TRUE(result.ok()) << result.status();
+    auto aes_cmac = std::move(result.ValueOrDie());
+    auto aes_cmac_result = aes_cmac->ComputeMac(data);
+    EXPECT_TRUE(aes_cmac_result.ok()) << aes_cmac_result.status();
+    EXPECT_EQ(tag, aes_cmac_result.ValueOrDie());
+  }
+
+  {  // Using KeyData proto.
+    KeyData key_data;
+    key_data.set_type_url(aes_cmac_key_type);
+    key_data.set_value(key.SerializeAsString());
+    auto result = key_manager.GetPrimitive(key_data);
+    EXPECT_TRUE(result.ok()) << result.status();
+    auto aes_cmac = std::move(result.ValueOrDie());
+    EXPECT_TRUE(aes_cmac->VerifyMac(tag, data).ok());
+    EXPECT_FALSE(aes_cmac->VerifyMac(tag, "other data").ok());
+  }
+}
+
+TEST_F(AesCmacKeyManagerTest, testNewKeyErrors) {
+  AesCmacKeyManager key_manager;
+  const KeyFactory& key_factory = key_manager.get_key_factory();
+
+  {  // Bad key format.
+    AesCtrKeyFormat key_format;
+    auto result = key_factory.NewKey(key_format);
+    EXPECT_FALSE(result.ok());
+    EXPECT_EQ(util::error::INVALID_ARGUMENT, result.status().error_code());
+    EXPECT_PRED_FORMAT2(testing::IsSubstring, "not supported",
+                        result.status().error_message());
+    EXPECT_PRED_FORMAT2(testing::IsSubstring, "AesCtrKeyFormat",
+                        result.status().error_message());
+  }
+
+  {  // Bad serialized key format.
+    auto result = key_factory.NewKey("some bad serialized proto");
+    EXPECT_FALSE(result.ok());
+    EXPECT_EQ(util::error::INVALID_ARGUMENT, result.status().error_code());
+    EXPECT_PRED_FORMAT2(testing::IsSubstring, "not parse",
+                        result.status().error_message());
+  }
+
+  {  // Bad AesCmacKeyFormat: unsupported key_size.
+    AesCmacKeyFormat key_format;
+    key_format.set_key_size(24);
+    key_format.mutable_params()->set_tag_size(16);
+    auto result = key_factory.NewKey(key_format);
+    EXPECT_FALSE(result.ok());
+    EXPECT_EQ(util::error::INVALID_ARGUMENT, result.status().error_code());
+    EXPECT_PRED_FORMAT2(testing::IsSubstring, "24 bytes",
+                        result.status().error_message());
+  }
+
+  {  // Bad AesCmacKeyFormat: tag_size too big.
+    AesCmacKeyFormat key_format;
+    key_format.set_key_size(32);
+    key_format.mutable_params()->set_tag_size(17);
+    auto result = key_factory.NewKey(key_format);
+    EXPECT_FALSE(result.ok());
+    EXPECT_EQ(util::error::INVALID_ARGUMENT, result.status().error_code());
+    EXPECT_PRED_FORMAT2(testing::IsSubstring, "tag_size",
+                        result.status().error_message());
+  }
+}
+
+TEST_F(AesCmacKeyManagerTest, testNewKeyBasic) {
+  AesCmacKeyManager key_manager;
+  const KeyFactory& key_factory = key_manager.get_key_factory();
+  AesCmacKeyFormat key_format;
+  key_format.set_key_size(32);
+  key_format.mutable_params()->set_tag_size(16);
+
+  { // Via NewKey(format_proto).
+    auto result = key_factory.NewKey(key_format);
+    EXPECT_TRUE(result.ok()) << result.status();
+    auto key = std::move(result.ValueOrDie());
+    EXPECT_EQ(key_type_prefix + key->GetTypeName(), aes_cmac_key_type);
+    std::unique_ptr<AesCmacKey> aes_cmac_key(
+        reinterpret_cast<AesCmacKey*>(key.release()));
+    EXPECT_EQ(0, aes_cmac_key->version());
+    EXPECT_EQ(key_format.params().tag_size(),
+              aes_cmac_key->params().tag_size());
+    EXPECT_EQ(key_format.key_size(), aes_cmac_key->key_value().size());
+  }
+
+  { // Via NewKeyData(serialized_format_proto).
+    auto result = key_factory.NewKeyData(key_format.SerializeAsString());
+    EXPECT_TRUE(result.ok()) << result.status();
+    auto key_data = std::move(result.ValueOrDie());
+    EXPECT_EQ(aes_cmac_key_type, key_data->type_url());
+    EXPECT_EQ(KeyData::SYMMETRIC, key_data->key_material_type());
+    AesCmacKey aes_cmac_key;
+    EXPECT_TRUE(aes_cmac_key.ParseFromString(key_data->value()));
+    EXPECT_EQ(0, aes_cmac_key.version());
+    EXPECT_EQ(key_format.params().tag_size(),
+              aes_cmac_key.params().tag_size());
+    EXPECT_EQ(key_format.key_size(), aes_cmac_key.key_value().size());
+  }
+}
+
+}  // namespace
+}  // namespace tink
+}  // namespace crypto
+
+int main(int ac, char* av[]) {
+  testing::InitGoogleTest(&ac, av);
+  return RUN_ALL_TESTS();
+}
@@ -19,7 +19,10 @@
 #include "absl/strings/ascii.h"
 #include "tink/catalogue.h"
 #include "tink/key_manager.h"
+#include "tink/mac/aes_cmac_key_manager.h"
 #include "tink/mac/hmac_key_manager.h"
+#include "tink/mac/poly1305_mac_key_manager.h"
+#include "tink/mac/tree_hmac_key_manager.h"
 #include "tink/util/status.h"
 #include "tink/util/statusor.h"
 
@@ -34,6 +37,18 @@ crypto::tink::util::StatusOr<std::unique_ptr<KeyManager<Mac>>> CreateKeyManager(
     std::unique_ptr<KeyManager<Mac>> manager(new HmacKeyManager());
     return std::move(manager);
   }
+  if (type_url == AesCmacKeyManager::kKeyType) {
+    std::unique_ptr<KeyManager<Mac>> manager(new AesCmacKeyManager());
+    return std::move(manager);
+  }
+  if (type_url == Poly1305MacKeyManager::kKeyType) {
+    std::unique_ptr<KeyManager<Mac>> manager(new Poly1305MacKeyManager());
+    return std::move(manager);
+  }
+  if (type_url == TreeHmacKeyManager::kKeyType) {
+    std::unique_ptr<KeyManager<Mac>> manager(new TreeHmacKeyManager());
+    return std::move(manager);
+  }
   return ToStatusF(crypto::tink::util::error::NOT_FOUND,
                    "No key manager for type_url '%s'.", type_url.c_str());
 }
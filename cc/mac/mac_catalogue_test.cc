@@ -56,6 +56,15 @@ TEST_F(MacCatalogueTest, testBasic) {
     EXPECT_FALSE(manager_result.ok());
     EXPECT_EQ(util::error::NOT_FOUND, manager_result.status().error_code());
   }
+
+  for (const char* other_key_type :
+       {"type.googleapis.com/google.crypto.tink.AesCmacKey",
+        "type.googleapis.com/google.crypto.tink.Poly1305MacKey",
+        "type.googleapis.com/google.crypto.tink.TreeHmacKey"}) {
+    auto manager_result = catalogue.GetKeyManager(other_key_type, "Mac", 0);
+    EXPECT_TRUE(manager_result.ok()) << manager_result.status();
+    EXPECT_TRUE(manager_result.ValueOrDie()->DoesSupport(other_key_type));
+  }
 }
 
 }  // namespace
@@ -32,6 +32,15 @@ google::crypto::tink::RegistryConfig* GenerateRegistryConfig() {
   config->add_entry()->MergeFrom(*Config::GetTinkKeyTypeEntry(
       MacConfig::kCatalogueName, MacConfig::kPrimitiveName,
       "HmacKey", 0, true));
+  config->add_entry()->MergeFrom(*Config::GetTinkKeyTypeEntry(
+      MacConfig::kCatalogueName, MacConfig::kPrimitiveName,
+      "AesCmacKey", 0, true));
+  config->add_entry()->MergeFrom(*Config::GetTinkKeyTypeEntry(
+      MacConfig::kCatalogueName, MacConfig::kPrimitiveName,
+      "Poly1305MacKey", 0, true));
+  config->add_entry()->MergeFrom(*Config::GetTinkKeyTypeEntry(
+      MacConfig::kCatalogueName, MacConfig::kPrimitiveName,
+      "TreeHmacKey", 0, true));
   config->set_config_name("TINK_MAC");
   return config;
 }
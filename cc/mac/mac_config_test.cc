@@ -52,13 +52,38 @@ TEST_F(MacConfigTest, testBasic) {
   std::string key_type = "type.googleapis.com/google.crypto.tink.HmacKey";
   auto& config = MacConfig::Latest();
 
-  EXPECT_EQ(1, MacConfig::Latest().entry_size());
+  std::string aes_cmac_key_type =
+      "type.googleapis.com/google.crypto.tink.AesCmacKey";
+  std::string poly1305_mac_key_type =
+      "type.googleapis.com/google.crypto.tink.Poly1305MacKey";
+  std::string tree_hmac_key_type =
+      "type.googleapis.com/google.crypto.tink.TreeHmacKey";
+
+  EXPECT_EQ(4, MacConfig::Latest().entry_size());
   EXPECT_EQ("TinkMac", config.entry(0).catalogue_name());
   EXPECT_EQ("Mac", config.entry(0).primitive_name());
   EXPECT_EQ(key_type, config.entry(0).type_url());
   EXPECT_EQ(true, config.entry(0).new_key_allowed());
   EXPECT_EQ(0, config.entry(0).key_manager_version());
 
+  EXPECT_EQ("TinkMac", config.entry(1).catalogue_name());
+  EXPECT_EQ("Mac", config.entry(1).primitive_name());
+  EXPECT_EQ(aes_cmac_key_type, config.entry(1).type_url());
+  EXPECT_EQ(true, config.entry(1).new_key_allowed());
+  EXPECT_EQ(0, config.entry(1).key_manager_version());
+
+  EXPECT_EQ("TinkMac", config.entry(2).catalogue_name());
+  EXPECT_EQ("Mac", config.entry(2).primitive_name());
+  EXPECT_EQ(poly1305_mac_key_type, config.entry(2).type_url());
+  EXPECT_EQ(true, config.entry(2).new_key_allowed());
+  EXPECT_EQ(0, config.entry(2).key_manager_version());
+
+  EXPECT_EQ("TinkMac", config.entry(3).catalogue_name());
+  EXPECT_EQ("Mac", config.entry(3).primitive_name());
+  EXPECT_EQ(tree_hmac_key_type, config.entry(3).type_url());
+  EXPECT_EQ(true, config.entry(3).new_key_allowed());
+  EXPECT_EQ(0, config.entry(3).key_manager_version());
+
   // No key manager before registration.
   auto manager_result = Registry::get_key_manager<Mac>(key_type);
   EXPECT_FALSE(manager_result.ok());
@@ -70,6 +95,11 @@ TEST_F(MacConfigTest, testBasic) {
   manager_result = Registry::get_key_manager<Mac>(key_type);
   EXPECT_TRUE(manager_result.ok()) << manager_result.status();
   EXPECT_TRUE(manager_result.ValueOrDie()->DoesSupport(key_type));
+  for (const std::string& other_key_type :
+       {aes_cmac_key_type, poly1305_mac_key_type, tree_hmac_key_type}) {
+    auto other_manager_result = Registry::get_key_manager<Mac>(other_key_type);
+    EXPECT_TRUE(other_manager_result.ok()) << other_manager_result.status();
+  }
 }
 
 TEST_F(MacConfigTest, testRegister) {
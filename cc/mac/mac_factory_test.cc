@@ -16,27 +16,36 @@
 
 #include "tink/mac/mac_factory.h"
 
+#include <vector>
+
 #include "gtest/gtest.h"
 #include "tink/crypto_format.h"
 #include "tink/keyset_handle.h"
 #include "tink/mac.h"
+#include "tink/mac/aes_cmac_key_manager.h"
 #include "tink/mac/hmac_key_manager.h"
 #include "tink/mac/mac_config.h"
+#include "tink/mac/mac_key_templates.h"
+#include "tink/mac/poly1305_mac_key_manager.h"
 #include "tink/util/keyset_util.h"
 #include "tink/util/status.h"
 #include "tink/util/test_util.h"
+#include "proto/aes_cmac.pb.h"
 #include "proto/common.pb.h"
 #include "proto/hmac.pb.h"
+#include "proto/poly1305_mac.pb.h"
 #include "proto/tink.pb.h"
 
 using crypto::tink::KeysetUtil;
 using crypto::tink::test::AddRawKey;
 using crypto::tink::test::AddTinkKey;
+using google::crypto::tink::AesCmacKeyFormat;
 using google::crypto::tink::HashType;
 using google::crypto::tink::HmacKeyFormat;
 using google::crypto::tink::KeyData;
 using google::crypto::tink::Keyset;
 using google::crypto::tink::KeyStatusType;
+using google::crypto::tink::Poly1305MacKeyFormat;
 
 
 namespace crypto {
@@ -128,6 +137,60 @@ TEST_F(MacFactoryTest, testPrimitive) {
   EXPECT_TRUE(status.ok()) << status;
 }
 
+TEST_F(MacFactoryTest, testMixedKeyTypes) {
+  // A keyset with HMAC, AES-CMAC and Poly1305 keys.
+  HmacKeyManager hmac_key_manager;
+  AesCmacKeyManager aes_cmac_key_manager;
+  Poly1305MacKeyManager poly1305_mac_key_manager;
+  HmacKeyFormat hmac_key_format;
+  hmac_key_format.set_key_size(32);
+  hmac_key_format.mutable_params()->set_tag_size(16);
+  hmac_key_format.mutable_params()->set_hash(HashType::SHA256);
+  AesCmacKeyFormat aes_cmac_key_format;
+  aes_cmac_key_format.set_key_size(32);
+  aes_cmac_key_format.mutable_params()->set_tag_size(16);
+
+  Keyset keyset;
+  AddTinkKey(hmac_key_manager.get_key_type(), 1,
+             *hmac_key_manager.get_key_factory()
+                  .NewKey(hmac_key_format).ValueOrDie(),
+             KeyStatusType::ENABLED, KeyData::SYMMETRIC, &keyset);
+  AddTinkKey(aes_cmac_key_manager.get_key_type(), 2,
+             *aes_cmac_key_manager.get_key_factory()
+                  .NewKey(aes_cmac_key_format).ValueOrDie(),
+             KeyStatusType::ENABLED, KeyData::SYMMETRIC, &keyset);
+  AddRawKey(poly1305_mac_key_manager.get_key_type(), 3,
+            *poly1305_mac_key_manager.get_key_factory()
+                 .NewKey(Poly1305MacKeyFormat()).ValueOrDie(),
+            KeyStatusType::ENABLED, KeyData::SYMMETRIC, &keyset);
+  ASSERT_TRUE(MacConfig::Register().ok());
+
+  std::string data = "some_data_for_mac";
+  std::vector<std::string> mac_values;
+  for (uint32_t primary_key_id : {1, 2, 3}) {
+    keyset.set_primary_key_id(primary_key_id);
+    auto mac_result =
+        MacFactory::GetPrimitive(*KeysetUtil::GetKeysetHandle(keyset));
+    ASSERT_TRUE(mac_result.ok()) << mac_result.status();
+    auto compute_mac_result = mac_result.ValueOrDie()->ComputeMac(data);
+    ASSERT_TRUE(compute_mac_result.ok()) << compute_mac_result.status();
+    mac_values.push_back(compute_mac_result.ValueOrDie());
+  }
+  // The tags have the prefix of the primary key, or none for the RAW key.
+  EXPECT_EQ(5 + 16, mac_values[0].size());
+  EXPECT_EQ(5 + 16, mac_values[1].size());
+  EXPECT_EQ(32, mac_values[2].size());
+
+  // Every tag verifies with the keyset, whichever key is primary.
+  auto mac = std::move(
+      MacFactory::GetPrimitive(*KeysetUtil::GetKeysetHandle(keyset))
+          .ValueOrDie());
+  for (const std::string& mac_value : mac_values) {
+    EXPECT_TRUE(mac->VerifyMac(mac_value, data).ok());
+    EXPECT_FALSE(mac->VerifyMac(mac_value, "bad data for mac").ok());
+  }
+}
+
 }  // namespace
 }  // namespace tink
 }  // namespace crypto
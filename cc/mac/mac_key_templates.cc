@@ -16,18 +16,24 @@
 
 #include "tink/mac/mac_key_templates.h"
 
+#include "proto/aes_cmac.pb.h"
 #include "proto/common.pb.h"
 #include "proto/hmac.pb.h"
+#include "proto/poly1305_mac.pb.h"
 #include "proto/tink.pb.h"
+#include "proto/tree_hmac.pb.h"
 
 namespace crypto {
 namespace tink {
 namespace {
 
+using google::crypto::tink::AesCmacKeyFormat;
 using google::crypto::tink::HmacKeyFormat;
 using google::crypto::tink::HashType;
 using google::crypto::tink::KeyTemplate;
 using google::crypto::tink::OutputPrefixType;
+using google::crypto::tink::Poly1305MacKeyFormat;
+using google::crypto::tink::TreeHmacKeyFormat;
 
 KeyTemplate* NewHmacKeyTemplate(int key_size_in_bytes,
                                 int tag_size_in_bytes,
@@ -44,6 +50,45 @@ KeyTemplate* NewHmacKeyTemplate(int key_size_in_bytes,
   return key_template;
 }
 
+KeyTemplate* NewAesCmacKeyTemplate(int key_size_in_bytes,
+                                   int tag_size_in_bytes) {
+  KeyTemplate* key_template = new KeyTemplate;
+  key_template->set_type_url(
+      "type.googleapis.com/google.crypto.tink.AesCmacKey");
+  key_template->set_output_prefix_type(OutputPrefixType::TINK);
+  AesCmacKeyFormat key_format;
+  key_format.set_key_size(key_size_in_bytes);
+  key_format.mutable_params()->set_tag_size(tag_size_in_bytes);
+  key_format.SerializeToString(key_template->mutable_value());
+  return key_template;
+}
+
+KeyTemplate* NewPoly1305MacKeyTemplate() {
+  KeyTemplate* key_template = new KeyTemplate;
+  key_template->set_type_url(
+      "type.googleapis.com/google.crypto.tink.Poly1305MacKey");
+  key_template->set_output_prefix_type(OutputPrefixType::TINK);
+  Poly1305MacKeyFormat key_format;
+  key_format.SerializeToString(key_template->mutable_value());
+  return key_template;
+}
+
+KeyTemplate* NewTreeHmacKeyTemplate(int key_size_in_bytes,
+                                    int tag_size_in_bytes,
+                                    int chunk_size_in_bytes,
+                                    HashType hash_type) {
+  KeyTemplate* key_template = new KeyTemplate;
+  key_template->set_type_url(
+      "type.googleapis.com/google.crypto.tink.TreeHmacKey");
+  key_template->set_output_prefix_type(OutputPrefixType::TINK);
+  TreeHmacKeyFormat key_format;
+  key_format.set_key_size(key_size_in_bytes);
+  key_format.mutable_params()->set_tag_size(tag_size_in_bytes);
+  key_format.mutable_params()->set_chunk_size(chunk_size_in_bytes);
+  key_format.mutable_params()->set_hash(hash_type);
+  key_format.SerializeToString(key_template->mutable_value());
+  return key_template;
+}
 
 }  // anonymous namespace
 
@@ -65,5 +110,26 @@ const KeyTemplate& MacKeyTemplates::HmacSha256() {
   return *key_template;
 }
 
+const KeyTemplate& MacKeyTemplates::AesCmac() {
+  static const KeyTemplate* key_template =
+      NewAesCmacKeyTemplate(/* key_size_in_bytes= */ 32,
+                            /* tag_size_in_bytes= */ 16);
+  return *key_template;
+}
+
+const KeyTemplate& MacKeyTemplates::Poly1305Mac() {
+  static const KeyTemplate* key_template = NewPoly1305MacKeyTemplate();
+  return *key_template;
+}
+
+const KeyTemplate& MacKeyTemplates::TreeHmacSha256() {
+  static const KeyTemplate* key_template =
+      NewTreeHmacKeyTemplate(/* key_size_in_bytes= */ 32,
+                             /* tag_size_in_bytes= */ 32,
+                             /* chunk_size_in_bytes= */ 1 << 20,
+                             HashType::SHA256);
+  return *key_template;
+}
+
 }  // namespace tink
 }  // namespace crypto
@@ -16,20 +16,29 @@
 
 #include "tink/mac/mac_key_templates.h"
 
+#include "tink/mac/aes_cmac_key_manager.h"
 #include "tink/mac/hmac_key_manager.h"
+#include "tink/mac/poly1305_mac_key_manager.h"
+#include "tink/mac/tree_hmac_key_manager.h"
+#include "proto/aes_cmac.pb.h"
 #include "proto/common.pb.h"
 #include "proto/hmac.pb.h"
+#include "proto/poly1305_mac.pb.h"
 #include "proto/tink.pb.h"
+#include "proto/tree_hmac.pb.h"
 #include "gtest/gtest.h"
 
 namespace crypto {
 namespace tink {
 namespace {
 
+using google::crypto::tink::AesCmacKeyFormat;
 using google::crypto::tink::HashType;
 using google::crypto::tink::HmacKeyFormat;
 using google::crypto::tink::KeyTemplate;
 using google::crypto::tink::OutputPrefixType;
+using google::crypto::tink::Poly1305MacKeyFormat;
+using google::crypto::tink::TreeHmacKeyFormat;
 
 TEST(MacKeyTemplatesTest, testHmacKeyTemplates) {
   std::string type_url = "type.googleapis.com/google.crypto.tink.HmacKey";
@@ -80,6 +89,76 @@ TEST(MacKeyTemplatesTest, testHmacKeyTemplates) {
   }
 }
 
+TEST(MacKeyTemplatesTest, testAesCmacKeyTemplates) {
+  std::string type_url = "type.googleapis.com/google.crypto.tink.AesCmacKey";
+
+  // Check that returned template is correct.
+  const KeyTemplate& key_template = MacKeyTemplates::AesCmac();
+  EXPECT_EQ(type_url, key_template.type_url());
+  EXPECT_EQ(OutputPrefixType::TINK, key_template.output_prefix_type());
+  AesCmacKeyFormat key_format;
+  EXPECT_TRUE(key_format.ParseFromString(key_template.value()));
+  EXPECT_EQ(32, key_format.key_size());
+  EXPECT_EQ(16, key_format.params().tag_size());
+
+  // Check that reference to the same object is returned.
+  const KeyTemplate& key_template_2 = MacKeyTemplates::AesCmac();
+  EXPECT_EQ(&key_template, &key_template_2);
+
+  // Check that the template works with the key manager.
+  AesCmacKeyManager key_manager;
+  EXPECT_EQ(key_manager.get_key_type(), key_template.type_url());
+  auto new_key_result = key_manager.get_key_factory().NewKey(key_format);
+  EXPECT_TRUE(new_key_result.ok()) << new_key_result.status();
+}
+
+TEST(MacKeyTemplatesTest, testPoly1305MacKeyTemplates) {
+  std::string type_url =
+      "type.googleapis.com/google.crypto.tink.Poly1305MacKey";
+
+  // Check that returned template is correct.
+  const KeyTemplate& key_template = MacKeyTemplates::Poly1305Mac();
+  EXPECT_EQ(type_url, key_template.type_url());
+  EXPECT_EQ(OutputPrefixType::TINK, key_template.output_prefix_type());
+  Poly1305MacKeyFormat key_format;
+  EXPECT_TRUE(key_format.ParseFromString(key_template.value()));
+
+  // Check that reference to the same object is returned.
+  const KeyTemplate& key_template_2 = MacKeyTemplates::Poly1305Mac();
+  EXPECT_EQ(&key_template, &key_template_2);
+
+  // Check that the template works with the key manager.
+  Poly1305MacKeyManager key_manager;
+  EXPECT_EQ(key_manager.get_key_type(), key_template.type_url());
+  auto new_key_result = key_manager.get_key_factory().NewKey(key_format);
+  EXPECT_TRUE(new_key_result.ok()) << new_key_result.status();
+}
+
+TEST(MacKeyTemplatesTest, testTreeHmacKeyTemplates) {
+  std::string type_url = "type.googleapis.com/google.crypto.tink.TreeHmacKey";
+
+  // Check that returned template is correct.
+  const KeyTemplate& key_template = MacKeyTemplates::TreeHmacSha256();
+  EXPECT_EQ(type_url, key_template.type_url());
+  EXPECT_EQ(OutputPrefixType::TINK, key_template.output_prefix_type());
+  TreeHmacKeyFormat key_format;
+  EXPECT_TRUE(key_format.ParseFromString(key_template.value()));
+  EXPECT_EQ(32, key_format.key_size());
+  EXPECT_EQ(32, key_format.params().tag_size());
+  EXPECT_EQ(1 << 20, key_format.params().chunk_size());
+  EXPECT_EQ(HashType::SHA256, key_format.params().hash());
+
+  // Check that reference to the same object is returned.
+  const KeyTemplate& key_template_2 = MacKeyTemplates::TreeHmacSha256();
+  EXPECT_EQ(&key_template, &key_template_2);
+
+  // Check that the template works with the key manager.
+  TreeHmacKeyManager key_manager;
+  EXPECT_EQ(key_manager.get_key_type(), key_template.type_url());
+  auto new_key_result = key_manager.get_key_factory().NewKey(key_format);
+  EXPECT_TRUE(new_key_result.ok()) << new_key_result.status();
+}
+
 }  // namespace
 }  // namespace tink
 }  // namespace crypto
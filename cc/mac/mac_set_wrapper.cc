@@ -18,6 +18,7 @@
 
 #include "tink/crypto_format.h"
 #include "tink/mac.h"
+#include "tink/output_buffer.h"
 #include "tink/primitive_set.h"
 #include "tink/subtle/subtle_util_boringssl.h"
 #include "tink/util/status.h"
@@ -73,6 +74,23 @@ util::StatusOr<std::string> MacSetWrapper::ComputeMac(
   return key_id + compute_mac_result.ValueOrDie();
 }
 
+util::Status MacSetWrapper::ComputeMacInto(absl::string_view data,
+                                           OutputBuffer* mac_value) const {
+  data = subtle::SubtleUtilBoringSSL::EnsureNonNull(data);
+
+  auto primary = mac_set_->get_primary();
+  std::string local_data;
+  if (primary->get_output_prefix_type() == OutputPrefixType::LEGACY) {
+    local_data = std::string(data);
+    local_data.append(
+        reinterpret_cast<const char*>(&CryptoFormat::kLegacyStartByte), 1);
+    data = local_data;
+  }
+  // The primitive writes its MAC right after the key prefix.
+  PrefixedOutputBuffer output(primary->get_identifier(), mac_value);
+  return primary->get_primitive().ComputeMacInto(data, &output);
+}
+
 util::Status MacSetWrapper::VerifyMac(
     absl::string_view mac_value,
     absl::string_view data) const {
@@ -19,6 +19,7 @@
 
 #include "absl/strings/string_view.h"
 #include "tink/mac.h"
+#include "tink/output_buffer.h"
 #include "tink/primitive_set.h"
 #include "tink/util/status.h"
 #include "tink/util/statusor.h"
@@ -42,6 +43,9 @@ class MacSetWrapper : public Mac {
   crypto::tink::util::StatusOr<std::string> ComputeMac(
       absl::string_view data) const override;
 
+  crypto::tink::util::Status ComputeMacInto(
+      absl::string_view data, OutputBuffer* mac_value) const override;
+
   crypto::tink::util::Status VerifyMac(
       absl::string_view mac_value,
       absl::string_view data) const override;
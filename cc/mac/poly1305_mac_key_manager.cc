@@ -0,0 +1,202 @@
+// Copyright 2018 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/mac/poly1305_mac_key_manager.h"
+
+#include "absl/strings/string_view.h"
+#include "tink/mac.h"
+#include "tink/key_manager.h"
+#include "tink/subtle/poly1305_mac_boringssl.h"
+#include "tink/subtle/random.h"
+#include "tink/util/errors.h"
+#include "tink/util/protobuf_helper.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "tink/util/validation.h"
+#include "proto/poly1305_mac.pb.h"
+#include "proto/tink.pb.h"
+
+namespace crypto {
+namespace tink {
+
+using crypto::tink::util::Status;
+using crypto::tink::util::StatusOr;
+using google::crypto::tink::KeyData;
+using google::crypto::tink::Poly1305MacKey;
+using google::crypto::tink::Poly1305MacKeyFormat;
+using portable_proto::MessageLite;
+
+namespace {
+
+const int kKeySizeInBytes = 32;
+
+}  // namespace
+
+class Poly1305MacKeyFactory : public KeyFactory {
+ public:
+  Poly1305MacKeyFactory() {}
+
+  // Generates a new random Poly1305MacKey, based on the specified
+  // 'key_format', which must contain Poly1305MacKeyFormat-proto.
+  crypto::tink::util::StatusOr<std::unique_ptr<portable_proto::MessageLite>>
+  NewKey(const portable_proto::MessageLite& key_format) const override;
+
+  // Generates a new random Poly1305MacKey, based on the specified
+  // 'serialized_key_format', which must contain
+  // Poly1305MacKeyFormat-proto.
+  crypto::tink::util::StatusOr<std::unique_ptr<portable_proto::MessageLite>>
+  NewKey(absl::string_view serialized_key_format) const override;
+
+  // Generates a new random Poly1305MacKey, based on the specified
+  // 'serialized_key_format' (which must contain
+  // Poly1305MacKeyFormat-proto), and wraps it in a KeyData-proto.
+  crypto::tink::util::StatusOr<std::unique_ptr<google::crypto::tink::KeyData>>
+  NewKeyData(absl::string_view serialized_key_format) const override;
+};
+
+StatusOr<std::unique_ptr<MessageLite>> Poly1305MacKeyFactory::NewKey(
+    const portable_proto::MessageLite& key_format) const {
+  std::string key_format_url =
+      std::string(Poly1305MacKeyManager::kKeyTypePrefix) +
+      key_format.GetTypeName();
+  if (key_format_url != Poly1305MacKeyManager::kKeyFormatUrl) {
+    return ToStatusF(util::error::INVALID_ARGUMENT,
+                     "Key format proto '%s' is not supported by this manager.",
+                     key_format_url.c_str());
+  }
+  const Poly1305MacKeyFormat& poly1305_mac_key_format =
+      reinterpret_cast<const Poly1305MacKeyFormat&>(key_format);
+  Status status =
+      Poly1305MacKeyManager::Validate(poly1305_mac_key_format);
+  if (!status.ok()) return status;
+
+  // Generate Poly1305MacKey.
+  std::unique_ptr<Poly1305MacKey> poly1305_mac_key(
+      new Poly1305MacKey());
+  poly1305_mac_key->set_version(Poly1305MacKeyManager::kVersion);
+  poly1305_mac_key->set_key_value(
+      subtle::Random::GetRandomBytes(kKeySizeInBytes));
+  std::unique_ptr<MessageLite> key = std::move(poly1305_mac_key);
+  return std::move(key);
+}
+
+StatusOr<std::unique_ptr<MessageLite>> Poly1305MacKeyFactory::NewKey(
+    absl::string_view serialized_key_format) const {
+  Poly1305MacKeyFormat key_format;
+  if (!key_format.ParseFromString(std::string(serialized_key_format))) {
+    return ToStatusF(util::error::INVALID_ARGUMENT,
+                     "Could not parse the passed string as proto '%s'.",
+                     Poly1305MacKeyManager::kKeyFormatUrl);
+  }
+  return NewKey(key_format);
+}
+
+StatusOr<std::unique_ptr<KeyData>> Poly1305MacKeyFactory::NewKeyData(
+    absl::string_view serialized_key_format) const {
+  auto new_key_result = NewKey(serialized_key_format);
+  if (!new_key_result.ok()) return new_key_result.status();
+  auto new_key = reinterpret_cast<const Poly1305MacKey&>(
+      *(new_key_result.ValueOrDie()));
+  std::unique_ptr<KeyData> key_data(new KeyData());
+  key_data->set_type_url(Poly1305MacKeyManager::kKeyType);
+  key_data->set_value(new_key.SerializeAsString());
+  key_data->set_key_material_type(KeyData::SYMMETRIC);
+  return std::move(key_data);
+}
+
+constexpr char Poly1305MacKeyManager::kKeyFormatUrl[];
+constexpr char Poly1305MacKeyManager::kKeyTypePrefix[];
+constexpr char Poly1305MacKeyManager::kKeyType[];
+constexpr uint32_t Poly1305MacKeyManager::kVersion;
+
+Poly1305MacKeyManager::Poly1305MacKeyManager()
+    : key_type_(kKeyType), key_factory_(new Poly1305MacKeyFactory()) {}
+
+const std::string& Poly1305MacKeyManager::get_key_type() const {
+  return key_type_;
+}
+
+uint32_t Poly1305MacKeyManager::get_version() const { return kVersion; }
+
+const KeyFactory& Poly1305MacKeyManager::get_key_factory() const {
+  return *key_factory_;
+}
+
+StatusOr<std::unique_ptr<Mac>> Poly1305MacKeyManager::GetPrimitive(
+    const KeyData& key_data) const {
+  if (DoesSupport(key_data.type_url())) {
+    Poly1305MacKey poly1305_mac_key;
+    if (!poly1305_mac_key.ParseFromString(key_data.value())) {
+      return ToStatusF(util::error::INVALID_ARGUMENT,
+                       "Could not parse key_data.value as key type '%s'.",
+                       key_data.type_url().c_str());
+    }
+    return GetPrimitiveImpl(poly1305_mac_key);
+  } else {
+    return ToStatusF(util::error::INVALID_ARGUMENT,
+                     "Key type '%s' is not supported by this manager.",
+                     key_data.type_url().c_str());
+  }
+}
+
+StatusOr<std::unique_ptr<Mac>> Poly1305MacKeyManager::GetPrimitive(
+    const MessageLite& key) const {
+  std::string key_type = std::string(kKeyTypePrefix) + key.GetTypeName();
+  if (DoesSupport(key_type)) {
+    const Poly1305MacKey& poly1305_mac_key =
+        reinterpret_cast<const Poly1305MacKey&>(key);
+    return GetPrimitiveImpl(poly1305_mac_key);
+  } else {
+    return ToStatusF(util::error::INVALID_ARGUMENT,
+                     "Key type '%s' is not supported by this manager.",
+                     key_type.c_str());
+  }
+}
+
+StatusOr<std::unique_ptr<Mac>> Poly1305MacKeyManager::GetPrimitiveImpl(
+    const Poly1305MacKey& poly1305_mac_key) const {
+  Status status = Validate(poly1305_mac_key);
+  if (!status.ok()) return status;
+  auto poly1305_mac_result = subtle::Poly1305MacBoringSsl::New(
+      poly1305_mac_key.key_value());
+  if (!poly1305_mac_result.ok())
+    return poly1305_mac_result.status();
+  return std::move(poly1305_mac_result.ValueOrDie());
+}
+
+// static
+Status Poly1305MacKeyManager::Validate(const Poly1305MacKey& key) {
+  Status status = ValidateVersion(key.version(), kVersion);
+  if (!status.ok()) return status;
+  uint32_t key_size = key.key_value().size();
+  if (key_size != kKeySizeInBytes) {
+    return ToStatusF(util::error::INVALID_ARGUMENT,
+                     "Invalid Poly1305MacKey: key_value has %d bytes; "
+                     "supported size: %d bytes.",
+                     key_size, kKeySizeInBytes);
+  }
+  return Status::OK;
+}
+
+// static
+Status Poly1305MacKeyManager::Validate(
+    const Poly1305MacKeyFormat& key_format) {
+  // Poly1305MacKeyFormat has no parameters.
+  return Status::OK;
+}
+
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,269 @@
+// Copyright 2018 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include "tink/mac/poly1305_mac_key_manager.h"
+
+#include "gtest/gtest.h"
+#include "tink/mac.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "proto/aes_eax.pb.h"
+#include "proto/common.pb.h"
+#include "proto/poly1305_mac.pb.h"
+#include "proto/tink.pb.h"
+
+namespace crypto {
+namespace tink {
+
+using google::crypto::tink::AesEaxKey;
+using google::crypto::tink::AesEaxKeyFormat;
+using google::crypto::tink::KeyData;
+using google::crypto::tink::KeyTemplate;
+using google::crypto::tink::Poly1305MacKey;
+using google::crypto::tink::Poly1305MacKeyFormat;
+
+namespace {
+
+class Poly1305MacKeyManagerTest : public ::testing::Test {
+ protected:
+  std::string key_type_prefix = "type.googleapis.com/";
+  std::string poly1305_mac_key_type =
+      "type.googleapis.com/google.crypto.tink.Poly1305MacKey";
+};
+
+TEST_F(Poly1305MacKeyManagerTest, testBasic) {
+  Poly1305MacKeyManager key_manager;
+
+  EXPECT_EQ(0, key_manager.get_version());
+  EXPECT_EQ("type.googleapis.com/google.crypto.tink.Poly1305MacKey",
+            key_manager.get_key_type());
+  EXPECT_TRUE(key_manager.DoesSupport(key_manager.get_key_type()));
+}
+
+TEST_F(Poly1305MacKeyManagerTest, testKeyDataErrors) {
+  Poly1305MacKeyManager key_manager;
+
+  {  // Bad key type.
+    KeyData key_data;
+    std::string bad_key_type =
+        "type.googleapis.com/google.crypto.tink.SomeOtherKey";
+    key_data.set_type_url(bad_key_type);
+    auto result = key_manager.GetPrimitive(key_data);
+    EXPECT_FALSE(result.ok());
+    EXPECT_EQ(util::error::INVALID_ARGUMENT, result.status().error_code());
+    EXPECT_PRED_FORMAT2(testing::IsSubstring, "not supported",
+                        result.status().error_message());
+    EXPECT_PRED_FORMAT2(testing::IsSubstring, bad_key_type,
+                        result.status().error_message());
+  }
+
+  {  // Bad key value.
+    KeyData key_data;
+    key_data.set_type_url(poly1305_mac_key_type);
+    key_data.set_value("some bad serialized proto");
+    auto result = key_manager.GetPrimitive(key_data);
+    EXPECT_FALSE(result.ok());
+    EXPECT_EQ(util::error::INVALID_ARGUMENT, result.status().error_code());
+    EXPECT_PRED_FORMAT2(testing::IsSubstring, "not parse",
+                        result.status().error_message());
+  }
+
+  {  // Bad version.
+    KeyData key_data;
+    Poly1305MacKey key;
+    key.set_version(1);
+    key_data.set_type_url(poly1305_mac_key_type);
+    key_data.set_value(key.SerializeAsString());
+    auto result = key_manager.GetPrimitive(key_data);
+    EXPECT_FALSE(result.ok());
+    EXPECT_EQ(util::error::INVALID_ARGUMENT, result.status().error_code());
+    EXPECT_PRED_FORMAT2(testing::IsSubstring, "version",
+                        result.status().error_message());
+  }
+
+  {  // Bad key_value size (supported size: 32).
+    for (int len = 0; len < 42; len++) {
+      Poly1305MacKey key;
+      key.set_version(0);
+      key.set_key_value(std::string(len, 'a'));
+      KeyData key_data;
+      key_data.set_type_url(poly1305_mac_key_type);
+      key_data.set_value(key.SerializeAsString());
+      auto result = key_manager.GetPrimitive(key_data);
+      if (len == 32) {
+        EXPECT_TRUE(result.ok()) << result.status();
+      } else {
+        EXPECT_FALSE(result.ok());
+        EXPECT_EQ(util::error::INVALID_ARGUMENT,
+                  result.status().error_code());
+        EXPECT_PRED_FORMAT2(testing::IsSubstring,
+                            std::to_string(len) + " bytes",
+                            result.status().error_message());
+        EXPECT_PRED_FORMAT2(testing::IsSubstring, "supported size",
+                            result.status().error_message());
+      }
+    }
+  }
+}
+
+TEST_F(Poly1305MacKeyManagerTest, testKeyMessageErrors) {
+  Poly1305MacKeyManager key_manager;
+
+  {  // Bad protobuffer.
+    AesEaxKey key;
+    auto result = key_manager.GetPrimitive(key);
+    EXPECT_FALSE(result.ok());
+    EXPECT_EQ(util::error::INVALID_ARGUMENT, result.status().error_code());
+    EXPECT_PRED_FORMAT2(testing::IsSubstring, "AesEaxKey",
+                        result.status().error_message());
+    EXPECT_PRED_FORMAT2(testing::IsSubstring, "not supported",
+                        result.status().error_message());
+  }
+
+  {  // Bad key_value size (supported size: 32).
+    for (int len = 0; len < 42; len++) {
+      Poly1305MacKey key;
+      key.set_version(0);
+      key.set_key_value(std::string(len, 'a'));
+      auto result = key_manager.GetPrimitive(key);
+      if (len == 32) {
+        EXPECT_TRUE(result.ok()) << result.status();
+      } else {
+        EXPECT_FALSE(result.ok());
+        EXPECT_EQ(util::error::INVALID_ARGUMENT,
+                  result.status().error_code());
+        EXPECT_PRED_FORMAT2(testing::IsSubstring,
+                            std::to_string(len) + " bytes",
+                            result.status().error_message());
+        EXPECT_PRED_FORMAT2(testing::IsSubstring, "supported size",
+                            result.status().error_message());
+      }
+    }
+  }
+}
+
+TEST_F(Poly1305MacKeyManagerTest, testPrimitives) {
+  std::string data = "some data";
+  Poly1305MacKeyManager key_manager;
+  Poly1305MacKey key;
+
+  key.set_version(0);
+  key.set_key_value("32 bytes of key 0123456789abcdef");
+
+  {  // Using key message only.
+    auto result = key_manager.GetPrimitive(key);
+    EXPECT_TRUE(result.ok()) << result.status();
+    auto poly1305_mac = std::move(result.ValueOrDie());
+    auto mac_result = poly1305_mac->ComputeMac(data);
+    EXPECT_TRUE(mac_result.ok()) << mac_result.status();
+    EXPECT_EQ(32, mac_result.ValueOrDie().size());
+    auto status = poly1305_mac->VerifyMac(mac_result.ValueOrDie(), data);
+    EXPECT_TRUE(status.ok()) << status;
+  }
+
+  {  // Using KeyData proto.
+    KeyData key_data;
+    key_data.set_type_url(poly1305_mac_key_type);
+    key_data.set_value(key.SerializeAsString());
+    auto result = key_manager.GetPrimitive(key_data);
+    EXPECT_TRUE(result.ok()) << result.status();
+    auto poly1305_mac = std::move(result.ValueOrDie());
+    auto mac_result = poly1305_mac->ComputeMac(data);
+    EXPECT_TRUE(mac_result.ok()) << mac_result.status();
+    auto status = poly1305_mac->VerifyMac(mac_result.ValueOrDie(), data);
+    EXPECT_TRUE(status.ok()) << status;
+    EXPECT_FALSE(
+        poly1305_mac->VerifyMac(mac_result.ValueOrDie(), "other data").ok());
+  }
+}
+
+TEST_F(Poly1305MacKeyManagerTest, testNewKeyErrors) {
+  Poly1305MacKeyManager key_manager;
+  const KeyFactory& key_factory = key_manager.get_key_factory();
+
+  {  // Bad key format.
+    AesEaxKeyFormat key_format;
+    auto result = key_factory.NewKey(key_format);
+    EXPECT_FALSE(result.ok());
+    EXPECT_EQ(util::error::INVALID_ARGUMENT, result.status().error_code());
+    EXPECT_PRED_FORMAT2(testing::IsSubstring, "not supported",
+                        result.status().error_message());
+    EXPECT_PRED_FORMAT2(testing::IsSubstring, "AesEaxKeyFormat",
+                        result.status().error_message());
+  }
+
+  {  // Bad serialized key format.
+    auto result = key_factory.NewKey("some bad serialized proto");
+    EXPECT_FALSE(result.ok());
+    EXPECT_EQ(util::error::INVALID_ARGUMENT, result.status().error_code());
+    EXPECT_PRED_FORMAT2(testing::IsSubstring, "not parse",
+                        result.status().error_message());
+  }
+}
+
+TEST_F(Poly1305MacKeyManagerTest, testNewKeyBasic) {
+  Poly1305MacKeyManager key_manager;
+  const KeyFactory& key_factory = key_manager.get_key_factory();
+  Poly1305MacKeyFormat key_format;
+
+  { // Via NewKey(format_proto).
+    auto result = key_factory.NewKey(key_format);
+    EXPECT_TRUE(result.ok()) << result.status();
+    auto key = std::move(result.ValueOrDie());
+    EXPECT_EQ(key_type_prefix + key->GetTypeName(), poly1305_mac_key_type);
+    std::unique_ptr<Poly1305MacKey> poly1305_mac_key(
+        reinterpret_cast<Poly1305MacKey*>(key.release()));
+    EXPECT_EQ(0, poly1305_mac_key->version());
+    EXPECT_EQ(32, poly1305_mac_key->key_value().size());
+  }
+
+  { // Via NewKey(serialized_format_proto).
+    auto result = key_factory.NewKey(key_format.SerializeAsString());
+    EXPECT_TRUE(result.ok()) << result.status();
+    auto key = std::move(result.ValueOrDie());
+    EXPECT_EQ(key_type_prefix + key->GetTypeName(), poly1305_mac_key_type);
+    std::unique_ptr<Poly1305MacKey> poly1305_mac_key(
+        reinterpret_cast<Poly1305MacKey*>(key.release()));
+    EXPECT_EQ(0, poly1305_mac_key->version());
+    EXPECT_EQ(32, poly1305_mac_key->key_value().size());
+  }
+
+  {  // Via NewKey with an empty serialized format, as in the Java template.
+    auto result = key_factory.NewKey("");
+    EXPECT_TRUE(result.ok()) << result.status();
+  }
+
+  { // Via NewKeyData(serialized_format_proto).
+    auto result = key_factory.NewKeyData(key_format.SerializeAsString());
+    EXPECT_TRUE(result.ok()) << result.status();
+    auto key_data = std::move(result.ValueOrDie());
+    EXPECT_EQ(poly1305_mac_key_type, key_data->type_url());
+    EXPECT_EQ(KeyData::SYMMETRIC, key_data->key_material_type());
+    Poly1305MacKey poly1305_mac_key;
+    EXPECT_TRUE(poly1305_mac_key.ParseFromString(key_data->value()));
+    EXPECT_EQ(0, poly1305_mac_key.version());
+    EXPECT_EQ(32, poly1305_mac_key.key_value().size());
+  }
+}
+
+}  // namespace
+}  // namespace tink
+}  // namespace crypto
+
+int main(int ac, char* av[]) {
+  testing::InitGoogleTest(&ac, av);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,242 @@
+// Copyright 2018 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/mac/tree_hmac_key_manager.h"
+
+#include <map>
+
+#include "absl/strings/string_view.h"
+#include "tink/mac.h"
+#include "tink/key_manager.h"
+#include "tink/subtle/tree_hmac_boringssl.h"
+#include "tink/subtle/random.h"
+#include "tink/util/enums.h"
+#include "tink/util/errors.h"
+#include "tink/util/protobuf_helper.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "tink/util/validation.h"
+#include "proto/common.pb.h"
+#include "proto/tree_hmac.pb.h"
+#include "proto/tink.pb.h"
+
+namespace crypto {
+namespace tink {
+
+using google::crypto::tink::HashType;
+using google::crypto::tink::TreeHmacKey;
+using google::crypto::tink::TreeHmacKeyFormat;
+using google::crypto::tink::TreeHmacParams;
+using google::crypto::tink::KeyData;
+using google::crypto::tink::KeyTemplate;
+using portable_proto::MessageLite;
+using crypto::tink::util::Enums;
+using crypto::tink::util::Status;
+using crypto::tink::util::StatusOr;
+
+class TreeHmacKeyFactory : public KeyFactory {
+ public:
+  TreeHmacKeyFactory() {}
+
+  // Generates a new random TreeHmacKey, based on the specified 'key_format',
+  // which must contain TreeHmacKeyFormat-proto.
+  crypto::tink::util::StatusOr<std::unique_ptr<portable_proto::MessageLite>>
+  NewKey(const portable_proto::MessageLite& key_format) const override;
+
+
+  // Generates a new random TreeHmacKey, based on the specified
+  // 'serialized_key_format', which must contain TreeHmacKeyFormat-proto.
+  crypto::tink::util::StatusOr<std::unique_ptr<portable_proto::MessageLite>>
+  NewKey(absl::string_view serialized_key_format) const override;
+
+  // Generates a new random TreeHmacKey, based on the specified
+  // 'serialized_key_format' (which must contain TreeHmacKeyFormat-proto),
+  // and wraps it in a KeyData-proto.
+  crypto::tink::util::StatusOr<std::unique_ptr<google::crypto::tink::KeyData>>
+  NewKeyData(absl::string_view serialized_key_format) const override;
+};
+
+StatusOr<std::unique_ptr<MessageLite>> TreeHmacKeyFactory::NewKey(
+    const portable_proto::MessageLite& key_format) const {
+  std::string key_format_url =
+      std::string(TreeHmacKeyManager::kKeyTypePrefix) +
+      key_format.GetTypeName();
+  if (key_format_url != TreeHmacKeyManager::kKeyFormatUrl) {
+    return ToStatusF(util::error::INVALID_ARGUMENT,
+                     "Key format proto '%s' is not supported by this manager.",
+                     key_format_url.c_str());
+  }
+  const TreeHmacKeyFormat& tree_hmac_key_format =
+      reinterpret_cast<const TreeHmacKeyFormat&>(key_format);
+  Status status = TreeHmacKeyManager::Validate(tree_hmac_key_format);
+  if (!status.ok()) return status;
+
+  // Generate TreeHmacKey.
+  std::unique_ptr<TreeHmacKey> tree_hmac_key(new TreeHmacKey());
+  tree_hmac_key->set_version(TreeHmacKeyManager::kVersion);
+  *(tree_hmac_key->mutable_params()) = tree_hmac_key_format.params();
+  tree_hmac_key->set_key_value(
+      subtle::Random::GetRandomBytes(tree_hmac_key_format.key_size()));
+  std::unique_ptr<MessageLite> key = std::move(tree_hmac_key);
+  return std::move(key);
+}
+
+StatusOr<std::unique_ptr<MessageLite>> TreeHmacKeyFactory::NewKey(
+    absl::string_view serialized_key_format) const {
+  TreeHmacKeyFormat key_format;
+  if (!key_format.ParseFromString(std::string(serialized_key_format))) {
+    return ToStatusF(util::error::INVALID_ARGUMENT,
+                     "Could not parse the passed string as proto '%s'.",
+                     TreeHmacKeyManager::kKeyFormatUrl);
+  }
+  return NewKey(key_format);
+}
+
+StatusOr<std::unique_ptr<KeyData>> TreeHmacKeyFactory::NewKeyData(
+    absl::string_view serialized_key_format) const {
+  auto new_key_result = NewKey(serialized_key_format);
+  if (!new_key_result.ok()) return new_key_result.status();
+  auto new_key = reinterpret_cast<const TreeHmacKey&>(
+      *(new_key_result.ValueOrDie()));
+  std::unique_ptr<KeyData> key_data(new KeyData());
+  key_data->set_type_url(TreeHmacKeyManager::kKeyType);
+  key_data->set_value(new_key.SerializeAsString());
+  key_data->set_key_material_type(KeyData::SYMMETRIC);
+  return std::move(key_data);
+}
+
+constexpr char TreeHmacKeyManager::kKeyFormatUrl[];
+constexpr char TreeHmacKeyManager::kKeyTypePrefix[];
+constexpr char TreeHmacKeyManager::kKeyType[];
+constexpr uint32_t TreeHmacKeyManager::kVersion;
+
+const int kMinKeySizeInBytes = 16;
+const int kMinTagSizeInBytes = 10;
+const uint32_t kMinChunkSizeInBytes = 1 << 10;
+const uint32_t kMaxChunkSizeInBytes = 1 << 26;
+
+TreeHmacKeyManager::TreeHmacKeyManager()
+    : key_type_(kKeyType), key_factory_(new TreeHmacKeyFactory()) {}
+
+const std::string& TreeHmacKeyManager::get_key_type() const {
+  return key_type_;
+}
+
+uint32_t TreeHmacKeyManager::get_version() const {
+  return kVersion;
+}
+
+const KeyFactory& TreeHmacKeyManager::get_key_factory() const {
+  return *key_factory_;
+}
+
+StatusOr<std::unique_ptr<Mac>>
+TreeHmacKeyManager::GetPrimitive(const KeyData& key_data) const {
+  if (DoesSupport(key_data.type_url())) {
+    TreeHmacKey tree_hmac_key;
+    if (!tree_hmac_key.ParseFromString(key_data.value())) {
+      return ToStatusF(util::error::INVALID_ARGUMENT,
+                       "Could not parse key_data.value as key type '%s'.",
+                       key_data.type_url().c_str());
+    }
+    return GetPrimitiveImpl(tree_hmac_key);
+  } else {
+    return ToStatusF(util::error::INVALID_ARGUMENT,
+                     "Key type '%s' is not supported by this manager.",
+                     key_data.type_url().c_str());
+  }
+}
+
+StatusOr<std::unique_ptr<Mac>>
+TreeHmacKeyManager::GetPrimitive(const MessageLite& key) const {
+  std::string key_type = std::string(kKeyTypePrefix) + key.GetTypeName();
+  if (DoesSupport(key_type)) {
+    const TreeHmacKey& tree_hmac_key =
+        reinterpret_cast<const TreeHmacKey&>(key);
+    return GetPrimitiveImpl(tree_hmac_key);
+  } else {
+    return ToStatusF(util::error::INVALID_ARGUMENT,
+                     "Key type '%s' is not supported by this manager.",
+                     key_type.c_str());
+  }
+}
+
+StatusOr<std::unique_ptr<Mac>>
+TreeHmacKeyManager::GetPrimitiveImpl(const TreeHmacKey& tree_hmac_key) const {
+  Status status = Validate(tree_hmac_key);
+  if (!status.ok()) return status;
+  auto tree_hmac_result = subtle::TreeHmacBoringSsl::New(
+      util::Enums::ProtoToSubtle(tree_hmac_key.params().hash()),
+      tree_hmac_key.params().tag_size(),
+      tree_hmac_key.params().chunk_size(),
+      tree_hmac_key.key_value());
+  if (!tree_hmac_result.ok()) return tree_hmac_result.status();
+  std::unique_ptr<Mac> tree_hmac = std::move(tree_hmac_result.ValueOrDie());
+  return std::move(tree_hmac);
+}
+
+// static
+Status TreeHmacKeyManager::Validate(const TreeHmacParams& params) {
+  if (params.tag_size() < kMinTagSizeInBytes) {
+    return ToStatusF(util::error::INVALID_ARGUMENT,
+                     "Invalid TreeHmacParams: tag_size %d is too small.",
+                     params.tag_size());
+  }
+  std::map<HashType, uint32_t> max_tag_size = {{HashType::SHA256, 32},
+                                               {HashType::SHA512, 64}};
+  if (max_tag_size.find(params.hash()) == max_tag_size.end()) {
+    return ToStatusF(util::error::INVALID_ARGUMENT,
+                     "Invalid TreeHmacParams: HashType '%s' not supported.",
+                     Enums::HashName(params.hash()));
+  }
+  if (params.tag_size() > max_tag_size[params.hash()]) {
+    return ToStatusF(util::error::INVALID_ARGUMENT,
+        "Invalid TreeHmacParams: tag_size %d is too big for HashType '%s'.",
+        params.tag_size(), Enums::HashName(params.hash()));
+  }
+  if (params.chunk_size() < kMinChunkSizeInBytes ||
+      params.chunk_size() > kMaxChunkSizeInBytes) {
+    return ToStatusF(util::error::INVALID_ARGUMENT,
+                     "Invalid TreeHmacParams: chunk_size %d is not between "
+                     "%d and %d.",
+                     params.chunk_size(), kMinChunkSizeInBytes,
+                     kMaxChunkSizeInBytes);
+  }
+  return Status::OK;
+}
+
+// static
+Status TreeHmacKeyManager::Validate(const TreeHmacKey& key) {
+  Status status = ValidateVersion(key.version(), kVersion);
+  if (!status.ok()) return status;
+  if (key.key_value().size() < kMinKeySizeInBytes) {
+      return ToStatusF(util::error::INVALID_ARGUMENT,
+                       "Invalid TreeHmacKey: key_value is too short.");
+  }
+  return Validate(key.params());
+}
+
+// static
+Status TreeHmacKeyManager::Validate(const TreeHmacKeyFormat& key_format) {
+  if (key_format.key_size() < kMinKeySizeInBytes) {
+      return ToStatusF(util::error::INVALID_ARGUMENT,
+                       "Invalid TreeHmacKeyFormat: key_size is too small.");
+  }
+  return Validate(key_format.params());
+}
+
+}  // namespace tink
+}  // namespace crypto
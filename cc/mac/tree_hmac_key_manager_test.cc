@@ -0,0 +1,308 @@
+// Copyright 2018 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/mac/tree_hmac_key_manager.h"
+
+#include "tink/mac.h"
+#include "tink/subtle/tree_hmac_boringssl.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "tink/util/test_util.h"
+#include "gtest/gtest.h"
+#include "proto/aes_ctr.pb.h"
+#include "proto/common.pb.h"
+#include "proto/tink.pb.h"
+#include "proto/tree_hmac.pb.h"
+
+namespace crypto {
+namespace tink {
+
+using google::crypto::tink::AesCtrKey;
+using google::crypto::tink::AesCtrKeyFormat;
+using google::crypto::tink::HashType;
+using google::crypto::tink::KeyData;
+using google::crypto::tink::TreeHmacKey;
+using google::crypto::tink::TreeHmacKeyFormat;
+
+namespace {
+
+class TreeHmacKeyManagerTest : public ::testing::Test {
+ protected:
+  TreeHmacKey NewKey(HashType hash, uint32_t tag_size, uint32_t chunk_size) {
+    TreeHmacKey key;
+    key.set_version(0);
+    key.set_key_value(std::string(32, 'k'));
+    key.mutable_params()->set_hash(hash);
+    key.mutable_params()->set_tag_size(tag_size);
+    key.mutable_params()->set_chunk_size(chunk_size);
+    return key;
+  }
+
+  std::string key_type_prefix = "type.googleapis.com/";
+  std::string tree_hmac_key_type =
+      "type.googleapis.com/google.crypto.tink.TreeHmacKey";
+};
+
+TEST_F(TreeHmacKeyManagerTest, testBasic) {
+  TreeHmacKeyManager key_manager;
+
+  EXPECT_EQ(0, key_manager.get_version());
+  EXPECT_EQ("type.googleapis.com/google.crypto.tink.TreeHmacKey",
+            key_manager.get_key_type());
+  EXPECT_TRUE(key_manager.DoesSupport(key_manager.get_key_type()));
+}
+
+TEST_F(TreeHmacKeyManagerTest, testKeyDataErrors) {
+  TreeHmacKeyManager key_manager;
+
+  {  // Bad key type.
+    KeyData key_data;
+    std::string bad_key_type =
+        "type.googleapis.com/google.crypto.tink.SomeOtherKey";
+    key_data.set_type_url(bad_key_type);
+    auto result = key_manager.GetPrimitive(key_data);
+    EXPECT_FALSE(result.ok());
+    EXPECT_EQ(util::error::INVALID_ARGUMENT, result.status().error_code());
+    EXPECT_PRED_FORMAT2(testing::IsSubstring, "not supported",
+                        result.status().error_message());
+    EXPECT_PRED_FORMAT2(testing::IsSubstring, bad_key_type,
+                        result.status().error_message());
+  }
+
+  {  // Bad key value.
+    KeyData key_data;
+    key_data.set_type_url(tree_hmac_key_type);
+    key_data.set_value("some bad serialized proto");
+    auto result = key_manager.GetPrimitive(key_data);
+    EXPECT_FALSE(result.ok());
+    EXPECT_EQ(util::error::INVALID_ARGUMENT, result.status().error_code());
+    EXPECT_PRED_FORMAT2(testing::IsSubstring, "not parse",
+                        result.status().error_message());
+  }
+
+  {  // Bad version.
+    KeyData key_data;
+    TreeHmacKey key = NewKey(HashType::SHA256, 32, 1 << 20);
+    key.set_version(1);
+    key_data.set_type_url(tree_hmac_key_type);
+    key_data.set_value(key.SerializeAsString());
+    auto result = key_manager.GetPrimitive(key_data);
+    EXPECT_FALSE(result.ok());
+    EXPECT_EQ(util::error::INVALID_ARGUMENT, result.status().error_code());
+    EXPECT_PRED_FORMAT2(testing::IsSubstring, "version",
+                        result.status().error_message());
+  }
+
+  {  // Bad key_value size (at least 16 bytes).
+    for (int len = 0; len < 42; len++) {
+      TreeHmacKey key = NewKey(HashType::SHA256, 32, 1 << 20);
+      key.set_key_value(std::string(len, 'a'));
+      KeyData key_data;
+      key_data.set_type_url(tree_hmac_key_type);
+      key_data.set_value(key.SerializeAsString());
+      auto result = key_manager.GetPrimitive(key_data);
+      if (len >= 16) {
+        EXPECT_TRUE(result.ok()) << result.status();
+      } else {
+        EXPECT_FALSE(result.ok());
+        EXPECT_EQ(util::error::INVALID_ARGUMENT,
+                  result.status().error_code());
+        EXPECT_PRED_FORMAT2(testing::IsSubstring, "too short",
+                            result.status().error_message());
+      }
+    }
+  }
+}
+
+TEST_F(TreeHmacKeyManagerTest, testKeyMessageErrors) {
+  TreeHmacKeyManager key_manager;
+
+  {  // Bad protobuffer.
+    AesCtrKey key_message;
+    auto result = key_manager.GetPrimitive(key_message);
+    EXPECT_FALSE(result.ok());
+    EXPECT_EQ(util::error::INVALID_ARGUMENT, result.status().error_code());
+    EXPECT_PRED_FORMAT2(testing::IsSubstring, "AesCtrKey",
+                        result.status().error_message());
+    EXPECT_PRED_FORMAT2(testing::IsSubstring, "not supported",
+                        result.status().error_message());
+  }
+
+  {  // Bad hash.
+    for (HashType hash : {HashType::UNKNOWN_HASH, HashType::SHA1}) {
+      auto result = key_manager.GetPrimitive(NewKey(hash, 16, 1 << 20));
+      EXPECT_FALSE(result.ok());
+      EXPECT_EQ(util::error::INVALID_ARGUMENT, result.status().error_code());
+      EXPECT_PRED_FORMAT2(testing::IsSubstring, "not supported",
+                          result.status().error_message());
+    }
+  }
+
+  {  // Bad tag_size (supported sizes: 10 to the digest size).
+    for (int tag_size = 0; tag_size < 70; tag_size++) {
+      for (HashType hash : {HashType::SHA256, HashType::SHA512}) {
+        auto result = key_manager.GetPrimitive(NewKey(hash, tag_size, 1024));
+        int max_tag_size = hash == HashType::SHA256 ? 32 : 64;
+        if (tag_size >= 10 && tag_size <= max_tag_size) {
+          EXPECT_TRUE(result.ok()) << result.status();
+        } else {
+          EXPECT_FALSE(result.ok());
+          EXPECT_EQ(util::error::INVALID_ARGUMENT,
+                    result.status().error_code());
+          EXPECT_PRED_FORMAT2(testing::IsSubstring, "tag_size",
+                              result.status().error_message());
+        }
+      }
+    }
+  }
+
+  {  // Bad chunk_size (supported sizes: 1 KB to 64 MB).
+    for (uint32_t chunk_size :
+         {0u, 1023u, 1024u, 1u << 20, 1u << 26, (1u << 26) + 1}) {
+      auto result =
+          key_manager.GetPrimitive(NewKey(HashType::SHA256, 32, chunk_size));
+      if (chunk_size >= 1024 && chunk_size <= (1 << 26)) {
+        EXPECT_TRUE(result.ok()) << result.status();
+      } else {
+        EXPECT_FALSE(result.ok());
+        EXPECT_PRED_FORMAT2(testing::IsSubstring, "chunk_size",
+                            result.status().error_message());
+      }
+    }
+  }
+}
+
+TEST_F(TreeHmacKeyManagerTest, testPrimitives) {
+  TreeHmacKeyManager key_manager;
+  TreeHmacKey key = NewKey(HashType::SHA512, 64, 4096);
+  std::string data(3 * 4096 + 1, 'd');
+
+  auto subtle_result = subtle::TreeHmacBoringSsl::New(
+      subtle::HashType::SHA512, 64, 4096, key.key_value());
+  ASSERT_TRUE(subtle_result.ok()) << subtle_result.status();
+  std::string tag = subtle_result.ValueOrDie()->ComputeMac(data).ValueOrDie();
+
+  {  // Using key message only.
+    auto result = key_manager.GetPrimitive(key);
+    EXPECT_TRUE(result.ok()) << result.status();
+    auto tree_hmac = std::move(result.ValueOrDie());
+    auto tree_hmac_result = tree_hmac->ComputeMac(data);
+    EXPECT_TRUE(tree_hmac_result.ok()) << tree_hmac_result.status();
+    EXPECT_EQ(tag, tree_hmac_result.ValueOrDie());
+  }
+
+  {  // Using KeyData proto.
+    KeyData key_data;
+    key_data.set_type_url(tree_hmac_key_type);
+    key_data.set_value(key.SerializeAsString());
+    auto result = key_manager.GetPrimitive(key_data);
+    EXPECT_TRUE(result.ok()) << result.status();
+    auto tree_hmac = std::move(result.ValueOrDie());
+    EXPECT_TRUE(tree_hmac->VerifyMac(tag, data).ok());
+    EXPECT_FALSE(tree_hmac->VerifyMac(tag, "other data").ok());
+  }
+}
+
+TEST_F(TreeHmacKeyManagerTest, testNewKeyErrors) {
+  TreeHmacKeyManager key_manager;
+  const KeyFactory& key_factory = key_manager.get_key_factory();
+
+  {  // Bad key format.
+    AesCtrKeyFormat key_format;
+    auto result = key_factory.NewKey(key_format);
+    EXPECT_FALSE(result.ok());
+    EXPECT_EQ(util::error::INVALID_ARGUMENT, result.status().error_code());
+    EXPECT_PRED_FORMAT2(testing::IsSubstring, "not supported",
+                        result.status().error_message());
+    EXPECT_PRED_FORMAT2(testing::IsSubstring, "AesCtrKeyFormat",
+                        result.status().error_message());
+  }
+
+  {  // Bad serialized key format.
+    auto result = key_factory.NewKey("some bad serialized proto");
+    EXPECT_FALSE(result.ok());
+    EXPECT_EQ(util::error::INVALID_ARGUMENT, result.status().error_code());
+    EXPECT_PRED_FORMAT2(testing::IsSubstring, "not parse",
+                        result.status().error_message());
+  }
+
+  {  // Bad TreeHmacKeyFormat: key_size too small.
+    TreeHmacKeyFormat key_format;
+    key_format.set_key_size(8);
+    *key_format.mutable_params() = NewKey(HashType::SHA256, 32, 1024).params();
+    auto result = key_factory.NewKey(key_format);
+    EXPECT_FALSE(result.ok());
+    EXPECT_EQ(util::error::INVALID_ARGUMENT, result.status().error_code());
+    EXPECT_PRED_FORMAT2(testing::IsSubstring, "too small",
+                        result.status().error_message());
+  }
+
+  {  // Bad TreeHmacKeyFormat: chunk_size too small.
+    TreeHmacKeyFormat key_format;
+    key_format.set_key_size(32);
+    *key_format.mutable_params() = NewKey(HashType::SHA256, 32, 16).params();
+    auto result = key_factory.NewKey(key_format);
+    EXPECT_FALSE(result.ok());
+    EXPECT_EQ(util::error::INVALID_ARGUMENT, result.status().error_code());
+    EXPECT_PRED_FORMAT2(testing::IsSubstring, "chunk_size",
+                        result.status().error_message());
+  }
+}
+
+TEST_F(TreeHmacKeyManagerTest, testNewKeyBasic) {
+  TreeHmacKeyManager key_manager;
+  const KeyFactory& key_factory = key_manager.get_key_factory();
+  TreeHmacKeyFormat key_format;
+  key_format.set_key_size(32);
+  *key_format.mutable_params() =
+      NewKey(HashType::SHA256, 32, 1 << 20).params();
+
+  { // Via NewKey(format_proto).
+    auto result = key_factory.NewKey(key_format);
+    EXPECT_TRUE(result.ok()) << result.status();
+    auto key = std::move(result.ValueOrDie());
+    EXPECT_EQ(key_type_prefix + key->GetTypeName(), tree_hmac_key_type);
+    std::unique_ptr<TreeHmacKey> tree_hmac_key(
+        reinterpret_cast<TreeHmacKey*>(key.release()));
+    EXPECT_EQ(0, tree_hmac_key->version());
+    EXPECT_EQ(key_format.params().SerializeAsString(),
+              tree_hmac_key->params().SerializeAsString());
+    EXPECT_EQ(key_format.key_size(), tree_hmac_key->key_value().size());
+  }
+
+  { // Via NewKeyData(serialized_format_proto).
+    auto result = key_factory.NewKeyData(key_format.SerializeAsString());
+    EXPECT_TRUE(result.ok()) << result.status();
+    auto key_data = std::move(result.ValueOrDie());
+    EXPECT_EQ(tree_hmac_key_type, key_data->type_url());
+    EXPECT_EQ(KeyData::SYMMETRIC, key_data->key_material_type());
+    TreeHmacKey tree_hmac_key;
+    EXPECT_TRUE(tree_hmac_key.ParseFromString(key_data->value()));
+    EXPECT_EQ(0, tree_hmac_key.version());
+    EXPECT_EQ(key_format.params().SerializeAsString(),
+              tree_hmac_key.params().SerializeAsString());
+    EXPECT_EQ(key_format.key_size(), tree_hmac_key.key_value().size());
+  }
+}
+
+}  // namespace
+}  // namespace tink
+}  // namespace crypto
+
+int main(int ac, char* av[]) {
+  testing::InitGoogleTest(&ac, av);
+  return RUN_ALL_TESTS();
+}
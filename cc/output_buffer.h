@@ -0,0 +1,109 @@
+// Copyright 2018 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_OUTPUT_BUFFER_H_
+#define TINK_OUTPUT_BUFFER_H_
+
+#include <stddef.h>
+
+#include <string>
+
+#include "absl/strings/string_view.h"
+#include "tink/util/status.h"
+
+namespace crypto {
+namespace tink {
+
+///////////////////////////////////////////////////////////////////////////////
+// A destination for the output of a primitive, e.g. a ciphertext or a MAC.
+// The *Into() methods of the primitives (e.g. Aead::EncryptInto()) write
+// their output directly into the memory returned by Resize(), so the
+// implementation of this interface decides where the output lives, e.g. in
+// a request-scoped arena or in a reused buffer instead of a new std::string.
+class OutputBuffer {
+ public:
+  // Resizes the output to 'size' bytes, keeping its first
+  // min('size', old size) bytes, and returns a pointer to the output.
+  // Returns nullptr if the buffer cannot hold 'size' bytes. The pointer is
+  // valid until the next call to Resize().
+  virtual char* Resize(size_t size) = 0;
+
+  virtual ~OutputBuffer() {}
+};
+
+///////////////////////////////////////////////////////////////////////////////
+// An OutputBuffer that writes to caller-owned memory of a fixed capacity,
+// e.g. a block allocated from an arena. 'data' must be non-null. The buffer
+// never allocates memory.
+class FixedOutputBuffer : public OutputBuffer {
+ public:
+  FixedOutputBuffer(char* data, size_t capacity)
+      : data_(data), capacity_(capacity), size_(0) {}
+
+  // Returns nullptr if 'size' exceeds the capacity.
+  char* Resize(size_t size) override;
+
+  // Returns the output written so far.
+  absl::string_view output() const { return absl::string_view(data_, size_); }
+
+ private:
+  char* const data_;
+  const size_t capacity_;
+  size_t size_;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+// An OutputBuffer that stores the output in a std::string, which must
+// outlive the buffer.
+class StringOutputBuffer : public OutputBuffer {
+ public:
+  explicit StringOutputBuffer(std::string* output) : output_(output) {}
+
+  char* Resize(size_t size) override {
+    output_->resize(size);
+    return &(*output_)[0];
+  }
+
+ private:
+  std::string* const output_;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+// An OutputBuffer that stores 'prefix' followed by the output in another
+// OutputBuffer, e.g. to prepend the key prefix of a keyset (see
+// CryptoFormat) to the output of a primitive without copying the output.
+// 'prefix' and 'buffer' must outlive this buffer.
+class PrefixedOutputBuffer : public OutputBuffer {
+ public:
+  PrefixedOutputBuffer(absl::string_view prefix, OutputBuffer* buffer)
+      : prefix_(prefix), buffer_(buffer) {}
+
+  char* Resize(size_t size) override;
+
+ private:
+  const absl::string_view prefix_;
+  OutputBuffer* const buffer_;
+};
+
+// Sets the output of 'buffer' to 'data'. Returns a RESOURCE_EXHAUSTED
+// error if 'buffer' cannot hold 'data'.
+crypto::tink::util::Status WriteToOutputBuffer(absl::string_view data,
+                                               OutputBuffer* buffer);
+
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_OUTPUT_BUFFER_H_
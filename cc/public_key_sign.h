@@ -17,12 +17,31 @@
 #ifndef PUBLIC_KEY_SIGN_H_
 #define PUBLIC_KEY_SIGN_H_
 
+#include <memory>
+
 #include "absl/strings/string_view.h"
+#include "tink/output_buffer.h"
+#include "tink/util/status.h"
 #include "tink/util/statusor.h"
 
 namespace crypto {
 namespace tink {
 
+///////////////////////////////////////////////////////////////////////////////
+// Interface for signing data that is passed in chunks, e.g. while it is
+// streamed from disk. Obtained from PublicKeySign::NewSigner().
+class PublicKeySigner {
+ public:
+  // Appends 'data' to the data to be signed.
+  virtual crypto::tink::util::Status Update(absl::string_view data) = 0;
+
+  // Returns the signature for all the data passed to Update().
+  // The signer must not be used after Finalize().
+  virtual crypto::tink::util::StatusOr<std::string> Finalize() = 0;
+
+  virtual ~PublicKeySigner() {}
+};
+
 ///////////////////////////////////////////////////////////////////////////////
 // Interface for public key signing.
 // Digital Signatures provide functionality of signing data and verification of
@@ -37,6 +56,20 @@ class PublicKeySign {
   virtual crypto::tink::util::StatusOr<std::string> Sign(
       absl::string_view data) const = 0;
 
+  // Like Sign(), but writes the signature to 'signature' instead of
+  // returning it, so that the caller decides where it is stored.
+  // The default implementation copies the result of Sign().
+  virtual crypto::tink::util::Status SignInto(
+      absl::string_view data, OutputBuffer* signature) const;
+
+  // Returns a signer that computes the same signature as Sign() for the
+  // concatenation of all chunks passed to it. The signer must not outlive
+  // this PublicKeySign.
+  // Schemes that sign a digest of the data hash the chunks as they come in;
+  // the default implementation buffers them and calls Sign() in Finalize().
+  virtual crypto::tink::util::StatusOr<std::unique_ptr<PublicKeySigner>>
+  NewSigner() const;
+
   virtual ~PublicKeySign() {}
 };
 
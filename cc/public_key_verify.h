@@ -17,12 +17,31 @@
 #ifndef PUBLIC_KEY_VERIFY_H_
 #define PUBLIC_KEY_VERIFY_H_
 
+#include <memory>
+
 #include "absl/strings/string_view.h"
 #include "tink/util/status.h"
+#include "tink/util/statusor.h"
 
 namespace crypto {
 namespace tink {
 
+///////////////////////////////////////////////////////////////////////////////
+// Interface for verifying a signature for data that is passed in chunks,
+// e.g. while it is streamed from disk. Obtained from
+// PublicKeyVerify::NewVerifier().
+class PublicKeyVerifier {
+ public:
+  // Appends 'data' to the data to be verified.
+  virtual crypto::tink::util::Status Update(absl::string_view data) = 0;
+
+  // Verifies that the signature is a digital signature for all the data
+  // passed to Update(). The verifier must not be used after Finalize().
+  virtual crypto::tink::util::Status Finalize() = 0;
+
+  virtual ~PublicKeyVerifier() {}
+};
+
 ///////////////////////////////////////////////////////////////////////////////
 // Interface for public key verifying.
 // Digital Signatures provide functionality of signing data and verification of
@@ -38,6 +57,14 @@ class PublicKeyVerify {
       absl::string_view signature,
       absl::string_view data) const = 0;
 
+  // Returns a verifier for 'signature' that gives the same result as
+  // Verify() for the concatenation of all chunks passed to it. The verifier
+  // must not outlive this PublicKeyVerify.
+  // Schemes that sign a digest of the data hash the chunks as they come in;
+  // the default implementation buffers them and calls Verify() in Finalize().
+  virtual crypto::tink::util::StatusOr<std::unique_ptr<PublicKeyVerifier>>
+  NewVerifier(absl::string_view signature) const;
+
   virtual ~PublicKeyVerify() {}
 };
 
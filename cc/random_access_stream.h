@@ -0,0 +1,65 @@
+// Copyright 2018 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_RANDOM_ACCESS_STREAM_H_
+#define TINK_RANDOM_ACCESS_STREAM_H_
+
+#include <stdint.h>
+
+#include "absl/strings/string_view.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+
+///////////////////////////////////////////////////////////////////////////////
+// A source of bytes that can be read at arbitrary positions, e.g. a memory
+// buffer or a file.
+// Implementations must support concurrent calls to PRead() from several
+// threads.
+class RandomAccessStream {
+ public:
+  // Reads 'count' bytes starting at 'position' into 'dest', which must have
+  // room for 'count' bytes. Returns an OUT_OF_RANGE error if the stream
+  // ends before 'position' + 'count'.
+  virtual crypto::tink::util::Status PRead(
+      uint64_t position, size_t count, char* dest) = 0;
+
+  // Returns the total number of bytes in the stream.
+  virtual crypto::tink::util::StatusOr<uint64_t> size() = 0;
+
+  virtual ~RandomAccessStream() {}
+};
+
+///////////////////////////////////////////////////////////////////////////////
+// A destination for bytes that can be written at arbitrary positions, e.g.
+// a memory buffer or a file.
+// Implementations must support concurrent calls to PWrite() from several
+// threads, as long as the calls write disjoint ranges.
+class RandomAccessSink {
+ public:
+  // Writes 'data' starting at 'position'.
+  virtual crypto::tink::util::Status PWrite(
+      uint64_t position, absl::string_view data) = 0;
+
+  virtual ~RandomAccessSink() {}
+};
+
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_RANDOM_ACCESS_STREAM_H_
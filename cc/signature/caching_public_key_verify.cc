@@ -0,0 +1,199 @@
+// Copyright 2018 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/signature/caching_public_key_verify.h"
+
+#include <string.h>
+
+#include "absl/memory/memory.h"
+#include "openssl/digest.h"
+#include "tink/subtle/random.h"
+#include "tink/subtle/subtle_util_boringssl.h"
+#include "tink/util/errors.h"
+
+namespace crypto {
+namespace tink {
+
+namespace {
+
+const size_t kNumShards = 16;
+const size_t kHmacKeySize = 32;
+
+const uint8_t* AsBytes(absl::string_view s) {
+  return reinterpret_cast<const uint8_t*>(s.data());
+}
+
+int64_t Now() {
+  return std::chrono::steady_clock::now().time_since_epoch().count();
+}
+
+}  // namespace
+
+// static
+util::StatusOr<std::unique_ptr<CachingPublicKeyVerify>>
+CachingPublicKeyVerify::New(std::unique_ptr<PublicKeyVerify> public_key_verify,
+                            size_t capacity, std::chrono::milliseconds ttl) {
+  if (public_key_verify == nullptr) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "public_key_verify must be non-NULL");
+  }
+  if (capacity == 0 || capacity > kMaxCapacity) {
+    return ToStatusF(util::error::INVALID_ARGUMENT,
+                     "Invalid cache capacity %zu.", capacity);
+  }
+  if (ttl.count() <= 0) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "The time to live must be positive.");
+  }
+  std::string key = subtle::Random::GetRandomBytes(kHmacKeySize);
+  bssl::UniquePtr<HMAC_CTX> hmac_ctx(HMAC_CTX_new());
+  if (hmac_ctx == nullptr ||
+      1 != HMAC_Init_ex(hmac_ctx.get(), key.data(), key.size(), EVP_sha256(),
+                        nullptr)) {
+    return util::Status(util::error::INTERNAL, "HMAC_Init_ex failed");
+  }
+  size_t slots_per_shard = (capacity + kNumShards - 1) / kNumShards;
+  return absl::WrapUnique(new CachingPublicKeyVerify(
+      std::move(public_key_verify), std::move(hmac_ctx), slots_per_shard,
+      ttl));
+}
+
+CachingPublicKeyVerify::CachingPublicKeyVerify(
+    std::unique_ptr<PublicKeyVerify> public_key_verify,
+    bssl::UniquePtr<HMAC_CTX> hmac_ctx, size_t slots_per_shard,
+    std::chrono::milliseconds ttl)
+    : public_key_verify_(std::move(public_key_verify)),
+      hmac_ctx_(std::move(hmac_ctx)),
+      slots_per_shard_(slots_per_shard),
+      ttl_(std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+          ttl)),
+      shards_(new Shard[kNumShards]) {
+  for (size_t i = 0; i < kNumShards; i++) {
+    shards_[i].slots.reset(new Slot[slots_per_shard_]);
+  }
+}
+
+util::StatusOr<CachingPublicKeyVerify::Tag> CachingPublicKeyVerify::ComputeTag(
+    absl::string_view signature, absl::string_view data) const {
+  // The signature is length-prefixed, so that no two (signature, data)
+  // pairs have the same encoding.
+  uint8_t signature_size[8];
+  uint64_t size = signature.size();
+  for (int i = 7; i >= 0; i--) {
+    signature_size[i] = static_cast<uint8_t>(size);
+    size >>= 8;
+  }
+  bssl::UniquePtr<HMAC_CTX> ctx(HMAC_CTX_new());
+  uint8_t buf[EVP_MAX_MD_SIZE];
+  unsigned int buf_len;
+  if (ctx == nullptr ||
+      1 != HMAC_CTX_copy_ex(ctx.get(), hmac_ctx_.get()) ||
+      1 != HMAC_Update(ctx.get(), signature_size, sizeof(signature_size)) ||
+      1 != HMAC_Update(ctx.get(), AsBytes(signature), signature.size()) ||
+      1 != HMAC_Update(ctx.get(), AsBytes(data), data.size()) ||
+      1 != HMAC_Final(ctx.get(), buf, &buf_len) ||
+      buf_len != sizeof(Tag::words)) {
+    return util::Status(util::error::INTERNAL, "HMAC failed");
+  }
+  Tag tag;
+  memcpy(tag.words, buf, sizeof(tag.words));
+  return tag;
+}
+
+CachingPublicKeyVerify::Shard* CachingPublicKeyVerify::ShardFor(
+    const Tag& tag) const {
+  return &shards_[tag.words[0] % kNumShards];
+}
+
+CachingPublicKeyVerify::Slot* CachingPublicKeyVerify::SlotFor(
+    const Shard& shard, const Tag& tag) const {
+  return &shard.slots[tag.words[1] % slots_per_shard_];
+}
+
+// static
+bool CachingPublicKeyVerify::Lookup(const Slot& slot, const Tag& tag,
+                                    int64_t now) {
+  uint32_t sequence = slot.sequence.load(std::memory_order_acquire);
+  if (sequence & 1) return false;  // Concurrent insertion; treat as a miss.
+  uint64_t diff = 0;
+  for (int i = 0; i < kTagWords; i++) {
+    diff |= slot.tag[i].load(std::memory_order_relaxed) ^ tag.words[i];
+  }
+  bool valid = now < slot.expiry.load(std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_acquire);
+  return diff == 0 && valid &&
+         slot.sequence.load(std::memory_order_relaxed) == sequence;
+}
+
+// static
+void CachingPublicKeyVerify::Insert(Shard* shard, Slot* slot, const Tag& tag,
+                                    int64_t expiry) {
+  std::lock_guard<std::mutex> lock(shard->write_mutex);
+  uint32_t sequence = slot->sequence.load(std::memory_order_relaxed);
+  slot->sequence.store(sequence + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  for (int i = 0; i < kTagWords; i++) {
+    slot->tag[i].store(tag.words[i], std::memory_order_relaxed);
+  }
+  slot->expiry.store(expiry, std::memory_order_relaxed);
+  slot->sequence.store(sequence + 2, std::memory_order_release);
+}
+
+util::Status CachingPublicKeyVerify::Verify(absl::string_view signature,
+                                            absl::string_view data) const {
+  signature = subtle::SubtleUtilBoringSSL::EnsureNonNull(signature);
+  data = subtle::SubtleUtilBoringSSL::EnsureNonNull(data);
+  auto tag_result = ComputeTag(signature, data);
+  if (!tag_result.ok()) return tag_result.status();
+  const Tag& tag = tag_result.ValueOrDie();
+  Shard* shard = ShardFor(tag);
+  Slot* slot = SlotFor(*shard, tag);
+
+  if (Lookup(*slot, tag, Now())) {
+    shard->hits.fetch_add(1, std::memory_order_relaxed);
+    return util::Status::OK;
+  }
+  shard->misses.fetch_add(1, std::memory_order_relaxed);
+  auto status = public_key_verify_->Verify(signature, data);
+  if (status.ok()) {
+    Insert(shard, slot, tag, Now() + ttl_.count());
+  }
+  return status;
+}
+
+util::StatusOr<std::unique_ptr<PublicKeyVerifier>>
+CachingPublicKeyVerify::NewVerifier(absl::string_view signature) const {
+  return public_key_verify_->NewVerifier(signature);
+}
+
+uint64_t CachingPublicKeyVerify::hits() const {
+  uint64_t hits = 0;
+  for (size_t i = 0; i < kNumShards; i++) {
+    hits += shards_[i].hits.load(std::memory_order_relaxed);
+  }
+  return hits;
+}
+
+uint64_t CachingPublicKeyVerify::misses() const {
+  uint64_t misses = 0;
+  for (size_t i = 0; i < kNumShards; i++) {
+    misses += shards_[i].misses.load(std::memory_order_relaxed);
+  }
+  return misses;
+}
+
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,130 @@
+// Copyright 2018 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_SIGNATURE_CACHING_PUBLIC_KEY_VERIFY_H_
+#define TINK_SIGNATURE_CACHING_PUBLIC_KEY_VERIFY_H_
+
+#include <atomic>
+#include <chrono>  // NOLINT(build/c++11)
+#include <memory>
+#include <mutex>  // NOLINT(build/c++11)
+
+#include "absl/strings/string_view.h"
+#include "openssl/base.h"
+#include "openssl/hmac.h"
+#include "tink/public_key_verify.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+
+///////////////////////////////////////////////////////////////////////////////
+// A PublicKeyVerify that remembers successful verifications of the
+// PublicKeyVerify it wraps, e.g. the one returned by
+// PublicKeyVerifyFactory::GetPrimitive(), for a limited time:
+//
+//   auto verify_result = CachingPublicKeyVerify::New(
+//       std::move(public_key_verify), /* capacity= */ 100000,
+//       /* ttl= */ std::chrono::seconds(60));
+//
+// Verifying a (signature, data) pair that was successfully verified within
+// the last 'ttl' costs an HMAC-SHA256 of the pair instead of a public key
+// operation. Failed verifications are never remembered.
+//
+// Entries are keyed by HMAC-SHA256 of the signature and the data, under a
+// random key that is unique to each instance. The signature carries the
+// key id of the key that produced it (for keys with a TINK or LEGACY
+// output prefix), and an entry is only ever consulted by the instance that
+// created it, i.e. for the keyset it was created for.
+//
+// The cache is split into shards of direct-mapped slots. Lookups do not
+// take locks; insertions lock only the shard they write to, and evict
+// whatever entry occupied the slot.
+class CachingPublicKeyVerify : public PublicKeyVerify {
+ public:
+  // Returns a PublicKeyVerify that caches up to 'capacity' successful
+  // verifications of 'public_key_verify' for 'ttl' each.
+  static crypto::tink::util::StatusOr<std::unique_ptr<CachingPublicKeyVerify>>
+  New(std::unique_ptr<PublicKeyVerify> public_key_verify, size_t capacity,
+      std::chrono::milliseconds ttl);
+
+  crypto::tink::util::Status Verify(
+      absl::string_view signature,
+      absl::string_view data) const override;
+
+  // Streaming verification is passed through to the wrapped
+  // PublicKeyVerify without caching.
+  crypto::tink::util::StatusOr<std::unique_ptr<PublicKeyVerifier>>
+  NewVerifier(absl::string_view signature) const override;
+
+  // Returns the number of Verify() calls answered from the cache.
+  uint64_t hits() const;
+
+  // Returns the number of Verify() calls passed to the wrapped
+  // PublicKeyVerify.
+  uint64_t misses() const;
+
+  ~CachingPublicKeyVerify() override {}
+
+  static constexpr size_t kMaxCapacity = 1 << 24;
+
+ private:
+  static constexpr int kTagWords = 4;  // 256-bit tags.
+
+  struct Tag {
+    uint64_t words[kTagWords];
+  };
+
+  // A slot is written under its shard's mutex and read without locks;
+  // 'sequence' is odd while a write is in progress (a seqlock).
+  struct Slot {
+    std::atomic<uint32_t> sequence{0};
+    std::atomic<uint64_t> tag[kTagWords] = {};
+    std::atomic<int64_t> expiry{0};  // steady_clock ticks, 0 if empty.
+  };
+
+  struct Shard {
+    std::unique_ptr<Slot[]> slots;
+    std::mutex write_mutex;
+    std::atomic<uint64_t> hits{0};
+    std::atomic<uint64_t> misses{0};
+  };
+
+  CachingPublicKeyVerify(std::unique_ptr<PublicKeyVerify> public_key_verify,
+                         bssl::UniquePtr<HMAC_CTX> hmac_ctx,
+                         size_t slots_per_shard,
+                         std::chrono::milliseconds ttl);
+
+  crypto::tink::util::StatusOr<Tag> ComputeTag(absl::string_view signature,
+                                               absl::string_view data) const;
+  Shard* ShardFor(const Tag& tag) const;
+  Slot* SlotFor(const Shard& shard, const Tag& tag) const;
+  static bool Lookup(const Slot& slot, const Tag& tag, int64_t now);
+  static void Insert(Shard* shard, Slot* slot, const Tag& tag,
+                     int64_t expiry);
+
+  const std::unique_ptr<PublicKeyVerify> public_key_verify_;
+  const bssl::UniquePtr<HMAC_CTX> hmac_ctx_;  // Keyed, copied per tag.
+  const size_t slots_per_shard_;
+  const std::chrono::steady_clock::duration ttl_;
+  const std::unique_ptr<Shard[]> shards_;
+};
+
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_SIGNATURE_CACHING_PUBLIC_KEY_VERIFY_H_
@@ -0,0 +1,192 @@
+// Copyright 2018 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/signature/caching_public_key_verify.h"
+
+#include <atomic>
+#include <chrono>  // NOLINT(build/c++11)
+#include <string>
+#include <thread>  // NOLINT(build/c++11)
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "tink/public_key_verify.h"
+#include "tink/util/status.h"
+#include "tink/util/test_util.h"
+
+using crypto::tink::test::DummyPublicKeyVerify;
+
+namespace crypto {
+namespace tink {
+namespace {
+
+// Counts the calls to Verify() that reach the wrapped PublicKeyVerify.
+class CountingPublicKeyVerify : public PublicKeyVerify {
+ public:
+  CountingPublicKeyVerify(absl::string_view signature_name,
+                          std::atomic<int>* calls)
+      : verify_(signature_name), calls_(calls) {}
+
+  util::Status Verify(absl::string_view signature,
+                      absl::string_view data) const override {
+    (*calls_)++;
+    return verify_.Verify(signature, data);
+  }
+
+ private:
+  DummyPublicKeyVerify verify_;
+  std::atomic<int>* calls_;
+};
+
+class CachingPublicKeyVerifyTest : public ::testing::Test {
+ protected:
+  std::unique_ptr<CachingPublicKeyVerify> NewVerify(
+      size_t capacity, std::chrono::milliseconds ttl) {
+    std::unique_ptr<PublicKeyVerify> verify(
+        new CountingPublicKeyVerify("some_signature", &calls_));
+    auto result = CachingPublicKeyVerify::New(std::move(verify), capacity, ttl);
+    EXPECT_TRUE(result.ok()) << result.status();
+    return std::move(result.ValueOrDie());
+  }
+
+  std::atomic<int> calls_{0};
+};
+
+TEST_F(CachingPublicKeyVerifyTest, testBasic) {
+  auto verify = NewVerify(100, std::chrono::seconds(60));
+  std::string data = "some data";
+  std::string signature = data + "some_signature";
+
+  for (int i = 0; i < 3; i++) {
+    auto status = verify->Verify(signature, data);
+    EXPECT_TRUE(status.ok()) << status;
+  }
+  EXPECT_EQ(1, calls_.load());
+  EXPECT_EQ(2, verify->hits());
+  EXPECT_EQ(1, verify->misses());
+
+  // Another signature of the same data is not a hit.
+  std::string other_signature = "some_signature" + data;
+  EXPECT_FALSE(verify->Verify(other_signature, data).ok());
+  // The signature of other data is not a hit.
+  EXPECT_FALSE(verify->Verify(signature, "some other data").ok());
+  EXPECT_EQ(3, calls_.load());
+  EXPECT_EQ(2, verify->hits());
+  EXPECT_EQ(3, verify->misses());
+
+  // Empty data.
+  const absl::string_view empty_data;
+  EXPECT_TRUE(verify->Verify("some_signature", empty_data).ok());
+  EXPECT_TRUE(verify->Verify("some_signature", "").ok());
+  EXPECT_EQ(4, calls_.load());
+}
+
+TEST_F(CachingPublicKeyVerifyTest, testFailuresAreNotCached) {
+  auto verify = NewVerify(100, std::chrono::seconds(60));
+  for (int i = 0; i < 3; i++) {
+    EXPECT_FALSE(verify->Verify("bad signature", "some data").ok());
+  }
+  EXPECT_EQ(3, calls_.load());
+  EXPECT_EQ(0, verify->hits());
+  EXPECT_EQ(3, verify->misses());
+}
+
+TEST_F(CachingPublicKeyVerifyTest, testExpiry) {
+  auto verify = NewVerify(100, std::chrono::milliseconds(50));
+  std::string data = "some data";
+  std::string signature = data + "some_signature";
+  EXPECT_TRUE(verify->Verify(signature, data).ok());
+  EXPECT_TRUE(verify->Verify(signature, data).ok());
+  EXPECT_EQ(1, calls_.load());
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  EXPECT_TRUE(verify->Verify(signature, data).ok());
+  EXPECT_EQ(2, calls_.load());
+}
+
+TEST_F(CachingPublicKeyVerifyTest, testEviction) {
+  auto verify = NewVerify(1, std::chrono::seconds(60));
+  // With a single slot per shard, many entries must evict each other, but
+  // each verification still gives the right result.
+  for (int round = 0; round < 2; round++) {
+    for (int i = 0; i < 100; i++) {
+      std::string data = "data " + std::to_string(i);
+      EXPECT_TRUE(verify->Verify(data + "some_signature", data).ok());
+      EXPECT_FALSE(verify->Verify(data + "bad_signature", data).ok());
+    }
+  }
+  EXPECT_GT(calls_.load(), 200);
+  EXPECT_EQ(400, verify->hits() + verify->misses());
+}
+
+TEST_F(CachingPublicKeyVerifyTest, testConcurrentUse) {
+  auto verify = NewVerify(64, std::chrono::seconds(60));
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 8; t++) {
+    threads.emplace_back([&verify]() {
+      for (int i = 0; i < 1000; i++) {
+        std::string data = "data " + std::to_string(i % 100);
+        EXPECT_TRUE(verify->Verify(data + "some_signature", data).ok());
+        EXPECT_FALSE(verify->Verify("bad_signature", data).ok());
+      }
+    });
+  }
+  for (auto& thread : threads) thread.join();
+  EXPECT_EQ(16000, verify->hits() + verify->misses());
+  EXPECT_GT(verify->hits(), 0);
+}
+
+TEST_F(CachingPublicKeyVerifyTest, testStreamingIsPassedThrough) {
+  auto verify = NewVerify(100, std::chrono::seconds(60));
+  auto verifier_result = verify->NewVerifier("some datasome_signature");
+  EXPECT_TRUE(verifier_result.ok()) << verifier_result.status();
+  auto verifier = std::move(verifier_result.ValueOrDie());
+  EXPECT_TRUE(verifier->Update("some ").ok());
+  EXPECT_TRUE(verifier->Update("data").ok());
+  auto status = verifier->Finalize();
+  EXPECT_TRUE(status.ok()) << status;
+  EXPECT_EQ(1, calls_.load());
+  EXPECT_EQ(0, verify->hits() + verify->misses());
+}
+
+TEST_F(CachingPublicKeyVerifyTest, testInvalidParameters) {
+  std::unique_ptr<PublicKeyVerify> verify(
+      new DummyPublicKeyVerify("some_signature"));
+  EXPECT_FALSE(
+      CachingPublicKeyVerify::New(nullptr, 100, std::chrono::seconds(60))
+          .ok());
+  EXPECT_FALSE(CachingPublicKeyVerify::New(std::move(verify), 0,
+                                           std::chrono::seconds(60))
+                   .ok());
+  verify.reset(new DummyPublicKeyVerify("some_signature"));
+  EXPECT_FALSE(CachingPublicKeyVerify::New(
+                   std::move(verify),
+                   CachingPublicKeyVerify::kMaxCapacity + 1,
+                   std::chrono::seconds(60))
+                   .ok());
+  verify.reset(new DummyPublicKeyVerify("some_signature"));
+  EXPECT_FALSE(CachingPublicKeyVerify::New(std::move(verify), 100,
+                                           std::chrono::milliseconds(0))
+                   .ok());
+}
+
+}  // namespace
+}  // namespace tink
+}  // namespace crypto
+
+int main(int ac, char* av[]) {
+  testing::InitGoogleTest(&ac, av);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,223 @@
+// Copyright 2017 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+#include "tink/signature/ed25519_sign_key_manager.h"
+
+#include "absl/strings/string_view.h"
+#include "absl/memory/memory.h"
+#include "openssl/curve25519.h"
+#include "openssl/mem.h"
+#include "tink/public_key_sign.h"
+#include "tink/key_manager.h"
+#include "tink/signature/ed25519_verify_key_manager.h"
+#include "tink/subtle/ed25519_sign_boringssl.h"
+#include "tink/util/errors.h"
+#include "tink/util/protobuf_helper.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "tink/util/validation.h"
+#include "proto/ed25519.pb.h"
+#include "proto/tink.pb.h"
+
+namespace crypto {
+namespace tink {
+
+using google::crypto::tink::Ed25519KeyFormat;
+using google::crypto::tink::Ed25519PrivateKey;
+using google::crypto::tink::KeyData;
+using portable_proto::MessageLite;
+using crypto::tink::util::Status;
+using crypto::tink::util::StatusOr;
+
+class Ed25519PrivateKeyFactory : public PrivateKeyFactory {
+ public:
+  Ed25519PrivateKeyFactory() {}
+
+  // Generates a new random Ed25519PrivateKey, based on
+  // the given 'key_format', which must contain Ed25519KeyFormat-proto.
+  crypto::tink::util::StatusOr<std::unique_ptr<portable_proto::MessageLite>>
+  NewKey(const portable_proto::MessageLite& key_format) const override;
+
+  // Generates a new random Ed25519PrivateKey, based on
+  // the given 'serialized_key_format', which must contain
+  // Ed25519KeyFormat-proto.
+  crypto::tink::util::StatusOr<std::unique_ptr<portable_proto::MessageLite>>
+  NewKey(absl::string_view serialized_key_format) const override;
+
+  // Generates a new random Ed25519PrivateKey based on
+  // the given 'serialized_key_format' (which must contain
+  // Ed25519KeyFormat-proto), and wraps it in a KeyData-proto.
+  crypto::tink::util::StatusOr<std::unique_ptr<google::crypto::tink::KeyData>>
+  NewKeyData(absl::string_view serialized_key_format) const override;
+
+  // Returns KeyData proto that contains Ed25519PublicKey
+  // extracted from the given serialized_private_key, which must contain
+  // Ed25519PrivateKey-proto.
+  crypto::tink::util::StatusOr<std::unique_ptr<google::crypto::tink::KeyData>>
+  GetPublicKeyData(absl::string_view serialized_private_key) const override;
+};
+
+StatusOr<std::unique_ptr<MessageLite>> Ed25519PrivateKeyFactory::NewKey(
+    const portable_proto::MessageLite& key_format) const {
+  std::string key_format_url =
+      std::string(Ed25519SignKeyManager::kKeyTypePrefix) +
+      key_format.GetTypeName();
+  if (key_format_url != Ed25519SignKeyManager::kKeyFormatUrl) {
+    return ToStatusF(util::error::INVALID_ARGUMENT,
+                     "Key format proto '%s' is not supported by this manager.",
+                     key_format_url.c_str());
+  }
+
+  // Generate new Ed25519 key. BoringSSL returns the 32-byte seed followed
+  // by the public key; only the seed is stored as the private key.
+  uint8_t public_key[ED25519_PUBLIC_KEY_LEN];
+  uint8_t private_key[ED25519_PRIVATE_KEY_LEN];
+  ED25519_keypair(public_key, private_key);
+
+  // Build Ed25519PrivateKey.
+  std::unique_ptr<Ed25519PrivateKey> ed25519_private_key(
+      new Ed25519PrivateKey());
+  ed25519_private_key->set_version(Ed25519SignKeyManager::kVersion);
+  ed25519_private_key->set_key_value(private_key, ED25519_PRIVATE_KEY_LEN / 2);
+  OPENSSL_cleanse(private_key, sizeof(private_key));
+  auto ed25519_public_key = ed25519_private_key->mutable_public_key();
+  ed25519_public_key->set_version(Ed25519SignKeyManager::kVersion);
+  ed25519_public_key->set_key_value(public_key, sizeof(public_key));
+
+  std::unique_ptr<MessageLite> key = std::move(ed25519_private_key);
+  return std::move(key);
+}
+
+StatusOr<std::unique_ptr<MessageLite>> Ed25519PrivateKeyFactory::NewKey(
+    absl::string_view serialized_key_format) const {
+  Ed25519KeyFormat key_format;
+  if (!key_format.ParseFromString(std::string(serialized_key_format))) {
+    return ToStatusF(util::error::INVALID_ARGUMENT,
+                     "Could not parse the passed string as proto '%s'.",
+                     Ed25519SignKeyManager::kKeyFormatUrl);
+  }
+  return NewKey(key_format);
+}
+
+StatusOr<std::unique_ptr<KeyData>> Ed25519PrivateKeyFactory::NewKeyData(
+    absl::string_view serialized_key_format) const {
+  auto new_key_result = NewKey(serialized_key_format);
+  if (!new_key_result.ok()) return new_key_result.status();
+  auto new_key = reinterpret_cast<const Ed25519PrivateKey&>(
+      *(new_key_result.ValueOrDie()));
+  std::unique_ptr<KeyData> key_data(new KeyData());
+  key_data->set_type_url(Ed25519SignKeyManager::kKeyType);
+  key_data->set_value(new_key.SerializeAsString());
+  key_data->set_key_material_type(KeyData::ASYMMETRIC_PRIVATE);
+  return std::move(key_data);
+}
+
+StatusOr<std::unique_ptr<KeyData>>
+Ed25519PrivateKeyFactory::GetPublicKeyData(
+    absl::string_view serialized_private_key) const {
+  Ed25519PrivateKey private_key;
+  if (!private_key.ParseFromString(std::string(serialized_private_key))) {
+    return ToStatusF(util::error::INVALID_ARGUMENT,
+                     "Could not parse the passed string as proto '%s'.",
+                     Ed25519SignKeyManager::kKeyType);
+  }
+  auto status = Ed25519SignKeyManager::Validate(private_key);
+  if (!status.ok()) return status;
+  auto key_data = absl::make_unique<KeyData>();
+  key_data->set_type_url(Ed25519VerifyKeyManager::kKeyType);
+  key_data->set_value(private_key.public_key().SerializeAsString());
+  key_data->set_key_material_type(KeyData::ASYMMETRIC_PUBLIC);
+  return std::move(key_data);
+}
+
+constexpr char Ed25519SignKeyManager::kKeyFormatUrl[];
+constexpr char Ed25519SignKeyManager::kKeyTypePrefix[];
+constexpr char Ed25519SignKeyManager::kKeyType[];
+constexpr uint32_t Ed25519SignKeyManager::kVersion;
+
+Ed25519SignKeyManager::Ed25519SignKeyManager()
+    : key_type_(kKeyType), key_factory_(new Ed25519PrivateKeyFactory()) {
+}
+
+const std::string& Ed25519SignKeyManager::get_key_type() const {
+  return key_type_;
+}
+
+const KeyFactory& Ed25519SignKeyManager::get_key_factory() const {
+  return *key_factory_;
+}
+
+uint32_t Ed25519SignKeyManager::get_version() const {
+  return kVersion;
+}
+
+StatusOr<std::unique_ptr<PublicKeySign>>
+Ed25519SignKeyManager::GetPrimitive(const KeyData& key_data) const {
+  if (DoesSupport(key_data.type_url())) {
+    Ed25519PrivateKey ed25519_private_key;
+    if (!ed25519_private_key.ParseFromString(key_data.value())) {
+      return ToStatusF(util::error::INVALID_ARGUMENT,
+                       "Could not parse key_data.value as key type '%s'.",
+                       key_data.type_url().c_str());
+    }
+    return GetPrimitiveImpl(ed25519_private_key);
+  } else {
+    return ToStatusF(util::error::INVALID_ARGUMENT,
+                     "Key type '%s' is not supported by this manager.",
+                     key_data.type_url().c_str());
+  }
+}
+
+StatusOr<std::unique_ptr<PublicKeySign>>
+Ed25519SignKeyManager::GetPrimitive(const MessageLite& key) const {
+  std::string key_type = std::string(kKeyTypePrefix) + key.GetTypeName();
+  if (DoesSupport(key_type)) {
+    const Ed25519PrivateKey& ed25519_private_key =
+        reinterpret_cast<const Ed25519PrivateKey&>(key);
+    return GetPrimitiveImpl(ed25519_private_key);
+  } else {
+    return ToStatusF(util::error::INVALID_ARGUMENT,
+                     "Key type '%s' is not supported by this manager.",
+                     key_type.c_str());
+  }
+}
+
+StatusOr<std::unique_ptr<PublicKeySign>>
+Ed25519SignKeyManager::GetPrimitiveImpl(
+    const Ed25519PrivateKey& ed25519_private_key) const {
+  Status status = Validate(ed25519_private_key);
+  if (!status.ok()) return status;
+  auto ed25519_result =
+      subtle::Ed25519SignBoringSsl::New(ed25519_private_key.key_value());
+  if (!ed25519_result.ok()) return ed25519_result.status();
+  std::unique_ptr<PublicKeySign> ed25519(
+      ed25519_result.ValueOrDie().release());
+  return std::move(ed25519);
+}
+
+// static
+Status Ed25519SignKeyManager::Validate(
+    const Ed25519PrivateKey& key) {
+  Status status = ValidateVersion(key.version(), kVersion);
+  if (!status.ok()) return status;
+  if (key.key_value().size() != ED25519_PRIVATE_KEY_LEN / 2) {
+    return Status(util::error::INVALID_ARGUMENT,
+                  "The ED25519 private key must be 32 bytes long.");
+  }
+  return Ed25519VerifyKeyManager::Validate(key.public_key());
+}
+
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,173 @@
+// Copyright 2017 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+////////////////////////////////////////////////////////////////////////////////
+#include "tink/signature/ed25519_sign_key_manager.h"
+
+#include "tink/public_key_sign.h"
+#include "tink/public_key_verify.h"
+#include "tink/signature/ed25519_verify_key_manager.h"
+#include "tink/signature/signature_key_templates.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "gtest/gtest.h"
+#include "proto/ecdsa.pb.h"
+#include "proto/ed25519.pb.h"
+#include "proto/tink.pb.h"
+
+namespace crypto {
+namespace tink {
+
+using google::crypto::tink::EcdsaKeyFormat;
+using google::crypto::tink::Ed25519KeyFormat;
+using google::crypto::tink::Ed25519PrivateKey;
+using google::crypto::tink::KeyData;
+
+namespace {
+
+class Ed25519SignKeyManagerTest : public ::testing::Test {
+ protected:
+  std::string ed25519_sign_key_type_ =
+      "type.googleapis.com/google.crypto.tink.Ed25519PrivateKey";
+
+  Ed25519PrivateKey NewKey() {
+    Ed25519KeyFormat key_format;
+    auto result = key_manager_.get_key_factory().NewKey(key_format);
+    EXPECT_TRUE(result.ok()) << result.status();
+    return reinterpret_cast<const Ed25519PrivateKey&>(*result.ValueOrDie());
+  }
+
+  Ed25519SignKeyManager key_manager_;
+};
+
+TEST_F(Ed25519SignKeyManagerTest, testBasic) {
+  EXPECT_EQ(0, key_manager_.get_version());
+  EXPECT_EQ(ed25519_sign_key_type_, key_manager_.get_key_type());
+  EXPECT_TRUE(key_manager_.DoesSupport(ed25519_sign_key_type_));
+}
+
+TEST_F(Ed25519SignKeyManagerTest, testKeyDataErrors) {
+  {  // Bad key type.
+    KeyData key_data;
+    key_data.set_type_url(
+        "type.googleapis.com/google.crypto.tink.EcdsaPrivateKey");
+    auto result = key_manager_.GetPrimitive(key_data);
+    EXPECT_FALSE(result.ok());
+    EXPECT_EQ(util::error::INVALID_ARGUMENT, result.status().error_code());
+  }
+
+  {  // Bad key value.
+    KeyData key_data;
+    key_data.set_type_url(ed25519_sign_key_type_);
+    key_data.set_value("some bad serialized proto");
+    auto result = key_manager_.GetPrimitive(key_data);
+    EXPECT_FALSE(result.ok());
+    EXPECT_EQ(util::error::INVALID_ARGUMENT, result.status().error_code());
+  }
+
+  {  // Bad version.
+    Ed25519PrivateKey key = NewKey();
+    key.set_version(1);
+    EXPECT_FALSE(key_manager_.GetPrimitive(key).ok());
+  }
+
+  {  // Bad private key size.
+    Ed25519PrivateKey key = NewKey();
+    key.set_key_value(key.key_value() + key.public_key().key_value());
+    EXPECT_FALSE(key_manager_.GetPrimitive(key).ok());
+  }
+
+  {  // Bad public key size.
+    Ed25519PrivateKey key = NewKey();
+    key.mutable_public_key()->set_key_value("too short");
+    EXPECT_FALSE(key_manager_.GetPrimitive(key).ok());
+  }
+}
+
+TEST_F(Ed25519SignKeyManagerTest, testPrimitives) {
+  Ed25519PrivateKey key = NewKey();
+  EXPECT_EQ(0, key.version());
+  EXPECT_EQ(32, key.key_value().size());
+  EXPECT_EQ(0, key.public_key().version());
+  EXPECT_EQ(32, key.public_key().key_value().size());
+
+  auto sign_result = key_manager_.GetPrimitive(key);
+  ASSERT_TRUE(sign_result.ok()) << sign_result.status();
+  std::string message = "some data to sign";
+  auto signature_result = sign_result.ValueOrDie()->Sign(message);
+  ASSERT_TRUE(signature_result.ok()) << signature_result.status();
+  EXPECT_EQ(64, signature_result.ValueOrDie().size());
+
+  Ed25519VerifyKeyManager verify_key_manager;
+  auto verify_result = verify_key_manager.GetPrimitive(key.public_key());
+  ASSERT_TRUE(verify_result.ok()) << verify_result.status();
+  auto status = verify_result.ValueOrDie()->Verify(
+      signature_result.ValueOrDie(), message);
+  EXPECT_TRUE(status.ok()) << status;
+  EXPECT_FALSE(verify_result.ValueOrDie()
+                   ->Verify(signature_result.ValueOrDie(), "other data")
+                   .ok());
+
+  // Keys are fresh.
+  EXPECT_NE(key.key_value(), NewKey().key_value());
+}
+
+TEST_F(Ed25519SignKeyManagerTest, testPublicKeyExtraction) {
+  auto private_key_factory = dynamic_cast<const PrivateKeyFactory*>(
+      &(key_manager_.get_key_factory()));
+  ASSERT_NE(private_key_factory, nullptr);
+
+  auto new_key_result = private_key_factory->NewKeyData(
+      SignatureKeyTemplates::Ed25519().value());
+  ASSERT_TRUE(new_key_result.ok()) << new_key_result.status();
+  EXPECT_EQ(KeyData::ASYMMETRIC_PRIVATE,
+            new_key_result.ValueOrDie()->key_material_type());
+  Ed25519PrivateKey new_key;
+  ASSERT_TRUE(new_key.ParseFromString(new_key_result.ValueOrDie()->value()));
+
+  auto public_key_data_result = private_key_factory->GetPublicKeyData(
+      new_key_result.ValueOrDie()->value());
+  ASSERT_TRUE(public_key_data_result.ok()) << public_key_data_result.status();
+  auto public_key_data = std::move(public_key_data_result.ValueOrDie());
+  EXPECT_EQ(Ed25519VerifyKeyManager::kKeyType, public_key_data->type_url());
+  EXPECT_EQ(KeyData::ASYMMETRIC_PUBLIC, public_key_data->key_material_type());
+  EXPECT_EQ(new_key.public_key().SerializeAsString(),
+            public_key_data->value());
+}
+
+TEST_F(Ed25519SignKeyManagerTest, testNewKeyErrors) {
+  const KeyFactory& key_factory = key_manager_.get_key_factory();
+
+  {  // Bad key format.
+    EcdsaKeyFormat key_format;
+    auto result = key_factory.NewKey(key_format);
+    EXPECT_FALSE(result.ok());
+    EXPECT_EQ(util::error::INVALID_ARGUMENT, result.status().error_code());
+  }
+
+  {  // Bad serialized key format.
+    auto result = key_factory.NewKey("some bad serialized proto");
+    EXPECT_FALSE(result.ok());
+    EXPECT_EQ(util::error::INVALID_ARGUMENT, result.status().error_code());
+  }
+}
+
+}  // namespace
+}  // namespace tink
+}  // namespace crypto
+
+int main(int ac, char* av[]) {
+  testing::InitGoogleTest(&ac, av);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,154 @@
+// Copyright 2017 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+#include "tink/signature/ed25519_verify_key_manager.h"
+
+#include "absl/strings/string_view.h"
+#include "openssl/curve25519.h"
+#include "tink/public_key_verify.h"
+#include "tink/key_manager.h"
+#include "tink/subtle/ed25519_verify_boringssl.h"
+#include "tink/util/errors.h"
+#include "tink/util/protobuf_helper.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "tink/util/validation.h"
+#include "proto/ed25519.pb.h"
+#include "proto/tink.pb.h"
+
+namespace crypto {
+namespace tink {
+
+using google::crypto::tink::Ed25519PublicKey;
+using google::crypto::tink::KeyData;
+using portable_proto::MessageLite;
+using crypto::tink::util::Status;
+using crypto::tink::util::StatusOr;
+
+class Ed25519PublicKeyFactory : public KeyFactory {
+ public:
+  Ed25519PublicKeyFactory() {}
+
+  // Not implemented for public keys.
+  crypto::tink::util::StatusOr<std::unique_ptr<portable_proto::MessageLite>>
+  NewKey(const portable_proto::MessageLite& key_format) const override;
+
+  // Not implemented for public keys.
+  crypto::tink::util::StatusOr<std::unique_ptr<portable_proto::MessageLite>>
+  NewKey(absl::string_view serialized_key_format) const override;
+
+  // Not implemented for public keys.
+  crypto::tink::util::StatusOr<std::unique_ptr<google::crypto::tink::KeyData>>
+  NewKeyData(absl::string_view serialized_key_format) const override;
+};
+
+StatusOr<std::unique_ptr<MessageLite>> Ed25519PublicKeyFactory::NewKey(
+    const portable_proto::MessageLite& key_format) const {
+  return util::Status(util::error::UNIMPLEMENTED,
+                      "Operation not supported for public keys, "
+                      "please use the Ed25519SignKeyManager.");
+}
+
+StatusOr<std::unique_ptr<MessageLite>> Ed25519PublicKeyFactory::NewKey(
+    absl::string_view serialized_key_format) const {
+  return util::Status(util::error::UNIMPLEMENTED,
+                      "Operation not supported for public keys, "
+                      "please use the Ed25519SignKeyManager.");
+}
+
+StatusOr<std::unique_ptr<KeyData>> Ed25519PublicKeyFactory::NewKeyData(
+    absl::string_view serialized_key_format) const {
+  return util::Status(util::error::UNIMPLEMENTED,
+                      "Operation not supported for public keys, "
+                      "please use the Ed25519SignKeyManager.");
+}
+
+constexpr char Ed25519VerifyKeyManager::kKeyTypePrefix[];
+constexpr char Ed25519VerifyKeyManager::kKeyType[];
+constexpr uint32_t Ed25519VerifyKeyManager::kVersion;
+
+Ed25519VerifyKeyManager::Ed25519VerifyKeyManager()
+    : key_type_(kKeyType), key_factory_(new Ed25519PublicKeyFactory()) {
+}
+
+const std::string& Ed25519VerifyKeyManager::get_key_type() const {
+  return key_type_;
+}
+
+const KeyFactory& Ed25519VerifyKeyManager::get_key_factory() const {
+  return *key_factory_;
+}
+
+uint32_t Ed25519VerifyKeyManager::get_version() const {
+  return kVersion;
+}
+
+StatusOr<std::unique_ptr<PublicKeyVerify>>
+Ed25519VerifyKeyManager::GetPrimitive(const KeyData& key_data) const {
+  if (DoesSupport(key_data.type_url())) {
+    Ed25519PublicKey public_key;
+    if (!public_key.ParseFromString(key_data.value())) {
+      return ToStatusF(util::error::INVALID_ARGUMENT,
+                       "Could not parse key_data.value as key type '%s'.",
+                       key_data.type_url().c_str());
+    }
+    return GetPrimitiveImpl(public_key);
+  } else {
+    return ToStatusF(util::error::INVALID_ARGUMENT,
+                     "Key type '%s' is not supported by this manager.",
+                     key_data.type_url().c_str());
+  }
+}
+
+StatusOr<std::unique_ptr<PublicKeyVerify>>
+Ed25519VerifyKeyManager::GetPrimitive(const MessageLite& key) const {
+  std::string key_type = std::string(kKeyTypePrefix) + key.GetTypeName();
+  if (DoesSupport(key_type)) {
+    const Ed25519PublicKey& public_key =
+        reinterpret_cast<const Ed25519PublicKey&>(key);
+    return GetPrimitiveImpl(public_key);
+  } else {
+    return ToStatusF(util::error::INVALID_ARGUMENT,
+                     "Key type '%s' is not supported by this manager.",
+                     key_type.c_str());
+  }
+}
+
+StatusOr<std::unique_ptr<PublicKeyVerify>>
+Ed25519VerifyKeyManager::GetPrimitiveImpl(
+    const Ed25519PublicKey& public_key) const {
+  Status status = Validate(public_key);
+  if (!status.ok()) return status;
+  auto ed25519_result =
+      subtle::Ed25519VerifyBoringSsl::New(public_key.key_value());
+  if (!ed25519_result.ok()) return ed25519_result.status();
+  std::unique_ptr<PublicKeyVerify> ed25519(
+      ed25519_result.ValueOrDie().release());
+  return std::move(ed25519);
+}
+
+// static
+Status Ed25519VerifyKeyManager::Validate(const Ed25519PublicKey& key) {
+  Status status = ValidateVersion(key.version(), kVersion);
+  if (!status.ok()) return status;
+  if (key.key_value().size() != ED25519_PUBLIC_KEY_LEN) {
+    return Status(util::error::INVALID_ARGUMENT,
+                  "The ED25519 public key must be 32 bytes long.");
+  }
+  return Status::OK;
+}
+
+}  // namespace tink
+}  // namespace crypto
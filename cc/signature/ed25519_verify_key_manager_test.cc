@@ -0,0 +1,125 @@
+// Copyright 2017 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+////////////////////////////////////////////////////////////////////////////////
+#include "tink/signature/ed25519_verify_key_manager.h"
+
+#include "tink/public_key_verify.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "tink/util/test_util.h"
+#include "gtest/gtest.h"
+#include "proto/ed25519.pb.h"
+#include "proto/tink.pb.h"
+
+namespace crypto {
+namespace tink {
+
+using google::crypto::tink::Ed25519KeyFormat;
+using google::crypto::tink::Ed25519PublicKey;
+using google::crypto::tink::KeyData;
+
+namespace {
+
+class Ed25519VerifyKeyManagerTest : public ::testing::Test {
+ protected:
+  std::string ed25519_verify_key_type_ =
+      "type.googleapis.com/google.crypto.tink.Ed25519PublicKey";
+
+  // Public key and signature of test 1 from
+  // https://tools.ietf.org/html/rfc8032#section-7.1.
+  Ed25519PublicKey GetPublicKey() {
+    Ed25519PublicKey key;
+    key.set_version(0);
+    key.set_key_value(test::HexDecodeOrDie(
+        "d75a980182b10ab7d54bfed3c964073a0ee172f3daa62325af021a68f707511a"));
+    return key;
+  }
+
+  std::string GetSignature() {
+    return test::HexDecodeOrDie(
+        "e5564300c360ac729086e2cc806e828a84877f1eb8e5d974d873e06522490155"
+        "5fb8821590a33bacc61e39701cf9b46bd25bf5f0595bbe24655141438e7a100b");
+  }
+};
+
+TEST_F(Ed25519VerifyKeyManagerTest, testBasic) {
+  Ed25519VerifyKeyManager key_manager;
+  EXPECT_EQ(0, key_manager.get_version());
+  EXPECT_EQ(ed25519_verify_key_type_, key_manager.get_key_type());
+  EXPECT_TRUE(key_manager.DoesSupport(ed25519_verify_key_type_));
+}
+
+TEST_F(Ed25519VerifyKeyManagerTest, testPrimitives) {
+  Ed25519VerifyKeyManager key_manager;
+
+  {  // Using Key proto.
+    auto result = key_manager.GetPrimitive(GetPublicKey());
+    ASSERT_TRUE(result.ok()) << result.status();
+    EXPECT_TRUE(result.ValueOrDie()->Verify(GetSignature(), "").ok());
+    EXPECT_FALSE(result.ValueOrDie()->Verify(GetSignature(), "data").ok());
+  }
+
+  {  // Using KeyData proto.
+    KeyData key_data;
+    key_data.set_type_url(ed25519_verify_key_type_);
+    key_data.set_value(GetPublicKey().SerializeAsString());
+    auto result = key_manager.GetPrimitive(key_data);
+    ASSERT_TRUE(result.ok()) << result.status();
+    EXPECT_TRUE(result.ValueOrDie()->Verify(GetSignature(), "").ok());
+  }
+}
+
+TEST_F(Ed25519VerifyKeyManagerTest, testKeyErrors) {
+  Ed25519VerifyKeyManager key_manager;
+
+  {  // Bad key type.
+    KeyData key_data;
+    key_data.set_type_url(
+        "type.googleapis.com/google.crypto.tink.EcdsaPublicKey");
+    auto result = key_manager.GetPrimitive(key_data);
+    EXPECT_FALSE(result.ok());
+    EXPECT_EQ(util::error::INVALID_ARGUMENT, result.status().error_code());
+  }
+
+  {  // Bad version.
+    Ed25519PublicKey key = GetPublicKey();
+    key.set_version(1);
+    EXPECT_FALSE(key_manager.GetPrimitive(key).ok());
+  }
+
+  {  // Bad key size.
+    Ed25519PublicKey key = GetPublicKey();
+    key.set_key_value(key.key_value().substr(1));
+    EXPECT_FALSE(key_manager.GetPrimitive(key).ok());
+  }
+}
+
+TEST_F(Ed25519VerifyKeyManagerTest, testNewKeyError) {
+  Ed25519VerifyKeyManager key_manager;
+  const KeyFactory& key_factory = key_manager.get_key_factory();
+  Ed25519KeyFormat key_format;
+  auto result = key_factory.NewKey(key_format);
+  EXPECT_FALSE(result.ok());
+  EXPECT_EQ(util::error::UNIMPLEMENTED, result.status().error_code());
+}
+
+}  // namespace
+}  // namespace tink
+}  // namespace crypto
+
+int main(int ac, char* av[]) {
+  testing::InitGoogleTest(&ac, av);
+  return RUN_ALL_TESTS();
+}
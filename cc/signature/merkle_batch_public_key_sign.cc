@@ -0,0 +1,168 @@
+// Copyright 2018 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/signature/merkle_batch_public_key_sign.h"
+
+#include <limits>
+
+#include "absl/strings/string_view.h"
+#include "openssl/sha.h"
+#include "tink/public_key_sign.h"
+#include "tink/util/errors.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+
+namespace {
+
+const char kRootLabel[] = "TinkMerkleBatchV1";
+const uint8_t kLeafTag = 0x00;
+const uint8_t kNodeTag = 0x01;
+
+void AppendBigEndian32(uint32_t value, std::string* out) {
+  out->push_back(static_cast<char>(value >> 24));
+  out->push_back(static_cast<char>(value >> 16));
+  out->push_back(static_cast<char>(value >> 8));
+  out->push_back(static_cast<char>(value));
+}
+
+// Appends H(tag || first || second) to 'out'.
+void AppendHash(uint8_t tag, absl::string_view first, absl::string_view second,
+                std::string* out) {
+  SHA256_CTX ctx;
+  uint8_t digest[SHA256_DIGEST_LENGTH];
+  SHA256_Init(&ctx);
+  SHA256_Update(&ctx, &tag, 1);
+  SHA256_Update(&ctx, first.data(), first.size());
+  SHA256_Update(&ctx, second.data(), second.size());
+  SHA256_Final(digest, &ctx);
+  out->append(reinterpret_cast<const char*>(digest), sizeof(digest));
+}
+
+absl::string_view HashAt(const std::string& level, size_t index) {
+  return absl::string_view(level).substr(index * SHA256_DIGEST_LENGTH,
+                                         SHA256_DIGEST_LENGTH);
+}
+
+}  // anonymous namespace
+
+constexpr uint8_t MerkleBatchPublicKeySign::kVersion;
+constexpr int MerkleBatchPublicKeySign::kHashSize;
+constexpr int MerkleBatchPublicKeySign::kHeaderSize;
+constexpr int MerkleBatchPublicKeySign::kMaxProofSize;
+
+// static
+util::StatusOr<std::unique_ptr<MerkleBatchPublicKeySign>>
+MerkleBatchPublicKeySign::New(std::unique_ptr<PublicKeySign> public_key_sign) {
+  if (public_key_sign == nullptr) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "public_key_sign must be non-null");
+  }
+  return std::unique_ptr<MerkleBatchPublicKeySign>(
+      new MerkleBatchPublicKeySign(std::move(public_key_sign)));
+}
+
+// static
+std::string MerkleBatchPublicKeySign::HashLeaf(absl::string_view message) {
+  std::string hash;
+  AppendHash(kLeafTag, message, absl::string_view(), &hash);
+  return hash;
+}
+
+// static
+std::string MerkleBatchPublicKeySign::HashChildren(absl::string_view left,
+                                                   absl::string_view right) {
+  std::string hash;
+  AppendHash(kNodeTag, left, right, &hash);
+  return hash;
+}
+
+// static
+std::string MerkleBatchPublicKeySign::RootSignatureData(
+    uint32_t tree_size, absl::string_view root) {
+  std::string data(kRootLabel);
+  AppendBigEndian32(tree_size, &data);
+  data.append(root.data(), root.size());
+  return data;
+}
+
+util::StatusOr<std::vector<std::string>> MerkleBatchPublicKeySign::SignBatch(
+    const std::vector<absl::string_view>& messages) const {
+  if (messages.empty()) {
+    return util::Status(util::error::INVALID_ARGUMENT, "empty batch");
+  }
+  if (messages.size() > std::numeric_limits<uint32_t>::max()) {
+    return util::Status(util::error::INVALID_ARGUMENT, "batch too large");
+  }
+  const uint32_t tree_size = messages.size();
+
+  // levels[0] holds the leaf hashes and levels.back() the root, each level
+  // as consecutive kHashSize-byte hashes.
+  std::vector<std::string> levels(1);
+  levels[0].reserve(static_cast<size_t>(tree_size) * kHashSize);
+  for (absl::string_view message : messages) {
+    AppendHash(kLeafTag, message, absl::string_view(), &levels[0]);
+  }
+  while (levels.back().size() > kHashSize) {
+    const std::string& below = levels.back();
+    size_t width = below.size() / kHashSize;
+    std::string level;
+    level.reserve((width + 1) / 2 * kHashSize);
+    for (size_t i = 0; i + 1 < width; i += 2) {
+      AppendHash(kNodeTag, HashAt(below, i), HashAt(below, i + 1), &level);
+    }
+    if (width % 2 == 1) {
+      level.append(HashAt(below, width - 1).data(), kHashSize);
+    }
+    levels.push_back(std::move(level));
+  }
+
+  auto root_signature_result =
+      public_key_sign_->Sign(RootSignatureData(tree_size, levels.back()));
+  if (!root_signature_result.ok()) return root_signature_result.status();
+  const std::string& root_signature = root_signature_result.ValueOrDie();
+
+  std::vector<std::string> signatures;
+  signatures.reserve(tree_size);
+  std::string proof;
+  for (uint32_t leaf_index = 0; leaf_index < tree_size; leaf_index++) {
+    proof.clear();
+    size_t index = leaf_index;
+    for (size_t l = 0; l + 1 < levels.size(); l++) {
+      size_t width = levels[l].size() / kHashSize;
+      size_t sibling = index ^ 1;
+      if (sibling < width) {
+        proof.append(HashAt(levels[l], sibling).data(), kHashSize);
+      }
+      index /= 2;
+    }
+    std::string signature;
+    signature.reserve(kHeaderSize + proof.size() + root_signature.size());
+    signature.push_back(static_cast<char>(kVersion));
+    AppendBigEndian32(tree_size, &signature);
+    AppendBigEndian32(leaf_index, &signature);
+    signature.push_back(static_cast<char>(proof.size() / kHashSize));
+    signature.append(proof);
+    signature.append(root_signature);
+    signatures.push_back(std::move(signature));
+  }
+  return std::move(signatures);
+}
+
+}  // namespace tink
+}  // namespace crypto
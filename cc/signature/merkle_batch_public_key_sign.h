@@ -0,0 +1,90 @@
+// Copyright 2018 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_SIGNATURE_MERKLE_BATCH_PUBLIC_KEY_SIGN_H_
+#define TINK_SIGNATURE_MERKLE_BATCH_PUBLIC_KEY_SIGN_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/strings/string_view.h"
+#include "tink/public_key_sign.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+
+///////////////////////////////////////////////////////////////////////////////
+// Signs a batch of messages with a single signature of the wrapped
+// PublicKeySign, e.g. the one returned by
+// PublicKeySignFactory::GetPrimitive():
+//
+//   auto sign_result =
+//       MerkleBatchPublicKeySign::New(std::move(public_key_sign));
+//   auto signatures_result =
+//       sign_result.ValueOrDie()->SignBatch({"record 1", "record 2"});
+//
+// SignBatch() builds a Merkle tree of SHA-256 hashes over the messages,
+// signs only its root, and returns for each message the root signature
+// together with the message's inclusion proof. Signing n messages thus
+// costs one public key operation and about 2n hashes. The signatures are
+// verified with MerkleBatchPublicKeyVerify.
+//
+// The leaves of the tree are H(0x00 || message), and inner nodes are
+// H(0x01 || left || right), as in RFC 6962; a node without a sibling is
+// carried to the next level unchanged. The signed data is
+//   "TinkMerkleBatchV1" || tree_size (4 bytes, big endian) || root,
+// and each signature is
+//   version (1 byte) || tree_size (4 bytes, big endian) ||
+//   leaf_index (4 bytes, big endian) || proof_size (1 byte) ||
+//   proof (proof_size hashes, leaf to root) || root_signature.
+//
+// The root signatures are signatures over the data above; keys used for
+// batches should not also sign other messages.
+class MerkleBatchPublicKeySign {
+ public:
+  static crypto::tink::util::StatusOr<std::unique_ptr<MerkleBatchPublicKeySign>>
+  New(std::unique_ptr<PublicKeySign> public_key_sign);
+
+  // Returns the signatures of 'messages', in the same order.
+  crypto::tink::util::StatusOr<std::vector<std::string>> SignBatch(
+      const std::vector<absl::string_view>& messages) const;
+
+  // Hashing and encoding helpers shared with MerkleBatchPublicKeyVerify.
+  static std::string HashLeaf(absl::string_view message);
+  static std::string HashChildren(absl::string_view left,
+                                  absl::string_view right);
+  static std::string RootSignatureData(uint32_t tree_size,
+                                       absl::string_view root);
+
+  static constexpr uint8_t kVersion = 1;
+  static constexpr int kHashSize = 32;
+  static constexpr int kHeaderSize = 10;
+  static constexpr int kMaxProofSize = 32;
+
+ private:
+  explicit MerkleBatchPublicKeySign(
+      std::unique_ptr<PublicKeySign> public_key_sign)
+      : public_key_sign_(std::move(public_key_sign)) {}
+
+  const std::unique_ptr<PublicKeySign> public_key_sign_;
+};
+
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_SIGNATURE_MERKLE_BATCH_PUBLIC_KEY_SIGN_H_
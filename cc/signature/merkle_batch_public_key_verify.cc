@@ -0,0 +1,108 @@
+// Copyright 2018 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/signature/merkle_batch_public_key_verify.h"
+
+#include "absl/strings/string_view.h"
+#include "tink/public_key_verify.h"
+#include "tink/signature/caching_public_key_verify.h"
+#include "tink/signature/merkle_batch_public_key_sign.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+
+namespace {
+
+const uint8_t kVersion = MerkleBatchPublicKeySign::kVersion;
+const size_t kHashSize = MerkleBatchPublicKeySign::kHashSize;
+const size_t kHeaderSize = MerkleBatchPublicKeySign::kHeaderSize;
+const size_t kMaxProofSize = MerkleBatchPublicKeySign::kMaxProofSize;
+
+uint32_t LoadBigEndian32(const char* p) {
+  const uint8_t* b = reinterpret_cast<const uint8_t*>(p);
+  return (static_cast<uint32_t>(b[0]) << 24) |
+         (static_cast<uint32_t>(b[1]) << 16) |
+         (static_cast<uint32_t>(b[2]) << 8) | static_cast<uint32_t>(b[3]);
+}
+
+util::Status InvalidSignature() {
+  return util::Status(util::error::INVALID_ARGUMENT, "Invalid signature.");
+}
+
+}  // anonymous namespace
+
+// static
+util::StatusOr<std::unique_ptr<MerkleBatchPublicKeyVerify>>
+MerkleBatchPublicKeyVerify::New(
+    std::unique_ptr<PublicKeyVerify> public_key_verify,
+    size_t root_cache_capacity, std::chrono::milliseconds root_cache_ttl) {
+  if (public_key_verify == nullptr) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "public_key_verify must be non-null");
+  }
+  auto caching_result = CachingPublicKeyVerify::New(
+      std::move(public_key_verify), root_cache_capacity, root_cache_ttl);
+  if (!caching_result.ok()) return caching_result.status();
+  return std::unique_ptr<MerkleBatchPublicKeyVerify>(
+      new MerkleBatchPublicKeyVerify(std::move(caching_result.ValueOrDie())));
+}
+
+util::Status MerkleBatchPublicKeyVerify::Verify(
+    absl::string_view signature, absl::string_view data) const {
+  if (signature.size() < kHeaderSize ||
+      static_cast<uint8_t>(signature[0]) != kVersion) {
+    return InvalidSignature();
+  }
+  uint32_t tree_size = LoadBigEndian32(signature.data() + 1);
+  uint32_t leaf_index = LoadBigEndian32(signature.data() + 5);
+  size_t proof_size = static_cast<uint8_t>(signature[9]);
+  if (leaf_index >= tree_size || proof_size > kMaxProofSize ||
+      signature.size() < kHeaderSize + proof_size * kHashSize) {
+    return InvalidSignature();
+  }
+  absl::string_view proof =
+      signature.substr(kHeaderSize, proof_size * kHashSize);
+  absl::string_view root_signature =
+      signature.substr(kHeaderSize + proof_size * kHashSize);
+
+  // Recompute the root from the leaf, taking the siblings from the proof.
+  std::string hash = MerkleBatchPublicKeySign::HashLeaf(data);
+  uint32_t index = leaf_index;
+  uint32_t width = tree_size;
+  size_t used = 0;
+  while (width > 1) {
+    if ((index ^ 1) < width) {
+      if (used == proof_size) return InvalidSignature();
+      absl::string_view sibling = proof.substr(used * kHashSize, kHashSize);
+      hash = index % 2 == 1
+                 ? MerkleBatchPublicKeySign::HashChildren(sibling, hash)
+                 : MerkleBatchPublicKeySign::HashChildren(hash, sibling);
+      used++;
+    }
+    index /= 2;
+    width = width / 2 + width % 2;
+  }
+  if (used != proof_size) return InvalidSignature();
+
+  return root_verify_->Verify(
+      root_signature,
+      MerkleBatchPublicKeySign::RootSignatureData(tree_size, hash));
+}
+
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,67 @@
+// Copyright 2018 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_SIGNATURE_MERKLE_BATCH_PUBLIC_KEY_VERIFY_H_
+#define TINK_SIGNATURE_MERKLE_BATCH_PUBLIC_KEY_VERIFY_H_
+
+#include <chrono>  // NOLINT(build/c++11)
+#include <memory>
+
+#include "absl/strings/string_view.h"
+#include "tink/public_key_verify.h"
+#include "tink/signature/caching_public_key_verify.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+
+///////////////////////////////////////////////////////////////////////////////
+// Verifies signatures produced by MerkleBatchPublicKeySign (see there for
+// the format): recomputes the Merkle root from the data and the inclusion
+// proof, and verifies the root signature with the wrapped PublicKeyVerify.
+//
+// Successful root verifications are remembered in a CachingPublicKeyVerify
+// of the given capacity and TTL, so that verifying the other messages of a
+// batch whose root was seen recently costs only the hashes of the proof.
+class MerkleBatchPublicKeyVerify : public PublicKeyVerify {
+ public:
+  static crypto::tink::util::StatusOr<
+      std::unique_ptr<MerkleBatchPublicKeyVerify>>
+  New(std::unique_ptr<PublicKeyVerify> public_key_verify,
+      size_t root_cache_capacity, std::chrono::milliseconds root_cache_ttl);
+
+  crypto::tink::util::Status Verify(
+      absl::string_view signature,
+      absl::string_view data) const override;
+
+  // Returns the number of root signatures found in the cache.
+  uint64_t root_cache_hits() const { return root_verify_->hits(); }
+
+  ~MerkleBatchPublicKeyVerify() override {}
+
+ private:
+  explicit MerkleBatchPublicKeyVerify(
+      std::unique_ptr<CachingPublicKeyVerify> root_verify)
+      : root_verify_(std::move(root_verify)) {}
+
+  const std::unique_ptr<CachingPublicKeyVerify> root_verify_;
+};
+
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_SIGNATURE_MERKLE_BATCH_PUBLIC_KEY_VERIFY_H_
@@ -0,0 +1,170 @@
+// Copyright 2018 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/signature/merkle_batch_public_key_verify.h"
+
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "tink/signature/merkle_batch_public_key_sign.h"
+#include "tink/subtle/ed25519_sign_boringssl.h"
+#include "tink/subtle/ed25519_verify_boringssl.h"
+#include "tink/util/status.h"
+#include "tink/util/test_util.h"
+
+namespace crypto {
+namespace tink {
+namespace {
+
+// Key pair from https://tools.ietf.org/html/rfc8032#section-7.1.
+const char kPrivateKeyHex[] =
+    "9d61b19deffd5a60ba844af492ec2cc44449c5697b326919703bac031cae7f60";
+const char kPublicKeyHex[] =
+    "d75a980182b10ab7d54bfed3c964073a0ee172f3daa62325af021a68f707511a";
+
+class MerkleBatchPublicKeyVerifyTest : public ::testing::Test {
+ protected:
+  std::unique_ptr<MerkleBatchPublicKeySign> NewSign() {
+    auto sign_result = subtle::Ed25519SignBoringSsl::New(
+        test::HexDecodeOrDie(kPrivateKeyHex));
+    EXPECT_TRUE(sign_result.ok()) << sign_result.status();
+    auto result =
+        MerkleBatchPublicKeySign::New(std::move(sign_result.ValueOrDie()));
+    EXPECT_TRUE(result.ok()) << result.status();
+    return std::move(result.ValueOrDie());
+  }
+
+  std::unique_ptr<MerkleBatchPublicKeyVerify> NewVerify() {
+    auto verify_result = subtle::Ed25519VerifyBoringSsl::New(
+        test::HexDecodeOrDie(kPublicKeyHex));
+    EXPECT_TRUE(verify_result.ok()) << verify_result.status();
+    auto result = MerkleBatchPublicKeyVerify::New(
+        std::move(verify_result.ValueOrDie()), 16, std::chrono::minutes(1));
+    EXPECT_TRUE(result.ok()) << result.status();
+    return std::move(result.ValueOrDie());
+  }
+
+  static std::vector<std::string> Messages(int count) {
+    std::vector<std::string> messages;
+    for (int i = 0; i < count; i++) {
+      messages.push_back("message " + std::to_string(i));
+    }
+    return messages;
+  }
+
+  static std::vector<std::string> SignBatch(
+      const MerkleBatchPublicKeySign& sign,
+      const std::vector<std::string>& messages) {
+    std::vector<absl::string_view> views(messages.begin(), messages.end());
+    auto result = sign.SignBatch(views);
+    EXPECT_TRUE(result.ok()) << result.status();
+    return result.ValueOrDie();
+  }
+};
+
+TEST_F(MerkleBatchPublicKeyVerifyTest, testSignVerify) {
+  auto sign = NewSign();
+  for (int batch_size : {1, 2, 3, 5, 8, 13, 100}) {
+    SCOPED_TRACE(batch_size);
+    std::vector<std::string> messages = Messages(batch_size);
+    std::vector<std::string> signatures = SignBatch(*sign, messages);
+    ASSERT_EQ(messages.size(), signatures.size());
+    auto verify = NewVerify();
+    for (int i = 0; i < batch_size; i++) {
+      auto status = verify->Verify(signatures[i], messages[i]);
+      EXPECT_TRUE(status.ok()) << i << ": " << status;
+      if (batch_size > 1) {
+        EXPECT_FALSE(
+            verify->Verify(signatures[i], messages[(i + 1) % batch_size]).ok());
+      }
+    }
+    // Only the first message needed a signature verification.
+    EXPECT_EQ(batch_size - 1, verify->root_cache_hits());
+  }
+}
+
+TEST_F(MerkleBatchPublicKeyVerifyTest, testProofSizes) {
+  auto sign = NewSign();
+  std::vector<std::string> messages = Messages(5);
+  std::vector<std::string> signatures = SignBatch(*sign, messages);
+  // In a tree of 5 leaves the 5th leaf is promoted twice and has only one
+  // sibling, the root of the first four leaves.
+  const int kHeaderSize = MerkleBatchPublicKeySign::kHeaderSize;
+  const int kHashSize = MerkleBatchPublicKeySign::kHashSize;
+  for (int i = 0; i < 4; i++) {
+    EXPECT_EQ(3, signatures[i][kHeaderSize - 1]);
+    EXPECT_EQ(kHeaderSize + 3 * kHashSize + 64, signatures[i].size());
+  }
+  EXPECT_EQ(1, signatures[4][kHeaderSize - 1]);
+  EXPECT_EQ(kHeaderSize + kHashSize + 64, signatures[4].size());
+}
+
+TEST_F(MerkleBatchPublicKeyVerifyTest, testModifiedSignatures) {
+  auto sign = NewSign();
+  std::vector<std::string> messages = Messages(6);
+  std::vector<std::string> signatures = SignBatch(*sign, messages);
+  auto verify = NewVerify();
+  for (int i = 0; i < 6; i++) {
+    for (size_t position = 0; position < signatures[i].size(); position++) {
+      std::string modified = signatures[i];
+      modified[position] ^= 0x01;
+      EXPECT_FALSE(verify->Verify(modified, messages[i]).ok())
+          << i << ", " << position;
+    }
+    for (size_t size = 0; size < signatures[i].size(); size++) {
+      EXPECT_FALSE(
+          verify->Verify(signatures[i].substr(0, size), messages[i]).ok());
+    }
+    EXPECT_FALSE(verify->Verify(signatures[i] + "x", messages[i]).ok());
+    EXPECT_TRUE(verify->Verify(signatures[i], messages[i]).ok());
+  }
+}
+
+TEST_F(MerkleBatchPublicKeyVerifyTest, testOtherBatchesAndKeys) {
+  auto sign = NewSign();
+  std::vector<std::string> messages = Messages(4);
+  std::vector<std::string> first = SignBatch(*sign, messages);
+  std::vector<std::string> second = SignBatch(*sign, Messages(3));
+  auto verify = NewVerify();
+  // A message of the second batch is not in the first one.
+  EXPECT_TRUE(verify->Verify(first[3], messages[3]).ok());
+  EXPECT_FALSE(verify->Verify(second[2], messages[3]).ok());
+
+  // A plain signature over the message is not a batch signature.
+  auto plain_sign = std::move(subtle::Ed25519SignBoringSsl::New(
+      test::HexDecodeOrDie(kPrivateKeyHex)).ValueOrDie());
+  EXPECT_FALSE(
+      verify->Verify(plain_sign->Sign(messages[0]).ValueOrDie(), messages[0])
+          .ok());
+}
+
+TEST_F(MerkleBatchPublicKeyVerifyTest, testInvalidParameters) {
+  EXPECT_FALSE(MerkleBatchPublicKeySign::New(nullptr).ok());
+  EXPECT_FALSE(MerkleBatchPublicKeyVerify::New(nullptr, 16,
+                                               std::chrono::minutes(1)).ok());
+  auto sign = NewSign();
+  EXPECT_FALSE(sign->SignBatch({}).ok());
+}
+
+}  // namespace
+}  // namespace tink
+}  // namespace crypto
+
+int main(int ac, char* av[]) {
+  testing::InitGoogleTest(&ac, av);
+  return RUN_ALL_TESTS();
+}
@@ -19,6 +19,7 @@
 #include "absl/strings/ascii.h"
 #include "tink/catalogue.h"
 #include "tink/signature/ecdsa_sign_key_manager.h"
+#include "tink/signature/ed25519_sign_key_manager.h"
 #include "tink/key_manager.h"
 #include "tink/util/status.h"
 #include "tink/util/statusor.h"
@@ -35,6 +36,11 @@ CreateKeyManager(const std::string& type_url) {
         new EcdsaSignKeyManager());
     return std::move(manager);
   }
+  if (type_url == Ed25519SignKeyManager::kKeyType) {
+    std::unique_ptr<KeyManager<PublicKeySign>> manager(
+        new Ed25519SignKeyManager());
+    return std::move(manager);
+  }
   return ToStatusF(crypto::tink::util::error::NOT_FOUND,
                    "No key manager for type_url '%s'.", type_url.c_str());
 }
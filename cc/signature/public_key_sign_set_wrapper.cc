@@ -17,6 +17,7 @@
 #include "tink/signature/public_key_sign_set_wrapper.h"
 
 #include "tink/crypto_format.h"
+#include "tink/output_buffer.h"
 #include "tink/primitive_set.h"
 #include "tink/public_key_sign.h"
 #include "tink/subtle/subtle_util_boringssl.h"
@@ -42,6 +43,35 @@ util::Status Validate(PrimitiveSet<PublicKeySign>* public_key_sign_set) {
   return util::Status::OK;
 }
 
+// Adds the output prefix of a key to the signatures of its signer.
+class PublicKeySignerSetWrapper : public PublicKeySigner {
+ public:
+  PublicKeySignerSetWrapper(std::unique_ptr<PublicKeySigner> signer,
+                            const std::string& key_id, bool is_legacy)
+      : signer_(std::move(signer)), key_id_(key_id), is_legacy_(is_legacy) {}
+
+  util::Status Update(absl::string_view data) override {
+    return signer_->Update(data);
+  }
+
+  util::StatusOr<std::string> Finalize() override {
+    if (is_legacy_) {
+      // LEGACY signatures are computed over data || kLegacyStartByte.
+      util::Status status = signer_->Update(absl::string_view(
+          reinterpret_cast<const char*>(&CryptoFormat::kLegacyStartByte), 1));
+      if (!status.ok()) return status;
+    }
+    auto sign_result = signer_->Finalize();
+    if (!sign_result.ok()) return sign_result.status();
+    return key_id_ + sign_result.ValueOrDie();
+  }
+
+ private:
+  const std::unique_ptr<PublicKeySigner> signer_;
+  const std::string key_id_;
+  const bool is_legacy_;
+};
+
 }  // anonymous namespace
 
 // static
@@ -62,11 +92,15 @@ util::StatusOr<std::string> PublicKeySignSetWrapper::Sign(
   data = subtle::SubtleUtilBoringSSL::EnsureNonNull(data);
 
   auto primary = public_key_sign_set_->get_primary();
-  std::string local_data;
   if (primary->get_output_prefix_type() == OutputPrefixType::LEGACY) {
-    local_data = std::string(data);
-    local_data.append(1, CryptoFormat::kLegacyStartByte);
-    data = local_data;
+    // Goes through the signer so that the legacy start byte is appended
+    // without copying 'data'.
+    auto signer_result = NewSigner();
+    if (!signer_result.ok()) return signer_result.status();
+    auto signer = std::move(signer_result.ValueOrDie());
+    util::Status status = signer->Update(data);
+    if (!status.ok()) return status;
+    return signer->Finalize();
   }
   auto sign_result = primary->get_primitive().Sign(data);
   if (!sign_result.ok()) return sign_result.status();
@@ -74,5 +108,31 @@ util::StatusOr<std::string> PublicKeySignSetWrapper::Sign(
   return key_id + sign_result.ValueOrDie();
 }
 
+util::Status PublicKeySignSetWrapper::SignInto(
+    absl::string_view data, OutputBuffer* signature) const {
+  data = subtle::SubtleUtilBoringSSL::EnsureNonNull(data);
+
+  auto primary = public_key_sign_set_->get_primary();
+  if (primary->get_output_prefix_type() == OutputPrefixType::LEGACY) {
+    auto sign_result = Sign(data);
+    if (!sign_result.ok()) return sign_result.status();
+    return WriteToOutputBuffer(sign_result.ValueOrDie(), signature);
+  }
+  // The primitive writes its signature right after the key prefix.
+  PrefixedOutputBuffer output(primary->get_identifier(), signature);
+  return primary->get_primitive().SignInto(data, &output);
+}
+
+util::StatusOr<std::unique_ptr<PublicKeySigner>>
+PublicKeySignSetWrapper::NewSigner() const {
+  auto primary = public_key_sign_set_->get_primary();
+  auto signer_result = primary->get_primitive().NewSigner();
+  if (!signer_result.ok()) return signer_result.status();
+  std::unique_ptr<PublicKeySigner> signer(new PublicKeySignerSetWrapper(
+      std::move(signer_result.ValueOrDie()), primary->get_identifier(),
+      primary->get_output_prefix_type() == OutputPrefixType::LEGACY));
+  return std::move(signer);
+}
+
 }  // namespace tink
 }  // namespace crypto
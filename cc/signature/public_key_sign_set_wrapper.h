@@ -18,8 +18,10 @@
 #define TINK_SIGNATURE_PUBLIC_KEY_SIGN_SET_WRAPPER_H_
 
 #include "absl/strings/string_view.h"
+#include "tink/output_buffer.h"
 #include "tink/public_key_sign.h"
 #include "tink/primitive_set.h"
+#include "tink/util/status.h"
 #include "tink/util/statusor.h"
 #include "proto/tink.pb.h"
 
@@ -42,6 +44,14 @@ class PublicKeySignSetWrapper : public PublicKeySign {
   crypto::tink::util::StatusOr<std::string> Sign(absl::string_view data)
       const override;
 
+  crypto::tink::util::Status SignInto(absl::string_view data,
+                                      OutputBuffer* signature) const override;
+
+  // Returns a signer of the primary instance, which produces the same
+  // signatures as Sign().
+  crypto::tink::util::StatusOr<std::unique_ptr<PublicKeySigner>> NewSigner()
+      const override;
+
   virtual ~PublicKeySignSetWrapper() {}
 
  private:
@@ -165,6 +165,46 @@ TEST_F(PublicKeySignSetWrapperTest, testLegacySignatures) {
     EXPECT_TRUE(status.ok()) << status;
 }
 
+TEST_F(PublicKeySignSetWrapperTest, testSigner) {
+  for (auto output_prefix_type :
+       {OutputPrefixType::TINK, OutputPrefixType::LEGACY,
+        OutputPrefixType::RAW}) {
+    Keyset::Key key;
+    key.set_output_prefix_type(output_prefix_type);
+    key.set_key_id(1234543);
+    std::string signature_name = "SomeSignatures";
+
+    std::unique_ptr<PrimitiveSet<PublicKeySign>> pk_sign_set(
+        new PrimitiveSet<PublicKeySign>());
+    std::unique_ptr<PublicKeySign> pk_sign(
+        new DummyPublicKeySign(signature_name));
+    auto entry_result = pk_sign_set->AddPrimitive(std::move(pk_sign), key);
+    ASSERT_TRUE(entry_result.ok());
+    pk_sign_set->set_primary(entry_result.ValueOrDie());
+    auto pk_sign_result = PublicKeySignSetWrapper::NewPublicKeySign(
+        std::move(pk_sign_set));
+    EXPECT_TRUE(pk_sign_result.ok()) << pk_sign_result.status();
+    pk_sign = std::move(pk_sign_result.ValueOrDie());
+
+    // Signing in chunks gives the same signature as signing at once.
+    auto signer_result = pk_sign->NewSigner();
+    EXPECT_TRUE(signer_result.ok()) << signer_result.status();
+    auto signer = std::move(signer_result.ValueOrDie());
+    EXPECT_TRUE(signer->Update("Some data").ok());
+    EXPECT_TRUE(signer->Update("").ok());
+    EXPECT_TRUE(signer->Update(" to sign").ok());
+    auto finalize_result = signer->Finalize();
+    EXPECT_TRUE(finalize_result.ok()) << finalize_result.status();
+    auto sign_result = pk_sign->Sign("Some data to sign");
+    EXPECT_TRUE(sign_result.ok()) << sign_result.status();
+    EXPECT_EQ(sign_result.ValueOrDie(), finalize_result.ValueOrDie());
+
+    // A finalized signer cannot be used anymore.
+    EXPECT_FALSE(signer->Update("more data").ok());
+    EXPECT_FALSE(signer->Finalize().ok());
+  }
+}
+
 }  // namespace
 }  // namespace tink
 }  // namespace crypto
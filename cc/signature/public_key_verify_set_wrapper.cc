@@ -16,6 +16,8 @@
 
 #include "tink/signature/public_key_verify_set_wrapper.h"
 
+#include <vector>
+
 #include "tink/crypto_format.h"
 #include "tink/primitive_set.h"
 #include "tink/public_key_verify.h"
@@ -43,6 +45,65 @@ util::Status Validate(PrimitiveSet<PublicKeyVerify>* public_key_verify_set) {
   return util::Status::OK;
 }
 
+absl::string_view LegacyStartByte() {
+  return absl::string_view(
+      reinterpret_cast<const char*>(&CryptoFormat::kLegacyStartByte), 1);
+}
+
+// Verifies a LEGACY signature, which is computed over
+// data || kLegacyStartByte, without copying 'data'.
+util::Status VerifyLegacy(const PublicKeyVerify& public_key_verify,
+                          absl::string_view signature,
+                          absl::string_view data) {
+  auto verifier_result = public_key_verify.NewVerifier(signature);
+  if (!verifier_result.ok()) return verifier_result.status();
+  auto verifier = std::move(verifier_result.ValueOrDie());
+  util::Status status = verifier->Update(data);
+  if (!status.ok()) return status;
+  status = verifier->Update(LegacyStartByte());
+  if (!status.ok()) return status;
+  return verifier->Finalize();
+}
+
+// Feeds the data to the verifiers of all candidate keys, and accepts the
+// signature if any of them does.
+class PublicKeyVerifierSetWrapper : public PublicKeyVerifier {
+ public:
+  struct Candidate {
+    std::unique_ptr<PublicKeyVerifier> verifier;
+    bool is_legacy;
+  };
+
+  explicit PublicKeyVerifierSetWrapper(std::vector<Candidate> candidates)
+      : candidates_(std::move(candidates)) {}
+
+  util::Status Update(absl::string_view data) override {
+    for (auto& candidate : candidates_) {
+      if (candidate.verifier == nullptr) continue;
+      if (!candidate.verifier->Update(data).ok()) {
+        // This candidate can no longer verify the signature.
+        candidate.verifier.reset();
+      }
+    }
+    return util::Status::OK;
+  }
+
+  util::Status Finalize() override {
+    for (auto& candidate : candidates_) {
+      if (candidate.verifier == nullptr) continue;
+      if (candidate.is_legacy &&
+          !candidate.verifier->Update(LegacyStartByte()).ok()) {
+        continue;
+      }
+      if (candidate.verifier->Finalize().ok()) return util::Status::OK;
+    }
+    return util::Status(util::error::INVALID_ARGUMENT, "Invalid signature.");
+  }
+
+ private:
+  std::vector<Candidate> candidates_;
+};
+
 }  // anonymous namespace
 
 // static
@@ -75,16 +136,12 @@ util::Status PublicKeyVerifySetWrapper::Verify(
   if (primitives_result.ok()) {
     absl::string_view raw_signature =
         signature.substr(CryptoFormat::kNonRawPrefixSize);
-    std::string local_data;
     for (auto& entry : *(primitives_result.ValueOrDie())) {
-      if (entry->get_output_prefix_type() == OutputPrefixType::LEGACY) {
-        local_data = std::string(data);
-        local_data.append(1, CryptoFormat::kLegacyStartByte);
-        data = local_data;
-      }
       auto& public_key_verify = entry->get_primitive();
       auto verify_result =
-          public_key_verify.Verify(raw_signature, data);
+          entry->get_output_prefix_type() == OutputPrefixType::LEGACY
+              ? VerifyLegacy(public_key_verify, raw_signature, data)
+              : public_key_verify.Verify(raw_signature, data);
       if (verify_result.ok()) {
         return util::Status::OK;
       } else {
@@ -108,5 +165,43 @@ util::Status PublicKeyVerifySetWrapper::Verify(
   return util::Status(util::error::INVALID_ARGUMENT, "Invalid signature.");
 }
 
+util::StatusOr<std::unique_ptr<PublicKeyVerifier>>
+PublicKeyVerifySetWrapper::NewVerifier(absl::string_view signature) const {
+  signature = subtle::SubtleUtilBoringSSL::EnsureNonNull(signature);
+
+  if (signature.length() <= CryptoFormat::kNonRawPrefixSize) {
+    return util::Status(util::error::INVALID_ARGUMENT, "Signature too short.");
+  }
+  std::vector<PublicKeyVerifierSetWrapper::Candidate> candidates;
+  const std::string& key_id = std::string(
+      signature.substr(0, CryptoFormat::kNonRawPrefixSize));
+  auto primitives_result = public_key_verify_set_->get_primitives(key_id);
+  if (primitives_result.ok()) {
+    absl::string_view raw_signature =
+        signature.substr(CryptoFormat::kNonRawPrefixSize);
+    for (auto& entry : *(primitives_result.ValueOrDie())) {
+      auto verifier_result = entry->get_primitive().NewVerifier(raw_signature);
+      if (!verifier_result.ok()) continue;
+      candidates.push_back(
+          {std::move(verifier_result.ValueOrDie()),
+           entry->get_output_prefix_type() == OutputPrefixType::LEGACY});
+    }
+  }
+  auto raw_primitives_result = public_key_verify_set_->get_raw_primitives();
+  if (raw_primitives_result.ok()) {
+    for (auto& entry : *(raw_primitives_result.ValueOrDie())) {
+      auto verifier_result = entry->get_primitive().NewVerifier(signature);
+      if (!verifier_result.ok()) continue;
+      candidates.push_back({std::move(verifier_result.ValueOrDie()), false});
+    }
+  }
+  if (candidates.empty()) {
+    return util::Status(util::error::INVALID_ARGUMENT, "Invalid signature.");
+  }
+  std::unique_ptr<PublicKeyVerifier> verifier(
+      new PublicKeyVerifierSetWrapper(std::move(candidates)));
+  return std::move(verifier);
+}
+
 }  // namespace tink
 }  // namespace crypto
@@ -44,6 +44,11 @@ class PublicKeyVerifySetWrapper : public PublicKeyVerify {
       absl::string_view signature,
       absl::string_view data) const override;
 
+  // Returns a verifier that tries all instances that Verify() would try
+  // for 'signature', feeding each chunk to all of them.
+  crypto::tink::util::StatusOr<std::unique_ptr<PublicKeyVerifier>>
+  NewVerifier(absl::string_view signature) const override;
+
   virtual ~PublicKeyVerifySetWrapper() {}
 
  private:
@@ -14,6 +14,7 @@
 //
 ////////////////////////////////////////////////////////////////////////////////
 
+#include "tink/signature/public_key_sign_set_wrapper.h"
 #include "tink/signature/public_key_verify_set_wrapper.h"
 #include "tink/public_key_verify.h"
 #include "tink/primitive_set.h"
@@ -118,6 +119,68 @@ TEST_F(PublicKeyVerifySetWrapperTest, testBasic) {
   }
 }
 
+TEST_F(PublicKeyVerifySetWrapperTest, testVerifier) {
+  Keyset::Key* key;
+  Keyset keyset;
+  OutputPrefixType output_prefix_types[] = {
+      OutputPrefixType::RAW, OutputPrefixType::LEGACY, OutputPrefixType::TINK};
+  std::vector<std::string> signature_names = {"signature_0", "signature_1",
+                                              "signature_2"};
+  std::unique_ptr<PrimitiveSet<PublicKeyVerify>> pk_verify_set(
+      new PrimitiveSet<PublicKeyVerify>());
+  std::unique_ptr<PrimitiveSet<PublicKeySign>> pk_sign_set(
+      new PrimitiveSet<PublicKeySign>());
+  for (int i = 0; i < 3; i++) {
+    key = keyset.add_key();
+    key->set_output_prefix_type(output_prefix_types[i]);
+    key->set_key_id(1000 + i);
+    std::unique_ptr<PublicKeyVerify> pk_verify(
+        new DummyPublicKeyVerify(signature_names[i]));
+    auto entry_result =
+        pk_verify_set->AddPrimitive(std::move(pk_verify), keyset.key(i));
+    ASSERT_TRUE(entry_result.ok());
+    pk_verify_set->set_primary(entry_result.ValueOrDie());
+  }
+  auto pk_verify_result = PublicKeyVerifySetWrapper::NewPublicKeyVerify(
+      std::move(pk_verify_set));
+  EXPECT_TRUE(pk_verify_result.ok()) << pk_verify_result.status();
+  auto pk_verify = std::move(pk_verify_result.ValueOrDie());
+
+  std::string data = "some data to sign";
+  for (int i = 0; i < 3; i++) {
+    // Signatures of all keys in the set, computed via the sign wrapper.
+    std::unique_ptr<PrimitiveSet<PublicKeySign>> pk_sign_set(
+        new PrimitiveSet<PublicKeySign>());
+    std::unique_ptr<PublicKeySign> pk_sign(
+        new DummyPublicKeySign(signature_names[i]));
+    auto entry_result =
+        pk_sign_set->AddPrimitive(std::move(pk_sign), keyset.key(i));
+    ASSERT_TRUE(entry_result.ok());
+    pk_sign_set->set_primary(entry_result.ValueOrDie());
+    pk_sign = std::move(
+        PublicKeySignSetWrapper::NewPublicKeySign(std::move(pk_sign_set))
+            .ValueOrDie());
+    std::string signature = pk_sign->Sign(data).ValueOrDie();
+    EXPECT_TRUE(pk_verify->Verify(signature, data).ok()) << i;
+
+    auto verifier_result = pk_verify->NewVerifier(signature);
+    EXPECT_TRUE(verifier_result.ok()) << verifier_result.status();
+    auto verifier = std::move(verifier_result.ValueOrDie());
+    EXPECT_TRUE(verifier->Update("some data").ok());
+    EXPECT_TRUE(verifier->Update(" to sign").ok());
+    auto status = verifier->Finalize();
+    EXPECT_TRUE(status.ok()) << i << ": " << status;
+
+    // Wrong data.
+    verifier = std::move(pk_verify->NewVerifier(signature).ValueOrDie());
+    EXPECT_TRUE(verifier->Update("some other data").ok());
+    EXPECT_FALSE(verifier->Finalize().ok()) << i;
+  }
+
+  // Too short signature.
+  EXPECT_FALSE(pk_verify->NewVerifier("1234").ok());
+}
+
 }  // namespace
 }  // namespace tink
 }  // namespace crypto
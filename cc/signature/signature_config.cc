@@ -39,6 +39,14 @@ google::crypto::tink::RegistryConfig* GenerateRegistryConfig() {
       SignatureConfig::kPublicKeyVerifyCatalogueName,
       SignatureConfig::kPublicKeyVerifyPrimitiveName,
       "EcdsaPublicKey", 0, true));
+  config->add_entry()->MergeFrom(*Config::GetTinkKeyTypeEntry(
+      SignatureConfig::kPublicKeySignCatalogueName,
+      SignatureConfig::kPublicKeySignPrimitiveName,
+      "Ed25519PrivateKey", 0, true));
+  config->add_entry()->MergeFrom(*Config::GetTinkKeyTypeEntry(
+      SignatureConfig::kPublicKeyVerifyCatalogueName,
+      SignatureConfig::kPublicKeyVerifyPrimitiveName,
+      "Ed25519PublicKey", 0, true));
   config->set_config_name("TINK_SIGNATURE");
   return config;
 }
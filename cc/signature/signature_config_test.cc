@@ -52,9 +52,13 @@ TEST_F(SignatureConfigTest, testBasic) {
       "type.googleapis.com/google.crypto.tink.EcdsaPrivateKey";
   std::string verify_key_type =
       "type.googleapis.com/google.crypto.tink.EcdsaPublicKey";
+  std::string ed25519_sign_key_type =
+      "type.googleapis.com/google.crypto.tink.Ed25519PrivateKey";
+  std::string ed25519_verify_key_type =
+      "type.googleapis.com/google.crypto.tink.Ed25519PublicKey";
   auto& config = SignatureConfig::Latest();
 
-  EXPECT_EQ(2, SignatureConfig::Latest().entry_size());
+  EXPECT_EQ(4, SignatureConfig::Latest().entry_size());
 
   EXPECT_EQ("TinkPublicKeySign", config.entry(0).catalogue_name());
   EXPECT_EQ("PublicKeySign", config.entry(0).primitive_name());
@@ -68,6 +72,18 @@ TEST_F(SignatureConfigTest, testBasic) {
   EXPECT_EQ(true, config.entry(1).new_key_allowed());
   EXPECT_EQ(0, config.entry(1).key_manager_version());
 
+  EXPECT_EQ("TinkPublicKeySign", config.entry(2).catalogue_name());
+  EXPECT_EQ("PublicKeySign", config.entry(2).primitive_name());
+  EXPECT_EQ(ed25519_sign_key_type, config.entry(2).type_url());
+  EXPECT_EQ(true, config.entry(2).new_key_allowed());
+  EXPECT_EQ(0, config.entry(2).key_manager_version());
+
+  EXPECT_EQ("TinkPublicKeyVerify", config.entry(3).catalogue_name());
+  EXPECT_EQ("PublicKeyVerify", config.entry(3).primitive_name());
+  EXPECT_EQ(ed25519_verify_key_type, config.entry(3).type_url());
+  EXPECT_EQ(true, config.entry(3).new_key_allowed());
+  EXPECT_EQ(0, config.entry(3).key_manager_version());
+
   // No key manager before registration.
   auto sign_manager_result =
       Registry::get_key_manager<PublicKeySign>(sign_key_type);
@@ -86,6 +102,13 @@ TEST_F(SignatureConfigTest, testBasic) {
       Registry::get_key_manager<PublicKeyVerify>(verify_key_type);
   EXPECT_TRUE(verify_manager_result.ok()) << verify_manager_result.status();
   EXPECT_TRUE(verify_manager_result.ValueOrDie()->DoesSupport(verify_key_type));
+
+  sign_manager_result =
+      Registry::get_key_manager<PublicKeySign>(ed25519_sign_key_type);
+  EXPECT_TRUE(sign_manager_result.ok()) << sign_manager_result.status();
+  verify_manager_result =
+      Registry::get_key_manager<PublicKeyVerify>(ed25519_verify_key_type);
+  EXPECT_TRUE(verify_manager_result.ok()) << verify_manager_result.status();
 }
 
 TEST_F(SignatureConfigTest, testRegister) {
@@ -18,6 +18,7 @@
 
 #include "proto/ecdsa.pb.h"
 #include "proto/common.pb.h"
+#include "proto/ed25519.pb.h"
 #include "proto/tink.pb.h"
 
 namespace crypto {
@@ -26,6 +27,7 @@ namespace {
 
 using google::crypto::tink::EcdsaKeyFormat;
 using google::crypto::tink::EcdsaSignatureEncoding;
+using google::crypto::tink::Ed25519KeyFormat;
 using google::crypto::tink::EllipticCurveType;
 using google::crypto::tink::HashType;
 using google::crypto::tink::KeyTemplate;
@@ -47,6 +49,16 @@ KeyTemplate* NewEcdsaKeyTemplate(HashType hash_type,
   return key_template;
 }
 
+KeyTemplate* NewEd25519KeyTemplate() {
+  KeyTemplate* key_template = new KeyTemplate;
+  key_template->set_type_url(
+      "type.googleapis.com/google.crypto.tink.Ed25519PrivateKey");
+  key_template->set_output_prefix_type(OutputPrefixType::TINK);
+  Ed25519KeyFormat key_format;
+  key_format.SerializeToString(key_template->mutable_value());
+  return key_template;
+}
+
 }  // anonymous namespace
 
 // static
@@ -100,5 +112,11 @@ const KeyTemplate& SignatureKeyTemplates::EcdsaP521Ieee() {
   return *key_template;
 }
 
+// static
+const KeyTemplate& SignatureKeyTemplates::Ed25519() {
+  static const KeyTemplate* key_template = NewEd25519KeyTemplate();
+  return *key_template;
+}
+
 }  // namespace tink
 }  // namespace crypto
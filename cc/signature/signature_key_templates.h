@@ -82,6 +82,11 @@ class SignatureKeyTemplates {
   //   - signature encoding: IEEE_P1363
   //   - OutputPrefixType: TINK
   static const google::crypto::tink::KeyTemplate& EcdsaP521Ieee();
+
+  // Returns a KeyTemplate that generates new instances of Ed25519PrivateKey
+  // with the following parameters:
+  //   - OutputPrefixType: TINK
+  static const google::crypto::tink::KeyTemplate& Ed25519();
 };
 
 }  // namespace tink
@@ -17,8 +17,10 @@
 #include "tink/signature/signature_key_templates.h"
 
 #include "tink/signature/ecdsa_sign_key_manager.h"
+#include "tink/signature/ed25519_sign_key_manager.h"
 #include "proto/common.pb.h"
 #include "proto/ecdsa.pb.h"
+#include "proto/ed25519.pb.h"
 #include "proto/tink.pb.h"
 #include "gtest/gtest.h"
 
@@ -28,6 +30,7 @@ namespace {
 
 using google::crypto::tink::EcdsaKeyFormat;
 using google::crypto::tink::EcdsaSignatureEncoding;
+using google::crypto::tink::Ed25519KeyFormat;
 using google::crypto::tink::EllipticCurveType;
 using google::crypto::tink::HashType;
 using google::crypto::tink::KeyTemplate;
@@ -176,6 +179,28 @@ TEST(SignatureKeyTemplatesTest, testKeyTemplatesWithIeeeEncoding) {
   }
 }
 
+TEST(SignatureKeyTemplatesTest, testEd25519KeyTemplate) {
+  std::string type_url =
+      "type.googleapis.com/google.crypto.tink.Ed25519PrivateKey";
+
+  // Check that returned template is correct.
+  const KeyTemplate& key_template = SignatureKeyTemplates::Ed25519();
+  EXPECT_EQ(type_url, key_template.type_url());
+  EXPECT_EQ(OutputPrefixType::TINK, key_template.output_prefix_type());
+  Ed25519KeyFormat key_format;
+  EXPECT_TRUE(key_format.ParseFromString(key_template.value()));
+
+  // Check that reference to the same object is returned.
+  const KeyTemplate& key_template_2 = SignatureKeyTemplates::Ed25519();
+  EXPECT_EQ(&key_template, &key_template_2);
+
+  // Check that the template works with the key manager.
+  Ed25519SignKeyManager key_manager;
+  EXPECT_EQ(key_manager.get_key_type(), key_template.type_url());
+  auto new_key_result = key_manager.get_key_factory().NewKey(key_format);
+  EXPECT_TRUE(new_key_result.ok()) << new_key_result.status();
+}
+
 }  // namespace
 }  // namespace tink
 }  // namespace crypto
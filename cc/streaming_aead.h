@@ -0,0 +1,78 @@
+// Copyright 2018 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_STREAMING_AEAD_H_
+#define TINK_STREAMING_AEAD_H_
+
+#include <stdint.h>
+
+#include "absl/strings/string_view.h"
+#include "tink/random_access_stream.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+
+///////////////////////////////////////////////////////////////////////////////
+// The interface for authenticated encryption with associated data of large
+// objects. The plaintext is split into segments that are encrypted and
+// authenticated independently, such that the ciphertext can be produced
+// and consumed in parallel, and parts of it can be decrypted without
+// touching the rest. The ciphertext format prevents reordering, truncating
+// and extending the segments.
+// (see https://eprint.iacr.org/2015/189.pdf)
+class StreamingAead {
+ public:
+  // Returns the size of the ciphertext of a plaintext of 'plaintext_size'
+  // bytes.
+  virtual uint64_t CiphertextSize(uint64_t plaintext_size) const = 0;
+
+  // Returns the size of the plaintext of a ciphertext of 'ciphertext_size'
+  // bytes, or an error if no ciphertext has that size.
+  virtual crypto::tink::util::StatusOr<uint64_t> PlaintextSize(
+      uint64_t ciphertext_size) const = 0;
+
+  // Encrypts the whole of 'plaintext' with 'associated_data' as associated
+  // data, and writes the resulting CiphertextSize(plaintext size) bytes to
+  // 'ciphertext', starting at position 0.
+  virtual crypto::tink::util::Status Encrypt(
+      RandomAccessStream* plaintext, absl::string_view associated_data,
+      RandomAccessSink* ciphertext) const = 0;
+
+  // Decrypts the whole of 'ciphertext' with 'associated_data' as associated
+  // data, and writes the resulting plaintext to 'plaintext', starting at
+  // position 0. If decryption fails, whatever was written to 'plaintext'
+  // must be discarded.
+  virtual crypto::tink::util::Status Decrypt(
+      RandomAccessStream* ciphertext, absl::string_view associated_data,
+      RandomAccessSink* plaintext) const = 0;
+
+  // Decrypts the 'count' bytes of plaintext starting at plaintext position
+  // 'position', reading and authenticating only the segments of
+  // 'ciphertext' that contain them. Returns an OUT_OF_RANGE error if the
+  // plaintext ends before 'position' + 'count'.
+  virtual crypto::tink::util::StatusOr<std::string> DecryptRange(
+      RandomAccessStream* ciphertext, absl::string_view associated_data,
+      uint64_t position, size_t count) const = 0;
+
+  virtual ~StreamingAead() {}
+};
+
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_STREAMING_AEAD_H_
@@ -0,0 +1,283 @@
+// Copyright 2018 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/streamingaead/aes_ctr_hmac_streaming_key_manager.h"
+
+#include "absl/strings/string_view.h"
+#include "tink/key_manager.h"
+#include "tink/streaming_aead.h"
+#include "tink/subtle/aes_ctr_hmac_streaming.h"
+#include "tink/subtle/random.h"
+#include "tink/util/enums.h"
+#include "tink/util/errors.h"
+#include "tink/util/protobuf_helper.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "tink/util/validation.h"
+#include "proto/aes_ctr_hmac_streaming.pb.h"
+#include "proto/common.pb.h"
+#include "proto/hmac.pb.h"
+#include "proto/tink.pb.h"
+
+namespace crypto {
+namespace tink {
+
+using google::crypto::tink::AesCtrHmacStreamingKey;
+using google::crypto::tink::AesCtrHmacStreamingKeyFormat;
+using google::crypto::tink::AesCtrHmacStreamingParams;
+using google::crypto::tink::HashType;
+using google::crypto::tink::HmacParams;
+using google::crypto::tink::KeyData;
+using google::crypto::tink::KeyTemplate;
+using portable_proto::MessageLite;
+using crypto::tink::util::Status;
+using crypto::tink::util::StatusOr;
+
+class AesCtrHmacStreamingKeyFactory : public KeyFactory {
+ public:
+  AesCtrHmacStreamingKeyFactory() {}
+
+  // Generates a new random AesCtrHmacStreamingKey, based on the specified
+  // 'key_format', which must contain AesCtrHmacStreamingKeyFormat-proto.
+  crypto::tink::util::StatusOr<std::unique_ptr<portable_proto::MessageLite>>
+  NewKey(const portable_proto::MessageLite& key_format) const override;
+
+  // Generates a new random AesCtrHmacStreamingKey, based on the specified
+  // 'serialized_key_format', which must contain
+  // AesCtrHmacStreamingKeyFormat-proto.
+  crypto::tink::util::StatusOr<std::unique_ptr<portable_proto::MessageLite>>
+  NewKey(absl::string_view serialized_key_format) const override;
+
+  // Generates a new random AesCtrHmacStreamingKey, based on the specified
+  // 'serialized_key_format' (which must contain
+  // AesCtrHmacStreamingKeyFormat-proto), and wraps it in a KeyData-proto.
+  crypto::tink::util::StatusOr<std::unique_ptr<google::crypto::tink::KeyData>>
+  NewKeyData(absl::string_view serialized_key_format) const override;
+};
+
+StatusOr<std::unique_ptr<MessageLite>> AesCtrHmacStreamingKeyFactory::NewKey(
+    const portable_proto::MessageLite& key_format) const {
+  std::string key_format_url =
+      std::string(AesCtrHmacStreamingKeyManager::kKeyTypePrefix) +
+      key_format.GetTypeName();
+  if (key_format_url != AesCtrHmacStreamingKeyManager::kKeyFormatUrl) {
+    return ToStatusF(util::error::INVALID_ARGUMENT,
+                     "Key format proto '%s' is not supported by this manager.",
+                     key_format_url.c_str());
+  }
+  const AesCtrHmacStreamingKeyFormat& streaming_key_format =
+        reinterpret_cast<const AesCtrHmacStreamingKeyFormat&>(key_format);
+  Status status = AesCtrHmacStreamingKeyManager::Validate(streaming_key_format);
+  if (!status.ok()) return status;
+
+  // Generate AesCtrHmacStreamingKey.
+  std::unique_ptr<AesCtrHmacStreamingKey> streaming_key(
+      new AesCtrHmacStreamingKey());
+  streaming_key->set_version(AesCtrHmacStreamingKeyManager::kVersion);
+  streaming_key->set_key_value(
+      subtle::Random::GetRandomBytes(streaming_key_format.key_size()));
+  *(streaming_key->mutable_params()) = streaming_key_format.params();
+  std::unique_ptr<MessageLite> key = std::move(streaming_key);
+  return std::move(key);
+}
+
+StatusOr<std::unique_ptr<MessageLite>> AesCtrHmacStreamingKeyFactory::NewKey(
+    absl::string_view serialized_key_format) const {
+  AesCtrHmacStreamingKeyFormat key_format;
+  if (!key_format.ParseFromString(std::string(serialized_key_format))) {
+    return ToStatusF(util::error::INVALID_ARGUMENT,
+                     "Could not parse the passed string as proto '%s'.",
+                     AesCtrHmacStreamingKeyManager::kKeyFormatUrl);
+  }
+  return NewKey(key_format);
+}
+
+StatusOr<std::unique_ptr<KeyData>> AesCtrHmacStreamingKeyFactory::NewKeyData(
+    absl::string_view serialized_key_format) const {
+  auto new_key_result = NewKey(serialized_key_format);
+  if (!new_key_result.ok()) return new_key_result.status();
+  auto new_key = reinterpret_cast<const AesCtrHmacStreamingKey&>(
+      *(new_key_result.ValueOrDie()));
+  std::unique_ptr<KeyData> key_data(new KeyData());
+  key_data->set_type_url(AesCtrHmacStreamingKeyManager::kKeyType);
+  key_data->set_value(new_key.SerializeAsString());
+  key_data->set_key_material_type(KeyData::SYMMETRIC);
+  return std::move(key_data);
+}
+
+constexpr char AesCtrHmacStreamingKeyManager::kKeyFormatUrl[];
+constexpr char AesCtrHmacStreamingKeyManager::kKeyTypePrefix[];
+constexpr char AesCtrHmacStreamingKeyManager::kKeyType[];
+constexpr uint32_t AesCtrHmacStreamingKeyManager::kVersion;
+
+// The main key must be at least as long as the derived keys, hence at least
+// 16 bytes.
+const int kMinKeySizeInBytes = 16;
+const uint32_t kMinTagSizeInBytes = 10;
+
+AesCtrHmacStreamingKeyManager::AesCtrHmacStreamingKeyManager()
+    : key_type_(kKeyType), key_factory_(new AesCtrHmacStreamingKeyFactory()) {}
+
+const std::string& AesCtrHmacStreamingKeyManager::get_key_type() const {
+  return key_type_;
+}
+
+uint32_t AesCtrHmacStreamingKeyManager::get_version() const {
+  return kVersion;
+}
+
+const KeyFactory& AesCtrHmacStreamingKeyManager::get_key_factory() const {
+  return *key_factory_;
+}
+
+StatusOr<std::unique_ptr<StreamingAead>>
+AesCtrHmacStreamingKeyManager::GetPrimitive(const KeyData& key_data) const {
+  if (DoesSupport(key_data.type_url())) {
+    AesCtrHmacStreamingKey streaming_key;
+    if (!streaming_key.ParseFromString(key_data.value())) {
+      return ToStatusF(util::error::INVALID_ARGUMENT,
+                       "Could not parse key_data.value as key type '%s'.",
+                       key_data.type_url().c_str());
+    }
+    return GetPrimitiveImpl(streaming_key);
+  } else {
+    return ToStatusF(util::error::INVALID_ARGUMENT,
+                     "Key type '%s' is not supported by this manager.",
+                     key_data.type_url().c_str());
+  }
+}
+
+StatusOr<std::unique_ptr<StreamingAead>>
+AesCtrHmacStreamingKeyManager::GetPrimitive(const MessageLite& key) const {
+  std::string key_type = std::string(kKeyTypePrefix) + key.GetTypeName();
+  if (DoesSupport(key_type)) {
+    const AesCtrHmacStreamingKey& streaming_key =
+        reinterpret_cast<const AesCtrHmacStreamingKey&>(key);
+    return GetPrimitiveImpl(streaming_key);
+  } else {
+    return ToStatusF(util::error::INVALID_ARGUMENT,
+                     "Key type '%s' is not supported by this manager.",
+                     key_type.c_str());
+  }
+}
+
+StatusOr<std::unique_ptr<StreamingAead>>
+AesCtrHmacStreamingKeyManager::GetPrimitiveImpl(
+    const AesCtrHmacStreamingKey& streaming_key) const {
+  Status status = Validate(streaming_key);
+  if (!status.ok()) return status;
+  const AesCtrHmacStreamingParams& params = streaming_key.params();
+  auto streaming_result = subtle::AesCtrHmacStreaming::New(
+      streaming_key.key_value(),
+      util::Enums::ProtoToSubtle(params.hkdf_hash_type()),
+      params.derived_key_size(),
+      util::Enums::ProtoToSubtle(params.hmac_params().hash()),
+      params.hmac_params().tag_size(), params.ciphertext_segment_size());
+  if (!streaming_result.ok()) return streaming_result.status();
+  std::unique_ptr<StreamingAead> streaming_aead(
+      streaming_result.ValueOrDie().release());
+  return std::move(streaming_aead);
+}
+
+// static
+Status AesCtrHmacStreamingKeyManager::Validate(
+    const AesCtrHmacStreamingParams& params) {
+  if (params.hkdf_hash_type() != HashType::SHA1 &&
+      params.hkdf_hash_type() != HashType::SHA256 &&
+      params.hkdf_hash_type() != HashType::SHA512) {
+    return ToStatusF(util::error::INVALID_ARGUMENT,
+                     "Invalid AesCtrHmacStreamingParams: "
+                     "unsupported hash type %d.", params.hkdf_hash_type());
+  }
+  uint32_t derived_key_size = params.derived_key_size();
+  if (derived_key_size != 16 && derived_key_size != 32) {
+    return ToStatusF(util::error::INVALID_ARGUMENT,
+                     "Invalid AesCtrHmacStreamingParams: derived_key_size "
+                     "is %d; supported sizes: 16 or 32 bytes.",
+                     derived_key_size);
+  }
+  const HmacParams& hmac_params = params.hmac_params();
+  uint32_t max_tag_size;
+  switch (hmac_params.hash()) {
+    case HashType::SHA1:
+      max_tag_size = 20;
+      break;
+    case HashType::SHA256:
+      max_tag_size = 32;
+      break;
+    case HashType::SHA512:
+      max_tag_size = 64;
+      break;
+    default:
+      return ToStatusF(util::error::INVALID_ARGUMENT,
+                       "Invalid AesCtrHmacStreamingParams: unsupported "
+                       "HMAC hash type %d.", hmac_params.hash());
+  }
+  if (hmac_params.tag_size() < kMinTagSizeInBytes ||
+      hmac_params.tag_size() > max_tag_size) {
+    return ToStatusF(util::error::INVALID_ARGUMENT,
+                     "Invalid AesCtrHmacStreamingParams: tag_size is %d; "
+                     "it must be between %d and %d bytes.",
+                     hmac_params.tag_size(), kMinTagSizeInBytes,
+                     max_tag_size);
+  }
+  // The first segment holds the header and a tag, and at least one byte of
+  // plaintext.
+  uint32_t min_segment_size =
+      1 + derived_key_size +
+      subtle::AesCtrHmacStreaming::kNoncePrefixSizeInBytes +
+      hmac_params.tag_size() + 1;
+  if (params.ciphertext_segment_size() < min_segment_size) {
+    return ToStatusF(util::error::INVALID_ARGUMENT,
+                     "Invalid AesCtrHmacStreamingParams: "
+                     "ciphertext_segment_size is %d; the minimum is %d bytes.",
+                     params.ciphertext_segment_size(), min_segment_size);
+  }
+  return Status::OK;
+}
+
+// static
+Status AesCtrHmacStreamingKeyManager::Validate(
+    const AesCtrHmacStreamingKey& key) {
+  Status status = ValidateVersion(key.version(), kVersion);
+  if (!status.ok()) return status;
+  uint32_t key_size = key.key_value().size();
+  if (key_size < kMinKeySizeInBytes ||
+      key_size < key.params().derived_key_size()) {
+    return ToStatusF(util::error::INVALID_ARGUMENT,
+                     "Invalid AesCtrHmacStreamingKey: key_value has %d "
+                     "bytes; it must be at least %d bytes and at least "
+                     "derived_key_size.", key_size, kMinKeySizeInBytes);
+  }
+  return Validate(key.params());
+}
+
+// static
+Status AesCtrHmacStreamingKeyManager::Validate(
+    const AesCtrHmacStreamingKeyFormat& key_format) {
+  if (key_format.key_size() < kMinKeySizeInBytes ||
+      key_format.key_size() < key_format.params().derived_key_size()) {
+    return ToStatusF(util::error::INVALID_ARGUMENT,
+                     "Invalid AesCtrHmacStreamingKeyFormat: key_size is %d; "
+                     "it must be at least %d bytes and at least "
+                     "derived_key_size.",
+                     key_format.key_size(), kMinKeySizeInBytes);
+  }
+  return Validate(key_format.params());
+}
+
+}  // namespace tink
+}  // namespace crypto
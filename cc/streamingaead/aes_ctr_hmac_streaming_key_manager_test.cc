@@ -0,0 +1,325 @@
+// Copyright 2018 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/streamingaead/aes_ctr_hmac_streaming_key_manager.h"
+
+#include "tink/streaming_aead.h"
+#include "tink/util/buffer_random_access_stream.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "gtest/gtest.h"
+#include "proto/aes_eax.pb.h"
+#include "proto/aes_ctr_hmac_streaming.pb.h"
+#include "proto/common.pb.h"
+#include "proto/tink.pb.h"
+
+namespace crypto {
+namespace tink {
+
+using crypto::tink::util::BufferRandomAccessSink;
+using crypto::tink::util::BufferRandomAccessStream;
+using google::crypto::tink::AesEaxKey;
+using google::crypto::tink::AesEaxKeyFormat;
+using google::crypto::tink::AesCtrHmacStreamingKey;
+using google::crypto::tink::AesCtrHmacStreamingKeyFormat;
+using google::crypto::tink::HashType;
+using google::crypto::tink::KeyData;
+
+namespace {
+
+class AesCtrHmacStreamingKeyManagerTest : public ::testing::Test {
+ protected:
+  std::string streaming_key_type =
+      "type.googleapis.com/google.crypto.tink.AesCtrHmacStreamingKey";
+
+  AesCtrHmacStreamingKey ValidKey() {
+    AesCtrHmacStreamingKey key;
+    key.set_version(0);
+    key.set_key_value(std::string(32, 'k'));
+    key.mutable_params()->set_hkdf_hash_type(HashType::SHA256);
+    key.mutable_params()->set_derived_key_size(16);
+    key.mutable_params()->set_ciphertext_segment_size(4096);
+    key.mutable_params()->mutable_hmac_params()->set_hash(HashType::SHA256);
+    key.mutable_params()->mutable_hmac_params()->set_tag_size(16);
+    return key;
+  }
+};
+
+TEST_F(AesCtrHmacStreamingKeyManagerTest, testBasic) {
+  AesCtrHmacStreamingKeyManager key_manager;
+
+  EXPECT_EQ(0, key_manager.get_version());
+  EXPECT_EQ("type.googleapis.com/google.crypto.tink.AesCtrHmacStreamingKey",
+            key_manager.get_key_type());
+  EXPECT_TRUE(key_manager.DoesSupport(key_manager.get_key_type()));
+}
+
+TEST_F(AesCtrHmacStreamingKeyManagerTest, testKeyDataErrors) {
+  AesCtrHmacStreamingKeyManager key_manager;
+
+  {  // Bad key type.
+    KeyData key_data;
+    std::string bad_key_type =
+        "type.googleapis.com/google.crypto.tink.SomeOtherKey";
+    key_data.set_type_url(bad_key_type);
+    auto result = key_manager.GetPrimitive(key_data);
+    EXPECT_FALSE(result.ok());
+    EXPECT_EQ(util::error::INVALID_ARGUMENT, result.status().error_code());
+    EXPECT_PRED_FORMAT2(testing::IsSubstring, "not supported",
+                        result.status().error_message());
+    EXPECT_PRED_FORMAT2(testing::IsSubstring, bad_key_type,
+                        result.status().error_message());
+  }
+
+  {  // Bad key value.
+    KeyData key_data;
+    key_data.set_type_url(streaming_key_type);
+    key_data.set_value("some bad serialized proto");
+    auto result = key_manager.GetPrimitive(key_data);
+    EXPECT_FALSE(result.ok());
+    EXPECT_EQ(util::error::INVALID_ARGUMENT, result.status().error_code());
+    EXPECT_PRED_FORMAT2(testing::IsSubstring, "not parse",
+                        result.status().error_message());
+  }
+
+  {  // Bad version.
+    KeyData key_data;
+    AesCtrHmacStreamingKey key = ValidKey();
+    key.set_version(1);
+    key_data.set_type_url(streaming_key_type);
+    key_data.set_value(key.SerializeAsString());
+    auto result = key_manager.GetPrimitive(key_data);
+    EXPECT_FALSE(result.ok());
+    EXPECT_EQ(util::error::INVALID_ARGUMENT, result.status().error_code());
+    EXPECT_PRED_FORMAT2(testing::IsSubstring, "version",
+                        result.status().error_message());
+  }
+
+  {  // Bad key_value size (minimum: 16 and derived_key_size).
+    for (int derived_key_size : {16, 32}) {
+      for (int len = 0; len < 40; len++) {
+        AesCtrHmacStreamingKey key = ValidKey();
+        key.set_key_value(std::string(len, 'a'));
+        key.mutable_params()->set_derived_key_size(derived_key_size);
+        KeyData key_data;
+        key_data.set_type_url(streaming_key_type);
+        key_data.set_value(key.SerializeAsString());
+        auto result = key_manager.GetPrimitive(key_data);
+        if (len >= derived_key_size) {
+          EXPECT_TRUE(result.ok()) << result.status();
+        } else {
+          EXPECT_FALSE(result.ok());
+          EXPECT_EQ(util::error::INVALID_ARGUMENT,
+                    result.status().error_code());
+          EXPECT_PRED_FORMAT2(testing::IsSubstring,
+                              std::to_string(len) + " bytes",
+                              result.status().error_message());
+        }
+      }
+    }
+  }
+}
+
+TEST_F(AesCtrHmacStreamingKeyManagerTest, testKeyMessageErrors) {
+  AesCtrHmacStreamingKeyManager key_manager;
+
+  {  // Bad protobuffer.
+    AesEaxKey key;
+    auto result = key_manager.GetPrimitive(key);
+    EXPECT_FALSE(result.ok());
+    EXPECT_EQ(util::error::INVALID_ARGUMENT, result.status().error_code());
+    EXPECT_PRED_FORMAT2(testing::IsSubstring, "AesEaxKey",
+                        result.status().error_message());
+    EXPECT_PRED_FORMAT2(testing::IsSubstring, "not supported",
+                        result.status().error_message());
+  }
+
+  {  // Bad hash type.
+    AesCtrHmacStreamingKey key = ValidKey();
+    key.mutable_params()->set_hkdf_hash_type(HashType::UNKNOWN_HASH);
+    auto result = key_manager.GetPrimitive(key);
+    EXPECT_FALSE(result.ok());
+    EXPECT_EQ(util::error::INVALID_ARGUMENT, result.status().error_code());
+    EXPECT_PRED_FORMAT2(testing::IsSubstring, "hash type",
+                        result.status().error_message());
+  }
+
+  {  // Bad derived_key_size (supported sizes: 16, 32).
+    for (int len = 0; len < 40; len++) {
+      AesCtrHmacStreamingKey key = ValidKey();
+      key.mutable_params()->set_derived_key_size(len);
+      auto result = key_manager.GetPrimitive(key);
+      if (len == 16 || len == 32) {
+        EXPECT_TRUE(result.ok()) << result.status();
+      } else {
+        EXPECT_FALSE(result.ok());
+        EXPECT_EQ(util::error::INVALID_ARGUMENT,
+                  result.status().error_code());
+        EXPECT_PRED_FORMAT2(testing::IsSubstring, "derived_key_size",
+                            result.status().error_message());
+      }
+    }
+  }
+
+  {  // Bad HMAC hash type.
+    AesCtrHmacStreamingKey key = ValidKey();
+    key.mutable_params()->mutable_hmac_params()->set_hash(
+        HashType::UNKNOWN_HASH);
+    auto result = key_manager.GetPrimitive(key);
+    EXPECT_FALSE(result.ok());
+    EXPECT_EQ(util::error::INVALID_ARGUMENT, result.status().error_code());
+    EXPECT_PRED_FORMAT2(testing::IsSubstring, "HMAC hash type",
+                        result.status().error_message());
+  }
+
+  {  // Bad tag_size (SHA1: 10 to 20 bytes).
+    for (int tag_size = 0; tag_size < 40; tag_size++) {
+      AesCtrHmacStreamingKey key = ValidKey();
+      key.mutable_params()->mutable_hmac_params()->set_hash(HashType::SHA1);
+      key.mutable_params()->mutable_hmac_params()->set_tag_size(tag_size);
+      auto result = key_manager.GetPrimitive(key);
+      if (tag_size >= 10 && tag_size <= 20) {
+        EXPECT_TRUE(result.ok()) << result.status();
+      } else {
+        EXPECT_FALSE(result.ok());
+        EXPECT_EQ(util::error::INVALID_ARGUMENT,
+                  result.status().error_code());
+        EXPECT_PRED_FORMAT2(testing::IsSubstring, "tag_size",
+                            result.status().error_message());
+      }
+    }
+  }
+
+  {  // Bad ciphertext_segment_size (minimum: 1 + 16 + 7 + 16 + 1 = 41).
+    for (int size : {0, 40, 41}) {
+      AesCtrHmacStreamingKey key = ValidKey();
+      key.mutable_params()->set_ciphertext_segment_size(size);
+      auto result = key_manager.GetPrimitive(key);
+      if (size == 41) {
+        EXPECT_TRUE(result.ok()) << result.status();
+      } else {
+        EXPECT_FALSE(result.ok());
+        EXPECT_PRED_FORMAT2(testing::IsSubstring, "ciphertext_segment_size",
+                            result.status().error_message());
+      }
+    }
+  }
+}
+
+TEST_F(AesCtrHmacStreamingKeyManagerTest, testPrimitives) {
+  std::string plaintext(10000, 'p');
+  std::string aad = "some aad";
+  AesCtrHmacStreamingKeyManager key_manager;
+  AesCtrHmacStreamingKey key = ValidKey();
+
+  auto result = key_manager.GetPrimitive(key);
+  EXPECT_TRUE(result.ok()) << result.status();
+  auto streaming_aead = std::move(result.ValueOrDie());
+
+  KeyData key_data;
+  key_data.set_type_url(streaming_key_type);
+  key_data.set_value(key.SerializeAsString());
+  auto other_result = key_manager.GetPrimitive(key_data);
+  EXPECT_TRUE(other_result.ok()) << other_result.status();
+  auto other_streaming_aead = std::move(other_result.ValueOrDie());
+
+  std::string ciphertext(streaming_aead->CiphertextSize(plaintext.size()),
+                         'c');
+  BufferRandomAccessStream plaintext_source(plaintext);
+  BufferRandomAccessSink ciphertext_sink(&ciphertext[0], ciphertext.size());
+  auto status =
+      streaming_aead->Encrypt(&plaintext_source, aad, &ciphertext_sink);
+  EXPECT_TRUE(status.ok()) << status;
+
+  BufferRandomAccessStream ciphertext_source(ciphertext);
+  auto decrypt_result =
+      other_streaming_aead->DecryptRange(&ciphertext_source, aad, 0,
+                                         plaintext.size());
+  EXPECT_TRUE(decrypt_result.ok()) << decrypt_result.status();
+  EXPECT_EQ(plaintext, decrypt_result.ValueOrDie());
+}
+
+TEST_F(AesCtrHmacStreamingKeyManagerTest, testNewKeyErrors) {
+  AesCtrHmacStreamingKeyManager key_manager;
+  const KeyFactory& key_factory = key_manager.get_key_factory();
+
+  {  // Bad key format.
+    AesEaxKeyFormat key_format;
+    auto result = key_factory.NewKey(key_format);
+    EXPECT_FALSE(result.ok());
+    EXPECT_EQ(util::error::INVALID_ARGUMENT, result.status().error_code());
+    EXPECT_PRED_FORMAT2(testing::IsSubstring, "AesEaxKeyFormat",
+                        result.status().error_message());
+    EXPECT_PRED_FORMAT2(testing::IsSubstring, "not supported",
+                        result.status().error_message());
+  }
+
+  {  // Bad serialized key format.
+    auto result = key_factory.NewKey("some bad serialized proto");
+    EXPECT_FALSE(result.ok());
+    EXPECT_EQ(util::error::INVALID_ARGUMENT, result.status().error_code());
+    EXPECT_PRED_FORMAT2(testing::IsSubstring, "not parse",
+                        result.status().error_message());
+  }
+
+  {  // key_size smaller than derived_key_size.
+    AesCtrHmacStreamingKeyFormat key_format;
+    *(key_format.mutable_params()) = ValidKey().params();
+    key_format.mutable_params()->set_derived_key_size(32);
+    key_format.set_key_size(16);
+    auto result = key_factory.NewKey(key_format);
+    EXPECT_FALSE(result.ok());
+    EXPECT_EQ(util::error::INVALID_ARGUMENT, result.status().error_code());
+    EXPECT_PRED_FORMAT2(testing::IsSubstring, "key_size",
+                        result.status().error_message());
+  }
+}
+
+TEST_F(AesCtrHmacStreamingKeyManagerTest, testNewKeyBasic) {
+  AesCtrHmacStreamingKeyManager key_manager;
+  const KeyFactory& key_factory = key_manager.get_key_factory();
+  AesCtrHmacStreamingKeyFormat key_format;
+  *(key_format.mutable_params()) = ValidKey().params();
+  key_format.set_key_size(32);
+
+  auto result = key_factory.NewKey(key_format);
+  EXPECT_TRUE(result.ok()) << result.status();
+  auto key = std::move(result.ValueOrDie());
+  EXPECT_EQ("type.googleapis.com/google.crypto.tink.AesCtrHmacStreamingKey",
+            "type.googleapis.com/" + key->GetTypeName());
+  std::unique_ptr<AesCtrHmacStreamingKey> streaming_key(
+      reinterpret_cast<AesCtrHmacStreamingKey*>(key.release()));
+  EXPECT_EQ(0, streaming_key->version());
+  EXPECT_EQ(32, streaming_key->key_value().size());
+  EXPECT_EQ(4096, streaming_key->params().ciphertext_segment_size());
+
+  auto key_data_result =
+      key_factory.NewKeyData(key_format.SerializeAsString());
+  EXPECT_TRUE(key_data_result.ok()) << key_data_result.status();
+  auto key_data = std::move(key_data_result.ValueOrDie());
+  EXPECT_EQ(streaming_key_type, key_data->type_url());
+  EXPECT_EQ(KeyData::SYMMETRIC, key_data->key_material_type());
+  EXPECT_TRUE(key_manager.GetPrimitive(*key_data).ok());
+}
+
+}  // namespace
+}  // namespace tink
+}  // namespace crypto
+
+int main(int ac, char* av[]) {
+  testing::InitGoogleTest(&ac, av);
+  return RUN_ALL_TESTS();
+}
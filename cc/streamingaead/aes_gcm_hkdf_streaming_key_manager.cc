@@ -0,0 +1,253 @@
+// Copyright 2018 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/streamingaead/aes_gcm_hkdf_streaming_key_manager.h"
+
+#include "absl/strings/string_view.h"
+#include "tink/key_manager.h"
+#include "tink/streaming_aead.h"
+#include "tink/subtle/aes_gcm_hkdf_streaming.h"
+#include "tink/subtle/random.h"
+#include "tink/util/enums.h"
+#include "tink/util/errors.h"
+#include "tink/util/protobuf_helper.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "tink/util/validation.h"
+#include "proto/aes_gcm_hkdf_streaming.pb.h"
+#include "proto/common.pb.h"
+#include "proto/tink.pb.h"
+
+namespace crypto {
+namespace tink {
+
+using google::crypto::tink::AesGcmHkdfStreamingKey;
+using google::crypto::tink::AesGcmHkdfStreamingKeyFormat;
+using google::crypto::tink::AesGcmHkdfStreamingParams;
+using google::crypto::tink::HashType;
+using google::crypto::tink::KeyData;
+using google::crypto::tink::KeyTemplate;
+using portable_proto::MessageLite;
+using crypto::tink::util::Status;
+using crypto::tink::util::StatusOr;
+
+class AesGcmHkdfStreamingKeyFactory : public KeyFactory {
+ public:
+  AesGcmHkdfStreamingKeyFactory() {}
+
+  // Generates a new random AesGcmHkdfStreamingKey, based on the specified
+  // 'key_format', which must contain AesGcmHkdfStreamingKeyFormat-proto.
+  crypto::tink::util::StatusOr<std::unique_ptr<portable_proto::MessageLite>>
+  NewKey(const portable_proto::MessageLite& key_format) const override;
+
+  // Generates a new random AesGcmHkdfStreamingKey, based on the specified
+  // 'serialized_key_format', which must contain
+  // AesGcmHkdfStreamingKeyFormat-proto.
+  crypto::tink::util::StatusOr<std::unique_ptr<portable_proto::MessageLite>>
+  NewKey(absl::string_view serialized_key_format) const override;
+
+  // Generates a new random AesGcmHkdfStreamingKey, based on the specified
+  // 'serialized_key_format' (which must contain
+  // AesGcmHkdfStreamingKeyFormat-proto), and wraps it in a KeyData-proto.
+  crypto::tink::util::StatusOr<std::unique_ptr<google::crypto::tink::KeyData>>
+  NewKeyData(absl::string_view serialized_key_format) const override;
+};
+
+StatusOr<std::unique_ptr<MessageLite>> AesGcmHkdfStreamingKeyFactory::NewKey(
+    const portable_proto::MessageLite& key_format) const {
+  std::string key_format_url =
+      std::string(AesGcmHkdfStreamingKeyManager::kKeyTypePrefix) +
+      key_format.GetTypeName();
+  if (key_format_url != AesGcmHkdfStreamingKeyManager::kKeyFormatUrl) {
+    return ToStatusF(util::error::INVALID_ARGUMENT,
+                     "Key format proto '%s' is not supported by this manager.",
+                     key_format_url.c_str());
+  }
+  const AesGcmHkdfStreamingKeyFormat& streaming_key_format =
+        reinterpret_cast<const AesGcmHkdfStreamingKeyFormat&>(key_format);
+  Status status = AesGcmHkdfStreamingKeyManager::Validate(streaming_key_format);
+  if (!status.ok()) return status;
+
+  // Generate AesGcmHkdfStreamingKey.
+  std::unique_ptr<AesGcmHkdfStreamingKey> streaming_key(
+      new AesGcmHkdfStreamingKey());
+  streaming_key->set_version(AesGcmHkdfStreamingKeyManager::kVersion);
+  streaming_key->set_key_value(
+      subtle::Random::GetRandomBytes(streaming_key_format.key_size()));
+  *(streaming_key->mutable_params()) = streaming_key_format.params();
+  std::unique_ptr<MessageLite> key = std::move(streaming_key);
+  return std::move(key);
+}
+
+StatusOr<std::unique_ptr<MessageLite>> AesGcmHkdfStreamingKeyFactory::NewKey(
+    absl::string_view serialized_key_format) const {
+  AesGcmHkdfStreamingKeyFormat key_format;
+  if (!key_format.ParseFromString(std::string(serialized_key_format))) {
+    return ToStatusF(util::error::INVALID_ARGUMENT,
+                     "Could not parse the passed string as proto '%s'.",
+                     AesGcmHkdfStreamingKeyManager::kKeyFormatUrl);
+  }
+  return NewKey(key_format);
+}
+
+StatusOr<std::unique_ptr<KeyData>> AesGcmHkdfStreamingKeyFactory::NewKeyData(
+    absl::string_view serialized_key_format) const {
+  auto new_key_result = NewKey(serialized_key_format);
+  if (!new_key_result.ok()) return new_key_result.status();
+  auto new_key = reinterpret_cast<const AesGcmHkdfStreamingKey&>(
+      *(new_key_result.ValueOrDie()));
+  std::unique_ptr<KeyData> key_data(new KeyData());
+  key_data->set_type_url(AesGcmHkdfStreamingKeyManager::kKeyType);
+  key_data->set_value(new_key.SerializeAsString());
+  key_data->set_key_material_type(KeyData::SYMMETRIC);
+  return std::move(key_data);
+}
+
+constexpr char AesGcmHkdfStreamingKeyManager::kKeyFormatUrl[];
+constexpr char AesGcmHkdfStreamingKeyManager::kKeyTypePrefix[];
+constexpr char AesGcmHkdfStreamingKeyManager::kKeyType[];
+constexpr uint32_t AesGcmHkdfStreamingKeyManager::kVersion;
+
+// The main key must be at least as long as the derived keys, hence at least
+// 16 bytes.
+const int kMinKeySizeInBytes = 16;
+
+AesGcmHkdfStreamingKeyManager::AesGcmHkdfStreamingKeyManager()
+    : key_type_(kKeyType), key_factory_(new AesGcmHkdfStreamingKeyFactory()) {}
+
+const std::string& AesGcmHkdfStreamingKeyManager::get_key_type() const {
+  return key_type_;
+}
+
+uint32_t AesGcmHkdfStreamingKeyManager::get_version() const {
+  return kVersion;
+}
+
+const KeyFactory& AesGcmHkdfStreamingKeyManager::get_key_factory() const {
+  return *key_factory_;
+}
+
+StatusOr<std::unique_ptr<StreamingAead>>
+AesGcmHkdfStreamingKeyManager::GetPrimitive(const KeyData& key_data) const {
+  if (DoesSupport(key_data.type_url())) {
+    AesGcmHkdfStreamingKey streaming_key;
+    if (!streaming_key.ParseFromString(key_data.value())) {
+      return ToStatusF(util::error::INVALID_ARGUMENT,
+                       "Could not parse key_data.value as key type '%s'.",
+                       key_data.type_url().c_str());
+    }
+    return GetPrimitiveImpl(streaming_key);
+  } else {
+    return ToStatusF(util::error::INVALID_ARGUMENT,
+                     "Key type '%s' is not supported by this manager.",
+                     key_data.type_url().c_str());
+  }
+}
+
+StatusOr<std::unique_ptr<StreamingAead>>
+AesGcmHkdfStreamingKeyManager::GetPrimitive(const MessageLite& key) const {
+  std::string key_type = std::string(kKeyTypePrefix) + key.GetTypeName();
+  if (DoesSupport(key_type)) {
+    const AesGcmHkdfStreamingKey& streaming_key =
+        reinterpret_cast<const AesGcmHkdfStreamingKey&>(key);
+    return GetPrimitiveImpl(streaming_key);
+  } else {
+    return ToStatusF(util::error::INVALID_ARGUMENT,
+                     "Key type '%s' is not supported by this manager.",
+                     key_type.c_str());
+  }
+}
+
+StatusOr<std::unique_ptr<StreamingAead>>
+AesGcmHkdfStreamingKeyManager::GetPrimitiveImpl(
+    const AesGcmHkdfStreamingKey& streaming_key) const {
+  Status status = Validate(streaming_key);
+  if (!status.ok()) return status;
+  const AesGcmHkdfStreamingParams& params = streaming_key.params();
+  auto streaming_result = subtle::AesGcmHkdfStreaming::New(
+      streaming_key.key_value(),
+      util::Enums::ProtoToSubtle(params.hkdf_hash_type()),
+      params.derived_key_size(), params.ciphertext_segment_size());
+  if (!streaming_result.ok()) return streaming_result.status();
+  std::unique_ptr<StreamingAead> streaming_aead(
+      streaming_result.ValueOrDie().release());
+  return std::move(streaming_aead);
+}
+
+// static
+Status AesGcmHkdfStreamingKeyManager::Validate(
+    const AesGcmHkdfStreamingParams& params) {
+  if (params.hkdf_hash_type() != HashType::SHA1 &&
+      params.hkdf_hash_type() != HashType::SHA256 &&
+      params.hkdf_hash_type() != HashType::SHA512) {
+    return ToStatusF(util::error::INVALID_ARGUMENT,
+                     "Invalid AesGcmHkdfStreamingParams: "
+                     "unsupported hash type %d.", params.hkdf_hash_type());
+  }
+  uint32_t derived_key_size = params.derived_key_size();
+  if (derived_key_size != 16 && derived_key_size != 32) {
+    return ToStatusF(util::error::INVALID_ARGUMENT,
+                     "Invalid AesGcmHkdfStreamingParams: derived_key_size "
+                     "is %d; supported sizes: 16 or 32 bytes.",
+                     derived_key_size);
+  }
+  // The first segment holds the header and a tag, and at least one byte of
+  // plaintext.
+  uint32_t min_segment_size =
+      1 + derived_key_size +
+      subtle::AesGcmHkdfStreaming::kNoncePrefixSizeInBytes +
+      subtle::AesGcmHkdfStreaming::kTagSizeInBytes + 1;
+  if (params.ciphertext_segment_size() < min_segment_size) {
+    return ToStatusF(util::error::INVALID_ARGUMENT,
+                     "Invalid AesGcmHkdfStreamingParams: "
+                     "ciphertext_segment_size is %d; the minimum is %d bytes.",
+                     params.ciphertext_segment_size(), min_segment_size);
+  }
+  return Status::OK;
+}
+
+// static
+Status AesGcmHkdfStreamingKeyManager::Validate(
+    const AesGcmHkdfStreamingKey& key) {
+  Status status = ValidateVersion(key.version(), kVersion);
+  if (!status.ok()) return status;
+  uint32_t key_size = key.key_value().size();
+  if (key_size < kMinKeySizeInBytes ||
+      key_size < key.params().derived_key_size()) {
+    return ToStatusF(util::error::INVALID_ARGUMENT,
+                     "Invalid AesGcmHkdfStreamingKey: key_value has %d "
+                     "bytes; it must be at least %d bytes and at least "
+                     "derived_key_size.", key_size, kMinKeySizeInBytes);
+  }
+  return Validate(key.params());
+}
+
+// static
+Status AesGcmHkdfStreamingKeyManager::Validate(
+    const AesGcmHkdfStreamingKeyFormat& key_format) {
+  if (key_format.key_size() < kMinKeySizeInBytes ||
+      key_format.key_size() < key_format.params().derived_key_size()) {
+    return ToStatusF(util::error::INVALID_ARGUMENT,
+                     "Invalid AesGcmHkdfStreamingKeyFormat: key_size is %d; "
+                     "it must be at least %d bytes and at least "
+                     "derived_key_size.",
+                     key_format.key_size(), kMinKeySizeInBytes);
+  }
+  return Validate(key_format.params());
+}
+
+}  // namespace tink
+}  // namespace crypto
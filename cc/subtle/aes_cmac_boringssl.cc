@@ -0,0 +1,136 @@
+// Copyright 2017 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/subtle/aes_cmac_boringssl.h"
+
+#include <string.h>
+
+#include <string>
+
+#include "absl/strings/string_view.h"
+#include "openssl/aes.h"
+#include "openssl/mem.h"
+#include "tink/mac.h"
+#include "tink/util/errors.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+
+namespace {
+
+// Multiplies 'in' by x in GF(2^128), as in RFC 4493, section 2.3.
+void Double(const uint8_t in[16], uint8_t out[16]) {
+  uint8_t carry = in[0] >> 7;
+  for (int i = 0; i < 15; i++) {
+    out[i] = (in[i] << 1) | (in[i + 1] >> 7);
+  }
+  out[15] = (in[15] << 1) ^ (carry * 0x87);
+}
+
+void XorBlock(const uint8_t* in, uint8_t* state) {
+  for (int i = 0; i < 16; i++) state[i] ^= in[i];
+}
+
+}  // anonymous namespace
+
+// static
+util::StatusOr<std::unique_ptr<Mac>> AesCmacBoringSsl::New(
+    absl::string_view key_value, uint32_t tag_size) {
+  if (key_value.size() != 16 && key_value.size() != 32) {
+    return ToStatusF(util::error::INVALID_ARGUMENT,
+                     "Invalid key size: %d bytes, expected 16 or 32.",
+                     static_cast<int>(key_value.size()));
+  }
+  if (tag_size < MIN_TAG_SIZE || tag_size > BLOCK_SIZE) {
+    return ToStatusF(util::error::INVALID_ARGUMENT,
+                     "Invalid tag size: %d bytes.", tag_size);
+  }
+  std::unique_ptr<AesCmacBoringSsl> cmac(new AesCmacBoringSsl(tag_size));
+  if (AES_set_encrypt_key(reinterpret_cast<const uint8_t*>(key_value.data()),
+                          8 * key_value.size(), &cmac->key_) != 0) {
+    return util::Status(util::error::INTERNAL, "could not set the AES key");
+  }
+  uint8_t l[BLOCK_SIZE] = {0};
+  AES_encrypt(l, l, &cmac->key_);
+  Double(l, cmac->k1_);
+  Double(cmac->k1_, cmac->k2_);
+  OPENSSL_cleanse(l, sizeof(l));
+  std::unique_ptr<Mac> mac = std::move(cmac);
+  return std::move(mac);
+}
+
+AesCmacBoringSsl::~AesCmacBoringSsl() {
+  OPENSSL_cleanse(&key_, sizeof(key_));
+  OPENSSL_cleanse(k1_, sizeof(k1_));
+  OPENSSL_cleanse(k2_, sizeof(k2_));
+}
+
+void AesCmacBoringSsl::Cmac(absl::string_view data,
+                            uint8_t tag[BLOCK_SIZE]) const {
+  const uint8_t* in = reinterpret_cast<const uint8_t*>(data.data());
+  size_t len = data.size();
+  memset(tag, 0, BLOCK_SIZE);
+  // All blocks but the last one are chained as in CBC-MAC.
+  while (len > BLOCK_SIZE) {
+    XorBlock(in, tag);
+    AES_encrypt(tag, tag, &key_);
+    in += BLOCK_SIZE;
+    len -= BLOCK_SIZE;
+  }
+  // The last block is masked with k1 if it is complete, and padded and
+  // masked with k2 otherwise.
+  uint8_t last[BLOCK_SIZE];
+  if (len == BLOCK_SIZE) {
+    memcpy(last, k1_, BLOCK_SIZE);
+    XorBlock(in, last);
+  } else {
+    memcpy(last, k2_, BLOCK_SIZE);
+    for (size_t i = 0; i < len; i++) last[i] ^= in[i];
+    last[len] ^= 0x80;
+  }
+  XorBlock(last, tag);
+  AES_encrypt(tag, tag, &key_);
+}
+
+util::StatusOr<std::string> AesCmacBoringSsl::ComputeMac(
+    absl::string_view data) const {
+  uint8_t tag[BLOCK_SIZE];
+  Cmac(data, tag);
+  return std::string(reinterpret_cast<char*>(tag), tag_size_);
+}
+
+util::Status AesCmacBoringSsl::VerifyMac(
+    absl::string_view mac,
+    absl::string_view data) const {
+  if (mac.size() != tag_size_) {
+    return ToStatusF(util::error::INVALID_ARGUMENT,
+                     "incorrect tag size: expected %d, found %d", tag_size_,
+                     static_cast<int>(mac.size()));
+  }
+  uint8_t tag[BLOCK_SIZE];
+  Cmac(data, tag);
+  if (CRYPTO_memcmp(tag, mac.data(), tag_size_) != 0) {
+    return util::Status(util::error::INVALID_ARGUMENT, "verification failed");
+  }
+  return util::Status::OK;
+}
+
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
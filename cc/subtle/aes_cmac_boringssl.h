@@ -0,0 +1,79 @@
+// Copyright 2017 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_SUBTLE_AES_CMAC_BORINGSSL_H_
+#define TINK_SUBTLE_AES_CMAC_BORINGSSL_H_
+
+#include <memory>
+
+#include "absl/strings/string_view.h"
+#include "openssl/aes.h"
+#include "tink/mac.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+
+// AES-CMAC as defined in https://tools.ietf.org/html/rfc4493 (and, for
+// 256-bit keys, NIST SP 800-38B), with tags truncated to tag_size bytes.
+//
+// CMAC needs one AES block operation per 16 bytes of data, compared to the
+// four SHA-256 compressions of an HMAC-SHA256 over a short message, so it
+// is faster for short messages on CPUs with AES hardware support.
+//
+// The AES key schedule and the CMAC subkeys are computed once by New(),
+// and the instance is immutable, so calls can be made concurrently.
+class AesCmacBoringSsl : public Mac {
+ public:
+  // The key must be 128 or 256 bits, and 'tag_size' between 10 and 16.
+  static crypto::tink::util::StatusOr<std::unique_ptr<Mac>> New(
+      absl::string_view key_value, uint32_t tag_size);
+
+  // Computes and returns the CMAC for 'data'.
+  crypto::tink::util::StatusOr<std::string> ComputeMac(
+      absl::string_view data) const override;
+
+  // Verifies if 'mac' is a correct CMAC for 'data'.
+  // Returns Status::OK if 'mac' is correct, and a non-OK-Status otherwise.
+  crypto::tink::util::Status VerifyMac(
+      absl::string_view mac,
+      absl::string_view data) const override;
+
+  ~AesCmacBoringSsl() override;
+
+ private:
+  // The following constants are in bytes.
+  static const int BLOCK_SIZE = 16;
+  static const int MIN_TAG_SIZE = 10;
+
+  explicit AesCmacBoringSsl(uint32_t tag_size) : tag_size_(tag_size) {}
+
+  // Writes the full 16-byte CMAC of 'data' to 'tag'.
+  void Cmac(absl::string_view data, uint8_t tag[BLOCK_SIZE]) const;
+
+  AES_KEY key_;
+  uint8_t k1_[BLOCK_SIZE];
+  uint8_t k2_[BLOCK_SIZE];
+  const uint32_t tag_size_;
+};
+
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_SUBTLE_AES_CMAC_BORINGSSL_H_
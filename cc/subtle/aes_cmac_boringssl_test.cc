@@ -0,0 +1,129 @@
+// Copyright 2017 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/subtle/aes_cmac_boringssl.h"
+
+#include <string>
+#include <vector>
+
+#include "tink/mac.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "tink/util/test_util.h"
+#include "gtest/gtest.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+namespace {
+
+const char kMessageHex[] =
+    "6bc1bee22e409f96e93d7e117393172a"
+    "ae2d8a571e03ac9c9eb76fac45af8e51"
+    "30c81c46a35ce411e5fbc1191a0a52ef"
+    "f69f2445df4f9b17ad2b417be66c3710";
+
+struct TestVector {
+  std::string key_hex;
+  size_t message_size;
+  std::string tag_hex;
+};
+
+TEST(AesCmacBoringSslTest, testVectors) {
+  // Test vectors from https://tools.ietf.org/html/rfc4493#section-4 and
+  // NIST SP 800-38B, appendix D.
+  const std::string key128 = "2b7e151628aed2a6abf7158809cf4f3c";
+  const std::string key256 =
+      "603deb1015ca71be2b73aef0857d7781"
+      "1f352c073b6108d72d9810a30914dff4";
+  const std::vector<TestVector> test_vectors = {
+      {key128, 0, "bb1d6929e95937287fa37d129b756746"},
+      {key128, 16, "070a16b46b4d4144f79bdd9dd04a287c"},
+      {key128, 40, "dfa66747de9ae63030ca32611497c827"},
+      {key128, 64, "51f0bebf7e3b9d92fc49741779363cfe"},
+      {key256, 0, "028962f61b7bf89efc6b551f4667d983"},
+      {key256, 16, "28a7023f452e8f82bd4bf28d8c37c35c"},
+      {key256, 40, "aaf3d8f1de5640c232f5b169b9c911e6"},
+      {key256, 64, "e1992190549f6ed5696a2c056c315410"},
+  };
+  const std::string message = test::HexDecodeOrDie(kMessageHex);
+  for (const TestVector& v : test_vectors) {
+    auto cmac_result = AesCmacBoringSsl::New(test::HexDecodeOrDie(v.key_hex),
+                                             /* tag_size= */ 16);
+    ASSERT_TRUE(cmac_result.ok()) << cmac_result.status();
+    auto cmac = std::move(cmac_result.ValueOrDie());
+    std::string data = message.substr(0, v.message_size);
+    auto tag_result = cmac->ComputeMac(data);
+    ASSERT_TRUE(tag_result.ok()) << tag_result.status();
+    EXPECT_EQ(v.tag_hex, test::HexEncode(tag_result.ValueOrDie()));
+    EXPECT_TRUE(cmac->VerifyMac(test::HexDecodeOrDie(v.tag_hex), data).ok());
+
+    // Truncated tags are prefixes of the full tag.
+    auto truncated_result =
+        AesCmacBoringSsl::New(test::HexDecodeOrDie(v.key_hex), 10);
+    ASSERT_TRUE(truncated_result.ok()) << truncated_result.status();
+    EXPECT_EQ(v.tag_hex.substr(0, 20),
+              test::HexEncode(
+                  truncated_result.ValueOrDie()->ComputeMac(data)
+                      .ValueOrDie()));
+  }
+}
+
+TEST(AesCmacBoringSslTest, testModification) {
+  auto cmac = std::move(
+      AesCmacBoringSsl::New(std::string(32, 'k'), 16).ValueOrDie());
+  for (size_t size : {0, 1, 15, 16, 17, 32, 100}) {
+    std::string data(size, 'd');
+    std::string tag = cmac->ComputeMac(data).ValueOrDie();
+    EXPECT_TRUE(cmac->VerifyMac(tag, data).ok());
+    for (size_t i = 0; i < tag.size() * 8; i++) {
+      std::string modified_tag = tag;
+      modified_tag[i / 8] ^= 1 << (i % 8);
+      EXPECT_FALSE(cmac->VerifyMac(modified_tag, data).ok()) << size << i;
+    }
+    for (size_t i = 0; i < data.size() * 8; i++) {
+      std::string modified_data = data;
+      modified_data[i / 8] ^= 1 << (i % 8);
+      EXPECT_FALSE(cmac->VerifyMac(tag, modified_data).ok()) << size << i;
+    }
+    for (size_t i = 0; i < tag.size(); i++) {
+      EXPECT_FALSE(cmac->VerifyMac(tag.substr(0, i), data).ok());
+    }
+    // Appending the 10* padding must change the tag.
+    EXPECT_FALSE(cmac->VerifyMac(tag, data + '\x80').ok());
+  }
+}
+
+TEST(AesCmacBoringSslTest, testInvalidParameters) {
+  for (int key_size = 0; key_size < 65; key_size++) {
+    auto result = AesCmacBoringSsl::New(std::string(key_size, 'k'), 16);
+    EXPECT_EQ(key_size == 16 || key_size == 32, result.ok()) << key_size;
+  }
+  for (uint32_t tag_size = 0; tag_size < 33; tag_size++) {
+    auto result = AesCmacBoringSsl::New(std::string(16, 'k'), tag_size);
+    EXPECT_EQ(tag_size >= 10 && tag_size <= 16, result.ok()) << tag_size;
+  }
+}
+
+}  // namespace
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
+
+int main(int ac, char* av[]) {
+  testing::InitGoogleTest(&ac, av);
+  return RUN_ALL_TESTS();
+}
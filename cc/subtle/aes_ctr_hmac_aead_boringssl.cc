@@ -0,0 +1,223 @@
+// Copyright 2017 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/subtle/aes_ctr_hmac_aead_boringssl.h"
+
+#include <algorithm>
+#include <string>
+
+#include "openssl/evp.h"
+#include "openssl/hmac.h"
+#include "openssl/mem.h"
+#include "tink/aead.h"
+#include "tink/subtle/random.h"
+#include "tink/subtle/subtle_util_boringssl.h"
+#include "tink/util/errors.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+
+namespace {
+
+// Number of bytes encrypted and MACed at a time. Small enough for a chunk of
+// plaintext and ciphertext to stay in L1.
+const size_t kChunkSize = 4096;
+
+const EVP_CIPHER* GetCipherForKeySize(uint32_t size_in_bytes) {
+  switch (size_in_bytes) {
+    case 16:
+      return EVP_aes_128_ctr();
+    case 32:
+      return EVP_aes_256_ctr();
+    default:
+      return nullptr;
+  }
+}
+
+const uint8_t* AsBytes(absl::string_view s) {
+  return reinterpret_cast<const uint8_t*>(s.data());
+}
+
+}  // namespace
+
+// static
+util::StatusOr<std::unique_ptr<Aead>> AesCtrHmacAeadBoringSsl::New(
+    absl::string_view aes_key, uint8_t iv_size, HashType hash,
+    absl::string_view hmac_key, uint8_t tag_size) {
+  const EVP_CIPHER* cipher = GetCipherForKeySize(aes_key.size());
+  if (cipher == nullptr) {
+    return util::Status(util::error::INTERNAL, "invalid key size");
+  }
+  if (iv_size < MIN_IV_SIZE_IN_BYTES || iv_size > BLOCK_SIZE) {
+    return util::Status(util::error::INTERNAL, "invalid iv size");
+  }
+  auto md_result = SubtleUtilBoringSSL::EvpHash(hash);
+  if (!md_result.ok()) return md_result.status();
+  const EVP_MD* md = md_result.ValueOrDie();
+  if (tag_size < MIN_TAG_SIZE_IN_BYTES || tag_size > EVP_MD_size(md)) {
+    return util::Status(util::error::INTERNAL, "invalid tag size");
+  }
+  if (hmac_key.size() < MIN_HMAC_KEY_SIZE) {
+    return util::Status(util::error::INTERNAL, "invalid HMAC key size");
+  }
+  bssl::UniquePtr<HMAC_CTX> hmac_ctx(HMAC_CTX_new());
+  if (hmac_ctx == nullptr ||
+      1 != HMAC_Init_ex(hmac_ctx.get(), hmac_key.data(), hmac_key.size(), md,
+                        nullptr)) {
+    return util::Status(util::error::INTERNAL, "HMAC_Init_ex failed");
+  }
+  std::unique_ptr<Aead> aead(new AesCtrHmacAeadBoringSsl(
+      cipher, aes_key, iv_size, std::move(hmac_ctx), tag_size));
+  return std::move(aead);
+}
+
+util::StatusOr<bssl::UniquePtr<HMAC_CTX>> AesCtrHmacAeadBoringSsl::StartMac(
+    absl::string_view additional_data, absl::string_view iv) const {
+  bssl::UniquePtr<HMAC_CTX> ctx(HMAC_CTX_new());
+  if (ctx == nullptr ||
+      1 != HMAC_CTX_copy_ex(ctx.get(), hmac_ctx_.get()) ||
+      1 != HMAC_Update(ctx.get(), AsBytes(additional_data),
+                       additional_data.size()) ||
+      1 != HMAC_Update(ctx.get(), AsBytes(iv), iv.size())) {
+    return util::Status(util::error::INTERNAL, "HMAC failed");
+  }
+  return std::move(ctx);
+}
+
+util::Status AesCtrHmacAeadBoringSsl::FinishMac(
+    HMAC_CTX* ctx, absl::string_view additional_data, uint8_t* tag) const {
+  uint64_t aad_size_in_bits = additional_data.size() * 8;
+  uint8_t aad_size[8];
+  for (int i = sizeof(aad_size) - 1; i >= 0; i--) {
+    aad_size[i] = aad_size_in_bits & 0xff;
+    aad_size_in_bits >>= 8;
+  }
+  uint8_t buf[EVP_MAX_MD_SIZE];
+  unsigned int buf_len;
+  if (1 != HMAC_Update(ctx, aad_size, sizeof(aad_size)) ||
+      1 != HMAC_Final(ctx, buf, &buf_len)) {
+    return util::Status(util::error::INTERNAL, "HMAC failed");
+  }
+  memcpy(tag, buf, tag_size_);
+  return util::Status::OK;
+}
+
+util::StatusOr<std::string> AesCtrHmacAeadBoringSsl::Encrypt(
+    absl::string_view plaintext,
+    absl::string_view additional_data) const {
+  // BoringSSL expects a non-null pointer for plaintext and additional_data,
+  // regardless of whether the size is 0.
+  plaintext = SubtleUtilBoringSSL::EnsureNonNull(plaintext);
+  additional_data = SubtleUtilBoringSSL::EnsureNonNull(additional_data);
+
+  const std::string iv = Random::GetRandomBytes(iv_size_);
+  // OpenSSL expects that the IV must be a full block.
+  uint8_t iv_block[BLOCK_SIZE];
+  memset(iv_block, 0, sizeof(iv_block));
+  memcpy(iv_block, iv.data(), iv.size());
+  bssl::UniquePtr<EVP_CIPHER_CTX> cipher_ctx(EVP_CIPHER_CTX_new());
+  if (cipher_ctx == nullptr ||
+      1 != EVP_EncryptInit_ex(cipher_ctx.get(), cipher_, nullptr /* engine */,
+                              AsBytes(aes_key_), iv_block)) {
+    return util::Status(util::error::INTERNAL, "could not initialize ctx");
+  }
+  auto mac_ctx_result = StartMac(additional_data, iv);
+  if (!mac_ctx_result.ok()) return mac_ctx_result.status();
+  bssl::UniquePtr<HMAC_CTX> mac_ctx = std::move(mac_ctx_result.ValueOrDie());
+
+  std::string ciphertext(iv_size_ + plaintext.size() + tag_size_, '\0');
+  memcpy(&ciphertext[0], iv.data(), iv_size_);
+  uint8_t* ct = reinterpret_cast<uint8_t*>(&ciphertext[iv_size_]);
+  const uint8_t* pt = AsBytes(plaintext);
+  for (size_t pos = 0; pos < plaintext.size(); pos += kChunkSize) {
+    size_t chunk_size = std::min(kChunkSize, plaintext.size() - pos);
+    int len;
+    if (1 != EVP_EncryptUpdate(cipher_ctx.get(), ct + pos, &len, pt + pos,
+                               chunk_size) ||
+        static_cast<size_t>(len) != chunk_size) {
+      return util::Status(util::error::INTERNAL, "encryption failed");
+    }
+    if (1 != HMAC_Update(mac_ctx.get(), ct + pos, chunk_size)) {
+      return util::Status(util::error::INTERNAL, "HMAC failed");
+    }
+  }
+  util::Status status =
+      FinishMac(mac_ctx.get(), additional_data, ct + plaintext.size());
+  if (!status.ok()) return status;
+  return std::move(ciphertext);
+}
+
+util::StatusOr<std::string> AesCtrHmacAeadBoringSsl::Decrypt(
+    absl::string_view ciphertext,
+    absl::string_view additional_data) const {
+  // BoringSSL expects a non-null pointer for additional_data,
+  // regardless of whether the size is 0.
+  additional_data = SubtleUtilBoringSSL::EnsureNonNull(additional_data);
+
+  if (ciphertext.size() < static_cast<size_t>(iv_size_) + tag_size_) {
+    return util::Status(util::error::INTERNAL, "ciphertext too short");
+  }
+  absl::string_view iv = ciphertext.substr(0, iv_size_);
+  absl::string_view payload = ciphertext.substr(
+      iv_size_, ciphertext.size() - iv_size_ - tag_size_);
+  absl::string_view tag = ciphertext.substr(ciphertext.size() - tag_size_);
+
+  uint8_t iv_block[BLOCK_SIZE];
+  memset(iv_block, 0, sizeof(iv_block));
+  memcpy(iv_block, iv.data(), iv.size());
+  bssl::UniquePtr<EVP_CIPHER_CTX> cipher_ctx(EVP_CIPHER_CTX_new());
+  if (cipher_ctx == nullptr ||
+      1 != EVP_DecryptInit_ex(cipher_ctx.get(), cipher_, nullptr /* engine */,
+                              AsBytes(aes_key_), iv_block)) {
+    return util::Status(util::error::INTERNAL,
+                        "could not initialize key or iv");
+  }
+  auto mac_ctx_result = StartMac(additional_data, iv);
+  if (!mac_ctx_result.ok()) return mac_ctx_result.status();
+  bssl::UniquePtr<HMAC_CTX> mac_ctx = std::move(mac_ctx_result.ValueOrDie());
+
+  std::string plaintext(payload.size(), '\0');
+  uint8_t* pt = reinterpret_cast<uint8_t*>(&plaintext[0]);
+  const uint8_t* ct = AsBytes(payload);
+  for (size_t pos = 0; pos < payload.size(); pos += kChunkSize) {
+    size_t chunk_size = std::min(kChunkSize, payload.size() - pos);
+    if (1 != HMAC_Update(mac_ctx.get(), ct + pos, chunk_size)) {
+      return util::Status(util::error::INTERNAL, "HMAC failed");
+    }
+    int len;
+    if (1 != EVP_DecryptUpdate(cipher_ctx.get(), pt + pos, &len, ct + pos,
+                               chunk_size) ||
+        static_cast<size_t>(len) != chunk_size) {
+      return util::Status(util::error::INTERNAL, "decryption failed");
+    }
+  }
+  uint8_t expected_tag[EVP_MAX_MD_SIZE];
+  util::Status status =
+      FinishMac(mac_ctx.get(), additional_data, expected_tag);
+  if (!status.ok()) return status;
+  if (CRYPTO_memcmp(expected_tag, tag.data(), tag_size_) != 0) {
+    OPENSSL_cleanse(pt, plaintext.size());
+    return util::Status(util::error::INVALID_ARGUMENT, "verification failed");
+  }
+  return std::move(plaintext);
+}
+
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
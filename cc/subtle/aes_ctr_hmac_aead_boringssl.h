@@ -0,0 +1,99 @@
+// Copyright 2017 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_SUBTLE_AES_CTR_HMAC_AEAD_BORINGSSL_H_
+#define TINK_SUBTLE_AES_CTR_HMAC_AEAD_BORINGSSL_H_
+
+#include <memory>
+#include <string>
+
+#include "absl/strings/string_view.h"
+#include "openssl/base.h"
+#include "openssl/evp.h"
+#include "openssl/hmac.h"
+#include "tink/aead.h"
+#include "tink/subtle/common_enums.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+
+// AES-CTR-HMAC AEAD that encrypts and authenticates in a single pass over
+// the data. Ciphertexts are byte-identical to those of
+// EncryptThenAuthenticate over AesCtrBoringSsl and HmacBoringSsl, i.e.
+//   iv || AES-CTR(iv, plaintext) || HMAC(aad || iv || ct || bitlen(aad)).
+//
+// The data is processed in chunks small enough to stay in L1: each chunk
+// is encrypted and then MACed (or MACed and then decrypted) before moving
+// on to the next one, instead of streaming the whole message through the
+// cache once for AES-CTR and once more for HMAC.
+class AesCtrHmacAeadBoringSsl : public Aead {
+ public:
+  static crypto::tink::util::StatusOr<std::unique_ptr<Aead>> New(
+      absl::string_view aes_key, uint8_t iv_size, HashType hash,
+      absl::string_view hmac_key, uint8_t tag_size);
+
+  crypto::tink::util::StatusOr<std::string> Encrypt(
+      absl::string_view plaintext,
+      absl::string_view additional_data) const override;
+
+  // Decrypts into an internal buffer while verifying the tag, and returns
+  // the plaintext only if the tag is valid.
+  crypto::tink::util::StatusOr<std::string> Decrypt(
+      absl::string_view ciphertext,
+      absl::string_view additional_data) const override;
+
+  virtual ~AesCtrHmacAeadBoringSsl() {}
+
+ private:
+  static const uint8_t MIN_IV_SIZE_IN_BYTES = 12;
+  static const uint8_t MIN_TAG_SIZE_IN_BYTES = 10;
+  static const uint8_t BLOCK_SIZE = 16;
+  static const uint32_t MIN_HMAC_KEY_SIZE = 16;
+
+  AesCtrHmacAeadBoringSsl(const EVP_CIPHER* cipher, absl::string_view aes_key,
+                          uint8_t iv_size, bssl::UniquePtr<HMAC_CTX> hmac_ctx,
+                          uint8_t tag_size)
+      : cipher_(cipher),
+        aes_key_(aes_key),
+        iv_size_(iv_size),
+        hmac_ctx_(std::move(hmac_ctx)),
+        tag_size_(tag_size) {}
+
+  // Returns a copy of hmac_ctx_ that has absorbed 'additional_data' and 'iv'.
+  crypto::tink::util::StatusOr<bssl::UniquePtr<HMAC_CTX>> StartMac(
+      absl::string_view additional_data, absl::string_view iv) const;
+
+  // Finishes 'ctx' and writes the tag to 'tag'.
+  crypto::tink::util::Status FinishMac(HMAC_CTX* ctx,
+                                       absl::string_view additional_data,
+                                       uint8_t* tag) const;
+
+  // cipher_ is a singleton owned by BoringSsl.
+  const EVP_CIPHER* cipher_;
+  const std::string aes_key_;
+  const uint8_t iv_size_;
+  // HMAC context keyed with the HMAC key. Never updated after New().
+  const bssl::UniquePtr<HMAC_CTX> hmac_ctx_;
+  const uint8_t tag_size_;
+};
+
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_SUBTLE_AES_CTR_HMAC_AEAD_BORINGSSL_H_
@@ -0,0 +1,229 @@
+// Copyright 2017 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/subtle/aes_ctr_hmac_aead_boringssl.h"
+
+#include <string>
+#include <vector>
+
+#include "tink/subtle/aes_ctr_boringssl.h"
+#include "tink/subtle/common_enums.h"
+#include "tink/subtle/encrypt_then_authenticate.h"
+#include "tink/subtle/hmac_boringssl.h"
+#include "tink/subtle/random.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "tink/util/test_util.h"
+#include "gtest/gtest.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+namespace {
+
+struct Params {
+  int encryption_key_size;
+  int iv_size;
+  int tag_size;
+  HashType hash_type;
+};
+
+static const std::vector<Params> test_params({
+    {16, 12, 16, HashType::SHA1},
+    {16, 16, 32, HashType::SHA256},
+    {32, 16, 16, HashType::SHA256},
+    {32, 12, 64, HashType::SHA512},
+});
+
+// Returns EncryptThenAuthenticate over AesCtrBoringSsl and HmacBoringSsl,
+// which AesCtrHmacAeadBoringSsl has to be compatible with.
+static std::unique_ptr<Aead> CreateTwoPassAead(
+    const std::string& encryption_key, uint8_t iv_size,
+    const std::string& mac_key, uint8_t tag_size, HashType hash_type) {
+  auto ind_cipher = AesCtrBoringSsl::New(encryption_key, iv_size);
+  auto mac = HmacBoringSsl::New(hash_type, tag_size, mac_key);
+  return std::move(EncryptThenAuthenticate::New(
+                       std::move(ind_cipher.ValueOrDie()),
+                       std::move(mac.ValueOrDie()), tag_size)
+                       .ValueOrDie());
+}
+
+TEST(AesCtrHmacAeadBoringSslTest, testRfcVectors) {
+  // Test vectors from encrypt_then_authenticate_test.cc, copied from
+  // https://tools.ietf.org/html/draft-mcgrew-aead-aes-cbc-hmac-sha2-05.
+  // As the RFC uses CBC mode only the tag computation is checked.
+  std::string mac_key =
+      test::HexDecodeOrDie("000102030405060708090a0b0c0d0e0f");
+  std::string enc_key =
+      test::HexDecodeOrDie("101112131415161718191a1b1c1d1e1f");
+  std::string ct = test::HexDecodeOrDie(
+      "1af38c2dc2b96ffdd86694092341bc04"
+      "c80edfa32ddf39d5ef00c0b468834279"
+      "a2e46a1b8049f792f76bfe54b903a9c9"
+      "a94ac9b47ad2655c5f10f9aef71427e2"
+      "fc6f9b3f399a221489f16362c7032336"
+      "09d45ac69864e3321cf82935ac4096c8"
+      "6e133314c54019e8ca7980dfa4b9cf1b"
+      "384c486f3a54c51078158ee5d79de59f"
+      "bd34d848b3d69550a67646344427ade5"
+      "4b8851ffb598f7f80074b9473c82e2db"
+      "652c3fa36b0a7c5b3219fab3a30bc1c4");
+  std::string aad = test::HexDecodeOrDie(
+      "546865207365636f6e64207072696e63"
+      "69706c65206f66204175677573746520"
+      "4b6572636b686f666673");
+  auto res = AesCtrHmacAeadBoringSsl::New(enc_key, 16, HashType::SHA256,
+                                          mac_key, 16);
+  EXPECT_TRUE(res.ok()) << res.status();
+  auto cipher = std::move(res.ValueOrDie());
+  auto pt = cipher->Decrypt(ct, aad);
+  EXPECT_TRUE(pt.ok()) << pt.status();
+}
+
+TEST(AesCtrHmacAeadBoringSslTest, testCompatibleWithEncryptThenAuthenticate) {
+  // Sizes around the chunk size and multiples of it.
+  std::vector<int> message_sizes = {0,    1,    15,   16,   17,   255,
+                                    4095, 4096, 4097, 8192, 12289, 70000};
+  for (const Params& params : test_params) {
+    std::string encryption_key =
+        Random::GetRandomBytes(params.encryption_key_size);
+    std::string mac_key = Random::GetRandomBytes(32);
+    auto res = AesCtrHmacAeadBoringSsl::New(encryption_key, params.iv_size,
+                                            params.hash_type, mac_key,
+                                            params.tag_size);
+    EXPECT_TRUE(res.ok()) << res.status();
+    auto fused = std::move(res.ValueOrDie());
+    auto two_pass =
+        CreateTwoPassAead(encryption_key, params.iv_size, mac_key,
+                          params.tag_size, params.hash_type);
+    for (int size : message_sizes) {
+      std::string message = Random::GetRandomBytes(size);
+      std::string aad = Random::GetRandomBytes(size % 97);
+
+      auto ct = fused->Encrypt(message, aad);
+      EXPECT_TRUE(ct.ok()) << ct.status();
+      EXPECT_EQ(message.size() + params.iv_size + params.tag_size,
+                ct.ValueOrDie().size());
+      auto pt = two_pass->Decrypt(ct.ValueOrDie(), aad);
+      EXPECT_TRUE(pt.ok()) << pt.status() << " size: " << size;
+      EXPECT_EQ(message, pt.ValueOrDie());
+
+      ct = two_pass->Encrypt(message, aad);
+      EXPECT_TRUE(ct.ok()) << ct.status();
+      pt = fused->Decrypt(ct.ValueOrDie(), aad);
+      EXPECT_TRUE(pt.ok()) << pt.status() << " size: " << size;
+      EXPECT_EQ(message, pt.ValueOrDie());
+    }
+  }
+}
+
+TEST(AesCtrHmacAeadBoringSslTest, testMultipleEncrypt) {
+  auto res = AesCtrHmacAeadBoringSsl::New(Random::GetRandomBytes(16), 12,
+                                          HashType::SHA256,
+                                          Random::GetRandomBytes(32), 16);
+  EXPECT_TRUE(res.ok()) << res.status();
+  auto cipher = std::move(res.ValueOrDie());
+
+  std::string message = Random::GetRandomBytes(20);
+  std::string aad = Random::GetRandomBytes(20);
+  auto ct1 = cipher->Encrypt(message, aad);
+  auto ct2 = cipher->Encrypt(message, aad);
+  EXPECT_NE(ct1.ValueOrDie(), ct2.ValueOrDie());
+}
+
+TEST(AesCtrHmacAeadBoringSslTest, testInvalidParams) {
+  std::string key16 = Random::GetRandomBytes(16);
+  // Invalid AES key size.
+  EXPECT_FALSE(AesCtrHmacAeadBoringSsl::New(Random::GetRandomBytes(24), 12,
+                                            HashType::SHA256, key16, 16)
+                   .ok());
+  // Invalid IV sizes.
+  EXPECT_FALSE(
+      AesCtrHmacAeadBoringSsl::New(key16, 11, HashType::SHA256, key16, 16)
+          .ok());
+  EXPECT_FALSE(
+      AesCtrHmacAeadBoringSsl::New(key16, 17, HashType::SHA256, key16, 16)
+          .ok());
+  // Invalid tag sizes.
+  EXPECT_FALSE(
+      AesCtrHmacAeadBoringSsl::New(key16, 12, HashType::SHA256, key16, 9)
+          .ok());
+  EXPECT_FALSE(
+      AesCtrHmacAeadBoringSsl::New(key16, 12, HashType::SHA256, key16, 33)
+          .ok());
+  // HMAC key too short.
+  EXPECT_FALSE(AesCtrHmacAeadBoringSsl::New(key16, 12, HashType::SHA256,
+                                            Random::GetRandomBytes(15), 16)
+                   .ok());
+}
+
+TEST(AesCtrHmacAeadBoringSslTest, testDecrypt_modifiedCiphertext) {
+  auto res = AesCtrHmacAeadBoringSsl::New(Random::GetRandomBytes(16), 12,
+                                          HashType::SHA256,
+                                          Random::GetRandomBytes(32), 16);
+  EXPECT_TRUE(res.ok()) << res.status();
+  auto cipher = std::move(res.ValueOrDie());
+
+  std::string message = "Some data to encrypt.";
+  std::string aad = "Some data to authenticate.";
+  std::string ct = cipher->Encrypt(message, aad).ValueOrDie();
+  EXPECT_TRUE(cipher->Decrypt(ct, aad).ok());
+  // Modify the ciphertext
+  for (size_t i = 0; i < ct.size() * 8; i++) {
+    std::string modified_ct = ct;
+    modified_ct[i / 8] ^= 1 << (i % 8);
+    EXPECT_FALSE(cipher->Decrypt(modified_ct, aad).ok()) << i;
+  }
+
+  // Modify the additional data
+  for (size_t i = 0; i < aad.size() * 8; i++) {
+    std::string modified_aad = aad;
+    modified_aad[i / 8] ^= 1 << (i % 8);
+    EXPECT_FALSE(cipher->Decrypt(ct, modified_aad).ok()) << i;
+  }
+
+  // Truncate the ciphertext
+  for (size_t i = 0; i < ct.size(); i++) {
+    std::string truncated_ct(ct, 0, i);
+    EXPECT_FALSE(cipher->Decrypt(truncated_ct, aad).ok()) << i;
+  }
+}
+
+TEST(AesCtrHmacAeadBoringSslTest, testParamsEmptyVersusNullStringView) {
+  auto res = AesCtrHmacAeadBoringSsl::New(Random::GetRandomBytes(16), 12,
+                                          HashType::SHA256,
+                                          Random::GetRandomBytes(32), 16);
+  EXPECT_TRUE(res.ok()) << res.status();
+  auto cipher = std::move(res.ValueOrDie());
+
+  const absl::string_view empty;
+  const absl::string_view null(nullptr, 0);
+  auto ct = cipher->Encrypt(null, null);
+  EXPECT_TRUE(ct.ok()) << ct.status();
+  auto pt = cipher->Decrypt(ct.ValueOrDie(), empty);
+  EXPECT_TRUE(pt.ok()) << pt.status();
+  EXPECT_EQ("", pt.ValueOrDie());
+}
+
+}  // namespace
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
+
+int main(int ac, char* av[]) {
+  testing::InitGoogleTest(&ac, av);
+  return RUN_ALL_TESTS();
+}
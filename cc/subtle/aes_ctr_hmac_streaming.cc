@@ -0,0 +1,256 @@
+// Copyright 2018 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/subtle/aes_ctr_hmac_streaming.h"
+
+#include <string.h>
+
+#include "absl/memory/memory.h"
+#include "openssl/base.h"
+#include "openssl/crypto.h"
+#include "openssl/evp.h"
+#include "openssl/hmac.h"
+#include "openssl/mem.h"
+#include "tink/subtle/hkdf.h"
+#include "tink/subtle/random.h"
+#include "tink/subtle/subtle_util_boringssl.h"
+#include "tink/util/errors.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+
+namespace {
+
+const int kNonceSizeInBytes = 16;
+const int kMinTagSizeInBytes = 10;
+
+int HeaderSize(int derived_key_size) {
+  return 1 + derived_key_size + AesCtrHmacStreaming::kNoncePrefixSizeInBytes;
+}
+
+const uint8_t* AsBytes(absl::string_view s) {
+  return reinterpret_cast<const uint8_t*>(s.data());
+}
+
+class AesCtrHmacSegmentCipher : public StreamSegmentCipher {
+ public:
+  AesCtrHmacSegmentCipher(const EVP_CIPHER* cipher, absl::string_view aes_key,
+                          bssl::UniquePtr<HMAC_CTX> hmac_ctx, int tag_size,
+                          absl::string_view nonce_prefix)
+      : cipher_(cipher),
+        aes_key_(aes_key),
+        hmac_ctx_(std::move(hmac_ctx)),
+        tag_size_(tag_size),
+        nonce_prefix_(nonce_prefix) {}
+
+  ~AesCtrHmacSegmentCipher() override {
+    OPENSSL_cleanse(&aes_key_[0], aes_key_.size());
+  }
+
+  util::Status EncryptSegment(absl::string_view plaintext,
+                              uint32_t segment_number, bool is_last_segment,
+                              char* ciphertext) const override {
+    uint8_t nonce[kNonceSizeInBytes];
+    ComputeNonce(segment_number, is_last_segment, nonce);
+    uint8_t* out = reinterpret_cast<uint8_t*>(ciphertext);
+    util::Status status = Ctr(nonce, AsBytes(plaintext), plaintext.size(), out);
+    if (!status.ok()) return status;
+    return ComputeTag(nonce, out, plaintext.size(), out + plaintext.size());
+  }
+
+  util::Status DecryptSegment(absl::string_view ciphertext,
+                              uint32_t segment_number, bool is_last_segment,
+                              char* plaintext) const override {
+    if (ciphertext.size() < static_cast<size_t>(tag_size_)) {
+      return util::Status(util::error::INVALID_ARGUMENT,
+                          "Ciphertext segment too short");
+    }
+    uint8_t nonce[kNonceSizeInBytes];
+    ComputeNonce(segment_number, is_last_segment, nonce);
+    size_t size = ciphertext.size() - tag_size_;
+    uint8_t tag[EVP_MAX_MD_SIZE];
+    util::Status status = ComputeTag(nonce, AsBytes(ciphertext), size, tag);
+    if (!status.ok()) return status;
+    if (CRYPTO_memcmp(tag, ciphertext.data() + size, tag_size_) != 0) {
+      return util::Status(util::error::INVALID_ARGUMENT,
+                          "Authentication failed");
+    }
+    return Ctr(nonce, AsBytes(ciphertext), size,
+               reinterpret_cast<uint8_t*>(plaintext));
+  }
+
+ private:
+  void ComputeNonce(uint32_t segment_number, bool is_last_segment,
+                    uint8_t nonce[kNonceSizeInBytes]) const {
+    memset(nonce, 0, kNonceSizeInBytes);
+    memcpy(nonce, nonce_prefix_.data(), nonce_prefix_.size());
+    uint8_t* p = nonce + nonce_prefix_.size();
+    p[0] = static_cast<uint8_t>(segment_number >> 24);
+    p[1] = static_cast<uint8_t>(segment_number >> 16);
+    p[2] = static_cast<uint8_t>(segment_number >> 8);
+    p[3] = static_cast<uint8_t>(segment_number);
+    p[4] = is_last_segment ? 1 : 0;
+  }
+
+  util::Status Ctr(const uint8_t* nonce, const uint8_t* in, size_t size,
+                   uint8_t* out) const {
+    bssl::UniquePtr<EVP_CIPHER_CTX> ctx(EVP_CIPHER_CTX_new());
+    int len;
+    if (ctx == nullptr ||
+        1 != EVP_EncryptInit_ex(ctx.get(), cipher_, nullptr,
+                                AsBytes(aes_key_), nonce) ||
+        1 != EVP_EncryptUpdate(ctx.get(), out, &len, in, size) ||
+        static_cast<size_t>(len) != size) {
+      return util::Status(util::error::INTERNAL, "AES-CTR failed");
+    }
+    return util::Status::OK;
+  }
+
+  util::Status ComputeTag(const uint8_t* nonce, const uint8_t* ciphertext,
+                          size_t size, uint8_t* tag) const {
+    bssl::UniquePtr<HMAC_CTX> ctx(HMAC_CTX_new());
+    uint8_t buf[EVP_MAX_MD_SIZE];
+    unsigned int buf_len;
+    if (ctx == nullptr || 1 != HMAC_CTX_copy_ex(ctx.get(), hmac_ctx_.get()) ||
+        1 != HMAC_Update(ctx.get(), nonce, kNonceSizeInBytes) ||
+        1 != HMAC_Update(ctx.get(), ciphertext, size) ||
+        1 != HMAC_Final(ctx.get(), buf, &buf_len)) {
+      return util::Status(util::error::INTERNAL, "HMAC failed");
+    }
+    memcpy(tag, buf, tag_size_);
+    return util::Status::OK;
+  }
+
+  const EVP_CIPHER* cipher_;  // Owned by BoringSSL.
+  std::string aes_key_;  // wiped on destruction
+  // HMAC context keyed with the HMAC key. Never updated after construction.
+  const bssl::UniquePtr<HMAC_CTX> hmac_ctx_;
+  const int tag_size_;
+  const std::string nonce_prefix_;
+};
+
+}  // namespace
+
+constexpr int AesCtrHmacStreaming::kNoncePrefixSizeInBytes;
+constexpr int AesCtrHmacStreaming::kHmacKeySizeInBytes;
+
+// static
+util::StatusOr<std::unique_ptr<AesCtrHmacStreaming>> AesCtrHmacStreaming::New(
+    absl::string_view ikm, HashType hkdf_hash, int derived_key_size,
+    HashType tag_hash, int tag_size, int ciphertext_segment_size) {
+  if (derived_key_size != 16 && derived_key_size != 32) {
+    return ToStatusF(util::error::INVALID_ARGUMENT,
+                     "Invalid derived key size %d; supported sizes: "
+                     "16 or 32 bytes.", derived_key_size);
+  }
+  if (ikm.size() < 16 || ikm.size() < static_cast<size_t>(derived_key_size)) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "Input key material too short.");
+  }
+  if (hkdf_hash != HashType::SHA1 && hkdf_hash != HashType::SHA256 &&
+      hkdf_hash != HashType::SHA512) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "Unsupported HKDF hash.");
+  }
+  auto md_result = SubtleUtilBoringSSL::EvpHash(tag_hash);
+  if (!md_result.ok()) return md_result.status();
+  int max_tag_size = EVP_MD_size(md_result.ValueOrDie());
+  if (tag_size < kMinTagSizeInBytes || tag_size > max_tag_size) {
+    return ToStatusF(util::error::INVALID_ARGUMENT,
+                     "Invalid tag size %d.", tag_size);
+  }
+  if (ciphertext_segment_size <= HeaderSize(derived_key_size) + tag_size) {
+    return ToStatusF(util::error::INVALID_ARGUMENT,
+                     "Ciphertext segment size %d too small.",
+                     ciphertext_segment_size);
+  }
+  return absl::WrapUnique(
+      new AesCtrHmacStreaming(ikm, hkdf_hash, derived_key_size, tag_hash,
+                              tag_size, ciphertext_segment_size));
+}
+
+AesCtrHmacStreaming::AesCtrHmacStreaming(absl::string_view ikm,
+                                         HashType hkdf_hash,
+                                         int derived_key_size,
+                                         HashType tag_hash, int tag_size,
+                                         int ciphertext_segment_size)
+    : NonceBasedStreamingAead(HeaderSize(derived_key_size),
+                              ciphertext_segment_size, tag_size),
+      ikm_(ikm),
+      hkdf_hash_(hkdf_hash),
+      derived_key_size_(derived_key_size),
+      tag_hash_(tag_hash),
+      tag_size_(tag_size) {}
+
+util::StatusOr<std::unique_ptr<StreamSegmentCipher>>
+AesCtrHmacStreaming::NewSegmentCipher(
+    absl::string_view salt, absl::string_view nonce_prefix,
+    absl::string_view associated_data) const {
+  auto key_material_result =
+      Hkdf::ComputeHkdf(hkdf_hash_, ikm_, salt, associated_data,
+                        derived_key_size_ + kHmacKeySizeInBytes);
+  if (!key_material_result.ok()) return key_material_result.status();
+  std::string& key_material = key_material_result.ValueOrDie();
+  auto md_result = SubtleUtilBoringSSL::EvpHash(tag_hash_);
+  bssl::UniquePtr<HMAC_CTX> hmac_ctx(HMAC_CTX_new());
+  bool keyed =
+      md_result.ok() && hmac_ctx != nullptr &&
+      1 == HMAC_Init_ex(hmac_ctx.get(), key_material.data() + derived_key_size_,
+                        kHmacKeySizeInBytes, md_result.ValueOrDie(), nullptr);
+  std::unique_ptr<StreamSegmentCipher> segment_cipher;
+  if (keyed) {
+    const EVP_CIPHER* cipher =
+        derived_key_size_ == 16 ? EVP_aes_128_ctr() : EVP_aes_256_ctr();
+    segment_cipher.reset(new AesCtrHmacSegmentCipher(
+        cipher, absl::string_view(key_material).substr(0, derived_key_size_),
+        std::move(hmac_ctx), tag_size_, nonce_prefix));
+  }
+  // The segment cipher keeps its own copies of both keys.
+  OPENSSL_cleanse(&key_material[0], key_material.size());
+  if (!md_result.ok()) return md_result.status();
+  if (!keyed) {
+    return util::Status(util::error::INTERNAL, "HMAC_Init_ex failed");
+  }
+  return std::move(segment_cipher);
+}
+
+util::StatusOr<std::unique_ptr<StreamSegmentCipher>>
+AesCtrHmacStreaming::NewSegmentEncrypter(absl::string_view associated_data,
+                                         std::string* header) const {
+  std::string salt = Random::GetRandomBytes(derived_key_size_);
+  std::string nonce_prefix = Random::GetRandomBytes(kNoncePrefixSizeInBytes);
+  header->assign(1, static_cast<char>(header_size()));
+  header->append(salt);
+  header->append(nonce_prefix);
+  return NewSegmentCipher(salt, nonce_prefix, associated_data);
+}
+
+util::StatusOr<std::unique_ptr<StreamSegmentCipher>>
+AesCtrHmacStreaming::NewSegmentDecrypter(
+    absl::string_view header, absl::string_view associated_data) const {
+  if (header.size() != header_size() ||
+      static_cast<uint8_t>(header[0]) != header_size()) {
+    return util::Status(util::error::INVALID_ARGUMENT, "Invalid header");
+  }
+  return NewSegmentCipher(header.substr(1, derived_key_size_),
+                          header.substr(1 + derived_key_size_),
+                          associated_data);
+}
+
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,157 @@
+// Copyright 2018 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/subtle/aes_ctr_hmac_streaming.h"
+
+#include <string>
+
+#include "gtest/gtest.h"
+#include "tink/subtle/common_enums.h"
+#include "tink/subtle/random.h"
+#include "tink/util/buffer_random_access_stream.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "tink/util/test_util.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+namespace {
+
+using crypto::tink::util::BufferRandomAccessSink;
+using crypto::tink::util::BufferRandomAccessStream;
+
+util::StatusOr<std::string> Encrypt(const StreamingAead& streaming_aead,
+                                    absl::string_view plaintext,
+                                    absl::string_view associated_data) {
+  std::string ciphertext(streaming_aead.CiphertextSize(plaintext.size()), 'x');
+  BufferRandomAccessStream source(plaintext);
+  BufferRandomAccessSink sink(&ciphertext[0], ciphertext.size());
+  auto status = streaming_aead.Encrypt(&source, associated_data, &sink);
+  if (!status.ok()) return status;
+  return ciphertext;
+}
+
+util::StatusOr<std::string> Decrypt(const StreamingAead& streaming_aead,
+                                    absl::string_view ciphertext,
+                                    absl::string_view associated_data) {
+  auto size_result = streaming_aead.PlaintextSize(ciphertext.size());
+  if (!size_result.ok()) return size_result.status();
+  std::string plaintext(size_result.ValueOrDie(), 'x');
+  BufferRandomAccessStream source(ciphertext);
+  BufferRandomAccessSink sink(&plaintext[0], plaintext.size());
+  auto status = streaming_aead.Decrypt(&source, associated_data, &sink);
+  if (!status.ok()) return status;
+  return plaintext;
+}
+
+class AesCtrHmacStreamingTest : public ::testing::Test {
+ protected:
+  std::string ikm_ = test::HexDecodeOrDie(
+      "000102030405060708090a0b0c0d0e0f00112233445566778899aabbccddeeff");
+};
+
+TEST_F(AesCtrHmacStreamingTest, testEncryptDecrypt) {
+  std::string associated_data = "some associated data";
+  for (int derived_key_size : {16, 32}) {
+    for (HashType tag_hash : {HashType::SHA1, HashType::SHA256}) {
+      for (int segment_size : {128, 4096}) {
+        int tag_size = 12;
+        auto result = AesCtrHmacStreaming::New(ikm_, HashType::SHA256,
+                                               derived_key_size, tag_hash,
+                                               tag_size, segment_size);
+        EXPECT_TRUE(result.ok()) << result.status();
+        auto streaming_aead = std::move(result.ValueOrDie());
+        int header_size = 1 + derived_key_size + 7;
+        int first_segment_size = segment_size - header_size - tag_size;
+        for (int plaintext_size :
+             {0, 1, first_segment_size, first_segment_size + 1,
+              7 * segment_size + 5}) {
+          std::string plaintext = Random::GetRandomBytes(plaintext_size);
+          auto ct_result =
+              Encrypt(*streaming_aead, plaintext, associated_data);
+          EXPECT_TRUE(ct_result.ok()) << ct_result.status();
+          std::string ciphertext = ct_result.ValueOrDie();
+          EXPECT_EQ(plaintext_size,
+                    streaming_aead->PlaintextSize(ciphertext.size())
+                        .ValueOrDie());
+          auto pt_result =
+              Decrypt(*streaming_aead, ciphertext, associated_data);
+          EXPECT_TRUE(pt_result.ok()) << pt_result.status();
+          EXPECT_EQ(plaintext, pt_result.ValueOrDie());
+          EXPECT_FALSE(Decrypt(*streaming_aead, ciphertext, "wrong").ok());
+
+          for (size_t position = 0; position < ciphertext.size();
+               position += 1 + ciphertext.size() / 7) {
+            std::string modified = ciphertext;
+            modified[position] ^= 0x80;
+            EXPECT_FALSE(
+                Decrypt(*streaming_aead, modified, associated_data).ok());
+          }
+        }
+      }
+    }
+  }
+}
+
+TEST_F(AesCtrHmacStreamingTest, testLargeInputAndRanges) {
+  auto streaming_aead = std::move(
+      AesCtrHmacStreaming::New(ikm_, HashType::SHA256, 32, HashType::SHA256,
+                               32, 1 << 12).ValueOrDie());
+  std::string plaintext = Random::GetRandomBytes(6 << 20);
+  std::string ciphertext =
+      Encrypt(*streaming_aead, plaintext, "aad").ValueOrDie();
+  auto pt_result = Decrypt(*streaming_aead, ciphertext, "aad");
+  EXPECT_TRUE(pt_result.ok()) << pt_result.status();
+  EXPECT_TRUE(plaintext == pt_result.ValueOrDie());
+
+  BufferRandomAccessStream source(ciphertext);
+  for (size_t position : {0, 4000, 4056, 4057, 1000000}) {
+    auto result =
+        streaming_aead->DecryptRange(&source, "aad", position, 20000);
+    EXPECT_TRUE(result.ok()) << result.status();
+    EXPECT_EQ(plaintext.substr(position, 20000), result.ValueOrDie());
+  }
+  EXPECT_FALSE(
+      Decrypt(*streaming_aead, ciphertext.substr(0, 1 << 20), "aad").ok());
+}
+
+TEST_F(AesCtrHmacStreamingTest, testInvalidParameters) {
+  EXPECT_FALSE(AesCtrHmacStreaming::New(ikm_, HashType::SHA256, 24,
+                                        HashType::SHA256, 16, 4096).ok());
+  EXPECT_FALSE(AesCtrHmacStreaming::New(ikm_.substr(0, 15), HashType::SHA256,
+                                        16, HashType::SHA256, 16, 4096).ok());
+  EXPECT_FALSE(AesCtrHmacStreaming::New(ikm_, HashType::UNKNOWN_HASH, 16,
+                                        HashType::SHA256, 16, 4096).ok());
+  EXPECT_FALSE(AesCtrHmacStreaming::New(ikm_, HashType::SHA256, 16,
+                                        HashType::SHA256, 9, 4096).ok());
+  EXPECT_FALSE(AesCtrHmacStreaming::New(ikm_, HashType::SHA256, 16,
+                                        HashType::SHA1, 21, 4096).ok());
+  EXPECT_TRUE(AesCtrHmacStreaming::New(ikm_, HashType::SHA256, 16,
+                                       HashType::SHA512, 64, 4096).ok());
+  EXPECT_FALSE(AesCtrHmacStreaming::New(ikm_, HashType::SHA256, 16,
+                                        HashType::SHA256, 16, 24 + 16).ok());
+}
+
+}  // namespace
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
+
+int main(int ac, char* av[]) {
+  testing::InitGoogleTest(&ac, av);
+  return RUN_ALL_TESTS();
+}
@@ -21,14 +21,19 @@
 
 #include "absl/strings/string_view.h"
 #include "tink/aead.h"
+#include "tink/output_buffer.h"
 #include "tink/util/status.h"
 #include "tink/util/statusor.h"
-#include "openssl/evp.h"
+#include "openssl/aead.h"
+#include "openssl/base.h"
 
 namespace crypto {
 namespace tink {
 namespace subtle {
 
+// The key schedule is computed once, by New(), into an EVP_AEAD_CTX that
+// all calls share, so EncryptInto() and DecryptInto() do not allocate
+// memory. The methods are safe to call concurrently.
 class AesGcmBoringSsl : public Aead {
  public:
   static crypto::tink::util::StatusOr<std::unique_ptr<Aead>> New(
@@ -42,21 +47,28 @@ class AesGcmBoringSsl : public Aead {
       absl::string_view ciphertext,
       absl::string_view additional_data) const override;
 
+  // Writes IV || ciphertext || tag directly into 'ciphertext'.
+  crypto::tink::util::Status EncryptInto(
+      absl::string_view plaintext,
+      absl::string_view additional_data,
+      OutputBuffer* ciphertext) const override;
+
+  crypto::tink::util::Status DecryptInto(
+      absl::string_view ciphertext,
+      absl::string_view additional_data,
+      OutputBuffer* plaintext) const override;
+
   virtual ~AesGcmBoringSsl() {}
 
  private:
   static const int IV_SIZE_IN_BYTES = 12;
   static const int TAG_SIZE_IN_BYTES = 16;
 
-  AesGcmBoringSsl() {}
-  AesGcmBoringSsl(absl::string_view key_value,
-                  const EVP_CIPHER *cipher);
+  AesGcmBoringSsl() = delete;
+  explicit AesGcmBoringSsl(bssl::UniquePtr<EVP_AEAD_CTX> ctx)
+      : ctx_(std::move(ctx)) {}
 
-  const std::string key_;
-  // cipher_ is a singleton owned by BoringSsl.
-  // Preferable would be to use the AEAD interface, but unfortunately this
-  // interface does not support 192-bit keys.
-  const EVP_CIPHER *cipher_;
+  const bssl::UniquePtr<EVP_AEAD_CTX> ctx_;
 };
 
 }  // namespace subtle
@@ -0,0 +1,190 @@
+// Copyright 2018 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/subtle/aes_gcm_hkdf_streaming.h"
+
+#include <string.h>
+
+#include "absl/memory/memory.h"
+#include "openssl/aead.h"
+#include "openssl/base.h"
+#include "openssl/mem.h"
+#include "tink/subtle/hkdf.h"
+#include "tink/subtle/random.h"
+#include "tink/util/errors.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+
+namespace {
+
+const int kNonceSizeInBytes = 12;
+
+int HeaderSize(int derived_key_size) {
+  return 1 + derived_key_size + AesGcmHkdfStreaming::kNoncePrefixSizeInBytes;
+}
+
+const uint8_t* AsBytes(absl::string_view s) {
+  return reinterpret_cast<const uint8_t*>(s.data());
+}
+
+class AesGcmHkdfSegmentCipher : public StreamSegmentCipher {
+ public:
+  AesGcmHkdfSegmentCipher(bssl::UniquePtr<EVP_AEAD_CTX> ctx,
+                          absl::string_view nonce_prefix)
+      : ctx_(std::move(ctx)), nonce_prefix_(nonce_prefix) {}
+
+  util::Status EncryptSegment(absl::string_view plaintext,
+                              uint32_t segment_number, bool is_last_segment,
+                              char* ciphertext) const override {
+    uint8_t nonce[kNonceSizeInBytes];
+    ComputeNonce(segment_number, is_last_segment, nonce);
+    size_t out_len;
+    if (1 != EVP_AEAD_CTX_seal(
+                 ctx_.get(), reinterpret_cast<uint8_t*>(ciphertext), &out_len,
+                 plaintext.size() + AesGcmHkdfStreaming::kTagSizeInBytes,
+                 nonce, sizeof(nonce), AsBytes(plaintext), plaintext.size(),
+                 nullptr, 0)) {
+      return util::Status(util::error::INTERNAL, "Encryption failed");
+    }
+    return util::Status::OK;
+  }
+
+  util::Status DecryptSegment(absl::string_view ciphertext,
+                              uint32_t segment_number, bool is_last_segment,
+                              char* plaintext) const override {
+    uint8_t nonce[kNonceSizeInBytes];
+    ComputeNonce(segment_number, is_last_segment, nonce);
+    size_t out_len;
+    if (ciphertext.size() < AesGcmHkdfStreaming::kTagSizeInBytes ||
+        1 != EVP_AEAD_CTX_open(
+                 ctx_.get(), reinterpret_cast<uint8_t*>(plaintext), &out_len,
+                 ciphertext.size(), nonce, sizeof(nonce), AsBytes(ciphertext),
+                 ciphertext.size(), nullptr, 0)) {
+      return util::Status(util::error::INVALID_ARGUMENT,
+                          "Authentication failed");
+    }
+    return util::Status::OK;
+  }
+
+ private:
+  void ComputeNonce(uint32_t segment_number, bool is_last_segment,
+                    uint8_t nonce[kNonceSizeInBytes]) const {
+    memcpy(nonce, nonce_prefix_.data(), nonce_prefix_.size());
+    uint8_t* p = nonce + nonce_prefix_.size();
+    p[0] = static_cast<uint8_t>(segment_number >> 24);
+    p[1] = static_cast<uint8_t>(segment_number >> 16);
+    p[2] = static_cast<uint8_t>(segment_number >> 8);
+    p[3] = static_cast<uint8_t>(segment_number);
+    p[4] = is_last_segment ? 1 : 0;
+  }
+
+  const bssl::UniquePtr<EVP_AEAD_CTX> ctx_;
+  const std::string nonce_prefix_;
+};
+
+}  // namespace
+
+constexpr int AesGcmHkdfStreaming::kNoncePrefixSizeInBytes;
+constexpr int AesGcmHkdfStreaming::kTagSizeInBytes;
+
+// static
+util::StatusOr<std::unique_ptr<AesGcmHkdfStreaming>> AesGcmHkdfStreaming::New(
+    absl::string_view ikm, HashType hkdf_hash, int derived_key_size,
+    int ciphertext_segment_size) {
+  if (derived_key_size != 16 && derived_key_size != 32) {
+    return ToStatusF(util::error::INVALID_ARGUMENT,
+                     "Invalid derived key size %d; supported sizes: "
+                     "16 or 32 bytes.", derived_key_size);
+  }
+  if (ikm.size() < 16 || ikm.size() < static_cast<size_t>(derived_key_size)) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "Input key material too short.");
+  }
+  if (hkdf_hash != HashType::SHA1 && hkdf_hash != HashType::SHA256 &&
+      hkdf_hash != HashType::SHA512) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "Unsupported HKDF hash.");
+  }
+  if (ciphertext_segment_size <=
+      HeaderSize(derived_key_size) + kTagSizeInBytes) {
+    return ToStatusF(util::error::INVALID_ARGUMENT,
+                     "Ciphertext segment size %d too small.",
+                     ciphertext_segment_size);
+  }
+  return absl::WrapUnique(new AesGcmHkdfStreaming(
+      ikm, hkdf_hash, derived_key_size, ciphertext_segment_size));
+}
+
+AesGcmHkdfStreaming::AesGcmHkdfStreaming(absl::string_view ikm,
+                                         HashType hkdf_hash,
+                                         int derived_key_size,
+                                         int ciphertext_segment_size)
+    : NonceBasedStreamingAead(HeaderSize(derived_key_size),
+                              ciphertext_segment_size, kTagSizeInBytes),
+      ikm_(ikm),
+      hkdf_hash_(hkdf_hash),
+      derived_key_size_(derived_key_size) {}
+
+util::StatusOr<std::unique_ptr<StreamSegmentCipher>>
+AesGcmHkdfStreaming::NewSegmentCipher(
+    absl::string_view salt, absl::string_view nonce_prefix,
+    absl::string_view associated_data) const {
+  auto key_result = Hkdf::ComputeHkdf(hkdf_hash_, ikm_, salt, associated_data,
+                                      derived_key_size_);
+  if (!key_result.ok()) return key_result.status();
+  std::string& key = key_result.ValueOrDie();
+  const EVP_AEAD* aead = derived_key_size_ == 16 ? EVP_aead_aes_128_gcm()
+                                                 : EVP_aead_aes_256_gcm();
+  bssl::UniquePtr<EVP_AEAD_CTX> ctx(EVP_AEAD_CTX_new(
+      aead, AsBytes(key), key.size(), kTagSizeInBytes));
+  // The context keeps its own expanded copy of the key.
+  OPENSSL_cleanse(&key[0], key.size());
+  if (ctx == nullptr) {
+    return util::Status(util::error::INTERNAL, "EVP_AEAD_CTX_new failed");
+  }
+  std::unique_ptr<StreamSegmentCipher> cipher(
+      new AesGcmHkdfSegmentCipher(std::move(ctx), nonce_prefix));
+  return std::move(cipher);
+}
+
+util::StatusOr<std::unique_ptr<StreamSegmentCipher>>
+AesGcmHkdfStreaming::NewSegmentEncrypter(absl::string_view associated_data,
+                                         std::string* header) const {
+  std::string salt = Random::GetRandomBytes(derived_key_size_);
+  std::string nonce_prefix = Random::GetRandomBytes(kNoncePrefixSizeInBytes);
+  header->assign(1, static_cast<char>(header_size()));
+  header->append(salt);
+  header->append(nonce_prefix);
+  return NewSegmentCipher(salt, nonce_prefix, associated_data);
+}
+
+util::StatusOr<std::unique_ptr<StreamSegmentCipher>>
+AesGcmHkdfStreaming::NewSegmentDecrypter(
+    absl::string_view header, absl::string_view associated_data) const {
+  if (header.size() != header_size() ||
+      static_cast<uint8_t>(header[0]) != header_size()) {
+    return util::Status(util::error::INVALID_ARGUMENT, "Invalid header");
+  }
+  return NewSegmentCipher(header.substr(1, derived_key_size_),
+                          header.substr(1 + derived_key_size_),
+                          associated_data);
+}
+
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
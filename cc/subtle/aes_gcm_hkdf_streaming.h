@@ -0,0 +1,79 @@
+// Copyright 2018 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_SUBTLE_AES_GCM_HKDF_STREAMING_H_
+#define TINK_SUBTLE_AES_GCM_HKDF_STREAMING_H_
+
+#include <memory>
+#include <string>
+
+#include "absl/strings/string_view.h"
+#include "tink/subtle/common_enums.h"
+#include "tink/subtle/nonce_based_streaming_aead.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+
+// Streaming AEAD with AES-GCM, compatible with the Java class of the same
+// name. Each ciphertext uses its own AES-GCM key, derived with HKDF from
+// the input key material, a random salt and the associated data. The
+// header of a ciphertext is
+//   header_size (1 byte) || salt (derived_key_size bytes) ||
+//   nonce_prefix (7 bytes),
+// and the nonce of segment i is
+//   nonce_prefix || i (4 bytes, big endian) || is_last_segment (1 byte).
+// Every segment carries a 16-byte AES-GCM tag.
+class AesGcmHkdfStreaming : public NonceBasedStreamingAead {
+ public:
+  static crypto::tink::util::StatusOr<std::unique_ptr<AesGcmHkdfStreaming>>
+  New(absl::string_view ikm, HashType hkdf_hash, int derived_key_size,
+      int ciphertext_segment_size);
+
+  ~AesGcmHkdfStreaming() override {}
+
+  static constexpr int kNoncePrefixSizeInBytes = 7;
+  static constexpr int kTagSizeInBytes = 16;
+
+ protected:
+  crypto::tink::util::StatusOr<std::unique_ptr<StreamSegmentCipher>>
+  NewSegmentEncrypter(absl::string_view associated_data,
+                      std::string* header) const override;
+
+  crypto::tink::util::StatusOr<std::unique_ptr<StreamSegmentCipher>>
+  NewSegmentDecrypter(absl::string_view header,
+                      absl::string_view associated_data) const override;
+
+ private:
+  AesGcmHkdfStreaming(absl::string_view ikm, HashType hkdf_hash,
+                      int derived_key_size, int ciphertext_segment_size);
+
+  crypto::tink::util::StatusOr<std::unique_ptr<StreamSegmentCipher>>
+  NewSegmentCipher(absl::string_view salt, absl::string_view nonce_prefix,
+                   absl::string_view associated_data) const;
+
+  const std::string ikm_;
+  const HashType hkdf_hash_;
+  const int derived_key_size_;
+};
+
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_SUBTLE_AES_GCM_HKDF_STREAMING_H_
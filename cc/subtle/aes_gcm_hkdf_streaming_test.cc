@@ -0,0 +1,289 @@
+// Copyright 2018 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/subtle/aes_gcm_hkdf_streaming.h"
+
+#include <stdio.h>
+
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "openssl/aead.h"
+#include "tink/subtle/common_enums.h"
+#include "tink/subtle/hkdf.h"
+#include "tink/subtle/random.h"
+#include "tink/util/buffer_random_access_stream.h"
+#include "tink/util/file_random_access_stream.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "tink/util/test_util.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+namespace {
+
+using crypto::tink::util::BufferRandomAccessSink;
+using crypto::tink::util::BufferRandomAccessStream;
+using crypto::tink::util::FileRandomAccessSink;
+using crypto::tink::util::FileRandomAccessStream;
+
+util::StatusOr<std::string> Encrypt(const StreamingAead& streaming_aead,
+                                    absl::string_view plaintext,
+                                    absl::string_view associated_data) {
+  std::string ciphertext(streaming_aead.CiphertextSize(plaintext.size()), 'x');
+  BufferRandomAccessStream source(plaintext);
+  BufferRandomAccessSink sink(&ciphertext[0], ciphertext.size());
+  auto status = streaming_aead.Encrypt(&source, associated_data, &sink);
+  if (!status.ok()) return status;
+  return ciphertext;
+}
+
+util::StatusOr<std::string> Decrypt(const StreamingAead& streaming_aead,
+                                    absl::string_view ciphertext,
+                                    absl::string_view associated_data) {
+  auto size_result = streaming_aead.PlaintextSize(ciphertext.size());
+  if (!size_result.ok()) return size_result.status();
+  std::string plaintext(size_result.ValueOrDie(), 'x');
+  BufferRandomAccessStream source(ciphertext);
+  BufferRandomAccessSink sink(&plaintext[0], plaintext.size());
+  auto status = streaming_aead.Decrypt(&source, associated_data, &sink);
+  if (!status.ok()) return status;
+  return plaintext;
+}
+
+class AesGcmHkdfStreamingTest : public ::testing::Test {
+ protected:
+  std::unique_ptr<AesGcmHkdfStreaming> NewStreamingAead(
+      int derived_key_size, int ciphertext_segment_size) {
+    auto result = AesGcmHkdfStreaming::New(ikm_, HashType::SHA256,
+                                           derived_key_size,
+                                           ciphertext_segment_size);
+    EXPECT_TRUE(result.ok()) << result.status();
+    return std::move(result.ValueOrDie());
+  }
+
+  std::string ikm_ = test::HexDecodeOrDie(
+      "000102030405060708090a0b0c0d0e0f00112233445566778899aabbccddeeff");
+};
+
+TEST_F(AesGcmHkdfStreamingTest, testEncryptDecrypt) {
+  std::string associated_data = "some associated data";
+  for (int derived_key_size : {16, 32}) {
+    for (int segment_size : {64, 256, 4096}) {
+      auto streaming_aead = NewStreamingAead(derived_key_size, segment_size);
+      int header_size = 1 + derived_key_size + 7;
+      int first_segment_size = segment_size - header_size - 16;
+      for (int plaintext_size :
+           {0, 1, first_segment_size - 1, first_segment_size,
+            first_segment_size + 1, 5 * segment_size, 5 * segment_size + 3}) {
+        std::string plaintext = Random::GetRandomBytes(plaintext_size);
+        auto ct_result =
+            Encrypt(*streaming_aead, plaintext, associated_data);
+        EXPECT_TRUE(ct_result.ok()) << ct_result.status();
+        std::string ciphertext = ct_result.ValueOrDie();
+        EXPECT_EQ(header_size, static_cast<uint8_t>(ciphertext[0]));
+        auto size_result = streaming_aead->PlaintextSize(ciphertext.size());
+        EXPECT_TRUE(size_result.ok()) << size_result.status();
+        EXPECT_EQ(plaintext_size, size_result.ValueOrDie());
+
+        auto pt_result =
+            Decrypt(*streaming_aead, ciphertext, associated_data);
+        EXPECT_TRUE(pt_result.ok())
+            << pt_result.status() << " plaintext_size: " << plaintext_size
+            << " segment_size: " << segment_size;
+        EXPECT_EQ(plaintext, pt_result.ValueOrDie());
+
+        // Each encryption uses a fresh salt and nonce prefix.
+        EXPECT_NE(ciphertext,
+                  Encrypt(*streaming_aead, plaintext, associated_data)
+                      .ValueOrDie());
+        EXPECT_FALSE(
+            Decrypt(*streaming_aead, ciphertext, "other associated data")
+                .ok());
+      }
+    }
+  }
+}
+
+TEST_F(AesGcmHkdfStreamingTest, testLargeInputInParallel) {
+  auto streaming_aead = NewStreamingAead(16, 4096);
+  std::string plaintext = Random::GetRandomBytes(8 << 20);
+  auto ct_result = Encrypt(*streaming_aead, plaintext, "aad");
+  EXPECT_TRUE(ct_result.ok()) << ct_result.status();
+  std::string ciphertext = ct_result.ValueOrDie();
+  auto pt_result = Decrypt(*streaming_aead, ciphertext, "aad");
+  EXPECT_TRUE(pt_result.ok()) << pt_result.status();
+  EXPECT_TRUE(plaintext == pt_result.ValueOrDie());
+
+  // A modification anywhere is detected.
+  for (size_t position : {ciphertext.size() / 3, ciphertext.size() - 1}) {
+    std::string modified = ciphertext;
+    modified[position] ^= 1;
+    EXPECT_FALSE(Decrypt(*streaming_aead, modified, "aad").ok());
+  }
+}
+
+TEST_F(AesGcmHkdfStreamingTest, testDecryptRange) {
+  auto streaming_aead = NewStreamingAead(16, 256);
+  std::string plaintext = Random::GetRandomBytes(10000);
+  std::string ciphertext =
+      Encrypt(*streaming_aead, plaintext, "aad").ValueOrDie();
+  BufferRandomAccessStream source(ciphertext);
+  for (size_t position : {0, 1, 200, 217, 218, 5000, 9999, 10000}) {
+    for (size_t count : {0, 1, 100, 256, 3000}) {
+      auto result =
+          streaming_aead->DecryptRange(&source, "aad", position, count);
+      if (position + count > plaintext.size()) {
+        EXPECT_FALSE(result.ok());
+        continue;
+      }
+      EXPECT_TRUE(result.ok()) << result.status();
+      EXPECT_EQ(plaintext.substr(position, count), result.ValueOrDie());
+    }
+  }
+  EXPECT_FALSE(streaming_aead->DecryptRange(&source, "bad", 0, 10).ok());
+
+  // A modified segment only affects ranges that include it.
+  std::string modified = ciphertext;
+  modified[5 * 256 + 10] ^= 1;
+  BufferRandomAccessStream modified_source(modified);
+  EXPECT_TRUE(
+      streaming_aead->DecryptRange(&modified_source, "aad", 0, 1000).ok());
+  EXPECT_FALSE(
+      streaming_aead->DecryptRange(&modified_source, "aad", 1200, 10).ok());
+}
+
+TEST_F(AesGcmHkdfStreamingTest, testTruncationAndReordering) {
+  int segment_size = 256;
+  auto streaming_aead = NewStreamingAead(16, segment_size);
+  std::string plaintext = Random::GetRandomBytes(10 * segment_size);
+  std::string ciphertext =
+      Encrypt(*streaming_aead, plaintext, "aad").ValueOrDie();
+
+  // Dropping the last segment(s).
+  for (int segments = 1; segments < 10; segments++) {
+    EXPECT_FALSE(Decrypt(*streaming_aead,
+                         ciphertext.substr(0, segments * segment_size), "aad")
+                     .ok());
+  }
+  // Swapping two segments.
+  std::string swapped = ciphertext;
+  swapped.replace(2 * segment_size, segment_size,
+                  ciphertext.substr(3 * segment_size, segment_size));
+  swapped.replace(3 * segment_size, segment_size,
+                  ciphertext.substr(2 * segment_size, segment_size));
+  EXPECT_FALSE(Decrypt(*streaming_aead, swapped, "aad").ok());
+  // Invalid sizes.
+  EXPECT_FALSE(Decrypt(*streaming_aead, "", "aad").ok());
+  EXPECT_FALSE(Decrypt(*streaming_aead, ciphertext.substr(0, 30), "aad").ok());
+  EXPECT_FALSE(Decrypt(*streaming_aead,
+                       ciphertext.substr(0, 3 * segment_size + 16), "aad")
+                   .ok());
+}
+
+TEST_F(AesGcmHkdfStreamingTest, testFileEncryptDecrypt) {
+  auto streaming_aead = NewStreamingAead(32, 1 << 16);
+  std::string plaintext = Random::GetRandomBytes(3 << 20);
+  FILE* plaintext_file = tmpfile();
+  FILE* ciphertext_file = tmpfile();
+  FILE* decrypted_file = tmpfile();
+  ASSERT_NE(nullptr, plaintext_file);
+  ASSERT_NE(nullptr, ciphertext_file);
+  ASSERT_NE(nullptr, decrypted_file);
+  FileRandomAccessSink plaintext_sink(fileno(plaintext_file));
+  EXPECT_TRUE(plaintext_sink.PWrite(0, plaintext).ok());
+
+  FileRandomAccessStream plaintext_source(fileno(plaintext_file));
+  FileRandomAccessSink ciphertext_sink(fileno(ciphertext_file));
+  auto status =
+      streaming_aead->Encrypt(&plaintext_source, "aad", &ciphertext_sink);
+  EXPECT_TRUE(status.ok()) << status;
+  FileRandomAccessStream ciphertext_source(fileno(ciphertext_file));
+  EXPECT_EQ(streaming_aead->CiphertextSize(plaintext.size()),
+            ciphertext_source.size().ValueOrDie());
+
+  FileRandomAccessSink decrypted_sink(fileno(decrypted_file));
+  status =
+      streaming_aead->Decrypt(&ciphertext_source, "aad", &decrypted_sink);
+  EXPECT_TRUE(status.ok()) << status;
+  FileRandomAccessStream decrypted_source(fileno(decrypted_file));
+  std::string decrypted(decrypted_source.size().ValueOrDie(), 'x');
+  EXPECT_TRUE(
+      decrypted_source.PRead(0, decrypted.size(), &decrypted[0]).ok());
+  EXPECT_TRUE(plaintext == decrypted);
+  EXPECT_FALSE(
+      decrypted_source.PRead(decrypted.size() - 1, 2, &decrypted[0]).ok());
+
+  fclose(plaintext_file);
+  fclose(ciphertext_file);
+  fclose(decrypted_file);
+}
+
+// Checks the ciphertext format against a direct AES-GCM computation.
+TEST_F(AesGcmHkdfStreamingTest, testCiphertextFormat) {
+  auto streaming_aead = NewStreamingAead(16, 4096);
+  std::string plaintext = "some plaintext";
+  std::string associated_data = "some associated data";
+  std::string ciphertext =
+      Encrypt(*streaming_aead, plaintext, associated_data).ValueOrDie();
+  ASSERT_EQ(24 + plaintext.size() + 16, ciphertext.size());
+  std::string salt = ciphertext.substr(1, 16);
+  std::string nonce = ciphertext.substr(17, 7);
+  nonce.append(std::string("\x00\x00\x00\x00\x01", 5));
+  std::string key = Hkdf::ComputeHkdf(HashType::SHA256, ikm_, salt,
+                                      associated_data, 16).ValueOrDie();
+
+  bssl::UniquePtr<EVP_AEAD_CTX> ctx(EVP_AEAD_CTX_new(
+      EVP_aead_aes_128_gcm(), reinterpret_cast<const uint8_t*>(key.data()),
+      key.size(), 16));
+  std::vector<uint8_t> out(plaintext.size() + 16);
+  size_t out_len;
+  ASSERT_EQ(1, EVP_AEAD_CTX_seal(
+                   ctx.get(), out.data(), &out_len, out.size(),
+                   reinterpret_cast<const uint8_t*>(nonce.data()),
+                   nonce.size(),
+                   reinterpret_cast<const uint8_t*>(plaintext.data()),
+                   plaintext.size(), nullptr, 0));
+  EXPECT_EQ(std::string(out.begin(), out.end()), ciphertext.substr(24));
+}
+
+TEST_F(AesGcmHkdfStreamingTest, testInvalidParameters) {
+  EXPECT_FALSE(
+      AesGcmHkdfStreaming::New(ikm_, HashType::SHA256, 24, 4096).ok());
+  EXPECT_FALSE(AesGcmHkdfStreaming::New(ikm_.substr(0, 15), HashType::SHA256,
+                                        16, 4096).ok());
+  EXPECT_FALSE(AesGcmHkdfStreaming::New(ikm_.substr(0, 16), HashType::SHA256,
+                                        32, 4096).ok());
+  EXPECT_FALSE(
+      AesGcmHkdfStreaming::New(ikm_, HashType::UNKNOWN_HASH, 16, 4096).ok());
+  // The first segment must hold at least one byte of plaintext.
+  EXPECT_FALSE(
+      AesGcmHkdfStreaming::New(ikm_, HashType::SHA256, 16, 24 + 16).ok());
+  EXPECT_TRUE(
+      AesGcmHkdfStreaming::New(ikm_, HashType::SHA256, 16, 24 + 17).ok());
+}
+
+}  // namespace
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
+
+int main(int ac, char* av[]) {
+  testing::InitGoogleTest(&ac, av);
+  return RUN_ALL_TESTS();
+}
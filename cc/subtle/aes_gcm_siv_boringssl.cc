@@ -0,0 +1,126 @@
+// Copyright 2018 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/subtle/aes_gcm_siv_boringssl.h"
+
+#include <string>
+
+#include "openssl/aead.h"
+#include "openssl/err.h"
+#include "tink/aead.h"
+#include "tink/subtle/random.h"
+#include "tink/subtle/subtle_util_boringssl.h"
+#include "tink/util/errors.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+
+static const EVP_AEAD* GetAeadForKeySize(uint32_t size_in_bytes) {
+  switch (size_in_bytes) {
+    case 16:
+      return EVP_aead_aes_128_gcm_siv();
+    case 32:
+      return EVP_aead_aes_256_gcm_siv();
+    default:
+      return nullptr;
+  }
+}
+
+// static
+util::StatusOr<std::unique_ptr<Aead>> AesGcmSivBoringSsl::New(
+    absl::string_view key_value) {
+  const EVP_AEAD* aead = GetAeadForKeySize(key_value.size());
+  if (aead == nullptr) {
+    return util::Status(util::error::INVALID_ARGUMENT, "Invalid key size");
+  }
+  bssl::UniquePtr<EVP_AEAD_CTX> ctx(EVP_AEAD_CTX_new(
+      aead, reinterpret_cast<const uint8_t*>(key_value.data()),
+      key_value.size(), TAG_SIZE));
+  if (ctx == nullptr) {
+    return util::Status(util::error::INTERNAL,
+                        "could not initialize EVP_AEAD_CTX");
+  }
+  std::unique_ptr<Aead> gcm_siv(new AesGcmSivBoringSsl(std::move(ctx)));
+  return std::move(gcm_siv);
+}
+
+util::StatusOr<std::string> AesGcmSivBoringSsl::Encrypt(
+    absl::string_view plaintext,
+    absl::string_view additional_data) const {
+  // BoringSSL expects a non-null pointer for plaintext and additional_data,
+  // regardless of whether the size is 0.
+  plaintext = SubtleUtilBoringSSL::EnsureNonNull(plaintext);
+  additional_data = SubtleUtilBoringSSL::EnsureNonNull(additional_data);
+
+  // The nonce and the sealed output are written directly into the result.
+  std::string ciphertext(IV_SIZE + plaintext.size() + TAG_SIZE, '\0');
+  uint8_t* out = reinterpret_cast<uint8_t*>(&ciphertext[0]);
+  const std::string nonce = Random::GetRandomBytes(IV_SIZE);
+  memcpy(out, nonce.data(), IV_SIZE);
+  size_t len = 0;
+  int ret = EVP_AEAD_CTX_seal(
+      ctx_.get(), out + IV_SIZE, &len, ciphertext.size() - IV_SIZE,
+      out, IV_SIZE,
+      reinterpret_cast<const uint8_t*>(plaintext.data()), plaintext.size(),
+      reinterpret_cast<const uint8_t*>(additional_data.data()),
+      additional_data.size());
+  if (ret != 1) {
+    return util::Status(util::error::INTERNAL, "Encryption failed");
+  }
+  if (len != plaintext.size() + TAG_SIZE) {
+    return util::Status(util::error::INTERNAL, "Incorrect ciphertext size");
+  }
+  return std::move(ciphertext);
+}
+
+util::StatusOr<std::string> AesGcmSivBoringSsl::Decrypt(
+    absl::string_view ciphertext,
+    absl::string_view additional_data) const {
+  // BoringSSL expects a non-null pointer for additional_data,
+  // regardless of whether the size is 0.
+  additional_data = SubtleUtilBoringSSL::EnsureNonNull(additional_data);
+
+  if (ciphertext.size() < IV_SIZE + TAG_SIZE) {
+    return util::Status(util::error::INVALID_ARGUMENT, "Ciphertext too short");
+  }
+  const uint8_t* in = reinterpret_cast<const uint8_t*>(ciphertext.data());
+  std::string plaintext(ciphertext.size() - IV_SIZE - TAG_SIZE, '\0');
+  // Allocates 1 byte more than necessary so that the output pointer is
+  // valid even if the plaintext is empty.
+  plaintext.reserve(plaintext.size() + 1);
+  size_t len = 0;
+  int ret = EVP_AEAD_CTX_open(
+      ctx_.get(), reinterpret_cast<uint8_t*>(&plaintext[0]), &len,
+      plaintext.size(), in, IV_SIZE, in + IV_SIZE, ciphertext.size() - IV_SIZE,
+      reinterpret_cast<const uint8_t*>(additional_data.data()),
+      additional_data.size());
+  if (ret != 1) {
+    // Clears BoringSSL's error queue, the failure is reported to the caller.
+    ERR_clear_error();
+    return util::Status(util::error::INVALID_ARGUMENT, "Authentication failed");
+  }
+  if (len != plaintext.size()) {
+    return util::Status(util::error::INTERNAL, "Incorrect plaintext size");
+  }
+  return std::move(plaintext);
+}
+
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
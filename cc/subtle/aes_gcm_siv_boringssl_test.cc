@@ -0,0 +1,167 @@
+// Copyright 2018 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/subtle/aes_gcm_siv_boringssl.h"
+
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "absl/strings/str_cat.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "tink/util/test_util.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+namespace {
+
+TEST(AesGcmSivBoringSslTest, testBasic) {
+  std::string key(test::HexDecodeOrDie("000102030405060708090a0b0c0d0e0f"));
+  auto res = AesGcmSivBoringSsl::New(key);
+  EXPECT_TRUE(res.ok()) << res.status();
+  auto cipher = std::move(res.ValueOrDie());
+  std::string message = "Some data to encrypt.";
+  std::string aad = "Some data to authenticate.";
+  auto ct = cipher->Encrypt(message, aad);
+  EXPECT_TRUE(ct.ok()) << ct.status();
+  EXPECT_EQ(ct.ValueOrDie().size(),
+            message.size() + 12 /* nonce */ + 16 /* tag */);
+  auto pt = cipher->Decrypt(ct.ValueOrDie(), aad);
+  EXPECT_TRUE(pt.ok()) << pt.status();
+  EXPECT_EQ(pt.ValueOrDie(), message);
+}
+
+TEST(AesGcmSivBoringSslTest, testMessageSizes) {
+  for (int key_size : {16, 32}) {
+    std::string key(key_size, 'k');
+    auto cipher = std::move(AesGcmSivBoringSsl::New(key).ValueOrDie());
+    std::string aad = "Some data to authenticate.";
+    // The same cipher is used for all messages, which exercises the
+    // EVP_AEAD_CTX shared between calls.
+    for (size_t size = 0; size < 100; size++) {
+      std::string message(size, 'a' + size % 26);
+      auto ct = cipher->Encrypt(message, aad);
+      EXPECT_TRUE(ct.ok()) << ct.status();
+      EXPECT_EQ(ct.ValueOrDie().size(), size + 12 + 16);
+      auto pt = cipher->Decrypt(ct.ValueOrDie(), aad);
+      EXPECT_TRUE(pt.ok()) << pt.status();
+      EXPECT_EQ(pt.ValueOrDie(), message);
+    }
+  }
+}
+
+TEST(AesGcmSivBoringSslTest, testRandomNonce) {
+  std::string key(test::HexDecodeOrDie("000102030405060708090a0b0c0d0e0f"));
+  auto cipher = std::move(AesGcmSivBoringSsl::New(key).ValueOrDie());
+  std::string message = "Some data to encrypt.";
+  std::string aad = "Some data to authenticate.";
+  std::string ct1 = cipher->Encrypt(message, aad).ValueOrDie();
+  std::string ct2 = cipher->Encrypt(message, aad).ValueOrDie();
+  EXPECT_NE(ct1, ct2);
+}
+
+TEST(AesGcmSivBoringSslTest, testModification) {
+  std::string key(test::HexDecodeOrDie(
+      "000102030405060708090a0b0c0d0e0f000102030405060708090a0b0c0d0e0f"));
+  auto cipher = std::move(AesGcmSivBoringSsl::New(key).ValueOrDie());
+  std::string message = "Some data to encrypt.";
+  std::string aad = "Some data to authenticate.";
+  std::string ct = cipher->Encrypt(message, aad).ValueOrDie();
+  EXPECT_TRUE(cipher->Decrypt(ct, aad).ok());
+  // Modify the ciphertext
+  for (size_t i = 0; i < ct.size() * 8; i++) {
+    std::string modified_ct = ct;
+    modified_ct[i / 8] ^= 1 << (i % 8);
+    EXPECT_FALSE(cipher->Decrypt(modified_ct, aad).ok()) << i;
+  }
+  // Modify the additional data
+  for (size_t i = 0; i < aad.size() * 8; i++) {
+    std::string modified_aad = aad;
+    modified_aad[i / 8] ^= 1 << (i % 8);
+    EXPECT_FALSE(cipher->Decrypt(ct, modified_aad).ok()) << i;
+  }
+  // Truncate the ciphertext
+  for (size_t i = 0; i < ct.size(); i++) {
+    std::string truncated_ct(ct, 0, i);
+    EXPECT_FALSE(cipher->Decrypt(truncated_ct, aad).ok()) << i;
+  }
+}
+
+TEST(AesGcmSivBoringSslTest, testEmptyMessageAndAad) {
+  std::string key(test::HexDecodeOrDie("000102030405060708090a0b0c0d0e0f"));
+  auto cipher = std::move(AesGcmSivBoringSsl::New(key).ValueOrDie());
+  auto ct = cipher->Encrypt(nullptr, nullptr);
+  EXPECT_TRUE(ct.ok()) << ct.status();
+  auto pt = cipher->Decrypt(ct.ValueOrDie(), absl::string_view());
+  EXPECT_TRUE(pt.ok()) << pt.status();
+  EXPECT_EQ("", pt.ValueOrDie());
+}
+
+struct TestVector {
+  std::string key;
+  std::string nonce;
+  std::string plaintext;
+  std::string ciphertext;  // ct || tag
+};
+
+// Test vectors from https://tools.ietf.org/html/rfc8452#appendix-C.
+static const std::vector<TestVector> test_vectors({
+    {"01000000000000000000000000000000", "030000000000000000000000", "",
+     "dc20e2d83f25705bb49e439eca56de25"},
+    {"01000000000000000000000000000000", "030000000000000000000000",
+     "0100000000000000",
+     "b5d839330ac7b786578782fff6013b815b287c22493a364c"},
+    {"0100000000000000000000000000000000000000000000000000000000000000",
+     "030000000000000000000000", "", "07f5f4169bbf55a8400cd47ea6fd400f"},
+    {"0100000000000000000000000000000000000000000000000000000000000000",
+     "030000000000000000000000", "0100000000000000",
+     "c2ef328e5c71c83b843122130f7364b761e0b97427e3df28"},
+});
+
+TEST(AesGcmSivBoringSslTest, testVectors) {
+  for (const auto& v : test_vectors) {
+    auto cipher =
+        std::move(AesGcmSivBoringSsl::New(test::HexDecodeOrDie(v.key))
+                      .ValueOrDie());
+    std::string ct = test::HexDecodeOrDie(absl::StrCat(v.nonce, v.ciphertext));
+    auto pt = cipher->Decrypt(ct, "");
+    EXPECT_TRUE(pt.ok()) << pt.status();
+    EXPECT_EQ(test::HexEncode(pt.ValueOrDie()), v.plaintext);
+  }
+}
+
+TEST(AesGcmSivBoringSslTest, testInvalidKeySizes) {
+  for (int keysize = 0; keysize < 65; keysize++) {
+    if (keysize == 16 || keysize == 32) {
+      continue;
+    }
+    std::string key(keysize, 'x');
+    auto cipher = AesGcmSivBoringSsl::New(key);
+    EXPECT_FALSE(cipher.ok());
+  }
+}
+
+}  // namespace
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
+
+int main(int ac, char* av[]) {
+  testing::InitGoogleTest(&ac, av);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,269 @@
+// Copyright 2018 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/subtle/aes_siv_boringssl.h"
+
+#include <algorithm>
+#include <string>
+
+#include "openssl/aes.h"
+#include "openssl/mem.h"
+#include "tink/deterministic_aead.h"
+#include "tink/subtle/subtle_util_boringssl.h"
+#include "tink/util/errors.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+
+static const int BLOCK_SIZE = 16;
+
+namespace {
+
+uint64_t Load64(const uint8_t src[8]) {
+  uint64_t res;
+  memmove(&res, src, 8);
+  return res;
+}
+
+void Store64(uint8_t dst[8], uint64_t val) {
+  memmove(dst, &val, 8);
+}
+
+uint64_t BigEndianLoad64(const uint8_t src[8]) {
+  return static_cast<uint64_t>(src[7])
+      | (static_cast<uint64_t>(src[6]) << 8)
+      | (static_cast<uint64_t>(src[5]) << 16)
+      | (static_cast<uint64_t>(src[4]) << 24)
+      | (static_cast<uint64_t>(src[3]) << 32)
+      | (static_cast<uint64_t>(src[2]) << 40)
+      | (static_cast<uint64_t>(src[1]) << 48)
+      | (static_cast<uint64_t>(src[0]) << 56);
+}
+
+void BigEndianStore64(uint8_t dst[8], uint64_t val) {
+  dst[0] = (val >> 56) & 0xff;
+  dst[1] = (val >> 48) & 0xff;
+  dst[2] = (val >> 40) & 0xff;
+  dst[3] = (val >> 32) & 0xff;
+  dst[4] = (val >> 24) & 0xff;
+  dst[5] = (val >> 16) & 0xff;
+  dst[6] = (val >> 8) & 0xff;
+  dst[7] = val & 0xff;
+}
+
+void XorBlock(const uint8_t x[BLOCK_SIZE],
+              const uint8_t y[BLOCK_SIZE],
+              uint8_t res[BLOCK_SIZE]) {
+  uint64_t r0 = Load64(x) ^ Load64(y);
+  uint64_t r1 = Load64(x + 8) ^ Load64(y + 8);
+  Store64(res, r0);
+  Store64(res + 8, r1);
+}
+
+// Doubling in GF(2^128), called dbl() in RFC 5297.
+void MultiplyByX(const uint8_t in[BLOCK_SIZE],
+                 uint8_t out[BLOCK_SIZE]) {
+  uint64_t in_high = BigEndianLoad64(in);
+  uint64_t in_low = BigEndianLoad64(in + 8);
+  uint64_t out_high = (in_high << 1) ^ (in_low >> 63);
+  // If the most significant bit is set then the result has to
+  // be reduced by x^128 + x^7 + x^4 + x^2 + x + 1.
+  // The representation of x^7 + x^4 + x^2 + x + 1 is 0x87.
+  uint64_t out_low = (in_low << 1) ^ (in_high >> 63 ? 0x87 : 0);
+  BigEndianStore64(out, out_high);
+  BigEndianStore64(out + 8, out_low);
+}
+
+bool EqualBlocks(const uint8_t x[BLOCK_SIZE],
+                 const uint8_t y[BLOCK_SIZE]) {
+  uint64_t res = Load64(x) ^ Load64(y);
+  res |= Load64(x + 8) ^ Load64(y + 8);
+  return res == 0;
+}
+
+}  // namespace
+
+bool AesSivBoringSsl::IsValidKeySize(size_t key_size_in_bytes) {
+  return key_size_in_bytes == 32 ||
+         key_size_in_bytes == 64;
+}
+
+AesSivBoringSsl::AesSivBoringSsl(absl::string_view key_value) {
+  const uint8_t* key = reinterpret_cast<const uint8_t*>(key_value.data());
+  const unsigned half_key_bits = key_value.size() * 4;
+  // A non-zero status indicates a programming error, e.g. an invalid size.
+  if (AES_set_encrypt_key(key, half_key_bits, &cmac_key_) != 0 ||
+      AES_set_encrypt_key(key + key_value.size() / 2, half_key_bits,
+                          &ctr_key_) != 0) {
+    is_initialized_ = false;
+    return;
+  }
+  uint8_t block[BLOCK_SIZE];
+  memset(block, 0, BLOCK_SIZE);
+  AES_encrypt(block, block, &cmac_key_);
+  MultiplyByX(block, cmac_k1_);
+  MultiplyByX(cmac_k1_, cmac_k2_);
+  memset(block, 0, BLOCK_SIZE);
+  Cmac(block, BLOCK_SIZE, nullptr, cmac_zero_);
+  is_initialized_ = true;
+}
+
+AesSivBoringSsl::~AesSivBoringSsl() {
+  OPENSSL_cleanse(&cmac_key_, sizeof(cmac_key_));
+  OPENSSL_cleanse(&ctr_key_, sizeof(ctr_key_));
+  OPENSSL_cleanse(cmac_k1_, BLOCK_SIZE);
+  OPENSSL_cleanse(cmac_k2_, BLOCK_SIZE);
+  OPENSSL_cleanse(cmac_zero_, BLOCK_SIZE);
+}
+
+// static
+util::StatusOr<std::unique_ptr<DeterministicAead>> AesSivBoringSsl::New(
+    absl::string_view key_value) {
+  if (!IsValidKeySize(key_value.size())) {
+    return util::Status(util::error::INVALID_ARGUMENT, "Invalid key size");
+  }
+  std::unique_ptr<AesSivBoringSsl> daead(new AesSivBoringSsl(key_value));
+  if (!daead->is_initialized_) {
+    return util::Status(util::error::INTERNAL,
+                        "Could not initialize AesSivBoringSsl");
+  }
+  return std::unique_ptr<DeterministicAead>(daead.release());
+}
+
+void AesSivBoringSsl::Cmac(const uint8_t* data, size_t len,
+                           const uint8_t* xorend,
+                           uint8_t mac[BLOCK_SIZE]) const {
+  // xorend covers data[xorend_start..len).
+  const size_t xorend_start = len - BLOCK_SIZE;
+  uint8_t state[BLOCK_SIZE];
+  memset(state, 0, BLOCK_SIZE);
+  uint8_t block[BLOCK_SIZE];
+  size_t idx = 0;
+  while (len - idx > BLOCK_SIZE) {
+    if (xorend != nullptr && idx + BLOCK_SIZE > xorend_start) {
+      memcpy(block, &data[idx], BLOCK_SIZE);
+      for (size_t i = xorend_start; i < idx + BLOCK_SIZE; i++) {
+        block[i - idx] ^= xorend[i - xorend_start];
+      }
+      XorBlock(state, block, state);
+    } else {
+      XorBlock(state, &data[idx], state);
+    }
+    AES_encrypt(state, state, &cmac_key_);
+    idx += BLOCK_SIZE;
+  }
+  // The final block, complete iff it has BLOCK_SIZE bytes.
+  size_t rest = len - idx;
+  memset(block, 0, BLOCK_SIZE);
+  if (rest > 0) memcpy(block, &data[idx], rest);
+  if (xorend != nullptr) {
+    for (size_t i = std::max(idx, xorend_start); i < len; i++) {
+      block[i - idx] ^= xorend[i - xorend_start];
+    }
+  }
+  if (rest == BLOCK_SIZE) {
+    XorBlock(block, cmac_k1_, block);
+  } else {
+    block[rest] = 0x80;
+    XorBlock(block, cmac_k2_, block);
+  }
+  XorBlock(state, block, state);
+  AES_encrypt(state, mac, &cmac_key_);
+}
+
+void AesSivBoringSsl::S2v(absl::string_view additional_data,
+                          absl::string_view plaintext,
+                          uint8_t siv[BLOCK_SIZE]) const {
+  uint8_t d[BLOCK_SIZE];
+  uint8_t mac[BLOCK_SIZE];
+  MultiplyByX(cmac_zero_, d);
+  Cmac(reinterpret_cast<const uint8_t*>(additional_data.data()),
+       additional_data.size(), nullptr, mac);
+  XorBlock(d, mac, d);
+  const uint8_t* pt = reinterpret_cast<const uint8_t*>(plaintext.data());
+  if (plaintext.size() >= BLOCK_SIZE) {
+    Cmac(pt, plaintext.size(), d, siv);
+    return;
+  }
+  uint8_t block[BLOCK_SIZE];
+  memset(block, 0, BLOCK_SIZE);
+  if (!plaintext.empty()) memcpy(block, pt, plaintext.size());
+  block[plaintext.size()] = 0x80;
+  MultiplyByX(d, d);
+  XorBlock(d, block, block);
+  Cmac(block, BLOCK_SIZE, nullptr, siv);
+}
+
+void AesSivBoringSsl::CtrCrypt(const uint8_t siv[BLOCK_SIZE],
+                               const uint8_t* in, uint8_t* result,
+                               size_t size) const {
+  // This special case is necessary to avoid problems when in == null.
+  if (size == 0) {
+    return;
+  }
+  uint8_t ctr[BLOCK_SIZE];
+  memcpy(ctr, siv, BLOCK_SIZE);
+  // Clears the 31st and 63rd bit (counting from the right), so that
+  // implementations using 32 or 64 bit counters can be interoperable.
+  ctr[8] &= 0x7f;
+  ctr[12] &= 0x7f;
+  unsigned int num = 0;
+  uint8_t ecount_buf[BLOCK_SIZE];
+  memset(ecount_buf, 0, BLOCK_SIZE);
+  AES_ctr128_encrypt(in, result, size, &ctr_key_, ctr, ecount_buf, &num);
+}
+
+util::StatusOr<std::string> AesSivBoringSsl::EncryptDeterministically(
+    absl::string_view plaintext,
+    absl::string_view additional_data) const {
+  plaintext = SubtleUtilBoringSSL::EnsureNonNull(plaintext);
+  additional_data = SubtleUtilBoringSSL::EnsureNonNull(additional_data);
+
+  std::string ciphertext(BLOCK_SIZE + plaintext.size(), '\0');
+  uint8_t* out = reinterpret_cast<uint8_t*>(&ciphertext[0]);
+  S2v(additional_data, plaintext, out);
+  CtrCrypt(out, reinterpret_cast<const uint8_t*>(plaintext.data()),
+           out + BLOCK_SIZE, plaintext.size());
+  return std::move(ciphertext);
+}
+
+util::StatusOr<std::string> AesSivBoringSsl::DecryptDeterministically(
+    absl::string_view ciphertext,
+    absl::string_view additional_data) const {
+  additional_data = SubtleUtilBoringSSL::EnsureNonNull(additional_data);
+
+  if (ciphertext.size() < BLOCK_SIZE) {
+    return util::Status(util::error::INVALID_ARGUMENT, "Ciphertext too short");
+  }
+  const uint8_t* siv = reinterpret_cast<const uint8_t*>(ciphertext.data());
+  std::string plaintext(ciphertext.size() - BLOCK_SIZE, '\0');
+  CtrCrypt(siv, siv + BLOCK_SIZE, reinterpret_cast<uint8_t*>(&plaintext[0]),
+           plaintext.size());
+  uint8_t expected_siv[BLOCK_SIZE];
+  S2v(additional_data, plaintext, expected_siv);
+  if (!EqualBlocks(siv, expected_siv)) {
+    OPENSSL_cleanse(&plaintext[0], plaintext.size());
+    return util::Status(util::error::INVALID_ARGUMENT, "Tag mismatch");
+  }
+  return std::move(plaintext);
+}
+
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,96 @@
+// Copyright 2018 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_SUBTLE_AES_SIV_BORINGSSL_H_
+#define TINK_SUBTLE_AES_SIV_BORINGSSL_H_
+
+#include <memory>
+
+#include "absl/strings/string_view.h"
+#include "tink/deterministic_aead.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "openssl/aes.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+
+// AES-SIV as defined in https://tools.ietf.org/html/rfc5297, restricted to
+// a single component of associated data.
+// The first half of the key is used by S2V (i.e. AES-CMAC), the second half
+// by AES-CTR. The ciphertext is the 16 byte synthetic IV followed by the
+// encrypted plaintext.
+//
+// Both AES key schedules and the CMAC subkeys are computed once by New(), so
+// that the per-message cost is only the block cipher calls themselves.
+class AesSivBoringSsl : public DeterministicAead {
+ public:
+  // Currently supported key sizes are 256 and 512 bits,
+  // i.e. AES-128-SIV and AES-256-SIV.
+  static crypto::tink::util::StatusOr<std::unique_ptr<DeterministicAead>> New(
+      absl::string_view key_value);
+
+  crypto::tink::util::StatusOr<std::string> EncryptDeterministically(
+      absl::string_view plaintext,
+      absl::string_view additional_data) const override;
+
+  crypto::tink::util::StatusOr<std::string> DecryptDeterministically(
+      absl::string_view ciphertext,
+      absl::string_view additional_data) const override;
+
+  virtual ~AesSivBoringSsl();
+
+ private:
+  static const int BLOCK_SIZE = 16;
+
+  AesSivBoringSsl() = delete;
+  explicit AesSivBoringSsl(absl::string_view key_value);
+
+  // Returns whether key_size_in_bytes is a supported key size.
+  static bool IsValidKeySize(size_t key_size_in_bytes);
+
+  // Computes the AES-CMAC of data, where the last BLOCK_SIZE bytes of data
+  // are first xored with xorend if xorend is not null. In the latter case
+  // len must be at least BLOCK_SIZE.
+  void Cmac(const uint8_t* data, size_t len, const uint8_t* xorend,
+            uint8_t mac[BLOCK_SIZE]) const;
+
+  // Computes the synthetic IV S2V(additional_data, plaintext).
+  void S2v(absl::string_view additional_data, absl::string_view plaintext,
+           uint8_t siv[BLOCK_SIZE]) const;
+
+  // Encrypts or decrypts size bytes of in with AES-CTR, using siv
+  // as initial counter block after clearing the bits required by RFC 5297.
+  void CtrCrypt(const uint8_t siv[BLOCK_SIZE], const uint8_t* in,
+                uint8_t* result, size_t size) const;
+
+  AES_KEY cmac_key_;
+  AES_KEY ctr_key_;
+  // The CMAC subkeys K1 and K2 of RFC 4493.
+  uint8_t cmac_k1_[BLOCK_SIZE];
+  uint8_t cmac_k2_[BLOCK_SIZE];
+  // AES-CMAC of the all zero block, the first step of every S2V.
+  uint8_t cmac_zero_[BLOCK_SIZE];
+  // Set by the constructor to true if the initialization was successful.
+  bool is_initialized_;
+};
+
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_SUBTLE_AES_SIV_BORINGSSL_H_
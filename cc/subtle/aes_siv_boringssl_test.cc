@@ -0,0 +1,162 @@
+// Copyright 2018 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/subtle/aes_siv_boringssl.h"
+
+#include <string>
+
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "tink/util/test_util.h"
+#include "gtest/gtest.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+namespace {
+
+TEST(AesSivBoringSslTest, testRfc5297TestVector) {
+  // https://tools.ietf.org/html/rfc5297#appendix-A.1
+  std::string key(test::HexDecodeOrDie(
+      "fffefdfcfbfaf9f8f7f6f5f4f3f2f1f0"
+      "f0f1f2f3f4f5f6f7f8f9fafbfcfdfeff"));
+  std::string aad(test::HexDecodeOrDie(
+      "101112131415161718191a1b1c1d1e1f2021222324252627"));
+  std::string message(test::HexDecodeOrDie("112233445566778899aabbccddee"));
+  std::string expected(test::HexDecodeOrDie(
+      "85632d07c6e8f37f950acd320a2ecc93"
+      "40c02b9690c4dc04daef7f6afe5c"));
+  auto res = AesSivBoringSsl::New(key);
+  EXPECT_TRUE(res.ok()) << res.status();
+  auto cipher = std::move(res.ValueOrDie());
+  auto ct = cipher->EncryptDeterministically(message, aad);
+  EXPECT_TRUE(ct.ok()) << ct.status();
+  EXPECT_EQ(test::HexEncode(expected), test::HexEncode(ct.ValueOrDie()));
+  auto pt = cipher->DecryptDeterministically(expected, aad);
+  EXPECT_TRUE(pt.ok()) << pt.status();
+  EXPECT_EQ(message, pt.ValueOrDie());
+}
+
+TEST(AesSivBoringSslTest, testAes256SivTestVector) {
+  std::string key(test::HexDecodeOrDie(
+      "000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f"
+      "202122232425262728292a2b2c2d2e2f303132333435363738393a3b3c3d3e3f"));
+  std::string aad = "additional data";
+  std::string message = "Some data to encrypt deterministically.";
+  std::string expected(test::HexDecodeOrDie(
+      "15de06798d41793517017098a5e5e046"
+      "c5abb98549db1eb4441c3361a11eec9cec6d871a4f9eded5"
+      "2262766d01f62553c4f2fe40af414e"));
+  auto cipher = std::move(AesSivBoringSsl::New(key).ValueOrDie());
+  auto ct = cipher->EncryptDeterministically(message, aad);
+  EXPECT_TRUE(ct.ok()) << ct.status();
+  EXPECT_EQ(test::HexEncode(expected), test::HexEncode(ct.ValueOrDie()));
+}
+
+TEST(AesSivBoringSslTest, testMessageSize) {
+  std::string key(test::HexDecodeOrDie(
+      "000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f"
+      "202122232425262728292a2b2c2d2e2f303132333435363738393a3b3c3d3e3f"));
+  auto cipher = std::move(AesSivBoringSsl::New(key).ValueOrDie());
+  for (size_t size = 0; size < 260; size++) {
+    std::string message(size, 'x');
+    std::string aad = "Some data to authenticate.";
+    auto ct = cipher->EncryptDeterministically(message, aad);
+    EXPECT_TRUE(ct.ok()) << ct.status();
+    EXPECT_EQ(ct.ValueOrDie().size(), message.size() + 16);
+    auto pt = cipher->DecryptDeterministically(ct.ValueOrDie(), aad);
+    EXPECT_TRUE(pt.ok()) << pt.status();
+    EXPECT_EQ(pt.ValueOrDie(), message);
+  }
+}
+
+TEST(AesSivBoringSslTest, testAadSize) {
+  std::string key(test::HexDecodeOrDie(
+      "000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f"
+      "202122232425262728292a2b2c2d2e2f303132333435363738393a3b3c3d3e3f"));
+  auto cipher = std::move(AesSivBoringSsl::New(key).ValueOrDie());
+  for (size_t size = 0; size < 100; size++) {
+    std::string message = "Some message";
+    std::string aad(size, 'x');
+    auto ct = cipher->EncryptDeterministically(message, aad);
+    EXPECT_TRUE(ct.ok()) << ct.status();
+    auto pt = cipher->DecryptDeterministically(ct.ValueOrDie(), aad);
+    EXPECT_TRUE(pt.ok()) << pt.status();
+    EXPECT_EQ(pt.ValueOrDie(), message);
+  }
+}
+
+TEST(AesSivBoringSslTest, testDeterminism) {
+  std::string key(64, 'k');
+  auto cipher = std::move(AesSivBoringSsl::New(key).ValueOrDie());
+  std::string message = "Some data to encrypt.";
+  std::string aad = "Some data to authenticate.";
+  std::string ct = cipher->EncryptDeterministically(message, aad).ValueOrDie();
+  EXPECT_EQ(ct, cipher->EncryptDeterministically(message, aad).ValueOrDie());
+  EXPECT_NE(ct, cipher->EncryptDeterministically(message, "").ValueOrDie());
+  EXPECT_NE(ct, cipher->EncryptDeterministically("Some other data.", aad)
+                    .ValueOrDie());
+}
+
+TEST(AesSivBoringSslTest, testModification) {
+  std::string key(64, 'k');
+  auto cipher = std::move(AesSivBoringSsl::New(key).ValueOrDie());
+  std::string message = "Some data to encrypt.";
+  std::string aad = "Some data to authenticate.";
+  std::string ct = cipher->EncryptDeterministically(message, aad).ValueOrDie();
+  EXPECT_TRUE(cipher->DecryptDeterministically(ct, aad).ok());
+  // Modify the ciphertext
+  for (size_t i = 0; i < ct.size() * 8; i++) {
+    std::string modified_ct = ct;
+    modified_ct[i / 8] ^= 1 << (i % 8);
+    EXPECT_FALSE(cipher->DecryptDeterministically(modified_ct, aad).ok()) << i;
+  }
+  // Modify the additional data
+  for (size_t i = 0; i < aad.size() * 8; i++) {
+    std::string modified_aad = aad;
+    modified_aad[i / 8] ^= 1 << (i % 8);
+    auto decrypted = cipher->DecryptDeterministically(ct, modified_aad);
+    EXPECT_FALSE(decrypted.ok()) << i << " pt:" << decrypted.ValueOrDie();
+  }
+  // Truncate the ciphertext
+  for (size_t i = 0; i < ct.size(); i++) {
+    std::string truncated_ct(ct, 0, i);
+    EXPECT_FALSE(cipher->DecryptDeterministically(truncated_ct, aad).ok())
+        << i;
+  }
+}
+
+TEST(AesSivBoringSslTest, testInvalidKeySizes) {
+  for (int keysize = 0; keysize < 65; keysize++) {
+    std::string key(keysize, 'x');
+    auto cipher = AesSivBoringSsl::New(key);
+    if (keysize == 32 || keysize == 64) {
+      EXPECT_TRUE(cipher.ok());
+    } else {
+      EXPECT_FALSE(cipher.ok()) << "Accepted invalid key size:" << keysize;
+    }
+  }
+}
+
+}  // namespace
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
+
+int main(int ac, char* av[]) {
+  testing::InitGoogleTest(&ac, av);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,76 @@
+// Copyright 2018 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_SUBTLE_CHACHA20_POLY1305_BORINGSSL_H_
+#define TINK_SUBTLE_CHACHA20_POLY1305_BORINGSSL_H_
+
+#include <memory>
+#include <string>
+
+#include "absl/strings/string_view.h"
+#include "openssl/aead.h"
+#include "openssl/base.h"
+#include "tink/aead.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+
+// ChaCha20-Poly1305 as defined in https://tools.ietf.org/html/rfc7539,
+// with random 96-bit nonces. The ciphertext is nonce || ct || tag, which
+// is compatible with the Java class ChaCha20Poly1305.
+//
+// ChaCha20 needs no special instructions, so on CPUs without AES hardware
+// support it is several times faster than AES-GCM.
+//
+// The EVP_AEAD_CTX is set up once by New() and shared by all calls, which
+// are safe to make concurrently.
+class ChaCha20Poly1305BoringSsl : public Aead {
+ public:
+  // The key must be 256 bits.
+  static crypto::tink::util::StatusOr<std::unique_ptr<Aead>> New(
+      absl::string_view key_value);
+
+  crypto::tink::util::StatusOr<std::string> Encrypt(
+      absl::string_view plaintext,
+      absl::string_view additional_data) const override;
+
+  crypto::tink::util::StatusOr<std::string> Decrypt(
+      absl::string_view ciphertext,
+      absl::string_view additional_data) const override;
+
+  virtual ~ChaCha20Poly1305BoringSsl() {}
+
+ private:
+  // The following constants are in bytes.
+  static const int KEY_SIZE = 32;
+  static const int IV_SIZE = 12;
+  static const int TAG_SIZE = 16;
+
+  ChaCha20Poly1305BoringSsl() = delete;
+  explicit ChaCha20Poly1305BoringSsl(bssl::UniquePtr<EVP_AEAD_CTX> ctx)
+      : ctx_(std::move(ctx)) {}
+
+  const bssl::UniquePtr<EVP_AEAD_CTX> ctx_;
+};
+
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_SUBTLE_CHACHA20_POLY1305_BORINGSSL_H_
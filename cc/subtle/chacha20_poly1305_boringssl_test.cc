@@ -0,0 +1,156 @@
+// Copyright 2018 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/subtle/chacha20_poly1305_boringssl.h"
+
+#include <string>
+
+#include "gtest/gtest.h"
+#include "absl/strings/str_cat.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "tink/util/test_util.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+namespace {
+
+const char kKey256Hex[] =
+    "000102030405060708090a0b0c0d0e0f000102030405060708090a0b0c0d0e0f";
+
+TEST(ChaCha20Poly1305BoringSslTest, testBasic) {
+  std::string key(test::HexDecodeOrDie(kKey256Hex));
+  auto res = ChaCha20Poly1305BoringSsl::New(key);
+  EXPECT_TRUE(res.ok()) << res.status();
+  auto cipher = std::move(res.ValueOrDie());
+  std::string message = "Some data to encrypt.";
+  std::string aad = "Some data to authenticate.";
+  auto ct = cipher->Encrypt(message, aad);
+  EXPECT_TRUE(ct.ok()) << ct.status();
+  EXPECT_EQ(ct.ValueOrDie().size(),
+            message.size() + 12 /* nonce */ + 16 /* tag */);
+  auto pt = cipher->Decrypt(ct.ValueOrDie(), aad);
+  EXPECT_TRUE(pt.ok()) << pt.status();
+  EXPECT_EQ(pt.ValueOrDie(), message);
+}
+
+TEST(ChaCha20Poly1305BoringSslTest, testMessageSizes) {
+  std::string key(32, 'k');
+  auto cipher = std::move(ChaCha20Poly1305BoringSsl::New(key).ValueOrDie());
+  std::string aad = "Some data to authenticate.";
+  // The same cipher is used for all messages, which exercises the
+  // EVP_AEAD_CTX shared between calls.
+  for (size_t size = 0; size < 300; size++) {
+    std::string message(size, 'a' + size % 26);
+    auto ct = cipher->Encrypt(message, aad);
+    EXPECT_TRUE(ct.ok()) << ct.status();
+    EXPECT_EQ(ct.ValueOrDie().size(), size + 12 + 16);
+    auto pt = cipher->Decrypt(ct.ValueOrDie(), aad);
+    EXPECT_TRUE(pt.ok()) << pt.status();
+    EXPECT_EQ(pt.ValueOrDie(), message);
+  }
+}
+
+TEST(ChaCha20Poly1305BoringSslTest, testRandomNonce) {
+  std::string key(test::HexDecodeOrDie(kKey256Hex));
+  auto cipher = std::move(ChaCha20Poly1305BoringSsl::New(key).ValueOrDie());
+  std::string message = "Some data to encrypt.";
+  std::string aad = "Some data to authenticate.";
+  std::string ct1 = cipher->Encrypt(message, aad).ValueOrDie();
+  std::string ct2 = cipher->Encrypt(message, aad).ValueOrDie();
+  EXPECT_NE(ct1, ct2);
+}
+
+TEST(ChaCha20Poly1305BoringSslTest, testModification) {
+  std::string key(test::HexDecodeOrDie(kKey256Hex));
+  auto cipher = std::move(ChaCha20Poly1305BoringSsl::New(key).ValueOrDie());
+  std::string message = "Some data to encrypt.";
+  std::string aad = "Some data to authenticate.";
+  std::string ct = cipher->Encrypt(message, aad).ValueOrDie();
+  EXPECT_TRUE(cipher->Decrypt(ct, aad).ok());
+  // Modify the ciphertext
+  for (size_t i = 0; i < ct.size() * 8; i++) {
+    std::string modified_ct = ct;
+    modified_ct[i / 8] ^= 1 << (i % 8);
+    EXPECT_FALSE(cipher->Decrypt(modified_ct, aad).ok()) << i;
+  }
+  // Modify the additional data
+  for (size_t i = 0; i < aad.size() * 8; i++) {
+    std::string modified_aad = aad;
+    modified_aad[i / 8] ^= 1 << (i % 8);
+    EXPECT_FALSE(cipher->Decrypt(ct, modified_aad).ok()) << i;
+  }
+  // Truncate the ciphertext
+  for (size_t i = 0; i < ct.size(); i++) {
+    std::string truncated_ct(ct, 0, i);
+    EXPECT_FALSE(cipher->Decrypt(truncated_ct, aad).ok()) << i;
+  }
+}
+
+TEST(ChaCha20Poly1305BoringSslTest, testEmptyMessageAndAad) {
+  std::string key(test::HexDecodeOrDie(kKey256Hex));
+  auto cipher = std::move(ChaCha20Poly1305BoringSsl::New(key).ValueOrDie());
+  auto ct = cipher->Encrypt(nullptr, nullptr);
+  EXPECT_TRUE(ct.ok()) << ct.status();
+  auto pt = cipher->Decrypt(ct.ValueOrDie(), absl::string_view());
+  EXPECT_TRUE(pt.ok()) << pt.status();
+  EXPECT_EQ("", pt.ValueOrDie());
+}
+
+// Test vector from https://tools.ietf.org/html/rfc7539#section-2.8.2.
+TEST(ChaCha20Poly1305BoringSslTest, testVector) {
+  std::string key = test::HexDecodeOrDie(
+      "808182838485868788898a8b8c8d8e8f909192939495969798999a9b9c9d9e9f");
+  std::string nonce = "070000004041424344454647";
+  std::string aad = test::HexDecodeOrDie("50515253c0c1c2c3c4c5c6c7");
+  std::string plaintext =
+      "Ladies and Gentlemen of the class of '99: If I could offer you only "
+      "one tip for the future, sunscreen would be it.";
+  std::string ciphertext =
+      "d31a8d34648e60db7b86afbc53ef7ec2a4aded51296e08fea9e2b5a736ee62d6"
+      "3dbea45e8ca9671282fafb69da92728b1a71de0a9e060b2905d6a5b67ecd3b36"
+      "92ddbd7f2d778b8c9803aee328091b58fab324e4fad675945585808b4831d7bc"
+      "3ff4def08e4b7a9de576d26586cec64b6116";
+  std::string tag = "1ae10b594f09e26a7e902ecbd0600691";
+
+  auto cipher = std::move(ChaCha20Poly1305BoringSsl::New(key).ValueOrDie());
+  auto pt = cipher->Decrypt(
+      test::HexDecodeOrDie(absl::StrCat(nonce, ciphertext, tag)), aad);
+  EXPECT_TRUE(pt.ok()) << pt.status();
+  EXPECT_EQ(plaintext, pt.ValueOrDie());
+}
+
+TEST(ChaCha20Poly1305BoringSslTest, testInvalidKeySizes) {
+  for (int keysize = 0; keysize < 65; keysize++) {
+    if (keysize == 32) {
+      continue;
+    }
+    std::string key(keysize, 'x');
+    auto cipher = ChaCha20Poly1305BoringSsl::New(key);
+    EXPECT_FALSE(cipher.ok());
+  }
+}
+
+}  // namespace
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
+
+int main(int ac, char* av[]) {
+  testing::InitGoogleTest(&ac, av);
+  return RUN_ALL_TESTS();
+}
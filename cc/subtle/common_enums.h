@@ -53,6 +53,14 @@ enum EcdsaSignatureEncoding {
   DER = 2,
 };
 
+// AEADs of HPKE (https://tools.ietf.org/html/rfc9180#section-7.3).
+enum HpkeAead {
+  UNKNOWN_HPKE_AEAD = 0,
+  AES_128_GCM = 1,
+  AES_256_GCM = 2,
+  CHACHA20_POLY1305 = 3,
+};
+
 std::string EnumToString(EllipticCurveType type);
 std::string EnumToString(EcPointFormat format);
 std::string EnumToString(HashType type);
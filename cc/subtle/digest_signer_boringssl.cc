@@ -0,0 +1,113 @@
+// Copyright 2018 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/subtle/digest_signer_boringssl.h"
+
+#include "openssl/digest.h"
+#include "openssl/evp.h"
+#include "tink/subtle/subtle_util_boringssl.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+
+namespace {
+
+util::StatusOr<bssl::UniquePtr<EVP_MD_CTX>> NewDigestCtx(const EVP_MD* hash) {
+  bssl::UniquePtr<EVP_MD_CTX> ctx(EVP_MD_CTX_new());
+  if (ctx == nullptr || hash == nullptr ||
+      1 != EVP_DigestInit_ex(ctx.get(), hash, nullptr /* engine */)) {
+    return util::Status(util::error::INTERNAL, "Could not initialize digest.");
+  }
+  return std::move(ctx);
+}
+
+util::Status DigestUpdate(EVP_MD_CTX* ctx, absl::string_view data) {
+  data = SubtleUtilBoringSSL::EnsureNonNull(data);
+  if (1 != EVP_DigestUpdate(ctx, data.data(), data.size())) {
+    return util::Status(util::error::INTERNAL, "Could not compute digest.");
+  }
+  return util::Status::OK;
+}
+
+util::StatusOr<std::string> DigestFinal(EVP_MD_CTX* ctx) {
+  uint8_t digest[EVP_MAX_MD_SIZE];
+  unsigned int digest_size;
+  if (1 != EVP_DigestFinal_ex(ctx, digest, &digest_size)) {
+    return util::Status(util::error::INTERNAL, "Could not compute digest.");
+  }
+  return std::string(reinterpret_cast<const char*>(digest), digest_size);
+}
+
+util::Status AlreadyFinalized() {
+  return util::Status(util::error::FAILED_PRECONDITION,
+                      "Digest already finalized.");
+}
+
+}  // namespace
+
+// static
+util::StatusOr<std::unique_ptr<PublicKeySigner>> DigestSignerBoringSsl::New(
+    const EVP_MD* hash, SignDigestFunction sign_digest) {
+  auto ctx_result = NewDigestCtx(hash);
+  if (!ctx_result.ok()) return ctx_result.status();
+  std::unique_ptr<PublicKeySigner> signer(new DigestSignerBoringSsl(
+      std::move(ctx_result.ValueOrDie()), std::move(sign_digest)));
+  return std::move(signer);
+}
+
+util::Status DigestSignerBoringSsl::Update(absl::string_view data) {
+  if (finalized_) return AlreadyFinalized();
+  return DigestUpdate(ctx_.get(), data);
+}
+
+util::StatusOr<std::string> DigestSignerBoringSsl::Finalize() {
+  if (finalized_) return AlreadyFinalized();
+  finalized_ = true;
+  auto digest_result = DigestFinal(ctx_.get());
+  if (!digest_result.ok()) return digest_result.status();
+  return sign_digest_(digest_result.ValueOrDie());
+}
+
+// static
+util::StatusOr<std::unique_ptr<PublicKeyVerifier>>
+DigestVerifierBoringSsl::New(const EVP_MD* hash,
+                             VerifyDigestFunction verify_digest) {
+  auto ctx_result = NewDigestCtx(hash);
+  if (!ctx_result.ok()) return ctx_result.status();
+  std::unique_ptr<PublicKeyVerifier> verifier(new DigestVerifierBoringSsl(
+      std::move(ctx_result.ValueOrDie()), std::move(verify_digest)));
+  return std::move(verifier);
+}
+
+util::Status DigestVerifierBoringSsl::Update(absl::string_view data) {
+  if (finalized_) return AlreadyFinalized();
+  return DigestUpdate(ctx_.get(), data);
+}
+
+util::Status DigestVerifierBoringSsl::Finalize() {
+  if (finalized_) return AlreadyFinalized();
+  finalized_ = true;
+  auto digest_result = DigestFinal(ctx_.get());
+  if (!digest_result.ok()) return digest_result.status();
+  return verify_digest_(digest_result.ValueOrDie());
+}
+
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
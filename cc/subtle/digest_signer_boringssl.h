@@ -0,0 +1,98 @@
+// Copyright 2018 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_SUBTLE_DIGEST_SIGNER_BORINGSSL_H_
+#define TINK_SUBTLE_DIGEST_SIGNER_BORINGSSL_H_
+
+#include <functional>
+#include <memory>
+#include <string>
+
+#include "absl/strings/string_view.h"
+#include "openssl/digest.h"
+#include "tink/public_key_sign.h"
+#include "tink/public_key_verify.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+
+// PublicKeySigner for signature schemes that sign a digest of the data,
+// like ECDSA and RSA SSA. The data passed to Update() is hashed right away,
+// and Finalize() signs the digest with 'sign_digest'.
+class DigestSignerBoringSsl : public PublicKeySigner {
+ public:
+  typedef std::function<crypto::tink::util::StatusOr<std::string>(
+      absl::string_view digest)>
+      SignDigestFunction;
+
+  static crypto::tink::util::StatusOr<std::unique_ptr<PublicKeySigner>> New(
+      const EVP_MD* hash, SignDigestFunction sign_digest);
+
+  crypto::tink::util::Status Update(absl::string_view data) override;
+
+  crypto::tink::util::StatusOr<std::string> Finalize() override;
+
+  ~DigestSignerBoringSsl() override = default;
+
+ private:
+  DigestSignerBoringSsl(bssl::UniquePtr<EVP_MD_CTX> ctx,
+                        SignDigestFunction sign_digest)
+      : ctx_(std::move(ctx)),
+        sign_digest_(std::move(sign_digest)),
+        finalized_(false) {}
+
+  const bssl::UniquePtr<EVP_MD_CTX> ctx_;
+  const SignDigestFunction sign_digest_;
+  bool finalized_;
+};
+
+// PublicKeyVerifier for signature schemes that sign a digest of the data.
+// The data passed to Update() is hashed right away, and Finalize() checks
+// the digest with 'verify_digest'.
+class DigestVerifierBoringSsl : public PublicKeyVerifier {
+ public:
+  typedef std::function<crypto::tink::util::Status(absl::string_view digest)>
+      VerifyDigestFunction;
+
+  static crypto::tink::util::StatusOr<std::unique_ptr<PublicKeyVerifier>> New(
+      const EVP_MD* hash, VerifyDigestFunction verify_digest);
+
+  crypto::tink::util::Status Update(absl::string_view data) override;
+
+  crypto::tink::util::Status Finalize() override;
+
+  ~DigestVerifierBoringSsl() override = default;
+
+ private:
+  DigestVerifierBoringSsl(bssl::UniquePtr<EVP_MD_CTX> ctx,
+                          VerifyDigestFunction verify_digest)
+      : ctx_(std::move(ctx)),
+        verify_digest_(std::move(verify_digest)),
+        finalized_(false) {}
+
+  const bssl::UniquePtr<EVP_MD_CTX> ctx_;
+  const VerifyDigestFunction verify_digest_;
+  bool finalized_;
+};
+
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_SUBTLE_DIGEST_SIGNER_BORINGSSL_H_
@@ -0,0 +1,160 @@
+// Copyright 2018 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/subtle/ec_ephemeral_key_pool.h"
+
+#include <chrono>  // NOLINT(build/c++11)
+
+#include "absl/memory/memory.h"
+#include "tink/subtle/subtle_util_boringssl.h"
+#include "tink/util/status.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+
+// static
+util::StatusOr<std::unique_ptr<EcEphemeralKeyPool>> EcEphemeralKeyPool::New(
+    EllipticCurveType curve, size_t capacity, size_t max_keys_per_second) {
+  return NewImpl(curve, capacity, true, max_keys_per_second);
+}
+
+// static
+util::StatusOr<std::unique_ptr<EcEphemeralKeyPool>>
+EcEphemeralKeyPool::NewWithoutRefill(EllipticCurveType curve,
+                                     size_t capacity) {
+  return NewImpl(curve, capacity, false, 0);
+}
+
+// static
+util::StatusOr<std::unique_ptr<EcEphemeralKeyPool>>
+EcEphemeralKeyPool::NewImpl(EllipticCurveType curve, size_t capacity,
+                            bool refill, size_t max_keys_per_second) {
+  if (capacity == 0 || capacity > kMaxCapacity) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "Invalid ephemeral key pool capacity.");
+  }
+  auto status_or_ec_group = SubtleUtilBoringSSL::GetEcGroup(curve);
+  if (!status_or_ec_group.ok()) return status_or_ec_group.status();
+  bssl::UniquePtr<EC_GROUP> group(status_or_ec_group.ValueOrDie());
+  auto pool = absl::WrapUnique(new EcEphemeralKeyPool(
+      curve, std::move(group), capacity, max_keys_per_second));
+  if (refill) {
+    pool->refill_thread_ =
+        std::thread(&EcEphemeralKeyPool::Refill, pool.get());
+  }
+  return std::move(pool);
+}
+
+EcEphemeralKeyPool::EcEphemeralKeyPool(EllipticCurveType curve,
+                                       bssl::UniquePtr<EC_GROUP> group,
+                                       size_t capacity,
+                                       size_t max_keys_per_second)
+    : curve_(curve),
+      group_(std::move(group)),
+      capacity_(capacity),
+      max_keys_per_second_(max_keys_per_second),
+      misses_(0),
+      stopped_(false) {}
+
+EcEphemeralKeyPool::~EcEphemeralKeyPool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopped_ = true;
+  }
+  refill_cv_.notify_all();
+  if (refill_thread_.joinable()) refill_thread_.join();
+}
+
+bssl::UniquePtr<EC_KEY> EcEphemeralKeyPool::Pop() {
+  bssl::UniquePtr<EC_KEY> key;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (keys_.empty()) {
+      misses_++;
+      return nullptr;
+    }
+    key = std::move(keys_.front());
+    keys_.pop_front();
+  }
+  refill_cv_.notify_all();
+  return key;
+}
+
+util::Status EcEphemeralKeyPool::Fill() {
+  while (size() < capacity_) {
+    bssl::UniquePtr<EC_KEY> key = GenerateKey();
+    if (key == nullptr) {
+      return util::Status(util::error::INTERNAL, "EC_KEY_generate_key failed");
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (keys_.size() < capacity_) keys_.push_back(std::move(key));
+  }
+  return util::Status::OK;
+}
+
+size_t EcEphemeralKeyPool::size() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return keys_.size();
+}
+
+uint64_t EcEphemeralKeyPool::misses() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return misses_;
+}
+
+bssl::UniquePtr<EC_KEY> EcEphemeralKeyPool::GenerateKey() const {
+  bssl::UniquePtr<EC_KEY> key(EC_KEY_new());
+  if (key == nullptr || EC_KEY_set_group(key.get(), group_.get()) != 1 ||
+      EC_KEY_generate_key(key.get()) != 1) {
+    SubtleUtilBoringSSL::GetErrors();
+    return nullptr;
+  }
+  return key;
+}
+
+void EcEphemeralKeyPool::Refill() {
+  const std::chrono::microseconds interval(
+      max_keys_per_second_ == 0 ? 0 : 1000000 / max_keys_per_second_);
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (!stopped_) {
+    if (keys_.size() >= capacity_) {
+      refill_cv_.wait(
+          lock, [this]() { return stopped_ || keys_.size() < capacity_; });
+      continue;
+    }
+    // Generate outside the lock so that Pop() is never blocked on it.
+    lock.unlock();
+    bssl::UniquePtr<EC_KEY> key = GenerateKey();
+    lock.lock();
+    if (key != nullptr) {
+      // Fill() may have filled the pool in the meantime.
+      if (keys_.size() < capacity_) keys_.push_back(std::move(key));
+    } else {
+      // Senders fall back to inline generation; retry later.
+      refill_cv_.wait_for(lock, std::chrono::seconds(1),
+                          [this]() { return stopped_; });
+      continue;
+    }
+    if (interval.count() > 0) {
+      refill_cv_.wait_for(lock, interval, [this]() { return stopped_; });
+    }
+  }
+}
+
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
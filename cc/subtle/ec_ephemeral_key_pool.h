@@ -0,0 +1,111 @@
+// Copyright 2018 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_SUBTLE_EC_EPHEMERAL_KEY_POOL_H_
+#define TINK_SUBTLE_EC_EPHEMERAL_KEY_POOL_H_
+
+#include <stdint.h>
+
+#include <condition_variable>  // NOLINT(build/c++11)
+#include <deque>
+#include <memory>
+#include <mutex>  // NOLINT(build/c++11)
+#include <thread>  // NOLINT(build/c++11)
+
+#include "openssl/ec.h"
+#include "tink/subtle/common_enums.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+
+// A bounded pool of single-use ephemeral EC key pairs, kept full by a
+// background thread or by explicit calls to Fill(). Pop() hands out each
+// key pair exactly once; the pool never retains a reference to a key pair
+// after it has been popped.
+//
+// The pool is meant to be shared between all senders using the same curve,
+// e.g. by EciesHkdfSenderKemBoringSsl, to take key generation off the
+// encryption path.
+class EcEphemeralKeyPool {
+ public:
+  // Creates a pool holding up to 'capacity' key pairs for 'curve'.
+  // The background thread generates at most 'max_keys_per_second' key
+  // pairs per second, or as fast as it can if 'max_keys_per_second' is 0.
+  static crypto::tink::util::StatusOr<std::unique_ptr<EcEphemeralKeyPool>>
+  New(EllipticCurveType curve, size_t capacity, size_t max_keys_per_second);
+
+  // Creates a pool holding up to 'capacity' key pairs for 'curve', without
+  // a background thread. Key pairs are only added by Fill(), e.g. when the
+  // caller is idle.
+  static crypto::tink::util::StatusOr<std::unique_ptr<EcEphemeralKeyPool>>
+  NewWithoutRefill(EllipticCurveType curve, size_t capacity);
+
+  // Stops the background thread and destroys all unused key pairs.
+  ~EcEphemeralKeyPool();
+
+  // Removes a key pair from the pool and returns it, or returns nullptr
+  // if the pool is currently empty.
+  bssl::UniquePtr<EC_KEY> Pop();
+
+  // Generates key pairs in the calling thread until the pool is full,
+  // e.g. to warm up the pool before serving requests.
+  crypto::tink::util::Status Fill();
+
+  // Returns the number of key pairs currently available.
+  size_t size() const;
+
+  // Returns the number of calls to Pop() that found the pool empty, i.e.
+  // for which the caller had to generate a key pair itself.
+  uint64_t misses() const;
+
+  EllipticCurveType curve() const { return curve_; }
+
+  static constexpr size_t kMaxCapacity = 1 << 16;
+
+ private:
+  EcEphemeralKeyPool(EllipticCurveType curve, bssl::UniquePtr<EC_GROUP> group,
+                     size_t capacity, size_t max_keys_per_second);
+
+  static crypto::tink::util::StatusOr<std::unique_ptr<EcEphemeralKeyPool>>
+  NewImpl(EllipticCurveType curve, size_t capacity, bool refill,
+          size_t max_keys_per_second);
+
+  // Returns a new key pair, or nullptr if key generation failed.
+  bssl::UniquePtr<EC_KEY> GenerateKey() const;
+
+  void Refill();
+
+  const EllipticCurveType curve_;
+  const bssl::UniquePtr<EC_GROUP> group_;
+  const size_t capacity_;
+  const size_t max_keys_per_second_;
+
+  mutable std::mutex mutex_;
+  std::condition_variable refill_cv_;
+  std::deque<bssl::UniquePtr<EC_KEY>> keys_;  // guarded by mutex_
+  uint64_t misses_;                           // guarded by mutex_
+  bool stopped_;                              // guarded by mutex_
+  std::thread refill_thread_;
+};
+
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_SUBTLE_EC_EPHEMERAL_KEY_POOL_H_
@@ -0,0 +1,145 @@
+// Copyright 2018 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/subtle/ec_ephemeral_key_pool.h"
+
+#include <chrono>  // NOLINT(build/c++11)
+#include <thread>  // NOLINT(build/c++11)
+
+#include "gtest/gtest.h"
+#include "openssl/bn.h"
+#include "openssl/ec.h"
+#include "tink/subtle/common_enums.h"
+#include "tink/subtle/ecies_hkdf_recipient_kem_boringssl.h"
+#include "tink/subtle/ecies_hkdf_sender_kem_boringssl.h"
+#include "tink/subtle/subtle_util_boringssl.h"
+#include "tink/util/test_util.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+namespace {
+
+// Waits until 'pool' holds at least 'count' key pairs.
+void WaitForKeys(const EcEphemeralKeyPool& pool, size_t count) {
+  while (pool.size() < count) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+}
+
+TEST(EcEphemeralKeyPoolTest, testInvalidCapacity) {
+  EXPECT_FALSE(
+      EcEphemeralKeyPool::New(EllipticCurveType::NIST_P256, 0, 0).ok());
+  EXPECT_FALSE(EcEphemeralKeyPool::New(EllipticCurveType::NIST_P256,
+                                       EcEphemeralKeyPool::kMaxCapacity + 1, 0)
+                   .ok());
+  EXPECT_FALSE(
+      EcEphemeralKeyPool::New(EllipticCurveType::UNKNOWN_CURVE, 4, 0).ok());
+  EXPECT_FALSE(
+      EcEphemeralKeyPool::NewWithoutRefill(EllipticCurveType::NIST_P256, 0)
+          .ok());
+}
+
+TEST(EcEphemeralKeyPoolTest, testFillsUpToCapacity) {
+  auto pool = std::move(
+      EcEphemeralKeyPool::New(EllipticCurveType::NIST_P256, 4, 0).ValueOrDie());
+  WaitForKeys(*pool, 4);
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  EXPECT_EQ(4u, pool->size());
+}
+
+TEST(EcEphemeralKeyPoolTest, testFillWithoutRefill) {
+  auto pool = std::move(EcEphemeralKeyPool::NewWithoutRefill(
+      EllipticCurveType::NIST_P256, 3).ValueOrDie());
+  EXPECT_EQ(0u, pool->size());
+  ASSERT_TRUE(pool->Fill().ok());
+  EXPECT_EQ(3u, pool->size());
+  ASSERT_NE(nullptr, pool->Pop());
+  EXPECT_EQ(2u, pool->size());
+  ASSERT_TRUE(pool->Fill().ok());
+  EXPECT_EQ(3u, pool->size());
+  EXPECT_EQ(0u, pool->misses());
+}
+
+TEST(EcEphemeralKeyPoolTest, testKeysAreHandedOutOnce) {
+  auto pool = std::move(EcEphemeralKeyPool::NewWithoutRefill(
+      EllipticCurveType::NIST_P256, 2).ValueOrDie());
+  ASSERT_TRUE(pool->Fill().ok());
+  bssl::UniquePtr<EC_KEY> first = pool->Pop();
+  bssl::UniquePtr<EC_KEY> second = pool->Pop();
+  ASSERT_NE(nullptr, first);
+  ASSERT_NE(nullptr, second);
+  EXPECT_NE(0, BN_cmp(EC_KEY_get0_private_key(first.get()),
+                      EC_KEY_get0_private_key(second.get())));
+  EXPECT_EQ(nullptr, pool->Pop());
+  EXPECT_EQ(1u, pool->misses());
+}
+
+TEST(EcEphemeralKeyPoolTest, testSenderKemWithPool) {
+  EllipticCurveType curve = EllipticCurveType::NIST_P256;
+  std::shared_ptr<EcEphemeralKeyPool> pool(std::move(
+      EcEphemeralKeyPool::NewWithoutRefill(curve, 2).ValueOrDie()));
+  ASSERT_TRUE(pool->Fill().ok());
+  auto test_key = SubtleUtilBoringSSL::GetNewEcKey(curve).ValueOrDie();
+  auto sender_kem = std::move(EciesHkdfSenderKemBoringSsl::New(
+      curve, test_key.pub_x, test_key.pub_y, pool).ValueOrDie());
+  auto recipient_kem = std::move(
+      EciesHkdfRecipientKemBoringSsl::New(curve, test_key.priv).ValueOrDie());
+
+  std::string salt = test::HexDecodeOrDie("0b0b0b0b");
+  std::string info = test::HexDecodeOrDie("0b0b0b0b0b0b0b0b");
+  // The first two iterations take key pairs from the pool, the last one
+  // finds it empty and generates a key pair inline.
+  std::string previous_kem_bytes;
+  for (int i = 0; i < 3; i++) {
+    auto kem_key = std::move(sender_kem->GenerateKey(
+        HashType::SHA256, salt, info, 32, EcPointFormat::UNCOMPRESSED)
+        .ValueOrDie());
+    EXPECT_NE(previous_kem_bytes, kem_key->get_kem_bytes());
+    previous_kem_bytes = kem_key->get_kem_bytes();
+    auto symmetric_key = recipient_kem->GenerateKey(
+        kem_key->get_kem_bytes(), HashType::SHA256, salt, info, 32,
+        EcPointFormat::UNCOMPRESSED);
+    ASSERT_TRUE(symmetric_key.ok()) << symmetric_key.status();
+    EXPECT_EQ(test::HexEncode(kem_key->get_symmetric_key()),
+              test::HexEncode(symmetric_key.ValueOrDie()));
+    EXPECT_EQ(i < 2 ? 1u - i : 0u, pool->size());
+    EXPECT_EQ(i < 2 ? 0u : 1u, pool->misses());
+  }
+}
+
+TEST(EcEphemeralKeyPoolTest, testSenderKemRejectsPoolForOtherCurve) {
+  std::shared_ptr<EcEphemeralKeyPool> pool(std::move(
+      EcEphemeralKeyPool::New(EllipticCurveType::NIST_P384, 1, 0)
+          .ValueOrDie()));
+  auto test_key =
+      SubtleUtilBoringSSL::GetNewEcKey(EllipticCurveType::NIST_P256)
+          .ValueOrDie();
+  EXPECT_FALSE(EciesHkdfSenderKemBoringSsl::New(EllipticCurveType::NIST_P256,
+                                                test_key.pub_x,
+                                                test_key.pub_y, pool)
+                   .ok());
+}
+
+}  // namespace
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
+
+int main(int ac, char* av[]) {
+  testing::InitGoogleTest(&ac, av);
+  return RUN_ALL_TESTS();
+}
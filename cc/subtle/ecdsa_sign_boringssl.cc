@@ -16,56 +16,21 @@
 
 #include "tink/subtle/ecdsa_sign_boringssl.h"
 
-#include <vector>
-
 #include "absl/strings/str_cat.h"
 #include "tink/subtle/common_enums.h"
+#include "tink/subtle/digest_signer_boringssl.h"
 #include "tink/subtle/subtle_util_boringssl.h"
 #include "tink/util/errors.h"
 #include "openssl/bn.h"
 #include "openssl/ec.h"
 #include "openssl/ecdsa.h"
 #include "openssl/evp.h"
+#include "openssl/mem.h"
 
 namespace crypto {
 namespace tink {
 namespace subtle {
 
-namespace {
-
-// Transforms ECDSA DER signature encoding to IEEE_P1363 encoding.
-//
-// The IEEE_P1363 signature's format is r || s, where r and s are zero-padded
-// and have the same size in bytes as the order of the curve. For example, for
-// NIST P-256 curve, r and s are zero-padded to 32 bytes.
-//
-// The DER signature is encoded using ASN.1
-// (https://tools.ietf.org/html/rfc5480#appendix-A): ECDSA-Sig-Value :: =
-// SEQUENCE { r INTEGER, s INTEGER }. In particular, the encoding is: 0x30 ||
-// totalLength || 0x02 || r's length || r || 0x02 || s's length || s.
-crypto::tink::util::StatusOr<std::string> DerToIeee(absl::string_view der,
-                                               const EC_KEY* key) {
-  size_t field_size_in_bytes =
-      (EC_GROUP_get_degree(EC_KEY_get0_group(key)) + 7) / 8;
-  bssl::UniquePtr<ECDSA_SIG> ecdsa(ECDSA_SIG_from_bytes(
-      reinterpret_cast<const uint8_t*>(der.data()), der.size()));
-  if (ecdsa.get() == nullptr) {
-    return util::Status(util::error::INTERNAL,
-                        "Internal BoringSSL ECDSA_SIG_from_bytes's error");
-  }
-  auto status_or_r = SubtleUtilBoringSSL::bn2str(ecdsa->r, field_size_in_bytes);
-  if (!status_or_r.ok()) {
-    return status_or_r.status();
-  }
-  auto status_or_s = SubtleUtilBoringSSL::bn2str(ecdsa->s, field_size_in_bytes);
-  if (!status_or_s.ok()) {
-    return status_or_s.status();
-  }
-  return status_or_r.ValueOrDie() + status_or_s.ValueOrDie();
-}
-
-}  // namespace
-
 // static
 util::StatusOr<std::unique_ptr<EcdsaSignBoringSsl>> EcdsaSignBoringSsl::New(
     const SubtleUtilBoringSSL::EcKey& ec_key, HashType hash_type,
@@ -115,7 +80,11 @@ util::StatusOr<std::unique_ptr<EcdsaSignBoringSsl>> EcdsaSignBoringSsl::New(
 
 EcdsaSignBoringSsl::EcdsaSignBoringSsl(EC_KEY* key, const EVP_MD* hash,
                                        EcdsaSignatureEncoding encoding)
-    : key_(key), hash_(hash), encoding_(encoding) {}
+    : key_(key),
+      hash_(hash),
+      encoding_(encoding),
+      field_size_in_bytes_(
+          (EC_GROUP_get_degree(EC_KEY_get0_group(key)) + 7) / 8) {}
 
 util::StatusOr<std::string> EcdsaSignBoringSsl::Sign(
     absl::string_view data) const {
@@ -130,25 +99,58 @@ util::StatusOr<std::string> EcdsaSignBoringSsl::Sign(
                   nullptr)) {
     return util::Status(util::error::INTERNAL, "Could not compute digest.");
   }
+  return SignDigest(absl::string_view(reinterpret_cast<const char*>(digest),
+                                      digest_size));
+}
+
+util::StatusOr<std::string> EcdsaSignBoringSsl::SignDigest(
+    absl::string_view digest) const {
+  if (digest.size() != static_cast<size_t>(EVP_MD_size(hash_))) {
+    return util::Status(util::error::INVALID_ARGUMENT, "Invalid digest size.");
+  }
 
   // Compute the signature.
-  std::vector<uint8_t> buffer(ECDSA_size(key_.get()));
-  unsigned int sig_length;
-  if (1 != ECDSA_sign(0 /* unused */, digest, digest_size, buffer.data(),
-                  &sig_length, key_.get())) {
+  bssl::UniquePtr<ECDSA_SIG> ecdsa(
+      ECDSA_do_sign(reinterpret_cast<const uint8_t*>(digest.data()),
+                    digest.size(), key_.get()));
+  if (ecdsa.get() == nullptr) {
     return util::Status(util::error::INTERNAL, "Signing failed.");
   }
 
   if (encoding_ == subtle::EcdsaSignatureEncoding::IEEE_P1363) {
-    auto status_or_sig = DerToIeee(
-        std::string(reinterpret_cast<char*>(buffer.data()), sig_length), key_.get());
-    if (!status_or_sig.ok()) {
-      return status_or_sig.status();
+    // The IEEE_P1363 signature's format is r || s, where r and s are
+    // zero-padded and have the same size in bytes as the order of the curve.
+    // For example, for NIST P-256 curve, r and s are zero-padded to 32 bytes.
+    auto status_or_r =
+        SubtleUtilBoringSSL::bn2str(ecdsa->r, field_size_in_bytes_);
+    if (!status_or_r.ok()) {
+      return status_or_r.status();
     }
-    return status_or_sig.ValueOrDie();
+    auto status_or_s =
+        SubtleUtilBoringSSL::bn2str(ecdsa->s, field_size_in_bytes_);
+    if (!status_or_s.ok()) {
+      return status_or_s.status();
+    }
+    return status_or_r.ValueOrDie() + status_or_s.ValueOrDie();
   }
 
-  return std::string(reinterpret_cast<char*>(buffer.data()), sig_length);
+  // The DER signature is encoded using ASN.1
+  // (https://tools.ietf.org/html/rfc5480#appendix-A).
+  uint8_t* der = nullptr;
+  size_t der_len;
+  if (!ECDSA_SIG_to_bytes(&der, &der_len, ecdsa.get())) {
+    return util::Status(util::error::INTERNAL,
+                        "Internal BoringSSL ECDSA_SIG_to_bytes's error");
+  }
+  std::string signature(reinterpret_cast<char*>(der), der_len);
+  OPENSSL_free(der);
+  return signature;
+}
+
+util::StatusOr<std::unique_ptr<PublicKeySigner>>
+EcdsaSignBoringSsl::NewSigner() const {
+  return DigestSignerBoringSsl::New(
+      hash_, [this](absl::string_view digest) { return SignDigest(digest); });
 }
 
 }  // namespace subtle
@@ -43,6 +43,15 @@ class EcdsaSignBoringSsl : public PublicKeySign {
   crypto::tink::util::StatusOr<std::string> Sign(
       absl::string_view data) const override;
 
+  // Computes the signature for 'digest', the hash of the data with the
+  // signature hash. Sign(data) is equivalent to SignDigest(hash(data)).
+  crypto::tink::util::StatusOr<std::string> SignDigest(
+      absl::string_view digest) const;
+
+  // Returns a signer that hashes the data as it is passed in.
+  crypto::tink::util::StatusOr<std::unique_ptr<PublicKeySigner>> NewSigner()
+      const override;
+
   virtual ~EcdsaSignBoringSsl() {}
 
  private:
@@ -52,6 +61,7 @@ class EcdsaSignBoringSsl : public PublicKeySign {
   bssl::UniquePtr<EC_KEY> key_;
   const EVP_MD* hash_;  // Owned by BoringSSL.
   EcdsaSignatureEncoding encoding_;
+  size_t field_size_in_bytes_;  // Size of r and s in IEEE_P1363 encoding.
 };
 
 }  // namespace subtle
@@ -17,6 +17,7 @@
 #include "tink/subtle/ecdsa_sign_boringssl.h"
 
 #include <string>
+#include <vector>
 
 #include "gtest/gtest.h"
 #include "tink/public_key_sign.h"
@@ -74,6 +75,53 @@ TEST_F(EcdsaSignBoringSslTest, testBasicSigning) {
   }
 }
 
+TEST_F(EcdsaSignBoringSslTest, testIncrementalSigning) {
+  subtle::EcdsaSignatureEncoding encodings[2] = {
+      EcdsaSignatureEncoding::DER, EcdsaSignatureEncoding::IEEE_P1363};
+  for (EcdsaSignatureEncoding encoding : encodings) {
+    auto ec_key = SubtleUtilBoringSSL::GetNewEcKey(EllipticCurveType::NIST_P256)
+                      .ValueOrDie();
+    auto signer = std::move(
+        EcdsaSignBoringSsl::New(ec_key, HashType::SHA256, encoding)
+            .ValueOrDie());
+    auto verifier = std::move(
+        EcdsaVerifyBoringSsl::New(ec_key, HashType::SHA256, encoding)
+            .ValueOrDie());
+    std::string message = "some data to be signed";
+
+    auto incremental_signer_result = signer->NewSigner();
+    ASSERT_TRUE(incremental_signer_result.ok())
+        << incremental_signer_result.status();
+    auto incremental_signer = std::move(incremental_signer_result.ValueOrDie());
+    EXPECT_TRUE(incremental_signer->Update("some data").ok());
+    EXPECT_TRUE(incremental_signer->Update(" to be signed").ok());
+    std::string signature = incremental_signer->Finalize().ValueOrDie();
+    auto status = verifier->Verify(signature, message);
+    EXPECT_TRUE(status.ok()) << status;
+
+    auto incremental_verifier = std::move(
+        verifier->NewVerifier(signature).ValueOrDie());
+    EXPECT_TRUE(incremental_verifier->Update("some data to").ok());
+    EXPECT_TRUE(incremental_verifier->Update(" be signed").ok());
+    status = incremental_verifier->Finalize();
+    EXPECT_TRUE(status.ok()) << status;
+
+    incremental_verifier = std::move(
+        verifier->NewVerifier(signature).ValueOrDie());
+    EXPECT_TRUE(incremental_verifier->Update("some bad message").ok());
+    EXPECT_FALSE(incremental_verifier->Finalize().ok());
+
+    // Prehashed data.
+    std::vector<uint8_t> digest =
+        boringssl::ComputeHash(message, *EVP_sha256()).ValueOrDie();
+    std::string digest_str(digest.begin(), digest.end());
+    signature = signer->SignDigest(digest_str).ValueOrDie();
+    status = verifier->Verify(signature, message);
+    EXPECT_TRUE(status.ok()) << status;
+    EXPECT_FALSE(signer->SignDigest(message).ok());
+  }
+}
+
 TEST_F(EcdsaSignBoringSslTest, testEncodingsMismatch) {
   subtle::EcdsaSignatureEncoding encodings[2] = {
       EcdsaSignatureEncoding::DER, EcdsaSignatureEncoding::IEEE_P1363};
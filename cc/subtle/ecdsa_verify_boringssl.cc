@@ -23,6 +23,7 @@
 #include "openssl/evp.h"
 #include "openssl/mem.h"
 #include "tink/subtle/common_enums.h"
+#include "tink/subtle/digest_signer_boringssl.h"
 #include "tink/subtle/subtle_util_boringssl.h"
 #include "tink/util/errors.h"
 
@@ -132,6 +133,16 @@ util::Status EcdsaVerifyBoringSsl::Verify(
                   nullptr)) {
     return util::Status(util::error::INTERNAL, "Could not compute digest.");
   }
+  return VerifyDigest(
+      signature,
+      absl::string_view(reinterpret_cast<const char*>(digest), digest_size));
+}
+
+util::Status EcdsaVerifyBoringSsl::VerifyDigest(
+    absl::string_view signature, absl::string_view digest) const {
+  if (digest.size() != static_cast<size_t>(EVP_MD_size(hash_))) {
+    return util::Status(util::error::INVALID_ARGUMENT, "Invalid digest size.");
+  }
 
   std::string derSig(signature);
   if (encoding_ == subtle::EcdsaSignatureEncoding::IEEE_P1363) {
@@ -143,7 +154,9 @@ util::Status EcdsaVerifyBoringSsl::Verify(
   }
 
   // Verify the signature.
-  if (1 != ECDSA_verify(0 /* unused */, digest, digest_size,
+  if (1 != ECDSA_verify(0 /* unused */,
+                        reinterpret_cast<const uint8_t*>(digest.data()),
+                        digest.size(),
                         reinterpret_cast<const uint8_t*>(derSig.data()),
                         derSig.size(), key_.get())) {
     // signature is invalid
@@ -153,6 +166,15 @@ util::Status EcdsaVerifyBoringSsl::Verify(
   return util::Status::OK;
 }
 
+util::StatusOr<std::unique_ptr<PublicKeyVerifier>>
+EcdsaVerifyBoringSsl::NewVerifier(absl::string_view signature) const {
+  std::string signature_copy(signature);
+  return DigestVerifierBoringSsl::New(
+      hash_, [this, signature_copy](absl::string_view digest) {
+        return VerifyDigest(signature_copy, digest);
+      });
+}
+
 }  // namespace subtle
 }  // namespace tink
 }  // namespace crypto
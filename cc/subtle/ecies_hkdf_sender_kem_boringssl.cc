@@ -50,12 +50,29 @@ util::StatusOr<std::unique_ptr<EciesHkdfSenderKemBoringSsl>>
 EciesHkdfSenderKemBoringSsl::New(
     subtle::EllipticCurveType curve,
     const std::string& pubx, const std::string& puby) {
+  return New(curve, pubx, puby, nullptr);
+}
+
+// static
+util::StatusOr<std::unique_ptr<EciesHkdfSenderKemBoringSsl>>
+EciesHkdfSenderKemBoringSsl::New(
+    subtle::EllipticCurveType curve,
+    const std::string& pubx, const std::string& puby,
+    std::shared_ptr<EcEphemeralKeyPool> ephemeral_key_pool) {
+  if (ephemeral_key_pool != nullptr && ephemeral_key_pool->curve() != curve) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "Ephemeral key pool is for a different curve.");
+  }
   auto status_or_ec_point =
       SubtleUtilBoringSSL::GetEcPoint(curve, pubx, puby);
   if (!status_or_ec_point.ok()) return status_or_ec_point.status();
+  auto status_or_ec_group = SubtleUtilBoringSSL::GetEcGroup(curve);
+  if (!status_or_ec_group.ok()) return status_or_ec_group.status();
   auto sender_kem =
       absl::WrapUnique(new EciesHkdfSenderKemBoringSsl(curve, pubx, puby));
   sender_kem->peer_pub_key_.reset(status_or_ec_point.ValueOrDie());
+  sender_kem->group_.reset(status_or_ec_group.ValueOrDie());
+  sender_kem->ephemeral_key_pool_ = std::move(ephemeral_key_pool);
   return std::move(sender_kem);
 }
 
@@ -71,17 +88,20 @@ EciesHkdfSenderKemBoringSsl::GenerateKey(
                         "peer_pub_key_ wasn't initialized");
   }
 
-  auto status_or_ec_group = SubtleUtilBoringSSL::GetEcGroup(curve_);
-  if (!status_or_ec_group.ok()) {
-    return status_or_ec_group.status();
-  }
-  bssl::UniquePtr<EC_GROUP> group(status_or_ec_group.ValueOrDie());
-  bssl::UniquePtr<EC_KEY> ephemeral_key(EC_KEY_new());
-  if (1 != EC_KEY_set_group(ephemeral_key.get(), group.get())) {
-    return util::Status(util::error::INTERNAL, "EC_KEY_set_group failed");
+  // Each pooled key pair is handed out once and destroyed with
+  // 'ephemeral_key' when this call returns.
+  bssl::UniquePtr<EC_KEY> ephemeral_key;
+  if (ephemeral_key_pool_ != nullptr) {
+    ephemeral_key = ephemeral_key_pool_->Pop();
   }
-  if (1 != EC_KEY_generate_key(ephemeral_key.get())) {
-    return util::Status(util::error::INTERNAL, "EC_KEY_generate_key failed");
+  if (ephemeral_key == nullptr) {
+    ephemeral_key.reset(EC_KEY_new());
+    if (1 != EC_KEY_set_group(ephemeral_key.get(), group_.get())) {
+      return util::Status(util::error::INTERNAL, "EC_KEY_set_group failed");
+    }
+    if (1 != EC_KEY_generate_key(ephemeral_key.get())) {
+      return util::Status(util::error::INTERNAL, "EC_KEY_generate_key failed");
+    }
   }
   const BIGNUM* ephemeral_priv = EC_KEY_get0_private_key(ephemeral_key.get());
   const EC_POINT* ephemeral_pub = EC_KEY_get0_public_key(ephemeral_key.get());
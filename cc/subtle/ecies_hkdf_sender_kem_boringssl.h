@@ -17,8 +17,11 @@
 #ifndef TINK_SUBTLE_ECIES_HKDF_SENDER_KEM_BORINGSSL_H_
 #define TINK_SUBTLE_ECIES_HKDF_SENDER_KEM_BORINGSSL_H_
 
+#include <memory>
+
 #include "absl/strings/string_view.h"
 #include "tink/subtle/common_enums.h"
+#include "tink/subtle/ec_ephemeral_key_pool.h"
 #include "tink/util/statusor.h"
 #include "openssl/ec.h"
 
@@ -53,6 +56,15 @@ class EciesHkdfSenderKemBoringSsl {
           const std::string& pubx,
           const std::string& puby);
 
+  // Like New(), but takes ephemeral key pairs from 'ephemeral_key_pool'
+  // when it has one available. The pool must be for the same curve.
+  static
+  crypto::tink::util::StatusOr<std::unique_ptr<EciesHkdfSenderKemBoringSsl>>
+      New(EllipticCurveType curve,
+          const std::string& pubx,
+          const std::string& puby,
+          std::shared_ptr<EcEphemeralKeyPool> ephemeral_key_pool);
+
   // Generates ephemeral key pairs, computes ECDH's shared secret based on
   // generated ephemeral key and recipient's public key, then uses HKDF
   // to derive the symmetric key from the shared secret, 'hkdf_info' and
@@ -73,6 +85,8 @@ class EciesHkdfSenderKemBoringSsl {
   std::string pubx_;
   std::string puby_;
   bssl::UniquePtr<EC_POINT> peer_pub_key_;
+  bssl::UniquePtr<EC_GROUP> group_;
+  std::shared_ptr<EcEphemeralKeyPool> ephemeral_key_pool_;
 };
 
 }  // namespace subtle
@@ -0,0 +1,78 @@
+// Copyright 2018 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+#include "tink/subtle/ed25519_sign_boringssl.h"
+
+#include "absl/memory/memory.h"
+#include "openssl/curve25519.h"
+#include "openssl/mem.h"
+#include "tink/output_buffer.h"
+#include "tink/subtle/subtle_util_boringssl.h"
+#include "tink/util/status.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+
+// static
+util::StatusOr<std::unique_ptr<Ed25519SignBoringSsl>> Ed25519SignBoringSsl::New(
+    absl::string_view private_key) {
+  if (private_key.size() != ED25519_PRIVATE_KEY_LEN / 2) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "Invalid ED25519 private key size.");
+  }
+  auto sign = absl::WrapUnique(new Ed25519SignBoringSsl());
+  uint8_t public_key[ED25519_PUBLIC_KEY_LEN];
+  ED25519_keypair_from_seed(
+      public_key, sign->private_key_,
+      reinterpret_cast<const uint8_t*>(private_key.data()));
+  return std::move(sign);
+}
+
+Ed25519SignBoringSsl::~Ed25519SignBoringSsl() {
+  OPENSSL_cleanse(private_key_, sizeof(private_key_));
+}
+
+util::StatusOr<std::string> Ed25519SignBoringSsl::Sign(
+    absl::string_view data) const {
+  std::string signature;
+  StringOutputBuffer output(&signature);
+  util::Status status = SignInto(data, &output);
+  if (!status.ok()) return status;
+  return std::move(signature);
+}
+
+util::Status Ed25519SignBoringSsl::SignInto(absl::string_view data,
+                                            OutputBuffer* signature) const {
+  // BoringSSL expects a non-null pointer for data,
+  // regardless of whether the size is 0.
+  data = SubtleUtilBoringSSL::EnsureNonNull(data);
+  uint8_t* output =
+      reinterpret_cast<uint8_t*>(signature->Resize(ED25519_SIGNATURE_LEN));
+  if (output == nullptr) {
+    return util::Status(util::error::RESOURCE_EXHAUSTED,
+                        "output buffer too small");
+  }
+  if (ED25519_sign(output, reinterpret_cast<const uint8_t*>(data.data()),
+                   data.size(), private_key_) != 1) {
+    signature->Resize(0);
+    return util::Status(util::error::INTERNAL, "Signing failed.");
+  }
+  return util::Status::OK;
+}
+
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
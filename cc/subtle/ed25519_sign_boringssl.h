@@ -0,0 +1,63 @@
+// Copyright 2018 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+#ifndef TINK_SUBTLE_ED25519_SIGN_BORINGSSL_H_
+#define TINK_SUBTLE_ED25519_SIGN_BORINGSSL_H_
+
+#include <memory>
+#include <string>
+
+#include "absl/strings/string_view.h"
+#include "openssl/curve25519.h"
+#include "tink/output_buffer.h"
+#include "tink/public_key_sign.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+
+// Ed25519 signing using Boring SSL, as defined in
+// https://tools.ietf.org/html/rfc8032#section-5.1.6.
+class Ed25519SignBoringSsl : public PublicKeySign {
+ public:
+  // Returns a signer for the 32-byte 'private_key' seed
+  // (https://tools.ietf.org/html/rfc8032#section-5.1.5).
+  static crypto::tink::util::StatusOr<std::unique_ptr<Ed25519SignBoringSsl>>
+  New(absl::string_view private_key);
+
+  // Computes the 64-byte signature for 'data'.
+  crypto::tink::util::StatusOr<std::string> Sign(
+      absl::string_view data) const override;
+
+  // Writes the signature for 'data' directly into 'signature'.
+  crypto::tink::util::Status SignInto(
+      absl::string_view data, OutputBuffer* signature) const override;
+
+  ~Ed25519SignBoringSsl() override;
+
+ private:
+  Ed25519SignBoringSsl() {}
+
+  // The seed followed by the public key, as expected by ED25519_sign().
+  uint8_t private_key_[ED25519_PRIVATE_KEY_LEN];
+};
+
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_SUBTLE_ED25519_SIGN_BORINGSSL_H_
@@ -0,0 +1,126 @@
+// Copyright 2018 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+#include "tink/subtle/ed25519_sign_boringssl.h"
+
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "tink/public_key_sign.h"
+#include "tink/public_key_verify.h"
+#include "tink/subtle/ed25519_verify_boringssl.h"
+#include "tink/subtle/random.h"
+#include "tink/util/test_util.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+namespace {
+
+// Test vectors from https://tools.ietf.org/html/rfc8032#section-7.1.
+struct Rfc8032TestVector {
+  std::string private_key;
+  std::string public_key;
+  std::string message;
+  std::string signature;
+};
+
+std::vector<Rfc8032TestVector> GetRfc8032TestVectors() {
+  return {
+      {test::HexDecodeOrDie(
+           "9d61b19deffd5a60ba844af492ec2cc44449c5697b326919703bac031cae7f60"),
+       test::HexDecodeOrDie(
+           "d75a980182b10ab7d54bfed3c964073a0ee172f3daa62325af021a68f707511a"),
+       "",
+       test::HexDecodeOrDie(
+           "e5564300c360ac729086e2cc806e828a84877f1eb8e5d974d873e06522490155"
+           "5fb8821590a33bacc61e39701cf9b46bd25bf5f0595bbe24655141438e7a100b")},
+      {test::HexDecodeOrDie(
+           "4ccd089b28ff96da9db6c346ec114e0f5b8a319f35aba624da8cf6ed4fb8a6fb"),
+       test::HexDecodeOrDie(
+           "3d4017c3e843895a92b70aa74d1b7ebc9c982ccf2ec4968cc0cd55f12af4660c"),
+       test::HexDecodeOrDie("72"),
+       test::HexDecodeOrDie(
+           "92a009a9f0d4cab8720e820b5f642540a2b27b5416503f8fb3762223ebdb69da"
+           "085ac1e43e15996e458f3613d0f11d8c387b2eaeb4302aeeb00d291612bb0c00")},
+      {test::HexDecodeOrDie(
+           "c5aa8df43f9f837bedb7442f31dcb7b166d38535076f094b85ce3a2e0b4458f7"),
+       test::HexDecodeOrDie(
+           "fc51cd8e6218a1a38da47ed00230f0580816ed13ba3303ac5deb911548908025"),
+       test::HexDecodeOrDie("af82"),
+       test::HexDecodeOrDie(
+           "6291d657deec24024827e69c3abe01a30ce548a284743a445e3680d7db5ac3ac"
+           "18ff9b538d16f290ae67f760984dc6594a7c15e9716ed28dc027beceea1ec40a")}};
+}
+
+TEST(Ed25519SignBoringSslTest, testRfc8032Vectors) {
+  for (const Rfc8032TestVector& vector : GetRfc8032TestVectors()) {
+    auto signer_result = Ed25519SignBoringSsl::New(vector.private_key);
+    ASSERT_TRUE(signer_result.ok()) << signer_result.status();
+    auto signature_result = signer_result.ValueOrDie()->Sign(vector.message);
+    ASSERT_TRUE(signature_result.ok()) << signature_result.status();
+    EXPECT_EQ(test::HexEncode(vector.signature),
+              test::HexEncode(signature_result.ValueOrDie()));
+
+    auto verifier_result = Ed25519VerifyBoringSsl::New(vector.public_key);
+    ASSERT_TRUE(verifier_result.ok()) << verifier_result.status();
+    auto status =
+        verifier_result.ValueOrDie()->Verify(vector.signature, vector.message);
+    EXPECT_TRUE(status.ok()) << status;
+  }
+}
+
+TEST(Ed25519SignBoringSslTest, testSignVerify) {
+  Rfc8032TestVector vector = GetRfc8032TestVectors()[0];
+  auto signer = std::move(
+      Ed25519SignBoringSsl::New(vector.private_key).ValueOrDie());
+  auto verifier = std::move(
+      Ed25519VerifyBoringSsl::New(vector.public_key).ValueOrDie());
+  std::string message = Random::GetRandomBytes(100);
+  std::string signature = signer->Sign(message).ValueOrDie();
+  EXPECT_EQ(ED25519_SIGNATURE_LEN, signature.size());
+  EXPECT_TRUE(verifier->Verify(signature, message).ok());
+
+  // Ed25519 signatures are deterministic.
+  EXPECT_EQ(signature, signer->Sign(message).ValueOrDie());
+
+  EXPECT_FALSE(verifier->Verify(signature, message + "x").ok());
+  EXPECT_FALSE(verifier->Verify(signature.substr(1), message).ok());
+  EXPECT_FALSE(verifier->Verify(signature + "x", message).ok());
+  for (size_t i = 0; i < signature.size(); i++) {
+    std::string modified_signature = signature;
+    modified_signature[i] ^= 1;
+    EXPECT_FALSE(verifier->Verify(modified_signature, message).ok());
+  }
+}
+
+TEST(Ed25519SignBoringSslTest, testInvalidKeySizes) {
+  EXPECT_FALSE(Ed25519SignBoringSsl::New("").ok());
+  EXPECT_FALSE(Ed25519SignBoringSsl::New(Random::GetRandomBytes(31)).ok());
+  EXPECT_FALSE(Ed25519SignBoringSsl::New(Random::GetRandomBytes(64)).ok());
+  EXPECT_FALSE(Ed25519VerifyBoringSsl::New("").ok());
+  EXPECT_FALSE(Ed25519VerifyBoringSsl::New(Random::GetRandomBytes(33)).ok());
+}
+
+}  // namespace
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
+
+int main(int ac, char* av[]) {
+  testing::InitGoogleTest(&ac, av);
+  return RUN_ALL_TESTS();
+}
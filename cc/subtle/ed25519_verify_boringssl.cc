@@ -0,0 +1,62 @@
+// Copyright 2018 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+#include "tink/subtle/ed25519_verify_boringssl.h"
+
+#include <string.h>
+
+#include "absl/memory/memory.h"
+#include "openssl/curve25519.h"
+#include "tink/subtle/subtle_util_boringssl.h"
+#include "tink/util/status.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+
+// static
+util::StatusOr<std::unique_ptr<Ed25519VerifyBoringSsl>>
+Ed25519VerifyBoringSsl::New(absl::string_view public_key) {
+  if (public_key.size() != ED25519_PUBLIC_KEY_LEN) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "Invalid ED25519 public key size.");
+  }
+  auto verify = absl::WrapUnique(new Ed25519VerifyBoringSsl());
+  memcpy(verify->public_key_, public_key.data(), ED25519_PUBLIC_KEY_LEN);
+  return std::move(verify);
+}
+
+util::Status Ed25519VerifyBoringSsl::Verify(
+    absl::string_view signature,
+    absl::string_view data) const {
+  if (signature.size() != ED25519_SIGNATURE_LEN) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "Invalid ED25519 signature size.");
+  }
+  // BoringSSL expects a non-null pointer for data,
+  // regardless of whether the size is 0.
+  data = SubtleUtilBoringSSL::EnsureNonNull(data);
+  if (ED25519_verify(reinterpret_cast<const uint8_t*>(data.data()),
+                     data.size(),
+                     reinterpret_cast<const uint8_t*>(signature.data()),
+                     public_key_) != 1) {
+    return util::Status(util::error::UNKNOWN, "Signature is not valid.");
+  }
+  return util::Status::OK;
+}
+
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
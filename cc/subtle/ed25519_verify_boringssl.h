@@ -0,0 +1,56 @@
+// Copyright 2018 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+#ifndef TINK_SUBTLE_ED25519_VERIFY_BORINGSSL_H_
+#define TINK_SUBTLE_ED25519_VERIFY_BORINGSSL_H_
+
+#include <memory>
+
+#include "absl/strings/string_view.h"
+#include "openssl/curve25519.h"
+#include "tink/public_key_verify.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+
+// Ed25519 verification using Boring SSL, as defined in
+// https://tools.ietf.org/html/rfc8032#section-5.1.7.
+class Ed25519VerifyBoringSsl : public PublicKeyVerify {
+ public:
+  // Returns a verifier for the 32-byte encoded 'public_key'.
+  static crypto::tink::util::StatusOr<std::unique_ptr<Ed25519VerifyBoringSsl>>
+  New(absl::string_view public_key);
+
+  // Verifies that 'signature' is a digital signature for 'data'.
+  crypto::tink::util::Status Verify(
+      absl::string_view signature,
+      absl::string_view data) const override;
+
+  virtual ~Ed25519VerifyBoringSsl() {}
+
+ private:
+  Ed25519VerifyBoringSsl() {}
+
+  uint8_t public_key_[ED25519_PUBLIC_KEY_LEN];
+};
+
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_SUBTLE_ED25519_VERIFY_BORINGSSL_H_
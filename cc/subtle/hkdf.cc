@@ -16,12 +16,17 @@
 
 #include "tink/subtle/hkdf.h"
 
+#include <algorithm>
+
+#include "absl/memory/memory.h"
 #include "tink/subtle/subtle_util_boringssl.h"
 #include "tink/subtle/common_enums.h"
 #include "tink/util/status.h"
 #include "tink/util/statusor.h"
 #include "openssl/evp.h"
 #include "openssl/hkdf.h"
+#include "openssl/hmac.h"
+#include "openssl/mem.h"
 
 
 namespace crypto {
@@ -62,6 +67,73 @@ util::StatusOr<std::string> Hkdf::ComputeEciesHkdfSymmetricKey(
   return Hkdf::ComputeHkdf(hash, ikm, salt, info, out_len);
 }
 
+// static
+util::StatusOr<std::unique_ptr<HkdfExpander>> HkdfExpander::New(
+    HashType hash, absl::string_view ikm, absl::string_view salt) {
+  auto status_or_evp_md = SubtleUtilBoringSSL::EvpHash(hash);
+  if (!status_or_evp_md.ok()) {
+    return status_or_evp_md.status();
+  }
+  const EVP_MD* md = status_or_evp_md.ValueOrDie();
+  ikm = SubtleUtilBoringSSL::EnsureNonNull(ikm);
+  salt = SubtleUtilBoringSSL::EnsureNonNull(salt);
+  uint8_t prk[EVP_MAX_MD_SIZE];
+  size_t prk_len;
+  if (1 != HKDF_extract(prk, &prk_len, md,
+                        reinterpret_cast<const uint8_t *>(ikm.data()),
+                        ikm.size(),
+                        reinterpret_cast<const uint8_t *>(salt.data()),
+                        salt.size())) {
+    return util::Status(util::error::INTERNAL,
+                        "BoringSSL's HKDF_extract failed");
+  }
+  bssl::UniquePtr<HMAC_CTX> prk_ctx(HMAC_CTX_new());
+  bool keyed = prk_ctx != nullptr &&
+               1 == HMAC_Init_ex(prk_ctx.get(), prk, prk_len, md, nullptr);
+  OPENSSL_cleanse(prk, sizeof(prk));
+  if (!keyed) {
+    return util::Status(util::error::INTERNAL, "HMAC_Init_ex failed");
+  }
+  return absl::WrapUnique(
+      new HkdfExpander(std::move(prk_ctx), EVP_MD_size(md)));
+}
+
+util::StatusOr<std::string> HkdfExpander::Expand(absl::string_view info,
+                                                 size_t out_len) const {
+  // See RFC5869, section 2.3.
+  if (out_len > 255 * digest_size_) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "HKDF output too long");
+  }
+  info = SubtleUtilBoringSSL::EnsureNonNull(info);
+  bssl::UniquePtr<HMAC_CTX> ctx(HMAC_CTX_new());
+  if (ctx == nullptr) {
+    return util::Status(util::error::INTERNAL, "HMAC_CTX_new failed");
+  }
+  std::string out(out_len, '\0');
+  uint8_t t[EVP_MAX_MD_SIZE];
+  unsigned int t_len = 0;
+  size_t done = 0;
+  for (uint8_t i = 1; done < out_len; i++) {
+    // T(i) = HMAC(PRK, T(i-1) | info | i), where T(0) is empty.
+    if (1 != HMAC_CTX_copy_ex(ctx.get(), prk_ctx_.get()) ||
+        1 != HMAC_Update(ctx.get(), t, t_len) ||
+        1 != HMAC_Update(ctx.get(),
+                         reinterpret_cast<const uint8_t *>(info.data()),
+                         info.size()) ||
+        1 != HMAC_Update(ctx.get(), &i, 1) ||
+        1 != HMAC_Final(ctx.get(), t, &t_len)) {
+      OPENSSL_cleanse(t, sizeof(t));
+      return util::Status(util::error::INTERNAL, "HKDF expand failed");
+    }
+    size_t todo = std::min(static_cast<size_t>(t_len), out_len - done);
+    memcpy(&out[done], t, todo);
+    done += todo;
+  }
+  OPENSSL_cleanse(t, sizeof(t));
+  return std::move(out);
+}
+
 }  // namespace subtle
 }  // namespace tink
 }  // namespace crypto
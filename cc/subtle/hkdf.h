@@ -17,7 +17,12 @@
 #ifndef TINK_SUBTLE_HKDF_H_
 #define TINK_SUBTLE_HKDF_H_
 
+#include <memory>
+#include <string>
+
 #include "absl/strings/string_view.h"
+#include "openssl/base.h"
+#include "openssl/hmac.h"
 #include "tink/subtle/common_enums.h"
 #include "tink/util/status.h"
 #include "tink/util/statusor.h"
@@ -48,6 +53,33 @@ class Hkdf {
       absl::string_view info,
       size_t out_len);
 };
+
+// HKDF according to RFC5869 for a fixed input keying material and salt.
+// New() runs the extract step and keys an HMAC context with the resulting
+// pseudorandom key once. Each call to Expand() then only copies that context
+// and hashes 'info', which makes deriving many keys from the same root key
+// considerably cheaper than repeated calls to Hkdf::ComputeHkdf.
+class HkdfExpander {
+ public:
+  static crypto::tink::util::StatusOr<std::unique_ptr<HkdfExpander>> New(
+      HashType hash,
+      absl::string_view ikm,
+      absl::string_view salt);
+
+  // Returns the same result as Hkdf::ComputeHkdf(hash, ikm, salt, info,
+  // out_len) for the hash, ikm and salt passed to New().
+  crypto::tink::util::StatusOr<std::string> Expand(
+      absl::string_view info, size_t out_len) const;
+
+ private:
+  HkdfExpander(bssl::UniquePtr<HMAC_CTX> prk_ctx, size_t digest_size)
+      : prk_ctx_(std::move(prk_ctx)), digest_size_(digest_size) {}
+
+  // HMAC context keyed with the pseudorandom key. Never updated after New().
+  const bssl::UniquePtr<HMAC_CTX> prk_ctx_;
+  const size_t digest_size_;
+};
+
 }  // namespace subtle
 }  // namespace tink
 }  // namespace crypto
@@ -0,0 +1,84 @@
+// Copyright 2018 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/subtle/hkdf_aead_key_derivation.h"
+
+#include "openssl/mem.h"
+#include "tink/subtle/aes_gcm_boringssl.h"
+#include "tink/util/status.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+
+// static
+util::StatusOr<std::unique_ptr<KeyDerivation>> HkdfAeadKeyDerivation::New(
+    HashType hash, absl::string_view root_key, absl::string_view salt,
+    size_t derived_key_size, size_t cache_size) {
+  if (derived_key_size != 16 && derived_key_size != 32) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "Invalid derived key size");
+  }
+  auto expander_result = HkdfExpander::New(hash, root_key, salt);
+  if (!expander_result.ok()) return expander_result.status();
+  std::unique_ptr<KeyDerivation> key_derivation(new HkdfAeadKeyDerivation(
+      std::move(expander_result.ValueOrDie()), derived_key_size, cache_size));
+  return std::move(key_derivation);
+}
+
+util::StatusOr<std::shared_ptr<Aead>> HkdfAeadKeyDerivation::DeriveAead(
+    absl::string_view context) const {
+  std::string key_context(context);
+  if (cache_size_ > 0) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = cache_.find(key_context);
+    if (it != cache_.end()) {
+      lru_.splice(lru_.begin(), lru_, it->second);
+      return it->second->second;
+    }
+  }
+
+  // Derives outside of the lock, so that a miss does not block the
+  // lookups of other threads.
+  auto key_result = expander_->Expand(context, derived_key_size_);
+  if (!key_result.ok()) return key_result.status();
+  std::string& key = key_result.ValueOrDie();
+  auto aead_result = AesGcmBoringSsl::New(key);
+  // The Aead keeps its own copy of the key.
+  OPENSSL_cleanse(&key[0], key.size());
+  if (!aead_result.ok()) return aead_result.status();
+  std::shared_ptr<Aead> aead(std::move(aead_result.ValueOrDie()));
+  if (cache_size_ == 0) return aead;
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = cache_.find(key_context);
+  if (it != cache_.end()) {
+    // Another thread derived the same context in the meantime.
+    lru_.splice(lru_.begin(), lru_, it->second);
+    return it->second->second;
+  }
+  lru_.emplace_front(key_context, aead);
+  cache_.emplace(std::move(key_context), lru_.begin());
+  if (lru_.size() > cache_size_) {
+    cache_.erase(lru_.back().first);
+    lru_.pop_back();
+  }
+  return aead;
+}
+
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
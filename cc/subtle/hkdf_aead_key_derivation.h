@@ -0,0 +1,81 @@
+// Copyright 2018 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_SUBTLE_HKDF_AEAD_KEY_DERIVATION_H_
+#define TINK_SUBTLE_HKDF_AEAD_KEY_DERIVATION_H_
+
+#include <list>
+#include <memory>
+#include <mutex>  // NOLINT(build/c++11)
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+#include "absl/strings/string_view.h"
+#include "tink/aead.h"
+#include "tink/key_derivation.h"
+#include "tink/subtle/common_enums.h"
+#include "tink/subtle/hkdf.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+
+// Derives AES-GCM Aeads from a root key with HKDF, using the context as
+// HKDF info:
+//   key = HKDF(hash, root_key, salt, context, derived_key_size).
+//
+// The HKDF extract step is done once in New(). The most recently used
+// derived Aeads are kept in a cache of at most 'cache_size' entries, so
+// deriving the Aead of a hot context again only costs a hash lookup.
+// A 'cache_size' of 0 disables the cache.
+class HkdfAeadKeyDerivation : public KeyDerivation {
+ public:
+  static crypto::tink::util::StatusOr<std::unique_ptr<KeyDerivation>> New(
+      HashType hash, absl::string_view root_key, absl::string_view salt,
+      size_t derived_key_size, size_t cache_size);
+
+  crypto::tink::util::StatusOr<std::shared_ptr<Aead>> DeriveAead(
+      absl::string_view context) const override;
+
+  virtual ~HkdfAeadKeyDerivation() {}
+
+ private:
+  // Least recently used contexts are at the back.
+  typedef std::list<std::pair<std::string, std::shared_ptr<Aead>>> LruList;
+
+  HkdfAeadKeyDerivation(std::unique_ptr<HkdfExpander> expander,
+                        size_t derived_key_size, size_t cache_size)
+      : expander_(std::move(expander)),
+        derived_key_size_(derived_key_size),
+        cache_size_(cache_size) {}
+
+  const std::unique_ptr<HkdfExpander> expander_;
+  const size_t derived_key_size_;
+  const size_t cache_size_;
+
+  mutable std::mutex mutex_;
+  mutable LruList lru_;  // guarded by mutex_
+  mutable std::unordered_map<std::string, LruList::iterator>
+      cache_;  // guarded by mutex_
+};
+
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_SUBTLE_HKDF_AEAD_KEY_DERIVATION_H_
@@ -0,0 +1,148 @@
+// Copyright 2018 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/subtle/hkdf_aead_key_derivation.h"
+
+#include <string>
+#include <thread>  // NOLINT(build/c++11)
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "absl/strings/str_cat.h"
+#include "tink/subtle/aes_gcm_boringssl.h"
+#include "tink/subtle/common_enums.h"
+#include "tink/subtle/hkdf.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+namespace {
+
+const char kRootKey[] = "0123456789abcdef0123456789abcdef";
+const char kSalt[] = "salt";
+
+TEST(HkdfAeadKeyDerivationTest, testMatchesHkdf) {
+  for (size_t key_size : {16, 32}) {
+    auto derivation = std::move(
+        HkdfAeadKeyDerivation::New(HashType::SHA256, kRootKey, kSalt,
+                                   key_size, /* cache_size= */ 10)
+            .ValueOrDie());
+    std::string context = "tenant-1";
+    auto derived = derivation->DeriveAead(context);
+    EXPECT_TRUE(derived.ok()) << derived.status();
+    std::string key = Hkdf::ComputeHkdf(HashType::SHA256, kRootKey, kSalt,
+                                        context, key_size).ValueOrDie();
+    auto expected = std::move(AesGcmBoringSsl::New(key).ValueOrDie());
+    std::string ct =
+        derived.ValueOrDie()->Encrypt("plaintext", "aad").ValueOrDie();
+    auto pt = expected->Decrypt(ct, "aad");
+    EXPECT_TRUE(pt.ok()) << pt.status();
+    EXPECT_EQ("plaintext", pt.ValueOrDie());
+  }
+}
+
+TEST(HkdfAeadKeyDerivationTest, testContextsAreIndependent) {
+  auto derivation = std::move(
+      HkdfAeadKeyDerivation::New(HashType::SHA256, kRootKey, kSalt, 16, 10)
+          .ValueOrDie());
+  auto aead1 = derivation->DeriveAead("tenant-1").ValueOrDie();
+  auto aead2 = derivation->DeriveAead("tenant-2").ValueOrDie();
+  std::string ct = aead1->Encrypt("plaintext", "aad").ValueOrDie();
+  EXPECT_TRUE(aead1->Decrypt(ct, "aad").ok());
+  EXPECT_FALSE(aead2->Decrypt(ct, "aad").ok());
+
+  // A different root key derives different keys for the same context.
+  auto other_derivation = std::move(
+      HkdfAeadKeyDerivation::New(HashType::SHA256, "another root key 0123",
+                                 kSalt, 16, 10).ValueOrDie());
+  auto other_aead1 = other_derivation->DeriveAead("tenant-1").ValueOrDie();
+  EXPECT_FALSE(other_aead1->Decrypt(ct, "aad").ok());
+}
+
+TEST(HkdfAeadKeyDerivationTest, testCache) {
+  auto derivation = std::move(
+      HkdfAeadKeyDerivation::New(HashType::SHA256, kRootKey, kSalt, 16,
+                                 /* cache_size= */ 2).ValueOrDie());
+  auto a = derivation->DeriveAead("a").ValueOrDie();
+  auto b = derivation->DeriveAead("b").ValueOrDie();
+  EXPECT_EQ(a.get(), derivation->DeriveAead("a").ValueOrDie().get());
+  EXPECT_EQ(b.get(), derivation->DeriveAead("b").ValueOrDie().get());
+  // "a" is the least recently used context and gets evicted by "c".
+  auto c = derivation->DeriveAead("c").ValueOrDie();
+  EXPECT_EQ(b.get(), derivation->DeriveAead("b").ValueOrDie().get());
+  EXPECT_EQ(c.get(), derivation->DeriveAead("c").ValueOrDie().get());
+  auto a2 = derivation->DeriveAead("a").ValueOrDie();
+  EXPECT_NE(a.get(), a2.get());
+  // The evicted Aead remains usable and is equivalent to the new one.
+  std::string ct = a->Encrypt("plaintext", "aad").ValueOrDie();
+  EXPECT_EQ("plaintext", a2->Decrypt(ct, "aad").ValueOrDie());
+}
+
+TEST(HkdfAeadKeyDerivationTest, testNoCache) {
+  auto derivation = std::move(
+      HkdfAeadKeyDerivation::New(HashType::SHA256, kRootKey, kSalt, 16,
+                                 /* cache_size= */ 0).ValueOrDie());
+  auto a = derivation->DeriveAead("a").ValueOrDie();
+  auto a2 = derivation->DeriveAead("a").ValueOrDie();
+  EXPECT_NE(a.get(), a2.get());
+  std::string ct = a->Encrypt("plaintext", "aad").ValueOrDie();
+  EXPECT_EQ("plaintext", a2->Decrypt(ct, "aad").ValueOrDie());
+}
+
+TEST(HkdfAeadKeyDerivationTest, testConcurrentDerivation) {
+  auto derivation = std::move(
+      HkdfAeadKeyDerivation::New(HashType::SHA256, kRootKey, kSalt, 16, 8)
+          .ValueOrDie());
+  std::string ct = derivation->DeriveAead("tenant-3")
+                       .ValueOrDie()->Encrypt("plaintext", "aad")
+                       .ValueOrDie();
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; t++) {
+    threads.emplace_back([&derivation, &ct, t]() {
+      for (int i = 0; i < 200; i++) {
+        std::string context = absl::StrCat("tenant-", (i + t) % 12);
+        auto aead = derivation->DeriveAead(context).ValueOrDie();
+        EXPECT_TRUE(aead->Encrypt("plaintext", "aad").ok());
+      }
+      auto aead = derivation->DeriveAead("tenant-3").ValueOrDie();
+      EXPECT_EQ("plaintext", aead->Decrypt(ct, "aad").ValueOrDie());
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
+
+TEST(HkdfAeadKeyDerivationTest, testInvalidParameters) {
+  EXPECT_FALSE(
+      HkdfAeadKeyDerivation::New(HashType::SHA256, kRootKey, kSalt, 24, 10)
+          .ok());
+  EXPECT_FALSE(
+      HkdfAeadKeyDerivation::New(HashType::UNKNOWN_HASH, kRootKey, kSalt, 16,
+                                 10).ok());
+}
+
+}  // namespace
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
+
+int main(int ac, char* av[]) {
+  testing::InitGoogleTest(&ac, av);
+  return RUN_ALL_TESTS();
+}
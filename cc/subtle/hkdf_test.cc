@@ -15,6 +15,10 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include "tink/subtle/hkdf.h"
+
+#include <string>
+#include <vector>
+
 #include "tink/subtle/common_enums.h"
 #include "tink/util/status.h"
 #include "tink/util/statusor.h"
@@ -111,6 +115,44 @@ TEST_F(HkdfTest, testLongOutput) {
   EXPECT_EQ(status_or_string.status().error_message(),
             "BoringSSL's HKDF failed");
 }
+
+TEST_F(HkdfTest, testExpander) {
+  for (const TestVector& test : test_vector) {
+    auto expander = std::move(
+        HkdfExpander::New(test.hash_type, test::HexDecodeOrDie(test.ikm_hex),
+                          test::HexDecodeOrDie(test.salt_hex))
+            .ValueOrDie());
+    // The expander can be used repeatedly.
+    for (int i = 0; i < 2; i++) {
+      EXPECT_EQ(test.out_key_hex,
+                test::HexEncode(
+                    expander->Expand(test::HexDecodeOrDie(test.info_hex),
+                                     test.out_len)
+                        .ValueOrDie()));
+    }
+  }
+}
+
+TEST_F(HkdfTest, testExpanderMatchesComputeHkdf) {
+  std::string ikm = "some input keying material";
+  auto expander =
+      std::move(HkdfExpander::New(HashType::SHA512, ikm, "").ValueOrDie());
+  for (size_t out_len : {0, 1, 16, 63, 64, 65, 200}) {
+    for (std::string info : {"", "tenant-1", "tenant-2"}) {
+      EXPECT_EQ(
+          Hkdf::ComputeHkdf(HashType::SHA512, ikm, "", info, out_len)
+              .ValueOrDie(),
+          expander->Expand(info, out_len).ValueOrDie());
+    }
+  }
+}
+
+TEST_F(HkdfTest, testExpanderLongOutput) {
+  auto expander =
+      std::move(HkdfExpander::New(HashType::SHA256, "ikm", "").ValueOrDie());
+  EXPECT_TRUE(expander->Expand("info", 255 * 32).ok());
+  EXPECT_FALSE(expander->Expand("info", 255 * 32 + 1).ok());
+}
 }  // namespace
 }  // namespace subtle
 }  // namespace tink
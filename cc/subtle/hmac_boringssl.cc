@@ -19,6 +19,7 @@
 #include <string>
 
 #include "tink/mac.h"
+#include "tink/output_buffer.h"
 #include "tink/subtle/common_enums.h"
 #include "tink/subtle/subtle_util_boringssl.h"
 #include "tink/util/errors.h"
@@ -61,6 +62,15 @@ HmacBoringSsl::HmacBoringSsl(const EVP_MD* md, uint32_t tag_size,
 
 util::StatusOr<std::string> HmacBoringSsl::ComputeMac(
     absl::string_view data) const {
+  std::string mac_value;
+  StringOutputBuffer output(&mac_value);
+  util::Status status = ComputeMacInto(data, &output);
+  if (!status.ok()) return status;
+  return std::move(mac_value);
+}
+
+util::Status HmacBoringSsl::ComputeMacInto(absl::string_view data,
+                                           OutputBuffer* mac_value) const {
   // BoringSSL expects a non-null pointer for data,
   // regardless of whether the size is 0.
   data = SubtleUtilBoringSSL::EnsureNonNull(data);
@@ -77,7 +87,8 @@ util::StatusOr<std::string> HmacBoringSsl::ComputeMac(
     return util::Status(util::error::INTERNAL,
                         "BoringSSL failed to compute HMAC");
   }
-  return std::string(reinterpret_cast<char*>(buf), tag_size_);
+  return WriteToOutputBuffer(
+      absl::string_view(reinterpret_cast<char*>(buf), tag_size_), mac_value);
 }
 
 util::Status HmacBoringSsl::VerifyMac(
@@ -21,6 +21,7 @@
 
 #include "absl/strings/string_view.h"
 #include "tink/mac.h"
+#include "tink/output_buffer.h"
 #include "tink/subtle/common_enums.h"
 #include "tink/util/status.h"
 #include "tink/util/statusor.h"
@@ -40,6 +41,10 @@ class HmacBoringSsl : public Mac {
   crypto::tink::util::StatusOr<std::string> ComputeMac(
       absl::string_view data) const override;
 
+  // Writes the HMAC for 'data' directly into 'mac_value'.
+  crypto::tink::util::Status ComputeMacInto(
+      absl::string_view data, OutputBuffer* mac_value) const override;
+
   // Verifies if 'mac' is a correct HMAC for 'data'.
   // Returns Status::OK if 'mac' is correct, and a non-OK-Status otherwise.
   crypto::tink::util::Status VerifyMac(
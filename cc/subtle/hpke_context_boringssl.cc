@@ -0,0 +1,384 @@
+// Copyright 2018 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/subtle/hpke_context_boringssl.h"
+
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "absl/memory/memory.h"
+#include "absl/strings/str_cat.h"
+#include "openssl/aead.h"
+#include "openssl/curve25519.h"
+#include "openssl/digest.h"
+#include "openssl/hkdf.h"
+#include "openssl/mem.h"
+#include "openssl/sha.h"
+#include "tink/subtle/subtle_util_boringssl.h"
+#include "tink/util/status.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+
+namespace {
+
+constexpr char kHpkeVersionLabel[] = "HPKE-v1";
+constexpr uint16_t kDhkemX25519HkdfSha256Id = 0x0020;
+constexpr uint16_t kHkdfSha256Id = 0x0001;
+constexpr int kNonceSize = 12;
+
+// Big-endian encoding of 'value' in 2 bytes (I2OSP(value, 2)).
+std::string TwoBytes(uint16_t value) {
+  return std::string({static_cast<char>(value >> 8),
+                      static_cast<char>(value & 0xff)});
+}
+
+std::string KemSuiteId() {
+  return absl::StrCat("KEM", TwoBytes(kDhkemX25519HkdfSha256Id));
+}
+
+std::string HpkeSuiteId(uint16_t aead_id) {
+  return absl::StrCat("HPKE", TwoBytes(kDhkemX25519HkdfSha256Id),
+                      TwoBytes(kHkdfSha256Id), TwoBytes(aead_id));
+}
+
+// Returns the RFC 9180 identifier of 'aead', or 0 if it is not supported.
+uint16_t AeadId(HpkeAead aead) {
+  switch (aead) {
+    case HpkeAead::AES_128_GCM:
+      return 0x0001;
+    case HpkeAead::AES_256_GCM:
+      return 0x0002;
+    case HpkeAead::CHACHA20_POLY1305:
+      return 0x0003;
+    default:
+      return 0;
+  }
+}
+
+const EVP_AEAD* EvpAead(HpkeAead aead) {
+  switch (aead) {
+    case HpkeAead::AES_128_GCM:
+      return EVP_aead_aes_128_gcm();
+    case HpkeAead::AES_256_GCM:
+      return EVP_aead_aes_256_gcm();
+    case HpkeAead::CHACHA20_POLY1305:
+      return EVP_aead_chacha20_poly1305();
+    default:
+      return nullptr;
+  }
+}
+
+// LabeledExtract() of https://tools.ietf.org/html/rfc9180#section-4.
+util::StatusOr<std::string> LabeledExtract(absl::string_view suite_id,
+                                           absl::string_view salt,
+                                           absl::string_view label,
+                                           absl::string_view ikm) {
+  std::string labeled_ikm =
+      absl::StrCat(kHpkeVersionLabel, suite_id, label, ikm);
+  salt = SubtleUtilBoringSSL::EnsureNonNull(salt);
+  uint8_t prk[EVP_MAX_MD_SIZE];
+  size_t prk_len;
+  if (HKDF_extract(prk, &prk_len, EVP_sha256(),
+                   reinterpret_cast<const uint8_t*>(labeled_ikm.data()),
+                   labeled_ikm.size(),
+                   reinterpret_cast<const uint8_t*>(salt.data()),
+                   salt.size()) != 1) {
+    return util::Status(util::error::INTERNAL, "HKDF_extract failed");
+  }
+  OPENSSL_cleanse(&labeled_ikm[0], labeled_ikm.size());
+  std::string out(reinterpret_cast<const char*>(prk), prk_len);
+  OPENSSL_cleanse(prk, sizeof(prk));
+  return out;
+}
+
+// LabeledExpand() of https://tools.ietf.org/html/rfc9180#section-4.
+util::StatusOr<std::string> LabeledExpand(absl::string_view suite_id,
+                                          absl::string_view prk,
+                                          absl::string_view label,
+                                          absl::string_view info,
+                                          uint16_t length) {
+  std::string labeled_info =
+      absl::StrCat(TwoBytes(length), kHpkeVersionLabel, suite_id, label, info);
+  std::string out(length, '\0');
+  if (HKDF_expand(reinterpret_cast<uint8_t*>(&out[0]), out.size(),
+                  EVP_sha256(), reinterpret_cast<const uint8_t*>(prk.data()),
+                  prk.size(),
+                  reinterpret_cast<const uint8_t*>(labeled_info.data()),
+                  labeled_info.size()) != 1) {
+    return util::Status(util::error::INTERNAL, "HKDF_expand failed");
+  }
+  return out;
+}
+
+// ExtractAndExpand() of DHKEM,
+// https://tools.ietf.org/html/rfc9180#section-4.1.
+util::StatusOr<std::string> ExtractAndExpand(absl::string_view dh,
+                                             absl::string_view kem_context) {
+  const std::string suite_id = KemSuiteId();
+  auto eae_prk = LabeledExtract(suite_id, "", "eae_prk", dh);
+  if (!eae_prk.ok()) return eae_prk.status();
+  return LabeledExpand(suite_id, eae_prk.ValueOrDie(), "shared_secret",
+                       kem_context, SHA256_DIGEST_LENGTH);
+}
+
+// Computes the X25519 shared secret of 'private_key' and 'public_key', and
+// derives the KEM shared secret from it.
+util::StatusOr<std::string> DhkemSharedSecret(absl::string_view private_key,
+                                              absl::string_view public_key,
+                                              absl::string_view enc,
+                                              absl::string_view pk_rm) {
+  uint8_t dh[X25519_SHARED_KEY_LEN];
+  if (X25519(dh, reinterpret_cast<const uint8_t*>(private_key.data()),
+             reinterpret_cast<const uint8_t*>(public_key.data())) != 1) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "X25519 key agreement failed");
+  }
+  auto shared_secret = ExtractAndExpand(
+      absl::string_view(reinterpret_cast<const char*>(dh), sizeof(dh)),
+      absl::StrCat(enc, pk_rm));
+  OPENSSL_cleanse(dh, sizeof(dh));
+  return shared_secret;
+}
+
+// KeySchedule() of https://tools.ietf.org/html/rfc9180#section-5.1 for
+// mode_base. Stores the AEAD key in 'key' and the base nonce in
+// 'base_nonce'.
+util::Status KeySchedule(HpkeAead aead, absl::string_view shared_secret,
+                         absl::string_view info, std::string* key,
+                         std::string* base_nonce) {
+  const EVP_AEAD* evp_aead = EvpAead(aead);
+  const std::string suite_id = HpkeSuiteId(AeadId(aead));
+  auto psk_id_hash = LabeledExtract(suite_id, "", "psk_id_hash", "");
+  if (!psk_id_hash.ok()) return psk_id_hash.status();
+  auto info_hash = LabeledExtract(suite_id, "", "info_hash", info);
+  if (!info_hash.ok()) return info_hash.status();
+  std::string key_schedule_context = absl::StrCat(
+      std::string(1, '\0'), psk_id_hash.ValueOrDie(), info_hash.ValueOrDie());
+  auto secret = LabeledExtract(suite_id, shared_secret, "secret", "");
+  if (!secret.ok()) return secret.status();
+  auto key_or = LabeledExpand(suite_id, secret.ValueOrDie(), "key",
+                              key_schedule_context,
+                              EVP_AEAD_key_length(evp_aead));
+  if (!key_or.ok()) return key_or.status();
+  auto base_nonce_or = LabeledExpand(suite_id, secret.ValueOrDie(),
+                                     "base_nonce", key_schedule_context,
+                                     kNonceSize);
+  if (!base_nonce_or.ok()) return base_nonce_or.status();
+  *key = std::move(key_or.ValueOrDie());
+  *base_nonce = std::move(base_nonce_or.ValueOrDie());
+  return util::Status::OK;
+}
+
+}  // namespace
+
+// static
+util::StatusOr<std::unique_ptr<HpkeContextBoringSsl>>
+HpkeContextBoringSsl::SetupSender(HpkeAead aead,
+                                  absl::string_view recipient_public_key,
+                                  absl::string_view info,
+                                  std::string* encapsulated_key) {
+  uint8_t ephemeral_public_key[X25519_PUBLIC_VALUE_LEN];
+  uint8_t ephemeral_private_key[X25519_PRIVATE_KEY_LEN];
+  X25519_keypair(ephemeral_public_key, ephemeral_private_key);
+  auto context = SetupSenderWithEphemeralKeyForTesting(
+      aead, recipient_public_key,
+      absl::string_view(reinterpret_cast<const char*>(ephemeral_private_key),
+                        sizeof(ephemeral_private_key)),
+      info, encapsulated_key);
+  OPENSSL_cleanse(ephemeral_private_key, sizeof(ephemeral_private_key));
+  return context;
+}
+
+// static
+util::StatusOr<std::unique_ptr<HpkeContextBoringSsl>>
+HpkeContextBoringSsl::SetupSenderWithEphemeralKeyForTesting(
+    HpkeAead aead, absl::string_view recipient_public_key,
+    absl::string_view ephemeral_private_key, absl::string_view info,
+    std::string* encapsulated_key) {
+  const EVP_AEAD* evp_aead = EvpAead(aead);
+  if (evp_aead == nullptr) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "Unsupported HPKE AEAD");
+  }
+  if (recipient_public_key.size() != kX25519KeySize ||
+      ephemeral_private_key.size() != kX25519KeySize) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "Invalid X25519 key size");
+  }
+  uint8_t ephemeral_public_key[X25519_PUBLIC_VALUE_LEN];
+  X25519_public_from_private(
+      ephemeral_public_key,
+      reinterpret_cast<const uint8_t*>(ephemeral_private_key.data()));
+  std::string enc(reinterpret_cast<const char*>(ephemeral_public_key),
+                  sizeof(ephemeral_public_key));
+
+  auto shared_secret =
+      DhkemSharedSecret(ephemeral_private_key, recipient_public_key, enc,
+                        recipient_public_key);
+  if (!shared_secret.ok()) return shared_secret.status();
+
+  std::string key;
+  std::string base_nonce;
+  util::Status status =
+      KeySchedule(aead, shared_secret.ValueOrDie(), info, &key, &base_nonce);
+  if (!status.ok()) return status;
+  bssl::UniquePtr<EVP_AEAD_CTX> aead_ctx(EVP_AEAD_CTX_new(
+      evp_aead, reinterpret_cast<const uint8_t*>(key.data()), key.size(),
+      EVP_AEAD_DEFAULT_TAG_LENGTH));
+  OPENSSL_cleanse(&key[0], key.size());
+  if (aead_ctx == nullptr) {
+    return util::Status(util::error::INTERNAL,
+                        "could not initialize EVP_AEAD_CTX");
+  }
+  *encapsulated_key = std::move(enc);
+  return absl::WrapUnique(
+      new HpkeContextBoringSsl(evp_aead, std::move(aead_ctx),
+                               std::move(base_nonce)));
+}
+
+// static
+util::StatusOr<std::unique_ptr<HpkeContextBoringSsl>>
+HpkeContextBoringSsl::SetupRecipient(HpkeAead aead,
+                                     absl::string_view recipient_private_key,
+                                     absl::string_view encapsulated_key,
+                                     absl::string_view info) {
+  const EVP_AEAD* evp_aead = EvpAead(aead);
+  if (evp_aead == nullptr) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "Unsupported HPKE AEAD");
+  }
+  if (recipient_private_key.size() != kX25519KeySize ||
+      encapsulated_key.size() != kX25519KeySize) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "Invalid X25519 key size");
+  }
+  uint8_t recipient_public_key[X25519_PUBLIC_VALUE_LEN];
+  X25519_public_from_private(
+      recipient_public_key,
+      reinterpret_cast<const uint8_t*>(recipient_private_key.data()));
+
+  auto shared_secret = DhkemSharedSecret(
+      recipient_private_key, encapsulated_key, encapsulated_key,
+      absl::string_view(reinterpret_cast<const char*>(recipient_public_key),
+                        sizeof(recipient_public_key)));
+  if (!shared_secret.ok()) return shared_secret.status();
+
+  std::string key;
+  std::string base_nonce;
+  util::Status status =
+      KeySchedule(aead, shared_secret.ValueOrDie(), info, &key, &base_nonce);
+  if (!status.ok()) return status;
+  bssl::UniquePtr<EVP_AEAD_CTX> aead_ctx(EVP_AEAD_CTX_new(
+      evp_aead, reinterpret_cast<const uint8_t*>(key.data()), key.size(),
+      EVP_AEAD_DEFAULT_TAG_LENGTH));
+  OPENSSL_cleanse(&key[0], key.size());
+  if (aead_ctx == nullptr) {
+    return util::Status(util::error::INTERNAL,
+                        "could not initialize EVP_AEAD_CTX");
+  }
+  return absl::WrapUnique(
+      new HpkeContextBoringSsl(evp_aead, std::move(aead_ctx),
+                               std::move(base_nonce)));
+}
+
+util::StatusOr<std::string> HpkeContextBoringSsl::ComputeNonce(
+    uint64_t sequence_number) const {
+  if (sequence_number == std::numeric_limits<uint64_t>::max()) {
+    return util::Status(util::error::FAILED_PRECONDITION,
+                        "HPKE message limit reached");
+  }
+  // nonce = base_nonce XOR I2OSP(seq, Nn)
+  std::string nonce = base_nonce_;
+  uint64_t seq = sequence_number;
+  for (int i = 0; i < 8; i++) {
+    nonce[kNonceSize - 1 - i] ^= static_cast<char>(seq & 0xff);
+    seq >>= 8;
+  }
+  return nonce;
+}
+
+util::StatusOr<std::string> HpkeContextBoringSsl::Seal(
+    absl::string_view plaintext, absl::string_view associated_data) {
+  auto result =
+      SealWithSequenceNumber(sequence_number_, plaintext, associated_data);
+  if (result.ok()) sequence_number_++;
+  return result;
+}
+
+util::StatusOr<std::string> HpkeContextBoringSsl::Open(
+    absl::string_view ciphertext, absl::string_view associated_data) {
+  auto result =
+      OpenWithSequenceNumber(sequence_number_, ciphertext, associated_data);
+  if (result.ok()) sequence_number_++;
+  return result;
+}
+
+util::StatusOr<std::string> HpkeContextBoringSsl::SealWithSequenceNumber(
+    uint64_t sequence_number, absl::string_view plaintext,
+    absl::string_view associated_data) const {
+  auto nonce = ComputeNonce(sequence_number);
+  if (!nonce.ok()) return nonce.status();
+  // BoringSSL expects a non-null pointer for plaintext and associated_data,
+  // regardless of whether the size is 0.
+  plaintext = SubtleUtilBoringSSL::EnsureNonNull(plaintext);
+  associated_data = SubtleUtilBoringSSL::EnsureNonNull(associated_data);
+
+  std::vector<uint8_t> ct(plaintext.size() + EVP_AEAD_max_overhead(aead_) +
+                          1);
+  size_t ct_len = 0;
+  if (EVP_AEAD_CTX_seal(
+          aead_ctx_.get(), ct.data(), &ct_len, ct.size(),
+          reinterpret_cast<const uint8_t*>(nonce.ValueOrDie().data()),
+          nonce.ValueOrDie().size(),
+          reinterpret_cast<const uint8_t*>(plaintext.data()), plaintext.size(),
+          reinterpret_cast<const uint8_t*>(associated_data.data()),
+          associated_data.size()) != 1) {
+    return util::Status(util::error::INTERNAL, "EVP_AEAD_CTX_seal failed");
+  }
+  return std::string(reinterpret_cast<const char*>(ct.data()), ct_len);
+}
+
+util::StatusOr<std::string> HpkeContextBoringSsl::OpenWithSequenceNumber(
+    uint64_t sequence_number, absl::string_view ciphertext,
+    absl::string_view associated_data) const {
+  auto nonce = ComputeNonce(sequence_number);
+  if (!nonce.ok()) return nonce.status();
+  ciphertext = SubtleUtilBoringSSL::EnsureNonNull(ciphertext);
+  associated_data = SubtleUtilBoringSSL::EnsureNonNull(associated_data);
+
+  std::vector<uint8_t> pt(ciphertext.size() + 1);
+  size_t pt_len = 0;
+  if (EVP_AEAD_CTX_open(
+          aead_ctx_.get(), pt.data(), &pt_len, pt.size(),
+          reinterpret_cast<const uint8_t*>(nonce.ValueOrDie().data()),
+          nonce.ValueOrDie().size(),
+          reinterpret_cast<const uint8_t*>(ciphertext.data()),
+          ciphertext.size(),
+          reinterpret_cast<const uint8_t*>(associated_data.data()),
+          associated_data.size()) != 1) {
+    // Do not reveal why decryption failed.
+    SubtleUtilBoringSSL::GetErrors();
+    return util::Status(util::error::INVALID_ARGUMENT, "Decryption failed");
+  }
+  return std::string(reinterpret_cast<const char*>(pt.data()), pt_len);
+}
+
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
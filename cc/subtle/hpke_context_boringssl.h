@@ -0,0 +1,110 @@
+// Copyright 2018 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_SUBTLE_HPKE_CONTEXT_BORINGSSL_H_
+#define TINK_SUBTLE_HPKE_CONTEXT_BORINGSSL_H_
+
+#include <memory>
+#include <string>
+
+#include "absl/strings/string_view.h"
+#include "openssl/aead.h"
+#include "openssl/base.h"
+#include "tink/subtle/common_enums.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+
+// An HPKE encryption context in base mode, as defined in
+// https://tools.ietf.org/html/rfc9180#section-5.1, for the ciphersuite
+// DHKEM(X25519, HKDF-SHA256), HKDF-SHA256 and the given AEAD.
+// This implementation uses Boring SSL for the underlying cryptographic
+// operations.
+//
+// Seal() and Open() advance the sequence number used to derive the AEAD
+// nonce, and are not thread-safe. SealWithSequenceNumber() and
+// OpenWithSequenceNumber() take the sequence number from the caller instead,
+// and can be called concurrently; the caller must never seal two messages
+// with the same sequence number.
+class HpkeContextBoringSsl {
+ public:
+  static constexpr int kX25519KeySize = 32;
+
+  // Encapsulates a fresh shared secret to 'recipient_public_key' and
+  // returns the sender's context. The encapsulated key, which is sent to
+  // the recipient, is stored in 'encapsulated_key'.
+  static crypto::tink::util::StatusOr<std::unique_ptr<HpkeContextBoringSsl>>
+  SetupSender(HpkeAead aead, absl::string_view recipient_public_key,
+              absl::string_view info, std::string* encapsulated_key);
+
+  // Same as SetupSender(), but with a fixed ephemeral private key.
+  // Only for known-answer tests, never use it to encrypt real data.
+  static crypto::tink::util::StatusOr<std::unique_ptr<HpkeContextBoringSsl>>
+  SetupSenderWithEphemeralKeyForTesting(
+      HpkeAead aead, absl::string_view recipient_public_key,
+      absl::string_view ephemeral_private_key, absl::string_view info,
+      std::string* encapsulated_key);
+
+  // Decapsulates 'encapsulated_key' with 'recipient_private_key' and
+  // returns the recipient's context.
+  static crypto::tink::util::StatusOr<std::unique_ptr<HpkeContextBoringSsl>>
+  SetupRecipient(HpkeAead aead, absl::string_view recipient_private_key,
+                 absl::string_view encapsulated_key, absl::string_view info);
+
+  // Encrypts 'plaintext' with the next nonce of the context.
+  crypto::tink::util::StatusOr<std::string> Seal(
+      absl::string_view plaintext, absl::string_view associated_data);
+
+  // Decrypts 'ciphertext' with the next nonce of the context.
+  crypto::tink::util::StatusOr<std::string> Open(
+      absl::string_view ciphertext, absl::string_view associated_data);
+
+  // Encrypts 'plaintext' with the nonce for 'sequence_number'.
+  crypto::tink::util::StatusOr<std::string> SealWithSequenceNumber(
+      uint64_t sequence_number, absl::string_view plaintext,
+      absl::string_view associated_data) const;
+
+  // Decrypts 'ciphertext' with the nonce for 'sequence_number'.
+  crypto::tink::util::StatusOr<std::string> OpenWithSequenceNumber(
+      uint64_t sequence_number, absl::string_view ciphertext,
+      absl::string_view associated_data) const;
+
+ private:
+  HpkeContextBoringSsl(const EVP_AEAD* aead,
+                       bssl::UniquePtr<EVP_AEAD_CTX> aead_ctx,
+                       std::string base_nonce)
+      : aead_(aead),
+        aead_ctx_(std::move(aead_ctx)),
+        base_nonce_(std::move(base_nonce)),
+        sequence_number_(0) {}
+
+  // Returns the nonce for 'sequence_number'.
+  crypto::tink::util::StatusOr<std::string> ComputeNonce(
+      uint64_t sequence_number) const;
+
+  const EVP_AEAD* aead_;  // Owned by BoringSSL.
+  const bssl::UniquePtr<EVP_AEAD_CTX> aead_ctx_;
+  const std::string base_nonce_;
+  uint64_t sequence_number_;
+};
+
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_SUBTLE_HPKE_CONTEXT_BORINGSSL_H_
@@ -0,0 +1,211 @@
+// Copyright 2018 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/subtle/hpke_context_boringssl.h"
+
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "openssl/curve25519.h"
+#include "tink/subtle/common_enums.h"
+#include "tink/util/test_util.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+namespace {
+
+// Test vector from https://tools.ietf.org/html/rfc9180#appendix-A.1
+// (DHKEM(X25519, HKDF-SHA256), HKDF-SHA256, AES-128-GCM, base mode).
+struct Rfc9180TestVector {
+  std::string recipient_public_key;
+  std::string recipient_private_key;
+  std::string ephemeral_private_key;
+  std::string encapsulated_key;
+  std::string info;
+};
+
+Rfc9180TestVector GetRfc9180TestVector() {
+  return {
+      test::HexDecodeOrDie(
+          "3948cfe0ad1ddb695d780e59077195da6c56506b027329794ab02bca80815c4d"),
+      test::HexDecodeOrDie(
+          "4612c550263fc8ad58375df3f557aac531d26850903e55a9f23f21d8534e8ac8"),
+      test::HexDecodeOrDie(
+          "52c4a758a802cd8b936eceea314432798d5baf2d7e9235dc084ab1b9cfa2f736"),
+      test::HexDecodeOrDie(
+          "37fda3567bdbd628e88668c3c8d7e97d1d1253b6d4ea6d44c150f741f1bf4431"),
+      test::HexDecodeOrDie("4f6465206f6e2061204772656369616e2055726e")};
+}
+
+TEST(HpkeContextBoringSslTest, testRfc9180Vector) {
+  Rfc9180TestVector vector = GetRfc9180TestVector();
+  std::string plaintext = test::HexDecodeOrDie(
+      "4265617574792069732074727574682c20747275746820626561757479");
+  struct {
+    std::string associated_data;
+    std::string ciphertext;
+  } encryptions[] = {
+      {test::HexDecodeOrDie("436f756e742d30"),
+       test::HexDecodeOrDie("f938558b5d72f1a23810b4be2ab4f84331acc02fc97babc5"
+                            "3a52ae8218a355a96d8770ac83d07bea87e13c512a")},
+      {test::HexDecodeOrDie("436f756e742d31"),
+       test::HexDecodeOrDie("af2d7e9ac9ae7e270f46ba1f975be53c09f8d875bdc85354"
+                            "58c2494e8a6eab251c03d0c22a56b8ca42c2063b84")}};
+
+  std::string encapsulated_key;
+  auto sender_result =
+      HpkeContextBoringSsl::SetupSenderWithEphemeralKeyForTesting(
+          HpkeAead::AES_128_GCM, vector.recipient_public_key,
+          vector.ephemeral_private_key, vector.info, &encapsulated_key);
+  ASSERT_TRUE(sender_result.ok()) << sender_result.status();
+  auto sender = std::move(sender_result.ValueOrDie());
+  EXPECT_EQ(vector.encapsulated_key, encapsulated_key);
+
+  auto recipient_result = HpkeContextBoringSsl::SetupRecipient(
+      HpkeAead::AES_128_GCM, vector.recipient_private_key, encapsulated_key,
+      vector.info);
+  ASSERT_TRUE(recipient_result.ok()) << recipient_result.status();
+  auto recipient = std::move(recipient_result.ValueOrDie());
+
+  for (const auto& encryption : encryptions) {
+    auto seal_result = sender->Seal(plaintext, encryption.associated_data);
+    ASSERT_TRUE(seal_result.ok()) << seal_result.status();
+    EXPECT_EQ(test::HexEncode(encryption.ciphertext),
+              test::HexEncode(seal_result.ValueOrDie()));
+
+    auto open_result =
+        recipient->Open(encryption.ciphertext, encryption.associated_data);
+    ASSERT_TRUE(open_result.ok()) << open_result.status();
+    EXPECT_EQ(plaintext, open_result.ValueOrDie());
+  }
+}
+
+TEST(HpkeContextBoringSslTest, testEncryptDecrypt) {
+  uint8_t public_key[X25519_PUBLIC_VALUE_LEN];
+  uint8_t private_key[X25519_PRIVATE_KEY_LEN];
+  X25519_keypair(public_key, private_key);
+  std::string recipient_public_key(reinterpret_cast<char*>(public_key),
+                                   X25519_PUBLIC_VALUE_LEN);
+  std::string recipient_private_key(reinterpret_cast<char*>(private_key),
+                                    X25519_PRIVATE_KEY_LEN);
+  std::string info = "some info";
+  std::string plaintext = "some plaintext";
+  std::string associated_data = "some associated data";
+
+  for (HpkeAead aead : {HpkeAead::AES_128_GCM, HpkeAead::AES_256_GCM,
+                        HpkeAead::CHACHA20_POLY1305}) {
+    SCOPED_TRACE(static_cast<int>(aead));
+    std::string encapsulated_key;
+    auto sender_result = HpkeContextBoringSsl::SetupSender(
+        aead, recipient_public_key, info, &encapsulated_key);
+    ASSERT_TRUE(sender_result.ok()) << sender_result.status();
+    auto ciphertext_result =
+        sender_result.ValueOrDie()->Seal(plaintext, associated_data);
+    ASSERT_TRUE(ciphertext_result.ok()) << ciphertext_result.status();
+    std::string ciphertext = ciphertext_result.ValueOrDie();
+
+    auto recipient_result = HpkeContextBoringSsl::SetupRecipient(
+        aead, recipient_private_key, encapsulated_key, info);
+    ASSERT_TRUE(recipient_result.ok()) << recipient_result.status();
+    auto recipient = std::move(recipient_result.ValueOrDie());
+    // A failed Open() must not advance the sequence number.
+    EXPECT_FALSE(recipient->Open(ciphertext, "wrong associated data").ok());
+    auto plaintext_result = recipient->Open(ciphertext, associated_data);
+    ASSERT_TRUE(plaintext_result.ok()) << plaintext_result.status();
+    EXPECT_EQ(plaintext, plaintext_result.ValueOrDie());
+
+    // A context bound to a different info cannot decrypt.
+    auto other_recipient = std::move(
+        HpkeContextBoringSsl::SetupRecipient(aead, recipient_private_key,
+                                             encapsulated_key, "other info")
+            .ValueOrDie());
+    EXPECT_FALSE(other_recipient->Open(ciphertext, associated_data).ok());
+  }
+}
+
+TEST(HpkeContextBoringSslTest, testExplicitSequenceNumbers) {
+  Rfc9180TestVector vector = GetRfc9180TestVector();
+  std::string encapsulated_key;
+  auto sender = std::move(
+      HpkeContextBoringSsl::SetupSenderWithEphemeralKeyForTesting(
+          HpkeAead::AES_128_GCM, vector.recipient_public_key,
+          vector.ephemeral_private_key, vector.info, &encapsulated_key)
+          .ValueOrDie());
+  std::vector<std::string> ciphertexts;
+  for (int i = 0; i < 3; i++) {
+    ciphertexts.push_back(
+        sender->Seal("message " + std::to_string(i), "aad").ValueOrDie());
+  }
+  // Sealing with an explicit sequence number matches Seal().
+  EXPECT_EQ(ciphertexts[1],
+            sender->SealWithSequenceNumber(1, "message 1", "aad")
+                .ValueOrDie());
+
+  // Messages can be opened in any order, without advancing the context.
+  auto recipient = std::move(
+      HpkeContextBoringSsl::SetupRecipient(
+          HpkeAead::AES_128_GCM, vector.recipient_private_key,
+          encapsulated_key, vector.info)
+          .ValueOrDie());
+  for (int i = 2; i >= 0; i--) {
+    auto result = recipient->OpenWithSequenceNumber(i, ciphertexts[i], "aad");
+    ASSERT_TRUE(result.ok()) << result.status();
+    EXPECT_EQ("message " + std::to_string(i), result.ValueOrDie());
+    EXPECT_FALSE(
+        recipient->OpenWithSequenceNumber(i + 1, ciphertexts[i], "aad").ok());
+  }
+  EXPECT_EQ("message 0", recipient->Open(ciphertexts[0], "aad").ValueOrDie());
+  EXPECT_FALSE(recipient
+                   ->OpenWithSequenceNumber(
+                       std::numeric_limits<uint64_t>::max(), ciphertexts[0],
+                       "aad")
+                   .ok());
+}
+
+TEST(HpkeContextBoringSslTest, testInvalidParameters) {
+  Rfc9180TestVector vector = GetRfc9180TestVector();
+  std::string encapsulated_key;
+  EXPECT_FALSE(HpkeContextBoringSsl::SetupSender(
+                   HpkeAead::UNKNOWN_HPKE_AEAD, vector.recipient_public_key,
+                   vector.info, &encapsulated_key)
+                   .ok());
+  EXPECT_FALSE(HpkeContextBoringSsl::SetupSender(
+                   HpkeAead::AES_128_GCM,
+                   vector.recipient_public_key.substr(1), vector.info,
+                   &encapsulated_key)
+                   .ok());
+  EXPECT_FALSE(HpkeContextBoringSsl::SetupRecipient(
+                   HpkeAead::AES_128_GCM, vector.recipient_private_key,
+                   vector.encapsulated_key.substr(1), vector.info)
+                   .ok());
+  EXPECT_FALSE(HpkeContextBoringSsl::SetupRecipient(
+                   HpkeAead::AES_128_GCM, "", vector.encapsulated_key,
+                   vector.info)
+                   .ok());
+}
+
+}  // namespace
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
+
+int main(int ac, char* av[]) {
+  testing::InitGoogleTest(&ac, av);
+  return RUN_ALL_TESTS();
+}
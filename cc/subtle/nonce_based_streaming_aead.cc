@@ -0,0 +1,230 @@
+// Copyright 2018 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/subtle/nonce_based_streaming_aead.h"
+
+#include <string.h>
+
+#include <vector>
+
+#include "tink/subtle/parallel_for.h"
+#include "tink/util/errors.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+
+namespace {
+
+// Segment numbers are encoded with 4 bytes in the nonces.
+const uint64_t kMaxSegments = 1ULL << 32;
+
+}  // namespace
+
+NonceBasedStreamingAead::NonceBasedStreamingAead(
+    size_t header_size, size_t ciphertext_segment_size, size_t tag_size)
+    : header_size_(header_size),
+      ciphertext_segment_size_(ciphertext_segment_size),
+      plaintext_segment_size_(ciphertext_segment_size - tag_size),
+      tag_size_(tag_size) {}
+
+uint64_t NonceBasedStreamingAead::NumSegments(uint64_t plaintext_size) const {
+  return (plaintext_size + header_size_ + plaintext_segment_size_ - 1) /
+         plaintext_segment_size_;
+}
+
+uint64_t NonceBasedStreamingAead::PlaintextStart(uint64_t segment) const {
+  return segment == 0 ? 0 : segment * plaintext_segment_size_ - header_size_;
+}
+
+uint64_t NonceBasedStreamingAead::CiphertextStart(uint64_t segment) const {
+  return segment == 0 ? header_size_ : segment * ciphertext_segment_size_;
+}
+
+uint64_t NonceBasedStreamingAead::CiphertextSize(
+    uint64_t plaintext_size) const {
+  return plaintext_size + header_size_ +
+         NumSegments(plaintext_size) * tag_size_;
+}
+
+util::StatusOr<uint64_t> NonceBasedStreamingAead::PlaintextSize(
+    uint64_t ciphertext_size) const {
+  if (ciphertext_size < header_size_ + tag_size_) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "Ciphertext too short.");
+  }
+  uint64_t num_segments = (ciphertext_size + ciphertext_segment_size_ - 1) /
+                          ciphertext_segment_size_;
+  uint64_t last_segment_size =
+      ciphertext_size - (num_segments - 1) * ciphertext_segment_size_;
+  // Only the first segment can be empty.
+  if (num_segments > kMaxSegments ||
+      (num_segments > 1 && last_segment_size <= tag_size_)) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "Invalid ciphertext size.");
+  }
+  return ciphertext_size - header_size_ - num_segments * tag_size_;
+}
+
+util::Status NonceBasedStreamingAead::ForEachSegment(
+    uint64_t begin, uint64_t end,
+    const SegmentFunction& segment_function) const {
+  return ParallelFor(
+      begin, end, ciphertext_segment_size_, [&]() -> ItemFunction {
+        std::vector<char> plaintext_buffer(ciphertext_segment_size_);
+        std::vector<char> ciphertext_buffer(ciphertext_segment_size_);
+        return [&segment_function, plaintext_buffer, ciphertext_buffer](
+                   uint64_t segment) mutable {
+          return segment_function(segment, plaintext_buffer.data(),
+                                  ciphertext_buffer.data());
+        };
+      });
+}
+
+util::Status NonceBasedStreamingAead::Encrypt(
+    RandomAccessStream* plaintext, absl::string_view associated_data,
+    RandomAccessSink* ciphertext) const {
+  auto size_result = plaintext->size();
+  if (!size_result.ok()) return size_result.status();
+  uint64_t plaintext_size = size_result.ValueOrDie();
+  uint64_t num_segments = NumSegments(plaintext_size);
+  if (num_segments > kMaxSegments) {
+    return util::Status(util::error::INVALID_ARGUMENT, "Plaintext too long.");
+  }
+  std::string header;
+  auto cipher_result = NewSegmentEncrypter(associated_data, &header);
+  if (!cipher_result.ok()) return cipher_result.status();
+  const StreamSegmentCipher& cipher = *cipher_result.ValueOrDie();
+  util::Status status = ciphertext->PWrite(0, header);
+  if (!status.ok()) return status;
+
+  return ForEachSegment(
+      0, num_segments,
+      [&](uint64_t segment, char* plaintext_buffer, char* ciphertext_buffer) {
+        bool is_last_segment = segment + 1 == num_segments;
+        uint64_t begin = PlaintextStart(segment);
+        uint64_t end =
+            is_last_segment ? plaintext_size : PlaintextStart(segment + 1);
+        size_t segment_size = end - begin;
+        util::Status status =
+            plaintext->PRead(begin, segment_size, plaintext_buffer);
+        if (!status.ok()) return status;
+        status = cipher.EncryptSegment(
+            absl::string_view(plaintext_buffer, segment_size), segment,
+            is_last_segment, ciphertext_buffer);
+        if (!status.ok()) return status;
+        return ciphertext->PWrite(
+            CiphertextStart(segment),
+            absl::string_view(ciphertext_buffer, segment_size + tag_size_));
+      });
+}
+
+util::Status NonceBasedStreamingAead::Decrypt(
+    RandomAccessStream* ciphertext, absl::string_view associated_data,
+    RandomAccessSink* plaintext) const {
+  auto size_result = ciphertext->size();
+  if (!size_result.ok()) return size_result.status();
+  uint64_t ciphertext_size = size_result.ValueOrDie();
+  auto plaintext_size_result = PlaintextSize(ciphertext_size);
+  if (!plaintext_size_result.ok()) return plaintext_size_result.status();
+  uint64_t num_segments = NumSegments(plaintext_size_result.ValueOrDie());
+  std::string header(header_size_, '\0');
+  util::Status status = ciphertext->PRead(0, header_size_, &header[0]);
+  if (!status.ok()) return status;
+  auto cipher_result = NewSegmentDecrypter(header, associated_data);
+  if (!cipher_result.ok()) return cipher_result.status();
+  const StreamSegmentCipher& cipher = *cipher_result.ValueOrDie();
+
+  return ForEachSegment(
+      0, num_segments,
+      [&](uint64_t segment, char* plaintext_buffer, char* ciphertext_buffer) {
+        bool is_last_segment = segment + 1 == num_segments;
+        uint64_t begin = CiphertextStart(segment);
+        uint64_t end =
+            is_last_segment ? ciphertext_size : CiphertextStart(segment + 1);
+        size_t segment_size = end - begin;
+        util::Status status =
+            ciphertext->PRead(begin, segment_size, ciphertext_buffer);
+        if (!status.ok()) return status;
+        status = cipher.DecryptSegment(
+            absl::string_view(ciphertext_buffer, segment_size), segment,
+            is_last_segment, plaintext_buffer);
+        if (!status.ok()) return status;
+        return plaintext->PWrite(
+            PlaintextStart(segment),
+            absl::string_view(plaintext_buffer, segment_size - tag_size_));
+      });
+}
+
+util::StatusOr<std::string> NonceBasedStreamingAead::DecryptRange(
+    RandomAccessStream* ciphertext, absl::string_view associated_data,
+    uint64_t position, size_t count) const {
+  auto size_result = ciphertext->size();
+  if (!size_result.ok()) return size_result.status();
+  uint64_t ciphertext_size = size_result.ValueOrDie();
+  auto plaintext_size_result = PlaintextSize(ciphertext_size);
+  if (!plaintext_size_result.ok()) return plaintext_size_result.status();
+  uint64_t plaintext_size = plaintext_size_result.ValueOrDie();
+  if (position > plaintext_size || count > plaintext_size - position) {
+    return util::Status(util::error::OUT_OF_RANGE,
+                        "Range exceeds the plaintext.");
+  }
+  if (count == 0) return std::string();
+  uint64_t num_segments = NumSegments(plaintext_size);
+  std::string header(header_size_, '\0');
+  util::Status status = ciphertext->PRead(0, header_size_, &header[0]);
+  if (!status.ok()) return status;
+  auto cipher_result = NewSegmentDecrypter(header, associated_data);
+  if (!cipher_result.ok()) return cipher_result.status();
+  const StreamSegmentCipher& cipher = *cipher_result.ValueOrDie();
+
+  std::string result(count, '\0');
+  uint64_t range_end = position + count;
+  uint64_t first_segment = (position + header_size_) / plaintext_segment_size_;
+  uint64_t last_segment =
+      (range_end - 1 + header_size_) / plaintext_segment_size_;
+  status = ForEachSegment(
+      first_segment, last_segment + 1,
+      [&](uint64_t segment, char* plaintext_buffer, char* ciphertext_buffer) {
+        bool is_last_segment = segment + 1 == num_segments;
+        uint64_t begin = CiphertextStart(segment);
+        uint64_t end =
+            is_last_segment ? ciphertext_size : CiphertextStart(segment + 1);
+        size_t segment_size = end - begin;
+        util::Status status =
+            ciphertext->PRead(begin, segment_size, ciphertext_buffer);
+        if (!status.ok()) return status;
+        status = cipher.DecryptSegment(
+            absl::string_view(ciphertext_buffer, segment_size), segment,
+            is_last_segment, plaintext_buffer);
+        if (!status.ok()) return status;
+        // Copy the part of the segment that lies within the range.
+        uint64_t segment_begin = PlaintextStart(segment);
+        uint64_t segment_end = segment_begin + segment_size - tag_size_;
+        uint64_t copy_begin = std::max(segment_begin, position);
+        uint64_t copy_end = std::min(segment_end, range_end);
+        memcpy(&result[copy_begin - position],
+               plaintext_buffer + (copy_begin - segment_begin),
+               copy_end - copy_begin);
+        return util::Status::OK;
+      });
+  if (!status.ok()) return status;
+  return result;
+}
+
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,139 @@
+// Copyright 2018 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_SUBTLE_NONCE_BASED_STREAMING_AEAD_H_
+#define TINK_SUBTLE_NONCE_BASED_STREAMING_AEAD_H_
+
+#include <functional>
+#include <memory>
+#include <string>
+
+#include "absl/strings/string_view.h"
+#include "tink/random_access_stream.h"
+#include "tink/streaming_aead.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+
+// Encrypts and decrypts the segments of a single ciphertext, with the keys
+// and nonce prefix determined by the ciphertext header.
+// The methods are called concurrently from several threads, and must be
+// thread-safe.
+class StreamSegmentCipher {
+ public:
+  // Encrypts 'plaintext' as the segment with number 'segment_number', and
+  // writes plaintext.size() + tag size bytes to 'ciphertext'.
+  virtual crypto::tink::util::Status EncryptSegment(
+      absl::string_view plaintext, uint32_t segment_number,
+      bool is_last_segment, char* ciphertext) const = 0;
+
+  // Decrypts 'ciphertext' as the segment with number 'segment_number', and
+  // writes ciphertext.size() - tag size bytes to 'plaintext'.
+  virtual crypto::tink::util::Status DecryptSegment(
+      absl::string_view ciphertext, uint32_t segment_number,
+      bool is_last_segment, char* plaintext) const = 0;
+
+  virtual ~StreamSegmentCipher() {}
+};
+
+// The segmented ciphertext format shared by AesGcmHkdfStreaming and
+// AesCtrHmacStreaming, as in the Java implementation. A ciphertext consists
+// of a header followed by ciphertext segments:
+//
+//   header || segment_0 || segment_1 || ... || segment_n-1
+//
+// Every segment but the last one is 'ciphertext_segment_size' bytes long,
+// except that segment_0 is shorter by the size of the header. Segment i is
+// the encryption of the corresponding plaintext segment with segment number
+// i, and with a flag marking the last segment.
+//
+// The segments are independent, hence this class encrypts and decrypts
+// them in parallel on all cores, for inputs large enough to be worth it.
+// Each worker thread claims batches of consecutive segments from a shared
+// cursor, reads its segments from the input at their computed offsets, and
+// writes the results directly to their computed offsets in the output.
+class NonceBasedStreamingAead : public StreamingAead {
+ public:
+  uint64_t CiphertextSize(uint64_t plaintext_size) const override;
+
+  crypto::tink::util::StatusOr<uint64_t> PlaintextSize(
+      uint64_t ciphertext_size) const override;
+
+  crypto::tink::util::Status Encrypt(
+      RandomAccessStream* plaintext, absl::string_view associated_data,
+      RandomAccessSink* ciphertext) const override;
+
+  crypto::tink::util::Status Decrypt(
+      RandomAccessStream* ciphertext, absl::string_view associated_data,
+      RandomAccessSink* plaintext) const override;
+
+  crypto::tink::util::StatusOr<std::string> DecryptRange(
+      RandomAccessStream* ciphertext, absl::string_view associated_data,
+      uint64_t position, size_t count) const override;
+
+  ~NonceBasedStreamingAead() override {}
+
+ protected:
+  NonceBasedStreamingAead(size_t header_size, size_t ciphertext_segment_size,
+                          size_t tag_size);
+
+  // Returns the cipher for a new ciphertext with 'associated_data', and
+  // stores the header of that ciphertext, header_size() bytes, in 'header'.
+  virtual crypto::tink::util::StatusOr<std::unique_ptr<StreamSegmentCipher>>
+  NewSegmentEncrypter(absl::string_view associated_data,
+                      std::string* header) const = 0;
+
+  // Returns the cipher for the ciphertext with 'header' and
+  // 'associated_data'.
+  virtual crypto::tink::util::StatusOr<std::unique_ptr<StreamSegmentCipher>>
+  NewSegmentDecrypter(absl::string_view header,
+                      absl::string_view associated_data) const = 0;
+
+  size_t header_size() const { return header_size_; }
+
+ private:
+  // Called for each segment with the segment number and scratch buffers of
+  // ciphertext_segment_size_ bytes that are owned by the calling thread.
+  typedef std::function<crypto::tink::util::Status(
+      uint64_t segment, char* plaintext_buffer, char* ciphertext_buffer)>
+      SegmentFunction;
+
+  // Calls 'segment_function' for all segments in ['begin', 'end'), on
+  // several threads if there are enough of them. Returns the first error.
+  crypto::tink::util::Status ForEachSegment(
+      uint64_t begin, uint64_t end,
+      const SegmentFunction& segment_function) const;
+
+  uint64_t NumSegments(uint64_t plaintext_size) const;
+  // Position of the first plaintext byte of 'segment'.
+  uint64_t PlaintextStart(uint64_t segment) const;
+  // Position of the first ciphertext byte of 'segment'.
+  uint64_t CiphertextStart(uint64_t segment) const;
+
+  const size_t header_size_;
+  const size_t ciphertext_segment_size_;
+  const size_t plaintext_segment_size_;
+  const size_t tag_size_;
+};
+
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_SUBTLE_NONCE_BASED_STREAMING_AEAD_H_
@@ -0,0 +1,93 @@
+// Copyright 2018 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/subtle/parallel_for.h"
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>  // NOLINT(build/c++11)
+#include <thread>  // NOLINT(build/c++11)
+#include <vector>
+
+#include "tink/util/status.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+
+namespace {
+
+// Inputs are only split over several threads if each thread gets at least
+// this many bytes, since starting a thread is not free.
+const uint64_t kMinBytesPerThread = 1 << 20;
+
+// Threads claim items in batches of at most this many bytes, and aim for
+// this many batches per thread, so that threads that finish early can take
+// over work from slower ones.
+const uint64_t kMaxBatchBytes = 1 << 20;
+const uint64_t kBatchesPerThread = 8;
+
+}  // namespace
+
+util::Status ParallelFor(
+    uint64_t begin, uint64_t end, uint64_t item_size,
+    const std::function<ItemFunction()>& new_item_function) {
+  if (begin >= end) return util::Status::OK;
+  uint64_t num_items = end - begin;
+  item_size = std::max<uint64_t>(1, item_size);
+  uint64_t max_threads =
+      std::max<uint64_t>(1, std::thread::hardware_concurrency());
+  uint64_t num_threads = std::min(
+      {max_threads, num_items,
+       std::max<uint64_t>(1, num_items * item_size / kMinBytesPerThread)});
+  uint64_t batch_size = std::min(num_items / (num_threads * kBatchesPerThread),
+                                 kMaxBatchBytes / item_size);
+  batch_size = std::max<uint64_t>(1, batch_size);
+
+  std::atomic<uint64_t> next_item(begin);
+  std::atomic<bool> failed(false);
+  std::mutex status_mutex;
+  util::Status status;
+  auto worker = [&]() {
+    ItemFunction item_function = new_item_function();
+    while (!failed.load(std::memory_order_relaxed)) {
+      uint64_t batch_begin = next_item.fetch_add(batch_size);
+      if (batch_begin >= end) return;
+      uint64_t batch_end = std::min(end, batch_begin + batch_size);
+      for (uint64_t item = batch_begin; item < batch_end; item++) {
+        util::Status item_status = item_function(item);
+        if (!item_status.ok()) {
+          std::lock_guard<std::mutex> lock(status_mutex);
+          if (status.ok()) status = item_status;
+          failed = true;
+          return;
+        }
+      }
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (uint64_t i = 1; i < num_threads; i++) {
+    threads.emplace_back(worker);
+  }
+  worker();
+  for (auto& thread : threads) thread.join();
+  return status;
+}
+
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,50 @@
+// Copyright 2018 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_SUBTLE_PARALLEL_FOR_H_
+#define TINK_SUBTLE_PARALLEL_FOR_H_
+
+#include <stdint.h>
+
+#include <functional>
+
+#include "tink/util/status.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+
+// Processes the item with index 'index'. Each ItemFunction is only called
+// from a single thread, so it can own per-thread state such as buffers.
+typedef std::function<crypto::tink::util::Status(uint64_t index)>
+    ItemFunction;
+
+// Calls an ItemFunction for each item in ['begin', 'end'), where each item
+// is about 'item_size' bytes of work. The items are split over up to one
+// thread per hardware thread if there are enough of them; the calling
+// thread is one of the threads. 'new_item_function' is called once in each
+// thread, possibly concurrently, and returns the ItemFunction of that
+// thread. After the first error no further items are started, and the
+// first error is returned.
+crypto::tink::util::Status ParallelFor(
+    uint64_t begin, uint64_t end, uint64_t item_size,
+    const std::function<ItemFunction()>& new_item_function);
+
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_SUBTLE_PARALLEL_FOR_H_
@@ -0,0 +1,86 @@
+// Copyright 2018 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/subtle/parallel_for.h"
+
+#include <atomic>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "tink/util/status.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+namespace {
+
+TEST(ParallelForTest, testEmptyRange) {
+  auto status = ParallelFor(5, 5, 1, []() -> ItemFunction {
+    return [](uint64_t index) {
+      ADD_FAILURE() << "unexpected item " << index;
+      return util::Status::OK;
+    };
+  });
+  EXPECT_TRUE(status.ok()) << status;
+}
+
+TEST(ParallelForTest, testEachItemOnce) {
+  for (uint64_t item_size : {0, 1, 1 << 10, 1 << 20}) {
+    const uint64_t begin = 3;
+    const uint64_t end = 10000;
+    std::vector<std::atomic<int>> calls(end);
+    for (auto& count : calls) count = 0;
+    auto status = ParallelFor(begin, end, item_size, [&]() -> ItemFunction {
+      return [&calls](uint64_t index) {
+        calls[index]++;
+        return util::Status::OK;
+      };
+    });
+    EXPECT_TRUE(status.ok()) << status;
+    for (uint64_t i = 0; i < end; i++) {
+      EXPECT_EQ(i < begin ? 0 : 1, calls[i]) << "item_size: " << item_size
+                                            << " index: " << i;
+    }
+  }
+}
+
+TEST(ParallelForTest, testError) {
+  // Small inputs run in the calling thread only, so no item after the
+  // failing one is started.
+  std::atomic<int> calls(0);
+  auto status = ParallelFor(0, 1000, 1, [&]() -> ItemFunction {
+    return [&calls](uint64_t index) {
+      calls++;
+      if (index == 0) {
+        return util::Status(util::error::INTERNAL, "item 0 failed");
+      }
+      return util::Status::OK;
+    };
+  });
+  EXPECT_EQ(util::error::INTERNAL, status.error_code()) << status;
+  EXPECT_EQ("item 0 failed", status.error_message());
+  EXPECT_EQ(1, calls);
+}
+
+}  // namespace
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
+
+int main(int ac, char* av[]) {
+  testing::InitGoogleTest(&ac, av);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,101 @@
+// Copyright 2017 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/subtle/poly1305_mac_boringssl.h"
+
+#include <string.h>
+
+#include <string>
+
+#include "absl/strings/string_view.h"
+#include "openssl/chacha.h"
+#include "openssl/mem.h"
+#include "openssl/poly1305.h"
+#include "tink/mac.h"
+#include "tink/subtle/random.h"
+#include "tink/subtle/subtle_util_boringssl.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+
+// static
+util::StatusOr<std::unique_ptr<Mac>> Poly1305MacBoringSsl::New(
+    absl::string_view key_value) {
+  if (key_value.size() != KEY_SIZE) {
+    return util::Status(util::error::INVALID_ARGUMENT, "Invalid key size");
+  }
+  std::unique_ptr<Poly1305MacBoringSsl> mac(new Poly1305MacBoringSsl());
+  memcpy(mac->key_, key_value.data(), KEY_SIZE);
+  std::unique_ptr<Mac> result = std::move(mac);
+  return std::move(result);
+}
+
+Poly1305MacBoringSsl::~Poly1305MacBoringSsl() {
+  OPENSSL_cleanse(key_, sizeof(key_));
+}
+
+void Poly1305MacBoringSsl::Poly1305(const uint8_t nonce[NONCE_SIZE],
+                                    absl::string_view data,
+                                    uint8_t out[16]) const {
+  // BoringSSL expects a non-null pointer for data,
+  // regardless of whether the size is 0.
+  data = SubtleUtilBoringSSL::EnsureNonNull(data);
+  uint32_t counter = static_cast<uint32_t>(nonce[0]) |
+                     (static_cast<uint32_t>(nonce[1]) << 8) |
+                     (static_cast<uint32_t>(nonce[2]) << 16) |
+                     (static_cast<uint32_t>(nonce[3]) << 24);
+  uint8_t one_time_key[32] = {0};
+  CRYPTO_chacha_20(one_time_key, one_time_key, sizeof(one_time_key), key_,
+                   nonce + 4, counter);
+  poly1305_state state;
+  CRYPTO_poly1305_init(&state, one_time_key);
+  CRYPTO_poly1305_update(&state,
+                         reinterpret_cast<const uint8_t*>(data.data()),
+                         data.size());
+  CRYPTO_poly1305_finish(&state, out);
+  OPENSSL_cleanse(one_time_key, sizeof(one_time_key));
+}
+
+util::StatusOr<std::string> Poly1305MacBoringSsl::ComputeMac(
+    absl::string_view data) const {
+  std::string tag = Random::GetRandomBytes(NONCE_SIZE);
+  tag.resize(TAG_SIZE);
+  uint8_t* out = reinterpret_cast<uint8_t*>(&tag[0]);
+  Poly1305(out, data, out + NONCE_SIZE);
+  return std::move(tag);
+}
+
+util::Status Poly1305MacBoringSsl::VerifyMac(
+    absl::string_view mac,
+    absl::string_view data) const {
+  if (mac.size() != TAG_SIZE) {
+    return util::Status(util::error::INVALID_ARGUMENT, "incorrect tag size");
+  }
+  const uint8_t* in = reinterpret_cast<const uint8_t*>(mac.data());
+  uint8_t expected[16];
+  Poly1305(in, data, expected);
+  if (CRYPTO_memcmp(expected, in + NONCE_SIZE, sizeof(expected)) != 0) {
+    return util::Status(util::error::INVALID_ARGUMENT, "verification failed");
+  }
+  return util::Status::OK;
+}
+
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
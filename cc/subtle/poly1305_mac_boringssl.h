@@ -0,0 +1,83 @@
+// Copyright 2017 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_SUBTLE_POLY1305_MAC_BORINGSSL_H_
+#define TINK_SUBTLE_POLY1305_MAC_BORINGSSL_H_
+
+#include <memory>
+#include <string>
+
+#include "absl/strings/string_view.h"
+#include "tink/mac.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+
+// A nonce-based MAC built from ChaCha20 and the Poly1305 universal hash.
+//
+// Each tag uses a fresh random 128-bit nonce. Its first 4 bytes are the
+// little-endian ChaCha20 block counter and its last 12 bytes the ChaCha20
+// nonce; the first 32 bytes of that ChaCha20 block are the one-time
+// Poly1305 key, as in https://tools.ietf.org/html/rfc8439#section-2.6.
+// The tag is
+//   nonce (16 bytes) || Poly1305(one-time key, data) (16 bytes).
+//
+// Poly1305 processes long messages several times faster than SHA-256, so
+// for large inputs this MAC is much faster than HMAC-SHA256. Unlike HMAC,
+// the tags are randomized: computing the tag of the same data twice gives
+// different tags, all of which verify.
+class Poly1305MacBoringSsl : public Mac {
+ public:
+  // The key must be 256 bits.
+  static crypto::tink::util::StatusOr<std::unique_ptr<Mac>> New(
+      absl::string_view key_value);
+
+  // Computes and returns a tag for 'data'.
+  crypto::tink::util::StatusOr<std::string> ComputeMac(
+      absl::string_view data) const override;
+
+  // Verifies if 'mac' is a correct tag for 'data'.
+  // Returns Status::OK if 'mac' is correct, and a non-OK-Status otherwise.
+  crypto::tink::util::Status VerifyMac(
+      absl::string_view mac,
+      absl::string_view data) const override;
+
+  ~Poly1305MacBoringSsl() override;
+
+  // The following constants are in bytes.
+  static const int KEY_SIZE = 32;
+  static const int NONCE_SIZE = 16;
+  static const int TAG_SIZE = NONCE_SIZE + 16;
+
+ private:
+  Poly1305MacBoringSsl() {}
+
+  // Writes the Poly1305 tag of 'data' under the one-time key selected by
+  // 'nonce' to 'out'.
+  void Poly1305(const uint8_t nonce[NONCE_SIZE], absl::string_view data,
+                uint8_t out[16]) const;
+
+  uint8_t key_[KEY_SIZE];
+};
+
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_SUBTLE_POLY1305_MAC_BORINGSSL_H_
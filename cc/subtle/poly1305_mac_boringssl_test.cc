@@ -0,0 +1,117 @@
+// Copyright 2017 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/subtle/poly1305_mac_boringssl.h"
+
+#include <string>
+
+#include "tink/mac.h"
+#include "tink/subtle/chacha20_poly1305_boringssl.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "tink/util/test_util.h"
+#include "gtest/gtest.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+namespace {
+
+const int kTagSize = 32;
+
+TEST(Poly1305MacBoringSslTest, testBasic) {
+  auto mac_result = Poly1305MacBoringSsl::New(std::string(32, 'k'));
+  ASSERT_TRUE(mac_result.ok()) << mac_result.status();
+  auto mac = std::move(mac_result.ValueOrDie());
+  for (size_t size : {0, 1, 15, 16, 17, 1000, 100000}) {
+    std::string data(size, 'd');
+    auto tag_result = mac->ComputeMac(data);
+    ASSERT_TRUE(tag_result.ok()) << tag_result.status();
+    std::string tag = tag_result.ValueOrDie();
+    EXPECT_EQ(kTagSize, tag.size());
+    EXPECT_TRUE(mac->VerifyMac(tag, data).ok()) << size;
+    // Tags are randomized.
+    std::string other_tag = mac->ComputeMac(data).ValueOrDie();
+    EXPECT_NE(tag, other_tag);
+    EXPECT_TRUE(mac->VerifyMac(other_tag, data).ok()) << size;
+  }
+}
+
+// Over a message whose length is a multiple of 16, followed by the two
+// 64-bit lengths, the ChaCha20-Poly1305 AEAD (RFC 8439, section 2.8) with an
+// empty plaintext computes the same Poly1305 tag as this MAC with the block
+// counter 0.
+TEST(Poly1305MacBoringSslTest, testCompatibleWithChaCha20Poly1305) {
+  const std::string key = test::HexDecodeOrDie(
+      "808182838485868788898a8b8c8d8e8f909192939495969798999a9b9c9d9e9f");
+  auto aead = std::move(ChaCha20Poly1305BoringSsl::New(key).ValueOrDie());
+  auto mac = std::move(Poly1305MacBoringSsl::New(key).ValueOrDie());
+  for (size_t size : {0, 16, 64, 4096}) {
+    std::string data(size, 'd');
+    // The ciphertext is nonce (12 bytes) || tag (16 bytes).
+    std::string ciphertext = aead->Encrypt("", data).ValueOrDie();
+    ASSERT_EQ(28, ciphertext.size());
+    std::string tag = std::string(4, '\0') + ciphertext;
+    std::string lengths(16, '\0');
+    for (int i = 0; i < 8; i++) lengths[i] = (size >> (8 * i)) & 0xff;
+    EXPECT_TRUE(mac->VerifyMac(tag, data + lengths).ok()) << size;
+    EXPECT_FALSE(mac->VerifyMac(tag, data).ok()) << size;
+  }
+}
+
+TEST(Poly1305MacBoringSslTest, testModification) {
+  auto mac = std::move(
+      Poly1305MacBoringSsl::New(std::string(32, 'k')).ValueOrDie());
+  std::string data = "Some data to test";
+  std::string tag = mac->ComputeMac(data).ValueOrDie();
+  EXPECT_TRUE(mac->VerifyMac(tag, data).ok());
+  for (size_t i = 0; i < tag.size() * 8; i++) {
+    std::string modified_tag = tag;
+    modified_tag[i / 8] ^= 1 << (i % 8);
+    EXPECT_FALSE(mac->VerifyMac(modified_tag, data).ok()) << i;
+  }
+  for (size_t i = 0; i < data.size() * 8; i++) {
+    std::string modified_data = data;
+    modified_data[i / 8] ^= 1 << (i % 8);
+    EXPECT_FALSE(mac->VerifyMac(tag, modified_data).ok()) << i;
+  }
+  for (size_t i = 0; i < tag.size(); i++) {
+    EXPECT_FALSE(mac->VerifyMac(tag.substr(0, i), data).ok());
+  }
+  EXPECT_FALSE(mac->VerifyMac(tag + "x", data).ok());
+
+  // Tags do not verify under other keys.
+  auto other_mac = std::move(
+      Poly1305MacBoringSsl::New(std::string(32, 'o')).ValueOrDie());
+  EXPECT_FALSE(other_mac->VerifyMac(tag, data).ok());
+}
+
+TEST(Poly1305MacBoringSslTest, testInvalidKeySizes) {
+  for (int key_size = 0; key_size < 65; key_size++) {
+    auto result = Poly1305MacBoringSsl::New(std::string(key_size, 'k'));
+    EXPECT_EQ(key_size == 32, result.ok()) << key_size;
+  }
+}
+
+}  // namespace
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
+
+int main(int ac, char* av[]) {
+  testing::InitGoogleTest(&ac, av);
+  return RUN_ALL_TESTS();
+}
@@ -25,11 +25,16 @@ namespace subtle {
 // static
 std::string Random::GetRandomBytes(size_t length) {
   std::unique_ptr<uint8_t[]> buf(new uint8_t[length]);
+  GetRandomBytes(buf.get(), length);
+  return std::string(reinterpret_cast<const char *>(buf.get()), length);
+}
+
+// static
+void Random::GetRandomBytes(uint8_t* buffer, size_t length) {
   // BoringSSL documentation says that it always returns 1; while
   // OpenSSL documentation says that it returns 1 on success, 0 otherwise. We
   // use BoringSSL, so we don't check the return value.
-  RAND_bytes(buf.get(), length);
-  return std::string(reinterpret_cast<const char *>(buf.get()), length);
+  RAND_bytes(buffer, length);
 }
 
 }  // namespace subtle
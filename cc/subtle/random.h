@@ -17,6 +17,8 @@
 #ifndef TINK_SUBTLE_RANDOM_H_
 #define TINK_SUBTLE_RANDOM_H_
 
+#include <stdint.h>
+
 #include <string>
 #include <memory>
 
@@ -28,6 +30,9 @@ class Random {
  public:
   // Returns a random std::string of desired length.
   static std::string GetRandomBytes(size_t length);
+
+  // Fills 'buffer' with 'length' random bytes.
+  static void GetRandomBytes(uint8_t* buffer, size_t length);
 };
 
 }  // namespace subtle
@@ -18,11 +18,11 @@
 
 #include <vector>
 
-#include "absl/strings/str_cat.h"
 #include "openssl/base.h"
 #include "openssl/digest.h"
 #include "openssl/evp.h"
 #include "openssl/rsa.h"
+#include "tink/subtle/digest_signer_boringssl.h"
 #include "tink/subtle/subtle_util_boringssl.h"
 
 namespace crypto {
@@ -40,34 +40,11 @@ util::StatusOr<std::unique_ptr<PublicKeySign>> RsaSsaPkcs1SignBoringSsl::New(
   auto sig_hash = SubtleUtilBoringSSL::EvpHash(params.sig_hash);
   if (!sig_hash.ok()) return sig_hash.status();
 
-  bssl::UniquePtr<RSA> rsa(RSA_new());
-  if (rsa == nullptr) {
-    return util::Status(util::error::INTERNAL, "Could not initialize RSA.");
-  }
-
-  {
-    auto st = SubtleUtilBoringSSL::CopyKey(private_key, rsa.get());
-    if (!st.ok()) return st;
-  }
-
-  {
-    auto st = SubtleUtilBoringSSL::CopyPrimeFactors(private_key, rsa.get());
-    if (!st.ok()) return st;
-  }
-
-  {
-    auto st = SubtleUtilBoringSSL::CopyCrtParams(private_key, rsa.get());
-    if (!st.ok()) return st;
-  }
+  auto rsa = SubtleUtilBoringSSL::BoringSslRsaFromRsaPrivateKey(private_key);
+  if (!rsa.ok()) return rsa.status();
 
-  if (RSA_check_key(rsa.get()) == 0 || RSA_check_fips(rsa.get()) == 0) {
-    return util::Status(util::error::INVALID_ARGUMENT,
-                        absl::StrCat("Could not load RSA key: ",
-                                     SubtleUtilBoringSSL::GetErrors()));
-  }
-
-  return std::unique_ptr<PublicKeySign>(
-      new RsaSsaPkcs1SignBoringSsl(std::move(rsa), sig_hash.ValueOrDie()));
+  return std::unique_ptr<PublicKeySign>(new RsaSsaPkcs1SignBoringSsl(
+      std::move(rsa.ValueOrDie()), sig_hash.ValueOrDie()));
 }
 
 RsaSsaPkcs1SignBoringSsl::RsaSsaPkcs1SignBoringSsl(
@@ -80,12 +57,21 @@ util::StatusOr<std::string> RsaSsaPkcs1SignBoringSsl::Sign(
   auto digest_or = boringssl::ComputeHash(data, *sig_hash_);
   if (!digest_or.ok()) return digest_or.status();
   std::vector<uint8_t> digest = std::move(digest_or.ValueOrDie());
+  return SignDigest(absl::string_view(
+      reinterpret_cast<const char*>(digest.data()), digest.size()));
+}
+
+util::StatusOr<std::string> RsaSsaPkcs1SignBoringSsl::SignDigest(
+    absl::string_view digest) const {
+  if (digest.size() != static_cast<size_t>(EVP_MD_size(sig_hash_))) {
+    return util::Status(util::error::INVALID_ARGUMENT, "Invalid digest size.");
+  }
 
   std::vector<uint8_t> signature(RSA_size(private_key_.get()));
   unsigned int signature_length = 0;
 
   if (RSA_sign(/*hash_nid=*/EVP_MD_type(sig_hash_),
-               /*in=*/digest.data(),
+               /*in=*/reinterpret_cast<const uint8_t*>(digest.data()),
                /*in_len=*/digest.size(),
                /*out=*/signature.data(),
                /*out_len=*/&signature_length,
@@ -100,6 +86,13 @@ util::StatusOr<std::string> RsaSsaPkcs1SignBoringSsl::Sign(
                 signature_length);
 }
 
+util::StatusOr<std::unique_ptr<PublicKeySigner>>
+RsaSsaPkcs1SignBoringSsl::NewSigner() const {
+  return DigestSignerBoringSsl::New(
+      sig_hash_,
+      [this](absl::string_view digest) { return SignDigest(digest); });
+}
+
 }  // namespace subtle
 }  // namespace tink
 }  // namespace crypto
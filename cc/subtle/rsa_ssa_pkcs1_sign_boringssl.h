@@ -46,6 +46,15 @@ class RsaSsaPkcs1SignBoringSsl : public PublicKeySign {
   crypto::tink::util::StatusOr<std::string> Sign(
       absl::string_view data) const override;
 
+  // Computes the signature for 'digest', the hash of the data with the
+  // signature hash. Sign(data) is equivalent to SignDigest(hash(data)).
+  crypto::tink::util::StatusOr<std::string> SignDigest(
+      absl::string_view digest) const;
+
+  // Returns a signer that hashes the data as it is passed in.
+  crypto::tink::util::StatusOr<std::unique_ptr<PublicKeySigner>> NewSigner()
+      const override;
+
   ~RsaSsaPkcs1SignBoringSsl() override = default;
 
  private:
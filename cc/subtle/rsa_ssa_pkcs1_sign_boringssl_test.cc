@@ -117,6 +117,65 @@ TEST_F(RsaPkcs1SignBoringsslTest, RejectsInvalidCrtParams) {
   }
 }
 
+TEST_F(RsaPkcs1SignBoringsslTest, SignsIncrementally) {
+  SubtleUtilBoringSSL::RsaSsaPkcs1Params params{/*sig_hash=*/HashType::SHA256};
+
+  auto signer_or = RsaSsaPkcs1SignBoringSsl::New(private_key_, params);
+  ASSERT_THAT(signer_or.status(), IsOk());
+  auto verifier_or = RsaSsaPkcs1VerifyBoringSsl::New(public_key_, params);
+  ASSERT_THAT(verifier_or.status(), IsOk());
+
+  auto incremental_signer_or = signer_or.ValueOrDie()->NewSigner();
+  ASSERT_THAT(incremental_signer_or.status(), IsOk());
+  auto incremental_signer = std::move(incremental_signer_or.ValueOrDie());
+  EXPECT_THAT(incremental_signer->Update("test"), IsOk());
+  EXPECT_THAT(incremental_signer->Update(""), IsOk());
+  EXPECT_THAT(incremental_signer->Update("data"), IsOk());
+  auto signature_or = incremental_signer->Finalize();
+  ASSERT_THAT(signature_or.status(), IsOk());
+  EXPECT_THAT(
+      verifier_or.ValueOrDie()->Verify(signature_or.ValueOrDie(), "testdata"),
+      IsOk());
+
+  auto incremental_verifier_or =
+      verifier_or.ValueOrDie()->NewVerifier(signature_or.ValueOrDie());
+  ASSERT_THAT(incremental_verifier_or.status(), IsOk());
+  auto incremental_verifier = std::move(incremental_verifier_or.ValueOrDie());
+  EXPECT_THAT(incremental_verifier->Update("testd"), IsOk());
+  EXPECT_THAT(incremental_verifier->Update("ata"), IsOk());
+  EXPECT_THAT(incremental_verifier->Finalize(), IsOk());
+
+  incremental_verifier = std::move(
+      verifier_or.ValueOrDie()->NewVerifier(signature_or.ValueOrDie())
+          .ValueOrDie());
+  EXPECT_THAT(incremental_verifier->Update("otherdata"), IsOk());
+  EXPECT_THAT(incremental_verifier->Finalize(), Not(IsOk()));
+}
+
+TEST_F(RsaPkcs1SignBoringsslTest, SignsDigest) {
+  SubtleUtilBoringSSL::RsaSsaPkcs1Params params{/*sig_hash=*/HashType::SHA256};
+
+  auto signer_or = RsaSsaPkcs1SignBoringSsl::New(private_key_, params);
+  ASSERT_THAT(signer_or.status(), IsOk());
+  const auto& signer =
+      static_cast<const RsaSsaPkcs1SignBoringSsl&>(*signer_or.ValueOrDie());
+  auto verifier_or = RsaSsaPkcs1VerifyBoringSsl::New(public_key_, params);
+  ASSERT_THAT(verifier_or.status(), IsOk());
+
+  auto digest_or = boringssl::ComputeHash("testdata", *EVP_sha256());
+  ASSERT_THAT(digest_or.status(), IsOk());
+  std::string digest(digest_or.ValueOrDie().begin(),
+                     digest_or.ValueOrDie().end());
+  auto signature_or = signer.SignDigest(digest);
+  ASSERT_THAT(signature_or.status(), IsOk());
+  EXPECT_THAT(
+      verifier_or.ValueOrDie()->Verify(signature_or.ValueOrDie(), "testdata"),
+      IsOk());
+
+  EXPECT_THAT(signer.SignDigest(digest.substr(1)).status(),
+              StatusIs(util::error::INVALID_ARGUMENT));
+}
+
 }  // namespace
 }  // namespace subtle
 }  // namespace tink
@@ -16,12 +16,13 @@
 
 #include "tink/subtle/rsa_ssa_pss_sign_boringssl.h"
 
+#include <atomic>
 #include <vector>
 
-#include "absl/strings/str_cat.h"
 #include "openssl/base.h"
 #include "openssl/evp.h"
 #include "openssl/rsa.h"
+#include "tink/subtle/digest_signer_boringssl.h"
 #include "tink/subtle/subtle_util_boringssl.h"
 
 namespace crypto {
@@ -32,6 +33,18 @@ namespace subtle {
 util::StatusOr<std::unique_ptr<PublicKeySign>> RsaSsaPssSignBoringSsl::New(
     const SubtleUtilBoringSSL::RsaPrivateKey& private_key,
     const SubtleUtilBoringSSL::RsaSsaPssParams& params) {
+  return NewWithKeyShards(private_key, params, 1);
+}
+
+// static
+util::StatusOr<std::unique_ptr<PublicKeySign>>
+RsaSsaPssSignBoringSsl::NewWithKeyShards(
+    const SubtleUtilBoringSSL::RsaPrivateKey& private_key,
+    const SubtleUtilBoringSSL::RsaSsaPssParams& params, int num_key_shards) {
+  if (num_key_shards < 1 || num_key_shards > kMaxKeyShards) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "Invalid number of key shards.");
+  }
   // Check hash.
   util::Status sig_hash_valid =
       SubtleUtilBoringSSL::ValidateSignatureHash(params.sig_hash);
@@ -41,58 +54,64 @@ util::StatusOr<std::unique_ptr<PublicKeySign>> RsaSsaPssSignBoringSsl::New(
   auto mgf1_hash = SubtleUtilBoringSSL::EvpHash(params.mgf1_hash);
   if (!mgf1_hash.ok()) return mgf1_hash.status();
 
-  bssl::UniquePtr<RSA> rsa(RSA_new());
-  if (rsa == nullptr) {
-    return util::Status(util::error::INTERNAL, "Could not initialize RSA.");
-  }
-
-  {
-    auto st = SubtleUtilBoringSSL::CopyKey(private_key, rsa.get());
-    if (!st.ok()) return st;
-  }
-  {
-    auto st = SubtleUtilBoringSSL::CopyPrimeFactors(private_key, rsa.get());
-    if (!st.ok()) return st;
-  }
-  {
-    auto st = SubtleUtilBoringSSL::CopyCrtParams(private_key, rsa.get());
-    if (!st.ok()) return st;
-  }
-
-  if (RSA_check_key(rsa.get()) == 0 || RSA_check_fips(rsa.get()) == 0) {
-    return util::Status(util::error::INVALID_ARGUMENT,
-                        absl::StrCat("Could not load RSA key: ",
-                                     SubtleUtilBoringSSL::GetErrors()));
+  // Only the first copy pays for the key checks; the others hit the
+  // validation cache.
+  std::vector<bssl::UniquePtr<RSA>> rsa_keys;
+  for (int i = 0; i < num_key_shards; i++) {
+    auto rsa = SubtleUtilBoringSSL::BoringSslRsaFromRsaPrivateKey(private_key);
+    if (!rsa.ok()) return rsa.status();
+    rsa_keys.push_back(std::move(rsa.ValueOrDie()));
   }
 
   return std::unique_ptr<PublicKeySign>(
-      new RsaSsaPssSignBoringSsl(std::move(rsa), sig_hash.ValueOrDie(),
+      new RsaSsaPssSignBoringSsl(std::move(rsa_keys),
+                                 sig_hash.ValueOrDie(),
                                  mgf1_hash.ValueOrDie(), params.salt_length));
 }
 
-RsaSsaPssSignBoringSsl::RsaSsaPssSignBoringSsl(bssl::UniquePtr<RSA> private_key,
-                                               const EVP_MD* sig_hash,
-                                               const EVP_MD* mgf1_hash,
-                                               int32_t salt_length)
-    : private_key_(std::move(private_key)),
+RsaSsaPssSignBoringSsl::RsaSsaPssSignBoringSsl(
+    std::vector<bssl::UniquePtr<RSA>> private_keys, const EVP_MD* sig_hash,
+    const EVP_MD* mgf1_hash, int32_t salt_length)
+    : private_keys_(std::move(private_keys)),
       sig_hash_(sig_hash),
       mgf1_hash_(mgf1_hash),
       salt_length_(salt_length) {}
 
+RSA* RsaSsaPssSignBoringSsl::private_key() const {
+  if (private_keys_.size() == 1) return private_keys_[0].get();
+  // Threads are numbered in the order in which they first sign, so that
+  // threads are spread evenly over the shards. Hashing the thread id does
+  // not do that: on some platforms it is an aligned pointer.
+  static std::atomic<uint32_t> next_thread_index(0);
+  thread_local uint32_t thread_index = next_thread_index++;
+  return private_keys_[thread_index % private_keys_.size()].get();
+}
+
 util::StatusOr<std::string> RsaSsaPssSignBoringSsl::Sign(
     absl::string_view data) const {
   data = SubtleUtilBoringSSL::EnsureNonNull(data);
   auto digest_or = boringssl::ComputeHash(data, *sig_hash_);
   if (!digest_or.ok()) return digest_or.status();
   std::vector<uint8_t> digest = std::move(digest_or.ValueOrDie());
+  return SignDigest(absl::string_view(
+      reinterpret_cast<const char*>(digest.data()), digest.size()));
+}
+
+util::StatusOr<std::string> RsaSsaPssSignBoringSsl::SignDigest(
+    absl::string_view digest) const {
+  if (digest.size() != static_cast<size_t>(EVP_MD_size(sig_hash_))) {
+    return util::Status(util::error::INVALID_ARGUMENT, "Invalid digest size.");
+  }
 
-  std::vector<uint8_t> signature(RSA_size(private_key_.get()));
+  RSA* rsa = private_key();
+  std::vector<uint8_t> signature(RSA_size(rsa));
   size_t signature_length;
 
-  if (RSA_sign_pss_mgf1(private_key_.get(),
+  if (RSA_sign_pss_mgf1(rsa,
                         /*out_len=*/&signature_length,
                         /*out=*/signature.data(), /*max_out=*/signature.size(),
-                        /*in=*/digest.data(), /*in_len=*/digest.size(),
+                        /*in=*/reinterpret_cast<const uint8_t*>(digest.data()),
+                        /*in_len=*/digest.size(),
                         /*md=*/sig_hash_,
                         /*mgf1_md=*/mgf1_hash_, salt_length_) != 1) {
     // TODO(b/112581512): Decide if it's safe to propagate the BoringSSL error.
@@ -104,6 +123,13 @@ util::StatusOr<std::string> RsaSsaPssSignBoringSsl::Sign(
                 signature_length);
 }
 
+util::StatusOr<std::unique_ptr<PublicKeySigner>>
+RsaSsaPssSignBoringSsl::NewSigner() const {
+  return DigestSignerBoringSsl::New(
+      sig_hash_,
+      [this](absl::string_view digest) { return SignDigest(digest); });
+}
+
 }  // namespace subtle
 }  // namespace tink
 }  // namespace crypto
@@ -18,6 +18,7 @@
 #define TINK_CC_SIGNATURE_RSA_SIGN_BORINGSSL_H_
 
 #include <memory>
+#include <vector>
 
 #include "absl/strings/string_view.h"
 #include "openssl/base.h"
@@ -42,21 +43,44 @@ class RsaSsaPssSignBoringSsl : public PublicKeySign {
       const SubtleUtilBoringSSL::RsaPrivateKey& private_key,
       const SubtleUtilBoringSSL::RsaSsaPssParams& params);
 
+  // Like New(), but keeps 'num_key_shards' independent copies of the
+  // private key. Each copy carries its own blinding and Montgomery state,
+  // so concurrent Sign() calls from different threads do not contend on
+  // the locks inside a single BoringSSL RSA object.
+  static crypto::tink::util::StatusOr<std::unique_ptr<PublicKeySign>>
+  NewWithKeyShards(const SubtleUtilBoringSSL::RsaPrivateKey& private_key,
+                   const SubtleUtilBoringSSL::RsaSsaPssParams& params,
+                   int num_key_shards);
+
   // Computes the signature for 'data'.
   crypto::tink::util::StatusOr<std::string> Sign(
       absl::string_view data) const override;
 
+  // Computes the signature for 'digest', the hash of the data with the
+  // signature hash. Sign(data) is equivalent to SignDigest(hash(data)).
+  crypto::tink::util::StatusOr<std::string> SignDigest(
+      absl::string_view digest) const;
+
+  // Returns a signer that hashes the data as it is passed in.
+  crypto::tink::util::StatusOr<std::unique_ptr<PublicKeySigner>> NewSigner()
+      const override;
+
   ~RsaSsaPssSignBoringSsl() override = default;
 
  private:
-  const bssl::UniquePtr<RSA> private_key_;
+  // Returns the key copy assigned to the calling thread.
+  RSA* private_key() const;
+
+  const std::vector<bssl::UniquePtr<RSA>> private_keys_;
   const EVP_MD* sig_hash_;   // Owned by BoringSSL.
   const EVP_MD* mgf1_hash_;  // Owned by BoringSSL.
   int32_t salt_length_;
 
-  RsaSsaPssSignBoringSsl(bssl::UniquePtr<RSA> private_key,
+  RsaSsaPssSignBoringSsl(std::vector<bssl::UniquePtr<RSA>> private_keys,
                          const EVP_MD* sig_hash, const EVP_MD* mgf1_hash,
                          int32_t salt_length);
+
+  static constexpr int kMaxKeyShards = 256;
 };
 
 }  // namespace subtle
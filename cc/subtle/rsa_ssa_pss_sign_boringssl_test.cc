@@ -16,6 +16,9 @@
 
 #include "tink/subtle/rsa_ssa_pss_sign_boringssl.h"
 
+#include <thread>  // NOLINT(build/c++11)
+#include <vector>
+
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 #include "absl/strings/escaping.h"
@@ -88,6 +91,47 @@ TEST_F(RsaPssSignBoringsslTest, EncodesPssWithSeparateHashes) {
       IsOk());
 }
 
+TEST_F(RsaPssSignBoringsslTest, EncodesPssWithKeyShards) {
+  SubtleUtilBoringSSL::RsaSsaPssParams params{/*sig_hash=*/HashType::SHA256,
+                                              /*mgf1_hash=*/HashType::SHA256,
+                                              /*salt_length=*/32};
+
+  auto signer_or =
+      RsaSsaPssSignBoringSsl::NewWithKeyShards(private_key_, params, 4);
+  ASSERT_THAT(signer_or.status(), IsOk());
+  auto verifier_or = RsaSsaPssVerifyBoringSsl::New(public_key_, params);
+  ASSERT_THAT(verifier_or.status(), IsOk());
+  const PublicKeySign& signer = *signer_or.ValueOrDie();
+  const PublicKeyVerify& verifier = *verifier_or.ValueOrDie();
+
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 8; i++) {
+    threads.emplace_back([&signer, &verifier]() {
+      for (int j = 0; j < 4; j++) {
+        auto signature_or = signer.Sign("testdata");
+        ASSERT_THAT(signature_or.status(), IsOk());
+        EXPECT_THAT(verifier.Verify(signature_or.ValueOrDie(), "testdata"),
+                    IsOk());
+      }
+    });
+  }
+  for (auto& thread : threads) thread.join();
+}
+
+TEST_F(RsaPssSignBoringsslTest, RejectsInvalidNumberOfKeyShards) {
+  SubtleUtilBoringSSL::RsaSsaPssParams params{/*sig_hash=*/HashType::SHA256,
+                                              /*mgf1_hash=*/HashType::SHA256,
+                                              /*salt_length=*/32};
+  EXPECT_THAT(
+      RsaSsaPssSignBoringSsl::NewWithKeyShards(private_key_, params, 0)
+          .status(),
+      StatusIs(util::error::INVALID_ARGUMENT));
+  EXPECT_THAT(
+      RsaSsaPssSignBoringSsl::NewWithKeyShards(private_key_, params, 100000)
+          .status(),
+      StatusIs(util::error::INVALID_ARGUMENT));
+}
+
 TEST_F(RsaPssSignBoringsslTest, RejectsInvalidPaddingHash) {
   SubtleUtilBoringSSL::RsaSsaPssParams params{
       /*sig_hash=*/HashType::SHA256, /*mgf1_hash=*/HashType::UNKNOWN_HASH,
@@ -133,6 +177,69 @@ TEST_F(RsaPssSignBoringsslTest, RejectsInvalidCrtParams) {
   }
 }
 
+TEST_F(RsaPssSignBoringsslTest, SignsIncrementally) {
+  SubtleUtilBoringSSL::RsaSsaPssParams params{/*sig_hash=*/HashType::SHA256,
+                                              /*mgf1_hash=*/HashType::SHA256,
+                                              /*salt_length=*/32};
+
+  auto signer_or = RsaSsaPssSignBoringSsl::New(private_key_, params);
+  ASSERT_THAT(signer_or.status(), IsOk());
+  auto verifier_or = RsaSsaPssVerifyBoringSsl::New(public_key_, params);
+  ASSERT_THAT(verifier_or.status(), IsOk());
+
+  auto incremental_signer_or = signer_or.ValueOrDie()->NewSigner();
+  ASSERT_THAT(incremental_signer_or.status(), IsOk());
+  auto incremental_signer = std::move(incremental_signer_or.ValueOrDie());
+  EXPECT_THAT(incremental_signer->Update("test"), IsOk());
+  EXPECT_THAT(incremental_signer->Update(""), IsOk());
+  EXPECT_THAT(incremental_signer->Update("data"), IsOk());
+  auto signature_or = incremental_signer->Finalize();
+  ASSERT_THAT(signature_or.status(), IsOk());
+  EXPECT_THAT(
+      verifier_or.ValueOrDie()->Verify(signature_or.ValueOrDie(), "testdata"),
+      IsOk());
+
+  auto incremental_verifier_or =
+      verifier_or.ValueOrDie()->NewVerifier(signature_or.ValueOrDie());
+  ASSERT_THAT(incremental_verifier_or.status(), IsOk());
+  auto incremental_verifier = std::move(incremental_verifier_or.ValueOrDie());
+  EXPECT_THAT(incremental_verifier->Update("testd"), IsOk());
+  EXPECT_THAT(incremental_verifier->Update("ata"), IsOk());
+  EXPECT_THAT(incremental_verifier->Finalize(), IsOk());
+
+  incremental_verifier = std::move(
+      verifier_or.ValueOrDie()->NewVerifier(signature_or.ValueOrDie())
+          .ValueOrDie());
+  EXPECT_THAT(incremental_verifier->Update("otherdata"), IsOk());
+  EXPECT_THAT(incremental_verifier->Finalize(), Not(IsOk()));
+}
+
+TEST_F(RsaPssSignBoringsslTest, SignsDigest) {
+  SubtleUtilBoringSSL::RsaSsaPssParams params{/*sig_hash=*/HashType::SHA256,
+                                              /*mgf1_hash=*/HashType::SHA256,
+                                              /*salt_length=*/32};
+
+  auto signer_or = RsaSsaPssSignBoringSsl::New(private_key_, params);
+  ASSERT_THAT(signer_or.status(), IsOk());
+  const auto& signer =
+      static_cast<const RsaSsaPssSignBoringSsl&>(*signer_or.ValueOrDie());
+  auto verifier_or = RsaSsaPssVerifyBoringSsl::New(public_key_, params);
+  ASSERT_THAT(verifier_or.status(), IsOk());
+
+  auto digest_or = boringssl::ComputeHash("testdata", *EVP_sha256());
+  ASSERT_THAT(digest_or.status(), IsOk());
+  std::string digest(digest_or.ValueOrDie().begin(),
+                     digest_or.ValueOrDie().end());
+  auto signature_or = signer.SignDigest(digest);
+  ASSERT_THAT(signature_or.status(), IsOk());
+  EXPECT_THAT(
+      verifier_or.ValueOrDie()->Verify(signature_or.ValueOrDie(), "testdata"),
+      IsOk());
+
+  EXPECT_THAT(signer.SignDigest(digest.substr(1)).status(),
+              StatusIs(util::error::INVALID_ARGUMENT));
+}
+
 }  // namespace
 }  // namespace subtle
 }  // namespace tink
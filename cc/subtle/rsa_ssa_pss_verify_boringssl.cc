@@ -20,6 +20,7 @@
 #include "openssl/evp.h"
 #include "openssl/rsa.h"
 #include "tink/subtle/common_enums.h"
+#include "tink/subtle/digest_signer_boringssl.h"
 #include "tink/subtle/subtle_util_boringssl.h"
 #include "tink/util/errors.h"
 
@@ -93,10 +94,22 @@ util::Status RsaSsaPssVerifyBoringSsl::Verify(absl::string_view signature,
   auto digest_result = boringssl::ComputeHash(data, *sig_hash_);
   if (!digest_result.ok()) return digest_result.status();
   auto digest = std::move(digest_result.ValueOrDie());
+  return VerifyDigest(
+      signature,
+      absl::string_view(reinterpret_cast<const char*>(digest.data()),
+                        digest.size()));
+}
+
+util::Status RsaSsaPssVerifyBoringSsl::VerifyDigest(
+    absl::string_view signature, absl::string_view digest) const {
+  if (digest.size() != static_cast<size_t>(EVP_MD_size(sig_hash_))) {
+    return util::Status(util::error::INVALID_ARGUMENT, "Invalid digest size.");
+  }
 
   if (1 != RSA_verify_pss_mgf1(
-               rsa_.get(), digest.data(), digest.size(), sig_hash_, mgf1_hash_,
-               salt_length_, reinterpret_cast<const uint8_t*>(signature.data()),
+               rsa_.get(), reinterpret_cast<const uint8_t*>(digest.data()),
+               digest.size(), sig_hash_, mgf1_hash_, salt_length_,
+               reinterpret_cast<const uint8_t*>(signature.data()),
                signature.length())) {
     // Signature is invalid.
     return util::Status(util::error::UNKNOWN, "Signature is not valid.");
@@ -104,6 +117,15 @@ util::Status RsaSsaPssVerifyBoringSsl::Verify(absl::string_view signature,
   return util::Status::OK;
 }
 
+util::StatusOr<std::unique_ptr<PublicKeyVerifier>>
+RsaSsaPssVerifyBoringSsl::NewVerifier(absl::string_view signature) const {
+  std::string signature_copy(signature);
+  return DigestVerifierBoringSsl::New(
+      sig_hash_, [this, signature_copy](absl::string_view digest) {
+        return VerifyDigest(signature_copy, digest);
+      });
+}
+
 }  // namespace subtle
 }  // namespace tink
 }  // namespace crypto
@@ -45,6 +45,16 @@ class RsaSsaPssVerifyBoringSsl : public PublicKeyVerify {
   crypto::tink::util::Status Verify(absl::string_view signature,
                                     absl::string_view data) const override;
 
+  // Verifies that 'signature' is a digital signature for 'digest', the hash
+  // of the data with the signature hash. Verify(signature, data) is
+  // equivalent to VerifyDigest(signature, hash(data)).
+  crypto::tink::util::Status VerifyDigest(absl::string_view signature,
+                                          absl::string_view digest) const;
+
+  // Returns a verifier that hashes the data as it is passed in.
+  crypto::tink::util::StatusOr<std::unique_ptr<PublicKeyVerifier>>
+  NewVerifier(absl::string_view signature) const override;
+
   ~RsaSsaPssVerifyBoringSsl() override = default;
 
  private:
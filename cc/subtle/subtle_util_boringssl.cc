@@ -15,12 +15,19 @@
 ///////////////////////////////////////////////////////////////////////////////
 
 #include "tink/subtle/subtle_util_boringssl.h"
+
+#include <mutex>  // NOLINT(build/c++11)
+#include <unordered_set>
+
 #include "absl/strings/str_cat.h"
 #include "absl/strings/substitute.h"
 #include "openssl/bn.h"
 #include "openssl/ec.h"
 #include "openssl/err.h"
+#include "openssl/hmac.h"
+#include "openssl/rand.h"
 #include "openssl/rsa.h"
+#include "openssl/sha.h"
 #include "tink/subtle/common_enums.h"
 
 namespace crypto {
@@ -29,6 +36,80 @@ namespace subtle {
 
 namespace {
 
+// Process-wide set of fingerprints of RSA private keys that passed
+// RSA_check_key and RSA_check_fips. Only successful checks are recorded, so
+// a key that is not found in the cache is always fully checked.
+// The fingerprints are HMAC-SHA256 tags under a random key drawn once per
+// process, so the cache holds no unkeyed digest of private key material.
+class ValidatedRsaKeyCache {
+ public:
+  static ValidatedRsaKeyCache& GetInstance() {
+    static ValidatedRsaKeyCache* cache = new ValidatedRsaKeyCache();
+    return *cache;
+  }
+
+  // Returns the fingerprint of 'key', or an empty string on failure.
+  std::string Fingerprint(const SubtleUtilBoringSSL::RsaPrivateKey& key) {
+    if (!has_fingerprint_key_) return "";
+    bssl::UniquePtr<HMAC_CTX> ctx(HMAC_CTX_new());
+    if (ctx == nullptr ||
+        !HMAC_Init_ex(ctx.get(), fingerprint_key_, sizeof(fingerprint_key_),
+                      EVP_sha256(), nullptr)) {
+      return "";
+    }
+    for (const std::string* component : {&key.n, &key.e, &key.d, &key.p,
+                                         &key.q, &key.dp, &key.dq, &key.crt}) {
+      uint8_t length[4] = {
+          static_cast<uint8_t>(component->size() >> 24),
+          static_cast<uint8_t>(component->size() >> 16),
+          static_cast<uint8_t>(component->size() >> 8),
+          static_cast<uint8_t>(component->size())};
+      if (!HMAC_Update(ctx.get(), length, sizeof(length)) ||
+          !HMAC_Update(ctx.get(),
+                       reinterpret_cast<const uint8_t*>(component->data()),
+                       component->size())) {
+        return "";
+      }
+    }
+    uint8_t tag[SHA256_DIGEST_LENGTH];
+    unsigned int tag_size;
+    if (!HMAC_Final(ctx.get(), tag, &tag_size)) return "";
+    return std::string(reinterpret_cast<const char*>(tag), tag_size);
+  }
+
+  bool Contains(const std::string& fingerprint) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (fingerprints_.count(fingerprint) == 0) return false;
+    hits_++;
+    return true;
+  }
+
+  void Insert(const std::string& fingerprint) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (fingerprints_.size() < kMaxEntries) fingerprints_.insert(fingerprint);
+  }
+
+  uint64_t hits() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return hits_;
+  }
+
+ private:
+  static const size_t kMaxEntries = 4096;
+
+  ValidatedRsaKeyCache()
+      : has_fingerprint_key_(RAND_bytes(fingerprint_key_,
+                                        sizeof(fingerprint_key_)) == 1),
+        hits_(0) {}
+
+  uint8_t fingerprint_key_[SHA256_DIGEST_LENGTH];
+  // Without a key nothing is fingerprinted, and every key is checked.
+  const bool has_fingerprint_key_;
+  std::mutex mutex_;
+  std::unordered_set<std::string> fingerprints_;  // guarded by mutex_
+  uint64_t hits_;                                 // guarded by mutex_
+};
+
 size_t ScalarSizeInBytes(const EC_GROUP* group) {
   return BN_num_bytes(EC_GROUP_get0_order(group));
 }
@@ -510,6 +591,45 @@ util::Status SubtleUtilBoringSSL::CopyCrtParams(
   return util::OkStatus();
 }
 
+// static
+util::StatusOr<bssl::UniquePtr<RSA>>
+SubtleUtilBoringSSL::BoringSslRsaFromRsaPrivateKey(const RsaPrivateKey &key) {
+  bssl::UniquePtr<RSA> rsa(RSA_new());
+  if (rsa == nullptr) {
+    return util::Status(util::error::INTERNAL, "Could not initialize RSA.");
+  }
+
+  {
+    auto st = CopyKey(key, rsa.get());
+    if (!st.ok()) return st;
+  }
+  {
+    auto st = CopyPrimeFactors(key, rsa.get());
+    if (!st.ok()) return st;
+  }
+  {
+    auto st = CopyCrtParams(key, rsa.get());
+    if (!st.ok()) return st;
+  }
+
+  ValidatedRsaKeyCache& cache = ValidatedRsaKeyCache::GetInstance();
+  std::string fingerprint = cache.Fingerprint(key);
+  if (fingerprint.empty() || !cache.Contains(fingerprint)) {
+    if (RSA_check_key(rsa.get()) == 0 || RSA_check_fips(rsa.get()) == 0) {
+      return util::Status(
+          util::error::INVALID_ARGUMENT,
+          absl::StrCat("Could not load RSA key: ", GetErrors()));
+    }
+    if (!fingerprint.empty()) cache.Insert(fingerprint);
+  }
+  return std::move(rsa);
+}
+
+// static
+uint64_t SubtleUtilBoringSSL::ValidatedRsaKeyCacheHits() {
+  return ValidatedRsaKeyCache::GetInstance().hits();
+}
+
 namespace boringssl {
 
 util::StatusOr<std::vector<uint8_t>> ComputeHash(absl::string_view input,
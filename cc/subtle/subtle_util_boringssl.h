@@ -23,6 +23,7 @@
 #include "openssl/bn.h"
 #include "openssl/err.h"
 #include "openssl/evp.h"
+#include "openssl/rsa.h"
 #include "tink/subtle/common_enums.h"
 #include "tink/util/status.h"
 #include "tink/util/statusor.h"
@@ -179,6 +180,20 @@ class SubtleUtilBoringSSL {
 
   // Copies the CRT params and dp, dq into the RSA key.
   static util::Status CopyCrtParams(const RsaPrivateKey &key, RSA *rsa);
+
+  // Returns BoringSSL's RSA private key holding the material of 'key',
+  // after checking it with RSA_check_key and RSA_check_fips.
+  // These checks take tens of milliseconds for large moduli, so keys that
+  // passed them are remembered for the lifetime of the process, by an
+  // HMAC-SHA256 of all their components under a random per-process key, and
+  // are not checked again. Keys that are not remembered (e.g. because the
+  // cache is full) are always checked.
+  static util::StatusOr<bssl::UniquePtr<RSA>> BoringSslRsaFromRsaPrivateKey(
+      const RsaPrivateKey &key);
+
+  // Returns how many times BoringSslRsaFromRsaPrivateKey skipped the checks
+  // of a remembered key. For testing only.
+  static uint64_t ValidatedRsaKeyCacheHits();
 };
 
 namespace boringssl {
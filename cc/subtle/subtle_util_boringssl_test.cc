@@ -394,6 +394,35 @@ TEST(CreatesNewRsaKeyPairTest, GeneratesDifferentKeysEveryTime) {
   }
 }
 
+TEST(BoringSslRsaFromRsaPrivateKeyTest, CachedKeyDoesNotMaskInvalidKey) {
+  SubtleUtilBoringSSL::RsaPublicKey public_key;
+  SubtleUtilBoringSSL::RsaPrivateKey private_key;
+  bssl::UniquePtr<BIGNUM> e(BN_new());
+  BN_set_word(e.get(), RSA_F4);
+  ASSERT_THAT(SubtleUtilBoringSSL::GetNewRsaKeyPair(2048, e.get(), &private_key,
+                                                    &public_key),
+              IsOk());
+
+  // The second load is served from the validation cache.
+  uint64_t hits = SubtleUtilBoringSSL::ValidatedRsaKeyCacheHits();
+  EXPECT_THAT(
+      SubtleUtilBoringSSL::BoringSslRsaFromRsaPrivateKey(private_key).status(),
+      IsOk());
+  EXPECT_EQ(hits, SubtleUtilBoringSSL::ValidatedRsaKeyCacheHits());
+  EXPECT_THAT(
+      SubtleUtilBoringSSL::BoringSslRsaFromRsaPrivateKey(private_key).status(),
+      IsOk());
+  EXPECT_EQ(hits + 1, SubtleUtilBoringSSL::ValidatedRsaKeyCacheHits());
+
+  // A key differing in a single CRT parameter must still be checked.
+  SubtleUtilBoringSSL::RsaPrivateKey invalid_key = private_key;
+  invalid_key.crt[0] ^= 0x80;
+  EXPECT_THAT(
+      SubtleUtilBoringSSL::BoringSslRsaFromRsaPrivateKey(invalid_key).status(),
+      StatusIs(util::error::INVALID_ARGUMENT));
+  EXPECT_EQ(hits + 1, SubtleUtilBoringSSL::ValidatedRsaKeyCacheHits());
+}
+
 TEST(ComputeHashTest, AcceptsNullStringView) {
   auto null_hash =
       boringssl::ComputeHash(absl::string_view(nullptr, 0), *EVP_sha512());
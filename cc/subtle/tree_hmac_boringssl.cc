@@ -0,0 +1,245 @@
+// Copyright 2018 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/subtle/tree_hmac_boringssl.h"
+
+#include <memory>
+#include <string>
+
+#include "absl/strings/string_view.h"
+#include "openssl/crypto.h"
+#include "openssl/digest.h"
+#include "openssl/evp.h"
+#include "openssl/hmac.h"
+#include "tink/mac.h"
+#include "tink/subtle/common_enums.h"
+#include "tink/subtle/parallel_for.h"
+#include "tink/subtle/subtle_util_boringssl.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+
+namespace {
+
+const uint8_t kChunkTag = 0x00;
+const uint8_t kRootTag = 0x01;
+
+std::string BigEndian64(uint64_t value) {
+  std::string out(8, '\0');
+  for (int i = 7; i >= 0; i--) {
+    out[i] = static_cast<char>(value);
+    value >>= 8;
+  }
+  return out;
+}
+
+util::Status HmacUpdate(HMAC_CTX* ctx, absl::string_view data) {
+  if (1 != HMAC_Update(ctx, reinterpret_cast<const uint8_t*>(data.data()),
+                       data.size())) {
+    return util::Status(util::error::INTERNAL, "HMAC_Update failed");
+  }
+  return util::Status::OK;
+}
+
+}  // namespace
+
+// static
+util::StatusOr<std::unique_ptr<TreeHmacBoringSsl>> TreeHmacBoringSsl::New(
+    HashType hash_type, uint32_t tag_size, uint32_t chunk_size,
+    const std::string& key_value) {
+  if (hash_type != SHA256 && hash_type != SHA512) {
+    return util::Status(util::error::INVALID_ARGUMENT,
+                        "hash_type must be SHA256 or SHA512");
+  }
+  util::StatusOr<const EVP_MD*> res = SubtleUtilBoringSSL::EvpHash(hash_type);
+  if (!res.ok()) {
+    return res.status();
+  }
+  const EVP_MD* md = res.ValueOrDie();
+  // The key manager is responsible to security policies.
+  // The checks here just ensure the preconditions of the primitive.
+  if (EVP_MD_size(md) < tag_size) {
+    return util::Status(util::error::INTERNAL, "invalid tag size");
+  }
+  if (chunk_size == 0) {
+    return util::Status(util::error::INTERNAL, "invalid chunk size");
+  }
+  if (key_value.size() < MIN_KEY_SIZE) {
+    return util::Status(util::error::INTERNAL, "invalid key size");
+  }
+  return std::unique_ptr<TreeHmacBoringSsl>(
+      new TreeHmacBoringSsl(md, tag_size, chunk_size, key_value));
+}
+
+util::Status TreeHmacBoringSsl::HashChunks(absl::string_view data,
+                                           uint64_t num_chunks,
+                                           uint8_t* out) const {
+  const size_t digest_size = EVP_MD_size(md_);
+  return ParallelFor(0, num_chunks, chunk_size_, [&]() -> ItemFunction {
+    // ItemFunction must be copyable, so the context is held by a shared_ptr.
+    std::shared_ptr<EVP_MD_CTX> ctx(EVP_MD_CTX_new(), EVP_MD_CTX_free);
+    return [this, data, out, digest_size, ctx](uint64_t chunk) {
+      absl::string_view chunk_data =
+          data.substr(chunk * chunk_size_, chunk_size_);
+      if (ctx == nullptr ||
+          1 != EVP_DigestInit_ex(ctx.get(), md_, nullptr /* engine */) ||
+          1 != EVP_DigestUpdate(ctx.get(), &kChunkTag, 1) ||
+          1 != EVP_DigestUpdate(ctx.get(), chunk_data.data(),
+                                chunk_data.size()) ||
+          1 != EVP_DigestFinal_ex(ctx.get(), out + chunk * digest_size,
+                                  nullptr)) {
+        return util::Status(util::error::INTERNAL,
+                            "BoringSSL failed to hash a chunk");
+      }
+      return util::Status::OK;
+    };
+  });
+}
+
+util::StatusOr<std::unique_ptr<TreeHmacBoringSsl::Computation>>
+TreeHmacBoringSsl::NewComputation() const {
+  std::unique_ptr<Computation> computation(new Computation(this));
+  util::Status status = computation->Init();
+  if (!status.ok()) return status;
+  return std::move(computation);
+}
+
+util::StatusOr<std::string> TreeHmacBoringSsl::ComputeMac(
+    absl::string_view data) const {
+  auto computation_result = NewComputation();
+  if (!computation_result.ok()) return computation_result.status();
+  auto computation = std::move(computation_result.ValueOrDie());
+  util::Status status = computation->Update(data);
+  if (!status.ok()) return status;
+  return computation->ComputeMac();
+}
+
+util::Status TreeHmacBoringSsl::VerifyMac(
+    absl::string_view mac,
+    absl::string_view data) const {
+  auto computation_result = NewComputation();
+  if (!computation_result.ok()) return computation_result.status();
+  auto computation = std::move(computation_result.ValueOrDie());
+  util::Status status = computation->Update(data);
+  if (!status.ok()) return status;
+  return computation->VerifyMac(mac);
+}
+
+TreeHmacBoringSsl::Computation::Computation(
+    const TreeHmacBoringSsl* tree_hmac)
+    : tree_hmac_(tree_hmac), data_size_(0), finished_(false) {}
+
+util::Status TreeHmacBoringSsl::Computation::Init() {
+  const std::string& key = tree_hmac_->key_value_;
+  root_.reset(HMAC_CTX_new());
+  if (root_ == nullptr ||
+      1 != HMAC_Init_ex(root_.get(), key.data(), key.size(), tree_hmac_->md_,
+                        nullptr /* engine */)) {
+    return util::Status(util::error::INTERNAL, "HMAC_Init_ex failed");
+  }
+  std::string prefix(1, static_cast<char>(kRootTag));
+  prefix.append(BigEndian64(tree_hmac_->chunk_size_));
+  return HmacUpdate(root_.get(), prefix);
+}
+
+util::Status TreeHmacBoringSsl::Computation::AddChunks(
+    absl::string_view data) {
+  uint64_t num_chunks = data.size() / tree_hmac_->chunk_size_;
+  std::vector<uint8_t> hashes(num_chunks * EVP_MD_size(tree_hmac_->md_));
+  util::Status status =
+      tree_hmac_->HashChunks(data, num_chunks, hashes.data());
+  if (!status.ok()) return status;
+  return HmacUpdate(root_.get(),
+                    absl::string_view(reinterpret_cast<char*>(hashes.data()),
+                                      hashes.size()));
+}
+
+util::Status TreeHmacBoringSsl::Computation::Update(absl::string_view data) {
+  if (finished_) {
+    return util::Status(util::error::FAILED_PRECONDITION,
+                        "computation already finished");
+  }
+  const size_t chunk_size = tree_hmac_->chunk_size_;
+  data_size_ += data.size();
+  if (!pending_.empty()) {
+    size_t fill = std::min(data.size(), chunk_size - pending_.size());
+    pending_.append(data.data(), fill);
+    data.remove_prefix(fill);
+    if (pending_.size() < chunk_size) return util::Status::OK;
+    util::Status status = AddChunks(pending_);
+    if (!status.ok()) return status;
+    pending_.clear();
+  }
+  size_t complete = data.size() / chunk_size * chunk_size;
+  util::Status status = AddChunks(data.substr(0, complete));
+  if (!status.ok()) return status;
+  data.remove_prefix(complete);
+  pending_.assign(data.data(), data.size());
+  return util::Status::OK;
+}
+
+util::StatusOr<std::string> TreeHmacBoringSsl::Computation::Finish() {
+  if (finished_) {
+    return util::Status(util::error::FAILED_PRECONDITION,
+                        "computation already finished");
+  }
+  finished_ = true;
+  // The last chunk is hashed even if empty, unless the data ended exactly
+  // at a chunk boundary.
+  if (!pending_.empty() || data_size_ == 0) {
+    uint8_t hash[EVP_MAX_MD_SIZE];
+    util::Status status = tree_hmac_->HashChunks(pending_, 1, hash);
+    if (!status.ok()) return status;
+    status = HmacUpdate(
+        root_.get(), absl::string_view(reinterpret_cast<char*>(hash),
+                                       EVP_MD_size(tree_hmac_->md_)));
+    if (!status.ok()) return status;
+  }
+  util::Status status = HmacUpdate(root_.get(), BigEndian64(data_size_));
+  if (!status.ok()) return status;
+  uint8_t buf[EVP_MAX_MD_SIZE];
+  unsigned int out_len;
+  if (1 != HMAC_Final(root_.get(), buf, &out_len)) {
+    return util::Status(util::error::INTERNAL, "HMAC_Final failed");
+  }
+  return std::string(reinterpret_cast<char*>(buf), out_len);
+}
+
+util::StatusOr<std::string> TreeHmacBoringSsl::Computation::ComputeMac() {
+  auto result = Finish();
+  if (!result.ok()) return result.status();
+  return result.ValueOrDie().substr(0, tree_hmac_->tag_size_);
+}
+
+util::Status TreeHmacBoringSsl::Computation::VerifyMac(
+    absl::string_view mac) {
+  if (mac.size() != tree_hmac_->tag_size_) {
+    return util::Status(util::error::INVALID_ARGUMENT, "incorrect tag size");
+  }
+  auto result = Finish();
+  if (!result.ok()) return result.status();
+  if (CRYPTO_memcmp(result.ValueOrDie().data(), mac.data(), mac.size()) != 0) {
+    return util::Status(util::error::INVALID_ARGUMENT, "verification failed");
+  }
+  return util::Status::OK;
+}
+
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
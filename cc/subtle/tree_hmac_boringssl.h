@@ -0,0 +1,134 @@
+// Copyright 2018 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_SUBTLE_TREE_HMAC_BORINGSSL_H_
+#define TINK_SUBTLE_TREE_HMAC_BORINGSSL_H_
+
+#include <memory>
+#include <string>
+
+#include "absl/strings/string_view.h"
+#include "openssl/evp.h"
+#include "openssl/hmac.h"
+#include "tink/mac.h"
+#include "tink/subtle/common_enums.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+
+// A MAC for large inputs whose computation is spread over all cores.
+//
+// The data is split into chunks of chunk_size bytes (the last chunk may be
+// shorter; empty data is a single empty chunk). Each chunk is hashed on its
+// own as H(0x00 || chunk), and the tag is
+//   HMAC(key, 0x01 || chunk_size (8 bytes, big endian) ||
+//             H(chunk_0) || ... || H(chunk_n-1) ||
+//             data_size (8 bytes, big endian)),
+// truncated to tag_size bytes, with H being SHA-256 or SHA-512. This is a
+// two-level tree in the spirit of ParallelHash (NIST SP 800-185): the chunk
+// hashes are independent and computed on up to hardware_concurrency()
+// threads, while the keyed root only covers one digest per chunk.
+//
+// Besides ComputeMac() and VerifyMac(), NewComputation() returns an
+// incremental computation of the same tag, for data that arrives in pieces.
+class TreeHmacBoringSsl : public Mac {
+ public:
+  // Computes the tag of data given in pieces. A computation is not
+  // thread-safe, and cannot be used after ComputeMac() or VerifyMac().
+  class Computation {
+   public:
+    // Appends 'data' to the data to be authenticated. Complete chunks are
+    // hashed right away, those within 'data' in parallel.
+    crypto::tink::util::Status Update(absl::string_view data);
+
+    // Returns the tag of all data given to Update().
+    crypto::tink::util::StatusOr<std::string> ComputeMac();
+
+    // Verifies that 'mac' is the tag of all data given to Update().
+    crypto::tink::util::Status VerifyMac(absl::string_view mac);
+
+   private:
+    friend class TreeHmacBoringSsl;
+
+    explicit Computation(const TreeHmacBoringSsl* tree_hmac);
+
+    crypto::tink::util::Status Init();
+
+    // Hashes the complete chunks in 'data' into the root HMAC.
+    crypto::tink::util::Status AddChunks(absl::string_view data);
+
+    // Returns the full root HMAC.
+    crypto::tink::util::StatusOr<std::string> Finish();
+
+    const TreeHmacBoringSsl* tree_hmac_;
+    bssl::UniquePtr<HMAC_CTX> root_;
+    std::string pending_;
+    uint64_t data_size_;
+    bool finished_;
+  };
+
+  // 'hash_type' must be SHA256 or SHA512, 'tag_size' at most the digest
+  // size, 'chunk_size' positive and the key at least 16 bytes.
+  static crypto::tink::util::StatusOr<std::unique_ptr<TreeHmacBoringSsl>>
+  New(HashType hash_type, uint32_t tag_size, uint32_t chunk_size,
+      const std::string& key_value);
+
+  // Computes and returns the tag for 'data'.
+  crypto::tink::util::StatusOr<std::string> ComputeMac(
+      absl::string_view data) const override;
+
+  // Verifies if 'mac' is a correct tag for 'data'.
+  // Returns Status::OK if 'mac' is correct, and a non-OK-Status otherwise.
+  crypto::tink::util::Status VerifyMac(
+      absl::string_view mac,
+      absl::string_view data) const override;
+
+  // Returns a new incremental computation.
+  crypto::tink::util::StatusOr<std::unique_ptr<Computation>>
+  NewComputation() const;
+
+  ~TreeHmacBoringSsl() override {}
+
+ private:
+  // Minimum key size in bytes.
+  static const size_t MIN_KEY_SIZE = 16;
+
+  TreeHmacBoringSsl(const EVP_MD* md, uint32_t tag_size, uint32_t chunk_size,
+                    const std::string& key_value)
+      : md_(md), tag_size_(tag_size), chunk_size_(chunk_size),
+        key_value_(key_value) {}
+
+  // Writes the hashes of the 'num_chunks' chunks at the start of 'data' to
+  // 'out', which must hold num_chunks * EVP_MD_size(md_) bytes.
+  crypto::tink::util::Status HashChunks(absl::string_view data,
+                                        uint64_t num_chunks,
+                                        uint8_t* out) const;
+
+  // TreeHmacBoringSsl is not owner of md (it is owned by BoringSSL).
+  const EVP_MD* md_;
+  const uint32_t tag_size_;
+  const uint32_t chunk_size_;
+  const std::string key_value_;
+};
+
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_SUBTLE_TREE_HMAC_BORINGSSL_H_
@@ -0,0 +1,182 @@
+// Copyright 2018 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/subtle/tree_hmac_boringssl.h"
+
+#include <string>
+#include <vector>
+
+#include "absl/strings/string_view.h"
+#include "openssl/sha.h"
+#include "tink/mac.h"
+#include "tink/subtle/common_enums.h"
+#include "tink/subtle/hmac_boringssl.h"
+#include "tink/subtle/random.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+#include "gtest/gtest.h"
+
+namespace crypto {
+namespace tink {
+namespace subtle {
+namespace {
+
+std::string BigEndian64(uint64_t value) {
+  std::string out;
+  for (int shift = 56; shift >= 0; shift -= 8) {
+    out.push_back(static_cast<char>(value >> shift));
+  }
+  return out;
+}
+
+std::string Hash(HashType hash_type, const std::string& data) {
+  uint8_t digest[SHA512_DIGEST_LENGTH];
+  const uint8_t* in = reinterpret_cast<const uint8_t*>(data.data());
+  if (hash_type == SHA256) {
+    ::SHA256(in, data.size(), digest);
+    return std::string(reinterpret_cast<char*>(digest), SHA256_DIGEST_LENGTH);
+  }
+  ::SHA512(in, data.size(), digest);
+  return std::string(reinterpret_cast<char*>(digest), SHA512_DIGEST_LENGTH);
+}
+
+// Computes the tag serially, following the definition in the header.
+std::string ReferenceMac(HashType hash_type, uint32_t tag_size,
+                         uint32_t chunk_size, const std::string& key,
+                         const std::string& data) {
+  std::string root("\x01", 1);
+  root.append(BigEndian64(chunk_size));
+  size_t pos = 0;
+  do {
+    root.append(Hash(hash_type, std::string("\x00", 1) +
+                                    data.substr(pos, chunk_size)));
+    pos += chunk_size;
+  } while (pos < data.size());
+  root.append(BigEndian64(data.size()));
+  auto hmac = std::move(
+      HmacBoringSsl::New(hash_type, tag_size, key).ValueOrDie());
+  return hmac->ComputeMac(root).ValueOrDie();
+}
+
+std::unique_ptr<TreeHmacBoringSsl> NewTreeHmac(
+    HashType hash_type, uint32_t tag_size, uint32_t chunk_size,
+    const std::string& key) {
+  auto result = TreeHmacBoringSsl::New(hash_type, tag_size, chunk_size, key);
+  EXPECT_TRUE(result.ok()) << result.status();
+  return std::move(result.ValueOrDie());
+}
+
+TEST(TreeHmacBoringSslTest, testMatchesReference) {
+  const uint32_t chunk_size = 1024;
+  std::string key = Random::GetRandomBytes(32);
+  for (HashType hash_type : {SHA256, SHA512}) {
+    for (uint32_t tag_size : {16, 32}) {
+      auto tree_hmac = NewTreeHmac(hash_type, tag_size, chunk_size, key);
+      for (size_t size : {0, 1, 1023, 1024, 1025, 3072, 5 * 1024 + 7}) {
+        SCOPED_TRACE(size);
+        std::string data = Random::GetRandomBytes(size);
+        auto result = tree_hmac->ComputeMac(data);
+        ASSERT_TRUE(result.ok()) << result.status();
+        EXPECT_EQ(ReferenceMac(hash_type, tag_size, chunk_size, key, data),
+                  result.ValueOrDie());
+        EXPECT_TRUE(tree_hmac->VerifyMac(result.ValueOrDie(), data).ok());
+      }
+    }
+  }
+}
+
+TEST(TreeHmacBoringSslTest, testIncremental) {
+  // Large enough to be hashed on several threads.
+  const uint32_t chunk_size = 4096;
+  std::string key = Random::GetRandomBytes(32);
+  auto tree_hmac = NewTreeHmac(SHA256, 32, chunk_size, key);
+  std::string data = Random::GetRandomBytes((4 << 20) + 100);
+  std::string tag = tree_hmac->ComputeMac(data).ValueOrDie();
+  EXPECT_EQ(ReferenceMac(SHA256, 32, chunk_size, key, data), tag);
+
+  for (size_t piece_size : {1, 1000, 4096, 5000, 1 << 20, 3 << 20}) {
+    SCOPED_TRACE(piece_size);
+    // Short pieces are slow to feed one by one; use a prefix of the data.
+    std::string input =
+        piece_size < 1000 ? data.substr(0, 3 * chunk_size + 5) : data;
+    auto computation =
+        std::move(tree_hmac->NewComputation().ValueOrDie());
+    for (size_t pos = 0; pos < input.size(); pos += piece_size) {
+      ASSERT_TRUE(
+          computation->Update(absl::string_view(input).substr(pos, piece_size))
+              .ok());
+    }
+    auto result = computation->ComputeMac();
+    ASSERT_TRUE(result.ok()) << result.status();
+    EXPECT_EQ(tree_hmac->ComputeMac(input).ValueOrDie(), result.ValueOrDie());
+  }
+
+  auto computation = std::move(tree_hmac->NewComputation().ValueOrDie());
+  EXPECT_TRUE(computation->Update(data.substr(0, 12345)).ok());
+  EXPECT_TRUE(computation->Update("").ok());
+  EXPECT_TRUE(computation->Update(data.substr(12345)).ok());
+  EXPECT_TRUE(computation->VerifyMac(tag).ok());
+  // A finished computation cannot be used again.
+  EXPECT_FALSE(computation->Update("more").ok());
+  EXPECT_FALSE(computation->ComputeMac().ok());
+}
+
+TEST(TreeHmacBoringSslTest, testModification) {
+  const uint32_t chunk_size = 1024;
+  std::string key = Random::GetRandomBytes(16);
+  auto tree_hmac = NewTreeHmac(SHA256, 16, chunk_size, key);
+  std::string data = Random::GetRandomBytes(4 * chunk_size);
+  std::string tag = tree_hmac->ComputeMac(data).ValueOrDie();
+
+  for (size_t pos : {0, 1023, 1024, 4095}) {
+    std::string modified = data;
+    modified[pos] ^= 0x01;
+    EXPECT_FALSE(tree_hmac->VerifyMac(tag, modified).ok()) << pos;
+  }
+  for (size_t pos = 0; pos < tag.size(); pos++) {
+    std::string modified = tag;
+    modified[pos] ^= 0x01;
+    EXPECT_FALSE(tree_hmac->VerifyMac(modified, data).ok()) << pos;
+  }
+  EXPECT_FALSE(tree_hmac->VerifyMac(tag, data.substr(0, 3 * chunk_size)).ok());
+  EXPECT_FALSE(tree_hmac->VerifyMac(tag, data + std::string(1, '\0')).ok());
+  EXPECT_FALSE(tree_hmac->VerifyMac(tag.substr(0, 15), data).ok());
+
+  // The chunk size is part of the tag.
+  auto other_hmac = NewTreeHmac(SHA256, 16, 2 * chunk_size, key);
+  EXPECT_FALSE(other_hmac->VerifyMac(tag, data).ok());
+}
+
+TEST(TreeHmacBoringSslTest, testInvalidParameters) {
+  std::string key = Random::GetRandomBytes(16);
+  EXPECT_TRUE(TreeHmacBoringSsl::New(SHA256, 32, 1024, key).ok());
+  EXPECT_TRUE(TreeHmacBoringSsl::New(SHA512, 64, 1024, key).ok());
+  EXPECT_FALSE(TreeHmacBoringSsl::New(SHA1, 16, 1024, key).ok());
+  EXPECT_FALSE(TreeHmacBoringSsl::New(SHA256, 33, 1024, key).ok());
+  EXPECT_FALSE(TreeHmacBoringSsl::New(SHA256, 32, 0, key).ok());
+  EXPECT_FALSE(
+      TreeHmacBoringSsl::New(SHA256, 32, 1024, key.substr(0, 15)).ok());
+}
+
+}  // namespace
+}  // namespace subtle
+}  // namespace tink
+}  // namespace crypto
+
+int main(int ac, char* av[]) {
+  testing::InitGoogleTest(&ac, av);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,45 @@
+// Copyright 2018 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/util/buffer_random_access_stream.h"
+
+#include <string.h>
+
+namespace crypto {
+namespace tink {
+namespace util {
+
+Status BufferRandomAccessStream::PRead(uint64_t position, size_t count,
+                                       char* dest) {
+  if (position > buffer_.size() || count > buffer_.size() - position) {
+    return Status(error::OUT_OF_RANGE, "Read past the end of the buffer.");
+  }
+  if (count > 0) memcpy(dest, buffer_.data() + position, count);
+  return Status::OK;
+}
+
+Status BufferRandomAccessSink::PWrite(uint64_t position,
+                                      absl::string_view data) {
+  if (position > size_ || data.size() > size_ - position) {
+    return Status(error::OUT_OF_RANGE, "Write past the end of the buffer.");
+  }
+  if (!data.empty()) memcpy(buffer_ + position, data.data(), data.size());
+  return Status::OK;
+}
+
+}  // namespace util
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,74 @@
+// Copyright 2018 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_UTIL_BUFFER_RANDOM_ACCESS_STREAM_H_
+#define TINK_UTIL_BUFFER_RANDOM_ACCESS_STREAM_H_
+
+#include "absl/strings/string_view.h"
+#include "tink/random_access_stream.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace util {
+
+// A RandomAccessStream that reads from a memory buffer, e.g. a string or
+// a memory-mapped file. The buffer is not owned and must outlive the
+// stream.
+class BufferRandomAccessStream : public RandomAccessStream {
+ public:
+  explicit BufferRandomAccessStream(absl::string_view buffer)
+      : buffer_(buffer) {}
+
+  crypto::tink::util::Status PRead(
+      uint64_t position, size_t count, char* dest) override;
+
+  crypto::tink::util::StatusOr<uint64_t> size() override {
+    return static_cast<uint64_t>(buffer_.size());
+  }
+
+  ~BufferRandomAccessStream() override {}
+
+ private:
+  const absl::string_view buffer_;
+};
+
+// A RandomAccessSink that writes to a memory buffer of fixed size, e.g. a
+// string resized to the expected output size. The buffer is not owned and
+// must outlive the sink.
+class BufferRandomAccessSink : public RandomAccessSink {
+ public:
+  BufferRandomAccessSink(char* buffer, size_t size)
+      : buffer_(buffer), size_(size) {}
+
+  // Returns an OUT_OF_RANGE error if 'data' does not fit into the buffer
+  // at 'position'.
+  crypto::tink::util::Status PWrite(
+      uint64_t position, absl::string_view data) override;
+
+  ~BufferRandomAccessSink() override {}
+
+ private:
+  char* const buffer_;
+  const size_t size_;
+};
+
+}  // namespace util
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_UTIL_BUFFER_RANDOM_ACCESS_STREAM_H_
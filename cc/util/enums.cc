@@ -135,6 +135,34 @@ pb::EcdsaSignatureEncoding Enums::SubtleToProto(
   }
 }
 
+// static
+subtle::HpkeAead Enums::ProtoToSubtle(pb::HpkeAead aead) {
+  switch (aead) {
+    case pb::HpkeAead::AES_128_GCM:
+      return subtle::HpkeAead::AES_128_GCM;
+    case pb::HpkeAead::AES_256_GCM:
+      return subtle::HpkeAead::AES_256_GCM;
+    case pb::HpkeAead::CHACHA20_POLY1305:
+      return subtle::HpkeAead::CHACHA20_POLY1305;
+    default:
+      return subtle::HpkeAead::UNKNOWN_HPKE_AEAD;
+  }
+}
+
+// static
+pb::HpkeAead Enums::SubtleToProto(subtle::HpkeAead aead) {
+  switch (aead) {
+    case subtle::HpkeAead::AES_128_GCM:
+      return pb::HpkeAead::AES_128_GCM;
+    case subtle::HpkeAead::AES_256_GCM:
+      return pb::HpkeAead::AES_256_GCM;
+    case subtle::HpkeAead::CHACHA20_POLY1305:
+      return pb::HpkeAead::CHACHA20_POLY1305;
+    default:
+      return pb::HpkeAead::AEAD_UNKNOWN;
+  }
+}
+
 // static
 const char* Enums::KeyStatusName(pb::KeyStatusType key_status_type) {
   switch (key_status_type) {
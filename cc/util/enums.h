@@ -21,6 +21,7 @@
 #include "tink/subtle/common_enums.h"
 #include "proto/common.pb.h"
 #include "proto/ecdsa.pb.h"
+#include "proto/hpke.pb.h"
 #include "proto/tink.pb.h"
 
 namespace crypto {
@@ -60,6 +61,13 @@ class Enums {
   static crypto::tink::subtle::EcdsaSignatureEncoding ProtoToSubtle(
       google::crypto::tink::EcdsaSignatureEncoding encoding);
 
+  // HpkeAead.
+  static google::crypto::tink::HpkeAead SubtleToProto(
+      crypto::tink::subtle::HpkeAead aead);
+
+  static crypto::tink::subtle::HpkeAead ProtoToSubtle(
+      google::crypto::tink::HpkeAead aead);
+
   // Printable names for common enums.
   static const char* KeyStatusName(
       google::crypto::tink::KeyStatusType key_status_type);
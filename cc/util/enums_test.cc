@@ -175,6 +175,36 @@ TEST_F(EnumsTest, testEcdsaSignatureEncoding) {
   EXPECT_EQ(3, count);
 }
 
+TEST_F(EnumsTest, testHpkeAead) {
+  EXPECT_EQ(pb::HpkeAead::AEAD_UNKNOWN,
+            Enums::SubtleToProto(subtle::HpkeAead::UNKNOWN_HPKE_AEAD));
+  EXPECT_EQ(pb::HpkeAead::AES_128_GCM,
+            Enums::SubtleToProto(subtle::HpkeAead::AES_128_GCM));
+  EXPECT_EQ(pb::HpkeAead::AES_256_GCM,
+            Enums::SubtleToProto(subtle::HpkeAead::AES_256_GCM));
+  EXPECT_EQ(pb::HpkeAead::CHACHA20_POLY1305,
+            Enums::SubtleToProto(subtle::HpkeAead::CHACHA20_POLY1305));
+  EXPECT_EQ(subtle::HpkeAead::UNKNOWN_HPKE_AEAD,
+            Enums::ProtoToSubtle(pb::HpkeAead::AEAD_UNKNOWN));
+  EXPECT_EQ(subtle::HpkeAead::AES_128_GCM,
+            Enums::ProtoToSubtle(pb::HpkeAead::AES_128_GCM));
+  EXPECT_EQ(subtle::HpkeAead::AES_256_GCM,
+            Enums::ProtoToSubtle(pb::HpkeAead::AES_256_GCM));
+  EXPECT_EQ(subtle::HpkeAead::CHACHA20_POLY1305,
+            Enums::ProtoToSubtle(pb::HpkeAead::CHACHA20_POLY1305));
+  // Check that enum conversion covers the entire range of the proto-enum.
+  int count = 0;
+  for (int int_aead = (int)pb::HpkeAead_MIN;
+       int_aead <= (int)pb::HpkeAead_MAX; int_aead++) {
+    if (pb::HpkeAead_IsValid(int_aead)) {
+      pb::HpkeAead aead = (pb::HpkeAead)int_aead;
+      EXPECT_EQ(aead, Enums::SubtleToProto(Enums::ProtoToSubtle(aead)));
+      count++;
+    }
+  }
+  EXPECT_EQ(4, count);
+}
+
 TEST_F(EnumsTest, testKeyStatusName) {
   EXPECT_EQ("ENABLED",
             std::string(Enums::KeyStatusName(pb::KeyStatusType::ENABLED)));
@@ -0,0 +1,74 @@
+// Copyright 2018 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "tink/util/file_random_access_stream.h"
+
+#include <errno.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "tink/util/errors.h"
+
+namespace crypto {
+namespace tink {
+namespace util {
+
+Status FileRandomAccessStream::PRead(uint64_t position, size_t count,
+                                     char* dest) {
+  while (count > 0) {
+    ssize_t read_count = pread(fd_, dest, count, position);
+    if (read_count < 0) {
+      if (errno == EINTR) continue;
+      return ToStatusF(error::INTERNAL, "pread failed with errno %d.", errno);
+    }
+    if (read_count == 0) {
+      return Status(error::OUT_OF_RANGE, "Read past the end of the file.");
+    }
+    dest += read_count;
+    position += read_count;
+    count -= read_count;
+  }
+  return Status::OK;
+}
+
+StatusOr<uint64_t> FileRandomAccessStream::size() {
+  struct stat st;
+  if (fstat(fd_, &st) != 0) {
+    return ToStatusF(error::INTERNAL, "fstat failed with errno %d.", errno);
+  }
+  return static_cast<uint64_t>(st.st_size);
+}
+
+Status FileRandomAccessSink::PWrite(uint64_t position,
+                                    absl::string_view data) {
+  const char* src = data.data();
+  size_t count = data.size();
+  while (count > 0) {
+    ssize_t write_count = pwrite(fd_, src, count, position);
+    if (write_count < 0) {
+      if (errno == EINTR) continue;
+      return ToStatusF(error::INTERNAL, "pwrite failed with errno %d.", errno);
+    }
+    src += write_count;
+    position += write_count;
+    count -= write_count;
+  }
+  return Status::OK;
+}
+
+}  // namespace util
+}  // namespace tink
+}  // namespace crypto
@@ -0,0 +1,68 @@
+// Copyright 2018 Google Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TINK_UTIL_FILE_RANDOM_ACCESS_STREAM_H_
+#define TINK_UTIL_FILE_RANDOM_ACCESS_STREAM_H_
+
+#include "absl/strings/string_view.h"
+#include "tink/random_access_stream.h"
+#include "tink/util/status.h"
+#include "tink/util/statusor.h"
+
+namespace crypto {
+namespace tink {
+namespace util {
+
+// A RandomAccessStream that reads from a file descriptor with pread(2).
+// The descriptor is not owned; the caller must keep it open for the
+// lifetime of the stream.
+class FileRandomAccessStream : public RandomAccessStream {
+ public:
+  explicit FileRandomAccessStream(int file_descriptor)
+      : fd_(file_descriptor) {}
+
+  crypto::tink::util::Status PRead(
+      uint64_t position, size_t count, char* dest) override;
+
+  crypto::tink::util::StatusOr<uint64_t> size() override;
+
+  ~FileRandomAccessStream() override {}
+
+ private:
+  const int fd_;
+};
+
+// A RandomAccessSink that writes to a file descriptor with pwrite(2).
+// The descriptor is not owned; the caller must keep it open for the
+// lifetime of the sink.
+class FileRandomAccessSink : public RandomAccessSink {
+ public:
+  explicit FileRandomAccessSink(int file_descriptor) : fd_(file_descriptor) {}
+
+  crypto::tink::util::Status PWrite(
+      uint64_t position, absl::string_view data) override;
+
+  ~FileRandomAccessSink() override {}
+
+ private:
+  const int fd_;
+};
+
+}  // namespace util
+}  // namespace tink
+}  // namespace crypto
+
+#endif  // TINK_UTIL_FILE_RANDOM_ACCESS_STREAM_H_
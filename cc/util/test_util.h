@@ -22,6 +22,7 @@
 #include "absl/strings/match.h"
 #include "absl/strings/string_view.h"
 #include "tink/aead.h"
+#include "tink/deterministic_aead.h"
 #include "tink/hybrid_decrypt.h"
 #include "tink/hybrid_encrypt.h"
 #include "tink/keyset_handle.h"
@@ -149,6 +150,39 @@ class DummyAead : public Aead {
   std::string aead_name_;
 };
 
+// A dummy implementation of DeterministicAead-interface.
+// An instance of DummyDeterministicAead can be identified by a name specified
+// as a parameter of the constructor.
+class DummyDeterministicAead : public DeterministicAead {
+ public:
+  DummyDeterministicAead(absl::string_view daead_name)
+      : daead_name_(daead_name) {}
+
+  // Computes a dummy ciphertext, which is concatenation of provided 'plaintext'
+  // with the name of this DummyDeterministicAead.
+  crypto::tink::util::StatusOr<std::string> EncryptDeterministically(
+      absl::string_view plaintext,
+      absl::string_view associated_data) const override {
+    return std::string(plaintext.data(), plaintext.size()).append(daead_name_);
+  }
+
+  crypto::tink::util::StatusOr<std::string> DecryptDeterministically(
+      absl::string_view ciphertext,
+      absl::string_view associated_data) const override {
+    std::string c(ciphertext.data(), ciphertext.size());
+    size_t pos = c.rfind(daead_name_);
+    if (pos != std::string::npos &&
+        ciphertext.length() == (unsigned)(daead_name_.length() + pos)) {
+      return c.substr(0, pos);
+    }
+    return crypto::tink::util::Status(
+        crypto::tink::util::error::INVALID_ARGUMENT, "Wrong ciphertext.");
+  }
+
+ private:
+  std::string daead_name_;
+};
+
 // A dummy implementation of HybridEncrypt-interface.
 // An instance of DummyHybridEncrypt can be identified by a name specified
 // as a parameter of the constructor.